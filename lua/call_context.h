@@ -22,6 +22,9 @@ struct CallContext {
   // Whether there is error on stack.
   bool has_error = false;
 
+  // Whether to yield the coroutine after the native function returns.
+  bool yield = false;
+
   // The index (1-based) of current arg.
   int current_arg = 1;
 
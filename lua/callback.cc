@@ -0,0 +1,73 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua/callback.h"
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+
+namespace lua {
+
+namespace internal {
+
+namespace {
+
+using CallStatsMap = std::map<std::string, CallStats>;
+
+// The counters are never removed so holders can keep pointers to them.
+CallStatsMap& GetCallStatsMap() {
+  static base::NoDestructor<CallStatsMap> call_stats;
+  return *call_stats;
+}
+
+// Workers run lua states in other threads.
+base::Lock& GetCallStatsLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+}  // namespace
+
+bool g_call_stats_enabled = false;
+
+void RecordCall(State* state, CallStats** stats,
+                base::TimeDelta convert_time, base::TimeDelta native_time) {
+  base::AutoLock auto_lock(GetCallStatsLock());
+  if (!*stats) {
+    // Native functions do not know their names, so take the name from the
+    // calling code, which is "settext" for "label:settext('text')".
+    lua_Debug ar;
+    const char* name = nullptr;
+    if (lua_getstack(state, 0, &ar) && lua_getinfo(state, "n", &ar))
+      name = ar.name;
+    *stats = &GetCallStatsMap()[name ? name : "(anonymous)"];
+  }
+  (*stats)->calls++;
+  (*stats)->convert_time += convert_time;
+  (*stats)->native_time += native_time;
+}
+
+}  // namespace internal
+
+void SetCallStatsEnabled(bool enabled) {
+  internal::g_call_stats_enabled = enabled;
+}
+
+std::map<std::string, CallStats> GetCallStats() {
+  base::AutoLock auto_lock(internal::GetCallStatsLock());
+  std::map<std::string, CallStats> result;
+  for (const auto& it : internal::GetCallStatsMap()) {
+    if (it.second.calls > 0)
+      result.emplace(it.first, it.second);
+  }
+  return result;
+}
+
+void ResetCallStats() {
+  base::AutoLock auto_lock(internal::GetCallStatsLock());
+  for (auto& it : internal::GetCallStatsMap())
+    it.second = CallStats();
+}
+
+}  // namespace lua
@@ -7,7 +7,9 @@
 #ifndef LUA_CALLBACK_H_
 #define LUA_CALLBACK_H_
 
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "lua/callback_internal.h"
@@ -15,6 +17,18 @@
 
 namespace lua {
 
+// Enable counting the calls into bound native functions, which is off by
+// default. The counters are shared by all states, including the states in
+// other threads.
+void SetCallStatsEnabled(bool enabled);
+
+// Return the counters of called functions, keyed by the names the functions
+// were first called with, like "settext".
+std::map<std::string, CallStats> GetCallStats();
+
+// Reset all counters to zero.
+void ResetCallStats();
+
 // Convert a lua function to C++ without keeping a reference to it.
 template<typename ReturnType, typename... ArgTypes>
 bool ToWeakFunction(State* state, int index,
@@ -25,10 +39,10 @@ bool ToWeakFunction(State* state, int index,
   }
   if (GetType(state, index) != LuaType::Function)
     return false;
-  std::shared_ptr<Handle> handle = Weak::New(state, index);
+  std::shared_ptr<Weak> handle = Weak::New(state, index);
   *out = [state, handle](ArgTypes... args) -> ReturnType {
     return internal::PCallHelper<ReturnType, ArgTypes...>::Run(
-        state, handle, std::move(args)...);
+        state, handle, args...);
   };
   return true;
 }
@@ -64,10 +78,10 @@ struct Type<std::function<ReturnType(ArgTypes...)>> {
     }
     if (GetType(state, index) != LuaType::Function)
       return false;
-    std::shared_ptr<Handle> handle = Persistent::New(state, index);
+    std::shared_ptr<Persistent> handle = Persistent::New(state, index);
     *out = [state, handle](ArgTypes... args) -> ReturnType {
       return internal::PCallHelper<ReturnType, ArgTypes...>::Run(
-          state, handle, std::move(args)...);
+          state, handle, args...);
     };
     return true;
   }
@@ -12,6 +12,7 @@
 
 #include "base/logging.h"
 #include "base/template_util.h"
+#include "base/time/time.h"
 #include "lua/call_context.h"
 #include "lua/handle.h"
 #include "lua/pcall.h"
@@ -20,8 +21,26 @@
 
 namespace lua {
 
+// Counters of the calls into a bound native function.
+struct CallStats {
+  uint64_t calls = 0;
+  // Time spent on converting arguments from lua.
+  base::TimeDelta convert_time;
+  // Time spent in the native function, including pushing its result and the
+  // lua code it calls.
+  base::TimeDelta native_time;
+};
+
 namespace internal {
 
+// Whether calls into bound functions are counted.
+extern bool g_call_stats_enabled;
+
+// Add a call to |*stats|, which is resolved from the name of the running
+// function on first call.
+void RecordCall(State* state, CallStats** stats,
+                base::TimeDelta convert_time, base::TimeDelta native_time);
+
 // CallbackHolder is used to pass a std::function from PushCFunction through
 // DispatchToCallback, where it is invoked.
 template<typename Sig>
@@ -31,6 +50,7 @@ class CallbackHolder {
       : callback(callback) {}
 
   std::function<Sig> callback;
+  CallStats* stats = nullptr;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(CallbackHolder);
@@ -145,6 +165,9 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
     static_assert(std::is_trivially_destructible<CallContext>::value,
                   "The CallContext must not invole C++ stack");
     {  // Make sure C++ stack is destroyed before calling lua_error.
+      base::TimeTicks start;
+      if (g_call_stats_enabled)
+        start = base::TimeTicks::Now();
       using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
       Invoker<Indices, ArgTypes...> invoker(&context);
       if (!invoker.ConvertArgs()) {
@@ -168,8 +191,13 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
                            : name.data(),
               context.invalid_arg_name);
         }
+      } else if (start.is_null()) {
+        invoker.DispatchToCallback(holder->callback);
       } else {
+        base::TimeTicks converted = base::TimeTicks::Now();
         invoker.DispatchToCallback(holder->callback);
+        RecordCall(state, &holder->stats, converted - start,
+                   base::TimeTicks::Now() - converted);
       }
     }
 
@@ -179,6 +207,9 @@ struct Dispatcher<ReturnType(ArgTypes...)> {
       return -1;
     }
 
+    if (context.yield)
+      return lua_yield(state, 0);
+
     return context.return_values_count;
   }
 };
@@ -191,10 +222,14 @@ inline void PushCFunction(State* state, const std::function<Sig>& callback) {
 }
 
 // Call PCall for the gloal handle.
+//
+// The handle is passed with its concrete type so Push is not a virtual call,
+// and the arguments are pushed directly without being copied.
 template<typename ReturnType, typename...ArgTypes>
 struct PCallHelper {
-  static ReturnType Run(State* state, const std::shared_ptr<Handle>& handle,
-                        ArgTypes... args) {
+  template<typename HandleType>
+  static ReturnType Run(State* state, const std::shared_ptr<HandleType>& handle,
+                        const ArgTypes&... args) {
     ReturnType result = ReturnType();
     int top = GetTop(state);
     DCHECK_EQ(state, handle->state());
@@ -212,8 +247,9 @@ struct PCallHelper {
 // The void return type version for PCallHelper.
 template<typename...ArgTypes>
 struct PCallHelper<void, ArgTypes...> {
-  static void Run(State* state, const std::shared_ptr<Handle>& handle,
-                  ArgTypes... args) {
+  template<typename HandleType>
+  static void Run(State* state, const std::shared_ptr<HandleType>& handle,
+                  const ArgTypes&... args) {
     int top = GetTop(state);
     DCHECK_EQ(state, handle->state());
     handle->Push();
@@ -218,3 +218,19 @@ TEST_F(CallbackTest, WeakFunctionIsStoredWeak) {
   lua::CollectGarbage(state_);
   EXPECT_EQ(callback(123), 0);
 }
+
+TEST_F(CallbackTest, CallStats) {
+  lua::ResetCallStats();
+  lua::SetCallStatsEnabled(true);
+  lua::Push(state_, &FunctionReturnsInt);
+  lua_setglobal(state_, "returnsint");
+  ASSERT_FALSE(luaL_dostring(state_, "returnsint(1) returnsint(2)"));
+  lua::SetCallStatsEnabled(false);
+  ASSERT_FALSE(luaL_dostring(state_, "returnsint(3)"));
+  std::map<std::string, lua::CallStats> stats = lua::GetCallStats();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats["returnsint"].calls, 2u);
+  lua::ResetCallStats();
+  EXPECT_TRUE(lua::GetCallStats().empty());
+  lua::SetTop(state_, 0);
+}
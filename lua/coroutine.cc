@@ -0,0 +1,56 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua/coroutine.h"
+
+#include <string>
+
+namespace lua {
+
+namespace internal {
+
+Coroutine::Coroutine(CallContext* context)
+    : state_(context->state), context_(context) {
+  lua_pushthread(state_);
+  ref_ = luaL_ref(state_, LUA_REGISTRYINDEX);
+  context_->yield = true;
+}
+
+Coroutine::~Coroutine() {
+  Release();
+}
+
+void Coroutine::CallFinished() {
+  context_ = nullptr;
+}
+
+void Coroutine::Resume(int nargs) {
+  if (context_) {
+    // The callback is called synchronously, return the values pushed.
+    context_->yield = false;
+    context_->return_values_count = nargs;
+    Release();
+    return;
+  }
+  int status = lua_resume(state_, nullptr, nargs);
+  if (status != LUA_OK && status != LUA_YIELD) {
+    std::string error;
+    To(state_, -1, &error);
+    LOG(ERROR) << "Error when resuming coroutine: " << error;
+  }
+  // Nobody receives the values yielded or returned by the coroutine.
+  SetTop(state_, 0);
+  Release();
+}
+
+void Coroutine::Release() {
+  if (ref_ == LUA_NOREF)
+    return;
+  luaL_unref(state_, LUA_REGISTRYINDEX, ref_);
+  ref_ = LUA_NOREF;
+}
+
+}  // namespace internal
+
+}  // namespace lua
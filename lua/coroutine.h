@@ -0,0 +1,117 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+//
+// Lets async functions yield the calling coroutine instead of taking a
+// callback.
+
+#ifndef LUA_COROUTINE_H_
+#define LUA_COROUTINE_H_
+
+#include <functional>
+#include <memory>
+
+#include "lua/callback.h"
+
+namespace lua {
+
+// The type of the callback parameter of async functions.
+//
+// When a function is passed it works the same with std::function. When the
+// callback is omitted in a coroutine, the coroutine yields after the native
+// function returns, and is resumed by the callback with its arguments, which
+// become the results of the call:
+//
+//   coroutine.wrap(function()
+//     local error, data = sys.readfile('file')
+//   end)()
+//
+// No lua closure is created for the yielding calls, the native function
+// should call the callback at most once.
+template<typename Sig>
+class AsyncCallback : public std::function<Sig> {
+ public:
+  using std::function<Sig>::function;
+  AsyncCallback() {}
+};
+
+namespace internal {
+
+// Refers to the coroutine that called an async function until it is resumed.
+class Coroutine {
+ public:
+  explicit Coroutine(CallContext* context);
+  ~Coroutine();
+
+  // Called when the native function returns, after which the call yields.
+  void CallFinished();
+
+  // Resume the coroutine with |nargs| values pushed on its stack. If the call
+  // has not yielded yet, the values are returned by the call instead.
+  void Resume(int nargs);
+
+  // Whether Resume has not been called.
+  bool pending() const { return ref_ != LUA_NOREF; }
+
+  State* state() const { return state_; }
+
+ private:
+  void Release();
+
+  State* state_;
+  int ref_;
+  CallContext* context_;
+
+  DISALLOW_COPY_AND_ASSIGN(Coroutine);
+};
+
+template<typename... ArgTypes>
+void ResumeCoroutine(const std::shared_ptr<Coroutine>& coroutine,
+                     const ArgTypes&... args) {
+  if (!coroutine->pending())
+    return;
+  Push(coroutine->state(), args...);
+  coroutine->Resume(sizeof...(ArgTypes));
+}
+
+template<size_t index, typename... ArgTypes>
+struct ArgumentHolder<index, AsyncCallback<void(ArgTypes...)>> {
+  AsyncCallback<void(ArgTypes...)> value;
+  std::shared_ptr<Coroutine> coroutine;
+
+  ~ArgumentHolder() {
+    if (coroutine)
+      coroutine->CallFinished();
+  }
+
+  bool Convert(CallContext* context) {
+    State* state = context->state;
+    int arg = context->current_arg;
+    LuaType type = GetType(state, arg);
+    if ((type == LuaType::None || type == LuaType::Nil) &&
+        lua_isyieldable(state)) {
+      coroutine = std::make_shared<Coroutine>(context);
+      std::shared_ptr<Coroutine> ref = coroutine;
+      value = [ref](ArgTypes... args) {
+        ResumeCoroutine(ref, args...);
+      };
+    } else if (!To(state, arg, static_cast<std::function<void(ArgTypes...)>*>(
+                                   &value))) {
+      context->invalid_arg = arg;
+      context->invalid_arg_name = "function";
+      return false;
+    }
+    context->current_arg++;
+    return true;
+  }
+};
+
+template<size_t index, typename Sig>
+struct ArgumentHolder<index, const AsyncCallback<Sig>&>
+    : public ArgumentHolder<index, AsyncCallback<Sig>> {};
+
+}  // namespace internal
+
+}  // namespace lua
+
+#endif  // LUA_COROUTINE_H_
@@ -0,0 +1,83 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua/lua.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class CoroutineTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    luaL_openlibs(state_);
+  }
+
+  lua::ManagedState state_;
+};
+
+std::function<void(int, const std::string&)> g_pending;
+
+void AsyncFunction(
+    lua::AsyncCallback<void(int, const std::string&)> callback) {
+  g_pending = std::move(callback);
+}
+
+void SyncFunction(lua::AsyncCallback<void(int)> callback) {
+  callback(123);
+}
+
+TEST_F(CoroutineTest, YieldWhenCallbackOmitted) {
+  lua::Push(state_, &AsyncFunction);
+  lua_setglobal(state_, "async");
+  ASSERT_FALSE(luaL_dostring(state_,
+      "coroutine.wrap(function()\n"
+      "  num, str = async()\n"
+      "end)()"));
+  ASSERT_TRUE(g_pending);
+  lua_getglobal(state_, "num");
+  EXPECT_EQ(lua::GetType(state_, -1), lua::LuaType::Nil);
+  lua::SetTop(state_, 0);
+
+  g_pending(42, "str");
+  g_pending(43, "ignored");
+  g_pending = nullptr;
+  int num = 0;
+  std::string str;
+  lua_getglobal(state_, "num");
+  lua_getglobal(state_, "str");
+  ASSERT_TRUE(lua::Pop(state_, &num, &str));
+  EXPECT_EQ(num, 42);
+  EXPECT_EQ(str, "str");
+}
+
+TEST_F(CoroutineTest, CallbackPassed) {
+  lua::Push(state_, &AsyncFunction);
+  lua_setglobal(state_, "async");
+  ASSERT_FALSE(luaL_dostring(state_,
+      "async(function(n, s) num = n end)"));
+  ASSERT_TRUE(g_pending);
+  g_pending(42, "str");
+  g_pending = nullptr;
+  int num = 0;
+  lua_getglobal(state_, "num");
+  ASSERT_TRUE(lua::Pop(state_, &num));
+  EXPECT_EQ(num, 42);
+}
+
+TEST_F(CoroutineTest, CallbackCalledBeforeYield) {
+  lua::Push(state_, &SyncFunction);
+  lua_setglobal(state_, "sync");
+  ASSERT_FALSE(luaL_dostring(state_,
+      "coroutine.wrap(function()\n"
+      "  num = sync()\n"
+      "end)()"));
+  int num = 0;
+  lua_getglobal(state_, "num");
+  ASSERT_TRUE(lua::Pop(state_, &num));
+  EXPECT_EQ(num, 123);
+}
+
+TEST_F(CoroutineTest, OmitCallbackOutsideCoroutine) {
+  lua::Push(state_, &AsyncFunction);
+  lua_setglobal(state_, "async");
+  EXPECT_TRUE(luaL_dostring(state_, "async()"));
+}
@@ -10,7 +10,8 @@ namespace lua {
 
 namespace {
 
-const char* kWeakTableName = "yue.internal.weaktable";
+// The address is used as the registry key of the weak table.
+char kWeakTableKey;
 
 }  // namespace
 
@@ -30,20 +31,21 @@ Weak::Weak(State* state, int index)
     : Handle(state) {
   index = AbsIndex(state, index);
   StackAutoReset reset(state);
-  PushWeakTable(state, kWeakTableName, "v");
+  PushWeakTableByKey(state, &kWeakTableKey, "v");
   RawSet(state, -1, static_cast<const void*>(this), ValueOnStack(state, index));
 }
 
 Weak::~Weak() {
   StackAutoReset reset(state());
-  luaL_getmetatable(state(), kWeakTableName);
+  PushWeakTableByKey(state(), &kWeakTableKey, "v");
   RawSet(state(), -1, static_cast<const void*>(this), nullptr);
 }
 
 void Weak::Push() const {
-  luaL_getmetatable(state(), kWeakTableName);
+  // Signal handlers are weak references, so this is called for every event.
+  lua_rawgetp(state(), LUA_REGISTRYINDEX, &kWeakTableKey);
   DCHECK_EQ(GetType(state(), -1), LuaType::Table);
-  RawGet(state(), -1, static_cast<const void*>(this));
+  lua_rawgetp(state(), -1, this);
   lua_remove(state(), -2);
 }
 
@@ -47,7 +47,7 @@ class Handle {
 };
 
 // The strong reference to a value.
-class Persistent : public Handle {
+class Persistent final : public Handle {
  public:
   static std::shared_ptr<Persistent> New(State* state, int index) {
     lua::Push(state, ValueOnStack(state, index));
@@ -64,7 +64,7 @@ class Persistent : public Handle {
 };
 
 // The weak reference.
-class Weak : public Handle {
+class Weak final : public Handle {
  public:
   static std::shared_ptr<Weak> New(State* state, int index) {
     return std::make_shared<Weak>(state, index);
@@ -5,6 +5,7 @@
 #ifndef LUA_LUA_H_
 #define LUA_LUA_H_
 
+#include "lua/coroutine.h"
 #include "lua/index.h"
 #include "lua/metatable.h"
 #include "lua/pcall.h"
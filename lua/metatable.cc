@@ -2,6 +2,8 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <string.h>
+
 #include "lua/index.h"
 #include "lua/metatable.h"
 
@@ -14,13 +16,58 @@ namespace {
 // Limit for table inheritance chains (to avoid loops).
 const int kMaxLoop  = 2000;
 
-const char* kWrapperTableName = "yue.internal.wrappertable";
+// The address is used as the registry key of the wrapper table.
+char kWrapperTableKey;
+
+// Copy the entries of table at |from| to |to|, unless the key is an internal
+// field, or is already in |to| or |other|.
+void CopyMissingEntries(State* state, int from, int to, int other) {
+  lua_pushnil(state);
+  while (lua_next(state, from) != 0) {
+    bool internal = lua_type(state, -2) == LUA_TSTRING &&
+                    strncmp(lua_tostring(state, -2), "__", 2) == 0;
+    if (!internal) {
+      lua_pushvalue(state, -2);
+      lua_rawget(state, to);
+      lua_pushvalue(state, -3);
+      lua_rawget(state, other);
+      bool exists = !lua_isnil(state, -1) || !lua_isnil(state, -2);
+      PopAndIgnore(state, 2);
+      if (!exists) {
+        lua_pushvalue(state, -2);
+        lua_pushvalue(state, -2);
+        lua_rawset(state, to);
+      }
+    }
+    PopAndIgnore(state, 1);
+  }
+}
 
 }  // namespace
 
+void InheritMetaTable(State* state, int index, int base) {
+  index = AbsIndex(state, index);
+  base = AbsIndex(state, base);
+  StackAutoReset reset(state);
+  RawSet(state, index, "__super", ValueOnStack(state, base));
+
+  // The metatable of base has been flattened, so copying one level is enough.
+  RawGet(state, index, "__properties");
+  if (GetType(state, -1) == LuaType::Nil) {
+    PopAndIgnore(state, 1);
+    NewTable(state);
+    RawSet(state, index, "__properties", ValueOnStack(state, -1));
+  }
+  int properties = GetTop(state);
+  CopyMissingEntries(state, base, index, properties);
+  RawGet(state, base, "__properties");
+  if (GetType(state, -1) == LuaType::Table)
+    CopyMissingEntries(state, GetTop(state), properties, index);
+}
+
 bool WrapperTableGet(State* state, void* key) {
   int top = GetTop(state);
-  PushWeakTable(state, kWrapperTableName, "v");
+  PushWeakTableByKey(state, &kWrapperTableKey, "v");
   RawGet(state, -1, key);
   if (GetType(state, -1) == LuaType::Nil) {
     SetTop(state, top);
@@ -33,11 +80,15 @@ bool WrapperTableGet(State* state, void* key) {
 void WrapperTableSet(State* state, void* key, int index) {
   index = AbsIndex(state, index);
   StackAutoReset reset(state);
-  PushWeakTable(state, kWrapperTableName, "v");
+  PushWeakTableByKey(state, &kWrapperTableKey, "v");
   RawSet(state, -1, key, ValueOnStack(state, index));
 }
 
 int InheritanceChainLookup(State* state) {
+  // Since metatables are flattened, the members of native classes are always
+  // found in the first loop, and the chain is only walked for members added
+  // to base classes later, or for custom data.
+  //
   // The first metatable to lookup.
   Push(state, ValueOnStack(state, lua_upvalueindex(1)));
   int metatable = 3;
@@ -121,4 +172,30 @@ int InheritanceChainAssign(State* state) {
 
 }  // namespace internal
 
+std::map<std::string, ObjectStats> GetObjectStats(State* state) {
+  std::map<std::string, ObjectStats> stats;
+  StackAutoReset reset(state);
+  PushWeakTableByKey(state, &internal::kWrapperTableKey, "v");
+  int table = GetTop(state);
+  lua_pushnil(state);
+  while (lua_next(state, table) != 0) {
+    int wrapper = GetTop(state);
+    if (lua_getmetatable(state, wrapper)) {
+      std::string name;
+      RawGetAndPop(state, -1, "__name", &name);
+      ObjectStats& entry = stats[name];
+      entry.count++;
+      RawGet(state, -1, "__hasoneref");
+      if (GetType(state, -1) == LuaType::Function) {
+        lua_pushvalue(state, wrapper);
+        lua_call(state, 1, 1);
+        if (lua_toboolean(state, -1))
+          entry.retained_by_wrapper++;
+      }
+    }
+    SetTop(state, wrapper - 1);
+  }
+  return stats;
+}
+
 }  // namespace lua
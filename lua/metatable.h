@@ -5,6 +5,8 @@
 #ifndef LUA_METATABLE_H_
 #define LUA_METATABLE_H_
 
+#include <map>
+#include <string>
 #include <type_traits>
 
 #include "lua/metatable_internal.h"
@@ -26,6 +28,9 @@ struct UserData<T, typename std::enable_if<std::is_base_of<
   static inline T* From(State* state, void* data) {
     return *static_cast<T**>(data);
   }
+  static inline bool HasOneRef(void* data) {
+    return (*static_cast<T**>(data))->HasOneRef();
+  }
 };
 
 // Defines how the wrapper of WeakPtr is destructed.
@@ -43,8 +48,21 @@ struct UserData<T, typename std::enable_if<std::is_base_of<
   static inline T* From(State* state, void* data) {
     return static_cast<base::WeakPtr<T>*>(data)->get();
   }
+  static inline bool HasOneRef(void* data) {
+    return false;
+  }
 };
 
+// Statistics of the live wrappers of a native class.
+struct ObjectStats {
+  uint32_t count = 0;
+  // The native objects that are only kept alive by their wrappers.
+  uint32_t retained_by_wrapper = 0;
+};
+
+// Return the stats of live wrappers, keyed by class names.
+std::map<std::string, ObjectStats> GetObjectStats(State* state);
+
 // Generate metatable for native classes.
 template<typename T, typename Enable = void>
 struct MetaTable {
@@ -23,6 +23,10 @@ bool WrapperTableGet(State* state, void* key);
 // Save a wrapper at |index| to weak wrapper table with |key|.
 void WrapperTableSet(State* state, void* key, int index);
 
+// Link the metatable at |index| to its |base|, and copy the members of |base|
+// that are not overridden, so members are found without walking the chain.
+void InheritMetaTable(State* state, int index, int base);
+
 // A implementation of __index that works as prototype chain.
 int InheritanceChainLookup(State* state);
 
@@ -37,6 +41,13 @@ int DereferenceOnGC(lua::State* state) {
   return 0;
 }
 
+// Push whether the wrapper is the only reference to the native object.
+template<typename T>
+int HasOneRef(lua::State* state) {
+  lua_pushboolean(state, UserData<T>::HasOneRef(lua_touserdata(state, 1)));
+  return 1;
+}
+
 // Create metatable for T, returns true if the metattable has already been
 // created.
 template<typename T>
@@ -57,6 +68,7 @@ bool NewMetaTable(State* state) {
 
   RawSet(state, -1,
          "__gc", CFunction(&DereferenceOnGC<T>),
+         "__hasoneref", CFunction(&HasOneRef<T>),
          "__index", CClosure(state, &InheritanceChainLookup, 1),
          "__newindex", CClosure(state, &InheritanceChainAssign, 1));
   Type<T>::BuildMetaTable(state, AbsIndex(state, -1));
@@ -82,7 +94,7 @@ struct InheritanceChain<T, typename std::enable_if<std::is_class<
     // Inherit from base type's metatable.
     StackAutoReset reset(state);
     InheritanceChain<typename Type<T>::base>::Push(state);
-    RawSet(state, -2, "__super", ValueOnStack(state, -1));
+    InheritMetaTable(state, -2, -1);
   }
 };
 
@@ -260,6 +260,18 @@ TEST_F(MetaTableTest, DeeplyDerivedClassInheritanceChain) {
   ASSERT_EQ(name, "TestClass");
 }
 
+TEST_F(MetaTableTest, DeeplyDerivedClassFlattenedMethods) {
+  lua::Push(state_, lua::MetaTable<DerivedClass2>());
+  lua::RawGet(state_, 1, "method1", "a", "c");
+  EXPECT_EQ(lua::GetType(state_, 2), lua::LuaType::Function);
+  EXPECT_EQ(lua::GetType(state_, 3), lua::LuaType::Function);
+  EXPECT_EQ(lua::GetType(state_, 4), lua::LuaType::Function);
+  lua::SetTop(state_, 1);
+  lua::RawGet(state_, 1, "new", "__super");
+  lua::RawGet(state_, 3, "new");
+  EXPECT_FALSE(lua_rawequal(state_, 2, 4));
+}
+
 TEST_F(MetaTableTest, DeeplyDerivedClassGC) {
   DerivedClass2* d2 = new DerivedClass2;
   int changed_d2 = 0;
@@ -431,3 +443,14 @@ TEST_F(MetaTableTest, WeakPtr) {
   instance.reset();
   ASSERT_FALSE(lua::To(state_, -1, &ptr));
 }
+
+TEST_F(MetaTableTest, ObjectStats) {
+  scoped_refptr<TestClass> kept = new TestClass;
+  lua::Push(state_, kept.get());
+  lua::Push(state_, new TestClass);
+  std::map<std::string, lua::ObjectStats> stats = lua::GetObjectStats(state_);
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats["TestClass"].count, 2u);
+  EXPECT_EQ(stats["TestClass"].retained_by_wrapper, 1u);
+  EXPECT_EQ(lua::GetTop(state_), 2);
+}
@@ -8,13 +8,14 @@ namespace lua {
 
 namespace {
 
-const char* kCustomDataTableName = "yue.internal.customdatatable";
+// The address is used as the registry key of the custom data table.
+char kCustomDataTableKey;
 
 }  // namespace
 
 void PushCustomDataTable(State* state, int key) {
   key = AbsIndex(state, key);
-  PushWeakTable(state, kCustomDataTableName, "k");
+  PushWeakTableByKey(state, &kCustomDataTableKey, "k");
   RawGetOrCreateTable(state, -1, ValueOnStack(state, key));
   lua_remove(state, -2);
 }
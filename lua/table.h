@@ -190,6 +190,21 @@ inline void PushWeakTable(State* state, const char* name, const char* mode) {
   }
 }
 
+// Like PushWeakTable, but the table is stored in registry with the address of
+// |key|, which only costs one rawget for tables accessed frequently.
+inline void PushWeakTableByKey(State* state, void* key, const char* mode) {
+  lua_rawgetp(state, LUA_REGISTRYINDEX, key);
+  if (GetType(state, -1) != LuaType::Table) {
+    PopAndIgnore(state, 1);
+    lua::NewTable(state);
+    lua::NewTable(state, 0, 1);
+    lua::RawSet(state, -1, "__mode", mode);
+    lua::SetMetaTable(state, -2);
+    lua_pushvalue(state, -1);
+    lua_rawsetp(state, LUA_REGISTRYINDEX, key);
+  }
+}
+
 // Return or create a table for key.
 template<typename T>
 void RawGetOrCreateTable(State* state, int table, const T& key) {
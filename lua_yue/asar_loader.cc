@@ -0,0 +1,103 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua_yue/asar_loader.h"
+
+#include <memory>
+
+#include "base/strings/string_util.h"
+#include "nativeui/protocol_asar_job.h"
+
+namespace yue {
+
+namespace {
+
+// Feed the content of job to lua_load, files stored uncompressed are read
+// from the mapped archive without copying.
+struct ChunkReader {
+  scoped_refptr<nu::ProtocolJob> job;
+  bool has_content = false;
+  bool done = false;
+  char buffer[16 * 1024];
+};
+
+const char* ReadChunk(lua::State* state, void* data, size_t* size) {
+  auto* reader = static_cast<ChunkReader*>(data);
+  if (reader->done) {
+    *size = 0;
+    return nullptr;
+  }
+  base::StringPiece content;
+  if (!reader->has_content && reader->job->GetContent(&content)) {
+    reader->done = true;
+    *size = content.size();
+    return content.data();
+  }
+  reader->has_content = true;
+  *size = reader->job->Read(reader->buffer, sizeof(reader->buffer));
+  if (*size == 0)
+    reader->done = true;
+  return reader->buffer;
+}
+
+int SearchAsar(lua::State* state) {
+  std::string asar_path;
+  std::string name;
+  lua::To(state, lua_upvalueindex(1), &asar_path);
+  lua::To(state, 1, &name);
+  base::FilePath asar = base::FilePath::FromUTF8Unsafe(asar_path);
+  std::string path;
+  base::ReplaceChars(name, ".", "/", &path);
+  if (LoadFileFromAsar(state, asar, path + ".lua"))
+    return 1;
+  lua_pop(state, 1);
+  if (LoadFileFromAsar(state, asar, path + "/init.lua"))
+    return 1;
+  lua_pop(state, 1);
+  lua::PushFormatedString(state, "\n\tno file '%s.lua' in asar", path.c_str());
+  return 1;
+}
+
+}  // namespace
+
+bool LoadFileFromAsar(lua::State* state,
+                      const base::FilePath& asar,
+                      const std::string& path) {
+  // The reader has a large buffer, so do not put it on stack.
+  std::unique_ptr<ChunkReader> reader(new ChunkReader);
+  reader->job = new nu::ProtocolAsarJob(asar, path);
+  reader->job->Plug([](int) {});
+  bool success = false;
+  if (reader->job->Start()) {
+    std::string chunkname = "@" + asar.AsUTF8Unsafe() + "/" + path;
+    // Both text and binary chunks are accepted.
+    success = lua_load(state, &ReadChunk, reader.get(), chunkname.c_str(),
+                       "bt") == LUA_OK;
+  } else {
+    lua::PushFormatedString(state, "cannot open '%s' in asar", path.c_str());
+  }
+  return success;
+}
+
+void InsertAsarModuleLoader(lua::State* state, const base::FilePath& asar) {
+  lua::StackAutoReset reset(state);
+  lua_getglobal(state, "package");
+  DCHECK_EQ(lua::GetType(state, -1), lua::LuaType::Table)
+      << "package should be a table";
+  lua::RawGet(state, -1, "searchers");
+  DCHECK_EQ(lua::GetType(state, -1), lua::LuaType::Table)
+      << "package.searchers should be a table";
+
+  // table.insert(pacakge.searchers, 2, search_asar)
+  int len = static_cast<int>(lua::RawLen(state, -1));
+  for (int i = len; i >= 2; --i) {
+    lua::RawGet(state, -1, i);
+    lua_rawseti(state, -2, i + 1);
+  }
+  lua::Push(state, asar.AsUTF8Unsafe());
+  lua_pushcclosure(state, &SearchAsar, 1);
+  lua_rawseti(state, -2, 2);
+}
+
+}  // namespace yue
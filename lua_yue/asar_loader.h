@@ -0,0 +1,28 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef LUA_YUE_ASAR_LOADER_H_
+#define LUA_YUE_ASAR_LOADER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "lua/lua.h"
+
+namespace yue {
+
+// Load the chunk of |path| inside the |asar| archive and push it on stack,
+// the file can be either source code or bytecode precompiled by luac. On
+// failure the error message is pushed instead.
+bool LoadFileFromAsar(lua::State* state,
+                      const base::FilePath& asar,
+                      const std::string& path);
+
+// Add a function to package.searchers to load modules from the |asar|
+// archive, the module "a.b" is searched as "a/b.lua" and "a/b/init.lua".
+void InsertAsarModuleLoader(lua::State* state, const base::FilePath& asar);
+
+}  // namespace yue
+
+#endif  // LUA_YUE_ASAR_LOADER_H_
@@ -4,6 +4,9 @@
 
 #include "lua_yue/binding_gui.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -11,6 +14,8 @@
 #include <vector>
 
 #include "base/command_line.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "lua_yue/binding_signal.h"
 #include "lua_yue/binding_values.h"
 #include "nativeui/nativeui.h"
@@ -215,6 +220,40 @@ struct Type<nu::ImageScale> {
   }
 };
 
+template<>
+struct Type<nu::ImageQuality> {
+  static constexpr const char* name = "ImageQuality";
+  static inline bool To(State* state, int index, nu::ImageQuality* out) {
+    std::string quality;
+    if (!lua::To(state, index, &quality))
+      return false;
+    if (quality == "low") {
+      *out = nu::ImageQuality::Low;
+      return true;
+    } else if (quality == "medium") {
+      *out = nu::ImageQuality::Medium;
+      return true;
+    } else if (quality == "high") {
+      *out = nu::ImageQuality::High;
+      return true;
+    } else {
+      return false;
+    }
+  }
+  static inline void Push(State* state, nu::ImageQuality quality) {
+    switch (quality) {
+      case nu::ImageQuality::Low:
+        return lua::Push(state, "low");
+      case nu::ImageQuality::Medium:
+        return lua::Push(state, "medium");
+      case nu::ImageQuality::High:
+        return lua::Push(state, "high");
+    }
+    NOTREACHED();
+    return lua::Push(state, nullptr);
+  }
+};
+
 template<>
 struct Type<nu::Orientation> {
   static constexpr const char* name = "Orientation";
@@ -263,6 +302,8 @@ template<>
 struct Type<nu::Lifetime> {
   static constexpr const char* name = "Lifetime";
   static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index, "fastexit", &nu::Lifetime::FastExit);
+    RawSetProperty(state, index, "onfastexit", &nu::Lifetime::on_fast_exit);
 #if defined(OS_MACOSX)
     RawSetProperty(state, index,
                    "onready", &nu::Lifetime::on_ready,
@@ -271,6 +312,29 @@ struct Type<nu::Lifetime> {
   }
 };
 
+template<>
+struct Type<nu::MessageLoop::Priority> {
+  static constexpr const char* name = "MessageLoopPriority";
+  static inline bool To(State* state, int index,
+                        nu::MessageLoop::Priority* out) {
+    std::string priority;
+    if (!lua::To(state, index, &priority))
+      return false;
+    if (priority == "user-blocking") {
+      *out = nu::MessageLoop::Priority::UserBlocking;
+      return true;
+    } else if (priority == "normal") {
+      *out = nu::MessageLoop::Priority::Normal;
+      return true;
+    } else if (priority == "idle") {
+      *out = nu::MessageLoop::Priority::Idle;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
 template<>
 struct Type<nu::MessageLoop> {
   static constexpr const char* name = "MessageLoop";
@@ -278,8 +342,277 @@ struct Type<nu::MessageLoop> {
     RawSet(state, index,
            "run", &nu::MessageLoop::Run,
            "quit", &nu::MessageLoop::Quit,
-           "posttask", &nu::MessageLoop::PostTask,
-           "postdelayedtask", &nu::MessageLoop::PostDelayedTask);
+           "posttask", &PostTask,
+           "posttaskwithpriority", &PostTaskWithPriority,
+           "postdelayedtask", &PostDelayedTask,
+           "postunthrottleddelayedtask", &PostUnthrottledDelayedTask,
+           "postidletask", &PostIdleTask);
+  }
+  // Report the caller in script as where the task is posted.
+  static std::string GetPostingSite(State* state) {
+    if (!nu::State::GetCurrent()->IsMessageLoopStatsEnabled())
+      return std::string();
+    lua_Debug ar;
+    if (!lua_getstack(state, 1, &ar) || !lua_getinfo(state, "Sl", &ar))
+      return std::string();
+    return base::StringPrintf("%s:%d", ar.short_src, ar.currentline);
+  }
+  static void PostTask(CallContext* context, nu::MessageLoop::Task task) {
+    nu::MessageLoop::PostTaskFrom(GetPostingSite(context->state),
+                                  nu::MessageLoop::Priority::Normal,
+                                  std::move(task));
+  }
+  static void PostTaskWithPriority(CallContext* context,
+                                   nu::MessageLoop::Priority priority,
+                                   nu::MessageLoop::Task task) {
+    nu::MessageLoop::PostTaskFrom(GetPostingSite(context->state),
+                                  priority, std::move(task));
+  }
+  // Omitting the task in a coroutine sleeps the coroutine for |ms|.
+  static void PostDelayedTask(CallContext* context, int ms,
+                              AsyncCallback<void()> task) {
+    if (!task)
+      return;
+    nu::MessageLoop::SetTimeoutFrom(GetPostingSite(context->state),
+                                    ms, std::move(task));
+  }
+  static void PostUnthrottledDelayedTask(CallContext* context, int ms,
+                                         AsyncCallback<void()> task) {
+    if (!task)
+      return;
+    nu::MessageLoop::SetTimeoutFrom(GetPostingSite(context->state),
+                                    ms, std::move(task), false);
+  }
+  static void PostIdleTask(CallContext* context,
+                           nu::MessageLoop::IdleTask task) {
+    nu::MessageLoop::PostIdleTaskFrom(GetPostingSite(context->state),
+                                      std::move(task));
+  }
+};
+
+template<>
+struct Type<nu::MessageLoopStats::LongTask> {
+  static constexpr const char* name = "MessageLoopLongTask";
+  static inline void Push(State* state,
+                          const nu::MessageLoopStats::LongTask& task) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "postedfrom", task.posted_from,
+                "queuedelay", task.queue_delay.InMillisecondsF(),
+                "runtime", task.run_time.InMillisecondsF());
+  }
+};
+
+template<>
+struct Type<nu::MessageLoopStats> {
+  static constexpr const char* name = "MessageLoopStats";
+  static inline void Push(State* state, const nu::MessageLoopStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "taskcount", stats.task_count,
+                "totalqueuedelay", stats.total_queue_delay.InMillisecondsF(),
+                "maxqueuedelay", stats.max_queue_delay.InMillisecondsF(),
+                "totalruntime", stats.total_run_time.InMillisecondsF(),
+                "maxruntime", stats.max_run_time.InMillisecondsF(),
+                "longtasks", stats.long_tasks);
+  }
+};
+
+template<>
+struct Type<nu::LayoutStats::MeasureStats> {
+  static constexpr const char* name = "LayoutMeasureStats";
+  static inline void Push(State* state,
+                          const nu::LayoutStats::MeasureStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "count", stats.count,
+                "duration", stats.duration.InMillisecondsF());
+  }
+};
+
+template<>
+struct Type<nu::LayoutStats> {
+  static constexpr const char* name = "LayoutStats";
+  static inline void Push(State* state, const nu::LayoutStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "layoutcount", stats.layout_count,
+                "totalduration", stats.total_duration.InMillisecondsF(),
+                "maxduration", stats.max_duration.InMillisecondsF(),
+                "nodesvisited", stats.nodes_visited,
+                "measures", stats.measures);
+  }
+};
+
+template<>
+struct Type<nu::StartupStats::Phase> {
+  static constexpr const char* name = "StartupPhase";
+  static inline void Push(State* state, const nu::StartupStats::Phase& phase) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "name", phase.name,
+                "start", phase.start.InMillisecondsF(),
+                "duration", phase.duration.InMillisecondsF());
+  }
+};
+
+template<>
+struct Type<nu::StartupStats> {
+  static constexpr const char* name = "StartupStats";
+  static inline void Push(State* state, const nu::StartupStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1, "phases", stats.phases);
+  }
+};
+
+template<>
+struct Type<nu::MemoryReport::Entry> {
+  static constexpr const char* name = "MemoryReportEntry";
+  static inline void Push(State* state, const nu::MemoryReport::Entry& entry) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "count", entry.count,
+                "bytes", static_cast<double>(entry.bytes));
+  }
+};
+
+template<>
+struct Type<nu::MemoryReport> {
+  static constexpr const char* name = "MemoryReport";
+  static inline void Push(State* state, const nu::MemoryReport& report) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "viewcount", report.view_count,
+                "views", report.views,
+                "yoganodecount", report.yoga_node_count,
+                "freeyoganodecount", report.free_yoga_node_count,
+                "recycledviewcount", report.recycled_view_count,
+                "images", report.images,
+                "fonts", report.fonts,
+                "attributedtexts", report.attributed_texts,
+                "canvases", report.canvases,
+                "tablemodelcount", report.table_model_count,
+                "tablerows", static_cast<double>(report.table_rows),
+                "tablecells", static_cast<double>(report.table_cells),
+                "protocolcacheentries", report.protocol_cache_entries,
+                "protocolcachebytes",
+                static_cast<double>(report.protocol_cache_bytes));
+  }
+};
+
+template<>
+struct Type<nu::PaintStats::Record> {
+  static constexpr const char* name = "PaintRecord";
+  static inline void Push(State* state, const nu::PaintStats::Record& record) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "windowtitle", record.window_title,
+                "starttime",
+                (record.start - base::TimeTicks()).InMillisecondsF(),
+                "duration", record.duration.InMillisecondsF(),
+                "dirtyarea", record.dirty_area,
+                "viewsdrawn", record.views_drawn,
+                "views", record.views,
+                "ondrawcount", record.on_draw_count,
+                "ondrawduration", record.on_draw_duration.InMillisecondsF());
+  }
+};
+
+template<>
+struct Type<nu::PaintStats> {
+  static constexpr const char* name = "PaintStats";
+  static inline void Push(State* state, const nu::PaintStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "paintcount", stats.paint_count,
+                "totalduration", stats.total_duration.InMillisecondsF(),
+                "maxduration", stats.max_duration.InMillisecondsF(),
+                "records", stats.records);
+  }
+};
+
+#if defined(OS_WIN)
+template<>
+struct Type<nu::WindowMessageStats::SlowMessage> {
+  static constexpr const char* name = "WindowSlowMessage";
+  static inline void Push(State* state,
+                          const nu::WindowMessageStats::SlowMessage& message) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "windowclass", message.window_class,
+                "message", message.message,
+                "starttime",
+                (message.start - base::TimeTicks()).InMillisecondsF(),
+                "duration", message.duration.InMillisecondsF());
+  }
+};
+
+template<>
+struct Type<nu::WindowMessageStats> {
+  static constexpr const char* name = "WindowMessageStats";
+  static inline void Push(State* state, const nu::WindowMessageStats& stats) {
+    lua::NewTable(state);
+    // The entries are pushed as a list since the keys are pairs.
+    lua::NewTable(state, static_cast<int>(stats.messages.size()), 0);
+    int i = 1;
+    for (const auto& it : stats.messages) {
+      lua::NewTable(state);
+      lua::RawSet(state, -1,
+                  "windowclass", it.first.first,
+                  "message", it.first.second,
+                  "count", it.second.count,
+                  "totalduration", it.second.total_duration.InMillisecondsF(),
+                  "maxduration", it.second.max_duration.InMillisecondsF());
+      lua_rawseti(state, -2, i++);
+    }
+    lua_setfield(state, -2, "messages");
+    lua::RawSet(state, -1, "slowmessages", stats.slow_messages);
+  }
+};
+#endif
+
+template<>
+struct Type<lua::ObjectStats> {
+  static constexpr const char* name = "ObjectStats";
+  static inline void Push(State* state, const lua::ObjectStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "count", stats.count,
+                "retainedbywrapper", stats.retained_by_wrapper);
+  }
+};
+
+template<>
+struct Type<lua::CallStats> {
+  static constexpr const char* name = "CallStats";
+  static inline void Push(State* state, const lua::CallStats& stats) {
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "calls", static_cast<double>(stats.calls),
+                "converttime", stats.convert_time.InMillisecondsF(),
+                "nativetime", stats.native_time.InMillisecondsF());
+  }
+};
+
+template<>
+struct Type<nu::LayoutTransaction> {
+  static constexpr const char* name = "LayoutTransaction";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "begin", &nu::LayoutTransaction::Begin,
+           "commit", &nu::LayoutTransaction::Commit,
+           "isactive", &nu::LayoutTransaction::IsActive,
+           "setdeferredlayout", &nu::LayoutTransaction::SetDeferredLayout,
+           "isdeferredlayout", &nu::LayoutTransaction::IsDeferredLayout,
+           "flush", &nu::LayoutTransaction::Flush);
+  }
+};
+
+template<>
+struct Type<nu::AsyncLayout> {
+  static constexpr const char* name = "AsyncLayout";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index, "compute", &nu::AsyncLayout::Compute);
   }
 };
 
@@ -325,6 +658,20 @@ template<>
 struct Type<nu::App> {
   static constexpr const char* name = "App";
   static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "prewarm", &nu::App::Prewarm,
+           "notifymemorypressure", &nu::App::NotifyMemoryPressure,
+           "isinbackground", &nu::App::IsInBackground,
+           "setbackgroundthrottlingenabled",
+           &nu::App::SetBackgroundThrottlingEnabled,
+           "isbackgroundthrottlingenabled",
+           &nu::App::IsBackgroundThrottlingEnabled,
+           "setbackgroundtimerinterval", &nu::App::SetBackgroundTimerInterval,
+           "getbackgroundtimerinterval", &nu::App::GetBackgroundTimerInterval);
+    RawSetProperty(state, metatable,
+                   "onmemorypressure", &nu::App::on_memory_pressure,
+                   "onenterbackground", &nu::App::on_enter_background,
+                   "onleavebackground", &nu::App::on_leave_background);
 #if defined(OS_MACOSX)
     RawSet(state, metatable,
            "setapplicationmenu",
@@ -359,9 +706,15 @@ struct Type<nu::AttributedText> {
            "setcolorfor", &SetColorFor,
 #endif
            "clear", &nu::AttributedText::Clear,
+           "replacetext", &ReplaceText,
+           "appendtext", &nu::AttributedText::AppendText,
            "getboundsfor", &nu::AttributedText::GetBoundsFor,
            "gettext", &nu::AttributedText::GetText);
   }
+  static void ReplaceText(nu::AttributedText* text, int start, int end,
+                          const std::string& str) {
+    text->ReplaceText(start - 1, end <= 0 ? end : end - 1, str);
+  }
 #if !defined(OS_WIN)
   static void SetFontFor(nu::AttributedText* text, nu::Font* font,
                          int start, int end) {
@@ -479,16 +832,44 @@ struct Type<nu::Font> {
   static constexpr const char* name = "Font";
   static void BuildMetaTable(State* state, int index) {
     RawSet(state, index,
-           "create", &CreateOnHeap<nu::Font, const std::string&, float,
-                                   nu::Font::Weight, nu::Font::Style>,
+           "create", &nu::Font::Get,
            "createfrompath", &CreateOnHeap<nu::Font, const base::FilePath&,
                                            float>,
+           "loadasync", &nu::Font::LoadAsync,
+           "loadsetasync", &nu::Font::LoadSetAsync,
            "default", &nu::Font::Default,
            "derive", &nu::Font::Derive,
            "getname", &nu::Font::GetName,
            "getsize", &nu::Font::GetSize,
            "getweight", &nu::Font::GetWeight,
-           "getstyle", &nu::Font::GetStyle);
+           "getstyle", &nu::Font::GetStyle,
+           "measurestrings", &nu::Font::MeasureStrings);
+  }
+};
+
+template<>
+struct Type<nu::Image::EncodeOptions> {
+  static constexpr const char* name = "ImageEncodeOptions";
+  static inline bool To(State* state, int index,
+                        nu::Image::EncodeOptions* out) {
+    if (GetType(state, index) == LuaType::Table)
+      RawGetAndPop(state, index, "quality", &out->quality);
+    return true;
+  }
+};
+
+template<>
+struct Type<nu::CanvasPixels> {
+  static constexpr const char* name = "CanvasPixels";
+  static inline void Push(State* state, const nu::CanvasPixels& pixels) {
+    // The memory is passed as light userdata without copying.
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "data", pixels.buffer.content(),
+                "size", static_cast<int>(pixels.buffer.size()),
+                "width", pixels.size.width(),
+                "height", pixels.size.height(),
+                "stride", pixels.stride);
   }
 };
 
@@ -501,7 +882,58 @@ struct Type<nu::Canvas> {
            "createformainscreen", &CreateOnHeap<nu::Canvas, const nu::SizeF&>,
            "getscalefactor", &nu::Canvas::GetScaleFactor,
            "getpainter", &nu::Canvas::GetPainter,
-           "getsize", &nu::Canvas::GetSize);
+           "getsize", &nu::Canvas::GetSize,
+           "lockpixels", &nu::Canvas::LockPixels,
+           "unlockpixels", &nu::Canvas::UnlockPixels,
+           "encodeasync", &nu::Canvas::EncodeAsync);
+  }
+};
+
+template<>
+struct Type<nu::DisplayList> {
+  static constexpr const char* name = "DisplayList";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "create", &CreateOnHeap<nu::DisplayList>,
+           "getpainter", &nu::DisplayList::GetPainter,
+           "replay", &nu::DisplayList::Replay,
+           "clear", &nu::DisplayList::Clear,
+           "getopcount", &nu::DisplayList::GetOpCount,
+           "isempty", &nu::DisplayList::IsEmpty);
+  }
+};
+
+template<>
+struct Type<nu::Path> {
+  static constexpr const char* name = "Path";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "create", &CreateOnHeap<nu::Path>,
+           "moveto", &nu::Path::MoveTo,
+           "lineto", &nu::Path::LineTo,
+           "beziercurveto", &nu::Path::BezierCurveTo,
+           "arc", &nu::Path::Arc,
+           "rect", &nu::Path::Rect,
+           "closepath", &nu::Path::ClosePath,
+           "clear", &nu::Path::Clear,
+           "isempty", &nu::Path::IsEmpty);
+  }
+};
+
+template<>
+struct Type<nu::MonospaceTextRenderer> {
+  static constexpr const char* name = "MonospaceTextRenderer";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "create", &CreateOnHeap<nu::MonospaceTextRenderer,
+                                   nu::Font*, nu::Color, float>,
+           "drawtext", &nu::MonospaceTextRenderer::DrawText,
+           "measuretext", &nu::MonospaceTextRenderer::MeasureText,
+           "getcellsize", &nu::MonospaceTextRenderer::GetCellSize,
+           "getglyphcount", &nu::MonospaceTextRenderer::GetGlyphCount,
+           "getfont", &nu::MonospaceTextRenderer::GetFont,
+           "getcolor", &nu::MonospaceTextRenderer::GetColor,
+           "getscalefactor", &nu::MonospaceTextRenderer::GetScaleFactor);
   }
 };
 
@@ -647,11 +1079,26 @@ struct Type<nu::Clipboard> {
            "isdataavailable", &nu::Clipboard::IsDataAvailable,
            "getdata", &nu::Clipboard::GetData,
            "setdata", &nu::Clipboard::SetData,
+           "setdataprovider", &nu::Clipboard::SetDataProvider,
+           "getdatasize", &GetDataSize,
+           "readdata", &ReadData,
            "startwatching", &nu::Clipboard::StartWatching,
            "stopwatching", &nu::Clipboard::StopWatching);
     RawSetProperty(state, index,
                    "onchange", &nu::Clipboard::on_change);
   }
+  static double GetDataSize(nu::Clipboard* clipboard,
+                            nu::Clipboard::Data::Type type) {
+    return static_cast<double>(clipboard->GetDataSize(type));
+  }
+  static bool ReadData(nu::Clipboard* clipboard,
+                       nu::Clipboard::Data::Type type,
+                       const std::function<bool(const nu::Buffer&)>& reader) {
+    // The chunk is only valid during the call.
+    return clipboard->ReadData(type, [&reader](const char* chunk, size_t size) {
+      return reader(nu::Buffer::Wrap(chunk, size));
+    });
+  }
 };
 
 template<>
@@ -690,7 +1137,7 @@ struct Type<nu::Color> {
     std::string hex;
     if (!lua::To(state, index, &hex))
       return false;
-    *out = nu::Color(hex);
+    *out = nu::Color::FromHexCached(hex);
     return true;
   }
   static void BuildMetaTable(State* state, int metatable) {
@@ -756,7 +1203,7 @@ struct Type<nu::Cursor> {
   static constexpr const char* name = "Cursor";
   static void BuildMetaTable(State* state, int index) {
     RawSet(state, index,
-           "createwithtype", &CreateOnHeap<nu::Cursor, nu::Cursor::Type>);
+           "createwithtype", &nu::Cursor::CreateWithType);
   }
 };
 
@@ -771,8 +1218,22 @@ struct Type<nu::DraggingInfo> {
         "dragoperationlink", static_cast<int>(nu::DRAG_OPERATION_LINK),
         "isdataavailable", &nu::DraggingInfo::IsDataAvailable,
         "getdata", &nu::DraggingInfo::GetData,
+        "getdatasize", &GetDataSize,
+        "readdata", &ReadData,
         "getdragoperations", &nu::DraggingInfo::GetDragOperations);
   }
+  static double GetDataSize(nu::DraggingInfo* info,
+                            nu::Clipboard::Data::Type type) {
+    return static_cast<double>(info->GetDataSize(type));
+  }
+  static bool ReadData(nu::DraggingInfo* info,
+                       nu::Clipboard::Data::Type type,
+                       const std::function<bool(const nu::Buffer&)>& reader) {
+    // The chunk is only valid during the call.
+    return info->ReadData(type, [&reader](const char* chunk, size_t size) {
+      return reader(nu::Buffer::Wrap(chunk, size));
+    });
+  }
 };
 
 template<>
@@ -788,6 +1249,20 @@ struct Type<nu::DragOptions> {
   }
 };
 
+template<>
+struct Type<nu::Image::DecodeOptions> {
+  static constexpr const char* name = "ImageDecodeOptions";
+  static inline bool To(State* state, int index,
+                        nu::Image::DecodeOptions* out) {
+    if (GetType(state, index) == LuaType::Table) {
+      RawGetAndPop(state, index,
+                   "size", &out->size,
+                   "scalefactor", &out->scale_factor);
+    }
+    return true;
+  }
+};
+
 template<>
 struct Type<nu::Image> {
   static constexpr const char* name = "Image";
@@ -798,9 +1273,49 @@ struct Type<nu::Image> {
            "createfrombuffer", &CreateOnHeap<nu::Image,
                                              const nu::Buffer&,
                                              float>,
+           "decodefrompathasync", &DecodeFromPathAsync,
+           "decodefrombufferasync", &DecodeFromBufferAsync,
            "isempty", &nu::Image::IsEmpty,
            "getsize", &nu::Image::GetSize,
-           "getscalefactor", &nu::Image::GetScaleFactor);
+           "getscalefactor", &nu::Image::GetScaleFactor,
+           "createresized", &nu::Image::CreateResized,
+           "setmipmapenabled", &nu::Image::SetMipmapEnabled,
+           "ismipmapenabled", &nu::Image::IsMipmapEnabled,
+           "encodeasync", &nu::Image::EncodeAsync);
+  }
+  static void DecodeFromPathAsync(const base::FilePath& path,
+                                  const nu::Image::DecodeOptions& options,
+                                  nu::Image::DecodeCallback callback) {
+    nu::Image::DecodeAsync(path, options, std::move(callback));
+  }
+  static void DecodeFromBufferAsync(const nu::Buffer& buffer,
+                                    const nu::Image::DecodeOptions& options,
+                                    nu::Image::DecodeCallback callback) {
+    nu::Image::DecodeAsync(buffer, options, std::move(callback));
+  }
+};
+
+template<>
+struct Type<nu::ImageCache> {
+  static constexpr const char* name = "ImageCache";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "get", &nu::ImageCache::Get,
+           "getasync", &nu::ImageCache::GetAsync,
+           "setbudget", &SetBudget,
+           "getbudget", &GetBudget,
+           "getusage", &GetUsage,
+           "onmemorypressure", &nu::ImageCache::OnMemoryPressure,
+           "clear", &nu::ImageCache::Clear);
+  }
+  static void SetBudget(nu::ImageCache* cache, double bytes) {
+    cache->SetBudget(static_cast<size_t>(std::max(0., bytes)));
+  }
+  static double GetBudget(nu::ImageCache* cache) {
+    return static_cast<double>(cache->GetBudget());
+  }
+  static double GetUsage(nu::ImageCache* cache) {
+    return static_cast<double>(cache->GetUsage());
   }
 };
 
@@ -896,6 +1411,8 @@ struct Type<nu::Painter> {
            "setlinewidth", &nu::Painter::SetLineWidth,
            "stroke", &nu::Painter::Stroke,
            "fill", &nu::Painter::Fill,
+           "strokepath", &nu::Painter::StrokePath,
+           "fillpath", &nu::Painter::FillPath,
            "clear", &nu::Painter::Clear,
            "strokerect", &nu::Painter::StrokeRect,
            "fillrect", &nu::Painter::FillRect,
@@ -904,7 +1421,25 @@ struct Type<nu::Painter> {
            "drawcanvas", &nu::Painter::DrawCanvas,
            "drawcanvasfromrect", &nu::Painter::DrawCanvasFromRect,
            "drawattributedtext", &nu::Painter::DrawAttributedText,
-           "drawtext", &nu::Painter::DrawText);
+           "drawtext", &nu::Painter::DrawText,
+           "execute", &Execute);
+  }
+  // Read the commands from an array of numbers.
+  static bool Execute(CallContext* context, nu::Painter* painter) {
+    State* state = context->state;
+    if (GetType(state, 2) != LuaType::Table) {
+      Push(state, "The arg 2 should be table of numbers");
+      context->has_error = true;
+      return false;
+    }
+    size_t size = RawLen(state, 2);
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      lua_rawgeti(state, 2, static_cast<lua_Integer>(i + 1));
+      data[i] = static_cast<float>(lua_tonumber(state, -1));
+      lua_pop(state, 1);
+    }
+    return painter->Execute(data.data(), data.size());
   }
 };
 
@@ -956,13 +1491,55 @@ struct Type<nu::Event> {
            "ismetapressed", &nu::Event::IsMetaPressed);
   }
   // Used by subclasses.
-  static void SetEventProperties(State* state,
-                                 int index,
-                                 const nu::Event* event) {
-    RawSet(state, index,
-           "type", event->type,
-           "modifiers", event->modifiers,
-           "timestamp", event->timestamp);
+  static bool PushField(State* state,
+                        const nu::Event& event,
+                        base::StringPiece key) {
+    if (key == "type")
+      lua::Push(state, event.type);
+    else if (key == "modifiers")
+      lua::Push(state, event.modifiers);
+    else if (key == "timestamp")
+      lua::Push(state, event.timestamp);
+    else
+      return false;
+    return true;
+  }
+};
+
+// Events are pushed as userdata keeping a copy of the event, and the fields
+// are only converted when accessed, so frequent events like mouse moves do
+// not create tables for every field.
+template<typename T>
+struct EventUserData {
+  static void Push(State* state, const T& event) {
+    new(lua_newuserdata(state, sizeof(T))) T(event);
+    PushMetaTable(state);
+    SetMetaTable(state, -2);
+  }
+
+ private:
+  static void PushMetaTable(State* state) {
+    // The address is used as the registry key of the metatable.
+    static char key;
+    lua_rawgetp(state, LUA_REGISTRYINDEX, &key);
+    if (GetType(state, -1) == LuaType::Table)
+      return;
+    PopAndIgnore(state, 1);
+    NewTable(state, 0, 3);
+    RawSet(state, -1,
+           "__name", Type<T>::name,
+           "__gc", CFunction(&DestructOnGC<T>),
+           "__index", CFunction(&Index));
+    lua_pushvalue(state, -1);
+    lua_rawsetp(state, LUA_REGISTRYINDEX, &key);
+  }
+
+  static int Index(State* state) {
+    const auto* event = static_cast<const T*>(lua_touserdata(state, 1));
+    const char* key = lua_tostring(state, 2);
+    if (!key || !Type<T>::PushField(state, *event, key))
+      lua::PushNil(state);
+    return 1;
   }
 };
 
@@ -971,12 +1548,22 @@ struct Type<nu::MouseEvent> {
   using base = nu::Event;
   static constexpr const char* name = "MouseEvent";
   static inline void Push(State* state, const nu::MouseEvent& event) {
-    NewTable(state);
-    Type<nu::Event>::SetEventProperties(state, -1, &event);
-    RawSet(state, -1,
-           "button", event.button,
-           "positioninview", event.position_in_view,
-           "positioninwindow", event.position_in_window);
+    EventUserData<nu::MouseEvent>::Push(state, event);
+  }
+  static bool PushField(State* state,
+                        const nu::MouseEvent& event,
+                        base::StringPiece key) {
+    if (key == "button")
+      lua::Push(state, event.button);
+    else if (key == "positioninview")
+      lua::Push(state, event.position_in_view);
+    else if (key == "positioninwindow")
+      lua::Push(state, event.position_in_window);
+    else if (key == "coalescedpositions")
+      lua::Push(state, event.coalesced_positions);
+    else
+      return Type<nu::Event>::PushField(state, event, key);
+    return true;
   }
 };
 
@@ -993,10 +1580,16 @@ struct Type<nu::KeyEvent> {
   using base = nu::Event;
   static constexpr const char* name = "KeyEvent";
   static inline void Push(State* state, const nu::KeyEvent& event) {
-    NewTable(state);
-    Type<nu::Event>::SetEventProperties(state, -1, &event);
-    RawSet(state, -1,
-           "key", event.key);
+    EventUserData<nu::KeyEvent>::Push(state, event);
+  }
+  static bool PushField(State* state,
+                        const nu::KeyEvent& event,
+                        base::StringPiece key) {
+    if (key == "key")
+      lua::Push(state, event.key);
+    else
+      return Type<nu::Event>::PushField(state, event, key);
+    return true;
   }
 };
 
@@ -1034,12 +1627,16 @@ struct Type<nu::FileDialog> {
            "getresult", &nu::FileDialog::GetResult,
            "run", &nu::FileDialog::Run,
            "runforwindow", &nu::FileDialog::RunForWindow,
+           "show", &nu::FileDialog::Show,
+           "showforwindow", &nu::FileDialog::ShowForWindow,
            "settitle", &nu::FileDialog::SetTitle,
            "setbuttonlabel", &nu::FileDialog::SetButtonLabel,
            "setfilename", &nu::FileDialog::SetFilename,
            "setfolder", &nu::FileDialog::SetFolder,
            "setoptions", &nu::FileDialog::SetOptions,
            "setfilters", &nu::FileDialog::SetFilters);
+    RawSetProperty(state, metatable,
+                   "onresponse", &nu::FileDialog::on_response);
   }
 };
 
@@ -1072,8 +1669,14 @@ struct Type<nu::MenuBase> {
            "append", RefMethod(&nu::MenuBase::Append, RefType::Ref),
            "insert", RefMethod(&Insert, RefType::Ref),
            "remove", RefMethod(&nu::MenuBase::Remove, RefType::Deref),
+           "appendtemplate", &AppendTemplate,
            "itemcount", &nu::MenuBase::ItemCount,
            "itemat", &ItemAt);
+    RawSetProperty(state, metatable,
+                   "onitemclick", &nu::MenuBase::on_item_click);
+  }
+  static inline void AppendTemplate(nu::MenuBase* menu, ::base::Value items) {
+    menu->AppendTemplate(items);
   }
   static inline void Insert(nu::MenuBase* menu, nu::MenuItem* item, int i) {
     menu->Insert(item, i - 1);
@@ -1091,13 +1694,19 @@ struct Type<nu::MenuBar> {
   static constexpr const char* name = "MenuBar";
   static void BuildMetaTable(State* state, int metatable) {
     RawSet(state, metatable,
-           "create", &Create);
+           "create", &Create,
+           "createfromtemplate", &CreateFromTemplate);
   }
   static nu::MenuBar* Create(CallContext* context) {
     nu::MenuBar* menu = new nu::MenuBar;
     ReadMenuItems(context->state, context->current_arg, menu);
     return menu;
   }
+  static nu::MenuBar* CreateFromTemplate(::base::Value items) {
+    nu::MenuBar* menu = new nu::MenuBar;
+    menu->AppendTemplate(items);
+    return menu;
+  }
 };
 
 template<>
@@ -1107,6 +1716,7 @@ struct Type<nu::Menu> {
   static void BuildMetaTable(State* state, int metatable) {
     RawSet(state, metatable,
            "create", &Create,
+           "createfromtemplate", &CreateFromTemplate,
            "popup", &nu::Menu::Popup);
   }
   static nu::Menu* Create(CallContext* context) {
@@ -1114,6 +1724,11 @@ struct Type<nu::Menu> {
     ReadMenuItems(context->state, context->current_arg, menu);
     return menu;
   }
+  static nu::Menu* CreateFromTemplate(::base::Value items) {
+    nu::Menu* menu = new nu::Menu;
+    menu->AppendTemplate(items);
+    return menu;
+  }
 };
 
 template<>
@@ -1197,7 +1812,9 @@ struct Type<nu::MenuItem> {
            "isvisible", &nu::MenuItem::IsVisible,
            "setsubmenu", &nu::MenuItem::SetSubmenu,
            "getsubmenu", &nu::MenuItem::GetSubmenu,
-           "setaccelerator", &nu::MenuItem::SetAccelerator);
+           "setaccelerator", &nu::MenuItem::SetAccelerator,
+           "setid", &nu::MenuItem::SetId,
+           "getid", &nu::MenuItem::GetId);
     RawSetProperty(state, index,
                    "onclick", &nu::MenuItem::on_click);
   }
@@ -1300,9 +1917,7 @@ struct Type<nu::MessageBox> {
            "create", &CreateOnHeap<nu::MessageBox>,
            "run", &nu::MessageBox::Run,
            "runforwindow", &nu::MessageBox::RunForWindow,
-#if defined(OS_LINUX) || defined(OS_WIN)
            "show", &nu::MessageBox::Show,
-#endif
            "showforwindow", &nu::MessageBox::ShowForWindow,
            "close", &nu::MessageBox::Close,
            "settype", &nu::MessageBox::SetType,
@@ -1343,6 +1958,7 @@ struct Type<nu::Tray> {
            "settitle", &nu::Tray::SetTitle,
 #endif
            "setimage", &nu::Tray::SetImage,
+           "setimagefromcanvas", &nu::Tray::SetImageFromCanvas,
 #if defined(OS_MAC)
            "setpressedimage", &nu::Tray::SetPressedImage,
 #endif
@@ -1428,6 +2044,10 @@ struct Type<nu::Window::Options> {
 #if defined(OS_MACOSX)
       RawGetAndPop(state, index,
                    "showtrafficlights", &out->show_traffic_lights);
+#elif defined(OS_WIN)
+      RawGetAndPop(state, index, "direct2d", &out->direct2d);
+      RawGetAndPop(state, index,
+                   "directcomposition", &out->direct_composition);
 #endif
     }
     return true;
@@ -1447,6 +2067,7 @@ struct Type<nu::Window> {
            "setcontentview",
            RefMethod(&nu::Window::SetContentView, RefType::Reset, "content"),
            "getcontentview", &nu::Window::GetContentView,
+           "preparecontentview", &nu::Window::PrepareContentView,
            "setcontentsize", &nu::Window::SetContentSize,
            "getcontentsize", &nu::Window::GetContentSize,
            "setbounds", &nu::Window::SetBounds,
@@ -1470,6 +2091,7 @@ struct Type<nu::Window> {
            "minimize", &nu::Window::Minimize,
            "restore", &nu::Window::Restore,
            "isminimized", &nu::Window::IsMinimized,
+           "isoccluded", &nu::Window::IsOccluded,
            "setresizable", &nu::Window::SetResizable,
            "isresizable", &nu::Window::IsResizable,
            "setmaximizable", &nu::Window::SetMaximizable,
@@ -1499,7 +2121,19 @@ struct Type<nu::Window> {
            RefMethod(&nu::Window::AddChildWindow, RefType::Ref),
            "removechildview",
            RefMethod(&nu::Window::RemoveChildWindow, RefType::Deref),
-           "getchildwindows", &nu::Window::GetChildWindows);
+           "getchildwindows", &nu::Window::GetChildWindows,
+           "requestframe", &nu::Window::RequestFrame,
+           "cancelframe", &nu::Window::CancelFrame,
+           "setliveresizethrottled", &nu::Window::SetLiveResizeThrottled,
+           "isliveresizethrottled", &nu::Window::IsLiveResizeThrottled,
+           "setliveresizeapproximated",
+           &nu::Window::SetLiveResizeApproximated,
+           "isliveresizeapproximated", &nu::Window::IsLiveResizeApproximated,
+           "isinliveresize", &nu::Window::IsInLiveResize,
+           "setlayoutdeferreduntilshown",
+           &nu::Window::SetLayoutDeferredUntilShown,
+           "islayoutdeferreduntilshown",
+           &nu::Window::IsLayoutDeferredUntilShown);
     RawSetProperty(state, metatable,
                    "onclose", &nu::Window::on_close,
                    "onfocus", &nu::Window::on_focus,
@@ -1508,6 +2142,21 @@ struct Type<nu::Window> {
   }
 };
 
+template<>
+struct Type<nu::StyleSheet> {
+  static constexpr const char* name = "StyleSheet";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable, "create", &Create);
+  }
+  static nu::StyleSheet* Create(
+      const std::map<std::string, std::string>& styles) {
+    nu::StyleSheet* sheet = new nu::StyleSheet;
+    for (const auto& it : styles)
+      sheet->SetProperty(it.first, it.second);
+    return sheet;
+  }
+};
+
 template<>
 struct Type<nu::View> {
   static constexpr const char* name = "View";
@@ -1522,6 +2171,7 @@ struct Type<nu::View> {
            "schedulepaintrect", &nu::View::SchedulePaintRect,
            "setvisible", &nu::View::SetVisible,
            "isvisible", &nu::View::IsVisible,
+           "isonscreen", &nu::View::IsOnScreen,
            "setenabled", &nu::View::SetEnabled,
            "isenabled", &nu::View::IsEnabled,
            "focus", &nu::View::Focus,
@@ -1533,6 +2183,8 @@ struct Type<nu::View> {
            "hascapture", &nu::View::HasCapture,
            "setmousedowncanmovewindow", &nu::View::SetMouseDownCanMoveWindow,
            "ismousedowncanmovewindow", &nu::View::IsMouseDownCanMoveWindow,
+           "setcoalescemousemove", &nu::View::SetCoalesceMouseMove,
+           "iscoalescemousemove", &nu::View::IsCoalesceMouseMove,
            "dodrag", &nu::View::DoDrag,
            "dodragwithoptions", &nu::View::DoDragWithOptions,
            "canceldrag", &nu::View::CancelDrag,
@@ -1543,11 +2195,18 @@ struct Type<nu::View> {
            "setcolor", &nu::View::SetColor,
            "setbackgroundcolor", &nu::View::SetBackgroundColor,
            "setstyle", &SetStyle,
+           "set", CFunction(&SetProperties),
+           "applystyle", &nu::View::ApplyStyle,
            "getcomputedlayout", &nu::View::GetComputedLayout,
            "getminimumsize", &nu::View::GetMinimumSize,
+           "rendertocanvas", &nu::View::RenderToCanvas,
+           "setlayerbacked", &nu::View::SetLayerBacked,
+           "islayerbacked", &nu::View::IsLayerBacked,
 #if defined(OS_MACOSX)
            "setwantslayer", &nu::View::SetWantsLayer,
            "wantslayer", &nu::View::WantsLayer,
+           "setdrawsasynchronously", &nu::View::SetDrawsAsynchronously,
+           "drawsasynchronously", &nu::View::DrawsAsynchronously,
 #endif
            "getparent", &nu::View::GetParent,
            "getwindow", &nu::View::GetWindow);
@@ -1572,7 +2231,53 @@ struct Type<nu::View> {
       view->SetStyleProperty(it.first, it.second);
     view->Layout();
   }
+  // Call the setter of each property in the table, for example "text" calls
+  // "settext", and only do layout once for all of them.
+  static int SetProperties(State* state) {
+    luaL_checktype(state, 2, LUA_TTABLE);
+    bool success = true;
+    nu::LayoutTransaction::Begin();
+    lua_pushnil(state);
+    while (lua_next(state, 2) != 0) {
+      if (lua_type(state, -2) != LUA_TSTRING) {
+        PushFormatedString(state, "property name must be string");
+        success = false;
+        break;
+      }
+      std::string setter = "set" + base::ToLowerASCII(lua_tostring(state, -2));
+      lua_getfield(state, 1, setter.c_str());
+      if (lua_type(state, -1) != LUA_TFUNCTION) {
+        PushFormatedString(state, "unknown property %s",
+                           lua_tostring(state, -3));
+        success = false;
+        break;
+      }
+      lua_pushvalue(state, 1);
+      lua_pushvalue(state, -3);
+      if (lua_pcall(state, 2, 0, 0) != LUA_OK) {
+        success = false;
+        break;
+      }
+      lua_pop(state, 1);
+    }
+    nu::LayoutTransaction::Commit();
+    if (!success)
+      lua_error(state);
+    return 0;
+  }
 };
+
+template<>
+struct Type<nu::ViewTemplate> {
+  static constexpr const char* name = "ViewTemplate";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &nu::ViewTemplate::Create,
+           "instantiate", &nu::ViewTemplate::Instantiate,
+           "getviewcount", &nu::ViewTemplate::GetViewCount);
+  }
+};
+
 template<>
 struct Type<nu::ComboBox> {
   using base = nu::Picker;
@@ -1583,7 +2288,8 @@ struct Type<nu::ComboBox> {
            "settext", &nu::ComboBox::SetText,
            "gettext", &nu::ComboBox::GetText);
     RawSetProperty(state, index,
-                   "ontextchange", &nu::ComboBox::on_text_change);
+                   "ontextchange", &nu::ComboBox::on_text_change,
+                   "getitemsfortext", &nu::ComboBox::get_items_for_text);
   }
 };
 
@@ -1593,7 +2299,7 @@ struct Type<nu::Container> {
   static constexpr const char* name = "Container";
   static void BuildMetaTable(State* state, int index) {
     RawSet(state, index,
-           "create", &CreateOnHeap<nu::Container>,
+           "create", &Create,
            "getpreferredsize", &nu::Container::GetPreferredSize,
            "getpreferredwidthforheight",
            &nu::Container::GetPreferredWidthForHeight,
@@ -1606,9 +2312,24 @@ struct Type<nu::Container> {
            "removechildview",
            RefMethod(&nu::Container::RemoveChildView, RefType::Deref),
            "childcount", &nu::Container::ChildCount,
-           "childat", &ChildAt);
+           "childat", &ChildAt,
+#if defined(OS_MACOSX)
+           "settrackchildrenhover", &nu::Container::SetTrackChildrenHover,
+           "istrackchildrenhover", &nu::Container::IsTrackChildrenHover,
+#endif
+           "setdisplaylist", &nu::Container::SetDisplayList,
+           "getdisplaylist", &nu::Container::GetDisplayList,
+           "setthreadedrendering", &nu::Container::SetThreadedRendering,
+           "isthreadedrendering", &nu::Container::IsThreadedRendering);
     RawSetProperty(state, index, "ondraw", &nu::Container::on_draw);
   }
+  static scoped_refptr<nu::Container> Create() {
+    scoped_refptr<nu::View> view =
+        nu::State::GetCurrent()->ReuseView(nu::Container::kClassName);
+    if (view)
+      return static_cast<nu::Container*>(view.get());
+    return new nu::Container;
+  }
   // Transalte 1-based index to 0-based.
   static inline void AddChildViewAt(nu::Container* c, nu::View* view, int i) {
     c->AddChildViewAt(view, i - 1);
@@ -1742,6 +2463,9 @@ template<>
 struct Type<nu::ProtocolJob> {
   static constexpr const char* name = "ProtocolJob";
   static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "setcachecontrol", &nu::ProtocolJob::SetCacheControl,
+           "getcachecontrol", &nu::ProtocolJob::GetCacheControl);
   }
 };
 
@@ -1781,6 +2505,7 @@ struct Type<nu::ProtocolAsarJob> {
   }
 };
 
+#if defined(BROWSER_SUPPORT)
 template<>
 struct Type<nu::Browser::Options> {
   static constexpr const char* name = "BrowserOptions";
@@ -1804,6 +2529,17 @@ struct Type<nu::Browser::Options> {
   }
 };
 
+template<>
+struct Type<nu::BrowserReply> {
+  static constexpr const char* name = "BrowserReply";
+  static void BuildMetaTable(State* state, int index) {
+    RawSet(state, index,
+           "resolve", &nu::BrowserReply::Resolve,
+           "reject", &nu::BrowserReply::Reject,
+           "isdone", &nu::BrowserReply::IsDone);
+  }
+};
+
 template<>
 struct Type<nu::Browser> {
   using base = nu::View;
@@ -1811,14 +2547,21 @@ struct Type<nu::Browser> {
   static void BuildMetaTable(State* state, int metatable) {
     RawSet(state, metatable,
            "create", &CreateOnHeap<nu::Browser, nu::Browser::Options>,
+           "prewarm", &nu::Browser::Prewarm,
+           "acquire", &nu::Browser::Acquire,
            "registerprotocol", &nu::Browser::RegisterProtocol,
            "unregisterprotocol", &nu::Browser::UnregisterProtocol,
+           "setprotocolcachebudget", &SetProtocolCacheBudget,
+           "getprotocolcachebudget", &GetProtocolCacheBudget,
+           "getprotocolcacheusage", &GetProtocolCacheUsage,
+           "clearprotocolcache", &nu::Browser::ClearProtocolCache,
            "loadurl", &nu::Browser::LoadURL,
            "loadhtml", &nu::Browser::LoadHTML,
            "geturl", &nu::Browser::GetURL,
            "gettitle", &nu::Browser::GetTitle,
            "setuseragent", &nu::Browser::SetUserAgent,
-           "executejavascript", &nu::Browser::ExecuteJavaScript,
+           "executejavascript", &ExecuteJavaScript,
+           "executejavascriptraw", &ExecuteJavaScriptRaw,
            "goback", &nu::Browser::GoBack,
            "cangoback", &nu::Browser::CanGoBack,
            "goforward", &nu::Browser::GoForward,
@@ -1829,7 +2572,17 @@ struct Type<nu::Browser> {
            "setbindingname", &nu::Browser::SetBindingName,
            "addbinding", &AddBinding,
            "addrawbinding", &nu::Browser::AddRawBinding,
-           "removebinding", &nu::Browser::RemoveBinding);
+           "addbufferbinding", &nu::Browser::AddBufferBinding,
+           "addasyncbinding", &nu::Browser::AddAsyncBinding,
+           "removebinding", &nu::Browser::RemoveBinding,
+           "createbufferurl", &CreateBufferURL,
+           "revokebufferurl", &nu::Browser::RevokeBufferURL,
+           "pushmessage",
+           static_cast<void(nu::Browser::*)(const base::Value&)>(
+               &nu::Browser::PushMessage),
+           "pushbuffer",
+           static_cast<void(nu::Browser::*)(const nu::Buffer&)>(
+               &nu::Browser::PushMessage));
     RawSetProperty(state, metatable,
                    "onclose", &nu::Browser::on_close,
                    "onupdatecommand", &nu::Browser::on_update_command,
@@ -1840,6 +2593,37 @@ struct Type<nu::Browser> {
                    "onfinishnavigation", &nu::Browser::on_finish_navigation,
                    "onfailnavigation", &nu::Browser::on_fail_navigation);
   }
+  static void SetProtocolCacheBudget(double bytes) {
+    nu::Browser::SetProtocolCacheBudget(
+        static_cast<size_t>(std::max(0., bytes)));
+  }
+  static double GetProtocolCacheBudget() {
+    return static_cast<double>(nu::Browser::GetProtocolCacheBudget());
+  }
+  static double GetProtocolCacheUsage() {
+    return static_cast<double>(nu::Browser::GetProtocolCacheUsage());
+  }
+  static void ExecuteJavaScript(nu::Browser* browser,
+                                const std::string& code,
+                                AsyncCallback<void(bool, base::Value)> cb) {
+    browser->ExecuteJavaScript(code, std::move(cb));
+  }
+  static void ExecuteJavaScriptRaw(nu::Browser* browser,
+                                   const std::string& code,
+                                   AsyncCallback<void(bool, std::string)> cb) {
+    browser->ExecuteJavaScriptRaw(code, std::move(cb));
+  }
+  static std::string CreateBufferURL(nu::Browser* browser,
+                                     const nu::Buffer& buffer,
+                                     const std::string& mime_type) {
+    // The converted buffer does not own its memory, so keep a copy.
+    std::string* copy = new std::string(static_cast<char*>(buffer.content()),
+                                        buffer.size());
+    return browser->CreateBufferURL(
+        nu::Buffer::TakeOver(&(*copy)[0], copy->size(),
+                             [copy](void*) { delete copy; }),
+        mime_type);
+  }
   static void AddBinding(CallContext* context,
                          nu::Browser* browser,
                          const std::string& name) {
@@ -1861,6 +2645,8 @@ struct Type<nu::Browser> {
   }
 };
 
+#endif
+
 template<>
 struct Type<nu::Entry::Type> {
   static constexpr const char* name = "EntryType";
@@ -1887,10 +2673,18 @@ struct Type<nu::Entry> {
            "create", &CreateOnHeap<nu::Entry>,
            "createtype", &CreateOnHeap<nu::Entry, nu::Entry::Type>,
            "settext", &nu::Entry::SetText,
-           "gettext", &nu::Entry::GetText);
+           "gettext", &nu::Entry::GetText,
+           "settextchangedebounce", &nu::Entry::SetTextChangeDebounce,
+           "gettextchangedebounce", &nu::Entry::GetTextChangeDebounce,
+           "settextchangethrottle", &nu::Entry::SetTextChangeThrottle,
+           "gettextchangethrottle", &nu::Entry::GetTextChangeThrottle,
+           "setignorecomposition", &nu::Entry::SetIgnoreComposition,
+           "isignoringcomposition", &nu::Entry::IsIgnoringComposition,
+           "iscomposing", &nu::Entry::IsComposing);
     RawSetProperty(state, metatable,
                    "onactivate", &nu::Entry::on_activate,
-                   "ontextchange", &nu::Entry::on_text_change);
+                   "ontextchange", &nu::Entry::on_text_change,
+                   "ontextrangechange", &nu::Entry::on_text_range_change);
   }
 };
 
@@ -1900,7 +2694,7 @@ struct Type<nu::Label> {
   static constexpr const char* name = "Label";
   static void BuildMetaTable(State* state, int metatable) {
     RawSet(state, metatable,
-           "create", &CreateOnHeap<nu::Label, const std::string&>,
+           "create", &Create,
            "createwithattributedtext",
            &CreateOnHeap<nu::Label, nu::AttributedText*>,
            "settext", &nu::Label::SetText,
@@ -1911,6 +2705,15 @@ struct Type<nu::Label> {
            RefMethod(&nu::Label::SetAttributedText, RefType::Reset, "atext"),
            "getattributedtext", &nu::Label::GetAttributedText);
   }
+  static scoped_refptr<nu::Label> Create(const std::string& text) {
+    scoped_refptr<nu::View> view =
+        nu::State::GetCurrent()->ReuseView(nu::Label::kClassName);
+    if (!view)
+      return new nu::Label(text);
+    auto* label = static_cast<nu::Label*>(view.get());
+    label->SetText(text);
+    return label;
+  }
 };
 
 template<>
@@ -1935,6 +2738,7 @@ struct Type<nu::Picker> {
     RawSet(state, metatable,
            "create", &CreateOnHeap<nu::Picker>,
            "additem", &nu::Picker::AddItem,
+           "setitems", &nu::Picker::SetItems,
            "removeitemat", &RemoveItemAt,
            "getitems", &nu::Picker::GetItems,
            "selectitemat", &SelectItemAt,
@@ -2049,8 +2853,41 @@ struct Type<nu::Scroll> {
            "setOverlayScrollbar", &nu::Scroll::SetOverlayScrollbar,
            "isOverlayScrollbar", &nu::Scroll::IsOverlayScrollbar,
 #endif
+           "setscrollposition", &nu::Scroll::SetScrollPosition,
+           "setscrollpositionanimated",
+           &nu::Scroll::SetScrollPositionAnimated,
+           "getscrollposition", &nu::Scroll::GetScrollPosition,
+           "getmaximumscrollposition", &nu::Scroll::GetMaximumScrollPosition,
            "setscrollbarpolicy", &nu::Scroll::SetScrollbarPolicy,
            "getscrollbarpolicy", &nu::Scroll::GetScrollbarPolicy);
+    RawSetProperty(state, metatable, "onscroll", &nu::Scroll::on_scroll,
+                   "onscrollend", &nu::Scroll::on_scroll_end);
+  }
+};
+
+template<>
+struct Type<nu::VirtualList> {
+  using base = nu::Scroll;
+  static constexpr const char* name = "VirtualList";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::VirtualList>,
+           "setitemcount", &nu::VirtualList::SetItemCount,
+           "getitemcount", &nu::VirtualList::GetItemCount,
+           "setestimateditemheight", &nu::VirtualList::SetEstimatedItemHeight,
+           "getestimateditemheight", &nu::VirtualList::GetEstimatedItemHeight,
+           "setoverscan", &nu::VirtualList::SetOverscan,
+           "getoverscan", &nu::VirtualList::GetOverscan,
+           "reloaddata", &nu::VirtualList::ReloadData,
+           "reloaditem", &nu::VirtualList::ReloadItem,
+           "scrolltoitem", &nu::VirtualList::ScrollToItem,
+           "getvisiblerange", &nu::VirtualList::GetVisibleRange,
+           "getitemview", &nu::VirtualList::GetItemView);
+    RawSetProperty(state, metatable,
+                   "createitem", &nu::VirtualList::create_item,
+                   "binditem", &nu::VirtualList::bind_item,
+                   "recycleitem", &nu::VirtualList::recycle_item,
+                   "measureitem", &nu::VirtualList::measure_item);
   }
 };
 
@@ -2092,6 +2929,10 @@ struct Type<nu::Tab> {
            "create", &CreateOnHeap<nu::Tab>,
            "addpage", RefMethod(&nu::Tab::AddPage, RefType::Ref),
            "removePage", RefMethod(&nu::Tab::RemovePage, RefType::Deref),
+           "addlazypage", &nu::Tab::AddLazyPage,
+           "ispageloaded", &nu::Tab::IsPageLoaded,
+           "setmaxloadedpages", &nu::Tab::SetMaxLoadedPages,
+           "getmaxloadedpages", &nu::Tab::GetMaxLoadedPages,
            "pagecount", &nu::Tab::PageCount,
            "pageat", &PageAt,
            "selectpageat", &SelectPageAt,
@@ -2122,7 +2963,11 @@ struct Type<nu::TableModel> {
            "getvalue", &GetValue,
            "notifyrowinsertion", &NotifyRowInsertion,
            "notifyrowdeletion", &NotifyRowDeletion,
-           "notifyvaluechange", &NotifyValueChange);
+           "notifyvaluechange", &NotifyValueChange,
+           "notifyrowsinserted", &NotifyRowsInserted,
+           "notifyrowsdeleted", &NotifyRowsDeleted,
+           "notifyrangechanged", &NotifyRangeChanged,
+           "notifyreset", &nu::TableModel::NotifyReset);
   }
   static void SetValue(nu::TableModel* model,
                        uint32_t column,
@@ -2144,6 +2989,18 @@ struct Type<nu::TableModel> {
                               uint32_t module, uint32_t row) {
     model->NotifyValueChange(module - 1, row - 1);
   }
+  static void NotifyRowsInserted(nu::TableModel* model,
+                                 uint32_t start, uint32_t count) {
+    model->NotifyRowsInserted(start - 1, count);
+  }
+  static void NotifyRowsDeleted(nu::TableModel* model,
+                                uint32_t start, uint32_t count) {
+    model->NotifyRowsDeleted(start - 1, count);
+  }
+  static void NotifyRangeChanged(nu::TableModel* model,
+                                 uint32_t start, uint32_t count) {
+    model->NotifyRangeChanged(start - 1, count);
+  }
 };
 
 template<>
@@ -2155,13 +3012,39 @@ struct Type<nu::AbstractTableModel> {
     RawSetProperty(state, metatable,
                    "getrowcount", &nu::AbstractTableModel::get_row_count,
                    "setvalue", &nu::AbstractTableModel::set_value,
-                   "getvalue", &nu::AbstractTableModel::get_value);
+                   "getvalue", &nu::AbstractTableModel::get_value,
+                   "getrows", &nu::AbstractTableModel::get_rows);
   }
   static nu::AbstractTableModel* Create() {
     return new nu::AbstractTableModel(false /* index_starts_from_0 */);
   }
 };
 
+template<>
+struct Type<nu::PagedTableModel> {
+  using base = nu::TableModel;
+  static constexpr const char* name = "PagedTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "setrowcount", &nu::PagedTableModel::SetRowCount,
+           "setrows", &nu::PagedTableModel::SetRows,
+           "setplaceholder", &nu::PagedTableModel::SetPlaceholder,
+           "setmaxcachedpages", &nu::PagedTableModel::SetMaxCachedPages,
+           "invalidate", &nu::PagedTableModel::Invalidate,
+           "isrowloaded", &IsRowLoaded);
+    RawSetProperty(state, metatable,
+                   "loadrows", &nu::PagedTableModel::load_rows);
+  }
+  static nu::PagedTableModel* Create(uint32_t row_count, uint32_t page_size) {
+    return new nu::PagedTableModel(row_count, page_size,
+                                   false /* index_starts_from_0 */);
+  }
+  static bool IsRowLoaded(nu::PagedTableModel* model, uint32_t row) {
+    return model->IsRowLoaded(row - 1);
+  }
+};
+
 template<>
 struct Type<nu::SimpleTableModel> {
   using base = nu::TableModel;
@@ -2170,11 +3053,115 @@ struct Type<nu::SimpleTableModel> {
     RawSet(state, metatable,
            "create", &CreateOnHeap<nu::SimpleTableModel, uint32_t>,
            "addrow", &nu::SimpleTableModel::AddRow,
-           "removerowat", &RemoveRowAt);
+           "removerowat", &RemoveRowAt,
+           "addrows", &nu::SimpleTableModel::AddRows,
+           "removerowsat", &RemoveRowsAt);
   }
   static void RemoveRowAt(nu::SimpleTableModel* model, uint32_t row) {
     model->RemoveRowAt(row - 1);
   }
+  static void RemoveRowsAt(nu::SimpleTableModel* model,
+                           uint32_t start, uint32_t count) {
+    model->RemoveRowsAt(start - 1, count);
+  }
+};
+
+template<>
+struct Type<nu::TableModelView> {
+  using base = nu::TableModel;
+  static constexpr const char* name = "TableModelView";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::TableModelView,
+                                   scoped_refptr<nu::TableModel>>,
+           "getsource", &nu::TableModelView::GetSource,
+           "setfilter", &SetFilter,
+           "sort", &Sort,
+           "sortasync", &SortAsync,
+           "clearsort", &nu::TableModelView::ClearSort,
+           "getsortcolumn", &GetSortColumn,
+           "issortascending", &nu::TableModelView::IsSortAscending,
+           "maptosource", &MapToSource,
+           "mapfromsource", &MapFromSource);
+  }
+  static void SetFilter(nu::TableModelView* view,
+                        std::function<bool(nu::TableModel*, uint32_t)> f) {
+    if (!f) {
+      view->SetFilter(nullptr);
+      return;
+    }
+    view->SetFilter([f](nu::TableModel* source, uint32_t row) {
+      return f(source, row + 1);
+    });
+  }
+  static void Sort(nu::TableModelView* view, uint32_t column, bool ascending) {
+    view->Sort(column - 1, ascending);
+  }
+  static void SortAsync(nu::TableModelView* view, uint32_t column,
+                        bool ascending, std::function<void()> callback) {
+    view->SortAsync(column - 1, ascending, std::move(callback));
+  }
+  static int GetSortColumn(nu::TableModelView* view) {
+    int column = view->GetSortColumn();
+    return column < 0 ? -1 : column + 1;
+  }
+  static uint32_t MapToSource(nu::TableModelView* view, uint32_t row) {
+    return view->MapToSource(row - 1) + 1;
+  }
+  static int MapFromSource(nu::TableModelView* view, uint32_t row) {
+    int result = view->MapFromSource(row - 1);
+    return result < 0 ? -1 : result + 1;
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel::ColumnType> {
+  static constexpr const char* name = "ColumnarTableModelColumnType";
+  static inline bool To(State* state, int index,
+                        nu::ColumnarTableModel::ColumnType* out) {
+    std::string type;
+    if (!lua::To(state, index, &type))
+      return false;
+    if (type == "int64") {
+      *out = nu::ColumnarTableModel::ColumnType::Int64;
+      return true;
+    } else if (type == "double") {
+      *out = nu::ColumnarTableModel::ColumnType::Double;
+      return true;
+    } else if (type == "bool") {
+      *out = nu::ColumnarTableModel::ColumnType::Bool;
+      return true;
+    } else if (type == "string") {
+      *out = nu::ColumnarTableModel::ColumnType::String;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel> {
+  using base = nu::TableModel;
+  static constexpr const char* name = "ColumnarTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::ColumnarTableModel,
+                                   std::vector<
+                                       nu::ColumnarTableModel::ColumnType>>,
+           "addrow", &nu::ColumnarTableModel::AddRow,
+           "removerowat", &RemoveRowAt,
+           "addrows", &nu::ColumnarTableModel::AddRows,
+           "removerowsat", &RemoveRowsAt,
+           "reserve", &nu::ColumnarTableModel::Reserve);
+  }
+  static void RemoveRowAt(nu::ColumnarTableModel* model, uint32_t row) {
+    model->RemoveRowAt(row - 1);
+  }
+  static void RemoveRowsAt(nu::ColumnarTableModel* model,
+                           uint32_t start, uint32_t count) {
+    model->RemoveRowsAt(start - 1, count);
+  }
 };
 
 template<>
@@ -2199,6 +3186,31 @@ struct Type<nu::Table::ColumnType> {
   }
 };
 
+template<>
+struct Type<nu::Table::ScrollAlign> {
+  static constexpr const char* name = "TableScrollAlign";
+  static inline bool To(State* state, int index, nu::Table::ScrollAlign* out) {
+    std::string align;
+    if (!lua::To(state, index, &align))
+      return false;
+    if (align == "nearest") {
+      *out = nu::Table::ScrollAlign::Nearest;
+      return true;
+    } else if (align == "start") {
+      *out = nu::Table::ScrollAlign::Start;
+      return true;
+    } else if (align == "center") {
+      *out = nu::Table::ScrollAlign::Center;
+      return true;
+    } else if (align == "end") {
+      *out = nu::Table::ScrollAlign::End;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
 template<>
 struct Type<nu::Table::ColumnOptions> {
   static constexpr const char* name = "TableColumnOptions";
@@ -2236,7 +3248,11 @@ struct Type<nu::Table> {
            "setrowheight", &nu::Table::SetRowHeight,
            "getrowheight", &nu::Table::GetRowHeight,
            "selectrow", &SelectRow,
-           "getselectedrow", &GetSelectedRow);
+           "getselectedrow", &GetSelectedRow,
+           "getvisiblerowrange", &GetVisibleRowRange,
+           "scrolltorow", &ScrollToRow);
+    RawSetProperty(state, metatable,
+                   "onvisiblerangechange", &nu::Table::on_visible_range_change);
   }
   static void SelectRow(nu::Table* table, int row) {
     table->SelectRow(row - 1);
@@ -2245,6 +3261,133 @@ struct Type<nu::Table> {
     int index = table->GetSelectedRow();
     return index == -1 ? -1 : index + 1;
   }
+  // Return the first and last visible rows.
+  static std::tuple<int, int> GetVisibleRowRange(nu::Table* table) {
+    int start, end;
+    std::tie(start, end) = table->GetVisibleRowRange();
+    if (start == -1)
+      return std::make_tuple(-1, -1);
+    return std::make_tuple(start + 1, end);
+  }
+  static void ScrollToRow(nu::Table* table, int row,
+                          nu::Table::ScrollAlign align) {
+    table->ScrollToRow(row - 1, align);
+  }
+};
+
+template<>
+struct Type<nu::TreeModel> {
+  static constexpr const char* name = "TreeModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "getchildcount", &nu::TreeModel::GetChildCount,
+           "getchild", &GetChild,
+           "haschildren", &nu::TreeModel::HasChildren,
+           "getvalue", &GetValue,
+           "notifychildreninserted", &NotifyChildrenInserted,
+           "notifychildrendeleted", &NotifyChildrenDeleted,
+           "notifynodechanged", &nu::TreeModel::NotifyNodeChanged,
+           "notifychildrenreset", &nu::TreeModel::NotifyChildrenReset);
+  }
+  static uint32_t GetChild(nu::TreeModel* model,
+                           uint32_t parent, uint32_t index) {
+    return model->GetChild(parent, index - 1);
+  }
+  static const base::Value* GetValue(
+      nu::TreeModel* model, uint32_t node, uint32_t column) {
+    return model->GetValue(node, column - 1);
+  }
+  static void NotifyChildrenInserted(nu::TreeModel* model, uint32_t parent,
+                                     uint32_t start, uint32_t count) {
+    model->NotifyChildrenInserted(parent, start - 1, count);
+  }
+  static void NotifyChildrenDeleted(nu::TreeModel* model, uint32_t parent,
+                                    uint32_t start, uint32_t count) {
+    model->NotifyChildrenDeleted(parent, start - 1, count);
+  }
+};
+
+template<>
+struct Type<nu::AbstractTreeModel> {
+  using base = nu::TreeModel;
+  static constexpr const char* name = "AbstractTreeModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable, "create", &Create);
+    RawSetProperty(state, metatable,
+                   "getchildcount", &nu::AbstractTreeModel::get_child_count,
+                   "getchild", &nu::AbstractTreeModel::get_child,
+                   "haschildren", &nu::AbstractTreeModel::has_children,
+                   "getvalue", &nu::AbstractTreeModel::get_value);
+  }
+  static nu::AbstractTreeModel* Create() {
+    return new nu::AbstractTreeModel(false /* index_starts_from_0 */);
+  }
+};
+
+template<>
+struct Type<nu::SimpleTreeModel> {
+  using base = nu::TreeModel;
+  static constexpr const char* name = "SimpleTreeModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::SimpleTreeModel>,
+           "addnode", &nu::SimpleTreeModel::AddNode,
+           "addnodes", &nu::SimpleTreeModel::AddNodes,
+           "removenode", &nu::SimpleTreeModel::RemoveNode,
+           "setvalue", &SetValue,
+           "getparent", &nu::SimpleTreeModel::GetParent,
+           "getnodecount", &nu::SimpleTreeModel::GetNodeCount);
+  }
+  static void SetValue(nu::SimpleTreeModel* model, uint32_t node,
+                       uint32_t column, ::base::Value value) {
+    model->SetValue(node, column - 1, std::move(value));
+  }
+};
+
+template<>
+struct Type<nu::TreeView> {
+  using base = nu::View;
+  static constexpr const char* name = "TreeView";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::TreeView>,
+           "setmodel",
+           RefMethod(&nu::TreeView::SetModel, RefType::Reset, "model"),
+           "getmodel", &nu::TreeView::GetModel,
+           "addcolumn", &nu::TreeView::AddColumn,
+           "getcolumncount", &nu::TreeView::GetColumnCount,
+           "setcolumnsvisible", &nu::TreeView::SetColumnsVisible,
+           "iscolumnsvisible", &nu::TreeView::IsColumnsVisible,
+           "expandnode", &nu::TreeView::ExpandNode,
+           "collapsenode", &nu::TreeView::CollapseNode,
+           "isnodeexpanded", &nu::TreeView::IsNodeExpanded,
+           "selectnode", &nu::TreeView::SelectNode,
+           "getselectednode", &nu::TreeView::GetSelectedNode);
+    RawSetProperty(state, metatable,
+                   "onnodeexpand", &nu::TreeView::on_node_expand,
+                   "onnodecollapse", &nu::TreeView::on_node_collapse,
+                   "onselectionchange", &nu::TreeView::on_selection_change);
+  }
+};
+
+template<>
+struct Type<nu::TextEdit::RangeAttributes> {
+  static constexpr const char* name = "TextEditRangeAttributes";
+  static inline bool To(State* state, int index,
+                        nu::TextEdit::RangeAttributes* out) {
+    if (GetType(state, index) != LuaType::Table)
+      return false;
+    if (!RawGetAndPop(state, index, "start", &out->start) ||
+        !RawGetAndPop(state, index, "end", &out->end))
+      return false;
+    nu::Font* font;
+    if (RawGetAndPop(state, index, "font", &font))
+      out->font = font;
+    nu::Color color;
+    if (RawGetAndPop(state, index, "color", &color))
+      out->color = color;
+    return true;
+  }
 };
 
 template<>
@@ -2271,6 +3414,13 @@ struct Type<nu::TextEdit> {
            "inserttextat", &nu::TextEdit::InsertTextAt,
            "delete", &nu::TextEdit::Delete,
            "deleterange", &nu::TextEdit::DeleteRange,
+           "appendtext", &nu::TextEdit::AppendText,
+           "setmaxlines", &nu::TextEdit::SetMaxLines,
+           "getmaxlines", &nu::TextEdit::GetMaxLines,
+           "setautoscroll", &nu::TextEdit::SetAutoScroll,
+           "isautoscroll", &nu::TextEdit::IsAutoScroll,
+           "setattributesforranges", &nu::TextEdit::SetAttributesForRanges,
+           "clearattributesinrange", &nu::TextEdit::ClearAttributesInRange,
 #if !defined(OS_WIN)
            "setoverlayscrollbar", &nu::TextEdit::SetOverlayScrollbar,
 #endif
@@ -2278,6 +3428,7 @@ struct Type<nu::TextEdit> {
            "gettextbounds", &nu::TextEdit::GetTextBounds);
     RawSetProperty(state, metatable,
                    "ontextchange", &nu::TextEdit::on_text_change,
+                   "ontextrangechange", &nu::TextEdit::on_text_range_change,
                    "shouldinsertnewline",
                    &nu::TextEdit::should_insert_new_line);
   }
@@ -2362,17 +3513,277 @@ struct Type<nu::Vibrant> {
 
 }  // namespace lua
 
+namespace {
+
+void SetLayoutStatsEnabled(bool enabled) {
+  nu::State::GetCurrent()->SetLayoutStatsEnabled(enabled);
+}
+
+nu::LayoutStats GetLayoutStats() {
+  return nu::State::GetCurrent()->GetLayoutStats();
+}
+
+void ResetLayoutStats() {
+  nu::State::GetCurrent()->ResetLayoutStats();
+}
+
+void SetMessageLoopStatsEnabled(bool enabled) {
+  nu::State::GetCurrent()->SetMessageLoopStatsEnabled(enabled);
+}
+
+nu::MessageLoopStats GetMessageLoopStats() {
+  return nu::State::GetCurrent()->GetMessageLoopStats();
+}
+
+void ResetMessageLoopStats() {
+  nu::State::GetCurrent()->ResetMessageLoopStats();
+}
+
+nu::MemoryReport GetMemoryReport() {
+  return nu::State::GetCurrent()->GetMemoryReport();
+}
+
+nu::StartupStats GetStartupStats() {
+  return nu::State::GetStartupStats();
+}
+
+void SetPaintStatsEnabled(bool enabled) {
+  nu::State::GetCurrent()->SetPaintStatsEnabled(enabled);
+}
+
+nu::PaintStats GetPaintStats() {
+  return nu::State::GetCurrent()->GetPaintStats();
+}
+
+void ResetPaintStats() {
+  nu::State::GetCurrent()->ResetPaintStats();
+}
+
+std::string GetPaintTrace() {
+  return nu::State::GetCurrent()->GetPaintStats().ToTraceJSON();
+}
+
+void StartTracing(const std::string& categories) {
+  nu::TraceLog::GetInstance()->Clear();
+  nu::TraceLog::GetInstance()->Start(categories);
+}
+
+void StopTracing() {
+  nu::TraceLog::GetInstance()->Stop();
+}
+
+std::string GetTrace() {
+  return nu::TraceLog::GetInstance()->ToTraceJSON();
+}
+
+#if defined(OS_WIN)
+void SetWindowMessageStatsEnabled(bool enabled) {
+  nu::State::GetCurrent()->SetWindowMessageStatsEnabled(enabled);
+}
+
+nu::WindowMessageStats GetWindowMessageStats() {
+  return nu::State::GetCurrent()->GetWindowMessageStats();
+}
+
+void ResetWindowMessageStats() {
+  nu::State::GetCurrent()->ResetWindowMessageStats();
+}
+#endif
+
+// Wrappers that are garbage but not collected yet are also counted, so call
+// collectgarbage() before reading the stats.
+std::map<std::string, lua::ObjectStats> GetObjectStats(lua::State* state) {
+  return lua::GetObjectStats(state);
+}
+
+void SetCallStatsEnabled(bool enabled) {
+  lua::SetCallStatsEnabled(enabled);
+}
+
+std::map<std::string, lua::CallStats> GetCallStats() {
+  return lua::GetCallStats();
+}
+
+void ResetCallStats() {
+  lua::ResetCallStats();
+}
+
+void SetLongTaskThreshold(float ms) {
+  nu::State::GetCurrent()->SetLongTaskThreshold(
+      base::TimeDelta::FromMillisecondsD(ms));
+}
+
+void SetViewRecycleLimit(uint32_t limit) {
+  nu::State::GetCurrent()->SetViewRecycleLimit(limit);
+}
+
 template<typename T>
-inline void BindType(lua::State* state, const char* name) {
-  int top = lua::GetTop(state);
+void BindType(lua::State* state, int exports, const char* name) {
+  lua::StackAutoReset reset(state);
   lua::Push(state, name);
   lua::Push(state, lua::MetaTable<T>());
   // Reference the nu::State object so it is freed at last.
-  lua::RawSet(state, -1, "__state", lua::ValueOnStack(state, top - 1));
+  lua::RawGet(state, exports, "__state_ptr");
+  lua::RawSet(state, -2, "__state", lua::ValueOnStack(state, -1));
+  lua_pop(state, 1);
   // Assign to exports table.
-  lua_rawset(state, top);
+  lua_rawset(state, exports);
 }
 
+// The classes exported in yue.gui.
+struct Binding {
+  const char* name;
+  void (*bind)(lua::State* state, int exports, const char* name);
+};
+
+const Binding kBindings[] = {
+  {"Lifetime", &BindType<nu::Lifetime>},
+  {"MessageLoop", &BindType<nu::MessageLoop>},
+  {"LayoutTransaction", &BindType<nu::LayoutTransaction>},
+  {"AsyncLayout", &BindType<nu::AsyncLayout>},
+  {"App", &BindType<nu::App>},
+  {"ImageCache", &BindType<nu::ImageCache>},
+  {"AttributedText", &BindType<nu::AttributedText>},
+  {"Font", &BindType<nu::Font>},
+  {"Canvas", &BindType<nu::Canvas>},
+  {"Clipboard", &BindType<nu::Clipboard>},
+  {"Color", &BindType<nu::Color>},
+  {"Cursor", &BindType<nu::Cursor>},
+  {"DisplayList", &BindType<nu::DisplayList>},
+  {"Path", &BindType<nu::Path>},
+  {"MonospaceTextRenderer", &BindType<nu::MonospaceTextRenderer>},
+  {"DraggingInfo", &BindType<nu::DraggingInfo>},
+  {"Image", &BindType<nu::Image>},
+  {"Painter", &BindType<nu::Painter>},
+  {"Event", &BindType<nu::Event>},
+  {"FileDialog", &BindType<nu::FileDialog>},
+  {"FileOpenDialog", &BindType<nu::FileOpenDialog>},
+  {"FileSaveDialog", &BindType<nu::FileSaveDialog>},
+  {"MenuBar", &BindType<nu::MenuBar>},
+  {"Menu", &BindType<nu::Menu>},
+  {"MenuItem", &BindType<nu::MenuItem>},
+  {"MessageBox", &BindType<nu::MessageBox>},
+  {"Window", &BindType<nu::Window>},
+  {"ComboBox", &BindType<nu::ComboBox>},
+  {"Container", &BindType<nu::Container>},
+  {"Button", &BindType<nu::Button>},
+  {"ProtocolStringJob", &BindType<nu::ProtocolStringJob>},
+  {"ProtocolFileJob", &BindType<nu::ProtocolFileJob>},
+  {"ProtocolAsarJob", &BindType<nu::ProtocolAsarJob>},
+#if defined(BROWSER_SUPPORT)
+  {"Browser", &BindType<nu::Browser>},
+  {"BrowserReply", &BindType<nu::BrowserReply>},
+#endif
+  {"Entry", &BindType<nu::Entry>},
+  {"Label", &BindType<nu::Label>},
+  {"StyleSheet", &BindType<nu::StyleSheet>},
+  {"ViewTemplate", &BindType<nu::ViewTemplate>},
+  {"Picker", &BindType<nu::Picker>},
+  {"ProgressBar", &BindType<nu::ProgressBar>},
+  {"GifPlayer", &BindType<nu::GifPlayer>},
+  {"Group", &BindType<nu::Group>},
+  {"Screen", &BindType<nu::Screen>},
+  {"Scroll", &BindType<nu::Scroll>},
+  {"Separator", &BindType<nu::Separator>},
+  {"Slider", &BindType<nu::Slider>},
+  {"Tab", &BindType<nu::Tab>},
+  {"TableModel", &BindType<nu::TableModel>},
+  {"AbstractTableModel", &BindType<nu::AbstractTableModel>},
+  {"PagedTableModel", &BindType<nu::PagedTableModel>},
+  {"SimpleTableModel", &BindType<nu::SimpleTableModel>},
+  {"ColumnarTableModel", &BindType<nu::ColumnarTableModel>},
+  {"TableModelView", &BindType<nu::TableModelView>},
+  {"Table", &BindType<nu::Table>},
+  {"TextEdit", &BindType<nu::TextEdit>},
+  {"Tray", &BindType<nu::Tray>},
+  {"TreeModel", &BindType<nu::TreeModel>},
+  {"AbstractTreeModel", &BindType<nu::AbstractTreeModel>},
+  {"SimpleTreeModel", &BindType<nu::SimpleTreeModel>},
+  {"TreeView", &BindType<nu::TreeView>},
+  {"VirtualList", &BindType<nu::VirtualList>},
+#if defined(OS_MACOSX)
+  {"Toolbar", &BindType<nu::Toolbar>},
+  {"Vibrant", &BindType<nu::Vibrant>},
+#endif
+};
+
+bool g_lazy_bindings = false;
+
+// The __index of exports table when bindings are lazy, the metatable of class
+// is built when it is first accessed.
+int LazyBindingsIndex(lua::State* state) {
+  const char* key = lua_tostring(state, 2);
+  if (key) {
+    for (const Binding& binding : kBindings) {
+      if (strcmp(binding.name, key) == 0) {
+        binding.bind(state, 1, binding.name);
+        lua::RawGet(state, 1, key);
+        return 1;
+      }
+    }
+  }
+  lua::PushNil(state);
+  return 1;
+}
+
+// Run incremental garbage collection in the idle time after frames, so the
+// collector does less work in the middle of animations.
+class IdleGarbageCollector {
+ public:
+  // Bytes allocated since last collection before starting a new one in idle
+  // time, in KB.
+  static const int kMinGrowth = 256;
+
+  // The work done by each step, in KB.
+  static const int kStepSize = 16;
+
+  explicit IdleGarbageCollector(lua::State* state)
+      : state_(state),
+        last_count_(lua::CollectGarbage(state, lua::GCOp::Count)),
+        id_(nu::MessageLoop::AddFrameIdleHandler(
+            [this](double remaining) { Step(remaining); })) {}
+
+  ~IdleGarbageCollector() {
+    nu::MessageLoop::RemoveFrameIdleHandler(id_);
+  }
+
+ private:
+  void Step(double remaining) {
+    int count = lua::CollectGarbage(state_, lua::GCOp::Count);
+    if (!collecting_ && count - last_count_ < kMinGrowth)
+      return;
+    NU_TRACE_EVENT("binding", "Lua::IdleGC");
+    collecting_ = true;
+    base::TimeTicks deadline = base::TimeTicks::Now() +
+                               base::TimeDelta::FromMillisecondsD(remaining);
+    while (base::TimeTicks::Now() < deadline) {
+      // A cycle has finished.
+      if (lua::CollectGarbage(state_, lua::GCOp::Step, kStepSize)) {
+        collecting_ = false;
+        last_count_ = lua::CollectGarbage(state_, lua::GCOp::Count);
+        break;
+      }
+    }
+  }
+
+  lua::State* state_;
+  int last_count_;
+  bool collecting_ = false;
+  int id_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleGarbageCollector);
+};
+
+}  // namespace
+
+namespace yue {
+
+void SetLazyBindingsEnabled(bool enabled) {
+  g_lazy_bindings = enabled;
+}
+
+}  // namespace yue
+
 extern "C" int luaopen_yue_gui(lua::State* state) {
   // The exports table.
   lua::NewTable(state);
@@ -2384,61 +3795,59 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   lua::Push(state, "__state_ptr");
   lua::NewUserData<nu::State>(state);
   lua_rawset(state, -3);
+  // The module may be required in a coroutine, while the collector must
+  // live with the main thread.
+  lua_rawgeti(state, LUA_REGISTRYINDEX, LUA_RIDX_MAINTHREAD);
+  lua::State* main_thread = lua_tothread(state, -1);
+  lua::PopAndIgnore(state, 1);
+  lua::Push(state, "__idle_gc_ptr");
+  lua::NewUserData<IdleGarbageCollector>(state, main_thread);
+  lua_rawset(state, -3);
 
   // Classes.
-  BindType<nu::Lifetime>(state, "Lifetime");
-  BindType<nu::MessageLoop>(state, "MessageLoop");
-  BindType<nu::App>(state, "App");
-  BindType<nu::AttributedText>(state, "AttributedText");
-  BindType<nu::Font>(state, "Font");
-  BindType<nu::Canvas>(state, "Canvas");
-  BindType<nu::Clipboard>(state, "Clipboard");
-  BindType<nu::Color>(state, "Color");
-  BindType<nu::Cursor>(state, "Cursor");
-  BindType<nu::DraggingInfo>(state, "DraggingInfo");
-  BindType<nu::Image>(state, "Image");
-  BindType<nu::Painter>(state, "Painter");
-  BindType<nu::Event>(state, "Event");
-  BindType<nu::FileDialog>(state, "FileDialog");
-  BindType<nu::FileOpenDialog>(state, "FileOpenDialog");
-  BindType<nu::FileSaveDialog>(state, "FileSaveDialog");
-  BindType<nu::MenuBar>(state, "MenuBar");
-  BindType<nu::Menu>(state, "Menu");
-  BindType<nu::MenuItem>(state, "MenuItem");
-  BindType<nu::MessageBox>(state, "MessageBox");
-  BindType<nu::Window>(state, "Window");
-  BindType<nu::ComboBox>(state, "ComboBox");
-  BindType<nu::Container>(state, "Container");
-  BindType<nu::Button>(state, "Button");
-  BindType<nu::ProtocolStringJob>(state, "ProtocolStringJob");
-  BindType<nu::ProtocolFileJob>(state, "ProtocolFileJob");
-  BindType<nu::ProtocolAsarJob>(state, "ProtocolAsarJob");
-  BindType<nu::Browser>(state, "Browser");
-  BindType<nu::Entry>(state, "Entry");
-  BindType<nu::Label>(state, "Label");
-  BindType<nu::Picker>(state, "Picker");
-  BindType<nu::ProgressBar>(state, "ProgressBar");
-  BindType<nu::GifPlayer>(state, "GifPlayer");
-  BindType<nu::Group>(state, "Group");
-  BindType<nu::Screen>(state, "Screen");
-  BindType<nu::Scroll>(state, "Scroll");
-  BindType<nu::Separator>(state, "Separator");
-  BindType<nu::Slider>(state, "Slider");
-  BindType<nu::Tab>(state, "Tab");
-  BindType<nu::TableModel>(state, "TableModel");
-  BindType<nu::AbstractTableModel>(state, "AbstractTableModel");
-  BindType<nu::SimpleTableModel>(state, "SimpleTableModel");
-  BindType<nu::Table>(state, "Table");
-  BindType<nu::TextEdit>(state, "TextEdit");
-  BindType<nu::Tray>(state, "Tray");
-#if defined(OS_MACOSX)
-  BindType<nu::Toolbar>(state, "Toolbar");
-  BindType<nu::Vibrant>(state, "Vibrant");
-#endif
+  int exports = lua::GetTop(state);
+  if (g_lazy_bindings) {
+    lua::NewTable(state, 0, 1);
+    lua::RawSet(state, -1, "__index", lua::CFunction(&LazyBindingsIndex));
+    lua::SetMetaTable(state, exports);
+  } else {
+    for (const Binding& binding : kBindings)
+      binding.bind(state, exports, binding.name);
+  }
   // Properties.
   lua::RawSet(state, -1,
-              "lifetime", nu::Lifetime::GetCurrent(),
-              "app",      nu::App::GetCurrent(),
-              "screen",   nu::Screen::GetCurrent());
+              "lifetime",   nu::Lifetime::GetCurrent(),
+              "app",        nu::App::GetCurrent(),
+              "imagecache", nu::ImageCache::GetCurrent(),
+              "screen",     nu::Screen::GetCurrent());
+  // Functions.
+  lua::RawSet(state, -1,
+              "setlayoutstatsenabled", &SetLayoutStatsEnabled,
+              "getlayoutstats", &GetLayoutStats,
+              "resetlayoutstats", &ResetLayoutStats,
+              "setmessageloopstatsenabled", &SetMessageLoopStatsEnabled,
+              "getmessageloopstats", &GetMessageLoopStats,
+              "resetmessageloopstats", &ResetMessageLoopStats,
+              "setpaintstatsenabled", &SetPaintStatsEnabled,
+              "getpaintstats", &GetPaintStats,
+              "resetpaintstats", &ResetPaintStats,
+              "getpainttrace", &GetPaintTrace,
+              "starttracing", &StartTracing,
+              "stoptracing", &StopTracing,
+              "gettrace", &GetTrace,
+              "getobjectstats", &GetObjectStats,
+              "getmemoryreport", &GetMemoryReport,
+              "getstartupstats", &GetStartupStats,
+              "setcallstatsenabled", &SetCallStatsEnabled,
+              "getcallstats", &GetCallStats,
+              "resetcallstats", &ResetCallStats,
+              "setlongtaskthreshold", &SetLongTaskThreshold,
+              "setviewrecyclelimit", &SetViewRecycleLimit);
+#if defined(OS_WIN)
+  lua::RawSet(state, -1,
+              "setwindowmessagestatsenabled", &SetWindowMessageStatsEnabled,
+              "getwindowmessagestats", &GetWindowMessageStats,
+              "resetwindowmessagestats", &ResetWindowMessageStats);
+#endif
   return 1;
 }
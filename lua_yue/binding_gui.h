@@ -15,4 +15,13 @@
 
 extern "C" LUA_MODULE_EXPORT int luaopen_yue_gui(lua::State* state);
 
+namespace yue {
+
+// Build the metatables of classes in yue.gui when they are first accessed,
+// instead of when the module is loaded, which makes loading faster for apps
+// only using a few classes. Must be called before loading the module.
+void SetLazyBindingsEnabled(bool enabled);
+
+}  // namespace yue
+
 #endif  // LUA_YUE_BINDING_GUI_H_
@@ -27,3 +27,20 @@ TEST_F(YueGuiTest, CollectGarbageInCallback) {
       "end)\n"
       "gui.MessageLoop.run()");
 }
+
+TEST_F(YueGuiTest, SetProperties) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "local gui = require('yue.gui')\n"
+      "label = gui.Label.create('')\n"
+      "label:set{text = 'yue', visible = false, style = {flex = 1}}\n"
+      "return label:gettext(), label:isvisible()"));
+  bool visible = true;
+  std::string text;
+  ASSERT_TRUE(lua::Pop(state_, &text, &visible));
+  EXPECT_EQ(text, "yue");
+  EXPECT_FALSE(visible);
+  ASSERT_TRUE(luaL_dostring(state_, "label:set{nonexist = 1}"));
+  std::string error;
+  ASSERT_TRUE(lua::Pop(state_, &error));
+  EXPECT_EQ(error, "unknown property nonexist");
+}
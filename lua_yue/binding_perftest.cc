@@ -0,0 +1,135 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+
+#include "base/json/json_reader.h"
+#include "lua/lua.h"
+#include "lua_yue/binding_values.h"
+#include "lua_yue/builtin_loader.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kIterations = 100;
+
+// Number of times the benchmarked code runs in each iteration, so the cost of
+// entering Lua is not counted.
+const int kInnerLoop = 1000;
+
+}  // namespace
+
+class YueBindingPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    luaL_openlibs(state_);
+    yue::InsertBuiltinModuleLoader(state_);
+    ASSERT_FALSE(luaL_dostring(state_, "gui = require('yue.gui')"));
+  }
+
+  // Run |setup| once, and then time |body| which runs kInnerLoop times in
+  // each iteration.
+  void RunLuaPerfTest(const std::string& name,
+                      const std::string& setup,
+                      const std::string& body) {
+    ASSERT_FALSE(luaL_dostring(state_, setup.c_str()));
+    std::string code = "function bench()\n"
+                       "  for i = 1, " + std::to_string(kInnerLoop) + " do\n" +
+                       body + "\n"
+                       "  end\n"
+                       "end";
+    ASSERT_FALSE(luaL_dostring(state_, code.c_str()));
+    bool success = true;
+    nu::RunPerfTest(name, kIterations, [&](int) {
+      lua_getglobal(state_, "bench");
+      success &= lua::PCall(state_, nullptr);
+    });
+    EXPECT_TRUE(success);
+  }
+
+  lua::ManagedState state_;
+};
+
+// Methods defined in the metatable of the class itself.
+TEST_F(YueBindingPerfTest, MethodDispatchOwn) {
+  RunLuaPerfTest("LuaMethodDispatchOwn",
+                 "label = gui.Label.create('yue')",
+                 "label:gettext()");
+}
+
+// Methods found by walking the inheritance chain in InheritanceChainLookup.
+TEST_F(YueBindingPerfTest, MethodDispatchInherited) {
+  RunLuaPerfTest("LuaMethodDispatchInherited",
+                 "label = gui.Label.create('yue')",
+                 "label:isvisible()");
+}
+
+// Pushing objects that already have wrappers.
+TEST_F(YueBindingPerfTest, PushCachedObject) {
+  RunLuaPerfTest("LuaPushCachedObject",
+                 "container = gui.Container.create()\n"
+                 "container:addchildview(gui.Label.create('yue'))",
+                 "container:childat(1)");
+}
+
+// Creating objects and their wrappers.
+TEST_F(YueBindingPerfTest, CreateObject) {
+  RunLuaPerfTest("LuaCreateObject", "", "gui.Label.create('yue')");
+  lua::CollectGarbage(state_);
+}
+
+// Setting properties with the generic setter.
+TEST_F(YueBindingPerfTest, SetProperties) {
+  RunLuaPerfTest("LuaSetProperties",
+                 "label = gui.Label.create('')",
+                 "label:set{text = 'yue', visible = true}");
+}
+
+// Reading the cached signal properties.
+TEST_F(YueBindingPerfTest, GetSignalProperty) {
+  RunLuaPerfTest("LuaGetSignalProperty",
+                 "",
+                 "local signal = gui.app.onenterbackground");
+}
+
+// Assigning handlers to signal properties.
+TEST_F(YueBindingPerfTest, SetSignalProperty) {
+  RunLuaPerfTest("LuaSetSignalProperty",
+                 "label = gui.Label.create('')\n"
+                 "handler = function() end",
+                 "label.onmousedown = handler\n"
+                 "label.onmousedown:disconnectall()");
+}
+
+// Calling lua::Callback from Signal::Emit.
+TEST_F(YueBindingPerfTest, SignalEmit) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "count = 0\n"
+      "gui.app.onenterbackground = function(app) count = count + 1 end"));
+  nu::App* app = nu::App::GetCurrent();
+  nu::RunPerfTest("LuaSignalEmit", kIterations, [&](int) {
+    for (int i = 0; i < kInnerLoop; ++i)
+      app->on_enter_background.Emit(app);
+  });
+  app->on_enter_background.DisconnectAll();
+}
+
+// Converting base::Value to Lua tables and back.
+TEST_F(YueBindingPerfTest, ValueConversions) {
+  base::Optional<base::Value> value = base::JSONReader::Read(
+      "{\"name\": \"yue\", \"size\": [800, 600], \"visible\": true,"
+      " \"items\": [{\"id\": 1, \"text\": \"a\"}, {\"id\": 2, \"text\": \"b\"},"
+      " {\"id\": 3, \"text\": \"c\"}, {\"id\": 4, \"text\": \"d\"}]}");
+  ASSERT_TRUE(value);
+  nu::RunPerfTest("LuaValueConversions", kIterations, [&](int) {
+    for (int i = 0; i < kInnerLoop; ++i) {
+      lua::Push(state_, *value);
+      base::Value out;
+      lua::To(state_, -1, &out);
+      lua::PopAndIgnore(state_, 1);
+    }
+  });
+}
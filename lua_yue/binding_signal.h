@@ -9,6 +9,7 @@
 
 #include "lua/lua.h"
 #include "nativeui/signal.h"
+#include "nativeui/trace_event.h"
 
 namespace yue {
 
@@ -32,7 +33,8 @@ class SignalWrapper : public base::RefCounted<SignalWrapper<Sig>> {
           2, lua::GetTypeName(context->state, 2), "function");
       return -1;
     }
-    int id = signal_->Connect(slot);
+    int id = signal_->Connect(
+        nu::TraceSlot("binding", "SignalHandler", std::move(slot)));
     // self.__yuesignals[signal][id] = slot
     lua::PushRefsTable(context->state, "__yuesignals", -1);
     lua::RawGetOrCreateTable(context->state, -1, static_cast<void*>(signal_));
@@ -54,9 +56,18 @@ class SignalWrapper : public base::RefCounted<SignalWrapper<Sig>> {
     if (!PushOwner(context))
       return;
     signal_->DisconnectAll();
-    // self.__yuesignals[signal] = {}
-    lua::PushRefsTable(context->state, "__yuesignals", -1);
-    lua::RawSet(context->state, -1, static_cast<void*>(signal_), nullptr);
+    // Clear self.__yuesignals[signal] instead of replacing it, so handlers
+    // connected again later do not need a new table.
+    lua::State* state = context->state;
+    lua::PushRefsTable(state, "__yuesignals", -1);
+    lua::RawGetOrCreateTable(state, -1, static_cast<void*>(signal_));
+    lua_pushnil(state);
+    while (lua_next(state, -2) != 0) {
+      lua_pop(state, 1);
+      lua_pushvalue(state, -1);
+      lua_pushnil(state);
+      lua_rawset(state, -4);
+    }
   }
 
  private:
@@ -117,7 +128,8 @@ struct MemberTraits<nu::Signal<Sig>> {
     std::function<Sig> slot;
     if (!lua::ToWeakFunction(state, value, &slot))
       return false;
-    int id = out->Connect(slot);
+    int id = out->Connect(
+        nu::TraceSlot("binding", "SignalHandler", std::move(slot)));
     // self.__yuesignals[signal][id] = slot
     lua::PushRefsTable(state, "__yuesignals", owner);
     lua::RawGetOrCreateTable(state, -1, static_cast<void*>(out));
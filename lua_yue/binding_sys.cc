@@ -4,7 +4,15 @@
 
 #include "lua_yue/binding_sys.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "build/build_config.h"
+#include "lua_yue/binding_signal.h"
+#include "lua_yue/binding_values.h"
+#include "lua_yue/file_system.h"
+#include "lua_yue/worker.h"
 
 namespace {
 
@@ -19,10 +27,75 @@ namespace {
 #define PLATFORM "other"
 #endif
 
+// Paths are passed as UTF-8 strings in lua.
+base::FilePath ToFilePath(const std::string& path) {
+  return base::FilePath::FromUTF8Unsafe(path);
+}
+
+// The callbacks can be omitted in coroutines.
+void ReadFile(const std::string& path,
+              lua::AsyncCallback<void(const char*, base::StringPiece)> cb) {
+  yue::ReadFileAsync(ToFilePath(path), std::move(cb));
+}
+
+void WriteFile(const std::string& path,
+               std::string data,
+               lua::AsyncCallback<void(const char*)> callback) {
+  yue::WriteFileAsync(ToFilePath(path), std::move(data), std::move(callback));
+}
+
+void ReadDirectory(
+    const std::string& path,
+    lua::AsyncCallback<void(const char*, const std::vector<std::string>&)>
+        callback) {
+  yue::ReadDirectoryAsync(ToFilePath(path), std::move(callback));
+}
+
 }  // namespace
 
-extern "C" int luaopen_yue_sys(lua::State* state) {
+namespace lua {
+
+template<>
+struct Type<yue::Worker> {
+  static constexpr const char* name = "Worker";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<yue::Worker, const std::string&>,
+           "postmessage", &yue::Worker::Post,
+           "postbuffer", &PostBuffer,
+           "terminate", &yue::Worker::Terminate);
+    RawSetProperty(state, metatable,
+                   "onmessage", &yue::Worker::on_message,
+                   "onbuffer", &yue::Worker::on_buffer,
+                   "onerror", &yue::Worker::on_error);
+  }
+  // Lua strings can not outlive the call, so they are copied once into a
+  // buffer that is moved to the worker.
+  static void PostBuffer(yue::Worker* worker, base::StringPiece data) {
+    worker->PostBuffer(yue::CopyToBuffer(data));
+  }
+};
+
+}  // namespace lua
+
+namespace yue {
+
+int OpenSysInWorker(lua::State* state) {
   lua::NewTable(state);
   lua::RawSet(state, -1, "platform", PLATFORM);
   return 1;
 }
+
+}  // namespace yue
+
+extern "C" int luaopen_yue_sys(lua::State* state) {
+  yue::OpenSysInWorker(state);
+  // The file functions call back in the main thread, so they are not
+  // available in workers.
+  lua::RawSet(state, -1,
+              "Worker", lua::MetaTable<yue::Worker>(),
+              "readfile", &ReadFile,
+              "writefile", &WriteFile,
+              "readdir", &ReadDirectory);
+  return 1;
+}
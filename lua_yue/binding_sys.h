@@ -9,4 +9,11 @@
 
 extern "C" int luaopen_yue_sys(lua::State* state);
 
+namespace yue {
+
+// The yue.sys module in workers, which can not create workers.
+int OpenSysInWorker(lua::State* state);
+
+}  // namespace yue
+
 #endif  // LUA_YUE_BINDING_SYS_H_
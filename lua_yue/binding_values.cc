@@ -4,12 +4,8 @@
 
 #include "lua_yue/binding_values.h"
 
-#include <memory>
 #include <string>
 #include <utility>
-#include <vector>
-
-#include "base/memory/ptr_util.h"
 
 namespace lua {
 
@@ -30,6 +26,46 @@ bool IsTableArray(State* state, int index, size_t* size) {
   return true;
 }
 
+// Convert the array at |index| with |size| elements, the values are written
+// into the list directly.
+bool ToList(State* state, int index, size_t size, base::Value* out) {
+  base::Value::ListStorage storage;
+  storage.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    lua_rawgeti(state, index, static_cast<lua_Integer>(i + 1));
+    storage.emplace_back();
+    bool success = Type<base::Value>::To(state, -1, &storage.back());
+    lua_pop(state, 1);
+    if (!success)
+      return false;
+  }
+  *out = base::Value(std::move(storage));
+  return true;
+}
+
+// Convert the table at |index| to dictionary, the values are written into
+// the dictionary directly.
+bool ToDictionary(State* state, int index, base::Value* out) {
+  *out = base::Value(base::Value::Type::DICTIONARY);
+  StackAutoReset reset(state);
+  lua_pushnil(state);
+  while (lua_next(state, index) != 0) {
+    // Convert a copy of key, since converting number keys in place would
+    // confuse lua_next.
+    lua_pushvalue(state, -2);
+    size_t length = 0;
+    const char* key = lua_tolstring(state, -1, &length);
+    if (!key)
+      return false;
+    base::Value* value = out->SetKey(base::StringPiece(key, length),
+                                     base::Value());
+    if (!Type<base::Value>::To(state, -2, value))
+      return false;
+    lua_pop(state, 2);
+  }
+  return true;
+}
+
 }  // namespace
 
 // static
@@ -67,11 +103,11 @@ void Type<base::Value>::Push(State* state, const base::Value& value) {
       return;
     }
     case base::Value::Type::LIST: {
-      NewTable(state, static_cast<int>(value.GetList().size()), 0);
-      for (size_t i = 0; i < value.GetList().size(); ++i) {
-        lua::Push(state, static_cast<int>(i + 1));
-        Type<base::Value>::Push(state, value.GetList()[i]);
-        lua_rawset(state, -3);
+      const auto& list = value.GetList();
+      NewTable(state, static_cast<int>(list.size()), 0);
+      for (size_t i = 0; i < list.size(); ++i) {
+        Type<base::Value>::Push(state, list[i]);
+        lua_rawseti(state, -2, static_cast<lua_Integer>(i + 1));
       }
       return;
     }
@@ -91,32 +127,18 @@ bool Type<base::Value>::To(State* state, int index, base::Value* out) {
     case LuaType::Boolean:
       *out = base::Value(lua_toboolean(state, index));
       break;
-    case LuaType::String:
-      *out = base::Value(lua_tostring(state, index));
+    case LuaType::String: {
+      size_t length = 0;
+      const char* str = lua_tolstring(state, index, &length);
+      *out = base::Value(base::StringPiece(str, length));
       break;
+    }
     case LuaType::Table: {
       size_t size = 0;
-      if (IsTableArray(state, index, &size)) {
-        std::vector<base::Value> storage;
-        if (!lua::To(state, index, &storage))
-          return false;
-        *out = base::Value(std::move(storage));
-      } else {
-        *out = base::Value(base::Value::Type::DICTIONARY);
-        auto* dict = static_cast<base::DictionaryValue*>(out);
-        StackAutoReset reset(state);
-        lua_pushnil(state);
-        while (lua_next(state, index) != 0) {
-          std::string key;
-          base::Value value;
-          if (!lua::To(state, -2, &key) || !lua::To(state, -1, &value))
-            return false;
-          lua_pop(state, 1);
-          auto vval = std::make_unique<base::Value>(std::move(value));
-          dict->SetWithoutPathExpansion(key.c_str(), std::move(vval));
-        }
-      }
-      break;
+      if (IsTableArray(state, index, &size))
+        return ToList(state, index, size, out);
+      else
+        return ToDictionary(state, index, out);
     }
     default:
       *out = base::Value();
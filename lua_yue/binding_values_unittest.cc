@@ -29,3 +29,14 @@ TEST_F(YueValuesTest, ValueConversions) {
   ASSERT_TRUE(base::JSONWriter::Write(out, &json));
   ASSERT_EQ(json, "{\"a\":1.0,\"b\":{\"c\":[\"t\",\"e\"],\"d\":\"st\"}}");
 }
+
+TEST_F(YueValuesTest, NumberKeys) {
+  lua::NewTable(state_);
+  lua::RawSet(state_, 1, 1, "a", 3, "b", 5, "c");
+  base::Value out;
+  ASSERT_TRUE(lua::To(state_, 1, &out));
+  std::string json;
+  ASSERT_TRUE(base::JSONWriter::Write(out, &json));
+  ASSERT_EQ(json, "{\"1\":\"a\",\"3\":\"b\",\"5\":\"c\"}");
+  EXPECT_EQ(lua::GetType(state_, 1), lua::LuaType::Table);
+}
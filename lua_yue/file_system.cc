@@ -0,0 +1,151 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua_yue/file_system.h"
+
+#include <limits>
+#include <utility>
+
+#include "base/files/file.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/protocol_asar_job.h"
+#include "nativeui/util/worker_pool.h"
+
+namespace yue {
+
+namespace {
+
+// Split "/path/to/app.asar/dir/file" into the archive and the path inside it.
+bool SplitAsarPath(const base::FilePath& path,
+                   base::FilePath* asar,
+                   std::string* inner) {
+  std::vector<base::FilePath::StringType> components;
+  path.GetComponents(&components);
+  base::FilePath current;
+  for (size_t i = 0; i + 1 < components.size(); ++i) {
+    current = i == 0 ? base::FilePath(components[i])
+                     : current.Append(components[i]);
+    if (!current.MatchesExtension(FILE_PATH_LITERAL(".asar")) ||
+        !base::PathExists(current) || base::DirectoryExists(current))
+      continue;
+    *asar = current;
+    for (size_t j = i + 1; j < components.size(); ++j) {
+      if (!inner->empty())
+        inner->push_back('/');
+      inner->append(base::FilePath(components[j]).AsUTF8Unsafe());
+    }
+    return true;
+  }
+  return false;
+}
+
+// The read functions return an empty string on success, and the error
+// message otherwise.
+std::string ReadFileFromAsar(const base::FilePath& asar,
+                             const std::string& path,
+                             std::string* data) {
+  scoped_refptr<nu::ProtocolJob> job = new nu::ProtocolAsarJob(asar, path);
+  job->Plug([](int) {});
+  if (!job->Start())
+    return "cannot open '" + path + "' in asar";
+  base::StringPiece content;
+  if (job->GetContent(&content)) {
+    content.CopyToString(data);
+    return std::string();
+  }
+  char buffer[16 * 1024];
+  while (size_t size = job->Read(buffer, sizeof(buffer)))
+    data->append(buffer, size);
+  return std::string();
+}
+
+std::string ReadFile(const base::FilePath& path, std::string* data) {
+  base::FilePath asar;
+  std::string inner;
+  if (!base::PathExists(path) && SplitAsarPath(path, &asar, &inner))
+    return ReadFileFromAsar(asar, inner, data);
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return base::File::ErrorToString(file.error_details());
+  int64_t length = file.GetLength();
+  if (length < 0)
+    return base::File::ErrorToString(base::File::GetLastFileError());
+  if (length > std::numeric_limits<int>::max())
+    return "file is too large";
+  data->resize(static_cast<size_t>(length));
+  if (length > 0 &&
+      file.Read(0, &data->front(), static_cast<int>(length)) != length)
+    return base::File::ErrorToString(base::File::GetLastFileError());
+  return std::string();
+}
+
+std::string ReadDirectory(const base::FilePath& path,
+                          std::vector<std::string>* names) {
+  if (!base::DirectoryExists(path))
+    return "not a directory";
+  base::FileEnumerator enumerator(
+      path, false,
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath name = enumerator.Next(); !name.empty();
+       name = enumerator.Next())
+    names->push_back(name.BaseName().AsUTF8Unsafe());
+  return std::string();
+}
+
+// Pass null to callbacks for empty errors.
+inline const char* ToError(const std::string& error) {
+  return error.empty() ? nullptr : error.c_str();
+}
+
+}  // namespace
+
+// The callbacks hold references to lua functions, so they are put on heap and
+// only copied and destroyed in the main thread.
+void ReadFileAsync(const base::FilePath& path, ReadFileCallback callback) {
+  auto* reply = new ReadFileCallback(std::move(callback));
+  nu::WorkerPool::PostTask([path, reply]() {
+    std::string data;
+    std::string error = ReadFile(path, &data);
+    nu::MessageLoop::PostTask([reply, error, data]() {
+      if (*reply)
+        (*reply)(ToError(error), data);
+      delete reply;
+    });
+  });
+}
+
+void WriteFileAsync(const base::FilePath& path,
+                    std::string data,
+                    WriteFileCallback callback) {
+  auto* reply = new WriteFileCallback(std::move(callback));
+  nu::WorkerPool::PostTask([path, data, reply]() {
+    std::string error;
+    if (base::WriteFile(path, data.data(), static_cast<int>(data.size())) !=
+        static_cast<int>(data.size()))
+      error = base::File::ErrorToString(base::File::GetLastFileError());
+    nu::MessageLoop::PostTask([reply, error]() {
+      if (*reply)
+        (*reply)(ToError(error));
+      delete reply;
+    });
+  });
+}
+
+void ReadDirectoryAsync(const base::FilePath& path,
+                        ReadDirectoryCallback callback) {
+  auto* reply = new ReadDirectoryCallback(std::move(callback));
+  nu::WorkerPool::PostTask([path, reply]() {
+    std::vector<std::string> names;
+    std::string error = ReadDirectory(path, &names);
+    nu::MessageLoop::PostTask([reply, error, names]() {
+      if (*reply)
+        (*reply)(ToError(error), names);
+      delete reply;
+    });
+  });
+}
+
+}  // namespace yue
@@ -0,0 +1,43 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef LUA_YUE_FILE_SYSTEM_H_
+#define LUA_YUE_FILE_SYSTEM_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/strings/string_piece.h"
+
+namespace yue {
+
+// File operations that run in a shared pool of background threads, the
+// callbacks are called in the main thread with MessageLoop::PostTask, and
+// |error| is null on success.
+using ReadFileCallback =
+    std::function<void(const char* error, base::StringPiece data)>;
+using WriteFileCallback = std::function<void(const char* error)>;
+using ReadDirectoryCallback =
+    std::function<void(const char* error,
+                       const std::vector<std::string>& names)>;
+
+// Read the whole file at |path|, which can also be a file inside an asar
+// archive like "/path/to/app.asar/dir/file".
+void ReadFileAsync(const base::FilePath& path, ReadFileCallback callback);
+
+// Replace the content of file at |path| with |data|.
+void WriteFileAsync(const base::FilePath& path,
+                    std::string data,
+                    WriteFileCallback callback);
+
+// Return the names of files and directories under |path|, in no particular
+// order.
+void ReadDirectoryAsync(const base::FilePath& path,
+                        ReadDirectoryCallback callback);
+
+}  // namespace yue
+
+#endif  // LUA_YUE_FILE_SYSTEM_H_
@@ -0,0 +1,64 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <algorithm>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "lua_yue/file_system.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class FileSystemTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(FileSystemTest, WriteAndReadFile) {
+  base::FilePath path = temp_dir_.GetPath().AppendASCII("file");
+  bool read = false;
+  yue::WriteFileAsync(path, "content", [&](const char* error) {
+    ASSERT_EQ(error, nullptr);
+    yue::ReadFileAsync(path, [&](const char* error, base::StringPiece data) {
+      EXPECT_EQ(error, nullptr);
+      EXPECT_EQ(data, "content");
+      read = true;
+      nu::MessageLoop::Quit();
+    });
+  });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(read);
+}
+
+TEST_F(FileSystemTest, ReadMissingFile) {
+  bool failed = false;
+  yue::ReadFileAsync(temp_dir_.GetPath().AppendASCII("missing"),
+                     [&](const char* error, base::StringPiece data) {
+    failed = error != nullptr;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(failed);
+}
+
+TEST_F(FileSystemTest, ReadDirectory) {
+  ASSERT_TRUE(base::CreateDirectory(temp_dir_.GetPath().AppendASCII("dir")));
+  ASSERT_EQ(base::WriteFile(temp_dir_.GetPath().AppendASCII("file"), "a", 1),
+            1);
+  std::vector<std::string> names;
+  yue::ReadDirectoryAsync(temp_dir_.GetPath(),
+                          [&](const char* error,
+                              const std::vector<std::string>& result) {
+    EXPECT_EQ(error, nullptr);
+    names = result;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  std::sort(names.begin(), names.end());
+  EXPECT_EQ(names, std::vector<std::string>({"dir", "file"}));
+}
@@ -5,6 +5,8 @@
 #include "base/command_line.h"
 #include "base/logging.h"
 #include "base/strings/utf_string_conversions.h"
+#include "lua_yue/asar_loader.h"
+#include "lua_yue/binding_gui.h"
 #include "lua_yue/builtin_loader.h"
 #include "nativeui/lifetime.h"
 #include "nativeui/state.h"
@@ -15,10 +17,15 @@ int main(int argc, const char *argv[]) {
 
   auto* cmd = base::CommandLine::ForCurrentProcess();
   if (cmd->GetArgs().size() != 1) {
-    fprintf(stderr, "Usage: yue <path-to-script>\n");
+    fprintf(stderr, "Usage: yue [--lazy-bindings] [--startup-stats] "
+                    "<path-to-script>\n");
     return 1;
   }
 
+  // Build the classes of yue.gui when they are used.
+  if (cmd->HasSwitch("lazy-bindings"))
+    yue::SetLazyBindingsEnabled(true);
+
   // Create lua environment.
   lua::ManagedState state;
   if (!state) {
@@ -38,14 +45,28 @@ int main(int argc, const char *argv[]) {
   std::string filename = cmd->GetArgs()[0];
 #endif
 
-  // Load the main script.
-  if (luaL_loadfile(state, filename.c_str()) != LUA_OK ||
-      !lua::PCall(state, nullptr)) {
+  // When running an asar archive, load the modules and "main.lua" from it,
+  // which can be either source code or precompiled bytecode.
+  bool loaded;
+  base::FilePath path(cmd->GetArgs()[0]);
+  if (path.MatchesExtension(FILE_PATH_LITERAL(".asar"))) {
+    yue::InsertAsarModuleLoader(state, path);
+    loaded = yue::LoadFileFromAsar(state, path, "main.lua");
+  } else {
+    loaded = luaL_loadfile(state, filename.c_str()) == LUA_OK;
+  }
+
+  // Run the main script.
+  if (!loaded || !lua::PCall(state, nullptr)) {
     std::string error;
     lua::Pop(state, &error);
     fprintf(stderr, "Error when running script: %s\n", error.c_str());
     return 1;
   }
 
+  // Print the time spent in the phases of startup when the script exits.
+  if (cmd->HasSwitch("startup-stats"))
+    fputs(nu::State::GetStartupStats().ToString().c_str(), stderr);
+
   return 0;
 }
@@ -0,0 +1,291 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua_yue/worker.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <deque>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "lua/lua.h"
+#include "lua_yue/binding_sys.h"
+#include "lua_yue/binding_util.h"
+#include "lua_yue/binding_values.h"
+#include "nativeui/message_loop.h"
+
+namespace yue {
+
+namespace {
+
+struct Message {
+  enum class Type {
+    Value,
+    Buffer,
+    Error,
+  };
+
+  Type type = Type::Value;
+  // The message, or the error string.
+  base::Value value;
+  nu::Buffer buffer;
+};
+
+}  // namespace
+
+class Worker::Channel : public base::RefCountedThreadSafe<Channel> {
+ public:
+  explicit Channel(Worker* owner) : owner_(owner), wake_up_(&lock_) {}
+
+  // Called in main thread.
+  void PostToWorker(Message message) {
+    base::AutoLock auto_lock(lock_);
+    if (closed_ || exited_)
+      return;
+    to_worker_.push_back(std::move(message));
+    wake_up_.Signal();
+  }
+
+  // Called in main thread.
+  void Close() {
+    base::AutoLock auto_lock(lock_);
+    closed_ = true;
+    to_worker_.clear();
+    to_main_.clear();
+    wake_up_.Signal();
+  }
+
+  // Called in main thread when the worker is destroyed.
+  void DetachOwner() {
+    owner_ = nullptr;
+  }
+
+  // Called in worker thread, wait for next message and return false when the
+  // channel is closed.
+  bool WaitForMessage(Message* message) {
+    base::AutoLock auto_lock(lock_);
+    while (!closed_ && to_worker_.empty())
+      wake_up_.Wait();
+    if (closed_)
+      return false;
+    *message = std::move(to_worker_.front());
+    to_worker_.pop_front();
+    return true;
+  }
+
+  // Called in worker thread when it stops handling messages.
+  void WorkerExited() {
+    base::AutoLock auto_lock(lock_);
+    exited_ = true;
+    to_worker_.clear();
+  }
+
+  // Called in worker thread.
+  void PostToMain(Message message) {
+    {
+      base::AutoLock auto_lock(lock_);
+      if (closed_)
+        return;
+      to_main_.push_back(std::move(message));
+      // Messages posted before the main thread handles them are delivered
+      // with one task.
+      if (to_main_.size() > 1)
+        return;
+    }
+    scoped_refptr<Channel> self(this);
+    nu::MessageLoop::PostTask([self]() { self->DeliverToMain(); });
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Channel>;
+
+  ~Channel() {}
+
+  void DeliverToMain() {
+    std::deque<Message> messages;
+    {
+      base::AutoLock auto_lock(lock_);
+      messages.swap(to_main_);
+    }
+    for (Message& message : messages) {
+      if (!owner_)
+        return;
+      // The handlers may release the last reference to worker.
+      scoped_refptr<Worker> worker(owner_);
+      switch (message.type) {
+        case Message::Type::Value:
+          worker->on_message.Emit(worker.get(), message.value);
+          break;
+        case Message::Type::Buffer:
+          worker->on_buffer.Emit(
+              worker.get(),
+              base::StringPiece(static_cast<char*>(message.buffer.content()),
+                                message.buffer.size()));
+          break;
+        case Message::Type::Error:
+          worker->on_error.Emit(worker.get(), message.value.GetString());
+          break;
+      }
+    }
+  }
+
+  // Only accessed in main thread.
+  Worker* owner_;
+
+  base::Lock lock_;
+  base::ConditionVariable wake_up_;
+  bool closed_ = false;
+  bool exited_ = false;
+  std::deque<Message> to_worker_;
+  std::deque<Message> to_main_;
+};
+
+namespace {
+
+// Run the worker code and then the handlers of messages, until the channel is
+// closed.
+class WorkerThread : public base::PlatformThread::Delegate {
+ public:
+  WorkerThread(scoped_refptr<Worker::Channel> channel, std::string source)
+      : channel_(std::move(channel)), source_(std::move(source)) {}
+
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override {
+    base::PlatformThread::SetName("LuaWorker");
+    Run();
+    channel_->WorkerExited();
+    delete this;
+  }
+
+ private:
+  void Run() {
+    lua::ManagedState state;
+    if (!state) {
+      PostError("Unable to create lua state");
+      return;
+    }
+    luaL_openlibs(state);
+    PreloadModules(state);
+    // The port is kept at index 1 for the lifetime of worker.
+    PushPort(state);
+    if (luaL_loadbuffer(state, source_.data(), source_.size(), "=worker") !=
+            LUA_OK ||
+        !lua::PCall(state, nullptr, lua::ValueOnStack(state, 1))) {
+      PostLuaError(state);
+      return;
+    }
+    Message message;
+    while (channel_->WaitForMessage(&message)) {
+      bool is_value = message.type == Message::Type::Value;
+      lua::RawGet(state, 1, is_value ? "onmessage" : "onbuffer");
+      if (lua::GetType(state, -1) != lua::LuaType::Function) {
+        lua::SetTop(state, 1);
+        continue;
+      }
+      bool success = is_value ?
+          lua::PCall(state, nullptr, message.value) :
+          lua::PCall(state, nullptr, base::StringPiece(
+              static_cast<char*>(message.buffer.content()),
+              message.buffer.size()));
+      if (!success)
+        PostLuaError(state);
+      lua::SetTop(state, 1);
+    }
+  }
+
+  // Only the modules that do not touch GUI can be required in worker.
+  void PreloadModules(lua::State* state) {
+    lua::StackAutoReset reset(state);
+    lua_getglobal(state, "package");
+    lua::RawGet(state, -1, "preload");
+    lua::RawSet(state, -1,
+                "yue.sys", lua::CFunction(&OpenSysInWorker),
+                "yue.util", lua::CFunction(&luaopen_yue_util));
+  }
+
+  // The port is the table passed to worker code for posting messages, and
+  // for receiving messages with its "onmessage" and "onbuffer" fields.
+  void PushPort(lua::State* state) {
+    scoped_refptr<Worker::Channel> channel = channel_;
+    std::function<void(base::Value)> post_message =
+        [channel](base::Value value) {
+      Message message;
+      message.value = std::move(value);
+      channel->PostToMain(std::move(message));
+    };
+    std::function<void(base::StringPiece)> post_buffer =
+        [channel](base::StringPiece data) {
+      Message message;
+      message.type = Message::Type::Buffer;
+      message.buffer = CopyToBuffer(data);
+      channel->PostToMain(std::move(message));
+    };
+    lua::NewTable(state);
+    lua::RawSet(state, -1,
+                "postmessage", post_message,
+                "postbuffer", post_buffer);
+  }
+
+  void PostLuaError(lua::State* state) {
+    std::string error;
+    lua::Pop(state, &error);
+    PostError(error);
+  }
+
+  void PostError(const std::string& error) {
+    Message message;
+    message.type = Message::Type::Error;
+    message.value = base::Value(error);
+    channel_->PostToMain(std::move(message));
+  }
+
+  scoped_refptr<Worker::Channel> channel_;
+  std::string source_;
+};
+
+}  // namespace
+
+nu::Buffer CopyToBuffer(base::StringPiece data) {
+  void* content = malloc(data.size());
+  memcpy(content, data.data(), data.size());
+  return nu::Buffer::TakeOver(content, data.size(), free);
+}
+
+Worker::Worker(const std::string& source) : channel_(new Channel(this)) {
+  auto* thread = new WorkerThread(channel_, source);
+  if (!base::PlatformThread::CreateNonJoinable(0, thread)) {
+    LOG(ERROR) << "Failed to create thread for worker.";
+    delete thread;
+    channel_->Close();
+  }
+}
+
+Worker::~Worker() {
+  channel_->DetachOwner();
+  channel_->Close();
+}
+
+void Worker::Post(base::Value message) {
+  Message task;
+  task.value = std::move(message);
+  channel_->PostToWorker(std::move(task));
+}
+
+void Worker::PostBuffer(nu::Buffer buffer) {
+  Message task;
+  task.type = Message::Type::Buffer;
+  task.buffer = std::move(buffer);
+  channel_->PostToWorker(std::move(task));
+}
+
+void Worker::Terminate() {
+  channel_->Close();
+}
+
+}  // namespace yue
@@ -0,0 +1,74 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef LUA_YUE_WORKER_H_
+#define LUA_YUE_WORKER_H_
+
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+#include "nativeui/buffer.h"
+#include "nativeui/signal.h"
+
+namespace yue {
+
+// Runs lua code in its own lua_State on a background thread.
+//
+// The worker state only has the standard libraries and the non-GUI modules
+// of yue, and exchanges messages with the main thread: messages posted to
+// the worker are queued until the worker is free, and messages posted from
+// the worker are delivered in the main thread with MessageLoop::PostTask.
+//
+// The worker code receives a port table as argument:
+//
+//   local port = ...
+//   function port.onmessage(message)
+//     port.postmessage(message)
+//   end
+//
+// Errors in the worker code are reported with the on_error event, and the
+// worker keeps handling messages after errors in handlers.
+class Worker : public base::RefCounted<Worker> {
+ public:
+  // Start running the lua |source| in a new thread.
+  explicit Worker(const std::string& source);
+
+  // Send |message| to the worker.
+  void Post(base::Value message);
+
+  // Send the bytes of |buffer| to the worker, the memory is moved to the
+  // worker thread without copying.
+  void PostBuffer(nu::Buffer buffer);
+
+  // Stop the worker after it finishes current message, pending messages in
+  // both directions are discarded.
+  void Terminate();
+
+  // Events.
+  nu::Signal<void(Worker*, const base::Value&)> on_message;
+  nu::Signal<void(Worker*, base::StringPiece)> on_buffer;
+  nu::Signal<void(Worker*, const std::string&)> on_error;
+
+  // Internal: Shared state of the two threads.
+  class Channel;
+
+ private:
+  friend class base::RefCounted<Worker>;
+
+  ~Worker();
+
+  scoped_refptr<Channel> channel_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+// Copy |data| into a buffer that owns its memory, so it can be moved to
+// other threads.
+nu::Buffer CopyToBuffer(base::StringPiece data);
+
+}  // namespace yue
+
+#endif  // LUA_YUE_WORKER_H_
@@ -0,0 +1,68 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "lua_yue/builtin_loader.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class WorkerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    luaL_openlibs(state_);
+    yue::InsertBuiltinModuleLoader(state_);
+    // Messages from workers are delivered in the GUI message loop.
+    luaL_dostring(state_, "gui = require('yue.gui') sys = require('yue.sys')");
+  }
+
+  lua::ManagedState state_;
+};
+
+TEST_F(WorkerTest, PostMessage) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "worker = sys.Worker.create([[\n"
+      "  local port = ...\n"
+      "  function port.onmessage(message)\n"
+      "    port.postmessage({ sum = message[1] + message[2] })\n"
+      "  end\n"
+      "  function port.onbuffer(data)\n"
+      "    port.postbuffer(data:upper())\n"
+      "  end\n"
+      "]])\n"
+      "worker.onmessage:connect(function(self, message)\n"
+      "  sum = message.sum\n"
+      "end)\n"
+      "worker.onbuffer:connect(function(self, data)\n"
+      "  buffer = data\n"
+      "  gui.MessageLoop.quit()\n"
+      "end)\n"
+      "worker:postmessage({ 1, 2 })\n"
+      "worker:postbuffer('buffer')\n"
+      "gui.MessageLoop.run()"));
+  int sum = 0;
+  lua_getglobal(state_, "sum");
+  ASSERT_TRUE(lua::Pop(state_, &sum));
+  EXPECT_EQ(sum, 3);
+  std::string buffer;
+  lua_getglobal(state_, "buffer");
+  ASSERT_TRUE(lua::Pop(state_, &buffer));
+  EXPECT_EQ(buffer, "BUFFER");
+}
+
+TEST_F(WorkerTest, NoGUIInWorker) {
+  ASSERT_FALSE(luaL_dostring(state_,
+      "worker = sys.Worker.create([[\n"
+      "  local port = ...\n"
+      "  assert(require('yue.sys').Worker == nil)\n"
+      "  require('yue.gui')\n"
+      "]])\n"
+      "worker.onerror:connect(function(self, message)\n"
+      "  workererror = message\n"
+      "  gui.MessageLoop.quit()\n"
+      "end)\n"
+      "gui.MessageLoop.run()"));
+  std::string error;
+  lua_getglobal(state_, "workererror");
+  ASSERT_TRUE(lua::Pop(state_, &error));
+  EXPECT_NE(error.find("module 'yue.gui' not found"), std::string::npos);
+}
@@ -5,7 +5,9 @@
 #ifndef NATIVEUI_ACCELERATOR_MANAGER_H_
 #define NATIVEUI_ACCELERATOR_MANAGER_H_
 
-#include <map>
+#include <stdint.h>
+
+#include <vector>
 
 #include "base/macros.h"
 #include "build/build_config.h"
@@ -33,6 +35,13 @@ class NATIVEUI_EXPORT AcceleratorManager {
   // Activate the target associated with the specified accelerator, return the
   // ID of activated item.
   int Process(const Accelerator& accelerator);
+
+  // The number of Process calls, and the table slots they have probed.
+  struct LookupStats {
+    int lookups = 0;
+    int probes = 0;
+  };
+  const LookupStats& lookup_stats() const { return lookup_stats_; }
 #endif
 
 #if defined(OS_LINUX)
@@ -45,8 +54,21 @@ class NATIVEUI_EXPORT AcceleratorManager {
 #endif
 
 #if defined(OS_WIN)
-  using AcceleratorMap = std::map<Accelerator, int>;
-  AcceleratorMap accelerators_;
+  // Accelerators are stored in an open-addressing table with linear probing,
+  // keyed by the packed key code and modifiers. Empty slots have id -1.
+  struct Slot {
+    uint32_t key = 0;
+    int id = -1;
+  };
+
+  // Return the index of slot for |key|, which is either the slot holding it
+  // or the empty slot where it should be inserted.
+  size_t FindSlot(uint32_t key, int* probes) const;
+  void Grow();
+
+  std::vector<Slot> slots_;
+  size_t count_ = 0;
+  LookupStats lookup_stats_;
 #endif
 
   DISALLOW_COPY_AND_ASSIGN(AcceleratorManager);
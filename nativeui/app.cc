@@ -4,7 +4,11 @@
 
 #include "nativeui/app.h"
 
+#include <algorithm>
+
+#include "nativeui/gfx/font.h"
 #include "nativeui/menu_bar.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/state.h"
 
 namespace nu {
@@ -17,6 +21,57 @@ App* App::GetCurrent() {
 App::App() : weak_factory_(this) {
 }
 
-App::~App() = default;
+App::~App() {
+  // Timers are shared by all threads and outlive the app.
+  if (timer_alignment_ > 0)
+    MessageLoop::SetTimerAlignment(0);
+}
+
+void App::Prewarm() {
+  Font::Default();
+  State::GetCurrent()->PlatformPrewarm();
+}
+
+void App::NotifyMemoryPressure(bool critical) {
+  on_memory_pressure.Emit(this, critical);
+  State::GetCurrent()->TrimCaches(critical);
+}
+
+void App::SetBackgroundThrottlingEnabled(bool enabled) {
+  background_throttling_ = enabled;
+  UpdateTimerThrottling();
+}
+
+void App::SetBackgroundTimerInterval(int ms) {
+  background_timer_interval_ = std::max(ms, 0);
+  UpdateTimerThrottling();
+}
+
+void App::UpdateWindowOcclusion(Window* window, bool occluded) {
+  if (occluded) {
+    visible_windows_.erase(window);
+  } else {
+    visible_windows_.insert(window);
+    has_shown_window_ = true;
+  }
+  bool in_background = has_shown_window_ && visible_windows_.empty();
+  if (in_background == in_background_)
+    return;
+  in_background_ = in_background;
+  UpdateTimerThrottling();
+  if (in_background_)
+    on_enter_background.Emit(this);
+  else
+    on_leave_background.Emit(this);
+}
+
+void App::UpdateTimerThrottling() {
+  int alignment = in_background_ && background_throttling_ ?
+                  background_timer_interval_ : 0;
+  if (alignment == timer_alignment_)
+    return;
+  timer_alignment_ = alignment;
+  MessageLoop::SetTimerAlignment(alignment);
+}
 
 }  // namespace nu
@@ -5,22 +5,61 @@
 #ifndef NATIVEUI_APP_H_
 #define NATIVEUI_APP_H_
 
+#include <set>
 #include <string>
 
 #include "base/memory/weak_ptr.h"
 #include "nativeui/clipboard.h"
 #include "nativeui/gfx/color.h"
+#include "nativeui/signal.h"
+
+#if defined(OS_MACOSX)
+#include <dispatch/dispatch.h>
+#elif defined(OS_LINUX)
+typedef struct _GMemoryMonitor GMemoryMonitor;
+#elif defined(OS_WIN)
+#include "nativeui/message_loop.h"
+#endif
 
 namespace nu {
 
 class Font;
 class MenuBar;
+class Window;
 
 // App wide APIs, this class is managed by State.
 class NATIVEUI_EXPORT App {
  public:
   static App* GetCurrent();
 
+  // Initialize the resources used by windows ahead of time, so showing the
+  // first window does not have to do it.
+  void Prewarm();
+
+  // Emit on_memory_pressure and then trim the caches of current thread, the
+  // caches are cleared when |critical| is true, and halved otherwise.
+  //
+  // This is called automatically when the system notifies memory pressure,
+  // apps can also call it to release memory proactively.
+  void NotifyMemoryPressure(bool critical);
+
+  // The app enters background mode when all the windows that have been shown
+  // are hidden, minimized or covered, and leaves when any window can be seen
+  // again. Frame callbacks and animations of windows are already suspended
+  // when they can not be seen.
+  bool IsInBackground() const { return in_background_; }
+
+  // Align the timers set in background mode to multiples of the background
+  // timer interval, so they wake up the app at most once per interval.
+  // Enabled by default, PostUnthrottledDelayedTask can be used for timers
+  // that must not be delayed.
+  void SetBackgroundThrottlingEnabled(bool enabled);
+  bool IsBackgroundThrottlingEnabled() const { return background_throttling_; }
+
+  // The default interval is 1 second.
+  void SetBackgroundTimerInterval(int ms);
+  int GetBackgroundTimerInterval() const { return background_timer_interval_; }
+
 #if defined(OS_MACOSX)
   // Set the application menu.
   void SetApplicationMenu(scoped_refptr<MenuBar> menu);
@@ -45,6 +84,14 @@ class NATIVEUI_EXPORT App {
   ActivationPolicy GetActivationPolicy() const;
 #endif
 
+  // Internal: Called when |window| becomes visible or invisible.
+  void UpdateWindowOcclusion(Window* window, bool occluded);
+
+  // Events.
+  Signal<void(App*, bool)> on_memory_pressure;
+  Signal<void(App*)> on_enter_background;
+  Signal<void(App*)> on_leave_background;
+
   base::WeakPtr<App> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
 
  protected:
@@ -54,8 +101,39 @@ class NATIVEUI_EXPORT App {
  private:
   friend class State;
 
+  // Listen to the memory pressure notifications of system, only called for
+  // the app of main thread.
+  void PlatformInit();
+  void PlatformDestroy();
+
+#if defined(OS_WIN)
+  // Check the low memory state and schedule next check.
+  void PollLowMemory();
+#endif
+
+  // Apply the alignment of timers for current mode.
+  void UpdateTimerThrottling();
+
+  // Windows that can be seen.
+  std::set<Window*> visible_windows_;
+  bool has_shown_window_ = false;
+  bool in_background_ = false;
+
+  bool background_throttling_ = true;
+  int background_timer_interval_ = 1000;
+  // The alignment of timers currently applied.
+  int timer_alignment_ = 0;
+
 #if defined(OS_MACOSX)
   scoped_refptr<MenuBar> application_menu_;
+  dispatch_source_t memory_pressure_source_ = nullptr;
+#elif defined(OS_LINUX)
+  GMemoryMonitor* memory_monitor_ = nullptr;
+  unsigned long memory_signal_ = 0;  // NOLINT
+#elif defined(OS_WIN)
+  HANDLE low_memory_notification_ = nullptr;
+  MessageLoop::TimerId low_memory_timer_ = 0;
+  bool is_low_memory_ = false;
 #endif
 
   base::WeakPtrFactory<App> weak_factory_;
@@ -4,16 +4,26 @@
 
 #include "nativeui/asar_archive.h"
 
-#include <memory>
+#include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
 #include <utility>
-#include <vector>
 
+#include "base/base_paths.h"
+#include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/hash/hash.h"
 #include "base/json/json_reader.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/path_service.h"
 #include "base/pickle.h"
-#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
-#include "base/strings/string_split.h"
-#include "base/strings/utf_string_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
 
 namespace nu {
 
@@ -22,107 +32,430 @@ namespace {
 // The version of asar format we supports.
 const uint8_t kSupportedAsarVersion = 2;
 
+// Identifies the index files, the version should be increased when the format
+// of index is changed.
+const char kIndexMagic[] = "NUASARINDEX";
+const int kIndexVersion = 3;
+
+// Archives that have been opened.
+struct CachedArchive {
+  base::Time last_modified;
+  int64_t size = 0;
+  scoped_refptr<AsarArchive> archive;
+};
+
+struct ArchiveCache {
+  base::Lock lock;
+  std::map<base::FilePath, CachedArchive> archives;
+};
+
+base::LazyInstance<ArchiveCache>::Leaky g_archive_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+inline bool IsSeparator(char c) {
+  return c == '/' || c == '\\';
+}
+
+// Reads |path| as if it was normalized, i.e. without leading and trailing
+// separators, and with every run of separators read as one slash.
+class NormalizedPathReader {
+ public:
+  explicit NormalizedPathReader(base::StringPiece path)
+      : path_(base::TrimString(path, "/\\", base::TRIM_ALL)) {}
+
+  bool AtEnd() const { return pos_ == path_.size(); }
+
+  char Next() {
+    char c = path_[pos_++];
+    if (!IsSeparator(c))
+      return c;
+    // There is no trailing separator, so the run ends before the end.
+    while (IsSeparator(path_[pos_]))
+      ++pos_;
+    return '/';
+  }
+
+ private:
+  base::StringPiece path_;
+  size_t pos_ = 0;
+};
+
+// Compare the normalized |name| with |path|, like StringPiece::compare.
+int ComparePath(base::StringPiece name, base::StringPiece path) {
+  NormalizedPathReader reader(path);
+  for (char c : name) {
+    if (reader.AtEnd())
+      return 1;
+    unsigned char a = c;
+    unsigned char b = reader.Next();
+    if (a != b)
+      return a < b ? -1 : 1;
+  }
+  return reader.AtEnd() ? 0 : -1;
+}
+
+// Return where the header starts in an extended asar archive.
+bool ReadExtendedMeta(base::StringPiece data, uint64_t* header_offset) {
+  // Read last 13 bytes, which are | size(8) | version(1) | magic(4) |.
+  if (data.size() < 13 || data.substr(data.size() - 4) != "ASAR")
+    return false;
+  uint8_t version = static_cast<uint8_t>(data[data.size() - 5]);
+  if (version != kSupportedAsarVersion)
+    return false;
+  double size;
+  memcpy(&size, data.data() + data.size() - 13, 8);
+  if (!(size >= 0 && size <= data.size()))
+    return false;
+  *header_offset = data.size() - static_cast<uint64_t>(size);
+  return true;
+}
+
+// Read the "compression" field of file, which is in the form of
+// {"algorithm": "lz4", "size": 1024, "blockSize": 65536}. Files with unknown
+// algorithms are skipped.
+bool ReadCompression(const base::Value& node, AsarArchive::FileInfo* info) {
+  const base::Value* compression =
+      node.FindKeyOfType("compression", base::Value::Type::DICTIONARY);
+  if (!compression)
+    return true;
+  const base::Value* algorithm =
+      compression->FindKeyOfType("algorithm", base::Value::Type::STRING);
+  const base::Value* size =
+      compression->FindKeyOfType("size", base::Value::Type::INTEGER);
+  const base::Value* block_size =
+      compression->FindKeyOfType("blockSize", base::Value::Type::INTEGER);
+  if (!algorithm || algorithm->GetString() != "lz4" ||
+      !size || size->GetInt() < 0 ||
+      !block_size || block_size->GetInt() <= 0)
+    return false;
+  info->compressed = true;
+  info->decompressed_size = size->GetInt();
+  info->block_size = block_size->GetInt();
+  return true;
+}
+
 }  // namespace
 
-AsarArchive::AsarArchive(base::File file, bool extended_format)
-    : file_(std::move(file)) {
-  if (!file_.IsValid())
+// static
+scoped_refptr<AsarArchive> AsarArchive::Open(const base::FilePath& path,
+                                             bool extended_format) {
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info))
+    return nullptr;
+
+  ArchiveCache* cache = g_archive_cache.Pointer();
+  {
+    base::AutoLock auto_lock(cache->lock);
+    auto it = cache->archives.find(path);
+    if (it != cache->archives.end() &&
+        it->second.last_modified == info.last_modified &&
+        it->second.size == info.size)
+      return it->second.archive;
+  }
+
+  // Read the archive without holding the lock, try the index file first.
+  base::FilePath index_path = GetIndexPath(path, info);
+  scoped_refptr<AsarArchive> archive(new AsarArchive);
+  if (index_path.empty() ||
+      !archive->ReadIndex(index_path, path, info, extended_format)) {
+    archive = new AsarArchive(
+        base::File(path, base::File::FLAG_OPEN | base::File::FLAG_READ),
+        extended_format);
+    if (!archive->IsValid())
+      return archive;
+    if (!index_path.empty())
+      archive->WriteIndex(index_path, path, info, extended_format);
+  }
+
+  archive->path_ = path;
+
+  base::AutoLock auto_lock(cache->lock);
+  CachedArchive& cached = cache->archives[path];
+  cached.last_modified = info.last_modified;
+  cached.size = info.size;
+  cached.archive = archive;
+  return archive;
+}
+
+// static
+void AsarArchive::ReleaseUnusedArchives() {
+  ArchiveCache* cache = g_archive_cache.Pointer();
+  base::AutoLock auto_lock(cache->lock);
+  for (auto it = cache->archives.begin(); it != cache->archives.end();) {
+    if (it->second.archive->HasOneRef())
+      it = cache->archives.erase(it);
+    else
+      ++it;
+  }
+}
+
+AsarArchive::AsarArchive() {}
+
+AsarArchive::AsarArchive(base::File file, bool extended_format) {
+  base::MemoryMappedFile mapped_file;
+  if (!file.IsValid() || !mapped_file.Initialize(std::move(file)))
     return;
+  base::StringPiece data(reinterpret_cast<const char*>(mapped_file.data()),
+                         mapped_file.length());
 
   // If it is an extended type of asar, search from the end of file.
-  if (extended_format && !ReadExtendedMeta())
+  uint64_t header_offset = 0;
+  if (extended_format && !ReadExtendedMeta(data, &header_offset))
     return;
 
   // Read size.
-  char size_buf[8];
-  if (file_.ReadAtCurrentPos(size_buf, 8) != 8)
+  if (data.size() < header_offset + 8)
     return;
+  char size_buf[8];
+  memcpy(size_buf, data.data() + header_offset, 8);
   uint32_t size;
   if (!base::PickleIterator(base::Pickle(size_buf, 8)).ReadUInt32(&size))
     return;
 
-  // Read header.
-  std::vector<char> header_buf(size);
-  if (file_.ReadAtCurrentPos(header_buf.data(), size) != static_cast<int>(size))
+  // Read header, which is used directly from the mapped memory.
+  if (data.size() - header_offset - 8 < size)
     return;
-  std::string header;
+  base::StringPiece header;
   if (!base::PickleIterator(
-          base::Pickle(header_buf.data(), size)).ReadString(&header))
+          base::Pickle(data.data() + header_offset + 8, size))
+              .ReadStringPiece(&header))
     return;
 
-  // Parse header.
+  // Parse header, the parsed tree is only used for building the index.
   base::Optional<base::Value> value = base::JSONReader::Read(header);
   if (!value || !value->is_dict())
     return;
-  content_offset_ += 8 + size;
-  header_ = std::move(*value);
+  const base::Value* files =
+      value->FindKeyOfType("files", base::Value::Type::DICTIONARY);
+  if (!files)
+    return;
+  content_offset_ = header_offset + 8 + size;
+  file_length_ = data.size();
+
+  std::string prefix;
+  Links links;
+  AddFiles(*files, &prefix, &links);
+  SortEntries();
+  ResolveLinks(std::move(links));
+  valid_ = true;
 }
 
 AsarArchive::~AsarArchive() {
 }
 
 bool AsarArchive::IsValid() const {
-  return file_.IsValid() && header_.is_dict();
+  return valid_;
 }
 
-bool AsarArchive::GetFileInfo(const std::string& path, FileInfo* info) {
-  if (!header_.is_dict())
+bool AsarArchive::GetFileInfo(base::StringPiece path, FileInfo* info) const {
+  auto it = std::lower_bound(
+      entries_.begin(), entries_.end(), path,
+      [this](const Entry& entry, base::StringPiece target) {
+        return ComparePath(GetName(entry), target) < 0;
+      });
+  if (it == entries_.end() || ComparePath(GetName(*it), path) != 0)
     return false;
+  *info = it->info;
+  return true;
+}
 
-  // Convert file path to value search path.
-  // path/to/image.jpg => { files, path, files, to, files, image.jpg }
-  std::vector<base::StringPiece> components = base::SplitStringPiece(
-      path, "/\\", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-  std::vector<base::StringPiece> key;
-  key.reserve(components.size() * 2);
-  for (const base::StringPiece& c : components) {
-    key.push_back("files");
-    key.push_back(c);
+base::StringPiece AsarArchive::AcquireMapping() {
+  base::AutoLock auto_lock(mapping_lock_);
+  if (!mapping_) {
+    if (path_.empty())
+      return base::StringPiece();
+    mapping_.reset(new base::MemoryMappedFile);
+    if (!mapping_->Initialize(path_)) {
+      mapping_.reset();
+      return base::StringPiece();
+    }
   }
+  ++mapping_readers_;
+  return base::StringPiece(reinterpret_cast<const char*>(mapping_->data()),
+                           mapping_->length());
+}
 
-  // Search for the node representing path.
-  const base::Value* node = header_.FindPath(key);
-  if (!node)
-    return false;
-
-  // Read file information.
-  const base::Value* link = node->FindKey("link");
-  if (link && link->is_string())
-    return GetFileInfo(link->GetString(), info);
-
-  const base::Value* size = node->FindKey("size");
-  if (!size || !size->is_int())
-    return false;
-  info->size = size->GetInt();
-
-  const base::Value* offset = node->FindKey("offset");
-  if (!offset || !offset->is_string() ||
-      !base::StringToUint64(offset->GetString(), &info->offset))
-    return false;
+void AsarArchive::ReleaseMapping() {
+  base::AutoLock auto_lock(mapping_lock_);
+  DCHECK_GT(mapping_readers_, 0);
+  if (--mapping_readers_ == 0)
+    mapping_.reset();
+}
 
-  info->offset += content_offset_;
-  return true;
+// static
+base::FilePath AsarArchive::GetIndexPath(const base::FilePath& path,
+                                         const base::File::Info& info) {
+  base::FilePath dir;
+#if defined(OS_WIN)
+  if (!base::PathService::Get(base::DIR_LOCAL_APP_DATA, &dir))
+    return base::FilePath();
+#else
+  if (!base::PathService::Get(base::DIR_CACHE, &dir))
+    return base::FilePath();
+#endif
+  // The name only needs to be unique enough, the archive's path and stats are
+  // also stored in the index and verified when reading.
+  std::string key = base::StringPrintf(
+      "%s:%" PRId64 ":%" PRId64, path.AsUTF8Unsafe().c_str(), info.size,
+      info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  return dir.Append(FILE_PATH_LITERAL("yue"))
+            .Append(FILE_PATH_LITERAL("asar"))
+            .AppendASCII(base::StringPrintf("%08x.index",
+                                            base::PersistentHash(key)));
 }
 
-bool AsarArchive::ReadExtendedMeta() {
-  // Read last 13 bytes, which are | size(8) | version(1) | magic(4) |.
-  char magic[5] = { 0 };
-  if (file_.Seek(base::File::FROM_END, -4) == -1 ||
-      file_.ReadAtCurrentPos(magic, 4) != 4 ||
-      base::StringPiece(magic) != "ASAR")
+bool AsarArchive::ReadIndex(const base::FilePath& index_path,
+                            const base::FilePath& path,
+                            const base::File::Info& info,
+                            bool extended_format) {
+  std::string data;
+  if (!base::ReadFileToString(index_path, &data))
     return false;
-  uint8_t version;
-  if (file_.Seek(base::File::FROM_END, -5) == -1 ||
-      file_.ReadAtCurrentPos(reinterpret_cast<char*>(&version), 1) != 1 ||
-      version != kSupportedAsarVersion)
+  base::Pickle pickle(data.data(), static_cast<int>(data.size()));
+  base::PickleIterator iter(pickle);
+  base::StringPiece magic, archive_path;
+  int version;
+  bool extended;
+  int64_t size, last_modified;
+  uint32_t entry_size;
+  if (!iter.ReadStringPiece(&magic) || magic != kIndexMagic ||
+      !iter.ReadInt(&version) || version != kIndexVersion ||
+      !iter.ReadStringPiece(&archive_path) ||
+      archive_path != path.AsUTF8Unsafe() ||
+      !iter.ReadBool(&extended) || extended != extended_format ||
+      !iter.ReadInt64(&size) || size != info.size ||
+      !iter.ReadInt64(&last_modified) ||
+      last_modified !=
+          info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds() ||
+      !iter.ReadUInt32(&entry_size) || entry_size != sizeof(Entry))
     return false;
-  double size;
-  if (file_.Seek(base::File::FROM_END, -13) == -1 ||
-      file_.ReadAtCurrentPos(reinterpret_cast<char*>(&size), 8) != 8)
+  const char* entries;
+  int length;
+  if (!iter.ReadString(&names_) ||
+      !iter.ReadData(&entries, &length) || length % sizeof(Entry) != 0)
     return false;
-  content_offset_ = file_.GetLength() - static_cast<uint64_t>(size);
-  file_.Seek(base::File::FROM_BEGIN, content_offset_);
+  entries_.resize(length / sizeof(Entry));
+  memcpy(entries_.data(), entries, length);
+  // Make sure a corrupted index can not read out of bounds.
+  for (const Entry& entry : entries_) {
+    if (entry.name_offset > names_.size() ||
+        entry.name_size > names_.size() - entry.name_offset)
+      return false;
+  }
+  valid_ = true;
   return true;
 }
 
+void AsarArchive::WriteIndex(const base::FilePath& index_path,
+                             const base::FilePath& path,
+                             const base::File::Info& info,
+                             bool extended_format) const {
+  base::Pickle pickle;
+  pickle.WriteString(kIndexMagic);
+  pickle.WriteInt(kIndexVersion);
+  pickle.WriteString(path.AsUTF8Unsafe());
+  pickle.WriteBool(extended_format);
+  pickle.WriteInt64(info.size);
+  pickle.WriteInt64(
+      info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds());
+  pickle.WriteUInt32(sizeof(Entry));
+  pickle.WriteString(names_);
+  pickle.WriteData(reinterpret_cast<const char*>(entries_.data()),
+                   static_cast<int>(entries_.size() * sizeof(Entry)));
+  // Write to a temporary file first so readers never see a partial index,
+  // failing to write is fine as the index is only a cache.
+  base::FilePath dir = index_path.DirName();
+  base::FilePath temp_path;
+  if (!base::CreateDirectory(dir) ||
+      !base::CreateTemporaryFileInDir(dir, &temp_path))
+    return;
+  int size = static_cast<int>(pickle.size());
+  if (base::WriteFile(temp_path, static_cast<const char*>(pickle.data()),
+                      size) != size ||
+      !base::ReplaceFile(temp_path, index_path, nullptr))
+    base::DeleteFile(temp_path, false);
+}
+
+void AsarArchive::AddFiles(const base::Value& files,
+                           std::string* prefix,
+                           Links* links) {
+  for (const auto& it : files.DictItems()) {
+    const base::Value& node = it.second;
+    if (!node.is_dict())
+      continue;
+    size_t prefix_size = prefix->size();
+    if (!prefix->empty())
+      prefix->push_back('/');
+    prefix->append(it.first);
+
+    const base::Value* children =
+        node.FindKeyOfType("files", base::Value::Type::DICTIONARY);
+    const base::Value* link =
+        node.FindKeyOfType("link", base::Value::Type::STRING);
+    if (children) {
+      AddFiles(*children, prefix, links);
+    } else if (link) {
+      links->emplace_back(*prefix, link->GetString());
+    } else {
+      // Unpacked files do not have offsets and are skipped, so are the
+      // malformed entries that do not fit in the archive.
+      const base::Value* size =
+          node.FindKeyOfType("size", base::Value::Type::INTEGER);
+      const base::Value* offset =
+          node.FindKeyOfType("offset", base::Value::Type::STRING);
+      FileInfo info;
+      if (size && size->GetInt() >= 0 && offset &&
+          base::StringToUint64(offset->GetString(), &info.offset) &&
+          info.offset <= file_length_ - content_offset_ &&
+          static_cast<uint64_t>(size->GetInt()) <=
+              file_length_ - content_offset_ - info.offset &&
+          ReadCompression(node, &info)) {
+        info.size = size->GetInt();
+        info.offset += content_offset_;
+        AddEntry(*prefix, info);
+      }
+    }
+
+    prefix->resize(prefix_size);
+  }
+}
+
+void AsarArchive::AddEntry(const std::string& path, const FileInfo& info) {
+  Entry entry;
+  entry.name_offset = static_cast<uint32_t>(names_.size());
+  entry.name_size = static_cast<uint32_t>(path.size());
+  entry.info = info;
+  names_.append(path);
+  entries_.push_back(entry);
+}
+
+void AsarArchive::SortEntries() {
+  std::sort(entries_.begin(), entries_.end(),
+            [this](const Entry& a, const Entry& b) {
+              return GetName(a) < GetName(b);
+            });
+}
+
+void AsarArchive::ResolveLinks(Links links) {
+  // Links can point to other links, so resolve them until no more can be
+  // found, which also stops on cyclic links.
+  while (!links.empty()) {
+    std::vector<std::pair<std::string, FileInfo>> resolved;
+    Links unresolved;
+    for (auto& link : links) {
+      FileInfo info;
+      if (GetFileInfo(link.second, &info))
+        resolved.emplace_back(std::move(link.first), info);
+      else
+        unresolved.push_back(std::move(link));
+    }
+    if (resolved.empty())
+      break;
+    for (const auto& entry : resolved)
+      AddEntry(entry.first, entry.second);
+    SortEntries();
+    links = std::move(unresolved);
+  }
+}
+
 }  // namespace nu
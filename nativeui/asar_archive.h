@@ -5,33 +5,132 @@
 #ifndef NATIVEUI_ASAR_ARCHIVE_H_
 #define NATIVEUI_ASAR_ARCHIVE_H_
 
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
 #include "base/values.h"
 #include "nativeui/nativeui_export.h"
 
+namespace base {
+class MemoryMappedFile;
+}
+
 namespace nu {
 
-class NATIVEUI_EXPORT AsarArchive {
+// Reads the information of files in an asar archive.
+//
+// The header is read from memory-mapped file and compiled into a sorted index
+// of file paths when opened, so looking up files does not allocate. The file
+// is only kept mapped while there are readers, so it can still be replaced on
+// Windows when nothing is loading.
+class NATIVEUI_EXPORT AsarArchive
+    : public base::RefCountedThreadSafe<AsarArchive> {
  public:
   struct FileInfo {
     uint32_t size = 0;
     uint64_t offset = 0;
+    // Compressed files are stored as a list of LZ4 blocks, each decompressed
+    // to |block_size| bytes except the last one.
+    bool compressed = false;
+    uint32_t block_size = 0;
+    uint32_t decompressed_size = 0;
   };
 
+  // Return the archive at |path|, which is shared by all callers until the
+  // file is modified.
+  //
+  // The index is saved to the per-user cache directory after parsing the
+  // header, and later opening loads it without parsing the header, as long as
+  // the archive has not been modified since then.
+  static scoped_refptr<AsarArchive> Open(const base::FilePath& path,
+                                         bool extended_format);
+
+  // Forget the opened archives that are not used by anyone, so their indexes
+  // are released. This is called by App::NotifyMemoryPressure.
+  static void ReleaseUnusedArchives();
+
   AsarArchive(base::File file, bool extended_format);
-  virtual ~AsarArchive();
 
   bool IsValid() const;
-  bool GetFileInfo(const std::string& path, FileInfo* info);
+
+  // Separators in |path| can be either slashes or backslashes.
+  bool GetFileInfo(base::StringPiece path, FileInfo* info) const;
+
+  // Return the whole archive file mapped in memory, which is shared by all
+  // readers of the archive until the last of them calls ReleaseMapping.
+  // Return null if the archive can not be mapped, and ReleaseMapping should
+  // not be called in that case.
+  base::StringPiece AcquireMapping();
+  void ReleaseMapping();
+
+  // Internal: Return where the index of archive at |path| with stats |info|
+  // is cached, or an empty path if there is no cache directory.
+  static base::FilePath GetIndexPath(const base::FilePath& path,
+                                     const base::File::Info& info);
+
+ protected:
+  virtual ~AsarArchive();
 
  private:
-  bool ReadExtendedMeta();
+  friend class base::RefCountedThreadSafe<AsarArchive>;
+
+  // Create an empty archive for loading index.
+  AsarArchive();
+
+  // Read and write the index file, which is only valid for the archive at
+  // |path| whose stats are |info|.
+  bool ReadIndex(const base::FilePath& index_path,
+                 const base::FilePath& path,
+                 const base::File::Info& info,
+                 bool extended_format);
+  void WriteIndex(const base::FilePath& index_path,
+                  const base::FilePath& path,
+                  const base::File::Info& info,
+                  bool extended_format) const;
+
+  struct Entry {
+    // Position of the normalized path in |names_|.
+    uint32_t name_offset;
+    uint32_t name_size;
+    FileInfo info;
+  };
+
+  using Links = std::vector<std::pair<std::string, std::string>>;
+
+  // Add the files in the |files| node of header to the index.
+  void AddFiles(const base::Value& files, std::string* prefix, Links* links);
+  void AddEntry(const std::string& path, const FileInfo& info);
+  void SortEntries();
+
+  // Link entries to the files they point to.
+  void ResolveLinks(Links links);
+
+  base::StringPiece GetName(const Entry& entry) const {
+    return base::StringPiece(names_).substr(entry.name_offset,
+                                            entry.name_size);
+  }
 
-  base::File file_;
-  base::Value header_;
   uint64_t content_offset_ = 0;
+  // Length of the archive file, entries running past it are rejected.
+  uint64_t file_length_ = 0;
+  bool valid_ = false;
+
+  // The archive file, which is mapped on demand.
+  base::FilePath path_;
+  base::Lock mapping_lock_;
+  int mapping_readers_ = 0;
+  std::unique_ptr<base::MemoryMappedFile> mapping_;
+
+  // The paths of all entries, stored in one buffer.
+  std::string names_;
+  std::vector<Entry> entries_;
 };
 
 }  // namespace nu
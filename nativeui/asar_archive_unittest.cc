@@ -0,0 +1,146 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/asar_archive.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/pickle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class AsarArchiveTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    path_ = dir_.GetPath().Append(FILE_PATH_LITERAL("test.asar"));
+  }
+
+  // Write an archive with |header| and |content|.
+  void WriteArchive(const std::string& header, const std::string& content) {
+    base::Pickle header_pickle;
+    header_pickle.WriteString(header);
+    base::Pickle size_pickle;
+    size_pickle.WriteUInt32(static_cast<uint32_t>(header_pickle.size()));
+    std::string data(static_cast<const char*>(size_pickle.data()),
+                     size_pickle.size());
+    data.append(static_cast<const char*>(header_pickle.data()),
+                header_pickle.size());
+    content_offset_ = data.size();
+    data += content;
+    int size = static_cast<int>(data.size());
+    ASSERT_EQ(base::WriteFile(path_, data.data(), size), size);
+  }
+
+  base::ScopedTempDir dir_;
+  base::FilePath path_;
+  uint64_t content_offset_ = 0;
+};
+
+TEST_F(AsarArchiveTest, GetFileInfo) {
+  WriteArchive(
+      "{\"files\":{"
+        "\"a.txt\":{\"size\":1,\"offset\":\"0\"},"
+        "\"dir\":{\"files\":{"
+          "\"b.txt\":{\"size\":2,\"offset\":\"1\"},"
+          "\"link\":{\"link\":\"a.txt\"}"
+        "}},"
+        "\"unpacked.txt\":{\"size\":3,\"unpacked\":true}"
+      "}}",
+      "abb");
+  scoped_refptr<nu::AsarArchive> archive =
+      nu::AsarArchive::Open(path_, false);
+  ASSERT_TRUE(archive && archive->IsValid());
+  nu::AsarArchive::FileInfo info;
+  ASSERT_TRUE(archive->GetFileInfo("dir/b.txt", &info));
+  EXPECT_EQ(info.size, 2u);
+  EXPECT_EQ(info.offset, content_offset_ + 1);
+  ASSERT_TRUE(archive->GetFileInfo("/dir\\\\b.txt/", &info));
+  EXPECT_EQ(info.offset, content_offset_ + 1);
+  ASSERT_TRUE(archive->GetFileInfo("dir/link", &info));
+  EXPECT_EQ(info.offset, content_offset_);
+  EXPECT_FALSE(archive->GetFileInfo("dir", &info));
+  EXPECT_FALSE(archive->GetFileInfo("dir/c.txt", &info));
+  EXPECT_FALSE(archive->GetFileInfo("unpacked.txt", &info));
+  // Opening again returns the same archive.
+  EXPECT_EQ(nu::AsarArchive::Open(path_, false), archive);
+}
+
+TEST_F(AsarArchiveTest, IndexFile) {
+  WriteArchive("{\"files\":{\"a.txt\":{\"size\":1,\"offset\":\"0\"}}}",
+               "a");
+  ASSERT_TRUE(nu::AsarArchive::Open(path_, false)->IsValid());
+  // The index is not written next to the archive.
+  EXPECT_FALSE(base::PathExists(
+      path_.AddExtension(FILE_PATH_LITERAL("index"))));
+  base::File::Info file_info;
+  ASSERT_TRUE(base::GetFileInfo(path_, &file_info));
+  base::FilePath index_path = nu::AsarArchive::GetIndexPath(path_, file_info);
+  if (!index_path.empty()) {
+    EXPECT_TRUE(base::PathExists(index_path));
+    base::DeleteFile(index_path, false);
+  }
+  // A modified archive does not use the stale index.
+  WriteArchive("{\"files\":{\"b.txt\":{\"size\":2,\"offset\":\"0\"}}}",
+               "bb");
+  base::Time time = base::Time::Now() + base::TimeDelta::FromHours(1);
+  ASSERT_TRUE(base::TouchFile(path_, time, time));
+  scoped_refptr<nu::AsarArchive> archive =
+      nu::AsarArchive::Open(path_, false);
+  nu::AsarArchive::FileInfo info;
+  EXPECT_FALSE(archive->GetFileInfo("a.txt", &info));
+  ASSERT_TRUE(archive->GetFileInfo("b.txt", &info));
+  EXPECT_EQ(info.size, 2u);
+  ASSERT_TRUE(base::GetFileInfo(path_, &file_info));
+  index_path = nu::AsarArchive::GetIndexPath(path_, file_info);
+  if (!index_path.empty())
+    base::DeleteFile(index_path, false);
+}
+
+TEST_F(AsarArchiveTest, Invalid) {
+  WriteArchive("not json", "");
+  scoped_refptr<nu::AsarArchive> archive =
+      nu::AsarArchive::Open(path_, false);
+  ASSERT_TRUE(archive);
+  EXPECT_FALSE(archive->IsValid());
+}
+
+TEST_F(AsarArchiveTest, MalformedEntries) {
+  WriteArchive(
+      "{\"files\":{"
+        "\"good.txt\":{\"size\":2,\"offset\":\"1\"},"
+        "\"negative.txt\":{\"size\":-1,\"offset\":\"0\"},"
+        "\"number.txt\":{\"size\":1,\"offset\":0},"
+        "\"text.txt\":{\"size\":1,\"offset\":\"abc\"},"
+        "\"past.txt\":{\"size\":3,\"offset\":\"1\"},"
+        "\"far.txt\":{\"size\":1,\"offset\":\"18446744073709551615\"}"
+      "}}",
+      "abc");
+  scoped_refptr<nu::AsarArchive> archive =
+      nu::AsarArchive::Open(path_, false);
+  ASSERT_TRUE(archive && archive->IsValid());
+  nu::AsarArchive::FileInfo info;
+  EXPECT_TRUE(archive->GetFileInfo("good.txt", &info));
+  EXPECT_FALSE(archive->GetFileInfo("negative.txt", &info));
+  EXPECT_FALSE(archive->GetFileInfo("number.txt", &info));
+  EXPECT_FALSE(archive->GetFileInfo("text.txt", &info));
+  EXPECT_FALSE(archive->GetFileInfo("past.txt", &info));
+  EXPECT_FALSE(archive->GetFileInfo("far.txt", &info));
+}
+
+TEST_F(AsarArchiveTest, SharedMapping) {
+  WriteArchive("{\"files\":{\"a.txt\":{\"size\":1,\"offset\":\"0\"}}}", "a");
+  scoped_refptr<nu::AsarArchive> archive =
+      nu::AsarArchive::Open(path_, false);
+  ASSERT_TRUE(archive && archive->IsValid());
+  base::StringPiece mapping = archive->AcquireMapping();
+  ASSERT_TRUE(mapping.data());
+  EXPECT_EQ(mapping.size(), content_offset_ + 1);
+  EXPECT_EQ(mapping.back(), 'a');
+  // All readers share the same mapping.
+  EXPECT_EQ(archive->AcquireMapping().data(), mapping.data());
+  archive->ReleaseMapping();
+  archive->ReleaseMapping();
+}
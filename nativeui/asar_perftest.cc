@@ -0,0 +1,221 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/logging.h"
+#include "base/pickle.h"
+#include "base/strings/stringprintf.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/protocol_asar_job.h"
+#include "nativeui/state.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const uint32_t kFileCounts[] = {1000, 10000, 100000};
+
+// Number of files in each directory of the synthetic archives.
+const uint32_t kFilesPerDir = 100;
+
+// Sizes of the files read by protocol jobs.
+const uint32_t kSmallFileSize = 4 * 1024;
+const uint32_t kLargeFileSize = 16 * 1024 * 1024;
+
+const size_t kBufferSizes[] = {4 * 1024, 64 * 1024, 1024 * 1024};
+
+const char kKey[] = "0123456789abcdef";
+const char kIV[] = "fedcba9876543210";
+
+std::string GetFilePath(uint32_t index) {
+  return base::StringPrintf("dir%u/file%u.txt", index / kFilesPerDir, index);
+}
+
+// Return |size| bytes different from their neighbours.
+std::string CreateContent(size_t size) {
+  std::string content(size, 0);
+  for (size_t i = 0; i < size; ++i)
+    content[i] = static_cast<char>(i * 7 + i / 256);
+  return content;
+}
+
+// Return |plain| encrypted with PKCS#7 padding.
+std::string Encrypt(const std::string& plain) {
+  size_t paddings = AES_BLOCKLEN - plain.size() % AES_BLOCKLEN;
+  std::string data = plain + std::string(paddings,
+                                         static_cast<char>(paddings));
+  nu::AES aes;
+  CHECK(aes.Init(kKey, kIV));
+  aes.CBCEncryptBuffer(reinterpret_cast<uint8_t*>(&data[0]),
+                       static_cast<uint32_t>(data.size()));
+  return data;
+}
+
+// Write an archive at |path| with |count| files of |content|, grouped into
+// directories of kFilesPerDir files.
+void WriteArchive(const base::FilePath& path,
+                  uint32_t count,
+                  const std::string& content) {
+  std::string header = "{\"files\":{";
+  for (uint32_t dir = 0; dir * kFilesPerDir < count; ++dir) {
+    if (dir > 0)
+      header += ',';
+    base::StringAppendF(&header, "\"dir%u\":{\"files\":{", dir);
+    for (uint32_t i = dir * kFilesPerDir;
+         i < count && i < (dir + 1) * kFilesPerDir; ++i) {
+      if (i > dir * kFilesPerDir)
+        header += ',';
+      base::StringAppendF(
+          &header, "\"file%u.txt\":{\"size\":%u,\"offset\":\"%llu\"}", i,
+          static_cast<uint32_t>(content.size()),
+          static_cast<unsigned long long>(i) * content.size());  // NOLINT
+    }
+    header += "}}";
+  }
+  header += "}}";
+
+  base::Pickle header_pickle;
+  header_pickle.WriteString(header);
+  base::Pickle size_pickle;
+  size_pickle.WriteUInt32(static_cast<uint32_t>(header_pickle.size()));
+  base::File file(path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  ASSERT_TRUE(file.IsValid());
+  file.WriteAtCurrentPos(static_cast<const char*>(size_pickle.data()),
+                         static_cast<int>(size_pickle.size()));
+  file.WriteAtCurrentPos(static_cast<const char*>(header_pickle.data()),
+                         static_cast<int>(header_pickle.size()));
+  for (uint32_t i = 0; i < count; ++i)
+    file.WriteAtCurrentPos(content.data(), static_cast<int>(content.size()));
+}
+
+}  // namespace
+
+class AsarPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    path_ = dir_.GetPath().Append(FILE_PATH_LITERAL("perf.asar"));
+  }
+
+  // Return where the index of current archive is cached.
+  base::FilePath GetIndexPath() {
+    base::File::Info info;
+    if (!base::GetFileInfo(path_, &info))
+      return base::FilePath();
+    return nu::AsarArchive::GetIndexPath(path_, info);
+  }
+
+  // Read all content of |file| in the archive with |buffer_size| chunks.
+  void ReadFile(const std::string& file, bool encrypted, size_t buffer_size) {
+    scoped_refptr<nu::ProtocolAsarJob> asar_job =
+        new nu::ProtocolAsarJob(path_, file);
+    if (encrypted)
+      ASSERT_TRUE(asar_job->SetDecipher(kKey, kIV));
+    scoped_refptr<nu::ProtocolJob> job = asar_job;
+    job->Plug([](int) {});
+    ASSERT_TRUE(job->Start());
+    buffer_.resize(buffer_size);
+    while (job->Read(&buffer_[0], buffer_size) > 0) {}
+  }
+
+  nu::State state_;
+  base::ScopedTempDir dir_;
+  base::FilePath path_;
+  std::string buffer_;
+};
+
+TEST_F(AsarPerfTest, Open) {
+  std::string content = CreateContent(64);
+  for (uint32_t count : kFileCounts) {
+    WriteArchive(path_, count, content);
+    base::FilePath index_path = GetIndexPath();
+    // Parsing the header and writing the index.
+    nu::RunPerfTest(base::StringPrintf("AsarOpenParseHeader/%u", count), 5,
+                    [&](int) {
+      base::DeleteFile(index_path, false);
+      ASSERT_TRUE(nu::AsarArchive::Open(path_, false)->IsValid());
+      nu::AsarArchive::ReleaseUnusedArchives();
+    });
+    // Loading the index written by the last open.
+    nu::RunPerfTest(base::StringPrintf("AsarOpenReadIndex/%u", count), 5,
+                    [&](int) {
+      ASSERT_TRUE(nu::AsarArchive::Open(path_, false)->IsValid());
+      nu::AsarArchive::ReleaseUnusedArchives();
+    });
+    // Returning the archive already opened.
+    scoped_refptr<nu::AsarArchive> archive =
+        nu::AsarArchive::Open(path_, false);
+    nu::RunPerfTest(base::StringPrintf("AsarOpenCached/%u", count), 1000,
+                    [&](int) { nu::AsarArchive::Open(path_, false); });
+    archive = nullptr;
+    nu::AsarArchive::ReleaseUnusedArchives();
+    base::DeleteFile(index_path, false);
+  }
+}
+
+TEST_F(AsarPerfTest, GetFileInfo) {
+  std::string content = CreateContent(64);
+  for (uint32_t count : kFileCounts) {
+    WriteArchive(path_, count, content);
+    scoped_refptr<nu::AsarArchive> archive =
+        nu::AsarArchive::Open(path_, false);
+    ASSERT_TRUE(archive->IsValid());
+    // Spread the lookups over the whole archive.
+    const int kLookups = 10000;
+    std::vector<std::string> paths(kLookups);
+    for (int i = 0; i < kLookups; ++i)
+      paths[i] = GetFilePath(static_cast<uint32_t>(i * 7919ull % count));
+    nu::AsarArchive::FileInfo info;
+    nu::RunPerfTest(base::StringPrintf("AsarGetFileInfo/%u", count), kLookups,
+                    [&](int i) { archive->GetFileInfo(paths[i], &info); });
+    nu::RunPerfTest(base::StringPrintf("AsarGetFileInfoMissing/%u", count),
+                    kLookups, [&](int i) {
+      archive->GetFileInfo(paths[i] + ".missing", &info);
+    });
+    archive = nullptr;
+    nu::AsarArchive::ReleaseUnusedArchives();
+  }
+}
+
+TEST_F(AsarPerfTest, ReadSmallFiles) {
+  const uint32_t kCount = 1000;
+  std::string content = CreateContent(kSmallFileSize);
+  for (bool encrypted : {false, true}) {
+    WriteArchive(path_, kCount, encrypted ? Encrypt(content) : content);
+    for (size_t buffer_size : kBufferSizes) {
+      nu::RunPerfTest(
+          base::StringPrintf("AsarReadSmallFile%s/%u/%u",
+                             encrypted ? "Encrypted" : "",
+                             kSmallFileSize,
+                             static_cast<uint32_t>(buffer_size)),
+          kCount, [&](int i) {
+        ReadFile(GetFilePath(i), encrypted, buffer_size);
+      });
+    }
+    nu::AsarArchive::ReleaseUnusedArchives();
+  }
+}
+
+TEST_F(AsarPerfTest, ReadLargeFile) {
+  std::string content = CreateContent(kLargeFileSize);
+  for (bool encrypted : {false, true}) {
+    WriteArchive(path_, 1, encrypted ? Encrypt(content) : content);
+    for (size_t buffer_size : kBufferSizes) {
+      nu::RunPerfTest(
+          base::StringPrintf("AsarReadLargeFile%s/%u/%u",
+                             encrypted ? "Encrypted" : "",
+                             kLargeFileSize,
+                             static_cast<uint32_t>(buffer_size)),
+          10, [&](int) {
+        ReadFile(GetFilePath(0), encrypted, buffer_size);
+      });
+    }
+    nu::AsarArchive::ReleaseUnusedArchives();
+  }
+}
@@ -0,0 +1,222 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/async_layout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "nativeui/container.h"
+#include "nativeui/label.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/state.h"
+#include "nativeui/util/worker_pool.h"
+#include "nativeui/util/yoga_util.h"
+#include "nativeui/window.h"
+#include "third_party/yoga/Yoga.h"
+
+namespace nu {
+
+namespace {
+
+// Sizes of a label measured in the main thread.
+struct MeasureSnapshot {
+  // Only used in the main thread.
+  Label* label;
+  // The size when text is not wrapped.
+  SizeF natural;
+  // The size when text is wrapped to |wrap_width|, the current width of label.
+  float wrap_width;
+  SizeF wrapped;
+  // Set when the worker has been asked for a width the text was not measured
+  // for, and the layout has to be computed again in the main thread.
+  bool inexact = false;
+};
+
+// Same with the measurement of Label, which leaves space for border.
+SizeF MeasureLabelText(Label* label, const SizeF& bounds) {
+  SizeF size = label->GetTextSizeFor(bounds);
+  size.Enlarge(1, 1);
+  return SizeF(std::ceil(size.width()), std::ceil(size.height()));
+}
+
+// Only uses the snapshot, so it is safe to be called in worker thread.
+YGSize MeasureFromSnapshot(YGNodeRef node,
+                           float width, YGMeasureMode mode,
+                           float height, YGMeasureMode height_mode) {
+  auto* snapshot = static_cast<MeasureSnapshot*>(YGNodeGetContext(node));
+  SizeF size = snapshot->natural;
+  if (mode != YGMeasureModeUndefined && width < size.width()) {
+    // Wrapping breaks the lines at the same places for any width between the
+    // widest line and the width the text was wrapped to.
+    if (width < snapshot->wrapped.width() || width > snapshot->wrap_width)
+      snapshot->inexact = true;
+    size = snapshot->wrapped;
+    size.set_width(std::min(size.width(), width));
+  }
+  if (mode == YGMeasureModeExactly)
+    size.set_width(width);
+  return {size.width(), size.height()};
+}
+
+// Measure the label directly, must be called in the main thread.
+YGSize MeasureLabel(YGNodeRef node,
+                    float width, YGMeasureMode mode,
+                    float height, YGMeasureMode height_mode) {
+  auto* snapshot = static_cast<MeasureSnapshot*>(YGNodeGetContext(node));
+  float nan = std::numeric_limits<float>::quiet_NaN();
+  SizeF size = MeasureLabelText(
+      snapshot->label, SizeF(mode == YGMeasureModeUndefined ? nan : width,
+                             nan));
+  if (mode == YGMeasureModeExactly)
+    size.set_width(width);
+  return {size.width(), size.height()};
+}
+
+}  // namespace
+
+struct AsyncLayout::Job {
+  struct Entry {
+    scoped_refptr<View> view;
+    View* parent;
+    int child_count;
+    YGNodeRef node;
+    RectF frame;
+  };
+
+  ~Job() {
+    // The nodes are freed from the root, in the main thread.
+    if (!entries.empty())
+      YGNodeFreeRecursive(entries[0].node);
+    YGConfigFree(config);
+  }
+
+  // Copy the styles of |view| and its children into detached nodes.
+  YGNodeRef Snapshot(View* view, View* parent) {
+    YGNodeRef node = YGNodeNewWithConfig(config);
+    YGNodeCopyStyle(node, view->node());
+    int child_count = view->IsContainer() ?
+        static_cast<Container*>(view)->ChildCount() : 0;
+    entries.push_back({view, parent, child_count, node, RectF()});
+    for (int i = 0; i < child_count; ++i) {
+      View* child = static_cast<Container*>(view)->ChildAt(i);
+      YGNodeInsertChild(node, Snapshot(child, view), i);
+    }
+    if (view->GetClassName() == Label::kClassName) {
+      auto* label = static_cast<Label*>(view);
+      float nan = std::numeric_limits<float>::quiet_NaN();
+      MeasureSnapshot snapshot;
+      snapshot.label = label;
+      snapshot.natural = MeasureLabelText(label, SizeF(nan, nan));
+      snapshot.wrap_width = YGNodeLayoutGetWidth(view->node());
+      snapshot.wrapped = MeasureLabelText(label,
+                                          SizeF(snapshot.wrap_width, nan));
+      measures.push_back(snapshot);
+      measured_nodes.push_back(node);
+    }
+    return node;
+  }
+
+  // The vector of snapshots may reallocate when building, so set the context
+  // after all children are added.
+  void SetMeasureFuncs() {
+    for (size_t i = 0; i < measured_nodes.size(); ++i) {
+      YGNodeSetContext(measured_nodes[i], &measures[i]);
+      YGNodeSetMeasureFunc(measured_nodes[i], MeasureFromSnapshot);
+    }
+  }
+
+  // Whether the tree has changed after taking snapshot.
+  bool IsStale() const {
+    for (const Entry& entry : entries) {
+      if (entry.view->GetParent() != entry.parent)
+        return true;
+      if (entry.view->IsContainer() &&
+          static_cast<Container*>(entry.view.get())->ChildCount() !=
+              entry.child_count)
+        return true;
+    }
+    return false;
+  }
+
+  // Whether any label was measured for a width not in the snapshot.
+  bool IsInexact() const {
+    for (const MeasureSnapshot& snapshot : measures) {
+      if (snapshot.inexact)
+        return true;
+    }
+    return false;
+  }
+
+  // Compute the frames, with the real labels when |measure_labels| is true.
+  void Calculate(bool measure_labels) {
+    for (YGNodeRef node : measured_nodes) {
+      YGNodeSetMeasureFunc(node, measure_labels ? MeasureLabel
+                                                : MeasureFromSnapshot);
+      YGNodeMarkDirty(node);
+    }
+    YGNodeRef root = entries[0].node;
+    YGNodeCalculateLayout(root, size.width(), size.height(), YGDirectionLTR);
+    for (Entry& entry : entries)
+      entry.frame = GetYGNodeBounds(entry.node);
+  }
+
+  // Called in the worker thread.
+  void Run() {
+    Calculate(false);
+    MessageLoop::PostTask([this]() { AsyncLayout::Apply(this); });
+  }
+
+  SizeF size;
+  Callback callback;
+  YGConfigRef config;
+  std::vector<Entry> entries;
+  std::vector<MeasureSnapshot> measures;
+  std::vector<YGNodeRef> measured_nodes;
+};
+
+// static
+void AsyncLayout::Compute(Container* root, const SizeF& size,
+                          Callback callback) {
+  Job* job = new Job;
+  job->size = size;
+  job->callback = std::move(callback);
+  job->config = YGConfigNew();
+  YGConfigCopy(job->config, root->GetWindow() ?
+                                root->GetWindow()->GetYogaConfig() :
+                                State::GetCurrent()->yoga_config());
+  // The root is laid out as a detached tree.
+  job->Snapshot(root, root->GetParent());
+  job->SetMeasureFuncs();
+  WorkerPool::PostTask([job]() { job->Run(); });
+}
+
+// static
+void AsyncLayout::Apply(Job* job) {
+  std::unique_ptr<Job> auto_delete(job);
+  // The state has been destroyed.
+  if (!State::GetCurrent())
+    return;
+  bool applied = !job->IsStale();
+  // The snapshot can not tell the height of text wrapped to other widths, so
+  // fall back to measuring the labels synchronously.
+  if (applied && job->IsInexact())
+    job->Calculate(true);
+  if (applied) {
+    // The root keeps its bounds, only its descendants are moved.
+    for (size_t i = 1; i < job->entries.size(); ++i) {
+      const Job::Entry& entry = job->entries[i];
+      if (entry.view->IsVisible())
+        entry.view->SetBounds(entry.frame);
+    }
+  }
+  if (job->callback)
+    job->callback(applied);
+}
+
+}  // namespace nu
@@ -0,0 +1,44 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_ASYNC_LAYOUT_H_
+#define NATIVEUI_ASYNC_LAYOUT_H_
+
+#include <functional>
+
+#include "base/macros.h"
+#include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class Container;
+
+// Compute the layout of a view tree on a worker thread.
+//
+// The styles of views are copied into a detached yoga tree, and the sizes of
+// labels are measured before starting the worker, so the views can still be
+// used while the layout is being computed. The computed frames are applied to
+// the views in the main thread.
+class NATIVEUI_EXPORT AsyncLayout {
+ public:
+  // Called with whether the frames have been applied, the frames are dropped
+  // when the tree has changed its structure.
+  using Callback = std::function<void(bool)>;
+
+  // Compute the layout of |root|'s children for |size|.
+  static void Compute(Container* root, const SizeF& size, Callback callback);
+
+ private:
+  struct Job;
+
+  // Apply the computed frames in the main thread.
+  static void Apply(Job* job);
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(AsyncLayout);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_ASYNC_LAYOUT_H_
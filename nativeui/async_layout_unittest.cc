@@ -0,0 +1,61 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class AsyncLayoutTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    container_ = new nu::Container;
+    child_ = new nu::Container;
+    child_->SetStyle("width", 50.f, "height", 60.f);
+    container_->AddChildView(child_.get());
+    container_->AddChildView(new nu::Label("text"));
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Container> container_;
+  scoped_refptr<nu::Container> child_;
+};
+
+TEST_F(AsyncLayoutTest, ApplyFrames) {
+  bool applied = false;
+  nu::AsyncLayout::Compute(container_.get(), nu::SizeF(200, 200),
+                           [&applied](bool result) {
+    applied = result;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(applied);
+  EXPECT_EQ(child_->GetBounds().size(), nu::SizeF(50, 60));
+  EXPECT_EQ(container_->ChildAt(1)->GetBounds().y(), 60);
+}
+
+TEST_F(AsyncLayoutTest, DropStaleFrames) {
+  bool applied = true;
+  nu::AsyncLayout::Compute(container_.get(), nu::SizeF(200, 200),
+                           [&applied](bool result) {
+    applied = result;
+    nu::MessageLoop::Quit();
+  });
+  container_->RemoveChildView(child_.get());
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(applied);
+}
+
+TEST_F(AsyncLayoutTest, MeasureWrappedTextForNewWidth) {
+  scoped_refptr<nu::Container> container = new nu::Container;
+  scoped_refptr<nu::Label> label = new nu::Label(
+      "some long text that is wrapped into many lines in a narrow width");
+  container->AddChildView(label.get());
+  float expected = container->GetPreferredHeightForWidth(60);
+  // The label is snapshotted with a width that does not wrap the text.
+  ASSERT_GT(expected, container->GetPreferredHeightForWidth(1000));
+  nu::AsyncLayout::Compute(container.get(), nu::SizeF(60, 1000),
+                           [](bool) { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(label->GetBounds().height(), expected);
+}
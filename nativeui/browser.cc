@@ -4,49 +4,352 @@
 
 #include "nativeui/browser.h"
 
+#include <string.h>
+
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <utility>
 
 #include "base/base64.h"
 #include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
 #include "base/json/string_escape.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/rand_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "nativeui/protocol_cache.h"
+#include "nativeui/state.h"
+#include "nativeui/trace_event.h"
 
 namespace nu {
 
+namespace {
+
+// Messages for buffer bindings start with this prefix, which can never be the
+// start of a JSON array.
+const char kBufferMessagePrefix[] = "b:";
+
+// Number of prewarmed browsers kept at most.
+const size_t kMaxPrewarmedBrowsers = 2;
+
+bool IsSameOptions(const Browser::Options& a, const Browser::Options& b) {
+  return a.devtools == b.devtools &&
+         a.context_menu == b.context_menu &&
+#if defined(OS_MACOSX) || defined(OS_LINUX)
+         a.allow_file_access_from_files == b.allow_file_access_from_files &&
+#endif
+#if defined(OS_LINUX)
+         a.hardware_acceleration == b.hardware_acceleration &&
+#endif
+#if defined(OS_WIN) && defined(WEBVIEW2_SUPPORT)
+         a.webview2_support == b.webview2_support &&
+         a.webview2_force_ie == b.webview2_force_ie &&
+#endif
+         true;
+}
+
+// A buffer waiting to be requested by web page.
+struct BufferResource : public base::RefCountedThreadSafe<BufferResource> {
+  Browser* owner;
+  Buffer buffer;
+  std::string mime_type;
+
+ private:
+  friend class base::RefCountedThreadSafe<BufferResource>;
+  ~BufferResource() {}
+};
+
+// The buffers served by all browsers, keyed by their URLs. The protocol
+// handler and browsers both run in main thread so no lock is needed.
+using BufferResourceMap = std::map<std::string, scoped_refptr<BufferResource>>;
+base::LazyInstance<BufferResourceMap>::Leaky g_buffer_resources =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Serve a buffer, which is released when the job is done.
+class ProtocolBufferJob : public ProtocolJob {
+ public:
+  explicit ProtocolBufferJob(scoped_refptr<BufferResource> resource)
+      : resource_(std::move(resource)) {
+    SetCacheControl("no-store");
+  }
+
+  // ProtocolJob:
+  bool Start() override {
+    notify_content_length(static_cast<int>(resource_->buffer.size()));
+    return true;
+  }
+
+  bool GetMimeType(std::string* mime_type) override {
+    if (resource_->mime_type.empty())
+      return false;
+    *mime_type = resource_->mime_type;
+    return true;
+  }
+
+  size_t Read(void* buf, size_t buf_size) override {
+    size_t size = resource_->buffer.size();
+    if (pos_ == size || buf_size == 0)
+      return 0;
+    size_t nread = std::min(buf_size, size - pos_);
+    memcpy(buf, static_cast<char*>(resource_->buffer.content()) + pos_, nread);
+    pos_ += nread;
+    return nread;
+  }
+
+  bool GetContent(base::StringPiece* content) override {
+    *content = base::StringPiece(
+        static_cast<const char*>(resource_->buffer.content()),
+        resource_->buffer.size());
+    return true;
+  }
+
+  bool Seek(int64_t offset) override {
+    if (offset < 0 || offset > static_cast<int64_t>(resource_->buffer.size()))
+      return false;
+    pos_ = static_cast<size_t>(offset);
+    return true;
+  }
+
+ private:
+  ~ProtocolBufferJob() override {}
+
+  scoped_refptr<BufferResource> resource_;
+  size_t pos_ = 0;
+};
+
+ProtocolJob* HandleBufferRequest(const std::string& url) {
+  BufferResourceMap* resources = g_buffer_resources.Pointer();
+  std::string key = url;
+  base::TrimString(key, "/", &key);
+  auto it = resources->find(key);
+  if (it == resources->end())
+    return nullptr;
+  // Buffers can only be requested once.
+  ProtocolJob* job = new ProtocolBufferJob(std::move(it->second));
+  resources->erase(it);
+  return job;
+}
+
+// Script that installs bindings, which is called with the security key, the
+// object for posting messages, the object to add bindings to, and a table
+// mapping method names to their kinds:
+// 0: Arguments are sent in JSON.
+// 1: Buffer bindings send the bytes of ArrayBuffer or typed arrays in base64
+//    after kBufferMessagePrefix, without converting them to JSON.
+// 2: Async bindings return Promises, the pending calls are kept in a hidden
+//    global object that survives updates of bindings, and the ids are
+//    prefixed with a random string so replies for previous pages are ignored.
+const char kBindingShim[] =
+    "(function(key, external, binding, methods) {"
+    "  function call(name) {"
+    "    return function() {"
+    "      var args = Array.prototype.slice.call(arguments);"
+    "      external.postMessage(JSON.stringify([key, name, args]));"
+    "    };"
+    "  }"
+    "  function callBuffer(name) {"
+    "    return function(data) {"
+    "      var bytes = ArrayBuffer.isView(data) ?"
+    "          new Uint8Array(data.buffer, data.byteOffset, data.byteLength) :"
+    "          new Uint8Array(data);"
+    "      var str = '';"
+    "      for (var i = 0; i < bytes.length; i += 0x8000)"
+    "        str += String.fromCharCode.apply("
+    "            null, bytes.subarray(i, i + 0x8000));"
+    "      external.postMessage('b:' + key + ':' + name + ':' + btoa(str));"
+    "    };"
+    "  }"
+    "  function callAsync(name) {"
+    "    var replies = window.__yueReplies;"
+    "    if (!replies) {"
+    "      replies = {prefix: Math.random().toString(36).slice(2) + ':',"
+    "                 count: 0};"
+    "      Object.defineProperty(window, '__yueReplies', {value: replies});"
+    "    }"
+    "    return function() {"
+    "      var args = Array.prototype.slice.call(arguments);"
+    "      return new Promise(function(resolve, reject) {"
+    "        var id = replies.prefix + (++replies.count);"
+    "        replies[id] = [resolve, reject];"
+    "        external.postMessage(JSON.stringify([key, name, args, id]));"
+    "      });"
+    "    };"
+    "  }"
+    "  var kinds = [call, callBuffer, callAsync];"
+    "  for (var name in methods)"
+    "    binding[name] = kinds[methods[name]](name);"
+    "})";
+
+// Pushed messages are flushed once per frame.
+const int kFlushMessagesDelay = 16;
+
+// Script wrapping pending messages, the "b" function converts base64 strings
+// to ArrayBuffer. The legacy event APIs are used to support IE.
+const char kDispatchMessagesBegin[] =
+    "(function(b) {"
+    "  var m = [";
+const char kDispatchMessagesEnd[] =
+    "];"
+    "  for (var i = 0; i < m.length; ++i) {"
+    "    var e = document.createEvent('CustomEvent');"
+    "    e.initCustomEvent('yuemessage', false, false, m[i]);"
+    "    window.dispatchEvent(e);"
+    "  }"
+    "})(function(s) {"
+    "  var r = atob(s), a = new Uint8Array(r.length);"
+    "  for (var i = 0; i < r.length; ++i) a[i] = r.charCodeAt(i);"
+    "  return a.buffer;"
+    "});";
+
+}  // namespace
+
 // static
 const char Browser::kClassName[] = "Browser";
 
-Browser::Browser(Options options) {
+// static
+const char Browser::kBufferScheme[] = "yue-buffer";
+
+Browser::Browser(Options options)
+    : options_(options), weak_factory_(this) {
   PlatformInit(std::move(options));
   // Generate a random number as security key.
   base::Base64Encode(base::RandBytesAsString(16), &security_key_);
 }
 
 Browser::~Browser() {
+  if (flush_timer_)
+    MessageLoop::ClearTimeout(flush_timer_);
+  BufferResourceMap* resources = g_buffer_resources.Pointer();
+  for (auto it = resources->begin(); it != resources->end();) {
+    if (it->second->owner == this)
+      it = resources->erase(it);
+    else
+      ++it;
+  }
   PlatformDestroy();
 }
 
+// static
+void Browser::Prewarm(Options options) {
+  auto& browsers = State::GetCurrent()->prewarmed_browsers();
+  if (browsers.size() >= kMaxPrewarmedBrowsers)
+    return;
+  scoped_refptr<Browser> browser = new Browser(std::move(options));
+  // Loading a page starts the web engine's processes.
+  browser->LoadURL("about:blank");
+  browsers.push_back(std::move(browser));
+}
+
+// static
+scoped_refptr<Browser> Browser::Acquire(Options options) {
+  auto& browsers = State::GetCurrent()->prewarmed_browsers();
+  for (auto it = browsers.begin(); it != browsers.end(); ++it) {
+    if (IsSameOptions((*it)->options_, options)) {
+      scoped_refptr<Browser> browser = std::move(*it);
+      browsers.erase(it);
+      return browser;
+    }
+  }
+  return new Browser(std::move(options));
+}
+
+// static
+bool Browser::RegisterProtocol(const std::string& scheme,
+                               const ProtocolHandler& handler) {
+  ProtocolCache* cache = ProtocolCache::GetInstance();
+  cache->ClearScheme(scheme);
+  return PlatformRegisterProtocol(scheme, cache->Wrap(handler));
+}
+
+// static
+void Browser::UnregisterProtocol(const std::string& scheme) {
+  ProtocolCache::GetInstance()->ClearScheme(scheme);
+  PlatformUnregisterProtocol(scheme);
+}
+
+// static
+void Browser::SetProtocolCacheBudget(size_t bytes) {
+  ProtocolCache::GetInstance()->SetBudget(bytes);
+}
+
+// static
+size_t Browser::GetProtocolCacheBudget() {
+  return ProtocolCache::GetInstance()->GetBudget();
+}
+
+// static
+size_t Browser::GetProtocolCacheUsage() {
+  return ProtocolCache::GetInstance()->GetUsage();
+}
+
+// static
+void Browser::ClearProtocolCache() {
+  ProtocolCache::GetInstance()->Clear();
+}
+
 const char* Browser::GetClassName() const {
   return kClassName;
 }
 
-void Browser::SetBindingName(const std::string& name) {
-  base::EscapeJSONString(name, false, &binding_name_);
+void Browser::ExecuteJavaScriptRaw(const std::string& code,
+                                   const RawExecutionCallback& callback) {
+  if (!callback) {
+    ExecuteJavaScript(code, nullptr);
+    return;
+  }
+  // The result is serialized by the browser engine instead of wrapping code
+  // with eval, which is blocked by content security policies.
+  PlatformExecuteJavaScriptRaw(code, callback);
+}
+
+void Browser::UpdateBindings() {
+  binding_table_.clear();
   if (!stop_serving_)
     PlatformUpdateBindings();
 }
 
+void Browser::SetBindingName(const std::string& name) {
+  base::EscapeJSONString(name, false, &binding_name_);
+  UpdateBindings();
+}
+
 void Browser::AddRawBinding(const std::string& name, const BindingFunc& func) {
   if (name.empty())
     return;
   std::string escaped;
   base::EscapeJSONString(name, false, &escaped);
+  buffer_bindings_.erase(escaped);
+  async_bindings_.erase(escaped);
   bindings_[escaped] = func;
-  if (!stop_serving_)
-    PlatformUpdateBindings();
+  UpdateBindings();
+}
+
+void Browser::AddBufferBinding(const std::string& name,
+                               const BufferBindingFunc& func) {
+  if (name.empty())
+    return;
+  std::string escaped;
+  base::EscapeJSONString(name, false, &escaped);
+  bindings_.erase(escaped);
+  async_bindings_.erase(escaped);
+  buffer_bindings_[escaped] = func;
+  UpdateBindings();
+}
+
+void Browser::AddAsyncBinding(const std::string& name,
+                              const AsyncBindingFunc& func) {
+  if (name.empty())
+    return;
+  std::string escaped;
+  base::EscapeJSONString(name, false, &escaped);
+  bindings_.erase(escaped);
+  buffer_bindings_.erase(escaped);
+  async_bindings_[escaped] = func;
+  UpdateBindings();
 }
 
 void Browser::RemoveBinding(const std::string& name) {
@@ -55,22 +358,73 @@ void Browser::RemoveBinding(const std::string& name) {
   std::string escaped;
   base::EscapeJSONString(name, false, &escaped);
   bindings_.erase(escaped);
-  if (!stop_serving_)
-    PlatformUpdateBindings();
+  buffer_bindings_.erase(escaped);
+  async_bindings_.erase(escaped);
+  UpdateBindings();
 }
 
 bool Browser::HasBindings() const {
-  return !bindings_.empty();
+  return !bindings_.empty() || !buffer_bindings_.empty() ||
+         !async_bindings_.empty();
+}
+
+std::string Browser::CreateBufferURL(Buffer buffer,
+                                     const std::string& mime_type) {
+  BufferResourceMap* resources = g_buffer_resources.Pointer();
+  // Register the internal scheme on first use.
+  static bool registered = false;
+  if (!registered)
+    registered = RegisterProtocol(kBufferScheme, &HandleBufferRequest);
+  scoped_refptr<BufferResource> resource = new BufferResource;
+  resource->owner = this;
+  resource->buffer = std::move(buffer);
+  resource->mime_type = mime_type;
+  std::string url = base::StringPrintf(
+      "%s://%s", kBufferScheme,
+      base::ToLowerASCII(base::HexEncode(base::RandBytesAsString(16).data(),
+                                         16)).c_str());
+  (*resources)[url] = std::move(resource);
+  return url;
+}
+
+void Browser::RevokeBufferURL(const std::string& url) {
+  BufferResourceMap* resources = g_buffer_resources.Pointer();
+  auto it = resources->find(url);
+  if (it != resources->end() && it->second->owner == this)
+    resources->erase(it);
+}
+
+void Browser::PushMessage(const base::Value& message) {
+  std::string json;
+  if (!base::JSONWriter::Write(message, &json))
+    return;
+  QueueMessage(json);
 }
 
-bool Browser::InvokeBindings(const std::string& json_str) {
+void Browser::PushMessage(const Buffer& buffer) {
+  std::string encoded;
+  base::Base64Encode(
+      base::StringPiece(static_cast<const char*>(buffer.content()),
+                        buffer.size()),
+      &encoded);
+  QueueMessage("b(\"" + encoded + "\")");
+}
+
+bool Browser::InvokeBindings(const std::string& message) {
+  NU_TRACE_EVENT("browser", "Browser::InvokeBindings");
   if (stop_serving_)
     return false;
+  if (base::StartsWith(message, kBufferMessagePrefix,
+                       base::CompareCase::SENSITIVE))
+    return InvokeBufferBinding(message);
 
-  base::Optional<base::Value> tup = base::JSONReader::Read(json_str);
+  // The message is [key, method, args] for bindings, and
+  // [key, method, args, id] for async bindings.
+  base::Optional<base::Value> tup = base::JSONReader::Read(message);
   if (!tup)
     return false;
-  if (!tup->is_list() || tup->GetList().size() != 3 ||
+  if (!tup->is_list() ||
+      (tup->GetList().size() != 3 && tup->GetList().size() != 4) ||
       !tup->GetList()[0].is_string() ||
       !tup->GetList()[1].is_string() ||
       !tup->GetList()[2].is_list())
@@ -80,10 +434,21 @@ bool Browser::InvokeBindings(const std::string& json_str) {
   const std::string& method = tup->GetList()[1].GetString();
   base::Value args = std::move(tup->GetList()[2]);
 
-  if (key != security_key_) {
-    stop_serving_ = true;
-    LOG(ERROR) << "Recevied invalid key, stop serving navite bindings";
+  if (!CheckBindingKey(key))
     return false;
+  NU_TRACE_EVENT_WITH_ARG("browser", "Browser::RunBinding", method);
+  if (tup->GetList().size() == 4) {
+    if (!tup->GetList()[3].is_string())
+      return false;
+    auto it = async_bindings_.find(method);
+    if (it == async_bindings_.end()) {
+      LOG(ERROR) << "Invoking invalid method: " << method;
+      return false;
+    }
+    scoped_refptr<BrowserReply> reply =
+        new BrowserReply(this, tup->GetList()[3].GetString());
+    it->second(this, std::move(args), reply.get());
+    return true;
   }
   auto it = bindings_.find(method);
   if (it == bindings_.end()) {
@@ -94,8 +459,61 @@ bool Browser::InvokeBindings(const std::string& json_str) {
   return true;
 }
 
+bool Browser::CheckBindingKey(const std::string& key) {
+  if (key != security_key_) {
+    stop_serving_ = true;
+    LOG(ERROR) << "Recevied invalid key, stop serving navite bindings";
+    return false;
+  }
+  return true;
+}
+
+bool Browser::InvokeBufferBinding(base::StringPiece message) {
+  // The message is "prefix<key>:<method>:<base64 data>", the key and data
+  // do not include colons.
+  message.remove_prefix(strlen(kBufferMessagePrefix));
+  size_t key_end = message.find(':');
+  size_t data_start = message.rfind(':');
+  if (key_end == base::StringPiece::npos || key_end == data_start)
+    return false;
+  if (!CheckBindingKey(message.substr(0, key_end).as_string()))
+    return false;
+  std::string method;
+  base::EscapeJSONString(
+      message.substr(key_end + 1, data_start - key_end - 1), false, &method);
+  auto it = buffer_bindings_.find(method);
+  if (it == buffer_bindings_.end()) {
+    LOG(ERROR) << "Invoking invalid method: " << method;
+    return false;
+  }
+  // Decode into a string that is owned by the buffer.
+  std::unique_ptr<std::string> data(new std::string);
+  if (!base::Base64Decode(message.substr(data_start + 1), data.get()))
+    return false;
+  std::string* content = data.release();
+  it->second(this, Buffer::TakeOver(&(*content)[0], content->size(),
+                                    [content](void*) { delete content; }));
+  return true;
+}
+
 std::string Browser::GetBindingScript() {
-  std::string code = "(function(key, external, binding) {";
+  // The table of methods only changes when bindings change.
+  if (binding_table_.empty()) {
+    binding_table_ = "{";
+    auto append = [this](const std::string& method, int kind) {
+      if (binding_table_.size() > 1)
+        binding_table_ += ',';
+      binding_table_ += base::StringPrintf("\"%s\":%d", method.c_str(), kind);
+    };
+    for (const auto& it : bindings_)
+      append(it.first, 0);
+    for (const auto& it : buffer_bindings_)
+      append(it.first, 1);
+    for (const auto& it : async_bindings_)
+      append(it.first, 2);
+    binding_table_ += '}';
+  }
+  std::string code = kBindingShim;
   std::string name = binding_name_;
   if (name.empty()) {
     name = "window";
@@ -104,16 +522,7 @@ std::string Browser::GetBindingScript() {
     name = base::StringPrintf("window[\"%s\"]", name.c_str());
     code = name + " = {};" + code;
   }
-  // Insert bindings.
-  for (const auto& it : bindings_) {
-    code += base::StringPrintf(
-        "binding[\"%s\"] = function() {"
-        "  var args = Array.prototype.slice.call(arguments);"
-        "  external.postMessage(JSON.stringify([key, \"%s\", args]));"
-        "};",
-        it.first.c_str(), it.first.c_str());
-  }
-  code += base::StringPrintf("})(\"%s\", %s, %s);",
+  code += base::StringPrintf("(\"%s\", %s, %s, %s);",
                              security_key_.c_str(),
 #if defined(OS_WIN)
 #if defined(WEBVIEW2_SUPPORT)
@@ -123,8 +532,46 @@ std::string Browser::GetBindingScript() {
 #else
                              "window.webkit.messageHandlers.yue",
 #endif
-                             name.c_str());
+                             name.c_str(),
+                             binding_table_.c_str());
   return code;
 }
 
+void Browser::SendReply(const std::string& id,
+                        bool success,
+                        const base::Value& value) {
+  std::string json;
+  if (!base::JSONWriter::Write(value, &json))
+    json = "null";
+  std::string escaped;
+  base::EscapeJSONString(id, true, &escaped);
+  ExecuteJavaScript(base::StringPrintf(
+      "(function(r, id, success, value) {"
+      "  var p = r && r[id];"
+      "  if (!p) return;"
+      "  delete r[id];"
+      "  p[success ? 0 : 1](value);"
+      "})(window.__yueReplies, %s, %s, %s);",
+      escaped.c_str(), success ? "true" : "false", json.c_str()),
+      nullptr);
+}
+
+void Browser::QueueMessage(const std::string& message) {
+  if (!pending_messages_.empty())
+    pending_messages_ += ',';
+  pending_messages_ += message;
+  if (!flush_timer_)
+    flush_timer_ = MessageLoop::SetTimeout(
+        kFlushMessagesDelay, [this]() { FlushMessages(); });
+}
+
+void Browser::FlushMessages() {
+  flush_timer_ = 0;
+  std::string code = kDispatchMessagesBegin;
+  code += pending_messages_;
+  code += kDispatchMessagesEnd;
+  pending_messages_.clear();
+  ExecuteJavaScript(code, nullptr);
+}
+
 }  // namespace nu
@@ -9,7 +9,10 @@
 #include <string>
 #include <utility>
 
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
+#include "nativeui/browser_reply.h"
+#include "nativeui/buffer.h"
 #include "nativeui/protocol_job.h"
 #include "nativeui/util/function_caller.h"
 #include "nativeui/view.h"
@@ -20,7 +23,11 @@ class NATIVEUI_EXPORT Browser : public View {
  public:
   using ProtocolHandler = std::function<ProtocolJob*(const std::string&)>;
   using ExecutionCallback = std::function<void(bool, base::Value)>;
+  using RawExecutionCallback = std::function<void(bool, std::string)>;
   using BindingFunc = std::function<void(Browser*, base::Value)>;
+  using BufferBindingFunc = std::function<void(Browser*, Buffer)>;
+  using AsyncBindingFunc =
+      std::function<void(Browser*, base::Value, BrowserReply*)>;
 
   struct Options {
     bool devtools = false;
@@ -48,6 +55,23 @@ class NATIVEUI_EXPORT Browser : public View {
                                const ProtocolHandler& handler);
   static void UnregisterProtocol(const std::string& scheme);
 
+  // Protocol cache APIs.
+  static void SetProtocolCacheBudget(size_t bytes);
+  static size_t GetProtocolCacheBudget();
+  static size_t GetProtocolCacheUsage();
+  static void ClearProtocolCache();
+
+  // Create a browser with |options| and keep it in a small pool, so it has
+  // finished starting when it is taken by Acquire.
+  static void Prewarm(Options options);
+
+  // Take a prewarmed browser created with the same |options|, or create a new
+  // one if there is none.
+  static scoped_refptr<Browser> Acquire(Options options);
+
+  // Scheme of the URLs returned by CreateBufferURL.
+  static const char kBufferScheme[];
+
   // View:
   const char* GetClassName() const override;
 
@@ -61,6 +85,10 @@ class NATIVEUI_EXPORT Browser : public View {
   void SetUserAgent(const std::string& user_agent);
   void ExecuteJavaScript(const std::string& code,
                          const ExecutionCallback& callback);
+  // Like ExecuteJavaScript but pass the result as a JSON string, which is
+  // cheaper than converting large results to base::Value.
+  void ExecuteJavaScriptRaw(const std::string& code,
+                            const RawExecutionCallback& callback);
 
   void GoBack();
   bool CanGoBack() const;
@@ -72,9 +100,22 @@ class NATIVEUI_EXPORT Browser : public View {
 
   void SetBindingName(const std::string& name);
   void AddRawBinding(const std::string& name, const BindingFunc& func);
+  void AddBufferBinding(const std::string& name,
+                        const BufferBindingFunc& func);
+  void AddAsyncBinding(const std::string& name, const AsyncBindingFunc& func);
   void RemoveBinding(const std::string& name);
   bool HasBindings() const;
 
+  // Serve |buffer| to web page under a generated URL, the buffer is released
+  // after the URL is requested once, or when the browser is destroyed.
+  std::string CreateBufferURL(Buffer buffer, const std::string& mime_type);
+  void RevokeBufferURL(const std::string& url);
+
+  // Push messages to the "yuemessage" listeners of web page, messages pushed
+  // in the same frame are delivered together.
+  void PushMessage(const base::Value& message);
+  void PushMessage(const Buffer& buffer);
+
   // Automatically deduce argument types.
   template<typename Sig>
   void AddBinding(const std::string& name, const std::function<Sig>& func) {
@@ -100,15 +141,23 @@ class NATIVEUI_EXPORT Browser : public View {
   Signal<void(Browser*, const std::string&, int)> on_fail_navigation;
   Signal<void(Browser*, const std::string&)> on_finish_navigation;
 
-  // Internal: Called from web pages to invoke native bindings.
-  bool InvokeBindings(const std::string& json_arg);
+  // Internal: Called from web pages to invoke native bindings, the |message|
+  // is either a JSON string of arguments, or binary data for buffer bindings.
+  bool InvokeBindings(const std::string& message);
 
   // Internal: Generate the user script to inject bindings.
   std::string GetBindingScript();
 
+  // Internal: Settle the Promise of async binding call with |id|.
+  void SendReply(const std::string& id,
+                 bool success,
+                 const base::Value& value);
+
   // Internal: Access to bindings properties.
   bool stop_serving() const { return stop_serving_; }
 
+  base::WeakPtr<Browser> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
+
 #if defined(OS_WIN) && defined(WEBVIEW2_SUPPORT)
   std::function<void()>& pending_load() { return pending_load_; }
 #endif
@@ -120,6 +169,16 @@ class NATIVEUI_EXPORT Browser : public View {
   void PlatformInit(Options options);
   void PlatformDestroy();
   void PlatformUpdateBindings();
+  void PlatformExecuteJavaScriptRaw(const std::string& code,
+                                    const RawExecutionCallback& callback);
+
+  static bool PlatformRegisterProtocol(const std::string& scheme,
+                                       const ProtocolHandler& handler);
+  static void PlatformUnregisterProtocol(const std::string& scheme);
+
+  // The options used for creating the browser, used for matching prewarmed
+  // browsers.
+  Options options_;
 
   // Prevent malicous calls to native bindings.
   std::string security_key_;
@@ -130,8 +189,33 @@ class NATIVEUI_EXPORT Browser : public View {
   std::function<void()> pending_load_;
 #endif
 
+  // Drop the cached table of methods and update the bindings in web page.
+  void UpdateBindings();
+
+  // Verify the |key| of message, and stop serving if it is invalid.
+  bool CheckBindingKey(const std::string& key);
+
+  // Parse the binary |message| for buffer bindings.
+  bool InvokeBufferBinding(base::StringPiece message);
+
+  // Queue the serialized |message| and schedule a flush.
+  void QueueMessage(const std::string& message);
+
+  // Dispatch all pending messages in one script execution.
+  void FlushMessages();
+
   std::string binding_name_;
+  // Cached JSON object mapping method names to their kinds.
+  std::string binding_table_;
   std::map<std::string, BindingFunc> bindings_;
+  std::map<std::string, BufferBindingFunc> buffer_bindings_;
+  std::map<std::string, AsyncBindingFunc> async_bindings_;
+
+  // Messages waiting to be pushed, as comma separated JavaScript expressions.
+  std::string pending_messages_;
+  MessageLoop::TimerId flush_timer_ = 0;
+
+  base::WeakPtrFactory<Browser> weak_factory_;
 };
 
 }  // namespace nu
@@ -0,0 +1,35 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/browser_reply.h"
+
+#include "nativeui/browser.h"
+
+namespace nu {
+
+BrowserReply::BrowserReply(Browser* browser, const std::string& id)
+    : browser_(browser->GetWeakPtr()), id_(id) {}
+
+BrowserReply::~BrowserReply() {
+  if (!done_)
+    Send(false, base::Value("The reply was dropped without result"));
+}
+
+void BrowserReply::Resolve(const base::Value& result) {
+  Send(true, result);
+}
+
+void BrowserReply::Reject(const base::Value& error) {
+  Send(false, error);
+}
+
+void BrowserReply::Send(bool success, const base::Value& value) {
+  if (done_)
+    return;
+  done_ = true;
+  if (browser_)
+    browser_->SendReply(id_, success, value);
+}
+
+}  // namespace nu
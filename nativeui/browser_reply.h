@@ -0,0 +1,46 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_BROWSER_REPLY_H_
+#define NATIVEUI_BROWSER_REPLY_H_
+
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/values.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class Browser;
+
+// Settles the Promise returned by an async binding in web page, it can be
+// kept and completed later, for example from a MessageLoop task.
+class NATIVEUI_EXPORT BrowserReply : public base::RefCounted<BrowserReply> {
+ public:
+  BrowserReply(Browser* browser, const std::string& id);
+
+  void Resolve(const base::Value& result);
+  void Reject(const base::Value& error);
+  bool IsDone() const { return done_; }
+
+ private:
+  friend class base::RefCounted<BrowserReply>;
+
+  // The Promise is rejected if it is never settled.
+  ~BrowserReply();
+
+  void Send(bool success, const base::Value& value);
+
+  base::WeakPtr<Browser> browser_;
+  std::string id_;
+  bool done_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(BrowserReply);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_BROWSER_REPLY_H_
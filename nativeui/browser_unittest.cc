@@ -7,6 +7,7 @@
 #include "base/files/scoped_temp_dir.h"
 #include "base/json/json_writer.h"
 #include "base/path_service.h"
+#include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "nativeui/nativeui.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -60,6 +61,22 @@ TEST_P(BrowserTest, DestroyAndCreate) {
   browser_ = new nu::Browser(nu::Browser::Options());
 }
 
+TEST_P(BrowserTest, PrewarmAndAcquire) {
+  nu::Browser::Options options;
+  nu::Browser::Prewarm(options);
+  nu::Browser::Prewarm(options);
+  nu::Browser::Prewarm(options);
+  ASSERT_EQ(state_.prewarmed_browsers().size(), 2u);
+  nu::Browser* prewarmed = state_.prewarmed_browsers()[0].get();
+  scoped_refptr<nu::Browser> browser = nu::Browser::Acquire(options);
+  EXPECT_EQ(browser.get(), prewarmed);
+  EXPECT_EQ(state_.prewarmed_browsers().size(), 1u);
+  options.devtools = true;
+  browser = nu::Browser::Acquire(options);
+  EXPECT_NE(browser.get(), nullptr);
+  EXPECT_EQ(state_.prewarmed_browsers().size(), 1u);
+}
+
 TEST_P(BrowserTest, LoadURL) {
   browser_->on_finish_navigation.Connect([](nu::Browser* browser,
                                             const std::string& url) {
@@ -174,6 +191,43 @@ TEST_P(BrowserTest, LoadHTMLWithScript) {
   nu::MessageLoop::Run();
 }
 
+TEST_P(BrowserTest, ExecuteJavaScriptRaw) {
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScriptRaw("var obj = {a: [1, 'b']};"
+                                  "obj",
+                                  [](bool success, std::string json) {
+      nu::MessageLoop::Quit();
+      ASSERT_EQ(success, true);
+      ASSERT_EQ(json, "{\"a\":[1,\"b\"]}");
+    });
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<html></html>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
+TEST_P(BrowserTest, ExecuteJavaScriptRawWithoutUnsafeEval) {
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScriptRaw("[1 + 1, 'a']",
+                                  [](bool success, std::string json) {
+      nu::MessageLoop::Quit();
+      ASSERT_EQ(success, true);
+      ASSERT_EQ(json, "[2,\"a\"]");
+    });
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<html><head>"
+                       "<meta http-equiv=\"Content-Security-Policy\""
+                       " content=\"script-src 'self'\">"
+                       "</head></html>",
+                       "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
 TEST_P(BrowserTest, LoadHTMLBaseURL) {
 #if defined(OS_WIN) && defined(WEBVIEW2_SUPPORT)
   if (browser_->IsWebView2())
@@ -301,6 +355,79 @@ TEST_P(BrowserTest, AddBinding) {
   nu::MessageLoop::Run();
 }
 
+TEST_P(BrowserTest, AddBufferBinding) {
+  browser_->AddBufferBinding("method", [](nu::Browser*, nu::Buffer buffer) {
+    nu::MessageLoop::Quit();
+    ASSERT_EQ(buffer.size(), 4u);
+    const uint8_t* bytes = static_cast<const uint8_t*>(buffer.content());
+    EXPECT_EQ(bytes[0], 0);
+    EXPECT_EQ(bytes[1], 1);
+    EXPECT_EQ(bytes[2], 128);
+    EXPECT_EQ(bytes[3], 255);
+  });
+  browser_->on_finish_navigation.Connect([&](nu::Browser* browser,
+                                             const std::string& url) {
+    browser->ExecuteJavaScript(
+        "window.method(new Uint8Array([9, 0, 1, 128, 255]).subarray(1))",
+        nullptr);
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<body><script></script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
+TEST_P(BrowserTest, AddAsyncBinding) {
+  browser_->AddAsyncBinding("method", [](nu::Browser*, base::Value args,
+                                         nu::BrowserReply* reply) {
+    ASSERT_EQ(args.GetList().size(), 1u);
+    scoped_refptr<nu::BrowserReply> ref(reply);
+    int value = args.GetList()[0].GetInt();
+    nu::MessageLoop::PostTask([ref, value]() {
+      ref->Resolve(base::Value(value * 2));
+    });
+  });
+  browser_->AddBinding("report", [](int result) {
+    nu::MessageLoop::Quit();
+    EXPECT_EQ(result, 42);
+  });
+  browser_->on_finish_navigation.Connect([&](nu::Browser* browser,
+                                             const std::string& url) {
+    browser->ExecuteJavaScript(
+        "window.method(21).then(function(r) { window.report(r) })",
+        nullptr);
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML("<body><script></script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
+TEST_P(BrowserTest, PushMessage) {
+  browser_->AddBinding("report", [](const std::string& messages) {
+    nu::MessageLoop::Quit();
+    EXPECT_EQ(messages, "1,two,3");
+  });
+  browser_->on_finish_navigation.Connect([&](nu::Browser* browser,
+                                             const std::string& url) {
+    browser->PushMessage(base::Value(1));
+    browser->PushMessage(base::Value("two"));
+    char bytes[] = {1, 2, 3};
+    browser->PushMessage(nu::Buffer::Wrap(bytes, sizeof(bytes)));
+  });
+  nu::MessageLoop::PostTask([&]() {
+    browser_->LoadHTML(
+        "<body><script>"
+        "var m = [];"
+        "window.addEventListener('yuemessage', function(e) {"
+        "  m.push(e.detail.byteLength || e.detail);"
+        "  if (m.length == 3) window.report(m.join());"
+        "});"
+        "</script></body>", "about:blank");
+  });
+  nu::MessageLoop::Run();
+}
+
 void DummyFunction(const std::string&) {
 }
 
@@ -396,6 +523,31 @@ TEST_P(BrowserTest, StringProtocol) {
   nu::MessageLoop::Run();
 }
 
+TEST_P(BrowserTest, CreateBufferURL) {
+#if defined(OS_WIN) && defined(WEBVIEW2_SUPPORT)
+  if (browser_->IsWebView2())
+    return;
+#endif
+  static const char kContent[] = "<html><body>buffer</body></html>";
+  std::string url = browser_->CreateBufferURL(
+      nu::Buffer::Wrap(kContent, sizeof(kContent) - 1), "text/html");
+  EXPECT_TRUE(base::StartsWith(url, "yue-buffer://",
+                               base::CompareCase::SENSITIVE));
+  browser_->on_finish_navigation.Connect([](nu::Browser* browser,
+                                            const std::string& url) {
+    browser->ExecuteJavaScript("document.body.textContent",
+                               [](bool success, base::Value result) {
+      nu::MessageLoop::Quit();
+      ASSERT_TRUE(result.is_string());
+      EXPECT_EQ(result.GetString(), "buffer");
+    });
+  });
+  nu::MessageLoop::PostTask([=]() {
+    browser_->LoadURL(url);
+  });
+  nu::MessageLoop::Run();
+}
+
 TEST_P(BrowserTest, FileProtocol) {
 #if defined(OS_WIN) && defined(WEBVIEW2_SUPPORT)
   if (browser_->IsWebView2())
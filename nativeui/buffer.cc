@@ -44,6 +44,12 @@ Buffer::~Buffer() {
     free_(content_);
 }
 
+Buffer::FreeFunc Buffer::Release() {
+  FreeFunc free = std::move(free_);
+  free_ = nullptr;
+  return free;
+}
+
 Buffer& Buffer::operator=(Buffer&& other) noexcept {
   if (free_)
     free_(content_);
@@ -26,6 +26,10 @@ namespace nu {
 // Note: Currently for language bindings we are assuming the buffer passed to
 // APIs are consumed immediately, so memory passed from language bindings are
 // NOT copied. Keep this in mind when designing new APIs.
+//
+// Buffers created with TakeOver own their memory, and can be moved to other
+// threads, or handed to language bindings without copying, for example the
+// Node binding turns them into Buffers that free the memory with |free|.
 class NATIVEUI_EXPORT Buffer {
  public:
   using FreeFunc = std::function<void(void*)>;
@@ -46,6 +50,13 @@ class NATIVEUI_EXPORT Buffer {
   void* content() const { return content_; }
   size_t size() const { return size_; }
 
+  // Whether the buffer owns its memory.
+  bool owns_content() const { return static_cast<bool>(free_); }
+
+  // Give up the ownership of memory and return the function to free it. The
+  // content is still accessible until the returned function is called.
+  FreeFunc Release();
+
 #if defined(OS_MACOSX)
   // Return an autoreleased NSData which does not manage the memory.
   NSData* ToNSData() const;
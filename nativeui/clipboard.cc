@@ -4,6 +4,7 @@
 
 #include "nativeui/clipboard.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/notreached.h"
@@ -109,6 +110,17 @@ Clipboard* Clipboard::FromType(Type type) {
   return State::GetCurrent()->GetClipboard(type);
 }
 
+// static
+bool Clipboard::ReadChunks(const char* data, size_t size,
+                           const DataReader& reader) {
+  for (size_t pos = 0; pos < size; pos += kDataChunkSize) {
+    size_t chunk = std::min(size - pos, static_cast<size_t>(kDataChunkSize));
+    if (!reader(data + pos, chunk))
+      return false;
+  }
+  return true;
+}
+
 Clipboard::Clipboard(Type type)
     : type_(type), clipboard_(PlatformCreate(type)), weak_factory_(this) {}
 
@@ -133,6 +145,23 @@ std::string Clipboard::GetText() const {
                                          : std::string();
 }
 
+bool Clipboard::IsDataAvailable(Data::Type type) const {
+  int64_t change_count = PlatformGetChangeCount();
+  if (change_count < 0)
+    return PlatformIsDataAvailable(type);
+  if (change_count != cached_change_count_) {
+    cached_change_count_ = change_count;
+    checked_types_ = available_types_ = 0;
+  }
+  unsigned bit = 1u << static_cast<int>(type);
+  if (!(checked_types_ & bit)) {
+    checked_types_ |= bit;
+    if (PlatformIsDataAvailable(type))
+      available_types_ |= bit;
+  }
+  return available_types_ & bit;
+}
+
 void Clipboard::StartWatching() {
   if (is_watching_)
     return;
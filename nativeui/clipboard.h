@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_CLIPBOARD_H_
 #define NATIVEUI_CLIPBOARD_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -20,6 +21,14 @@
 #endif
 #endif
 
+#if defined(OS_MACOSX)
+#ifdef __OBJC__
+@class NUClipboardDataOwner;
+#else
+class NUClipboardDataOwner;
+#endif
+#endif
+
 namespace nu {
 
 // Native clipboard, can only be obtained from App.
@@ -104,6 +113,15 @@ class NATIVEUI_EXPORT Clipboard {
     };
   };
 
+  // Create the data of a type when it is requested.
+  using DataProvider = std::function<Data(Data::Type)>;
+
+  // Receive a chunk of data, return false to stop reading.
+  using DataReader = std::function<bool(const char* chunk, size_t size)>;
+
+  // The maximum size of chunks passed to DataReader.
+  static const size_t kDataChunkSize = 64 * 1024;
+
 #if defined(OS_MACOSX)
   // Initializing from existing draggingPasteboard.
   explicit Clipboard(NativeClipboard clipboard);
@@ -117,6 +135,24 @@ class NATIVEUI_EXPORT Clipboard {
   Data GetData(Data::Type type) const;
   void SetData(std::vector<Data> objects);
 
+  // Return the size in bytes of the data of |type| kept by system, without
+  // reading or decoding it, -1 is returned if it is not available.
+  int64_t GetDataSize(Data::Type type) const;
+
+  // Read the undecoded data of |type| in chunks, text and HTML are read in
+  // UTF-8 and images in their encoded file formats. Return false if the data
+  // is not available or the |reader| stopped reading.
+  bool ReadData(Data::Type type, const DataReader& reader) const;
+
+  // Internal: Pass |size| bytes of |data| to |reader| in chunks.
+  static bool ReadChunks(const char* data, size_t size,
+                         const DataReader& reader);
+
+  // Announce data of |types| without creating them, the |provider| is called
+  // only when the data is requested by a paste.
+  void SetDataProvider(const std::vector<Data::Type>& types,
+                       const DataProvider& provider);
+
   void StartWatching();
   void StopWatching();
 
@@ -134,24 +170,42 @@ class NATIVEUI_EXPORT Clipboard {
 
   NativeClipboard PlatformCreate(Type type);
   void PlatformDestroy();
+  bool PlatformIsDataAvailable(Data::Type type) const;
+  // Return a number that changes whenever the content of clipboard changes,
+  // or -1 if the changes can not be noticed.
+  int64_t PlatformGetChangeCount() const;
   void PlatformStartWatching();
   void PlatformStopWatching();
 
 #if defined(OS_MACOSX)
   void OnTimer();
+  void RestartPolling();
 #endif
 
   Type type_;
   NativeClipboard clipboard_;
 
   bool is_watching_ = false;
+
+  // Results of IsDataAvailable cached for the change count, as bit sets of
+  // the data types.
+  mutable int64_t cached_change_count_ = -1;
+  mutable unsigned checked_types_ = 0;
+  mutable unsigned available_types_ = 0;
+
 #if defined(OS_MACOSX)
   // Timer-based clipboard watching.
   MessageLoop::TimerId timer_ = 0;
+  int polling_timeout_ = 0;
   int change_count_ = 0;
+  // Owner of the data set by SetDataProvider.
+  NUClipboardDataOwner* data_owner_ = nullptr;
 #elif defined(OS_LINUX)
   // Signal-based clipboard watching.
   ulong signal_ = 0;
+  // Counting the owner changes for caching.
+  mutable ulong owner_change_signal_ = 0;
+  int64_t owner_change_count_ = 0;
 #endif
 
   base::WeakPtrFactory<Clipboard> weak_factory_;
@@ -76,6 +76,16 @@ TEST_F(ClipboardTest, Text) {
   EXPECT_EQ(clipboard_->GetText(), "some text");
 }
 
+TEST_F(ClipboardTest, IsDataAvailable) {
+  EXPECT_FALSE(clipboard_->IsDataAvailable(Data::Type::Text));
+  clipboard_->SetText("some text");
+  EXPECT_TRUE(clipboard_->IsDataAvailable(Data::Type::Text));
+  EXPECT_TRUE(clipboard_->IsDataAvailable(Data::Type::Text));
+  EXPECT_FALSE(clipboard_->IsDataAvailable(Data::Type::Image));
+  clipboard_->Clear();
+  EXPECT_FALSE(clipboard_->IsDataAvailable(Data::Type::Text));
+}
+
 TEST_F(ClipboardTest, HTML) {
   std::string html = "<strong>text 文字</strong>";
   std::vector<Data> objects;
@@ -135,6 +145,52 @@ TEST_F(ClipboardTest, Multiple) {
   EXPECT_FALSE(clipboard_->IsDataAvailable(Data::Type::FilePaths));
 }
 
+TEST_F(ClipboardTest, ReadData) {
+  std::string html = "<strong>text 文字</strong>";
+  std::vector<Data> objects;
+  objects.emplace_back(Data::Type::Text, "some text");
+  objects.emplace_back(Data::Type::HTML, html);
+  clipboard_->SetData(std::move(objects));
+  EXPECT_GT(clipboard_->GetDataSize(Data::Type::Text), 0);
+  EXPECT_GT(clipboard_->GetDataSize(Data::Type::HTML), 0);
+  EXPECT_EQ(clipboard_->GetDataSize(Data::Type::FilePaths), -1);
+
+  std::string result;
+  auto reader = [&result](const char* chunk, size_t size) {
+    result.append(chunk, size);
+    return true;
+  };
+  EXPECT_TRUE(clipboard_->ReadData(Data::Type::Text, reader));
+  EXPECT_EQ(result, "some text");
+  result.clear();
+  EXPECT_TRUE(clipboard_->ReadData(Data::Type::HTML, reader));
+  EXPECT_NE(result.find(html), std::string::npos);
+  EXPECT_FALSE(clipboard_->ReadData(Data::Type::FilePaths, reader));
+  EXPECT_FALSE(clipboard_->ReadData(Data::Type::Text,
+                                    [](const char*, size_t) { return false; }));
+}
+
+TEST_F(ClipboardTest, DataProvider) {
+  int calls = 0;
+  clipboard_->SetDataProvider(
+      {Data::Type::Text, Data::Type::HTML},
+      [&calls](Data::Type type) {
+        ++calls;
+        if (type == Data::Type::Text)
+          return Data(Data::Type::Text, "lazy text");
+        return Data(Data::Type::HTML, "<b>lazy</b>");
+      });
+  EXPECT_EQ(calls, 0);
+  EXPECT_TRUE(clipboard_->IsDataAvailable(Data::Type::Text));
+  EXPECT_TRUE(clipboard_->IsDataAvailable(Data::Type::HTML));
+  EXPECT_FALSE(clipboard_->IsDataAvailable(Data::Type::FilePaths));
+
+  EXPECT_EQ(clipboard_->GetText(), "lazy text");
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(clipboard_->GetText(), "lazy text");
+  EXPECT_EQ(calls, 1);
+}
+
 TEST_F(ClipboardTest, NotAvailable) {
   Data data = clipboard_->GetData(Data::Type::Text);
   EXPECT_EQ(data.type(), Data::Type::None);
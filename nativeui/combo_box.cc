@@ -13,4 +13,10 @@ const char* ComboBox::GetClassName() const {
   return kClassName;
 }
 
+void ComboBox::NotifyTextChange() {
+  if (get_items_for_text)
+    SetItems(get_items_for_text(this, GetText()));
+  on_text_change.Emit(this);
+}
+
 }  // namespace nu
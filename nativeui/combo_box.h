@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_COMBO_BOX_H_
 #define NATIVEUI_COMBO_BOX_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -24,6 +25,7 @@ class NATIVEUI_EXPORT ComboBox : public Picker {
 
   // Picker:
   void AddItem(const std::string& text) override;
+  void SetItems(const std::vector<std::string>& items) override;
 #if defined(OS_MACOSX)
   // On macOS the ComboBox does not have any relationship with Picker, we have
   // to reimplement every method.
@@ -38,9 +40,19 @@ class NATIVEUI_EXPORT ComboBox : public Picker {
 #endif
   const char* GetClassName() const override;
 
+  // Internal: Called by platform implementations when user changes text.
+  void NotifyTextChange();
+
   // Events.
   Signal<void(ComboBox*)> on_text_change;
 
+  // Delegate methods.
+  // Return the items to list for current text, the items are replaced with
+  // the result whenever user changes text. Autocomplete lists can use it to
+  // only keep the matching entries instead of adding thousands of items.
+  std::function<std::vector<std::string>(ComboBox*, const std::string&)>
+      get_items_for_text;
+
  protected:
   ~ComboBox() override;
 };
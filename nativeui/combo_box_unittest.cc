@@ -59,3 +59,11 @@ TEST_F(ComboBoxTest, ChangeTextShouldNotEmitEvent) {
   combobox_->SetText("text");
   EXPECT_FALSE(emitted);
 }
+
+TEST_F(ComboBoxTest, SetItemsKeepText) {
+  combobox_->SetText("text");
+  combobox_->SetItems({"item", "item"});
+  EXPECT_EQ(combobox_->GetItems().size(), static_cast<size_t>(2));
+  EXPECT_EQ(combobox_->GetSelectedItemIndex(), -1);
+  EXPECT_EQ(combobox_->GetText(), "text");
+}
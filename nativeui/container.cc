@@ -7,10 +7,27 @@
 #include <algorithm>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
+#include "nativeui/layout_stats.h"
+#include "nativeui/layout_transaction.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/painter.h"
+#include "nativeui/paint_stats.h"
+#include "nativeui/render_thread.h"
+#include "nativeui/screen.h"
+#include "nativeui/state.h"
+#include "nativeui/trace_event.h"
+#include "nativeui/window.h"
+#include "nativeui/util/yoga_util.h"
 #include "third_party/yoga/Yoga.h"
 
+#if defined(OS_WIN)
+#include "nativeui/gfx/geometry/safe_integer_conversions.h"
+#include "nativeui/win/view_win.h"
+#endif
+
 namespace nu {
 
 namespace {
@@ -20,12 +37,93 @@ inline bool IsRootYGNode(Container* view) {
   return !YGNodeGetParent(view->node()) || !view->IsContainer();
 }
 
-// Get bounds from the CSS node.
-inline RectF GetYGNodeBounds(YGNodeRef node) {
-  return RectF(YGNodeLayoutGetLeft(node), YGNodeLayoutGetTop(node),
-               YGNodeLayoutGetWidth(node), YGNodeLayoutGetHeight(node));
+// Create the canvas that display list is rendered to.
+scoped_refptr<Canvas> CreateLayerCanvas(const SizeF& size, Window* window) {
+  if (!window)
+    return new Canvas(size);
+#if defined(OS_WIN)
+  // The Direct2D painter of shared canvas can only be used in main thread.
+  return new Canvas(
+      size, Screen::GetCurrent()->GetDisplayNearestWindow(window).scale_factor);
+#else
+  return new Canvas(size, window);
+#endif
 }
 
+// Frames of children computed by yoga, stored in separated arrays so they can
+// be converted to pixels in tight loops instead of one view at a time.
+class ChildFrames {
+ public:
+  explicit ChildFrames(int capacity) {
+    indices_.reserve(capacity);
+    has_new_layouts_.reserve(capacity);
+    x_.reserve(capacity);
+    y_.reserve(capacity);
+    width_.reserve(capacity);
+    height_.reserve(capacity);
+  }
+
+  void Add(int index, bool has_new_layout, YGNodeRef node) {
+    indices_.push_back(index);
+    has_new_layouts_.push_back(has_new_layout);
+    x_.push_back(YGNodeLayoutGetLeft(node));
+    y_.push_back(YGNodeLayoutGetTop(node));
+    width_.push_back(YGNodeLayoutGetWidth(node));
+    height_.push_back(YGNodeLayoutGetHeight(node));
+  }
+
+  size_t size() const { return indices_.size(); }
+  int index(size_t i) const { return indices_[i]; }
+  bool has_new_layout(size_t i) const { return has_new_layouts_[i]; }
+
+  RectF GetBounds(size_t i) const {
+    return RectF(x_[i], y_[i], width_[i], height_[i]);
+  }
+
+#if defined(OS_WIN)
+  // Scale all frames by |scale_factor|, the results are the same with
+  // ScaleRect before rounding.
+  void ScaleToPixels(float scale_factor) {
+    size_t count = size();
+    left_.resize(count);
+    top_.resize(count);
+    right_.resize(count);
+    bottom_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      left_[i] = x_[i] * scale_factor;
+      top_[i] = y_[i] * scale_factor;
+      right_[i] = left_[i] + width_[i] * scale_factor;
+      bottom_[i] = top_[i] + height_[i] * scale_factor;
+    }
+  }
+
+  // Same with ToNearestRect.
+  Rect GetPixelBounds(size_t i) const {
+    int left = ToRoundedInt(left_[i]);
+    int top = ToRoundedInt(top_[i]);
+    return Rect(left, top,
+                ToRoundedInt(right_[i]) - left,
+                ToRoundedInt(bottom_[i]) - top);
+  }
+#endif
+
+ private:
+  std::vector<int> indices_;
+  std::vector<uint8_t> has_new_layouts_;
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> width_;
+  std::vector<float> height_;
+#if defined(OS_WIN)
+  std::vector<float> left_;
+  std::vector<float> top_;
+  std::vector<float> right_;
+  std::vector<float> bottom_;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(ChildFrames);
+};
+
 }  // namespace
 
 // static
@@ -47,6 +145,7 @@ const char* Container::GetClassName() const {
 }
 
 void Container::Layout() {
+  NU_TRACE_EVENT("layout", "Container::Layout");
   // For child CSS node, tell parent to do the layout.
   if (!IsRootYGNode(this)) {
     dirty_ = true;
@@ -56,15 +155,30 @@ void Container::Layout() {
     // This usually happens after adding a child view, since the container does
     // not change its size.
     // TODO(zcbenz): Revisit the logic here, should have a cleaner way.
-    if (dirty_)
-      SetChildBoundsFromCSS();
+    if (dirty_ && !LayoutTransaction::DeferLayout(this) &&
+        !(GetWindow() && GetWindow()->IsWaitingForFirstShow()))
+      UpdateChildBounds(false);
     return;
   }
 
+  // Wait for the transaction to commit.
+  if (LayoutTransaction::DeferLayout(this))
+    return;
+
+  // The content view is not laid out before the window is shown, and is laid
+  // out once per frame during live resize.
+  if (!GetParent() && GetWindow() &&
+      (GetWindow()->DeferLayoutUntilShown() ||
+       GetWindow()->DeferLayoutForLiveResize()))
+    return;
+
   // So this is a root CSS node, calculate the layout and set bounds.
   SizeF size(GetBounds().size());
-  YGNodeCalculateLayout(node(), size.width(), size.height(), YGDirectionLTR);
-  SetChildBoundsFromCSS();
+  {
+    ScopedLayoutTimer timer;
+    YGNodeCalculateLayout(node(), size.width(), size.height(), YGDirectionLTR);
+  }
+  UpdateChildBounds(false);
 }
 
 bool Container::IsContainer() const {
@@ -76,23 +190,45 @@ void Container::OnSizeChanged() {
   if (IsRootYGNode(this))
     Layout();
   else
-    SetChildBoundsFromCSS();
+    UpdateChildBounds(false);
+}
+
+void Container::OnLiveResizeEnd() {
+  for (int i = 0; i < ChildCount(); ++i)
+    ChildAt(i)->OnLiveResizeEnd();
+}
+
+bool Container::ResetForReuse() {
+  // Subclasses have their own native implementations.
+  if (GetClassName() != kClassName || !ResetViewStates())
+    return false;
+  LayoutTransaction transaction;
+  while (ChildCount() > 0)
+    RemoveChildView(ChildAt(ChildCount() - 1));
+  on_draw.DisconnectAll();
+  display_list_ = nullptr;
+  threaded_rendering_ = false;
+  layer_ = nullptr;
+  return true;
 }
 
 SizeF Container::GetPreferredSize() const {
   float nan = std::numeric_limits<float>::quiet_NaN();
+  ScopedLayoutTimer timer;
   YGNodeCalculateLayout(node(), nan, nan, YGDirectionLTR);
   return SizeF(YGNodeLayoutGetWidth(node()), YGNodeLayoutGetHeight(node()));
 }
 
 float Container::GetPreferredHeightForWidth(float width) const {
   float nan = std::numeric_limits<float>::quiet_NaN();
+  ScopedLayoutTimer timer;
   YGNodeCalculateLayout(node(), width, nan, YGDirectionLTR);
   return YGNodeLayoutGetHeight(node());
 }
 
 float Container::GetPreferredWidthForHeight(float height) const {
   float nan = std::numeric_limits<float>::quiet_NaN();
+  ScopedLayoutTimer timer;
   YGNodeCalculateLayout(node(), nan, height, YGDirectionLTR);
   return YGNodeLayoutGetWidth(node());
 }
@@ -134,21 +270,122 @@ void Container::RemoveChildView(View* view) {
   YGNodeRemoveChild(node(), view->node());
 
   PlatformRemoveChildView(view);
+  scoped_refptr<View> child = std::move(*i);
   children_.erase(i);
 
   DCHECK_EQ(static_cast<int>(YGNodeGetChildCount(node())), ChildCount());
 
   Layout();
+
+  // Reuse the view if nothing else references it.
+  State::GetCurrent()->RecycleView(std::move(child));
+}
+
+void Container::SetDisplayList(scoped_refptr<DisplayList> list) {
+  display_list_ = std::move(list);
+  layer_ = nullptr;
+  SchedulePaint();
+}
+
+void Container::SetThreadedRendering(bool enabled) {
+  threaded_rendering_ = enabled;
+  if (!enabled)
+    layer_ = nullptr;
+  SchedulePaint();
 }
 
 void Container::SetChildBoundsFromCSS() {
+  UpdateChildBounds(true);
+}
+
+bool Container::HasCustomDraw() const {
+  return display_list_ || !on_draw.IsEmpty();
+}
+
+void Container::DrawCustomContent(Painter* painter, const RectF& dirty) {
+  if (display_list_) {
+    if (threaded_rendering_ && display_list_->IsSelfContained())
+      DrawLayer(painter);
+    else
+      display_list_->Replay(painter);
+  }
+  if (!on_draw.IsEmpty()) {
+    ScopedDrawHandlerTimer timer;
+    on_draw.Emit(this, painter, dirty);
+  }
+}
+
+void Container::DrawLayer(Painter* painter) {
+  SizeF size = GetBounds().size();
+  bool up_to_date = layer_ &&
+                    layer_version_ == display_list_->GetVersion() &&
+                    layer_->GetSize() == size;
+  if (!up_to_date && !layer_pending_) {
+    // Render a copy so the list can still be changed in main thread.
+    layer_pending_ = true;
+    scoped_refptr<DisplayList> list = display_list_;
+    int version = list->GetVersion();
+    scoped_refptr<Container> self(this);
+    RenderThread::Render(
+        list->Clone(), CreateLayerCanvas(size, GetWindow()),
+        [self, list, version](scoped_refptr<Canvas> canvas) {
+      self->layer_pending_ = false;
+      // Drop the result if the display list has been replaced.
+      if (!self->threaded_rendering_ || self->display_list_ != list)
+        return;
+      self->layer_ = std::move(canvas);
+      self->layer_version_ = version;
+      self->SchedulePaint();
+    });
+  }
+  // Draw the old layer until the new one is ready, the list is only replayed
+  // in main thread when there is nothing rendered yet.
+  if (layer_)
+    painter->DrawCanvas(layer_.get(), RectF(layer_->GetSize()));
+  else
+    display_list_->Replay(painter);
+}
+
+void Container::UpdateChildBounds(bool force) {
   dirty_ = false;
   if (!IsVisible())
     return;
+  State* state = State::GetCurrent();
+  if (state->IsLayoutStatsEnabled())
+    state->layout_stats()->nodes_visited += ChildCount();
+  ChildFrames frames(ChildCount());
   for (int i = 0; i < ChildCount(); ++i) {
     View* child = ChildAt(i);
-    if (child->IsVisible())
-      child->SetBounds(GetYGNodeBounds(child->node()));
+    if (!child->IsVisible())
+      continue;
+    // Yoga only sets the flag for nodes it has visited in the layout pass,
+    // untouched subtrees can be skipped.
+    YGNodeRef node = child->node();
+    bool has_new_layout = YGNodeGetHasNewLayout(node);
+    if (!force && !has_new_layout)
+      continue;
+    YGNodeSetHasNewLayout(node, false);
+    frames.Add(i, has_new_layout, node);
+  }
+#if defined(OS_WIN)
+  // Children share the scale factor of their parent.
+  frames.ScaleToPixels(GetNative()->scale_factor());
+#endif
+  for (size_t i = 0; i < frames.size(); ++i) {
+    View* child = ChildAt(frames.index(i));
+    // When the size of child container does not change, OnSizeChanged would
+    // not be called, but its children may still have new layouts.
+    bool check_size = frames.has_new_layout(i) && child->IsContainer();
+    SizeF old_size;
+    if (check_size)
+      old_size = child->GetBounds().size();
+#if defined(OS_WIN)
+    child->SetPixelBounds(frames.GetPixelBounds(i));
+#else
+    child->SetBounds(frames.GetBounds(i));
+#endif
+    if (check_size && old_size == frames.GetBounds(i).size())
+      static_cast<Container*>(child)->UpdateChildBounds(false);
   }
 }
 
@@ -7,10 +7,12 @@
 
 #include <vector>
 
+#include "nativeui/gfx/display_list.h"
 #include "nativeui/view.h"
 
 namespace nu {
 
+class Canvas;
 class Painter;
 
 class NATIVEUI_EXPORT Container : public View {
@@ -25,6 +27,8 @@ class NATIVEUI_EXPORT Container : public View {
   void Layout() override;
   bool IsContainer() const override;
   void OnSizeChanged() override;
+  void OnLiveResizeEnd() override;
+  bool ResetForReuse() override;
 
   // Gets preferred size of view.
   SizeF GetPreferredSize() const;
@@ -46,9 +50,33 @@ class NATIVEUI_EXPORT Container : public View {
     return children_[index].get();
   }
 
-  // Internal: Used by certain implementations to refresh layout.
+  // Set a display list that is replayed before emitting on_draw, so static
+  // contents do not have to be drawn by script code on every repaint.
+  void SetDisplayList(scoped_refptr<DisplayList> list);
+  DisplayList* GetDisplayList() const { return display_list_.get(); }
+
+  // Rasterize the display list in the render thread, and draw the result as
+  // a layer, so changing the list does not block the main thread.
+  void SetThreadedRendering(bool enabled);
+  bool IsThreadedRendering() const { return threaded_rendering_; }
+
+#if defined(OS_MACOSX)
+  // Emit hover events of children from the container, instead of installing
+  // a tracking area for each child.
+  void SetTrackChildrenHover(bool track);
+  bool IsTrackChildrenHover() const;
+#endif
+
+  // Internal: Used by certain implementations to refresh layout, the bounds
+  // of all children are updated.
   void SetChildBoundsFromCSS();
 
+  // Internal: Whether there is custom content to draw.
+  bool HasCustomDraw() const;
+
+  // Internal: Replay the display list and emit on_draw.
+  void DrawCustomContent(Painter* painter, const RectF& dirty);
+
   // Events.
   Signal<void(Container*, Painter*, const RectF&)> on_draw;
 
@@ -64,11 +92,33 @@ class NATIVEUI_EXPORT Container : public View {
   void PlatformRemoveChildView(View* view);
 
  private:
+  friend class LayoutTransaction;
+
+  // Set bounds of children from the CSS nodes, when |force| is false only the
+  // children that have new layouts are updated.
+  void UpdateChildBounds(bool force);
+
+  // Draw the layer rendered from display list, and start rendering when the
+  // layer is out of date.
+  void DrawLayer(Painter* painter);
+
   // Relationships.
   std::vector<scoped_refptr<View>> children_;
 
+  // Recorded drawing operations.
+  scoped_refptr<DisplayList> display_list_;
+
+  // The display list rendered in the render thread.
+  bool threaded_rendering_ = false;
+  bool layer_pending_ = false;
+  int layer_version_ = 0;
+  scoped_refptr<Canvas> layer_;
+
   // Whether the container should update children's layout.
   bool dirty_ = false;
+
+  // Whether the layout has been deferred by LayoutTransaction.
+  bool layout_deferred_ = false;
 };
 
 }  // namespace nu
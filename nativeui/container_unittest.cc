@@ -147,3 +147,164 @@ TEST_F(ContainerTest, MoveBetweenContainers) {
   EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 100));
   EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 100, 200, 100));
 }
+
+TEST_F(ContainerTest, LayoutTransaction) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  scoped_refptr<nu::Container> v1 = new nu::Container;
+  scoped_refptr<nu::Container> v2 = new nu::Container;
+  {
+    nu::LayoutTransaction transaction;
+    EXPECT_TRUE(nu::LayoutTransaction::IsActive());
+    v1->SetStyle("flex", 1);
+    v2->SetStyle("flex", 1);
+    container_->AddChildView(v1.get());
+    container_->AddChildView(v2.get());
+    EXPECT_EQ(v1->GetBounds(), nu::RectF());
+    EXPECT_EQ(v2->GetBounds(), nu::RectF());
+  }
+  EXPECT_FALSE(nu::LayoutTransaction::IsActive());
+  EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 200));
+  EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 200, 200, 200));
+}
+
+TEST_F(ContainerTest, NestedLayoutTransaction) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  scoped_refptr<nu::Container> v = new nu::Container;
+  v->SetStyle("flex", 1);
+  nu::LayoutTransaction::Begin();
+  nu::LayoutTransaction::Begin();
+  container_->AddChildView(v.get());
+  nu::LayoutTransaction::Commit();
+  EXPECT_EQ(v->GetBounds(), nu::RectF());
+  nu::LayoutTransaction::Commit();
+  EXPECT_EQ(v->GetBounds(), nu::RectF(0, 0, 200, 400));
+}
+
+TEST_F(ContainerTest, DeferredLayout) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  nu::LayoutTransaction::SetDeferredLayout(true);
+  scoped_refptr<nu::Container> v = new nu::Container;
+  v->SetStyle("flex", 1);
+  container_->AddChildView(v.get());
+  EXPECT_EQ(v->GetBounds(), nu::RectF());
+  nu::MessageLoop::PostTask([]() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(v->GetBounds(), nu::RectF(0, 0, 200, 400));
+  nu::LayoutTransaction::SetDeferredLayout(false);
+}
+
+TEST_F(ContainerTest, NewLayoutOfFixedSizeChild) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  nu::Container* c1 = new nu::Container;
+  c1->SetStyle("width", 100, "height", 100);
+  container_->AddChildView(c1);
+  nu::Container* c2 = new nu::Container;
+  c2->SetStyle("width", 100, "height", 100);
+  c1->AddChildView(c2);
+  EXPECT_EQ(c2->GetBounds(), nu::RectF(0, 0, 100, 100));
+  // The size of c1 does not change, but c2 gets a new layout.
+  scoped_refptr<nu::Container> v = new nu::Container;
+  v->SetStyle("flex", 1);
+  c2->AddChildView(v.get());
+  EXPECT_EQ(v->GetBounds(), nu::RectF(0, 0, 100, 100));
+  c2->SetStyle("margin-top", 10);
+  EXPECT_EQ(c2->GetBounds(), nu::RectF(0, 10, 100, 100));
+  EXPECT_EQ(v->GetBounds(), nu::RectF(0, 0, 100, 100));
+}
+
+TEST_F(ContainerTest, LayoutStats) {
+  state_.SetLayoutStatsEnabled(true);
+  window_->SetContentSize(nu::SizeF(200, 400));
+  container_->AddChildView(new nu::Label("label"));
+  const nu::LayoutStats& stats = state_.GetLayoutStats();
+  EXPECT_GT(stats.layout_count, 0);
+  EXPECT_GT(stats.nodes_visited, 0);
+  EXPECT_GE(stats.max_duration, base::TimeDelta());
+  ASSERT_EQ(stats.measures.count(nu::Label::kClassName), 1u);
+  EXPECT_GT(stats.measures.at(nu::Label::kClassName).count, 0);
+  state_.ResetLayoutStats();
+  EXPECT_EQ(stats.layout_count, 0);
+  EXPECT_TRUE(stats.measures.empty());
+}
+
+TEST_F(ContainerTest, PaintStats) {
+  state_.SetPaintStatsEnabled(true);
+  window_->SetTitle("paint");
+  bool drawn = false;
+  container_->on_draw.Connect([&](nu::Container*, nu::Painter*,
+                                  const nu::RectF&) { drawn = true; });
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 10), 1.f);
+  {
+    nu::ScopedPaintTimer timer(window_.get(), nu::Rect(0, 0, 10, 20));
+    nu::ScopedPaintTimer::CountView(container_.get());
+    container_->DrawCustomContent(canvas->GetPainter(),
+                                  nu::RectF(0, 0, 10, 10));
+  }
+  EXPECT_TRUE(drawn);
+  const nu::PaintStats& stats = state_.GetPaintStats();
+  EXPECT_EQ(stats.paint_count, 1);
+  ASSERT_EQ(stats.records.size(), 1u);
+  const nu::PaintStats::Record& record = stats.records[0];
+  EXPECT_EQ(record.window_title, "paint");
+  EXPECT_EQ(record.dirty_area, 200);
+  EXPECT_EQ(record.views_drawn, 1);
+  EXPECT_EQ(record.views.at(nu::Container::kClassName), 1);
+  EXPECT_EQ(record.on_draw_count, 1);
+  EXPECT_LE(record.on_draw_duration, record.duration);
+  std::string trace = stats.ToTraceJSON();
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"paint\""), std::string::npos);
+  state_.ResetPaintStats();
+  EXPECT_TRUE(stats.records.empty());
+}
+
+TEST_F(ContainerTest, RecycleViews) {
+  state_.SetViewRecycleLimit(1);
+  nu::Label* label = new nu::Label("text");
+  label->SetStyle("width", 50.f);
+  label->SetVisible(false);
+  label->on_mouse_down.Connect([](nu::View*, const nu::MouseEvent&) {
+    return true;
+  });
+  container_->AddChildView(label);
+  container_->RemoveChildView(label);
+  EXPECT_EQ(state_.GetMemoryReport().recycled_view_count, 1);
+
+  scoped_refptr<nu::View> view = state_.ReuseView(nu::Label::kClassName);
+  ASSERT_EQ(view.get(), label);
+  EXPECT_EQ(label->GetText(), "");
+  EXPECT_TRUE(label->IsVisible());
+  EXPECT_TRUE(label->on_mouse_down.IsEmpty());
+  EXPECT_FALSE(state_.ReuseView(nu::Label::kClassName));
+
+  // Views referenced elsewhere are not recycled.
+  container_->AddChildView(label);
+  container_->RemoveChildView(label);
+  EXPECT_EQ(state_.GetMemoryReport().recycled_view_count, 0);
+  state_.SetViewRecycleLimit(0);
+}
+
+TEST_F(ContainerTest, RecycleViewsWithDefaultProperties) {
+  state_.SetViewRecycleLimit(1);
+  nu::Container* child = new nu::Container;
+  child->SetCoalesceMouseMove(true);
+  child->SetLayerBacked(true);
+  container_->AddChildView(child);
+  container_->RemoveChildView(child);
+  scoped_refptr<nu::View> view = state_.ReuseView(nu::Container::kClassName);
+  ASSERT_EQ(view.get(), child);
+  EXPECT_FALSE(child->IsCoalesceMouseMove());
+  EXPECT_FALSE(child->IsLayerBacked());
+
+  // Views whose properties can not be restored are not recycled, so reused
+  // views never look like their previous owners.
+  child->SetBackgroundColor(nu::Color(255, 0, 0));
+  container_->AddChildView(child);
+  view = nullptr;
+  container_->RemoveChildView(child);
+  EXPECT_EQ(state_.GetMemoryReport().recycled_view_count, 0);
+  EXPECT_FALSE(state_.ReuseView(nu::Container::kClassName));
+  state_.SetViewRecycleLimit(0);
+}
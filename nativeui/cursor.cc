@@ -0,0 +1,16 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/cursor.h"
+
+#include "nativeui/state.h"
+
+namespace nu {
+
+// static
+Cursor* Cursor::CreateWithType(Type type) {
+  return State::GetCurrent()->GetCursor(type);
+}
+
+}  // namespace nu
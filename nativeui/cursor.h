@@ -31,6 +31,10 @@ class NATIVEUI_EXPORT Cursor : public base::RefCounted<Cursor> {
 
   explicit Cursor(Type type = Type::Default);
 
+  // Return the cursor of |type| shared by the whole app, which avoids
+  // creating a native cursor each time.
+  static Cursor* CreateWithType(Type type);
+
   NativeCursor GetNative() const { return cursor_; }
 
  private:
@@ -6,10 +6,20 @@
 
 namespace nu {
 
+FilePromise::FilePromise(const base::FilePath& file_name,
+                         const Writer& writer)
+    : file_name(file_name), writer(writer) {}
+
+FilePromise::FilePromise(const FilePromise& other) = default;
+
+FilePromise::~FilePromise() {}
+
 DragOptions::DragOptions() {}
 
 DragOptions::DragOptions(Image* image) : image(image) {}
 
+DragOptions::DragOptions(const DragOptions& other) = default;
+
 DragOptions::~DragOptions() {}
 
 DraggingInfo::DraggingInfo(int drag_operations)
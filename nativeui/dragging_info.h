@@ -5,6 +5,10 @@
 #ifndef NATIVEUI_DRAGGING_INFO_H_
 #define NATIVEUI_DRAGGING_INFO_H_
 
+#include <functional>
+#include <vector>
+
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "nativeui/clipboard.h"
@@ -19,13 +23,29 @@
 
 namespace nu {
 
+// A file that is only written after it is dropped.
+struct NATIVEUI_EXPORT FilePromise {
+  // Write the file to |path| and return whether it succeeded, it is called on
+  // a worker thread after dropping.
+  using Writer = std::function<bool(const base::FilePath& path)>;
+
+  FilePromise(const base::FilePath& file_name, const Writer& writer);
+  FilePromise(const FilePromise& other);
+  ~FilePromise();
+
+  base::FilePath file_name;  // name of the file without directory
+  Writer writer;
+};
+
 // The options for starting a drag session.
 struct NATIVEUI_EXPORT DragOptions {
   DragOptions();
   explicit DragOptions(Image* image);
+  DragOptions(const DragOptions& other);
   ~DragOptions();
 
   scoped_refptr<Image> image;
+  std::vector<FilePromise> file_promises;
 };
 
 // Getting information about dragged data in drag session.
@@ -38,6 +58,11 @@ class NATIVEUI_EXPORT DraggingInfo {
   virtual bool IsDataAvailable(Data::Type type) const = 0;
   virtual Data GetData(Data::Type type) const = 0;
 
+  // Streaming access to the undecoded data, see Clipboard::ReadData.
+  virtual int64_t GetDataSize(Data::Type type) const = 0;
+  virtual bool ReadData(Data::Type type,
+                        const Clipboard::DataReader& reader) const = 0;
+
   int GetDragOperations() const { return drag_operations_; }
 
   base::WeakPtr<DraggingInfo> GetWeakPtr() {
@@ -4,13 +4,86 @@
 
 #include "nativeui/entry.h"
 
+#include <algorithm>
+
 namespace nu {
 
 // static
 const char Entry::kClassName[] = "Entry";
 
+void Entry::SetTextChangeDebounce(int delay) {
+  debounce_ = std::max(0, delay);
+}
+
+void Entry::SetTextChangeThrottle(int interval) {
+  throttle_ = std::max(0, interval);
+}
+
+void Entry::SetIgnoreComposition(bool ignore) {
+  ignore_composition_ = ignore;
+}
+
+void Entry::NotifyTextChange() {
+  if (ignore_composition_ && IsComposing()) {
+    composition_changed_ = true;
+    return;
+  }
+  composition_changed_ = false;
+  ScheduleTextChange();
+}
+
+void Entry::NotifyCompositionEnd() {
+  if (!composition_changed_)
+    return;
+  composition_changed_ = false;
+  ScheduleTextChange();
+}
+
 const char* Entry::GetClassName() const {
   return kClassName;
 }
 
+void Entry::ScheduleTextChange() {
+  if (debounce_ == 0 && throttle_ == 0) {
+    on_text_change.Emit(this);
+    return;
+  }
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (pending_since_.is_null())
+    pending_since_ = now;
+  int delay;
+  if (debounce_ > 0) {
+    delay = debounce_;
+    if (throttle_ > 0) {
+      int waited = static_cast<int>((now - pending_since_).InMilliseconds());
+      delay = std::min(delay, std::max(0, throttle_ - waited));
+    }
+    if (text_change_timer_)
+      MessageLoop::ClearTimeout(text_change_timer_);
+  } else {
+    int elapsed = last_emit_.is_null() ?
+        throttle_ : static_cast<int>((now - last_emit_).InMilliseconds());
+    if (elapsed >= throttle_) {
+      FlushTextChange();
+      return;
+    }
+    // The trailing change would be emitted by the existing timer.
+    if (text_change_timer_)
+      return;
+    delay = throttle_ - elapsed;
+  }
+  // Keep a reference so the view is alive when the timer fires.
+  scoped_refptr<Entry> self(this);
+  text_change_timer_ = MessageLoop::SetTimeout(delay, [self]() {
+    self->text_change_timer_ = 0;
+    self->FlushTextChange();
+  });
+}
+
+void Entry::FlushTextChange() {
+  pending_since_ = base::TimeTicks();
+  last_emit_ = base::TimeTicks::Now();
+  on_text_change.Emit(this);
+}
+
 }  // namespace nu
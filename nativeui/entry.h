@@ -7,6 +7,8 @@
 
 #include <string>
 
+#include "base/time/time.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/view.h"
 
 namespace nu {
@@ -26,16 +28,60 @@ class NATIVEUI_EXPORT Entry : public View {
   void SetText(const std::string& text);
   std::string GetText() const;
 
+  // Emit on_text_change after user has stopped changing text for |delay|
+  // milliseconds, 0 means emitting for every change.
+  void SetTextChangeDebounce(int delay);
+  int GetTextChangeDebounce() const { return debounce_; }
+
+  // Emit on_text_change at most once every |interval| milliseconds. When
+  // used with debounce, the emitting is not delayed longer than |interval|.
+  void SetTextChangeThrottle(int interval);
+  int GetTextChangeThrottle() const { return throttle_; }
+
+  // Do not emit on_text_change for the intermediate text of IME composition,
+  // the change is emitted when the text is committed.
+  void SetIgnoreComposition(bool ignore);
+  bool IsIgnoringComposition() const { return ignore_composition_; }
+
+  // Return whether user is composing text with IME.
+  bool IsComposing() const;
+
+  // Internal: Called by platform implementations when user changes text, or
+  // finishes IME composition.
+  void NotifyTextChange();
+  void NotifyCompositionEnd();
+
   // View:
   const char* GetClassName() const override;
   SizeF GetMinimumSize() const override;
 
   // Events.
   Signal<void(Entry*)> on_text_change;
+  // Emitted after |removed| characters starting from |start| have been
+  // replaced with the |inserted| text by user. Unlike on_text_change, it is
+  // emitted for every change.
+  Signal<void(Entry*, int, int, const std::string&)> on_text_range_change;
   Signal<void(Entry*)> on_activate;
 
  protected:
   ~Entry() override;
+
+ private:
+  // Emit on_text_change now or later according to debounce and throttle.
+  void ScheduleTextChange();
+  void FlushTextChange();
+
+  int debounce_ = 0;
+  int throttle_ = 0;
+  bool ignore_composition_ = false;
+
+  // Whether a change was made during IME composition.
+  bool composition_changed_ = false;
+
+  MessageLoop::TimerId text_change_timer_ = 0;
+  // When the first change that has not been emitted was made.
+  base::TimeTicks pending_since_;
+  base::TimeTicks last_emit_;
 };
 
 }  // namespace nu
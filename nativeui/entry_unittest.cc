@@ -0,0 +1,48 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class EntryTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    entry_ = new nu::Entry;
+    entry_->on_text_change.Connect([this](nu::Entry*) { ++change_count_; });
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Entry> entry_;
+  int change_count_ = 0;
+};
+
+TEST_F(EntryTest, EmitForEveryChange) {
+  entry_->NotifyTextChange();
+  entry_->NotifyTextChange();
+  EXPECT_EQ(change_count_, 2);
+}
+
+TEST_F(EntryTest, Debounce) {
+  entry_->SetTextChangeDebounce(10);
+  entry_->NotifyTextChange();
+  entry_->NotifyTextChange();
+  entry_->NotifyTextChange();
+  EXPECT_EQ(change_count_, 0);
+  nu::MessageLoop::SetTimeout(50, []() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(change_count_, 1);
+}
+
+TEST_F(EntryTest, Throttle) {
+  entry_->SetTextChangeThrottle(10);
+  entry_->NotifyTextChange();
+  EXPECT_EQ(change_count_, 1);
+  entry_->NotifyTextChange();
+  entry_->NotifyTextChange();
+  EXPECT_EQ(change_count_, 1);
+  nu::MessageLoop::SetTimeout(50, []() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(change_count_, 2);
+}
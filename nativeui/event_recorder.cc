@@ -0,0 +1,376 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/event_recorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/values.h"
+#include "nativeui/container.h"
+#include "nativeui/group.h"
+#include "nativeui/scroll.h"
+#include "nativeui/tab.h"
+#include "nativeui/trace_event.h"
+#include "nativeui/window.h"
+
+namespace nu {
+
+namespace {
+
+// Number of recorders that are recording.
+std::atomic<int> g_recording_count{0};
+
+// Categories of the trace recorded during replay.
+const char kReplayTraceCategories[] = "layout,paint";
+
+const struct {
+  EventType type;
+  const char* name;
+} kRecordTypes[] = {
+  { EventType::MouseDown, "mousedown" },
+  { EventType::MouseUp, "mouseup" },
+  { EventType::MouseMove, "mousemove" },
+  { EventType::MouseEnter, "mouseenter" },
+  { EventType::MouseLeave, "mouseleave" },
+  { EventType::KeyDown, "keydown" },
+  { EventType::KeyUp, "keyup" },
+  { EventType::Unknown, "resize" },
+};
+
+const char* RecordTypeToString(EventType type) {
+  for (const auto& it : kRecordTypes) {
+    if (it.type == type)
+      return it.name;
+  }
+  return nullptr;
+}
+
+bool RecordTypeFromString(const std::string& name, EventType* type) {
+  for (const auto& it : kRecordTypes) {
+    if (name == it.name) {
+      *type = it.type;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Return the index of |child| in |parent|, or -1 if it can not be found.
+int GetIndexInParent(View* parent, View* child) {
+  if (parent->IsContainer()) {
+    Container* container = static_cast<Container*>(parent);
+    for (int i = 0; i < container->ChildCount(); ++i) {
+      if (container->ChildAt(i) == child)
+        return i;
+    }
+  } else if (parent->GetClassName() == Tab::kClassName) {
+    Tab* tab = static_cast<Tab*>(parent);
+    for (int i = 0; i < tab->PageCount(); ++i) {
+      if (tab->PageAt(i) == child)
+        return i;
+    }
+  } else if (parent->GetClassName() == Scroll::kClassName) {
+    if (static_cast<Scroll*>(parent)->GetContentView() == child)
+      return 0;
+  } else if (parent->GetClassName() == Group::kClassName) {
+    if (static_cast<Group*>(parent)->GetContentView() == child)
+      return 0;
+  }
+  return -1;
+}
+
+// Reverse of GetIndexInParent.
+View* GetChildAtIndex(View* parent, int index) {
+  if (parent->IsContainer())
+    return static_cast<Container*>(parent)->ChildAt(index);
+  if (parent->GetClassName() == Tab::kClassName)
+    return static_cast<Tab*>(parent)->PageAt(index);
+  if (index != 0)
+    return nullptr;
+  if (parent->GetClassName() == Scroll::kClassName)
+    return static_cast<Scroll*>(parent)->GetContentView();
+  if (parent->GetClassName() == Group::kClassName)
+    return static_cast<Group*>(parent)->GetContentView();
+  return nullptr;
+}
+
+// Compute the path from the content view of |window| to |view|.
+bool GetViewPath(Window* window, View* view, std::vector<int>* path) {
+  path->clear();
+  while (view->GetParent()) {
+    int index = GetIndexInParent(view->GetParent(), view);
+    if (index < 0)
+      return false;
+    path->push_back(index);
+    view = view->GetParent();
+  }
+  if (view != window->GetContentView())
+    return false;
+  std::reverse(path->begin(), path->end());
+  return true;
+}
+
+View* GetViewFromPath(Window* window, const std::vector<int>& path) {
+  View* view = window->GetContentView();
+  for (int index : path) {
+    if (!view)
+      break;
+    view = GetChildAtIndex(view, index);
+  }
+  return view;
+}
+
+// Read a number from |dict|, returns 0 if it does not exist.
+double GetNumberKey(const base::Value& dict, const char* key) {
+  const base::Value* value = dict.FindKey(key);
+  if (!value || !(value->is_int() || value->is_double()))
+    return 0;
+  return value->GetDouble();
+}
+
+float GetFloatKey(const base::Value& dict, const char* key) {
+  return static_cast<float>(GetNumberKey(dict, key));
+}
+
+}  // namespace
+
+EventRecorder::Record::Record() {}
+
+EventRecorder::Record::Record(const Record& other) = default;
+
+EventRecorder::Record::~Record() {}
+
+EventRecorder::EventRecorder(Window* window) : window_(window) {}
+
+EventRecorder::~EventRecorder() {
+  StopRecording();
+  CancelReplay();
+}
+
+// static
+bool EventRecorder::IsAnyRecording() {
+  return g_recording_count.load(std::memory_order_relaxed) > 0;
+}
+
+void EventRecorder::StartRecording() {
+  if (recording_ || IsReplaying())
+    return;
+  if (window_->event_recorder()) {
+    LOG(ERROR) << "The window is already being recorded.";
+    return;
+  }
+  recording_ = true;
+  recording_start_ = base::TimeTicks::Now();
+  records_.clear();
+  window_->set_event_recorder(this);
+  ++g_recording_count;
+}
+
+void EventRecorder::StopRecording() {
+  if (!recording_)
+    return;
+  recording_ = false;
+  window_->set_event_recorder(nullptr);
+  --g_recording_count;
+}
+
+void EventRecorder::Replay(ReplayCallback callback) {
+  if (recording_ || IsReplaying())
+    return;
+  replay_callback_ = std::move(callback);
+  replay_index_ = 0;
+  replay_start_ = base::TimeTicks::Now();
+  TraceLog::GetInstance()->Clear();
+  TraceLog::GetInstance()->Start(kReplayTraceCategories);
+  ScheduleNextEvent();
+}
+
+void EventRecorder::CancelReplay() {
+  if (!IsReplaying())
+    return;
+  MessageLoop::ClearTimeout(replay_timer_);
+  replay_timer_ = 0;
+  replay_callback_ = nullptr;
+  TraceLog::GetInstance()->Stop();
+}
+
+std::string EventRecorder::ToJSON() const {
+  base::Value::ListStorage events;
+  events.reserve(records_.size());
+  for (const Record& record : records_) {
+    base::Value event(base::Value::Type::DICTIONARY);
+    event.SetKey("time", base::Value(record.time.InMillisecondsF()));
+    event.SetKey("type", base::Value(RecordTypeToString(record.type)));
+    if (record.type == EventType::Unknown) {
+      event.SetKey("width", base::Value(record.size.width()));
+      event.SetKey("height", base::Value(record.size.height()));
+      events.push_back(std::move(event));
+      continue;
+    }
+    base::Value::ListStorage path;
+    for (int index : record.path)
+      path.emplace_back(index);
+    event.SetKey("view", base::Value(std::move(path)));
+    event.SetKey("modifiers", base::Value(record.modifiers));
+    event.SetKey("timestamp", base::Value(static_cast<double>(
+        record.timestamp)));
+    if (record.type == EventType::KeyDown || record.type == EventType::KeyUp) {
+      event.SetKey("key", base::Value(static_cast<int>(record.key)));
+    } else {
+      event.SetKey("button", base::Value(record.button));
+      event.SetKey("x", base::Value(record.position_in_view.x()));
+      event.SetKey("y", base::Value(record.position_in_view.y()));
+      event.SetKey("windowX", base::Value(record.position_in_window.x()));
+      event.SetKey("windowY", base::Value(record.position_in_window.y()));
+    }
+    events.push_back(std::move(event));
+  }
+  base::Value root(base::Value::Type::DICTIONARY);
+  root.SetKey("events", base::Value(std::move(events)));
+  std::string json;
+  base::JSONWriter::Write(root, &json);
+  return json;
+}
+
+bool EventRecorder::LoadJSON(const std::string& json) {
+  if (recording_ || IsReplaying())
+    return false;
+  base::Optional<base::Value> root = base::JSONReader::Read(json);
+  if (!root || !root->is_dict())
+    return false;
+  const base::Value* events =
+      root->FindKeyOfType("events", base::Value::Type::LIST);
+  if (!events)
+    return false;
+  std::vector<Record> records;
+  for (const base::Value& event : events->GetList()) {
+    if (!event.is_dict())
+      return false;
+    Record record;
+    const base::Value* type =
+        event.FindKeyOfType("type", base::Value::Type::STRING);
+    if (!type || !RecordTypeFromString(type->GetString(), &record.type))
+      return false;
+    record.time =
+        base::TimeDelta::FromMillisecondsD(GetNumberKey(event, "time"));
+    if (record.type == EventType::Unknown) {
+      record.size.SetSize(GetFloatKey(event, "width"),
+                          GetFloatKey(event, "height"));
+      records.push_back(std::move(record));
+      continue;
+    }
+    const base::Value* path =
+        event.FindKeyOfType("view", base::Value::Type::LIST);
+    if (!path)
+      return false;
+    for (const base::Value& index : path->GetList()) {
+      if (!index.is_int())
+        return false;
+      record.path.push_back(index.GetInt());
+    }
+    record.modifiers = static_cast<int>(GetNumberKey(event, "modifiers"));
+    record.timestamp = static_cast<uint32_t>(GetNumberKey(event, "timestamp"));
+    record.key = static_cast<KeyboardCode>(GetNumberKey(event, "key"));
+    record.button = static_cast<int>(GetNumberKey(event, "button"));
+    record.position_in_view.SetPoint(GetFloatKey(event, "x"),
+                                     GetFloatKey(event, "y"));
+    record.position_in_window.SetPoint(GetFloatKey(event, "windowX"),
+                                       GetFloatKey(event, "windowY"));
+    records.push_back(std::move(record));
+  }
+  records_ = std::move(records);
+  return true;
+}
+
+void EventRecorder::RecordMouseEvent(View* view, const MouseEvent& event) {
+  Record* record = AddRecord(view, event);
+  if (!record)
+    return;
+  record->button = event.button;
+  record->position_in_view = event.position_in_view;
+  record->position_in_window = event.position_in_window;
+}
+
+void EventRecorder::RecordKeyEvent(View* view, const KeyEvent& event) {
+  Record* record = AddRecord(view, event);
+  if (record)
+    record->key = event.key;
+}
+
+void EventRecorder::RecordResize(const SizeF& size) {
+  if (!recording_)
+    return;
+  Record record;
+  record.time = base::TimeTicks::Now() - recording_start_;
+  record.size = size;
+  records_.push_back(std::move(record));
+}
+
+EventRecorder::Record* EventRecorder::AddRecord(View* view,
+                                                const Event& event) {
+  if (!recording_ || event.type == EventType::Unknown)
+    return nullptr;
+  Record record;
+  if (!GetViewPath(window_.get(), view, &record.path))
+    return nullptr;
+  record.time = base::TimeTicks::Now() - recording_start_;
+  record.type = event.type;
+  record.modifiers = event.modifiers;
+  record.timestamp = event.timestamp;
+  records_.push_back(std::move(record));
+  return &records_.back();
+}
+
+void EventRecorder::ScheduleNextEvent() {
+  if (replay_index_ >= records_.size()) {
+    // Replay finished.
+    replay_timer_ = 0;
+    TraceLog::GetInstance()->Stop();
+    ReplayCallback callback = std::move(replay_callback_);
+    replay_callback_ = nullptr;
+    if (callback)
+      callback(TraceLog::GetInstance()->ToTraceJSON());
+    return;
+  }
+  base::TimeDelta delay = records_[replay_index_].time -
+                          (base::TimeTicks::Now() - replay_start_);
+  // The timer is not throttled so the timing matches the recording.
+  replay_timer_ = MessageLoop::SetTimeoutFrom(
+      "EventRecorder::Replay",
+      std::max(0, static_cast<int>(delay.InMilliseconds())),
+      [this]() {
+        DispatchRecord(records_[replay_index_++]);
+        // The replay may be cancelled by the handlers of events.
+        if (replay_timer_)
+          ScheduleNextEvent();
+      },
+      false);
+}
+
+void EventRecorder::DispatchRecord(const Record& record) {
+  if (record.type == EventType::Unknown) {
+    window_->SetContentSize(record.size);
+    return;
+  }
+  // The views may have changed since recording, skip the events whose views
+  // can not be found.
+  View* view = GetViewFromPath(window_.get(), record.path);
+  if (!view)
+    return;
+  if (record.type == EventType::KeyDown || record.type == EventType::KeyUp) {
+    view->EmitKeyEvent(KeyEvent(record.type, record.modifiers,
+                                record.timestamp, record.key));
+  } else {
+    view->EmitMouseEvent(MouseEvent(record.type, record.modifiers,
+                                    record.timestamp, record.button,
+                                    record.position_in_view,
+                                    record.position_in_window));
+  }
+}
+
+}  // namespace nu
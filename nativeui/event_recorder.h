@@ -0,0 +1,107 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_EVENT_RECORDER_H_
+#define NATIVEUI_EVENT_RECORDER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "nativeui/events/event.h"
+#include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+class View;
+class Window;
+
+// Records the mouse, key and resize events dispatched to the views of a
+// window, and replays them later with the same timing.
+//
+// Views are identified by their positions in the view hierarchy of window,
+// so the recorded events can be replayed against the same app build that
+// creates the same views. Only the signals of views are emitted when
+// replaying, the native widgets do not receive the events.
+class NATIVEUI_EXPORT EventRecorder {
+ public:
+  explicit EventRecorder(Window* window);
+  ~EventRecorder();
+
+  void StartRecording();
+  void StopRecording();
+  bool IsRecording() const { return recording_; }
+
+  // Replay the recorded events, the layouts and paints are recorded by the
+  // TraceLog during the replay, and the trace is passed to |callback| when
+  // all events are replayed.
+  using ReplayCallback = std::function<void(const std::string& trace)>;
+  void Replay(ReplayCallback callback);
+  void CancelReplay();
+  bool IsReplaying() const { return replay_timer_ != 0; }
+
+  // Serialize the recorded events to JSON, and load them back.
+  std::string ToJSON() const;
+  bool LoadJSON(const std::string& json);
+
+  size_t GetEventCount() const { return records_.size(); }
+  Window* GetWindow() const { return window_.get(); }
+
+  // Internal: Return whether there is any window being recorded, to avoid
+  // looking for the recorder when dispatching events.
+  static bool IsAnyRecording();
+
+  // Internal: Record the events dispatched to |view|.
+  void RecordMouseEvent(View* view, const MouseEvent& event);
+  void RecordKeyEvent(View* view, const KeyEvent& event);
+  void RecordResize(const SizeF& size);
+
+ private:
+  // The |type| is EventType::Unknown for resizes.
+  struct Record {
+    Record();
+    Record(const Record& other);
+    ~Record();
+
+    base::TimeDelta time;
+    EventType type = EventType::Unknown;
+    // The indices of the view in its ancestors, starting from content view.
+    std::vector<int> path;
+    int modifiers = 0;
+    uint32_t timestamp = 0;
+    int button = 0;
+    PointF position_in_view;
+    PointF position_in_window;
+    KeyboardCode key = VKEY_UNKNOWN;
+    SizeF size;
+  };
+
+  // Append a record for |view|, returns nullptr if the view is not in the
+  // window.
+  Record* AddRecord(View* view, const Event& event);
+
+  void ScheduleNextEvent();
+  void DispatchRecord(const Record& record);
+
+  scoped_refptr<Window> window_;
+  std::vector<Record> records_;
+
+  bool recording_ = false;
+  base::TimeTicks recording_start_;
+
+  size_t replay_index_ = 0;
+  base::TimeTicks replay_start_;
+  MessageLoop::TimerId replay_timer_ = 0;
+  ReplayCallback replay_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventRecorder);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_EVENT_RECORDER_H_
@@ -0,0 +1,96 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class EventRecorderTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentView(new nu::Container);
+    child_ = new nu::Container;
+    static_cast<nu::Container*>(window_->GetContentView())->AddChildView(
+        new nu::Container);
+    static_cast<nu::Container*>(window_->GetContentView())->AddChildView(
+        child_.get());
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Container> child_;
+};
+
+TEST_F(EventRecorderTest, RecordAndReplay) {
+  nu::EventRecorder recorder(window_.get());
+  recorder.StartRecording();
+  child_->EmitMouseEvent(nu::MouseEvent(nu::EventType::MouseDown, 0, 1, 1,
+                                        nu::PointF(10, 20),
+                                        nu::PointF(30, 40)));
+  child_->EmitKeyEvent(nu::KeyEvent(nu::EventType::KeyUp, 0, 2,
+                                    nu::VKEY_A));
+  recorder.StopRecording();
+  // Events after stopping are not recorded.
+  child_->EmitKeyEvent(nu::KeyEvent(nu::EventType::KeyDown, 0, 3,
+                                    nu::VKEY_B));
+  ASSERT_EQ(recorder.GetEventCount(), 2u);
+
+  // Replay in a fresh recorder loaded from JSON.
+  nu::EventRecorder replayer(window_.get());
+  ASSERT_TRUE(replayer.LoadJSON(recorder.ToJSON()));
+  ASSERT_EQ(replayer.GetEventCount(), 2u);
+  nu::PointF position;
+  nu::KeyboardCode key = nu::VKEY_UNKNOWN;
+  child_->on_mouse_down.Connect([&](nu::View*, const nu::MouseEvent& event) {
+    position = event.position_in_view;
+    return true;
+  });
+  child_->on_key_up.Connect([&](nu::View*, const nu::KeyEvent& event) {
+    key = event.key;
+    return true;
+  });
+  std::string trace;
+  replayer.Replay([&](const std::string& result) {
+    trace = result;
+    nu::MessageLoop::Quit();
+  });
+  EXPECT_TRUE(replayer.IsReplaying());
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(replayer.IsReplaying());
+  EXPECT_EQ(position, nu::PointF(10, 20));
+  EXPECT_EQ(key, nu::VKEY_A);
+  EXPECT_FALSE(trace.empty());
+}
+
+TEST_F(EventRecorderTest, SkipMissingViews) {
+  nu::EventRecorder recorder(window_.get());
+  recorder.StartRecording();
+  child_->EmitMouseEvent(nu::MouseEvent(nu::EventType::MouseUp, 0, 1, 1,
+                                        nu::PointF(), nu::PointF()));
+  // Views not in the window are not recorded.
+  scoped_refptr<nu::Container> orphan = new nu::Container;
+  orphan->EmitMouseEvent(nu::MouseEvent(nu::EventType::MouseUp, 0, 1, 1,
+                                        nu::PointF(), nu::PointF()));
+  recorder.StopRecording();
+  ASSERT_EQ(recorder.GetEventCount(), 1u);
+
+  static_cast<nu::Container*>(window_->GetContentView())->RemoveChildView(
+      child_.get());
+  bool emitted = false;
+  child_->on_mouse_up.Connect([&](nu::View*, const nu::MouseEvent&) {
+    emitted = true;
+    return false;
+  });
+  recorder.Replay([](const std::string&) { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(emitted);
+}
+
+TEST_F(EventRecorderTest, InvalidJSON) {
+  nu::EventRecorder recorder(window_.get());
+  EXPECT_FALSE(recorder.LoadJSON("{"));
+  EXPECT_FALSE(recorder.LoadJSON("{\"events\":[{\"type\":\"unknown\"}]}"));
+  EXPECT_TRUE(recorder.LoadJSON("{\"events\":[]}"));
+}
@@ -0,0 +1,32 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/events/event.h"
+
+namespace nu {
+
+Event::Event(EventType type, int modifiers, uint32_t timestamp)
+    : type(type),
+      modifiers(modifiers),
+      timestamp(timestamp),
+      native_event(nullptr) {}
+
+MouseEvent::MouseEvent(EventType type,
+                       int modifiers,
+                       uint32_t timestamp,
+                       int button,
+                       const PointF& position_in_view,
+                       const PointF& position_in_window)
+    : Event(type, modifiers, timestamp),
+      button(button),
+      position_in_view(position_in_view),
+      position_in_window(position_in_window) {}
+
+KeyEvent::KeyEvent(EventType type,
+                   int modifiers,
+                   uint32_t timestamp,
+                   KeyboardCode key)
+    : Event(type, modifiers, timestamp), key(key) {}
+
+}  // namespace nu
@@ -5,6 +5,8 @@
 #ifndef NATIVEUI_EVENTS_EVENT_H_
 #define NATIVEUI_EVENTS_EVENT_H_
 
+#include <vector>
+
 #include "nativeui/events/keyboard_codes.h"
 #include "nativeui/gfx/geometry/point_f.h"
 #include "nativeui/types.h"
@@ -46,22 +48,37 @@ struct NATIVEUI_EXPORT Event {
  protected:
   // Base Event class should nenver be created by user.
   Event(NativeEvent event, NativeView view);
+  // Create a synthetic event without the native event.
+  Event(EventType type, int modifiers, uint32_t timestamp);
 };
 
 // Mouse click events.
 struct NATIVEUI_EXPORT MouseEvent : public Event {
   // Create from the native event.
   MouseEvent(NativeEvent event, NativeView view);
+  // Create a synthetic event, used for replaying recorded events.
+  MouseEvent(EventType type,
+             int modifiers,
+             uint32_t timestamp,
+             int button,
+             const PointF& position_in_view,
+             const PointF& position_in_window);
 
   int button;
   PointF position_in_view;
   PointF position_in_window;
+
+  // When mouse move events are coalesced, the positions in view of the merged
+  // events, not including |position_in_view|.
+  std::vector<PointF> coalesced_positions;
 };
 
 // Key events.
 struct NATIVEUI_EXPORT KeyEvent: public Event {
   // Create from the native event.
   KeyEvent(NativeEvent event, NativeView view);
+  // Create a synthetic event, used for replaying recorded events.
+  KeyEvent(EventType type, int modifiers, uint32_t timestamp, KeyboardCode key);
 
   KeyboardCode key;
 };
@@ -0,0 +1,36 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/file_dialog.h"
+
+#include "base/logging.h"
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+void FileDialog::Show() {
+  ShowForWindow(nullptr);
+}
+
+void FileDialog::ShowForWindow(Window* window) {
+  if (is_showing_) {
+    LOG(ERROR) << "FileDialog is already showing";
+    return;
+  }
+  is_showing_ = true;
+  AddRef();
+  PlatformShowForWindow(window);
+}
+
+void FileDialog::OnClose(bool accepted) {
+  // Emit the event after the native dialog has finished its own handling, so
+  // the dialog can be shown again in the handler.
+  MessageLoop::PostTask([this, accepted]() {
+    is_showing_ = false;
+    on_response.Emit(this, accepted);
+    Release();
+  });
+}
+
+}  // namespace nu
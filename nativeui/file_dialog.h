@@ -12,6 +12,7 @@
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "nativeui/nativeui_export.h"
+#include "nativeui/signal.h"
 #include "nativeui/types.h"
 
 namespace nu {
@@ -33,6 +34,8 @@ class NATIVEUI_EXPORT FileDialog : public base::RefCounted<FileDialog> {
   base::FilePath GetResult() const;
   bool Run();
   bool RunForWindow(Window* window);
+  void Show();
+  void ShowForWindow(Window* window);
   void SetTitle(const std::string& title);
   void SetButtonLabel(const std::string& label);
   void SetFilename(const std::string& filename);
@@ -43,6 +46,12 @@ class NATIVEUI_EXPORT FileDialog : public base::RefCounted<FileDialog> {
 
   NativeFileDialog GetNative() const { return dialog_; }
 
+  // Events.
+  Signal<void(FileDialog*, bool accepted)> on_response;
+
+  // Private: Called by native implementations when the dialog is closed.
+  void OnClose(bool accepted);
+
  protected:
   explicit FileDialog(NativeFileDialog dialog);
   virtual ~FileDialog();
@@ -55,6 +64,9 @@ class NATIVEUI_EXPORT FileDialog : public base::RefCounted<FileDialog> {
  private:
   friend class base::RefCounted<FileDialog>;
 
+  void PlatformShowForWindow(Window* window);
+
+  bool is_showing_ = false;
   std::vector<Filter> filters_;
   NativeFileDialog dialog_;
 
@@ -8,6 +8,7 @@
 
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/util/yoga_util.h"
 
 namespace nu {
 
@@ -26,6 +27,8 @@ AttributedText::AttributedText(const std::string& text, TextFormat format)
 
 void AttributedText::SetFormat(TextFormat format) {
   format_ = std::move(format);
+  ++generation_;
+  ++revision_;
   PlatformUpdateFormat();
 }
 
@@ -36,6 +39,8 @@ void AttributedText::SetFont(scoped_refptr<Font> font) {
 void AttributedText::SetFontFor(scoped_refptr<Font> font, int start, int end) {
   if (RangeInvalid(start, end))
     return;
+  ++generation_;
+  ++revision_;
   PlatformSetFontFor(std::move(font), start, end);
 }
 
@@ -46,6 +51,7 @@ void AttributedText::SetColor(Color color) {
 void AttributedText::SetColorFor(Color color, int start, int end) {
   if (RangeInvalid(start, end))
     return;
+  ++revision_;
   PlatformSetColorFor(color, start, end);
 }
 
@@ -55,6 +61,33 @@ void AttributedText::Clear() {
   SetColor(attrs.color);
 }
 
+void AttributedText::ReplaceText(int start, int end, const std::string& text) {
+  if (start < 0 || (end >= 0 && end < start))
+    return;
+  ++generation_;
+  ++revision_;
+  PlatformReplaceText(start, end, text);
+}
+
+void AttributedText::AppendText(const std::string& text) {
+  if (text.empty())
+    return;
+  ++generation_;
+  ++revision_;
+  PlatformAppendText(text);
+}
+
+RectF AttributedText::GetBoundsFor(const SizeF& size) const {
+  if (bounds_generation_ == generation_ &&
+      IsSameDimension(bounds_constraint_.width(), size.width()) &&
+      IsSameDimension(bounds_constraint_.height(), size.height()))
+    return bounds_;
+  bounds_ = PlatformGetBoundsFor(size);
+  bounds_constraint_ = size;
+  bounds_generation_ = generation_;
+  return bounds_;
+}
+
 SizeF AttributedText::GetOneLineSize() const {
   return GetBoundsFor(SizeF(FLT_MAX, FLT_MAX)).size();
 }
@@ -9,14 +9,14 @@
 
 #include "base/memory/ref_counted.h"
 #include "nativeui/gfx/color.h"
+#include "nativeui/gfx/geometry/rect_f.h"
 #include "nativeui/gfx/text.h"
+#include "nativeui/memory_report.h"
 #include "nativeui/types.h"
 
 namespace nu {
 
 class Font;
-class RectF;
-class SizeF;
 
 class NATIVEUI_EXPORT AttributedText : public base::RefCounted<AttributedText> {
  public:
@@ -35,6 +35,12 @@ class NATIVEUI_EXPORT AttributedText : public base::RefCounted<AttributedText> {
   void SetColorFor(Color color, int start, int end);
   void Clear();
 
+  // Replace the text between character range [start, end) with |text|, the
+  // native layout is updated in place instead of being rebuilt. Passing -1
+  // as |end| means the rest of the text.
+  void ReplaceText(int start, int end, const std::string& text);
+  void AppendText(const std::string& text);
+
   RectF GetBoundsFor(const SizeF& size) const;
   std::string GetText() const;
 
@@ -42,6 +48,14 @@ class NATIVEUI_EXPORT AttributedText : public base::RefCounted<AttributedText> {
   SizeF GetOneLineSize() const;
   float GetOneLineHeight() const;
 
+  // Internal: Increased whenever a change that may affect the bounds of text
+  // is made, used for invalidating cached measurements.
+  int generation() const { return generation_; }
+
+  // Internal: Increased on every change, including the ones that do not
+  // affect bounds like colors, used for invalidating copies of native text.
+  int revision() const { return revision_; }
+
   NativeAttributedText GetNative() const { return text_; }
 
  protected:
@@ -50,12 +64,33 @@ class NATIVEUI_EXPORT AttributedText : public base::RefCounted<AttributedText> {
  private:
   friend class base::RefCounted<AttributedText>;
 
+  RectF PlatformGetBoundsFor(const SizeF& size) const;
   void PlatformUpdateFormat();
   void PlatformSetFontFor(scoped_refptr<Font> font, int start, int end);
   void PlatformSetColorFor(Color color, int start, int end);
+  void PlatformReplaceText(int start, int end, const std::string& text);
+  void PlatformAppendText(const std::string& text);
 
   NativeAttributedText text_;
   TextFormat format_;
+  int generation_ = 0;
+  int revision_ = 0;
+
+#if defined(OS_MACOSX)
+  // Inserted text takes the attributes of its neighbors, which do not exist
+  // when the text is empty.
+  scoped_refptr<Font> font_;
+  Color color_;
+#endif
+
+  // The last measured bounds, painters and labels usually measure the same
+  // text with the same size repeatedly.
+  mutable SizeF bounds_constraint_;
+  mutable RectF bounds_;
+  mutable int bounds_generation_ = -1;
+
+  // Counts the text in memory reports.
+  LiveObjectTracker live_object_{LiveObjectType::AttributedText, this};
 };
 
 }  // namespace nu
@@ -0,0 +1,43 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class AttributedTextTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(AttributedTextTest, ReplaceText) {
+  scoped_refptr<nu::AttributedText> text =
+      new nu::AttributedText("hello world", nu::TextFormat());
+  text->ReplaceText(6, 11, "yue");
+  EXPECT_EQ(text->GetText(), "hello yue");
+  text->ReplaceText(0, 0, "> ");
+  EXPECT_EQ(text->GetText(), "> hello yue");
+  text->ReplaceText(2, -1, "");
+  EXPECT_EQ(text->GetText(), "> ");
+  // Invalid ranges are ignored.
+  text->ReplaceText(2, 1, "ignored");
+  EXPECT_EQ(text->GetText(), "> ");
+}
+
+TEST_F(AttributedTextTest, ReplaceTextWithUnicode) {
+  scoped_refptr<nu::AttributedText> text =
+      new nu::AttributedText("\xE4\xBD\xA0\xE5\xA5\xBD", nu::TextFormat());
+  text->ReplaceText(1, 2, "a");
+  EXPECT_EQ(text->GetText(), "\xE4\xBD\xA0" "a");
+}
+
+TEST_F(AttributedTextTest, AppendText) {
+  scoped_refptr<nu::AttributedText> text =
+      new nu::AttributedText("", nu::TextFormat());
+  float empty_width = text->GetOneLineSize().width();
+  text->AppendText("line 1\n");
+  text->AppendText("line 2");
+  EXPECT_EQ(text->GetText(), "line 1\nline 2");
+  EXPECT_GT(text->GetOneLineSize().width(), empty_width);
+}
@@ -4,6 +4,8 @@
 
 #include "nativeui/gfx/canvas.h"
 
+#include <utility>
+
 #include "nativeui/gfx/painter.h"
 #include "nativeui/screen.h"
 
@@ -20,7 +22,27 @@ Canvas::Canvas(const SizeF& size, float scale_factor)
       painter_(PlatformCreatePainter(bitmap_, size_, scale_factor)) {
 }
 
+#if !defined(OS_WIN)
+Canvas::Canvas(const SizeF& size, Window* window)
+    : scale_factor_(
+          Screen::GetCurrent()->GetDisplayNearestWindow(window).scale_factor),
+      size_(size.IsEmpty() ? SizeF(1, 1) : size),
+      bitmap_(PlatformCreateSharedBitmap(size_, scale_factor_, window)),
+      painter_(PlatformCreatePainter(bitmap_, size_, scale_factor_)),
+      shared_(true) {
+}
+#endif
+
+void Canvas::EncodeAsync(const std::string& format,
+                         const Image::EncodeOptions& options,
+                         Image::EncodeCallback callback) {
+  Image::EncodePixelsAsync(LockPixels(), format, options, std::move(callback));
+  UnlockPixels();
+}
+
 Canvas::~Canvas() {
+  // The painter may still write to the bitmap when it is destroyed.
+  painter_.reset();
   PlatformDestroyBitmap(bitmap_);
 }
 
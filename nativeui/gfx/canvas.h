@@ -6,15 +6,31 @@
 #define NATIVEUI_GFX_CANVAS_H_
 
 #include <memory>
+#include <string>
 
 #include "base/memory/ref_counted.h"
+#include "nativeui/buffer.h"
+#include "nativeui/gfx/geometry/size.h"
 #include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/memory_report.h"
 #include "nativeui/nativeui_export.h"
 #include "nativeui/types.h"
 
 namespace nu {
 
 class Painter;
+class Window;
+
+// The pixels of canvas for direct access.
+struct NATIVEUI_EXPORT CanvasPixels {
+  // The memory of pixels, in premultiplied 32-bit BGRA format.
+  Buffer buffer;
+  // The size in pixels.
+  Size size;
+  // The number of bytes of each row.
+  int stride = 0;
+};
 
 class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
  public:
@@ -25,6 +41,13 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   explicit Canvas(const SizeF& size);
   // Create a canvas with |scale_factor|.
   Canvas(const SizeF& size, float scale_factor);
+#if defined(OS_WIN)
+  // Create a canvas that is painted with Direct2D instead of GDI+.
+  Canvas(const SizeF& size, float scale_factor, bool direct2d);
+#endif
+  // Create a canvas whose pixels can be composited into |window| without
+  // uploading, using the scale factor of the display nearest to |window|.
+  Canvas(const SizeF& size, Window* window);
 
   // Return the independent scale factor of canvas.
   float GetScaleFactor() const { return scale_factor_; }
@@ -35,8 +58,33 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   // Return the size of canvas.
   SizeF GetSize() const { return size_; }
 
+  // Return whether the canvas is created for a window.
+  bool IsShared() const { return shared_; }
+
+  // Return the pixels of canvas without copying, drawings are flushed before
+  // returning. The memory is only valid until UnlockPixels is called, and
+  // the painter should not be used before unlocking.
+  CanvasPixels LockPixels();
+
+  // Notify that the writing of pixels is done.
+  void UnlockPixels();
+
+  // Encode the pixels in worker threads, only the copying of pixels is done
+  // in current thread. See Image::EncodeAsync for details.
+  void EncodeAsync(const std::string& format,
+                   const Image::EncodeOptions& options,
+                   Image::EncodeCallback callback);
+
   // Internal: Return the native bitmap object.
+#if defined(OS_WIN)
+  NativeBitmap GetBitmap() const;
+
+  // Internal: Upload the pixels to a Direct2D bitmap that can be drawn by
+  // |target|, the bitmap is reused as long as the target does not change.
+  ID2D1Bitmap* GetDirect2DBitmap(ID2D1RenderTarget* target);
+#else
   NativeBitmap GetBitmap() const { return bitmap_; }
+#endif
 
  protected:
   virtual ~Canvas();
@@ -47,6 +95,11 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
   // Platform implementations.
   static NativeBitmap PlatformCreateBitmap(const SizeF& size,
                                            float scale_factor);
+#if !defined(OS_WIN)
+  static NativeBitmap PlatformCreateSharedBitmap(const SizeF& size,
+                                                 float scale_factor,
+                                                 Window* window);
+#endif
   static void PlatformDestroyBitmap(NativeBitmap bitmap);
   static Painter* PlatformCreatePainter(NativeBitmap bitmap,
                                         const SizeF& size,
@@ -57,6 +110,21 @@ class NATIVEUI_EXPORT Canvas : public base::RefCounted<Canvas> {
 
   NativeBitmap bitmap_;
   std::unique_ptr<Painter> painter_;
+
+  // Whether the bitmap is created by PlatformCreateSharedBitmap.
+  bool shared_ = false;
+
+#if defined(OS_WIN)
+  // The drawing of Direct2D must be flushed before reading the bitmap.
+  bool direct2d_ = false;
+
+  // The Direct2D bitmap and the render target that created it.
+  Microsoft::WRL::ComPtr<ID2D1RenderTarget> d2d_target_;
+  Microsoft::WRL::ComPtr<ID2D1Bitmap> d2d_bitmap_;
+#endif
+
+  // Counts the canvas in memory reports.
+  LiveObjectTracker live_object_{LiveObjectType::Canvas, this};
 };
 
 }  // namespace nu
@@ -0,0 +1,79 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string.h>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class CanvasTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(CanvasTest, LockPixels) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 20), 2.f);
+  canvas->GetPainter()->SetFillColor(nu::Color(255, 0, 0));
+  canvas->GetPainter()->FillRect(nu::RectF(0, 0, 10, 20));
+  nu::CanvasPixels pixels = canvas->LockPixels();
+  EXPECT_EQ(pixels.size, nu::Size(20, 40));
+  EXPECT_GE(pixels.stride, 20 * 4);
+  EXPECT_EQ(pixels.buffer.size(),
+            static_cast<size_t>(pixels.stride * pixels.size.height()));
+  // Premultiplied BGRA.
+  const uint8_t* data = static_cast<const uint8_t*>(pixels.buffer.content());
+  EXPECT_EQ(data[0], 0);
+  EXPECT_EQ(data[1], 0);
+  EXPECT_EQ(data[2], 255);
+  EXPECT_EQ(data[3], 255);
+  canvas->UnlockPixels();
+}
+
+TEST_F(CanvasTest, WritePixels) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(4, 4), 1.f);
+  nu::CanvasPixels pixels = canvas->LockPixels();
+  memset(pixels.buffer.content(), 0xFF, pixels.buffer.size());
+  canvas->UnlockPixels();
+  // The written pixels are visible after unlocking.
+  pixels = canvas->LockPixels();
+  EXPECT_EQ(static_cast<const uint8_t*>(pixels.buffer.content())[0], 0xFF);
+  canvas->UnlockPixels();
+}
+
+TEST_F(CanvasTest, LockPixelsTwice) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(4, 4), 1.f);
+  // The bindings unlock the previous lock before locking again, and keep a
+  // reference to the canvas while the memory is exposed.
+  nu::CanvasPixels pixels = canvas->LockPixels();
+  canvas->UnlockPixels();
+  pixels = canvas->LockPixels();
+  scoped_refptr<nu::Canvas> ref = canvas;
+  canvas = nullptr;
+  memset(pixels.buffer.content(), 0xFF, pixels.buffer.size());
+  ref->UnlockPixels();
+  pixels = ref->LockPixels();
+  EXPECT_EQ(static_cast<const uint8_t*>(pixels.buffer.content())[0], 0xFF);
+  ref->UnlockPixels();
+}
+
+TEST_F(CanvasTest, SharedWithWindow) {
+  scoped_refptr<nu::Window> window = new nu::Window(nu::Window::Options());
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 20),
+                                                    window.get());
+  EXPECT_TRUE(canvas->IsShared());
+  float scale_factor = canvas->GetScaleFactor();
+  canvas->GetPainter()->SetFillColor(nu::Color(255, 0, 0));
+  canvas->GetPainter()->FillRect(nu::RectF(0, 0, 10, 20));
+  nu::CanvasPixels pixels = canvas->LockPixels();
+  EXPECT_EQ(pixels.size, nu::Size(10 * scale_factor, 20 * scale_factor));
+  EXPECT_EQ(static_cast<const uint8_t*>(pixels.buffer.content())[3], 255);
+  canvas->UnlockPixels();
+  // Drawing onto other canvases still works.
+  scoped_refptr<nu::Canvas> other = new nu::Canvas(nu::SizeF(10, 20), 1.f);
+  other->GetPainter()->DrawCanvas(canvas.get(), nu::RectF(0, 0, 10, 20));
+  pixels = other->LockPixels();
+  EXPECT_EQ(static_cast<const uint8_t*>(pixels.buffer.content())[2], 255);
+  other->UnlockPixels();
+}
@@ -8,6 +8,7 @@
 
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "nativeui/state.h"
 
 namespace nu {
 
@@ -15,6 +16,10 @@ namespace {
 
 const uint32_t kColorWhite = 0xFFFFFFFF;
 
+// Apps only use a small set of colors, the cache is dropped when it grows
+// beyond this size to bound the memory used by generated strings.
+const size_t kMaxParsedColors = 256;
+
 uint32_t ParseHexColor(const std::string& color_string) {
   // Check the string for incorrect formatting.
   if (color_string.empty() || color_string[0] != '#')
@@ -52,6 +57,22 @@ uint32_t ParseHexColor(const std::string& color_string) {
 
 }  // namespace
 
+// static
+Color Color::FromHexCached(const std::string& hex) {
+  State* state = State::GetCurrent();
+  if (!state)
+    return Color(hex);
+  auto& parsed_colors = state->parsed_colors();
+  auto it = parsed_colors.find(hex);
+  if (it != parsed_colors.end())
+    return it->second;
+  if (parsed_colors.size() >= kMaxParsedColors)
+    parsed_colors.clear();
+  Color color(hex);
+  parsed_colors.emplace(hex, color);
+  return color;
+}
+
 Color::Color(const std::string& hex) : value_(ParseHexColor(hex)) {}
 
 std::string Color::ToString() const {
@@ -41,6 +41,10 @@ class NATIVEUI_EXPORT Color {
 
   static Color Get(Name name);
 
+  // Internal: Same with Color(hex) but remembers recently parsed strings, used
+  // by bindings that usually pass the same strings repeatedly.
+  static Color FromHexCached(const std::string& hex);
+
   explicit Color(const std::string& hex);
   explicit Color(uint32_t value) : value_(value) {}
   Color(unsigned a, unsigned r, unsigned g, unsigned b)
@@ -0,0 +1,340 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/display_list.h"
+
+#include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/path.h"
+
+namespace nu {
+
+enum class DisplayList::Op : uint8_t {
+  Save,
+  Restore,
+  BeginPath,
+  ClosePath,
+  MoveTo,
+  LineTo,
+  BezierCurveTo,
+  Arc,
+  Rect,
+  Clip,
+  ClipRect,
+  Translate,
+  Rotate,
+  Scale,
+  SetColor,
+  SetStrokeColor,
+  SetFillColor,
+  SetLineWidth,
+  Stroke,
+  Fill,
+  StrokePath,
+  FillPath,
+  Clear,
+  StrokeRect,
+  FillRect,
+  DrawImage,
+  DrawImageFromRect,
+  DrawCanvas,
+  DrawCanvasFromRect,
+  DrawAttributedText,
+};
+
+// The painter that records operations into the list.
+class DisplayList::Recorder : public Painter {
+ public:
+  explicit Recorder(DisplayList* list) : list_(list) {}
+  ~Recorder() override {}
+
+  // Painter:
+  void Save() override {
+    list_->Record(Op::Save, {});
+  }
+  void Restore() override {
+    list_->Record(Op::Restore, {});
+  }
+  void BeginPath() override {
+    list_->Record(Op::BeginPath, {});
+  }
+  void ClosePath() override {
+    list_->Record(Op::ClosePath, {});
+  }
+  void MoveTo(const PointF& p) override {
+    list_->Record(Op::MoveTo, {p.x(), p.y()});
+  }
+  void LineTo(const PointF& p) override {
+    list_->Record(Op::LineTo, {p.x(), p.y()});
+  }
+  void BezierCurveTo(const PointF& cp1,
+                     const PointF& cp2,
+                     const PointF& ep) override {
+    list_->Record(Op::BezierCurveTo,
+                  {cp1.x(), cp1.y(), cp2.x(), cp2.y(), ep.x(), ep.y()});
+  }
+  void Arc(const PointF& p, float radius, float sa, float ea) override {
+    list_->Record(Op::Arc, {p.x(), p.y(), radius, sa, ea});
+  }
+  void Rect(const RectF& rect) override {
+    RecordRect(Op::Rect, rect);
+  }
+  void Clip() override {
+    list_->Record(Op::Clip, {});
+  }
+  void ClipRect(const RectF& rect) override {
+    RecordRect(Op::ClipRect, rect);
+  }
+  void Translate(const Vector2dF& offset) override {
+    list_->Record(Op::Translate, {offset.x(), offset.y()});
+  }
+  void Rotate(float angle) override {
+    list_->Record(Op::Rotate, {angle});
+  }
+  void Scale(const Vector2dF& scale) override {
+    list_->Record(Op::Scale, {scale.x(), scale.y()});
+  }
+  void SetColor(Color color) override {
+    RecordColor(Op::SetColor, color);
+  }
+  void SetStrokeColor(Color color) override {
+    RecordColor(Op::SetStrokeColor, color);
+  }
+  void SetFillColor(Color color) override {
+    RecordColor(Op::SetFillColor, color);
+  }
+  void SetLineWidth(float width) override {
+    list_->Record(Op::SetLineWidth, {width});
+  }
+  void Stroke() override {
+    list_->Record(Op::Stroke, {});
+  }
+  void Fill() override {
+    list_->Record(Op::Fill, {});
+  }
+  void StrokePath(Path* path) override {
+    list_->paths_.push_back(path);
+    list_->Record(Op::StrokePath, {});
+  }
+  void FillPath(Path* path) override {
+    list_->paths_.push_back(path);
+    list_->Record(Op::FillPath, {});
+  }
+  void Clear() override {
+    list_->Record(Op::Clear, {});
+  }
+  void StrokeRect(const RectF& rect) override {
+    RecordRect(Op::StrokeRect, rect);
+  }
+  void FillRect(const RectF& rect) override {
+    RecordRect(Op::FillRect, rect);
+  }
+  void DrawImage(const Image* image, const RectF& rect) override {
+    list_->images_.push_back(const_cast<Image*>(image));
+    RecordRect(Op::DrawImage, rect);
+  }
+  void DrawImageFromRect(const Image* image, const RectF& src,
+                         const RectF& dest) override {
+    list_->images_.push_back(const_cast<Image*>(image));
+    RecordRects(Op::DrawImageFromRect, src, dest);
+  }
+  void DrawCanvas(Canvas* canvas, const RectF& rect) override {
+    list_->canvases_.push_back(canvas);
+    RecordRect(Op::DrawCanvas, rect);
+  }
+  void DrawCanvasFromRect(Canvas* canvas, const RectF& src,
+                          const RectF& dest) override {
+    list_->canvases_.push_back(canvas);
+    RecordRects(Op::DrawCanvasFromRect, src, dest);
+  }
+  void DrawAttributedText(scoped_refptr<AttributedText> text,
+                          const RectF& rect) override {
+    list_->texts_.push_back(std::move(text));
+    RecordRect(Op::DrawAttributedText, rect);
+  }
+
+ private:
+  void RecordRect(Op op, const RectF& r) {
+    list_->Record(op, {r.x(), r.y(), r.width(), r.height()});
+  }
+  void RecordRects(Op op, const RectF& r1, const RectF& r2) {
+    list_->Record(op, {r1.x(), r1.y(), r1.width(), r1.height(),
+                       r2.x(), r2.y(), r2.width(), r2.height()});
+  }
+  void RecordColor(Op op, Color color) {
+    list_->colors_.push_back(color);
+    list_->Record(op, {});
+  }
+
+  DisplayList* list_;
+};
+
+DisplayList::DisplayList() {}
+
+DisplayList::~DisplayList() {}
+
+Painter* DisplayList::GetPainter() {
+  if (!recorder_)
+    recorder_.reset(new Recorder(this));
+  return recorder_.get();
+}
+
+void DisplayList::Replay(Painter* painter) const {
+  size_t arg = 0, color = 0, text = 0, image = 0, canvas = 0, path = 0;
+  auto point = [&]() {
+    PointF p(args_[arg], args_[arg + 1]);
+    arg += 2;
+    return p;
+  };
+  auto rect = [&]() {
+    RectF r(args_[arg], args_[arg + 1], args_[arg + 2], args_[arg + 3]);
+    arg += 4;
+    return r;
+  };
+  // Unmatched Save calls in the list should not affect the caller.
+  painter->Save();
+  for (Op op : ops_) {
+    switch (op) {
+      case Op::Save:
+        painter->Save();
+        break;
+      case Op::Restore:
+        painter->Restore();
+        break;
+      case Op::BeginPath:
+        painter->BeginPath();
+        break;
+      case Op::ClosePath:
+        painter->ClosePath();
+        break;
+      case Op::MoveTo:
+        painter->MoveTo(point());
+        break;
+      case Op::LineTo:
+        painter->LineTo(point());
+        break;
+      case Op::BezierCurveTo: {
+        PointF cp1 = point();
+        PointF cp2 = point();
+        painter->BezierCurveTo(cp1, cp2, point());
+        break;
+      }
+      case Op::Arc: {
+        PointF p = point();
+        painter->Arc(p, args_[arg], args_[arg + 1], args_[arg + 2]);
+        arg += 3;
+        break;
+      }
+      case Op::Rect:
+        painter->Rect(rect());
+        break;
+      case Op::Clip:
+        painter->Clip();
+        break;
+      case Op::ClipRect:
+        painter->ClipRect(rect());
+        break;
+      case Op::Translate:
+        painter->Translate(point().OffsetFromOrigin());
+        break;
+      case Op::Rotate:
+        painter->Rotate(args_[arg++]);
+        break;
+      case Op::Scale:
+        painter->Scale(point().OffsetFromOrigin());
+        break;
+      case Op::SetColor:
+        painter->SetColor(colors_[color++]);
+        break;
+      case Op::SetStrokeColor:
+        painter->SetStrokeColor(colors_[color++]);
+        break;
+      case Op::SetFillColor:
+        painter->SetFillColor(colors_[color++]);
+        break;
+      case Op::SetLineWidth:
+        painter->SetLineWidth(args_[arg++]);
+        break;
+      case Op::Stroke:
+        painter->Stroke();
+        break;
+      case Op::Fill:
+        painter->Fill();
+        break;
+      case Op::StrokePath:
+        painter->StrokePath(paths_[path++].get());
+        break;
+      case Op::FillPath:
+        painter->FillPath(paths_[path++].get());
+        break;
+      case Op::Clear:
+        painter->Clear();
+        break;
+      case Op::StrokeRect:
+        painter->StrokeRect(rect());
+        break;
+      case Op::FillRect:
+        painter->FillRect(rect());
+        break;
+      case Op::DrawImage:
+        painter->DrawImage(images_[image++].get(), rect());
+        break;
+      case Op::DrawImageFromRect: {
+        RectF src = rect();
+        painter->DrawImageFromRect(images_[image++].get(), src, rect());
+        break;
+      }
+      case Op::DrawCanvas:
+        painter->DrawCanvas(canvases_[canvas++].get(), rect());
+        break;
+      case Op::DrawCanvasFromRect: {
+        RectF src = rect();
+        painter->DrawCanvasFromRect(canvases_[canvas++].get(), src, rect());
+        break;
+      }
+      case Op::DrawAttributedText:
+        painter->DrawAttributedText(texts_[text++], rect());
+        break;
+    }
+  }
+  painter->Restore();
+}
+
+scoped_refptr<DisplayList> DisplayList::Clone() const {
+  scoped_refptr<DisplayList> list = new DisplayList;
+  list->ops_ = ops_;
+  list->args_ = args_;
+  list->colors_ = colors_;
+  list->texts_ = texts_;
+  list->images_ = images_;
+  list->canvases_ = canvases_;
+  list->paths_ = paths_;
+  return list;
+}
+
+bool DisplayList::IsSelfContained() const {
+  return texts_.empty() && images_.empty() && canvases_.empty() &&
+         paths_.empty();
+}
+
+void DisplayList::Clear() {
+  ++version_;
+  ops_.clear();
+  args_.clear();
+  colors_.clear();
+  texts_.clear();
+  images_.clear();
+  canvases_.clear();
+  paths_.clear();
+}
+
+void DisplayList::Record(Op op, std::initializer_list<float> args) {
+  ++version_;
+  ops_.push_back(op);
+  args_.insert(args_.end(), args);
+}
+
+}  // namespace nu
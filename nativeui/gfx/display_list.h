@@ -0,0 +1,88 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_DISPLAY_LIST_H_
+#define NATIVEUI_GFX_DISPLAY_LIST_H_
+
+#include <stdint.h>
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class AttributedText;
+class Canvas;
+class Image;
+class Painter;
+class Path;
+
+// Records the operations of Painter and replays them later.
+//
+// Compared to drawing in the on_draw handler, replaying a recorded list does
+// not call into script code, which is much faster for static contents.
+class NATIVEUI_EXPORT DisplayList : public base::RefCounted<DisplayList> {
+ public:
+  DisplayList();
+
+  // Return the Painter that records operations into the list.
+  Painter* GetPainter();
+
+  // Run the recorded operations on |painter|.
+  void Replay(Painter* painter) const;
+
+  // Remove all recorded operations.
+  void Clear();
+
+  // Return the number of recorded operations.
+  int GetOpCount() const { return static_cast<int>(ops_.size()); }
+  bool IsEmpty() const { return ops_.empty(); }
+
+  // Internal: Return a copy of the list.
+  scoped_refptr<DisplayList> Clone() const;
+
+  // Internal: Whether the list does not reference other objects, which can
+  // be safely replayed outside the main thread.
+  bool IsSelfContained() const;
+
+  // Internal: Increased whenever the list is changed.
+  int GetVersion() const { return version_; }
+
+ private:
+  friend class base::RefCounted<DisplayList>;
+
+  class Recorder;
+
+  ~DisplayList();
+
+  enum class Op : uint8_t;
+
+  // Append the operation with its arguments.
+  void Record(Op op, std::initializer_list<float> args);
+
+  // Each operation reads a fixed number of arguments from the streams in
+  // order, which keeps the list compact and cache friendly.
+  std::vector<Op> ops_;
+  std::vector<float> args_;
+  std::vector<Color> colors_;
+  std::vector<scoped_refptr<AttributedText>> texts_;
+  std::vector<scoped_refptr<Image>> images_;
+  std::vector<scoped_refptr<Canvas>> canvases_;
+  std::vector<scoped_refptr<Path>> paths_;
+
+  std::unique_ptr<Recorder> recorder_;
+
+  int version_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(DisplayList);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_DISPLAY_LIST_H_
@@ -0,0 +1,73 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class DisplayListTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    list_ = new nu::DisplayList;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::DisplayList> list_;
+};
+
+TEST_F(DisplayListTest, Record) {
+  nu::Painter* painter = list_->GetPainter();
+  EXPECT_TRUE(list_->IsEmpty());
+  painter->BeginPath();
+  painter->MoveTo(nu::PointF(0, 0));
+  painter->LineTo(nu::PointF(10, 10));
+  painter->SetStrokeColor(nu::Color(0xFF, 0, 0));
+  painter->Stroke();
+  EXPECT_EQ(list_->GetOpCount(), 5);
+  list_->Clear();
+  EXPECT_TRUE(list_->IsEmpty());
+}
+
+TEST_F(DisplayListTest, Replay) {
+  nu::Painter* painter = list_->GetPainter();
+  painter->Save();
+  painter->Translate(nu::Vector2dF(5, 5));
+  painter->FillRect(nu::RectF(0, 0, 10, 10));
+  painter->DrawText("text", nu::RectF(0, 0, 100, 100), nu::TextAttributes());
+  painter->Restore();
+  scoped_refptr<nu::DisplayList> copy = new nu::DisplayList;
+  list_->Replay(copy->GetPainter());
+  // The replay is wrapped with a pair of Save and Restore.
+  EXPECT_EQ(copy->GetOpCount(), list_->GetOpCount() + 2);
+}
+
+TEST_F(DisplayListTest, ReplayOnCanvas) {
+  list_->GetPainter()->SetFillColor(nu::Color(0, 0xFF, 0));
+  list_->GetPainter()->FillRect(nu::RectF(0, 0, 10, 10));
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 10), 1.f);
+  list_->Replay(canvas->GetPainter());
+}
+
+TEST_F(DisplayListTest, Container) {
+  scoped_refptr<nu::Container> container = new nu::Container;
+  EXPECT_FALSE(container->HasCustomDraw());
+  container->SetDisplayList(list_);
+  EXPECT_EQ(container->GetDisplayList(), list_.get());
+  EXPECT_TRUE(container->HasCustomDraw());
+}
+
+TEST_F(DisplayListTest, Clone) {
+  nu::Painter* painter = list_->GetPainter();
+  int version = list_->GetVersion();
+  painter->FillRect(nu::RectF(0, 0, 10, 10));
+  EXPECT_NE(list_->GetVersion(), version);
+  EXPECT_TRUE(list_->IsSelfContained());
+  scoped_refptr<nu::DisplayList> copy = list_->Clone();
+  EXPECT_EQ(copy->GetOpCount(), 1);
+  // The copy is not affected by changes to the original list.
+  painter->DrawText("text", nu::RectF(0, 0, 100, 100), nu::TextAttributes());
+  EXPECT_FALSE(list_->IsSelfContained());
+  EXPECT_EQ(copy->GetOpCount(), 1);
+  EXPECT_TRUE(copy->IsSelfContained());
+}
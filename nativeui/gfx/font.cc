@@ -4,20 +4,125 @@
 
 #include "nativeui/gfx/font.h"
 
+#include <memory>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "nativeui/gfx/text_layout_cache.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/state.h"
+#include "nativeui/util/worker_pool.h"
 
 namespace nu {
 
+struct Font::LoadJob {
+  // Called in the worker thread.
+  void Run() {
+    for (size_t i = 0; i < paths.size(); ++i)
+      loaded.push_back(fonts[i]->ReadFromPath(paths[i], size));
+    MessageLoop::PostTask([this]() { Finish(); });
+  }
+
+  // Pass the fonts to callback in the main thread.
+  void Finish() {
+    std::unique_ptr<LoadJob> auto_delete(this);
+    for (size_t i = 0; i < fonts.size(); ++i) {
+      if (!loaded[i])
+        fonts[i] = nullptr;
+    }
+    // The state has been destroyed.
+    if (State::GetCurrent() && callback)
+      callback(std::move(fonts));
+  }
+
+  std::vector<base::FilePath> paths;
+  float size;
+  LoadSetCallback callback;
+  // The fonts are created in the main thread, so the worker thread only reads
+  // the native fonts into them.
+  std::vector<scoped_refptr<Font>> fonts;
+  std::vector<bool> loaded;
+};
+
 // static
 Font* Font::Default() {
   auto& default_font = State::GetCurrent()->default_font();
-  if (!default_font)
+  if (!default_font) {
+    ScopedStartupPhase startup_phase(StartupPhase::DefaultFont);
     default_font = new Font;
+  }
   return default_font.get();
 }
 
-Font* Font::Derive(float size_delta, Weight weight, Style style) const {
-  return new Font(GetName(), GetSize() + size_delta, weight, style);
+Font::Font(Empty) {}
+
+// static
+void Font::LoadAsync(const base::FilePath& path,
+                     float size,
+                     LoadCallback callback) {
+  LoadSetAsync({path}, size,
+               [callback](std::vector<scoped_refptr<Font>> fonts) {
+                 if (callback)
+                   callback(std::move(fonts[0]));
+               });
+}
+
+// static
+void Font::LoadSetAsync(const std::vector<base::FilePath>& paths,
+                        float size,
+                        LoadSetCallback callback) {
+  LoadJob* job = new LoadJob;
+  job->paths = paths;
+  job->size = size;
+  job->callback = std::move(callback);
+  for (size_t i = 0; i < paths.size(); ++i)
+    job->fonts.push_back(new Font(Empty()));
+  WorkerPool::PostTask([job]() { job->Run(); });
+}
+
+// static
+scoped_refptr<Font> Font::Get(const std::string& name,
+                              float size,
+                              Weight weight,
+                              Style style) {
+  CacheKey key(name, size, weight, style);
+  auto& fonts = State::GetCurrent()->interned_fonts();
+  auto it = fonts.find(key);
+  if (it != fonts.end())
+    return it->second;
+  Font* font = new Font(name, size, weight, style);
+  font->cache_key_.reset(new CacheKey(key));
+  fonts[key] = font;
+  return font;
+}
+
+scoped_refptr<Font> Font::Derive(float size_delta,
+                                 Weight weight,
+                                 Style style) const {
+  return Get(GetName(), GetSize() + size_delta, weight, style);
+}
+
+std::vector<SizeF> Font::MeasureStrings(const std::vector<std::string>& texts,
+                                        const SizeF& constraint) {
+  // The color does not affect bounds so the default one is used.
+  TextAttributes attributes(this);
+  TextLayoutCache* cache = State::GetCurrent()->GetTextLayoutCache();
+  std::vector<SizeF> sizes;
+  sizes.reserve(texts.size());
+  for (const std::string& text : texts)
+    sizes.push_back(cache->GetBoundsFor(text, attributes, constraint).size());
+  return sizes;
+}
+
+void Font::RemoveFromCache() {
+  State* state = State::GetCurrent();
+  if (!cache_key_ || !state)
+    return;
+  // The font may outlive the state that interned it.
+  auto& fonts = state->interned_fonts();
+  auto it = fonts.find(*cache_key_);
+  if (it != fonts.end() && it->second == this)
+    fonts.erase(it);
 }
 
 }  // namespace nu
@@ -5,10 +5,16 @@
 #ifndef NATIVEUI_GFX_FONT_H_
 #define NATIVEUI_GFX_FONT_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/memory_report.h"
 #include "nativeui/nativeui_export.h"
 #include "nativeui/types.h"
 
@@ -53,6 +59,14 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
     Italic = 1,
   };
 
+  // Return a font with the specified |name| (encoded in UTF-8), DIP |size|,
+  // |weight| and |style|. Fonts with the same specification are shared, so
+  // the native font handle is only created once while the font is alive.
+  static scoped_refptr<Font> Get(const std::string& name,
+                                 float size,
+                                 Weight weight,
+                                 Style style);
+
   // Create a Font implementation with the specified |name|
   // (encoded in UTF-8), DIP |size|, |weight| and |style|.
   Font(const std::string& name, float size, Weight weight, Style style);
@@ -60,9 +74,29 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
   // Create from from file path.
   Font(const base::FilePath& path, float size);
 
-  // Returns a new Font derived from the existing font.
-  // It is caller's responsibility to manage the lifetime of returned font.
-  Font* Derive(float size_delta, Weight weight, Style style) const;
+  // Called with the loaded font, or null if the file can not be read.
+  using LoadCallback = std::function<void(scoped_refptr<Font>)>;
+  using LoadSetCallback =
+      std::function<void(std::vector<scoped_refptr<Font>>)>;
+
+  // Read the font from |path| in a worker thread, the |callback| is called in
+  // the main thread.
+  static void LoadAsync(const base::FilePath& path,
+                        float size,
+                        LoadCallback callback);
+
+  // Read the fonts from |paths| in one worker thread, which can be used for
+  // preloading the fonts bundled with app while showing splash screen. The
+  // |callback| receives the fonts in the same order with |paths|.
+  static void LoadSetAsync(const std::vector<base::FilePath>& paths,
+                           float size,
+                           LoadSetCallback callback);
+
+  // Returns a Font derived from the existing font, which is shared with other
+  // fonts of the same specification.
+  scoped_refptr<Font> Derive(float size_delta,
+                             Weight weight,
+                             Style style) const;
 
   // Return the specified font name in UTF-8.
   std::string GetName() const;
@@ -76,6 +110,12 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
   // Return the font style.
   Style GetStyle() const;
 
+  // Return the sizes of |texts| drawn with this font when laid out in
+  // |constraint|, in one call. The texts are shaped through the shared text
+  // layout cache, so measuring them again or drawing them is cheap.
+  std::vector<SizeF> MeasureStrings(const std::vector<std::string>& texts,
+                                    const SizeF& constraint);
+
   // Return the native font handle.
   NativeFont GetNative() const;
 
@@ -83,10 +123,13 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
   // Private: Return font name in UTF-16.
   const std::wstring& GetName16() const;
 
-  // Private: Get or create the HFONT.
-  HFONT GetHFONT(HWND hwnd) const;
+  // Private: Get or create the HFONT for windows under |scale_factor|.
+  HFONT GetHFONT(float scale_factor) const;
 #endif
 
+  // Internal: The specification used for looking up interned fonts.
+  using CacheKey = std::tuple<std::string, float, Weight, Style>;
+
  protected:
   // Create default system UI font.
   Font();
@@ -96,7 +139,23 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
  private:
   friend class base::RefCounted<Font>;
 
-  NativeFont font_;
+  struct LoadJob;
+
+  // Create a font without native font, which is read by LoadJob later.
+  struct Empty {};
+  explicit Font(Empty);
+
+  // Read the native font from file, which does not touch the reference count
+  // and can be called in worker threads.
+  bool ReadFromPath(const base::FilePath& path, float size);
+
+  // Remove the font from the interned fonts, called on destruction.
+  void RemoveFromCache();
+
+  NativeFont font_ = nullptr;
+
+  // The key in the interned fonts, only set for fonts created by Get.
+  std::unique_ptr<CacheKey> cache_key_;
 
 #if defined(OS_WIN)
   // Cached PrivateFontCollection, used by fonts created from paths.
@@ -105,9 +164,13 @@ class NATIVEUI_EXPORT Font : public base::RefCounted<Font> {
   // Cached font family, which is requested by DirectWrite a lot.
   mutable std::wstring font_family_;
 
-  // Cached HFont.
-  mutable base::win::ScopedHFONT hfont_;
+  // Cached HFONTs for each scale factor, so moving windows between monitors
+  // does not create fonts again.
+  mutable std::map<float, base::win::ScopedHFONT> hfonts_;
 #endif
+
+  // Counts the font in memory reports.
+  LiveObjectTracker live_object_{LiveObjectType::Font, this};
 };
 
 }  // namespace nu
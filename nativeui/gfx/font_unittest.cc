@@ -0,0 +1,79 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class FontTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(FontTest, GetInternedFont) {
+  scoped_refptr<nu::Font> font = nu::Font::Get(
+      "Arial", 12, nu::Font::Weight::Normal, nu::Font::Style::Normal);
+  EXPECT_EQ(nu::Font::Get("Arial", 12, nu::Font::Weight::Normal,
+                          nu::Font::Style::Normal), font);
+  EXPECT_NE(nu::Font::Get("Arial", 13, nu::Font::Weight::Normal,
+                          nu::Font::Style::Normal), font);
+  EXPECT_NE(nu::Font::Get("Arial", 12, nu::Font::Weight::Bold,
+                          nu::Font::Style::Normal), font);
+}
+
+TEST_F(FontTest, ReleaseInternedFont) {
+  nu::Font::Get("Arial", 12, nu::Font::Weight::Normal,
+                nu::Font::Style::Italic);
+  EXPECT_TRUE(state_.interned_fonts().empty());
+}
+
+TEST_F(FontTest, Derive) {
+  scoped_refptr<nu::Font> font = nu::Font::Default()->Derive(
+      1, nu::Font::Weight::Bold, nu::Font::Style::Normal);
+  EXPECT_EQ(font, nu::Font::Default()->Derive(
+      1, nu::Font::Weight::Bold, nu::Font::Style::Normal));
+}
+
+TEST_F(FontTest, MeasureStrings) {
+  nu::Font* font = nu::Font::Default();
+  nu::SizeF constraint(1000, 1000);
+  std::vector<nu::SizeF> sizes = font->MeasureStrings(
+      {"a", "a longer text", ""}, constraint);
+  ASSERT_EQ(sizes.size(), 3u);
+  EXPECT_GT(sizes[0].width(), 0);
+  EXPECT_GT(sizes[1].width(), sizes[0].width());
+  scoped_refptr<nu::AttributedText> text =
+      new nu::AttributedText("a longer text", nu::TextAttributes(font));
+  EXPECT_EQ(sizes[1], text->GetBoundsFor(constraint).size());
+}
+
+TEST_F(FontTest, LoadAsyncFailure) {
+  bool called = false;
+  nu::Font::LoadAsync(base::FilePath(FILE_PATH_LITERAL("not_exist.ttf")), 12,
+                      [&called](scoped_refptr<nu::Font> font) {
+    called = true;
+    EXPECT_FALSE(font);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(called);
+}
+
+TEST_F(FontTest, LoadSetAsync) {
+  std::vector<base::FilePath> paths = {
+    base::FilePath(FILE_PATH_LITERAL("a.ttf")),
+    base::FilePath(FILE_PATH_LITERAL("b.ttf")),
+  };
+  size_t count = 0;
+  nu::Font::LoadSetAsync(paths, 12,
+                         [&count](std::vector<scoped_refptr<nu::Font>> fonts) {
+    count = fonts.size();
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(count, 2u);
+}
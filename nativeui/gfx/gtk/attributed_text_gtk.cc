@@ -5,6 +5,7 @@
 #include "nativeui/gfx/attributed_text.h"
 
 #include <math.h>
+#include <string.h>
 
 #include <gtk/gtk.h>
 #include <pango/pango.h>
@@ -27,6 +28,19 @@ guint CharIndexToByteIndex(const base::string16& text, int index) {
   return base::UTF16ToUTF8(text.substr(0, index)).size();
 }
 
+// Convert the character index to byte index by walking the UTF-8 string,
+// which avoids converting the whole text.
+guint CharIndexToByteIndex(const char* text, guint length, int index) {
+  const char* p = text;
+  const char* end = text + length;
+  while (index > 0 && p < end) {
+    // The character index is counted in UTF-16 code units.
+    index -= g_utf8_get_char(p) > 0xFFFF ? 2 : 1;
+    p = g_utf8_next_char(p);
+  }
+  return p - text;
+}
+
 void FillPangoAttributeIndex(PangoAttribute* attr, PangoLayout* layout,
                              int start, int end) {
   if (start == 0 && end < 0)  // this is the most common case
@@ -119,7 +133,32 @@ void AttributedText::PlatformSetColorFor(Color color, int start, int end) {
   pango_attr_list_insert(attrs, fg_attr);  // ownership taken
 }
 
-RectF AttributedText::GetBoundsFor(const SizeF& size) const {
+void AttributedText::PlatformReplaceText(int start, int end,
+                                         const std::string& text) {
+  const char* old_text = pango_layout_get_text(text_);
+  guint length = strlen(old_text);
+  guint pos = CharIndexToByteIndex(old_text, length, start);
+  guint pos_end = end > -1 ?
+      pos + CharIndexToByteIndex(old_text + pos, length - pos, end - start) :
+      length;
+#if PANGO_VERSION_CHECK(1, 44, 0)
+  // Move the attributes after the replaced range.
+  pango_attr_list_update(pango_layout_get_attributes(text_),
+                         pos, pos_end - pos, text.size());
+#endif
+  std::string new_text(old_text, pos);
+  new_text.append(text);
+  new_text.append(old_text + pos_end, length - pos_end);
+  pango_layout_set_text(text_, new_text.c_str(), new_text.size());
+}
+
+void AttributedText::PlatformAppendText(const std::string& text) {
+  std::string new_text(pango_layout_get_text(text_));
+  new_text.append(text);
+  pango_layout_set_text(text_, new_text.c_str(), new_text.size());
+}
+
+RectF AttributedText::PlatformGetBoundsFor(const SizeF& size) const {
   if (format_.wrap) {
     // Yoga may pass 0 as width to indicate no wrapping.
     if (size.width() == 0 || isnan(size.width()))
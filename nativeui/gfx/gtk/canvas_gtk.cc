@@ -4,10 +4,29 @@
 
 #include "nativeui/gfx/canvas.h"
 
+#include <gtk/gtk.h>
+
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/window.h"
 
 namespace nu {
 
+CanvasPixels Canvas::LockPixels() {
+  cairo_surface_flush(bitmap_);
+  CanvasPixels pixels;
+  pixels.size = Size(cairo_image_surface_get_width(bitmap_),
+                     cairo_image_surface_get_height(bitmap_));
+  pixels.stride = cairo_image_surface_get_stride(bitmap_);
+  pixels.buffer = Buffer::Wrap(cairo_image_surface_get_data(bitmap_),
+                               pixels.stride * pixels.size.height());
+  return pixels;
+}
+
+void Canvas::UnlockPixels() {
+  // Tell cairo that the surface has been modified.
+  cairo_surface_mark_dirty(bitmap_);
+}
+
 // static
 NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
                                           float scale_factor) {
@@ -19,6 +38,26 @@ NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
   return surface;
 }
 
+// static
+NativeBitmap Canvas::PlatformCreateSharedBitmap(const SizeF& size,
+                                                float scale_factor,
+                                                Window* window) {
+  GdkWindow* gdk_window =
+      gtk_widget_get_window(GTK_WIDGET(window->GetNative()));
+  if (!gdk_window)  // not realized yet
+    return PlatformCreateBitmap(size, scale_factor);
+  // On X11 the image surface similar to the window is stored in shared memory
+  // which is read by the X server directly, it is still an image surface so
+  // the pixels can be accessed in the same way.
+  cairo_surface_t* surface = gdk_window_create_similar_image_surface(
+      gdk_window, CAIRO_FORMAT_ARGB32,
+      size.width() * scale_factor,
+      size.height() * scale_factor,
+      1);
+  cairo_surface_set_device_scale(surface, scale_factor, scale_factor);
+  return surface;
+}
+
 // static
 void Canvas::PlatformDestroyBitmap(NativeBitmap bitmap) {
   cairo_surface_destroy(bitmap);
@@ -7,6 +7,9 @@
 #include <gtk/gtk.h>
 #include <pango/pangofc-fontmap.h>
 
+#include <map>
+
+#include "base/no_destructor.h"
 #include "nativeui/gtk/util/fontconfig.h"
 
 namespace nu {
@@ -25,6 +28,15 @@ PangoFontDescription* GetDefaultFontDescription() {
 }
 
 PangoFontDescription* FontDescriptionFromPath(const base::FilePath& path) {
+  // Adding the same file again makes fontconfig parse it again, and the
+  // application font set has to be searched linearly, so the descriptions of
+  // loaded files are remembered. Fonts are only created on main thread.
+  static base::NoDestructor<std::map<base::FilePath, PangoFontDescription*>>
+      loaded_fonts;
+  auto it = loaded_fonts->find(path);
+  if (it != loaded_fonts->end())
+    return pango_font_description_copy(it->second);
+
   // Add the font path to FcConfig first.
   FcConfig* config = GetGlobalFontConfig();
   FcConfigAppFontAddFile(
@@ -34,11 +46,15 @@ PangoFontDescription* FontDescriptionFromPath(const base::FilePath& path) {
   if (font_set) {
     for (int i = 0; i < font_set->nfont; ++i) {
       FcPattern* pattern = font_set->fonts[i];
-      if (GetFilename(pattern) == path.value())
-        return pango_fc_font_description_from_pattern(pattern, FALSE);
+      if (GetFilename(pattern) == path.value()) {
+        PangoFontDescription* desc =
+            pango_fc_font_description_from_pattern(pattern, FALSE);
+        (*loaded_fonts)[path] = pango_font_description_copy(desc);
+        return desc;
+      }
     }
   }
-  return GetDefaultFontDescription();
+  return nullptr;
 }
 
 }  // namespace
@@ -55,12 +71,23 @@ Font::Font(const std::string& name, float size, Weight weight, Style style)
     pango_font_description_set_style(font_, PANGO_STYLE_ITALIC);
 }
 
-Font::Font(const base::FilePath& path, float size)
-    : font_(FontDescriptionFromPath(path)) {
+Font::Font(const base::FilePath& path, float size) {
+  if (!ReadFromPath(path, size)) {
+    font_ = GetDefaultFontDescription();
+    pango_font_description_set_absolute_size(font_, size * PANGO_SCALE);
+  }
+}
+
+bool Font::ReadFromPath(const base::FilePath& path, float size) {
+  font_ = FontDescriptionFromPath(path);
+  if (!font_)
+    return false;
   pango_font_description_set_absolute_size(font_, size * PANGO_SCALE);
+  return true;
 }
 
 Font::~Font() {
+  RemoveFromCache();
   pango_font_description_free(font_);
 }
 
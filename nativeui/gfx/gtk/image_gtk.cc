@@ -6,6 +6,10 @@
 
 #include <gtk/gtk.h>
 
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+
 namespace nu {
 
 namespace {
@@ -19,6 +23,23 @@ NativeImage CreateEmptyImage() {
   return GDK_PIXBUF_ANIMATION(image);
 }
 
+// Wrap |pixbuf| as a static image.
+NativeImage CreateStaticImage(GdkPixbuf* pixbuf) {
+  GdkPixbufSimpleAnim* anim = gdk_pixbuf_simple_anim_new(
+      gdk_pixbuf_get_width(pixbuf), gdk_pixbuf_get_height(pixbuf), 1.f);
+  gdk_pixbuf_simple_anim_add_frame(anim, pixbuf);
+  return GDK_PIXBUF_ANIMATION(anim);
+}
+
+// Scale the image down while decoding, which is much faster than scaling after
+// decoding for formats like JPEG.
+void OnSizePrepared(GdkPixbufLoader* loader, int width, int height,
+                    const SizeF* max_size) {
+  SizeF size = Image::GetDecodeSize(SizeF(width, height), *max_size);
+  if (size.width() != width || size.height() != height)
+    gdk_pixbuf_loader_set_size(loader, size.width(), size.height());
+}
+
 }  // namespace
 
 Image::Image() : image_(CreateEmptyImage()), is_empty_(true) {}
@@ -51,6 +72,50 @@ Image::~Image() {
   g_object_unref(image_);
   if (iter_)
     g_object_unref(iter_);
+  if (surface_)
+    cairo_surface_destroy(surface_);
+}
+
+// static
+NativeImage Image::PlatformDecode(const std::string& data,
+                                  const SizeF& max_size,
+                                  float scale_factor) {
+  GdkPixbufLoader* loader = gdk_pixbuf_loader_new();
+  g_signal_connect(loader, "size-prepared", G_CALLBACK(OnSizePrepared),
+                   const_cast<SizeF*>(&max_size));
+  bool success =
+      gdk_pixbuf_loader_write(loader,
+                              reinterpret_cast<const guchar*>(data.data()),
+                              data.size(), nullptr) &&
+      gdk_pixbuf_loader_close(loader, nullptr);
+  GdkPixbuf* pixbuf = success ? gdk_pixbuf_loader_get_pixbuf(loader) : nullptr;
+  NativeImage image = nullptr;
+  if (pixbuf) {
+    // Wrap the first frame as a static image.
+    image = CreateStaticImage(pixbuf);
+  } else if (!success) {
+    gdk_pixbuf_loader_close(loader, nullptr);
+  }
+  g_object_unref(loader);
+  return image;
+}
+
+NativeImage Image::PlatformResize(const SizeF& size,
+                                  ImageQuality quality) const {
+  GdkInterpType interp = GDK_INTERP_HYPER;
+  if (quality == ImageQuality::Low)
+    interp = GDK_INTERP_NEAREST;
+  else if (quality == ImageQuality::Medium)
+    interp = GDK_INTERP_BILINEAR;
+  GdkPixbuf* frame = iter_ ? gdk_pixbuf_animation_iter_get_pixbuf(iter_)
+                           : gdk_pixbuf_animation_get_static_image(image_);
+  GdkPixbuf* pixbuf = gdk_pixbuf_scale_simple(
+      frame, size.width(), size.height(), interp);
+  if (!pixbuf)
+    return nullptr;
+  NativeImage image = CreateStaticImage(pixbuf);
+  g_object_unref(pixbuf);
+  return image;
 }
 
 bool Image::IsEmpty() const {
@@ -65,20 +130,63 @@ SizeF Image::GetSize() const {
                    1.f / scale_factor_);
 }
 
-bool Image::WriteToFile(const std::string& format,
-                        const base::FilePath& target) {
-  GdkPixbuf* pixbuf = gdk_pixbuf_animation_get_static_image(image_);
-  return gdk_pixbuf_save(pixbuf, target.value().c_str(), format.c_str(),
-                         nullptr, nullptr);
+// static
+bool Image::PlatformEncode(const void* pixels,
+                           const Size& size,
+                           int stride,
+                           const std::string& format,
+                           const EncodeOptions& options,
+                           std::string* output) {
+  // Unpremultiply the pixels by converting them into a pixbuf.
+  cairo_surface_t* surface = cairo_image_surface_create_for_data(
+      static_cast<unsigned char*>(const_cast<void*>(pixels)),
+      CAIRO_FORMAT_ARGB32, size.width(), size.height(), stride);
+  GdkPixbuf* pixbuf = gdk_pixbuf_get_from_surface(
+      surface, 0, 0, size.width(), size.height());
+  cairo_surface_destroy(surface);
+  if (!pixbuf)
+    return false;
+  gchar* buffer = nullptr;
+  gsize buffer_size = 0;
+  bool success;
+  if (format == "jpeg") {
+    std::string quality = base::NumberToString(options.quality);
+    success = gdk_pixbuf_save_to_buffer(pixbuf, &buffer, &buffer_size,
+                                        "jpeg", nullptr,
+                                        "quality", quality.c_str(), nullptr);
+  } else if (format == "png") {
+    success = gdk_pixbuf_save_to_buffer(pixbuf, &buffer, &buffer_size,
+                                        "png", nullptr, nullptr);
+  } else {
+    success = false;
+  }
+  g_object_unref(pixbuf);
+  if (success)
+    output->assign(buffer, buffer_size);
+  g_free(buffer);
+  return success;
+}
+
+cairo_surface_t* Image::GetCairoSurface() const {
+  if (!surface_) {
+    GdkPixbuf* pixbuf = gdk_pixbuf_animation_get_static_image(image_);
+    surface_ = gdk_cairo_surface_create_from_pixbuf(pixbuf, 1, nullptr);
+  }
+  return surface_;
+}
+
+bool Image::IsAnimated() const {
+  return !gdk_pixbuf_animation_is_static_image(image_);
 }
 
-void Image::AdvanceFrame() {
+int Image::AdvanceFrame() {
   GTimeVal time;
   g_get_current_time(&time);
   if (iter_)
     gdk_pixbuf_animation_iter_advance(iter_, &time);
   else
     iter_ = gdk_pixbuf_animation_get_iter(image_, &time);
+  return gdk_pixbuf_animation_iter_get_delay_time(iter_);
 }
 
 }  // namespace nu
@@ -16,6 +16,7 @@
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
 
 namespace nu {
 
@@ -130,6 +131,14 @@ void PainterGtk::Fill() {
   cairo_fill(context_);
 }
 
+void PainterGtk::StrokePath(Path* path) {
+  DrawPath(path, true);
+}
+
+void PainterGtk::FillPath(Path* path) {
+  DrawPath(path, false);
+}
+
 void PainterGtk::Clear() {
   cairo_save(context_);
   cairo_set_operator(context_, CAIRO_OPERATOR_CLEAR);
@@ -157,7 +166,9 @@ void PainterGtk::DrawImage(const Image* image, const RectF& rect) {
 
 void PainterGtk::DrawImageFromRect(const Image* image, const RectF& src,
                                    const RectF& dest) {
-  RectF ps = ScaleRect(src, image->GetScaleFactor());
+  RectF level_src(src);
+  image = image->GetMipmapFor(dest, &level_src);
+  RectF ps = ScaleRect(level_src, image->GetScaleFactor());
   cairo_save(context_);
   // Clip the image to |dest|.
   cairo_translate(context_, dest.x(), dest.y());
@@ -169,12 +180,14 @@ void PainterGtk::DrawImageFromRect(const Image* image, const RectF& src,
   float y_scale = dest.height() / ps.height();
   if (x_scale != 1.0f || y_scale != 1.0f)
     cairo_scale(context_, x_scale, y_scale);
-  // Choose the correct image.
-  GdkPixbuf* pixbuf = image->iter() ?
-      gdk_pixbuf_animation_iter_get_pixbuf(image->iter()) :
-      gdk_pixbuf_animation_get_static_image(image->GetNative());
-  // Draw.
-  gdk_cairo_set_source_pixbuf(context_, pixbuf, -ps.x(), -ps.y());
+  // Draw current frame for animations, otherwise use the cached surface.
+  if (image->iter()) {
+    GdkPixbuf* pixbuf = gdk_pixbuf_animation_iter_get_pixbuf(image->iter());
+    gdk_cairo_set_source_pixbuf(context_, pixbuf, -ps.x(), -ps.y());
+  } else {
+    cairo_set_source_surface(context_, image->GetCairoSurface(),
+                             -ps.x(), -ps.y());
+  }
   cairo_paint(context_);
   cairo_restore(context_);
 }
@@ -236,6 +249,19 @@ void PainterGtk::SetSourceColor(bool stroke) {
                                   color.b() / 255., color.a() / 255.);
 }
 
+void PainterGtk::DrawPath(Path* path, bool stroke) {
+  cairo_path_t* current = cairo_copy_path(context_);
+  cairo_new_path(context_);
+  cairo_append_path(context_, path->GetNative());
+  SetSourceColor(stroke);
+  if (stroke)
+    cairo_stroke(context_);
+  else
+    cairo_fill(context_);
+  cairo_append_path(context_, current);
+  cairo_path_destroy(current);
+}
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GFX_GTK_PAINTER_GTK_CC_
@@ -21,6 +21,9 @@ class PainterGtk : public Painter {
   // PainterGtk should be created on stack for best performance.
   ~PainterGtk() override;
 
+  // Internal: Return the cairo context.
+  cairo_t* context() const { return context_; }
+
   // Painter:
   void Save() override;
   void Restore() override;
@@ -44,6 +47,8 @@ class PainterGtk : public Painter {
   void SetLineWidth(float width) override;
   void Stroke() override;
   void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
   void Clear() override;
   void StrokeRect(const RectF& rect) override;
   void FillRect(const RectF& rect) override;
@@ -63,6 +68,9 @@ class PainterGtk : public Painter {
   // Set source color from stroke or fill color.
   void SetSourceColor(bool stroke);
 
+  // Stroke or fill |path| while keeping current path.
+  void DrawPath(Path* path, bool stroke);
+
   // Cairo does not distinguish between stroke color and fill color, we have to
   // implement our own.
   struct PainterState {
@@ -0,0 +1,32 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#include <cairo.h>
+
+#include "nativeui/gfx/gtk/painter_gtk.h"
+
+namespace nu {
+
+NativePath Path::PlatformCreate() const {
+  // Cairo paths can only be built in a context, use a tiny surface to build
+  // the path with the same calls of PainterGtk.
+  cairo_surface_t* surface = cairo_image_surface_create(CAIRO_FORMAT_A8, 1, 1);
+  cairo_path_t* path;
+  {
+    PainterGtk painter(surface, SizeF(1, 1), 1.f);
+    AddTo(&painter);
+    path = cairo_copy_path(painter.context());
+  }
+  cairo_surface_destroy(surface);
+  return path;
+}
+
+// static
+void Path::PlatformDestroy(NativePath path) {
+  cairo_path_destroy(path);
+}
+
+}  // namespace nu
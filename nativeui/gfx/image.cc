@@ -4,9 +4,23 @@
 
 #include "nativeui/gfx/image.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/painter.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/state.h"
+#include "nativeui/util/worker_pool.h"
 
 namespace nu {
 
@@ -32,10 +46,257 @@ ScaleFactorPair kScaleFactorPairs[] = {
   { FILE_PATH_LITERAL("@2.5x")  , 2.5f },
 };
 
+// Images are rarely drawn smaller than 1/256 of their sizes.
+const size_t kMaxMipmapLevels = 8;
+
 }  // namespace
 
+struct Image::DecodeJob {
+  DecodeJob(const DecodeOptions& options, float scale_factor)
+      : options(options), scale_factor(scale_factor) {}
+
+  // Can be called in any thread.
+  void Decode() {
+    if (!path.empty()) {
+      if (!base::ReadFileToString(path, &data))
+        data.clear();
+    }
+    SizeF max_size;
+    if (!options.size.IsEmpty())
+      max_size = ScaleSize(options.size, scale_factor);
+    if (!data.empty())
+      result = PlatformDecode(data, max_size, scale_factor);
+  }
+
+  // Wrap the decoded native image, must be called in the main thread.
+  scoped_refptr<Image> TakeImage() {
+    if (!result)
+      return nullptr;
+    scoped_refptr<Image> image = new Image(result);
+    image->scale_factor_ = scale_factor;
+    result = nullptr;
+    return image;
+  }
+
+  // Called in worker threads.
+  void Run() {
+    Decode();
+    MessageLoop::PostTask([this]() { Finish(); });
+  }
+
+  // Pass the image to callback in the main thread.
+  void Finish() {
+    std::unique_ptr<DecodeJob> auto_delete(this);
+    scoped_refptr<Image> image = TakeImage();
+    // The state has been destroyed.
+    if (State::GetCurrent() && callback)
+      callback(std::move(image));
+  }
+
+  base::FilePath path;
+  std::string data;
+  DecodeOptions options;
+  float scale_factor;
+  DecodeCallback callback;
+  NativeImage result = nullptr;
+};
+
+// Images are encoded from a copy of pixels, so the image can still be used
+// in the main thread.
+struct Image::EncodeJob {
+  EncodeJob(const std::string& format, const EncodeOptions& options)
+      : format(format), options(options) {}
+
+  // Copy the pixels of current frame, must be called in the main thread.
+  void CopyPixels(const Image* image) {
+    if (image->IsEmpty())
+      return;
+    scoped_refptr<Canvas> canvas =
+        new Canvas(image->GetSize(), image->GetScaleFactor());
+    canvas->GetPainter()->DrawImage(image, RectF(image->GetSize()));
+    CopyPixels(canvas->LockPixels());
+    canvas->UnlockPixels();
+  }
+  void CopyPixels(const CanvasPixels& source) {
+    pixels.assign(static_cast<const char*>(source.buffer.content()),
+                  source.buffer.size());
+    size = source.size;
+    stride = source.stride;
+  }
+
+  // Can be called in any thread.
+  void Encode() {
+    if (pixels.empty() ||
+        !PlatformEncode(pixels.data(), size, stride, format, options, &result))
+      result.clear();
+  }
+
+  // Called in worker threads.
+  void Run() {
+    Encode();
+    MessageLoop::PostTask([this]() { Finish(); });
+  }
+
+  // Pass the encoded data to callback in the main thread.
+  void Finish() {
+    std::unique_ptr<EncodeJob> auto_delete(this);
+    // The state has been destroyed.
+    if (!State::GetCurrent() || !callback)
+      return;
+    if (result.empty()) {
+      callback(Buffer());
+      return;
+    }
+    std::string* data = new std::string(std::move(result));
+    callback(Buffer::TakeOver(&(*data)[0], data->size(),
+                              [data](void*) { delete data; }));
+  }
+
+  std::string format;
+  EncodeOptions options;
+  EncodeCallback callback;
+  std::string pixels;
+  Size size;
+  int stride = 0;
+  std::string result;
+};
+
 Image::Image(NativeImage image) : image_(image) {}
 
+// static
+scoped_refptr<Image> Image::Decode(const base::FilePath& path,
+                                   const DecodeOptions& options) {
+  DecodeJob job(options, options.scale_factor > 0 ?
+      options.scale_factor : GetScaleFactorFromFilePath(path));
+  job.path = path;
+  job.Decode();
+  return job.TakeImage();
+}
+
+// static
+void Image::DecodeAsync(const base::FilePath& path,
+                        const DecodeOptions& options,
+                        DecodeCallback callback) {
+  DecodeJob* job = new DecodeJob(options, options.scale_factor > 0 ?
+      options.scale_factor : GetScaleFactorFromFilePath(path));
+  job->path = path;
+  job->callback = std::move(callback);
+  WorkerPool::PostTask([job]() { job->Run(); });
+}
+
+// static
+void Image::DecodeAsync(const Buffer& buffer,
+                        const DecodeOptions& options,
+                        DecodeCallback callback) {
+  DecodeJob* job = new DecodeJob(options, options.scale_factor > 0 ?
+      options.scale_factor : 1.f);
+  // The buffer from language bindings is only valid in current call.
+  job->data.assign(static_cast<const char*>(buffer.content()), buffer.size());
+  job->callback = std::move(callback);
+  WorkerPool::PostTask([job]() { job->Run(); });
+}
+
+void Image::EncodeAsync(const std::string& format,
+                        const EncodeOptions& options,
+                        EncodeCallback callback) const {
+  EncodeJob* job = new EncodeJob(format, options);
+  job->CopyPixels(this);
+  job->callback = std::move(callback);
+  // Encoding shares the threads with decoding.
+  WorkerPool::PostTask([job]() { job->Run(); });
+}
+
+// static
+void Image::EncodePixelsAsync(const CanvasPixels& pixels,
+                              const std::string& format,
+                              const EncodeOptions& options,
+                              EncodeCallback callback) {
+  EncodeJob* job = new EncodeJob(format, options);
+  job->CopyPixels(pixels);
+  job->callback = std::move(callback);
+  WorkerPool::PostTask([job]() { job->Run(); });
+}
+
+bool Image::WriteToFile(const std::string& format,
+                        const base::FilePath& target) {
+  EncodeJob job(format, EncodeOptions());
+  job.CopyPixels(this);
+  job.Encode();
+  if (job.result.empty())
+    return false;
+  int size = static_cast<int>(job.result.size());
+  return base::WriteFile(target, job.result.data(), size) == size;
+}
+
+scoped_refptr<Image> Image::CreateResized(const SizeF& size,
+                                          ImageQuality quality) const {
+  SizeF pixel_size(std::round(size.width() * scale_factor_),
+                   std::round(size.height() * scale_factor_));
+  NativeImage resized = nullptr;
+  if (!IsEmpty() && !pixel_size.IsEmpty())
+    resized = PlatformResize(pixel_size, quality);
+  if (!resized)
+    return new Image;
+  scoped_refptr<Image> image = new Image(resized);
+  image->scale_factor_ = scale_factor_;
+  return image;
+}
+
+void Image::SetMipmapEnabled(bool enabled) {
+  mipmap_enabled_ = enabled;
+  if (!enabled)
+    mipmaps_.clear();
+}
+
+const Image* Image::GetMipmapFor(const RectF& dest, RectF* src) const {
+  if (!mipmap_enabled_ || IsEmpty() || IsAnimated())
+    return this;
+  SizeF size = GetSize();
+  SizeF src_size = src ? src->size() : size;
+  if (src_size.IsEmpty())
+    return this;
+  // Use the smallest level that still has enough pixels for both dimensions,
+  // so the image is never upscaled from a level.
+  float ratio = std::max(dest.width() / src_size.width(),
+                         dest.height() / src_size.height());
+  size_t level = 0;
+  SizeF pixel_size = ScaleSize(size, scale_factor_);
+  while (ratio <= 0.5f && level < kMaxMipmapLevels &&
+         pixel_size.width() > 1.f && pixel_size.height() > 1.f) {
+    pixel_size.SetSize(std::ceil(pixel_size.width() / 2),
+                       std::ceil(pixel_size.height() / 2));
+    ratio *= 2;
+    ++level;
+  }
+  if (level == 0)
+    return this;
+  if (mipmaps_.size() < level)
+    mipmaps_.resize(level);
+  scoped_refptr<Image>& mipmap = mipmaps_[level - 1];
+  if (!mipmap)
+    mipmap = CreateResized(ScaleSize(pixel_size, 1.f / scale_factor_),
+                           ImageQuality::High);
+  if (mipmap->IsEmpty())
+    return this;
+  if (src) {
+    SizeF mipmap_size = mipmap->GetSize();
+    src->Scale(mipmap_size.width() / size.width(),
+               mipmap_size.height() / size.height());
+  }
+  return mipmap.get();
+}
+
+// static
+SizeF Image::GetDecodeSize(const SizeF& size, const SizeF& max_size) {
+  if (max_size.IsEmpty() || size.IsEmpty())
+    return size;
+  float scale = std::min({max_size.width() / size.width(),
+                          max_size.height() / size.height(),
+                          1.f});
+  return SizeF(std::max(1.f, std::round(size.width() * scale)),
+               std::max(1.f, std::round(size.height() * scale)));
+}
+
 // static
 float Image::GetScaleFactorFromFilePath(const base::FilePath& path) {
   base::FilePath::StringType name(path.BaseName().RemoveExtension().value());
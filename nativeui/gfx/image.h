@@ -5,21 +5,33 @@
 #ifndef NATIVEUI_GFX_IMAGE_H_
 #define NATIVEUI_GFX_IMAGE_H_
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "nativeui/buffer.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/gfx/geometry/size.h"
 #include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/memory_report.h"
+#include "nativeui/standard_enums.h"
 #include "nativeui/types.h"
 
 #if defined(OS_WIN)
+#include <d2d1.h>
+#include <wrl/client.h>
+
 #include "base/win/scoped_gdi_object.h"
 #endif
 
 #if defined(OS_MACOSX)
 #include <ImageIO/ImageIO.h>
+
+#include "base/mac/scoped_cftyperef.h"
 #endif
 
 #if defined(OS_LINUX)
@@ -28,6 +40,8 @@ typedef struct _GdkPixbufAnimationIter GdkPixbufAnimationIter;
 
 namespace nu {
 
+struct CanvasPixels;
+
 class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
  public:
   // Create an empty image.
@@ -43,6 +57,51 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
   // Create an image from memory.
   Image(const Buffer& buffer, float scale_factor);
 
+  // Options for decoding images in background.
+  struct DecodeOptions {
+    // Downsample the image to fit in |size| while decoding, the aspect ratio
+    // is kept and images are never upscaled. Empty size means no resizing.
+    SizeF size;
+    // The scale factor of decoded image, 0 means reading from the @2x suffix
+    // of file name, or 1 for buffers.
+    float scale_factor = 0;
+  };
+
+  // Decode the image in current thread, returns nullptr on failure.
+  static scoped_refptr<Image> Decode(const base::FilePath& path,
+                                     const DecodeOptions& options);
+
+  // Decode the image in worker threads, and pass the decoded image to the
+  // |callback| in main thread, or nullptr on failure. Only the first frame
+  // of animated images is decoded.
+  using DecodeCallback = std::function<void(scoped_refptr<Image>)>;
+  static void DecodeAsync(const base::FilePath& path,
+                          const DecodeOptions& options,
+                          DecodeCallback callback);
+  static void DecodeAsync(const Buffer& buffer,
+                          const DecodeOptions& options,
+                          DecodeCallback callback);
+
+  // Options for encoding images.
+  struct EncodeOptions {
+    // The quality of lossy formats like JPEG, from 0 to 100.
+    int quality = 90;
+  };
+
+  // Encode current frame of the image in worker threads, and pass the encoded
+  // data to |callback| in main thread, or an empty buffer on failure. The
+  // |format| can be "png" or "jpeg".
+  using EncodeCallback = std::function<void(Buffer)>;
+  void EncodeAsync(const std::string& format,
+                   const EncodeOptions& options,
+                   EncodeCallback callback) const;
+
+  // Internal: Encode a copy of |pixels| in worker threads.
+  static void EncodePixelsAsync(const CanvasPixels& pixels,
+                                const std::string& format,
+                                const EncodeOptions& options,
+                                EncodeCallback callback);
+
   // Whether the image is empty.
   bool IsEmpty() const;
 
@@ -52,33 +111,77 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
   // Get the scale factor of image.
   float GetScaleFactor() const { return scale_factor_; }
 
-  // Write the image to file.
-  // Note: Do not make it a public API for now, we need to figure out a
-  // universal type conversion API with options first.
+  // Return a copy of the image resized to |size| in DIPs, keeping the scale
+  // factor. Animated images are resized to a static image of current frame.
+  scoped_refptr<Image> CreateResized(const SizeF& size,
+                                     ImageQuality quality) const;
+
+  // Draw the image from pre-scaled levels when it is drawn at half of its
+  // size or smaller, the levels are created when firstly needed.
+  void SetMipmapEnabled(bool enabled);
+  bool IsMipmapEnabled() const { return mipmap_enabled_; }
+
+  // Internal: Return the image to draw when drawing |src| into |dest|, which
+  // is a mipmap level or the image itself, and convert |src| to the
+  // coordinates of the returned image. Null |src| means the whole image.
+  const Image* GetMipmapFor(const RectF& dest, RectF* src) const;
+
+  // Write current frame of the image to file in current thread.
   // Note: Should we add API for saving animations?
   bool WriteToFile(const std::string& format, const base::FilePath& target);
 
+  // Internal: Return the pixel |size| scaled down to fit in |max_size| for
+  // decoding, empty |max_size| means no scaling.
+  static SizeF GetDecodeSize(const SizeF& size, const SizeF& max_size);
+
   // Return the native instance of image object.
   NativeImage GetNative() const { return image_; }
 
+  // Internal: Whether the image has animation frames.
+  bool IsAnimated() const;
+
+  // Internal: Show next animation frame, and return how long in milliseconds
+  // the frame should be shown. The first call shows the first frame.
+  int AdvanceFrame();
+
 #if defined(OS_WIN)
   base::win::ScopedHICON GetHICON(const SizeF& size) const;
+
+  // Internal: Return a premultiplied copy of current frame, which GDI+ can
+  // draw without decoding or converting pixel formats again. Each frame of
+  // animated images is only decoded once.
+  Gdiplus::Bitmap* GetCachedBitmap() const;
+
+  // Internal: Return a device-dependent bitmap for |graphics|, which can only
+  // be drawn without scaling. Returns nullptr if not available.
+  Gdiplus::CachedBitmap* GetDeviceBitmap(Gdiplus::Graphics* graphics) const;
+
+  // Internal: Drop the device-dependent bitmap after it failed to draw.
+  void ResetDeviceBitmap() const;
+
+  // Internal: Return the Direct2D bitmap of current frame for |target|, which
+  // is cached until the image is drawn by another target. Returns nullptr if
+  // not available.
+  ID2D1Bitmap* GetDirect2DBitmap(ID2D1RenderTarget* target) const;
 #endif
 
 #if defined(OS_MACOSX)
   // Internal: Return the image representaion that has animations.
   NSBitmapImageRep* GetAnimationRep() const;
 
-  // Internal: Get the duration of animations.
-  float GetAnimationDuration(int index) const;
+  // Internal: Return a premultiplied bitmap of the image for |scale_factor|,
+  // which is cached so drawing it does not need decoding again. Returns
+  // nullptr for animated images.
+  CGImageRef GetCGImage(float scale_factor) const;
 #endif
 
 #if defined(OS_LINUX)
-  // Internal: Advance the frame iter.
-  void AdvanceFrame();
-
   // Internal: Return current animation frame.
   GdkPixbufAnimationIter* iter() const { return iter_; }
+
+  // Internal: Return a cached cairo surface of the static image, which is
+  // faster to draw than converting the pixbuf each time.
+  cairo_surface_t* GetCairoSurface() const;
 #endif
 
  protected:
@@ -87,20 +190,71 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
  private:
   friend class base::RefCounted<Image>;
 
+  struct DecodeJob;
+  struct EncodeJob;
+
   static float GetScaleFactorFromFilePath(const base::FilePath& path);
 
+  // Decode the first frame of encoded |data| into a static image that fits in
+  // |max_size| pixels, returns nullptr on failure. Called in worker threads.
+  static NativeImage PlatformDecode(const std::string& data,
+                                    const SizeF& max_size,
+                                    float scale_factor);
+
+  // Draw current frame into a new static image of |size| pixels.
+  NativeImage PlatformResize(const SizeF& size, ImageQuality quality) const;
+
+  // Encode the premultiplied BGRA |pixels| into |output|, returns false on
+  // failure. Called in worker threads.
+  static bool PlatformEncode(const void* pixels,
+                             const Size& size,
+                             int stride,
+                             const std::string& format,
+                             const EncodeOptions& options,
+                             std::string* output);
+
   float scale_factor_ = 1.f;
   NativeImage image_;
 
+  // The levels of mipmap, each is the half size of previous one.
+  bool mipmap_enabled_ = false;
+  mutable std::vector<scoped_refptr<Image>> mipmaps_;
+
 #if defined(OS_LINUX)
   // GTK does not have concept of empty image.
   bool is_empty_ = false;
   // The animation frame.
   GdkPixbufAnimationIter* iter_ = nullptr;
+  // The cached surface of static image.
+  mutable cairo_surface_t* surface_ = nullptr;
 #elif defined(OS_MACOSX)
   // The frame durations.
   std::vector<float> durations_;
+  // The shown animation frame, -1 before the animation starts.
+  int frame_ = -1;
+  // The cached bitmaps for each scale factor.
+  mutable std::map<float, base::ScopedCFTypeRef<CGImageRef>> cg_images_;
+#elif defined(OS_WIN)
+  // Read the frames information.
+  void InitFrames() const;
+
+  UINT GetActiveFrame() const { return frame_ < 0 ? 0 : frame_; }
+
+  // The shown animation frame, -1 before the animation starts.
+  int frame_ = -1;
+  // The delays of frames in milliseconds, and the cached bitmaps of each frame
+  // which are created lazily.
+  mutable bool frames_checked_ = false;
+  mutable std::vector<int> frame_delays_;
+  mutable std::vector<std::unique_ptr<Gdiplus::Bitmap>> cached_bitmaps_;
+  mutable std::vector<std::unique_ptr<Gdiplus::CachedBitmap>> device_bitmaps_;
+  // The Direct2D bitmaps of each frame, and the render target creating them.
+  mutable Microsoft::WRL::ComPtr<ID2D1RenderTarget> d2d_target_;
+  mutable std::vector<Microsoft::WRL::ComPtr<ID2D1Bitmap>> d2d_bitmaps_;
 #endif
+
+  // Counts the image in memory reports.
+  LiveObjectTracker live_object_{LiveObjectType::Image, this};
 };
 
 }  // namespace nu
@@ -0,0 +1,124 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/image_cache.h"
+
+#include <utility>
+
+#include "nativeui/message_loop.h"
+#include "nativeui/state.h"
+
+namespace nu {
+
+namespace {
+
+// Decoded images are stored as 32-bit pixels.
+size_t GetImageBytes(Image* image) {
+  SizeF size = ScaleSize(image->GetSize(), image->GetScaleFactor());
+  return static_cast<size_t>(size.width()) *
+         static_cast<size_t>(size.height()) * 4;
+}
+
+}  // namespace
+
+// static
+ImageCache* ImageCache::GetCurrent() {
+  return State::GetCurrent()->GetImageCache();
+}
+
+ImageCache::ImageCache()
+    : cache_(base::MRUCache<Key, Entry>::NO_AUTO_EVICT),
+      weak_factory_(this) {}
+
+ImageCache::~ImageCache() {}
+
+scoped_refptr<Image> ImageCache::Get(const base::FilePath& path,
+                                     const Image::DecodeOptions& options) {
+  Key key = GetKey(path, options);
+  auto it = cache_.Get(key);
+  if (it != cache_.end())
+    return it->second.image;
+  scoped_refptr<Image> image;
+  if (options.size.IsEmpty() && options.scale_factor == 0) {
+    // Read with the full image constructor to keep animations and template
+    // images.
+    image = new Image(path);
+  } else {
+    image = Image::Decode(path, options);
+    if (!image)
+      return new Image;
+  }
+  if (!image->IsEmpty())
+    Put(key, image);
+  return image;
+}
+
+void ImageCache::GetAsync(const base::FilePath& path,
+                          const Image::DecodeOptions& options,
+                          Image::DecodeCallback callback) {
+  Key key = GetKey(path, options);
+  auto it = cache_.Get(key);
+  if (it != cache_.end()) {
+    scoped_refptr<Image> image = it->second.image;
+    MessageLoop::PostTask([image, callback]() {
+      if (callback)
+        callback(image);
+    });
+    return;
+  }
+  base::WeakPtr<ImageCache> weak_ptr = GetWeakPtr();
+  Image::DecodeAsync(path, options,
+                     [weak_ptr, key, callback](scoped_refptr<Image> image) {
+    if (weak_ptr && image)
+      weak_ptr->Put(key, image);
+    if (callback)
+      callback(std::move(image));
+  });
+}
+
+void ImageCache::SetBudget(size_t bytes) {
+  budget_ = bytes;
+  EvictTo(budget_);
+}
+
+void ImageCache::OnMemoryPressure(bool critical) {
+  EvictTo(critical ? 0 : usage_ / 2);
+}
+
+void ImageCache::Clear() {
+  cache_.Clear();
+  usage_ = 0;
+}
+
+// static
+ImageCache::Key ImageCache::GetKey(const base::FilePath& path,
+                                   const Image::DecodeOptions& options) {
+  return Key(path.value(), options.size.width(), options.size.height(),
+             options.scale_factor);
+}
+
+void ImageCache::Put(const Key& key, scoped_refptr<Image> image) {
+  size_t bytes = GetImageBytes(image.get());
+  // Do not let one image flush the whole cache.
+  if (bytes > budget_)
+    return;
+  auto it = cache_.Peek(key);
+  if (it != cache_.end()) {
+    usage_ -= it->second.bytes;
+    cache_.Erase(it);
+  }
+  EvictTo(budget_ - bytes);
+  cache_.Put(key, Entry{std::move(image), bytes});
+  usage_ += bytes;
+}
+
+void ImageCache::EvictTo(size_t bytes) {
+  while (usage_ > bytes && !cache_.empty()) {
+    auto it = cache_.rbegin();
+    usage_ -= it->second.bytes;
+    cache_.Erase(it);
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,87 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_IMAGE_CACHE_H_
+#define NATIVEUI_GFX_IMAGE_CACHE_H_
+
+#include <tuple>
+
+#include "base/containers/mru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "nativeui/gfx/image.h"
+
+namespace nu {
+
+// Keeps the decoded images under a memory budget, so reading the same image
+// again returns the shared one. The least recently used images are evicted
+// when the budget is exceeded, or when system is low on memory.
+//
+// This class is managed by State.
+class NATIVEUI_EXPORT ImageCache {
+ public:
+  // Bytes of decoded pixels kept by default.
+  static const size_t kDefaultBudget = 64 * 1024 * 1024;
+
+  static ImageCache* GetCurrent();
+
+  ImageCache();
+  ~ImageCache();
+
+  // Return the image read from |path|, and downsampled when the size is set
+  // in |options|. The returned image is shared and must not be modified.
+  scoped_refptr<Image> Get(const base::FilePath& path,
+                           const Image::DecodeOptions& options);
+
+  // Like Get but the image is decoded in worker threads when not cached, the
+  // |callback| is called in the main thread.
+  void GetAsync(const base::FilePath& path,
+                const Image::DecodeOptions& options,
+                Image::DecodeCallback callback);
+
+  // Set the number of bytes of decoded pixels to keep, images are evicted
+  // immediately if the new budget is exceeded.
+  void SetBudget(size_t bytes);
+  size_t GetBudget() const { return budget_; }
+
+  // Return the bytes of decoded pixels in cache.
+  size_t GetUsage() const { return usage_; }
+
+  // Evict images when system is low on memory, half of the cache is released
+  // for moderate pressure and all for critical pressure. This is called by
+  // App::NotifyMemoryPressure.
+  void OnMemoryPressure(bool critical);
+
+  void Clear();
+  size_t size() const { return cache_.size(); }
+
+  base::WeakPtr<ImageCache> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
+
+ private:
+  using Key = std::tuple<base::FilePath::StringType, float, float, float>;
+
+  struct Entry {
+    scoped_refptr<Image> image;
+    size_t bytes;
+  };
+
+  static Key GetKey(const base::FilePath& path,
+                    const Image::DecodeOptions& options);
+
+  // Add |image| to cache and evict old images to fit in the budget.
+  void Put(const Key& key, scoped_refptr<Image> image);
+  void EvictTo(size_t bytes);
+
+  base::MRUCache<Key, Entry> cache_;
+  size_t budget_ = kDefaultBudget;
+  size_t usage_ = 0;
+
+  base::WeakPtrFactory<ImageCache> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_IMAGE_CACHE_H_
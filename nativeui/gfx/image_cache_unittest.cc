@@ -0,0 +1,103 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/files/file_path.h"
+#include "base/path_service.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ImageCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    base::FilePath exe_path;
+    base::PathService::Get(base::FILE_EXE, &exe_path);
+    base::FilePath dir = exe_path.DirName().DirName().DirName()
+                                 .Append(FILE_PATH_LITERAL("nativeui"))
+                                 .Append(FILE_PATH_LITERAL("test"))
+                                 .Append(FILE_PATH_LITERAL("fixtures"));
+    gif_ = dir.Append(FILE_PATH_LITERAL("animated.gif"));
+    png_ = dir.Append(FILE_PATH_LITERAL("static.png"));
+    cache_ = nu::ImageCache::GetCurrent();
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  nu::ImageCache* cache_;
+  base::FilePath gif_;
+  base::FilePath png_;
+};
+
+TEST_F(ImageCacheTest, SharedImage) {
+  scoped_refptr<nu::Image> image = cache_->Get(png_, {});
+  EXPECT_FALSE(image->IsEmpty());
+  EXPECT_EQ(cache_->Get(png_, {}), image);
+  EXPECT_EQ(cache_->size(), 1u);
+  EXPECT_EQ(cache_->GetUsage(), 4u);
+}
+
+TEST_F(ImageCacheTest, KeyedBySize) {
+  nu::Image::DecodeOptions options;
+  options.size = nu::SizeF(5, 5);
+  scoped_refptr<nu::Image> small = cache_->Get(gif_, options);
+  EXPECT_EQ(small->GetSize(), nu::SizeF(5, 5));
+  EXPECT_NE(cache_->Get(gif_, {}), small);
+  EXPECT_EQ(cache_->Get(gif_, options), small);
+  EXPECT_EQ(cache_->size(), 2u);
+}
+
+TEST_F(ImageCacheTest, FailedImageNotCached) {
+  scoped_refptr<nu::Image> image =
+      cache_->Get(base::FilePath(FILE_PATH_LITERAL("not_exist.png")), {});
+  EXPECT_TRUE(image->IsEmpty());
+  EXPECT_EQ(cache_->size(), 0u);
+}
+
+TEST_F(ImageCacheTest, EvictOverBudget) {
+  cache_->SetBudget(400);
+  cache_->Get(png_, {});
+  // The 10x10 image takes 400 bytes.
+  cache_->Get(gif_, {});
+  EXPECT_EQ(cache_->size(), 1u);
+  EXPECT_EQ(cache_->GetUsage(), 400u);
+  cache_->SetBudget(100);
+  EXPECT_EQ(cache_->size(), 0u);
+  EXPECT_EQ(cache_->GetUsage(), 0u);
+}
+
+TEST_F(ImageCacheTest, MemoryPressure) {
+  cache_->Get(gif_, {});
+  cache_->Get(png_, {});
+  // Evicting the least recently used image frees more than half.
+  cache_->OnMemoryPressure(false);
+  EXPECT_EQ(cache_->size(), 1u);
+  EXPECT_EQ(cache_->GetUsage(), 4u);
+  cache_->OnMemoryPressure(true);
+  EXPECT_EQ(cache_->size(), 0u);
+}
+
+TEST_F(ImageCacheTest, AppMemoryPressure) {
+  bool critical = false;
+  nu::App* app = nu::App::GetCurrent();
+  app->on_memory_pressure.Connect([&](nu::App* self, bool c) {
+    EXPECT_EQ(self, app);
+    critical = c;
+  });
+  cache_->Get(png_, {});
+  app->NotifyMemoryPressure(true);
+  EXPECT_TRUE(critical);
+  EXPECT_EQ(cache_->size(), 0u);
+}
+
+TEST_F(ImageCacheTest, GetAsync) {
+  nu::Image::DecodeOptions options;
+  options.size = nu::SizeF(5, 5);
+  scoped_refptr<nu::Image> result;
+  cache_->GetAsync(gif_, options, [&result](scoped_refptr<nu::Image> image) {
+    result = std::move(image);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  ASSERT_TRUE(result);
+  EXPECT_EQ(cache_->Get(gif_, options), result);
+}
@@ -0,0 +1,153 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/files/file_path.h"
+#include "base/path_service.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ImageTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    base::FilePath exe_path;
+    base::PathService::Get(base::FILE_EXE, &exe_path);
+    fixtures_ = exe_path.DirName().DirName().DirName()
+                        .Append(FILE_PATH_LITERAL("nativeui"))
+                        .Append(FILE_PATH_LITERAL("test"))
+                        .Append(FILE_PATH_LITERAL("fixtures"));
+  }
+
+  scoped_refptr<nu::Image> Decode(const base::FilePath& path,
+                                  const nu::Image::DecodeOptions& options) {
+    scoped_refptr<nu::Image> result;
+    nu::Image::DecodeAsync(path, options,
+                           [&result](scoped_refptr<nu::Image> image) {
+      result = std::move(image);
+      nu::MessageLoop::Quit();
+    });
+    nu::MessageLoop::Run();
+    return result;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  base::FilePath fixtures_;
+};
+
+TEST_F(ImageTest, DecodeAsync) {
+  scoped_refptr<nu::Image> image = Decode(
+      fixtures_.Append(FILE_PATH_LITERAL("animated.gif")),
+      nu::Image::DecodeOptions());
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(10, 10));
+  EXPECT_EQ(image->GetScaleFactor(), 1.f);
+}
+
+TEST_F(ImageTest, DecodeAsyncWithSize) {
+  nu::Image::DecodeOptions options;
+  options.size = nu::SizeF(5, 8);
+  scoped_refptr<nu::Image> image = Decode(
+      fixtures_.Append(FILE_PATH_LITERAL("animated.gif")), options);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(5, 5));
+  // Images are not upscaled.
+  options.size = nu::SizeF(20, 20);
+  image = Decode(fixtures_.Append(FILE_PATH_LITERAL("animated.gif")), options);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(10, 10));
+}
+
+TEST_F(ImageTest, DecodeAsyncWithScaleFactor) {
+  nu::Image::DecodeOptions options;
+  options.size = nu::SizeF(5, 5);
+  options.scale_factor = 2.f;
+  scoped_refptr<nu::Image> image = Decode(
+      fixtures_.Append(FILE_PATH_LITERAL("animated.gif")), options);
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetSize(), nu::SizeF(5, 5));
+  EXPECT_EQ(image->GetScaleFactor(), 2.f);
+}
+
+TEST_F(ImageTest, DecodeAsyncFailure) {
+  scoped_refptr<nu::Image> image = Decode(
+      base::FilePath(FILE_PATH_LITERAL("not_exist.png")),
+      nu::Image::DecodeOptions());
+  EXPECT_FALSE(image);
+}
+
+TEST_F(ImageTest, CreateResized) {
+  scoped_refptr<nu::Image> image = new nu::Image(
+      fixtures_.Append(FILE_PATH_LITERAL("animated.gif")));
+  scoped_refptr<nu::Image> resized =
+      image->CreateResized(nu::SizeF(5, 4), nu::ImageQuality::High);
+  ASSERT_FALSE(resized->IsEmpty());
+  EXPECT_EQ(resized->GetSize(), nu::SizeF(5, 4));
+  EXPECT_EQ(resized->GetScaleFactor(), image->GetScaleFactor());
+  EXPECT_FALSE(resized->IsAnimated());
+}
+
+TEST_F(ImageTest, Mipmap) {
+  scoped_refptr<nu::Image> image = Decode(
+      fixtures_.Append(FILE_PATH_LITERAL("animated.gif")),
+      nu::Image::DecodeOptions());
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->GetMipmapFor(nu::RectF(0, 0, 2, 2), nullptr), image.get());
+  image->SetMipmapEnabled(true);
+  // Drawing at more than half size uses the image itself.
+  EXPECT_EQ(image->GetMipmapFor(nu::RectF(0, 0, 6, 6), nullptr), image.get());
+  // Drawing at a quarter uses the second level, which is rounded up.
+  nu::RectF src(0, 0, 10, 10);
+  const nu::Image* level = image->GetMipmapFor(nu::RectF(0, 0, 2.5, 2.5), &src);
+  ASSERT_NE(level, image.get());
+  EXPECT_EQ(level->GetSize(), nu::SizeF(3, 3));
+  EXPECT_FLOAT_EQ(src.width(), 3);
+  EXPECT_FLOAT_EQ(src.height(), 3);
+}
+
+TEST_F(ImageTest, EncodeAsync) {
+  scoped_refptr<nu::Image> image = Decode(
+      fixtures_.Append(FILE_PATH_LITERAL("animated.gif")),
+      nu::Image::DecodeOptions());
+  ASSERT_TRUE(image);
+  for (const char* format : {"png", "jpeg"}) {
+    nu::Buffer result;
+    image->EncodeAsync(format, nu::Image::EncodeOptions(),
+                       [&result](nu::Buffer buffer) {
+      result = std::move(buffer);
+      nu::MessageLoop::Quit();
+    });
+    nu::MessageLoop::Run();
+    ASSERT_GT(result.size(), 0u);
+    // The encoded data can be decoded again.
+    scoped_refptr<nu::Image> decoded = new nu::Image(result, 1.f);
+    EXPECT_EQ(decoded->GetSize(), nu::SizeF(10, 10));
+  }
+}
+
+TEST_F(ImageTest, EncodeCanvasAsync) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 20), 2.f);
+  canvas->GetPainter()->FillRect(nu::RectF(0, 0, 5, 5));
+  nu::Buffer result;
+  canvas->EncodeAsync("png", nu::Image::EncodeOptions(),
+                      [&result](nu::Buffer buffer) {
+    result = std::move(buffer);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  scoped_refptr<nu::Image> decoded = new nu::Image(result, 2.f);
+  EXPECT_EQ(decoded->GetSize(), nu::SizeF(10, 20));
+}
+
+TEST_F(ImageTest, EncodeAsyncUnknownFormat) {
+  scoped_refptr<nu::Image> image = new nu::Image;
+  bool called = false;
+  image->EncodeAsync("unknown", nu::Image::EncodeOptions(),
+                     [&called](nu::Buffer buffer) {
+    called = true;
+    EXPECT_EQ(buffer.size(), 0u);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(called);
+}
@@ -6,6 +6,8 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <algorithm>
+
 #include "base/strings/sys_string_conversions.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/rect_f.h"
@@ -42,6 +44,7 @@ void AttributedText::PlatformSetFontFor(scoped_refptr<Font> font,
   if (start == 0 && end == -1) {
     [text_ removeAttribute:NSFontAttributeName
                      range:NSMakeRange(0, [text_ length])];
+    font_ = font;
   }
   [text_ addAttribute:NSFontAttributeName
                 value:font->GetNative()
@@ -52,13 +55,33 @@ void AttributedText::PlatformSetColorFor(Color color, int start, int end) {
   if (start == 0 && end == -1) {
     [text_ removeAttribute:NSForegroundColorAttributeName
                      range:NSMakeRange(0, [text_ length])];
+    color_ = color;
   }
   [text_ addAttribute:NSForegroundColorAttributeName
                 value:color.ToNSColor()
                 range:NSMakeRange(start, IndexToLength(text_, start, end))];
 }
 
-RectF AttributedText::GetBoundsFor(const SizeF& size) const {
+void AttributedText::PlatformReplaceText(int start, int end,
+                                         const std::string& text) {
+  int length = static_cast<int>([text_ length]);
+  start = std::min(start, length);
+  end = end > -1 ? std::min(end, length) : length;
+  bool was_empty = length == 0;
+  [text_ replaceCharactersInRange:NSMakeRange(start, end - start)
+                       withString:base::SysUTF8ToNSString(text)];
+  if (was_empty) {
+    PlatformSetFontFor(font_, 0, -1);
+    PlatformSetColorFor(color_, 0, -1);
+  }
+}
+
+void AttributedText::PlatformAppendText(const std::string& text) {
+  int length = static_cast<int>([text_ length]);
+  PlatformReplaceText(length, length, text);
+}
+
+RectF AttributedText::PlatformGetBoundsFor(const SizeF& size) const {
   int draw_options = 0;
   if (format_.wrap)
     draw_options |= NSStringDrawingUsesLineFragmentOrigin;
@@ -5,12 +5,41 @@
 #include "nativeui/gfx/canvas.h"
 
 #import <Cocoa/Cocoa.h>
+#include <CoreVideo/CoreVideo.h>
+#include <IOSurface/IOSurface.h>
+
+#include <algorithm>
 
 #include "base/mac/scoped_cftyperef.h"
 #include "nativeui/gfx/mac/painter_mac.h"
 
 namespace nu {
 
+namespace {
+
+// Called when the bitmap context backed by IOSurface is released.
+void ReleaseIOSurface(void* info, void* data) {
+  IOSurfaceRef surface = static_cast<IOSurfaceRef>(info);
+  IOSurfaceUnlock(surface, 0, nullptr);
+  CFRelease(surface);
+}
+
+}  // namespace
+
+CanvasPixels Canvas::LockPixels() {
+  CGContextFlush(bitmap_);
+  CanvasPixels pixels;
+  pixels.size = Size(CGBitmapContextGetWidth(bitmap_),
+                     CGBitmapContextGetHeight(bitmap_));
+  pixels.stride = CGBitmapContextGetBytesPerRow(bitmap_);
+  pixels.buffer = Buffer::Wrap(CGBitmapContextGetData(bitmap_),
+                               pixels.stride * pixels.size.height());
+  return pixels;
+}
+
+void Canvas::UnlockPixels() {
+}
+
 // static
 NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
                                           float scale_factor) {
@@ -27,6 +56,39 @@ NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
   return bitmap;
 }
 
+// static
+NativeBitmap Canvas::PlatformCreateSharedBitmap(const SizeF& size,
+                                                float scale_factor,
+                                                Window* window) {
+  // The bitmap context draws into the memory of IOSurface, which can be
+  // composited by the window server without copying.
+  int width = std::max(static_cast<int>(size.width() * scale_factor), 1);
+  int height = std::max(static_cast<int>(size.height() * scale_factor), 1);
+  NSDictionary* properties = @{
+    (id)kIOSurfaceWidth: @(width),
+    (id)kIOSurfaceHeight: @(height),
+    (id)kIOSurfaceBytesPerElement: @4,
+    (id)kIOSurfacePixelFormat: @(kCVPixelFormatType_32BGRA),
+  };
+  IOSurfaceRef surface = IOSurfaceCreate((CFDictionaryRef)properties);
+  if (!surface)
+    return PlatformCreateBitmap(size, scale_factor);
+  // Keep the surface locked for CPU access during the canvas's lifetime.
+  IOSurfaceLock(surface, 0, nullptr);
+  base::ScopedCFTypeRef<CGColorSpaceRef> color_space(
+        CGColorSpaceCreateDeviceRGB());
+  CGContextRef bitmap = CGBitmapContextCreateWithData(
+      IOSurfaceGetBaseAddress(surface), width, height, 8,
+      IOSurfaceGetBytesPerRow(surface), color_space,
+      kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst,
+      &ReleaseIOSurface, surface);
+  if (!bitmap) {
+    ReleaseIOSurface(surface, nullptr);
+    return PlatformCreateBitmap(size, scale_factor);
+  }
+  return bitmap;
+}
+
 // static
 void Canvas::PlatformDestroyBitmap(NativeBitmap bitmap) {
   CGContextRelease(bitmap);
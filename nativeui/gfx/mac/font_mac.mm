@@ -124,7 +124,7 @@ NSFont* NSFontFromPath(const base::FilePath& path, float size) {
   NSArray* descriptors_list = base::mac::CFToNSCast(descriptors);
   for (NSFontDescriptor* descriptor in descriptors_list)
     return [NSFont fontWithDescriptor:descriptor size:size];
-  return [NSFont systemFontOfSize:13];
+  return nil;
 }
 
 }  // namespace
@@ -136,10 +136,18 @@ Font::Font()
 Font::Font(const std::string& name, float size, Weight weight, Style style)
     : font_([NSFontWithSpec(name, size, weight, style) retain]) {}
 
-Font::Font(const base::FilePath& path, float size)
-    : font_([NSFontFromPath(path, size) retain]) {}
+Font::Font(const base::FilePath& path, float size) {
+  if (!ReadFromPath(path, size))
+    font_ = [[NSFont systemFontOfSize:13] retain];
+}
+
+bool Font::ReadFromPath(const base::FilePath& path, float size) {
+  font_ = [NSFontFromPath(path, size) retain];
+  return font_ != nil;
+}
 
 Font::~Font() {
+  RemoveFromCache();
   [font_ release];
 }
 
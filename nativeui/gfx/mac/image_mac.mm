@@ -6,6 +6,10 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+
 #include "base/mac/scoped_cftyperef.h"
 #include "base/strings/pattern.h"
 #include "base/strings/sys_string_conversions.h"
@@ -105,6 +109,96 @@ Image::~Image() {
   [image_ release];
 }
 
+// static
+NativeImage Image::PlatformDecode(const std::string& data,
+                                  const SizeF& max_size,
+                                  float scale_factor) {
+  base::ScopedCFTypeRef<CFDataRef> cfdata(CFDataCreateWithBytesNoCopy(
+      nullptr, reinterpret_cast<const UInt8*>(data.data()), data.size(),
+      kCFAllocatorNull));
+  base::ScopedCFTypeRef<CGImageSourceRef> source(
+      CGImageSourceCreateWithData(cfdata, nullptr));
+  if (!source || CGImageSourceGetCount(source) == 0)
+    return nil;
+  // Read the pixel size without decoding.
+  NSDictionary* properties = CFBridgingRelease(
+      CGImageSourceCopyPropertiesAtIndex(source, 0, nullptr));
+  SizeF size([[properties objectForKey:(__bridge NSString*)
+                  kCGImagePropertyPixelWidth] floatValue],
+             [[properties objectForKey:(__bridge NSString*)
+                  kCGImagePropertyPixelHeight] floatValue]);
+  SizeF decode_size = GetDecodeSize(size, max_size);
+  base::ScopedCFTypeRef<CGImageRef> cgimage;
+  if (decode_size != size) {
+    // The thumbnail is decoded at the target size directly.
+    NSDictionary* options = @{
+      (__bridge NSString*)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+      (__bridge NSString*)kCGImageSourceCreateThumbnailWithTransform: @YES,
+      (__bridge NSString*)kCGImageSourceShouldCacheImmediately: @YES,
+      (__bridge NSString*)kCGImageSourceThumbnailMaxPixelSize:
+          @(std::max(decode_size.width(), decode_size.height())),
+    };
+    cgimage.reset(CGImageSourceCreateThumbnailAtIndex(
+        source, 0, (__bridge CFDictionaryRef)options));
+  } else {
+    // Decode now instead of when the image is firstly drawn.
+    NSDictionary* options = @{
+      (__bridge NSString*)kCGImageSourceShouldCacheImmediately: @YES,
+    };
+    cgimage.reset(CGImageSourceCreateImageAtIndex(
+        source, 0, (__bridge CFDictionaryRef)options));
+  }
+  if (!cgimage)
+    return nil;
+  NSSize image_size = NSMakeSize(CGImageGetWidth(cgimage) / scale_factor,
+                                 CGImageGetHeight(cgimage) / scale_factor);
+  return [[NSImage alloc] initWithCGImage:cgimage size:image_size];
+}
+
+// static
+bool Image::PlatformEncode(const void* pixels,
+                           const Size& size,
+                           int stride,
+                           const std::string& format,
+                           const EncodeOptions& options,
+                           std::string* output) {
+  CFStringRef type;
+  if (format == "png")
+    type = CFSTR("public.png");
+  else if (format == "jpeg")
+    type = CFSTR("public.jpeg");
+  else
+    return false;
+  @autoreleasepool {
+    base::ScopedCFTypeRef<CGColorSpaceRef> color_space(
+        CGColorSpaceCreateDeviceRGB());
+    base::ScopedCFTypeRef<CGDataProviderRef> provider(
+        CGDataProviderCreateWithData(nullptr, pixels,
+                                     stride * size.height(), nullptr));
+    base::ScopedCFTypeRef<CGImageRef> cgimage(CGImageCreate(
+        size.width(), size.height(), 8, 32, stride, color_space,
+        kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst,
+        provider, nullptr, false, kCGRenderingIntentDefault));
+    base::ScopedCFTypeRef<CFMutableDataRef> data(
+        CFDataCreateMutable(nullptr, 0));
+    base::ScopedCFTypeRef<CGImageDestinationRef> destination(
+        CGImageDestinationCreateWithData(data, type, 1, nullptr));
+    if (!cgimage || !destination)
+      return false;
+    NSDictionary* properties = @{
+      (__bridge NSString*)kCGImageDestinationLossyCompressionQuality:
+          @(options.quality / 100.),
+    };
+    CGImageDestinationAddImage(destination, cgimage,
+                               (__bridge CFDictionaryRef)properties);
+    if (!CGImageDestinationFinalize(destination))
+      return false;
+    output->assign(reinterpret_cast<const char*>(CFDataGetBytePtr(data)),
+                   CFDataGetLength(data));
+    return true;
+  }
+}
+
 bool Image::IsEmpty() const {
   return [[image_ representations] count] == 0;
 }
@@ -124,8 +218,94 @@ NSBitmapImageRep* Image::GetAnimationRep() const {
   return nullptr;
 }
 
-float Image::GetAnimationDuration(int index) const {
-  return durations_[index];
+bool Image::IsAnimated() const {
+  return GetAnimationRep() != nullptr;
+}
+
+int Image::AdvanceFrame() {
+  NSBitmapImageRep* rep = GetAnimationRep();
+  if (!rep)
+    return 0;
+  int frames_count = [[rep valueForProperty:NSImageFrameCount] intValue];
+  frame_ = (frame_ + 1) % frames_count;
+  [rep setProperty:NSImageCurrentFrame
+         withValue:[NSNumber numberWithInteger:frame_]];
+  if (static_cast<size_t>(frame_) < durations_.size())
+    return durations_[frame_];
+  return 100;
+}
+
+NativeImage Image::PlatformResize(const SizeF& size,
+                                  ImageQuality quality) const {
+  size_t width = size.width();
+  size_t height = size.height();
+  base::ScopedCFTypeRef<CGColorSpaceRef> color_space(
+      CGColorSpaceCreateDeviceRGB());
+  base::ScopedCFTypeRef<CGContextRef> context(CGBitmapContextCreate(
+      nullptr, width, height, 8, 0, color_space,
+      kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host));
+  if (!context)
+    return nil;
+  NSGraphicsContext* ns_context =
+      [NSGraphicsContext graphicsContextWithGraphicsPort:context flipped:NO];
+  switch (quality) {
+    case ImageQuality::Low:
+      [ns_context setImageInterpolation:NSImageInterpolationLow];
+      break;
+    case ImageQuality::Medium:
+      [ns_context setImageInterpolation:NSImageInterpolationMedium];
+      break;
+    case ImageQuality::High:
+      [ns_context setImageInterpolation:NSImageInterpolationHigh];
+      break;
+  }
+  NSGraphicsContext* previous_context = [NSGraphicsContext currentContext];
+  [NSGraphicsContext setCurrentContext:ns_context];
+  [image_ drawInRect:NSMakeRect(0, 0, width, height)
+            fromRect:NSZeroRect
+           operation:NSCompositeCopy
+            fraction:1.0];
+  [NSGraphicsContext setCurrentContext:previous_context];
+  base::ScopedCFTypeRef<CGImageRef> cg_image(
+      CGBitmapContextCreateImage(context));
+  if (!cg_image)
+    return nil;
+  return [[NSImage alloc]
+      initWithCGImage:cg_image
+                 size:NSMakeSize(width / scale_factor_,
+                                 height / scale_factor_)];
+}
+
+CGImageRef Image::GetCGImage(float scale_factor) const {
+  auto it = cg_images_.find(scale_factor);
+  if (it != cg_images_.end())
+    return it->second.get();
+  // Animated images are drawn from current frame, and not cached.
+  base::ScopedCFTypeRef<CGImageRef>& result = cg_images_[scale_factor];
+  if (IsEmpty() || GetAnimationRep())
+    return nullptr;
+  // Draw the image into a premultiplied bitmap of device format.
+  SizeF size = GetSize();
+  size_t width = std::ceil(size.width() * scale_factor);
+  size_t height = std::ceil(size.height() * scale_factor);
+  base::ScopedCFTypeRef<CGColorSpaceRef> color_space(
+      CGColorSpaceCreateDeviceRGB());
+  base::ScopedCFTypeRef<CGContextRef> context(CGBitmapContextCreate(
+      nullptr, width, height, 8, 0, color_space,
+      kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host));
+  if (!context)
+    return nullptr;
+  NSGraphicsContext* ns_context =
+      [NSGraphicsContext graphicsContextWithGraphicsPort:context flipped:NO];
+  NSGraphicsContext* previous_context = [NSGraphicsContext currentContext];
+  [NSGraphicsContext setCurrentContext:ns_context];
+  [image_ drawInRect:NSMakeRect(0, 0, width, height)
+            fromRect:NSZeroRect
+           operation:NSCompositeCopy
+            fraction:1.0];
+  [NSGraphicsContext setCurrentContext:previous_context];
+  result.reset(CGBitmapContextCreateImage(context));
+  return result.get();
 }
 
 }  // namespace nu
@@ -45,6 +45,8 @@ class PainterMac : public Painter {
   void SetLineWidth(float width) override;
   void Stroke() override;
   void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
   void Clear() override;
   void StrokeRect(const RectF& rect) override;
   void FillRect(const RectF& rect) override;
@@ -58,6 +60,12 @@ class PainterMac : public Painter {
                           const RectF& rect) override;
 
  private:
+  // Return the scale factor from user space to device space.
+  float GetDeviceScaleFactor() const;
+
+  // Stroke or fill |path| while keeping current path.
+  void DrawPath(Path* path, bool stroke);
+
   // APIs of Core Graphics operate on current context, while we don't set
   // current context for memory bitmap. So in order to support Canvas we have
   // to save the context object and do manual context switching.
@@ -6,6 +6,9 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "base/mac/scoped_cftyperef.h"
 #include "base/mac/scoped_nsobject.h"
 #include "base/strings/sys_string_conversions.h"
@@ -13,15 +16,33 @@
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
 
 namespace nu {
 
 namespace {
 
+// Wrap the pixels of |bitmap| in an image without copying, the image must
+// not outlive current drawing.
+CGImageRef CreateImageWrappingBitmap(CGContextRef bitmap) {
+  size_t height = CGBitmapContextGetHeight(bitmap);
+  size_t stride = CGBitmapContextGetBytesPerRow(bitmap);
+  base::ScopedCFTypeRef<CGDataProviderRef> provider(
+      CGDataProviderCreateWithData(nullptr, CGBitmapContextGetData(bitmap),
+                                   stride * height, nullptr));
+  return CGImageCreate(CGBitmapContextGetWidth(bitmap), height, 8, 32, stride,
+                       CGBitmapContextGetColorSpace(bitmap),
+                       CGBitmapContextGetBitmapInfo(bitmap), provider,
+                       nullptr, false, kCGRenderingIntentDefault);
+}
+
 // Create a NSImage from bitmap.
 base::scoped_nsobject<NSImage> CreateNSImageFromCanvas(Canvas* canvas) {
+  // The pixels of shared canvases are read directly, while the image created
+  // by CGBitmapContextCreateImage copies pixels when the canvas is changed.
   base::ScopedCFTypeRef<CGImageRef> cgimage(
-      CGBitmapContextCreateImage(canvas->GetBitmap()));
+      canvas->IsShared() ? CreateImageWrappingBitmap(canvas->GetBitmap())
+                         : CGBitmapContextCreateImage(canvas->GetBitmap()));
   base::scoped_nsobject<NSBitmapImageRep> bitmap(
       [[NSBitmapImageRep alloc] initWithCGImage:cgimage]);
   base::scoped_nsobject<NSImage> image(
@@ -53,6 +74,16 @@ class GraphicsContextScope {
   DISALLOW_COPY_AND_ASSIGN(GraphicsContextScope);
 };
 
+// Draw |image| to |rect|, the context is flipped.
+void DrawCGImage(CGContextRef context, CGImageRef image, const RectF& rect) {
+  CGContextSaveGState(context);
+  CGContextTranslateCTM(context, rect.x(), rect.y() + rect.height());
+  CGContextScaleCTM(context, 1, -1);
+  CGContextDrawImage(context, CGRectMake(0, 0, rect.width(), rect.height()),
+                     image);
+  CGContextRestoreGState(context);
+}
+
 }  // namespace
 
 PainterMac::PainterMac(NSView* view)
@@ -76,6 +107,23 @@ PainterMac::~PainterMac() {
   [target_context_ release];
 }
 
+float PainterMac::GetDeviceScaleFactor() const {
+  // Cached bitmaps use integral scale factors to limit the number of caches.
+  CGSize size = CGContextConvertSizeToDeviceSpace(context_, CGSizeMake(1, 1));
+  return std::max(1.f, std::ceil(std::abs(static_cast<float>(size.width))));
+}
+
+void PainterMac::DrawPath(Path* path, bool stroke) {
+  base::ScopedCFTypeRef<CGPathRef> current;
+  if (!CGContextIsPathEmpty(context_))
+    current.reset(CGContextCopyPath(context_));
+  CGContextBeginPath(context_);
+  CGContextAddPath(context_, path->GetNative());
+  CGContextDrawPath(context_, stroke ? kCGPathStroke : kCGPathFill);
+  if (current)
+    CGContextAddPath(context_, current);
+}
+
 void PainterMac::Save() {
   CGContextSaveGState(context_);
 }
@@ -163,6 +211,14 @@ void PainterMac::Fill() {
   CGContextFillPath(context_);
 }
 
+void PainterMac::StrokePath(Path* path) {
+  DrawPath(path, true);
+}
+
+void PainterMac::FillPath(Path* path) {
+  DrawPath(path, false);
+}
+
 void PainterMac::Clear() {
   CGContextClearRect(context_, RectF(size_).ToCGRect());
 }
@@ -176,6 +232,12 @@ void PainterMac::FillRect(const RectF& rect) {
 }
 
 void PainterMac::DrawImage(const Image* image, const RectF& rect) {
+  image = image->GetMipmapFor(rect, nullptr);
+  CGImageRef cg_image = image->GetCGImage(GetDeviceScaleFactor());
+  if (cg_image) {
+    DrawCGImage(context_, cg_image, rect);
+    return;
+  }
   GraphicsContextScope scoped(target_context_);
   [image->GetNative() drawInRect:rect.ToCGRect()
                         fromRect:NSZeroRect
@@ -185,8 +247,26 @@ void PainterMac::DrawImage(const Image* image, const RectF& rect) {
                            hints:nil];
 }
 
-void PainterMac::DrawImageFromRect(const Image* image, const RectF& src,
+void PainterMac::DrawImageFromRect(const Image* image, const RectF& s,
                                    const RectF& dest) {
+  RectF src(s);
+  image = image->GetMipmapFor(dest, &src);
+  CGImageRef cg_image = image->GetCGImage(GetDeviceScaleFactor());
+  if (cg_image && !src.IsEmpty()) {
+    // Draw the whole image clipped to |dest|, scaled so |src| fills |dest|.
+    float x_scale = dest.width() / src.width();
+    float y_scale = dest.height() / src.height();
+    SizeF size = image->GetSize();
+    CGContextSaveGState(context_);
+    CGContextClipToRect(context_, dest.ToCGRect());
+    DrawCGImage(context_, cg_image,
+                RectF(dest.x() - src.x() * x_scale,
+                      dest.y() - src.y() * y_scale,
+                      size.width() * x_scale, size.height() * y_scale));
+    CGContextRestoreGState(context_);
+    return;
+  }
+
   // The src rect needs to be manually flipped.
   RectF flipped(src);
   flipped.set_y(image->GetSize().height() - src.height() - src.y());
@@ -0,0 +1,57 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#include <ApplicationServices/ApplicationServices.h>
+
+namespace nu {
+
+namespace {
+
+// Build CGPath with the same calls of PainterMac.
+class CGPathBuilder {
+ public:
+  explicit CGPathBuilder(CGMutablePathRef path) : path_(path) {}
+
+  void MoveTo(const PointF& p) {
+    CGPathMoveToPoint(path_, nullptr, p.x(), p.y());
+  }
+  void LineTo(const PointF& p) {
+    CGPathAddLineToPoint(path_, nullptr, p.x(), p.y());
+  }
+  void BezierCurveTo(const PointF& cp1, const PointF& cp2, const PointF& ep) {
+    CGPathAddCurveToPoint(path_, nullptr,
+                          cp1.x(), cp1.y(), cp2.x(), cp2.y(), ep.x(), ep.y());
+  }
+  void Arc(const PointF& p, float radius, float sa, float ea) {
+    // We are in a flipped coordinate system, so use anti-clockwise.
+    CGPathAddArc(path_, nullptr, p.x(), p.y(), radius, sa, ea, false);
+  }
+  void Rect(const RectF& rect) {
+    CGPathAddRect(path_, nullptr, rect.ToCGRect());
+  }
+  void ClosePath() {
+    CGPathCloseSubpath(path_);
+  }
+
+ private:
+  CGMutablePathRef path_;
+};
+
+}  // namespace
+
+NativePath Path::PlatformCreate() const {
+  CGMutablePathRef path = CGPathCreateMutable();
+  CGPathBuilder builder(path);
+  Visit(&builder);
+  return path;
+}
+
+// static
+void Path::PlatformDestroy(NativePath path) {
+  CGPathRelease(path);
+}
+
+}  // namespace nu
@@ -0,0 +1,109 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/monospace_text_renderer.h"
+
+#include <cmath>
+
+#include "base/strings/utf_string_conversion_utils.h"
+#include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/painter.h"
+
+namespace nu {
+
+namespace {
+
+// Run |callback| for each code point in |text|, invalid sequences are passed
+// as the replacement character.
+template<typename T>
+void ForEachCodePoint(const std::string& text, const T& callback) {
+  int32_t length = static_cast<int32_t>(text.size());
+  for (int32_t i = 0; i < length; ++i) {
+    uint32_t code_point;
+    if (!base::ReadUnicodeCharacter(text.data(), length, &i, &code_point))
+      code_point = 0xFFFD;
+    callback(code_point);
+  }
+}
+
+// Spaces and control characters only take a cell without drawing.
+inline bool IsBlank(uint32_t code_point) {
+  return code_point <= 0x20 || code_point == 0x7F;
+}
+
+}  // namespace
+
+MonospaceTextRenderer::MonospaceTextRenderer(Font* font,
+                                             Color color,
+                                             float scale_factor)
+    : attributes_(font, color, TextAlign::Start, TextAlign::Start, false),
+      scale_factor_(scale_factor) {
+  scoped_refptr<AttributedText> text = new AttributedText("M", attributes_);
+  SizeF size = text->GetOneLineSize();
+  advance_ = size.width();
+  cell_size_ = SizeF(std::ceil(size.width()), std::ceil(size.height()));
+}
+
+MonospaceTextRenderer::~MonospaceTextRenderer() {}
+
+void MonospaceTextRenderer::DrawText(Painter* painter,
+                                     const std::string& text,
+                                     const PointF& point) {
+  float x = point.x();
+  ForEachCodePoint(text, [&](uint32_t code_point) {
+    if (IsBlank(code_point)) {
+      x += advance_;
+      return;
+    }
+    const Glyph& glyph = GetGlyph(code_point);
+    painter->DrawCanvasFromRect(
+        glyph.page, glyph.rect,
+        RectF(x, point.y(), glyph.rect.width(), glyph.rect.height()));
+    x += advance_ * glyph.cells;
+  });
+}
+
+SizeF MonospaceTextRenderer::MeasureText(const std::string& text) {
+  int cells = 0;
+  ForEachCodePoint(text, [&](uint32_t code_point) {
+    cells += IsBlank(code_point) ? 1 : GetGlyph(code_point).cells;
+  });
+  return SizeF(advance_ * cells, cell_size_.height());
+}
+
+const MonospaceTextRenderer::Glyph& MonospaceTextRenderer::GetGlyph(
+    uint32_t code_point) {
+  auto it = glyphs_.find(code_point);
+  if (it != glyphs_.end())
+    return it->second;
+
+  std::string str;
+  base::WriteUnicodeCharacter(code_point, &str);
+  scoped_refptr<AttributedText> text = new AttributedText(str, attributes_);
+  int cells = text->GetOneLineSize().width() > advance_ * 1.5f ? 2 : 1;
+
+  // A wide glyph does not wrap across rows.
+  if (cells > 1 && next_cell_ % kPageCells == kPageCells - 1)
+    ++next_cell_;
+  if (pages_.empty() || next_cell_ + cells > kPageCells * kPageCells) {
+    pages_.push_back(new Canvas(SizeF(cell_size_.width() * kPageCells,
+                                      cell_size_.height() * kPageCells),
+                                scale_factor_));
+    next_cell_ = 0;
+  }
+
+  Glyph glyph;
+  glyph.page = pages_.back().get();
+  glyph.rect = RectF((next_cell_ % kPageCells) * cell_size_.width(),
+                     (next_cell_ / kPageCells) * cell_size_.height(),
+                     cell_size_.width() * cells,
+                     cell_size_.height());
+  glyph.cells = cells;
+  next_cell_ += cells;
+  glyph.page->GetPainter()->DrawAttributedText(text, glyph.rect);
+  return glyphs_.emplace(code_point, glyph).first->second;
+}
+
+}  // namespace nu
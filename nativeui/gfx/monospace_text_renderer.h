@@ -0,0 +1,95 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_MONOSPACE_TEXT_RENDERER_H_
+#define NATIVEUI_GFX_MONOSPACE_TEXT_RENDERER_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/point_f.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/gfx/text.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class Canvas;
+class Painter;
+
+// Draws single-line text in fixed width cells from an atlas of glyphs.
+//
+// Each glyph is rasterized only once into a Canvas, and drawing a string is
+// then a series of bitmap copies, which is much cheaper than shaping text for
+// every cell of custom-drawn tables, log viewers and code editors.
+//
+// The renderer does not do shaping, so it is only suitable for scripts where
+// each code point maps to one glyph, drawn with monospace fonts.
+class NATIVEUI_EXPORT MonospaceTextRenderer
+    : public base::RefCounted<MonospaceTextRenderer> {
+ public:
+  // The glyphs are rasterized with |scale_factor|, which should match the
+  // scale factor of the window that the text is drawn on.
+  MonospaceTextRenderer(Font* font, Color color, float scale_factor);
+
+  // Draw |text| in one line, with the top-left corner at |point|.
+  void DrawText(Painter* painter, const std::string& text,
+                const PointF& point);
+
+  // Return the size of |text| when drawn in one line.
+  SizeF MeasureText(const std::string& text);
+
+  // Return the width of one cell and the height of line.
+  SizeF GetCellSize() const { return SizeF(advance_, cell_size_.height()); }
+
+  // Return the number of rasterized glyphs.
+  int GetGlyphCount() const { return static_cast<int>(glyphs_.size()); }
+
+  Font* GetFont() const { return attributes_.font.get(); }
+  Color GetColor() const { return attributes_.color; }
+  float GetScaleFactor() const { return scale_factor_; }
+
+ private:
+  friend class base::RefCounted<MonospaceTextRenderer>;
+
+  ~MonospaceTextRenderer();
+
+  struct Glyph {
+    Canvas* page;
+    // The bounds of glyph in the page.
+    RectF rect;
+    // Number of cells taken, wide characters like CJK take two.
+    int cells;
+  };
+
+  // Return the glyph of |code_point|, rasterize it if not cached.
+  const Glyph& GetGlyph(uint32_t code_point);
+
+  // Number of cells in each row and column of an atlas page.
+  static const int kPageCells = 16;
+
+  TextAttributes attributes_;
+  float scale_factor_;
+
+  // The distance between cells, and the size of cells in atlas which is
+  // rounded up to whole pixels.
+  float advance_;
+  SizeF cell_size_;
+
+  // Where the next glyph is put in the last page.
+  int next_cell_ = 0;
+
+  std::vector<scoped_refptr<Canvas>> pages_;
+  std::unordered_map<uint32_t, Glyph> glyphs_;
+
+  DISALLOW_COPY_AND_ASSIGN(MonospaceTextRenderer);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_MONOSPACE_TEXT_RENDERER_H_
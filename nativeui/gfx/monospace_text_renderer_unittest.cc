@@ -0,0 +1,46 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class MonospaceTextRendererTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    scoped_refptr<nu::Font> font = nu::Font::Get(
+        "Courier New", 12, nu::Font::Weight::Normal, nu::Font::Style::Normal);
+    renderer_ = new nu::MonospaceTextRenderer(font.get(), nu::Color(), 1.f);
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::MonospaceTextRenderer> renderer_;
+};
+
+TEST_F(MonospaceTextRendererTest, CellSize) {
+  nu::SizeF size = renderer_->GetCellSize();
+  EXPECT_GT(size.width(), 0);
+  EXPECT_GT(size.height(), 0);
+}
+
+TEST_F(MonospaceTextRendererTest, RasterizeGlyphsOnce) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(200, 50), 1.f);
+  renderer_->DrawText(canvas->GetPainter(), "abca", nu::PointF());
+  EXPECT_EQ(renderer_->GetGlyphCount(), 3);
+  renderer_->DrawText(canvas->GetPainter(), "cab", nu::PointF(0, 20));
+  EXPECT_EQ(renderer_->GetGlyphCount(), 3);
+}
+
+TEST_F(MonospaceTextRendererTest, BlankCharacters) {
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(200, 50), 1.f);
+  renderer_->DrawText(canvas->GetPainter(), " \t ", nu::PointF());
+  EXPECT_EQ(renderer_->GetGlyphCount(), 0);
+}
+
+TEST_F(MonospaceTextRendererTest, MeasureText) {
+  nu::SizeF cell = renderer_->GetCellSize();
+  EXPECT_EQ(renderer_->MeasureText(""), nu::SizeF(0, cell.height()));
+  EXPECT_EQ(renderer_->MeasureText("a b"),
+            nu::SizeF(cell.width() * 3, cell.height()));
+}
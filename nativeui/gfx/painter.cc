@@ -4,17 +4,168 @@
 
 #include "nativeui/gfx/painter.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
 #include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/text_layout_cache.h"
+#include "nativeui/state.h"
 
 namespace nu {
 
+namespace {
+
+// Number of arguments of each command.
+const size_t kArgCount[] = {0, 0, 0, 0, 2, 2, 6, 5, 4, 0, 4, 2, 1,
+                            2, 4, 4, 4, 1, 0, 0, 0, 4, 4, 1};
+
+// Converting a float that is out of range of the integer type is undefined
+// behavior, so the values must be checked before casting.
+inline bool IsInRange(float value, float min, float max) {
+  return std::isfinite(value) && value >= min && value <= max;
+}
+
+bool ReadColor(const float* args, Color* color) {
+  for (int i = 0; i < 4; ++i) {
+    if (!IsInRange(args[i], 0, 255))
+      return false;
+  }
+  *color = Color(static_cast<unsigned>(args[3]),
+                 static_cast<unsigned>(args[0]),
+                 static_cast<unsigned>(args[1]),
+                 static_cast<unsigned>(args[2]));
+  return true;
+}
+
+}  // namespace
+
 Painter::Painter() : weak_factory_(this) {}
 
 Painter::~Painter() {}
 
+bool Painter::Execute(const float* data, size_t size) {
+  const float* end = data + size;
+  Color color;
+  while (data < end) {
+    float value = *data++;
+    if (!IsInRange(value, 0, static_cast<float>(base::size(kArgCount) - 1))) {
+      LOG(ERROR) << "Unknown painter command: " << value;
+      return false;
+    }
+    int command = static_cast<int>(value);
+    size_t remaining = end - data;
+    if (remaining < kArgCount[command]) {
+      LOG(ERROR) << "Missing arguments for painter command: " << command;
+      return false;
+    }
+    const float* args = data;
+    data += kArgCount[command];
+    switch (static_cast<Command>(command)) {
+      case Command::Save:
+        Save();
+        break;
+      case Command::Restore:
+        Restore();
+        break;
+      case Command::BeginPath:
+        BeginPath();
+        break;
+      case Command::ClosePath:
+        ClosePath();
+        break;
+      case Command::MoveTo:
+        MoveTo(PointF(args[0], args[1]));
+        break;
+      case Command::LineTo:
+        LineTo(PointF(args[0], args[1]));
+        break;
+      case Command::BezierCurveTo:
+        BezierCurveTo(PointF(args[0], args[1]), PointF(args[2], args[3]),
+                      PointF(args[4], args[5]));
+        break;
+      case Command::Arc:
+        Arc(PointF(args[0], args[1]), args[2], args[3], args[4]);
+        break;
+      case Command::Rect:
+        Rect(RectF(args[0], args[1], args[2], args[3]));
+        break;
+      case Command::Clip:
+        Clip();
+        break;
+      case Command::ClipRect:
+        ClipRect(RectF(args[0], args[1], args[2], args[3]));
+        break;
+      case Command::Translate:
+        Translate(Vector2dF(args[0], args[1]));
+        break;
+      case Command::Rotate:
+        Rotate(args[0]);
+        break;
+      case Command::Scale:
+        Scale(Vector2dF(args[0], args[1]));
+        break;
+      case Command::SetColor:
+        if (!ReadColor(args, &color)) {
+          LOG(ERROR) << "Invalid color for painter command: " << command;
+          return false;
+        }
+        SetColor(color);
+        break;
+      case Command::SetStrokeColor:
+        if (!ReadColor(args, &color)) {
+          LOG(ERROR) << "Invalid color for painter command: " << command;
+          return false;
+        }
+        SetStrokeColor(color);
+        break;
+      case Command::SetFillColor:
+        if (!ReadColor(args, &color)) {
+          LOG(ERROR) << "Invalid color for painter command: " << command;
+          return false;
+        }
+        SetFillColor(color);
+        break;
+      case Command::SetLineWidth:
+        SetLineWidth(args[0]);
+        break;
+      case Command::Stroke:
+        Stroke();
+        break;
+      case Command::Fill:
+        Fill();
+        break;
+      case Command::Clear:
+        Clear();
+        break;
+      case Command::StrokeRect:
+        StrokeRect(RectF(args[0], args[1], args[2], args[3]));
+        break;
+      case Command::FillRect:
+        FillRect(RectF(args[0], args[1], args[2], args[3]));
+        break;
+      case Command::Lines: {
+        // Rounding of |max_count| may still allow a few more points.
+        size_t max_count = static_cast<size_t>(end - data) / 2;
+        if (!IsInRange(args[0], 0, static_cast<float>(max_count))) {
+          LOG(ERROR) << "Invalid points for painter command: " << command;
+          return false;
+        }
+        size_t count = std::min(static_cast<size_t>(args[0]), max_count);
+        for (size_t i = 0; i < count; ++i, data += 2)
+          LineTo(PointF(data[0], data[1]));
+        break;
+      }
+    }
+  }
+  return true;
+}
+
 void Painter::DrawText(const std::string& str, const RectF& rect,
                        const TextAttributes& attributes) {
-  DrawAttributedText(new AttributedText(str, attributes), rect);
+  DrawAttributedText(
+      State::GetCurrent()->GetTextLayoutCache()->Get(str, attributes), rect);
 }
 
 }  // namespace nu
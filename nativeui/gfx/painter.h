@@ -22,12 +22,49 @@ namespace nu {
 class AttributedText;
 class Canvas;
 class Image;
+class Path;
 
 // The interface for painting on canvas or window.
 class NATIVEUI_EXPORT Painter {
  public:
   virtual ~Painter();
 
+  // The commands that can be encoded for Execute, each command is followed by
+  // a fixed number of arguments.
+  enum class Command {
+    Save = 0,           // no arguments
+    Restore,            // no arguments
+    BeginPath,          // no arguments
+    ClosePath,          // no arguments
+    MoveTo,             // x, y
+    LineTo,             // x, y
+    BezierCurveTo,      // cp1x, cp1y, cp2x, cp2y, x, y
+    Arc,                // x, y, radius, start angle, end angle
+    Rect,               // x, y, width, height
+    Clip,               // no arguments
+    ClipRect,           // x, y, width, height
+    Translate,          // x, y
+    Rotate,             // angle
+    Scale,              // x, y
+    SetColor,           // r, g, b, a
+    SetStrokeColor,     // r, g, b, a
+    SetFillColor,       // r, g, b, a
+    SetLineWidth,       // width
+    Stroke,             // no arguments
+    Fill,               // no arguments
+    Clear,              // no arguments
+    StrokeRect,         // x, y, width, height
+    FillRect,           // x, y, width, height
+    Lines,              // count, then |count| pairs of x, y
+  };
+
+  // Run the commands encoded in |data|, which is much faster than calling
+  // the methods one by one from language bindings.
+  //
+  // Return false when there is unknown command, or invalid or missing
+  // arguments, the commands before the error are still executed.
+  bool Execute(const float* data, size_t size);
+
   // Save/Restore current state.
   virtual void Save() = 0;
   virtual void Restore() = 0;
@@ -68,6 +105,11 @@ class NATIVEUI_EXPORT Painter {
   // Draw a solid shape by filling current path's content area.
   virtual void Fill() = 0;
 
+  // Stroke and fill |path| without changing current path, the native path of
+  // |path| is cached so drawing the same path again is cheap.
+  virtual void StrokePath(Path* path) = 0;
+  virtual void FillPath(Path* path) = 0;
+
   // Fill the whole context with transparent color.
   virtual void Clear() = 0;
 
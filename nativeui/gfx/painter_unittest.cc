@@ -0,0 +1,98 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <limits>
+
+#include "base/stl_util.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using Command = nu::Painter::Command;
+
+class PainterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    list_ = new nu::DisplayList;
+  }
+
+  static float C(Command command) { return static_cast<float>(command); }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::DisplayList> list_;
+};
+
+TEST_F(PainterTest, Execute) {
+  const float commands[] = {
+    C(Command::BeginPath),
+    C(Command::MoveTo), 0, 0,
+    C(Command::Lines), 3, 1, 1, 2, 2, 3, 3,
+    C(Command::SetStrokeColor), 255, 0, 0, 255,
+    C(Command::Stroke),
+  };
+  EXPECT_TRUE(list_->GetPainter()->Execute(commands, base::size(commands)));
+  // BeginPath, MoveTo, 3 LineTo, SetStrokeColor and Stroke.
+  EXPECT_EQ(list_->GetOpCount(), 7);
+}
+
+TEST_F(PainterTest, ExecuteInvalidCommands) {
+  const float unknown[] = {C(Command::BeginPath), 1000};
+  EXPECT_FALSE(list_->GetPainter()->Execute(unknown, base::size(unknown)));
+  EXPECT_EQ(list_->GetOpCount(), 1);
+  const float missing[] = {C(Command::MoveTo), 0};
+  EXPECT_FALSE(list_->GetPainter()->Execute(missing, base::size(missing)));
+  const float missing_points[] = {C(Command::Lines), 2, 0, 0};
+  EXPECT_FALSE(list_->GetPainter()->Execute(missing_points,
+                                            base::size(missing_points)));
+  EXPECT_EQ(list_->GetOpCount(), 1);
+}
+
+TEST_F(PainterTest, ExecuteOutOfRangeValues) {
+  const float kInf = std::numeric_limits<float>::infinity();
+  const float kNaN = std::numeric_limits<float>::quiet_NaN();
+  const float commands[][5] = {
+    {kNaN},
+    {-kInf},
+    {1e30f},
+    {-1},
+    {C(Command::SetColor), 255, 0, 0, kNaN},
+    {C(Command::SetFillColor), 1e10f, 0, 0, 255},
+    {C(Command::SetStrokeColor), -1, 0, 0, 255},
+    {C(Command::Lines), kInf, 0, 0},
+    {C(Command::Lines), 1e30f, 0, 0},
+    {C(Command::Lines), -1},
+  };
+  for (const auto& command : commands)
+    EXPECT_FALSE(list_->GetPainter()->Execute(command, base::size(command)));
+  EXPECT_EQ(list_->GetOpCount(), 0);
+}
+
+TEST_F(PainterTest, Path) {
+  scoped_refptr<nu::Path> path = new nu::Path;
+  EXPECT_TRUE(path->IsEmpty());
+  path->MoveTo(nu::PointF(1, 1));
+  path->LineTo(nu::PointF(8, 1));
+  path->Arc(nu::PointF(5, 5), 3, 0, 3.14f);
+  path->ClosePath();
+  EXPECT_FALSE(path->IsEmpty());
+  // Drawing a path records one operation.
+  nu::Painter* painter = list_->GetPainter();
+  painter->FillPath(path.get());
+  painter->StrokePath(path.get());
+  EXPECT_EQ(list_->GetOpCount(), 2);
+  // Adding the path to current path records each operation.
+  path->AddTo(painter);
+  EXPECT_EQ(list_->GetOpCount(), 6);
+  // The native path is created on first drawing and then reused.
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 10), 1.f);
+  list_->Replay(canvas->GetPainter());
+  nu::NativePath native = path->GetNative();
+  EXPECT_NE(native, nullptr);
+  canvas->GetPainter()->FillPath(path.get());
+  EXPECT_EQ(path->GetNative(), native);
+  // Drawing an empty path does nothing.
+  path->Clear();
+  EXPECT_TRUE(path->IsEmpty());
+  canvas->GetPainter()->FillPath(path.get());
+}
@@ -0,0 +1,73 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/path.h"
+
+#include "nativeui/gfx/painter.h"
+
+namespace nu {
+
+Path::Path() {}
+
+Path::~Path() {
+  if (native_)
+    PlatformDestroy(native_);
+}
+
+void Path::MoveTo(const PointF& p) {
+  Record(Op::MoveTo, {p.x(), p.y()});
+}
+
+void Path::LineTo(const PointF& p) {
+  Record(Op::LineTo, {p.x(), p.y()});
+}
+
+void Path::BezierCurveTo(const PointF& cp1,
+                         const PointF& cp2,
+                         const PointF& ep) {
+  Record(Op::BezierCurveTo,
+         {cp1.x(), cp1.y(), cp2.x(), cp2.y(), ep.x(), ep.y()});
+}
+
+void Path::Arc(const PointF& p, float radius, float sa, float ea) {
+  Record(Op::Arc, {p.x(), p.y(), radius, sa, ea});
+}
+
+void Path::Rect(const RectF& r) {
+  Record(Op::Rect, {r.x(), r.y(), r.width(), r.height()});
+}
+
+void Path::ClosePath() {
+  Record(Op::ClosePath, {});
+}
+
+void Path::Clear() {
+  ops_.clear();
+  args_.clear();
+  if (native_) {
+    PlatformDestroy(native_);
+    native_ = nullptr;
+  }
+}
+
+void Path::AddTo(Painter* painter) const {
+  Visit(painter);
+}
+
+NativePath Path::GetNative() const {
+  if (!native_)
+    native_ = PlatformCreate();
+  return native_;
+}
+
+void Path::Record(Op op, std::initializer_list<float> args) {
+  ops_.push_back(op);
+  args_.insert(args_.end(), args);
+  if (native_) {
+    PlatformDestroy(native_);
+    native_ = nullptr;
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,126 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PATH_H_
+#define NATIVEUI_GFX_PATH_H_
+
+#include <stdint.h>
+
+#include <initializer_list>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/nativeui_export.h"
+#include "nativeui/types.h"
+
+namespace nu {
+
+class Painter;
+
+// A path that is built once and then filled or stroked many times.
+//
+// The native path is created when the path is drawn for the first time, and
+// is cached until the path is modified, so drawing static shapes does not
+// rebuild them in every frame.
+class NATIVEUI_EXPORT Path : public base::RefCounted<Path> {
+ public:
+  Path();
+
+  // Same with the path operations of Painter.
+  void MoveTo(const PointF& point);
+  void LineTo(const PointF& point);
+  void BezierCurveTo(const PointF& cp1, const PointF& cp2, const PointF& ep);
+  void Arc(const PointF& point, float radius, float sa, float ea);
+  void Rect(const RectF& rect);
+  void ClosePath();
+
+  // Remove all operations.
+  void Clear();
+  bool IsEmpty() const { return ops_.empty(); }
+
+  // Internal: Add the operations to the current path of |painter|.
+  void AddTo(Painter* painter) const;
+
+  // Internal: Pass the operations to |sink|, which has the path methods of
+  // Painter.
+  template<typename Sink>
+  void Visit(Sink* sink) const;
+
+  // Internal: Return the native path, which is created on first call.
+  NativePath GetNative() const;
+
+ private:
+  friend class base::RefCounted<Path>;
+
+  ~Path();
+
+  enum class Op : uint8_t {
+    MoveTo,
+    LineTo,
+    BezierCurveTo,
+    Arc,
+    Rect,
+    ClosePath,
+  };
+
+  // Append the operation and drop the cached native path.
+  void Record(Op op, std::initializer_list<float> args);
+
+  NativePath PlatformCreate() const;
+  static void PlatformDestroy(NativePath path);
+
+  std::vector<Op> ops_;
+  std::vector<float> args_;
+
+  mutable NativePath native_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(Path);
+};
+
+template<typename Sink>
+void Path::Visit(Sink* sink) const {
+  size_t arg = 0;
+  auto point = [&]() {
+    PointF p(args_[arg], args_[arg + 1]);
+    arg += 2;
+    return p;
+  };
+  for (Op op : ops_) {
+    switch (op) {
+      case Op::MoveTo:
+        sink->MoveTo(point());
+        break;
+      case Op::LineTo:
+        sink->LineTo(point());
+        break;
+      case Op::BezierCurveTo: {
+        PointF cp1 = point();
+        PointF cp2 = point();
+        sink->BezierCurveTo(cp1, cp2, point());
+        break;
+      }
+      case Op::Arc: {
+        PointF p = point();
+        sink->Arc(p, args_[arg], args_[arg + 1], args_[arg + 2]);
+        arg += 3;
+        break;
+      }
+      case Op::Rect: {
+        RectF r(args_[arg], args_[arg + 1], args_[arg + 2], args_[arg + 3]);
+        arg += 4;
+        sink->Rect(r);
+        break;
+      }
+      case Op::ClosePath:
+        sink->ClosePath();
+        break;
+    }
+  }
+}
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PATH_H_
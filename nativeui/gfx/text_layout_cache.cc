@@ -0,0 +1,75 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/text_layout_cache.h"
+
+#include <functional>
+
+#include "nativeui/gfx/geometry/rect_f.h"
+
+namespace nu {
+
+TextLayoutCache::Key::Key(const std::string& text,
+                          const TextAttributes& attributes)
+    : text(text),
+      font(attributes.font),
+      color(attributes.color),
+      format(attributes.ToTextFormat()) {}
+
+TextLayoutCache::Key::Key(const Key& other) = default;
+
+TextLayoutCache::Key::~Key() {}
+
+bool TextLayoutCache::Key::operator==(const Key& other) const {
+  return text == other.text &&
+         font == other.font &&
+         color == other.color &&
+         format.align == other.format.align &&
+         format.valign == other.format.valign &&
+         format.wrap == other.format.wrap &&
+         format.ellipsis == other.format.ellipsis;
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const Key& key) const {
+  size_t hash = std::hash<std::string>()(key.text);
+  hash = hash * 31 + std::hash<Font*>()(key.font.get());
+  hash = hash * 31 + key.color.value();
+  hash = hash * 31 + static_cast<size_t>(key.format.align);
+  hash = hash * 31 + static_cast<size_t>(key.format.valign);
+  hash = hash * 31 + (key.format.wrap ? 1 : 0);
+  hash = hash * 31 + (key.format.ellipsis ? 1 : 0);
+  return hash;
+}
+
+TextLayoutCache::TextLayoutCache(size_t capacity) : cache_(capacity) {}
+
+TextLayoutCache::~TextLayoutCache() {}
+
+scoped_refptr<AttributedText> TextLayoutCache::Get(
+    const std::string& text,
+    const TextAttributes& attributes) {
+  Key key(text, attributes);
+  auto it = cache_.Get(key);
+  if (it != cache_.end())
+    return it->second;
+  scoped_refptr<AttributedText> result = new AttributedText(text, attributes);
+  cache_.Put(key, result);
+  return result;
+}
+
+RectF TextLayoutCache::GetBoundsFor(const std::string& text,
+                                    const TextAttributes& attributes,
+                                    const SizeF& size) {
+  return Get(text, attributes)->GetBoundsFor(size);
+}
+
+void TextLayoutCache::OnMemoryPressure(bool critical) {
+  cache_.ShrinkToSize(critical ? 0 : cache_.size() / 2);
+}
+
+void TextLayoutCache::Clear() {
+  cache_.Clear();
+}
+
+}  // namespace nu
@@ -0,0 +1,70 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_TEXT_LAYOUT_CACHE_H_
+#define NATIVEUI_GFX_TEXT_LAYOUT_CACHE_H_
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "nativeui/gfx/attributed_text.h"
+
+namespace nu {
+
+// Keeps the recently used texts created from plain strings, so drawing and
+// measuring the same string with the same attributes do not shape the text
+// again.
+class NATIVEUI_EXPORT TextLayoutCache {
+ public:
+  // Number of texts kept by default.
+  static const size_t kDefaultCapacity = 512;
+
+  explicit TextLayoutCache(size_t capacity = kDefaultCapacity);
+  ~TextLayoutCache();
+
+  // Return the text created from |text| with |attributes|, the returned text
+  // is shared and must not be modified.
+  scoped_refptr<AttributedText> Get(const std::string& text,
+                                    const TextAttributes& attributes);
+
+  // Return the bounds of |text| when laid out in |size|.
+  RectF GetBoundsFor(const std::string& text,
+                     const TextAttributes& attributes,
+                     const SizeF& size);
+
+  // Evict texts when system is low on memory, half of the cache is released
+  // for moderate pressure and all for critical pressure.
+  void OnMemoryPressure(bool critical);
+
+  void Clear();
+  size_t size() const { return cache_.size(); }
+
+ private:
+  struct Key {
+    Key(const std::string& text, const TextAttributes& attributes);
+    Key(const Key& other);
+    ~Key();
+
+    bool operator==(const Key& other) const;
+
+    std::string text;
+    // Keep a reference so the font is not reused by another one at the same
+    // address.
+    scoped_refptr<Font> font;
+    Color color;
+    TextFormat format;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  base::HashingMRUCache<Key, scoped_refptr<AttributedText>, KeyHash> cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(TextLayoutCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_TEXT_LAYOUT_CACHE_H_
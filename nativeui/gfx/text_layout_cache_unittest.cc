@@ -0,0 +1,71 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/text_layout_cache.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class TextLayoutCacheTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(TextLayoutCacheTest, ReuseText) {
+  nu::TextLayoutCache cache;
+  nu::TextAttributes attributes;
+  scoped_refptr<nu::AttributedText> text = cache.Get("text", attributes);
+  EXPECT_EQ(cache.Get("text", attributes), text);
+  EXPECT_NE(cache.Get("other", attributes), text);
+  attributes.wrap = !attributes.wrap;
+  EXPECT_NE(cache.Get("text", attributes), text);
+  EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST_F(TextLayoutCacheTest, EvictLeastRecentlyUsed) {
+  nu::TextLayoutCache cache(2);
+  nu::TextAttributes attributes;
+  scoped_refptr<nu::AttributedText> a = cache.Get("a", attributes);
+  cache.Get("b", attributes);
+  cache.Get("a", attributes);
+  cache.Get("c", attributes);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.Get("a", attributes), a);
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(TextLayoutCacheTest, MemoryPressure) {
+  nu::TextLayoutCache cache;
+  nu::TextAttributes attributes;
+  cache.Get("a", attributes);
+  cache.Get("b", attributes);
+  scoped_refptr<nu::AttributedText> c = cache.Get("c", attributes);
+  cache.Get("d", attributes);
+  cache.Get("c", attributes);
+  cache.OnMemoryPressure(false);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.Get("c", attributes), c);
+  cache.OnMemoryPressure(true);
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(TextLayoutCacheTest, GetBoundsFor) {
+  nu::TextLayoutCache cache;
+  nu::TextAttributes attributes;
+  scoped_refptr<nu::AttributedText> text =
+      new nu::AttributedText("some text", attributes);
+  nu::SizeF size(100, 100);
+  EXPECT_EQ(cache.GetBoundsFor("some text", attributes, size),
+            text->GetBoundsFor(size));
+}
+
+TEST_F(TextLayoutCacheTest, LabelsShareMeasurement) {
+  scoped_refptr<nu::Label> label1 = new nu::Label("shared");
+  scoped_refptr<nu::Label> label2 = new nu::Label("shared");
+  size_t size = state_.GetTextLayoutCache()->size();
+  EXPECT_EQ(label1->GetTextSizeFor(nu::SizeF(100, 100)),
+            label2->GetTextSizeFor(nu::SizeF(100, 100)));
+  EXPECT_LE(state_.GetTextLayoutCache()->size(), size + 1);
+}
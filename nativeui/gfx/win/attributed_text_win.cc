@@ -4,6 +4,7 @@
 
 #include "nativeui/gfx/win/attributed_text_win.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -49,18 +50,37 @@ void AttributedText::PlatformUpdateFormat() {
 
 void AttributedText::PlatformSetFontFor(scoped_refptr<Font> font,
                                         int start, int end) {
-  CHECK(start == 0 && end == -1)
-      << "AttributedText.SetFontFor does not work on Windows";
-  text_->font = std::move(font);
+  if (start == 0 && end == -1) {
+    text_->font = std::move(font);
+    text_->font_ranges.clear();
+  } else {
+    text_->font_ranges.push_back({start, end, std::move(font)});
+  }
 }
 
 void AttributedText::PlatformSetColorFor(Color color, int start, int end) {
-  CHECK(start == 0 && end == -1)
-      << "AttributedText.SetColorFor does not work on Windows";
-  text_->brush.reset(new Gdiplus::SolidBrush(ToGdi(color)));
+  if (start == 0 && end == -1) {
+    text_->brush.reset(new Gdiplus::SolidBrush(ToGdi(color)));
+    text_->color_ranges.clear();
+  } else {
+    text_->color_ranges.push_back({start, end, color});
+  }
 }
 
-RectF AttributedText::GetBoundsFor(const SizeF& size) const {
+void AttributedText::PlatformReplaceText(int start, int end,
+                                         const std::string& text) {
+  size_t length = text_->text.size();
+  size_t pos = std::min(static_cast<size_t>(start), length);
+  size_t count = end > -1 ? std::min(static_cast<size_t>(end), length) - pos
+                          : length - pos;
+  text_->text.replace(pos, count, base::UTF8ToUTF16(text));
+}
+
+void AttributedText::PlatformAppendText(const std::string& text) {
+  text_->text.append(base::UTF8ToUTF16(text));
+}
+
+RectF AttributedText::PlatformGetBoundsFor(const SizeF& size) const {
   // MeasureString does not take account of the last new line, add a character
   // to make it behave the same with other platforms.
   bool ends_with_newline = text_->text.size() > 0 &&
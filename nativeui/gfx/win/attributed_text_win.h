@@ -6,7 +6,9 @@
 #define NATIVEUI_GFX_WIN_ATTRIBUTED_TEXT_WIN_H_
 
 #include <memory>
+#include <vector>
 
+#include "nativeui/gfx/color.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/win/gdiplus.h"
 
@@ -19,7 +21,22 @@ struct AttributedTextImpl {
   base::string16 text;
   scoped_refptr<Font> font;
   std::unique_ptr<Gdiplus::SolidBrush> brush;
-  Gdiplus::StringFormat format;;
+  Gdiplus::StringFormat format;
+
+  // Attributes of parts of text, which GDI+ can not draw so they are only
+  // applied by the Direct2D painter.
+  struct FontRange {
+    int start;
+    int end;
+    scoped_refptr<Font> font;
+  };
+  struct ColorRange {
+    int start;
+    int end;
+    Color color;
+  };
+  std::vector<FontRange> font_ranges;
+  std::vector<ColorRange> color_ranges;
 };
 
 }  // namespace nu
@@ -4,14 +4,104 @@
 
 #include "nativeui/gfx/canvas.h"
 
+#include <memory>
+
 #include "nativeui/gfx/geometry/size_conversions.h"
 #include "nativeui/gfx/win/double_buffer.h"
+#include "nativeui/gfx/win/gdiplus.h"
+#include "nativeui/gfx/win/painter_d2d.h"
 #include "nativeui/gfx/win/painter_win.h"
+#include "nativeui/screen.h"
 #include "nativeui/state.h"
 #include "nativeui/win/util/subwin_holder.h"
 
 namespace nu {
 
+Canvas::Canvas(const SizeF& size, float scale_factor, bool direct2d)
+    : Canvas(size, scale_factor) {
+  if (direct2d) {
+    direct2d_ = true;
+    // The painter lives with the canvas, so it can not borrow the shared
+    // render target.
+    painter_.reset(new PainterD2D(bitmap_->dc(), nu::Rect(bitmap_->size()),
+                                  scale_factor, false));
+  }
+}
+
+Canvas::Canvas(const SizeF& size, Window* window)
+    : Canvas(size,
+             Screen::GetCurrent()->GetDisplayNearestWindow(window).scale_factor,
+             true) {
+  // Windows are painted into memory bitmaps, so the best we can do is to
+  // upload the pixels to Direct2D without converting with GDI+.
+  shared_ = true;
+}
+
+NativeBitmap Canvas::GetBitmap() const {
+  if (direct2d_)
+    static_cast<PainterD2D*>(painter_.get())->Flush();
+  return bitmap_;
+}
+
+CanvasPixels Canvas::LockPixels() {
+  DoubleBuffer* bitmap = GetBitmap();
+  // Make sure pending GDI drawings are written to the bitmap.
+  ::GdiFlush();
+  CanvasPixels pixels;
+  pixels.size = bitmap->size();
+  pixels.stride = pixels.size.width() * 4;
+  pixels.buffer = Buffer::Wrap(bitmap->bits(),
+                               pixels.stride * pixels.size.height());
+  return pixels;
+}
+
+void Canvas::UnlockPixels() {
+}
+
+ID2D1Bitmap* Canvas::GetDirect2DBitmap(ID2D1RenderTarget* target) {
+  DoubleBuffer* buffer = GetBitmap();
+  Size size = buffer->size();
+  // Bitmaps can only be drawn by the target that created them.
+  if (d2d_target_.Get() != target) {
+    d2d_target_ = target;
+    d2d_bitmap_.Reset();
+  }
+  if (!d2d_bitmap_) {
+    HRESULT hr = target->CreateBitmap(
+        D2D1::SizeU(size.width(), size.height()),
+        D2D1::BitmapProperties(
+            D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM,
+                              D2D1_ALPHA_MODE_PREMULTIPLIED),
+            96.f, 96.f),
+        &d2d_bitmap_);
+    if (FAILED(hr))
+      return nullptr;
+  }
+  if (shared_) {
+    // Shared canvases are painted with Direct2D, which writes premultiplied
+    // pixels that can be uploaded directly.
+    ::GdiFlush();
+    d2d_bitmap_->CopyFromMemory(nullptr, buffer->bits(), size.width() * 4);
+    return d2d_bitmap_.Get();
+  }
+  // GDI+ does not write the alpha channel of memory bitmap, so draw it into a
+  // premultiplied bitmap first.
+  std::unique_ptr<Gdiplus::Bitmap> source = buffer->GetGdiplusBitmap();
+  Gdiplus::Bitmap bitmap(size.width(), size.height(), PixelFormat32bppPARGB);
+  {
+    Gdiplus::Graphics graphics(&bitmap);
+    graphics.DrawImage(source.get(), 0, 0, size.width(), size.height());
+  }
+  Gdiplus::Rect rect(0, 0, size.width(), size.height());
+  Gdiplus::BitmapData data;
+  if (bitmap.LockBits(&rect, Gdiplus::ImageLockModeRead,
+                      PixelFormat32bppPARGB, &data) != Gdiplus::Ok)
+    return nullptr;
+  d2d_bitmap_->CopyFromMemory(nullptr, data.Scan0, data.Stride);
+  bitmap.UnlockBits(&data);
+  return d2d_bitmap_.Get();
+}
+
 // static
 NativeBitmap Canvas::PlatformCreateBitmap(const SizeF& size,
                                           float scale_factor) {
@@ -8,18 +8,19 @@ namespace nu {
 
 namespace {
 
-HBITMAP CreateBitmap(HDC dc, const Size& size) {
+HBITMAP CreateBitmap(HDC dc, const Size& size, void** bits) {
   BITMAPINFOHEADER bih = { 0 };
   bih.biBitCount = 32;
   bih.biSize = sizeof(BITMAPINFOHEADER);
   bih.biWidth = size.width();
-  bih.biHeight = size.height();
+  // Use top-down bitmap so pixels can be accessed in the same order with
+  // other platforms.
+  bih.biHeight = -size.height();
   bih.biPlanes = 1;
   bih.biSizeImage = size.width() * size.height() * 4;
   bih.biCompression = BI_RGB;
-  RGBQUAD* bits = nullptr;
   return ::CreateDIBSection(dc, reinterpret_cast<BITMAPINFO*>(&bih), 0,
-                            reinterpret_cast<void**>(&bits), NULL, 0);
+                            bits, NULL, 0);
 }
 
 }  // namespace
@@ -34,7 +35,7 @@ DoubleBuffer::DoubleBuffer(HDC dc, const Size& size, const Rect& src,
                            const Point& dest)
     : dc_(dc), size_(size), src_(src), dest_(dest),
       mem_dc_(::CreateCompatibleDC(dc)),
-      mem_bitmap_(CreateBitmap(dc, size)),
+      mem_bitmap_(CreateBitmap(dc, size, &bits_)),
       select_bitmap_(mem_dc_.Get(), mem_bitmap_.get()) {}
 
 DoubleBuffer::~DoubleBuffer() {
@@ -45,6 +46,11 @@ DoubleBuffer::~DoubleBuffer() {
   }
 }
 
+void DoubleBuffer::CopyTo(HDC dc, const Rect& rect) const {
+  BitBlt(dc, rect.x(), rect.y(), rect.width(), rect.height(),
+         mem_dc_.Get(), rect.x(), rect.y(), SRCCOPY);
+}
+
 std::unique_ptr<Gdiplus::Bitmap> DoubleBuffer::GetGdiplusBitmap() const {
   // Code from Microsoft/VSSDK-Extensibility-Samples:
   // ArchivedSamples/High-DPI_Images_Icons/Cpp/VsUIGdiplusImage.cpp
@@ -23,6 +23,10 @@ class DoubleBuffer {
 
   void SetNoCopy() { copy_on_destruction_ = false; }
 
+  // Copy the |rect| of buffer to the same position of |dc|, used when the
+  // buffer is kept and reused by multiple paints.
+  void CopyTo(HDC dc, const Rect& rect) const;
+
   // Return a GDI+ bitmap with alpha channel.
   //
   // Note that the memory bitmap does not have alpha channel in it, to get a
@@ -33,11 +37,16 @@ class DoubleBuffer {
   HDC dc() const { return mem_dc_.Get(); }
   Size size() const { return size_; }
 
+  // The pixels of buffer, which is stored top-down without padding.
+  void* bits() const { return bits_; }
+
  private:
   HDC dc_;
   Size size_;
   Rect src_;
   Point dest_;
+  // Must be declared before |mem_bitmap_|, which sets it when created.
+  void* bits_ = nullptr;
   base::win::ScopedCreateDC mem_dc_;
   base::win::ScopedBitmap mem_bitmap_;
   base::win::ScopedSelectObject select_bitmap_;
@@ -24,11 +24,11 @@ Font::Font() {
   SystemParametersInfoW(SPI_GETNONCLIENTMETRICS, sizeof(metrics), &metrics, 0);
 
   TEXTMETRIC fm;
-  hfont_.reset(::CreateFontIndirectW(&(metrics.lfMessageFont)));
+  base::win::ScopedHFONT hfont(::CreateFontIndirectW(&(metrics.lfMessageFont)));
 
   base::win::ScopedGetDC screen_dc(NULL);
   ScopedSetMapMode mode(screen_dc, MM_TEXT);
-  base::win::ScopedSelectObject scoped_font(screen_dc, hfont_.get());
+  base::win::ScopedSelectObject scoped_font(screen_dc, hfont.get());
   ::GetTextMetrics(screen_dc, &fm);
   float font_size = std::max<float>(1.f, fm.tmHeight - fm.tmInternalLeading);
 
@@ -53,9 +53,15 @@ Font::Font(const std::string& name, float size, Weight weight, Style style) {
                             Gdiplus::UnitPoint);
 }
 
-Font::Font(const base::FilePath& path, float size)
-    : font_collection_(new Gdiplus::PrivateFontCollection) {
+Font::Font(const base::FilePath& path, float size) {
+  // Use default font as fallback.
+  if (!ReadFromPath(path, size))
+    font_ = Default()->GetNative()->Clone();
+}
+
+bool Font::ReadFromPath(const base::FilePath& path, float size) {
   // Create font collection from path.
+  font_collection_.reset(new Gdiplus::PrivateFontCollection);
   font_collection_->AddFontFile(path.value().c_str());
   int count = font_collection_->GetFamilyCount();
   if (count > 0) {
@@ -71,16 +77,15 @@ Font::Font(const base::FilePath& path, float size)
                                   size * 72.f / 96.f,
                                   style,
                                   Gdiplus::UnitPoint);
-        return;
+        return true;
       }
     }
   }
-
-  // Use default font as fallback.
-  font_ = Default()->GetNative()->Clone();
+  return false;
 }
 
 Font::~Font() {
+  RemoveFromCache();
   delete font_;
 }
 
@@ -120,15 +125,19 @@ const std::wstring& Font::GetName16() const {
   return font_family_;
 }
 
-HFONT Font::GetHFONT(HWND hwnd) const {
-  if (!hfont_.is_valid()) {
-    base::win::ScopedGetDC dc(hwnd);
+HFONT Font::GetHFONT(float scale_factor) const {
+  base::win::ScopedHFONT& hfont = hfonts_[scale_factor];
+  if (!hfont.is_valid()) {
+    base::win::ScopedGetDC dc(NULL);
     Gdiplus::Graphics context(dc);
     LOGFONTW logfont;
     font_->GetLogFontW(&context, &logfont);
-    hfont_.reset(::CreateFontIndirect(&logfont));
+    // The height from GDI+ is computed for the DPI of screen.
+    logfont.lfHeight = -std::max(1, static_cast<int>(
+        GetSize() * scale_factor + 0.5f));
+    hfont.reset(::CreateFontIndirect(&logfont));
   }
-  return hfont_.get();
+  return hfont.get();
 }
 
 }  // namespace nu
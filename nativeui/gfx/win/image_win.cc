@@ -7,15 +7,44 @@
 #include <shlwapi.h>
 #include <wrl.h>
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "base/logging.h"
 #include "base/win/scoped_hglobal.h"
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/painter.h"
 #include "nativeui/gfx/win/double_buffer.h"
 #include "nativeui/gfx/win/gdiplus.h"
+#include "nativeui/gfx/win/painter_d2d.h"
 
 namespace nu {
 
+namespace {
+
+// Find the GDI+ encoder of |mime_type|.
+bool GetEncoderClsid(const wchar_t* mime_type, CLSID* clsid) {
+  UINT count = 0;
+  UINT size = 0;
+  if (Gdiplus::GetImageEncodersSize(&count, &size) != Gdiplus::Ok || !size)
+    return false;
+  std::vector<BYTE> buffer(size);
+  auto* encoders = reinterpret_cast<Gdiplus::ImageCodecInfo*>(buffer.data());
+  if (Gdiplus::GetImageEncoders(count, size, encoders) != Gdiplus::Ok)
+    return false;
+  for (UINT i = 0; i < count; ++i) {
+    if (wcscmp(encoders[i].MimeType, mime_type) == 0) {
+      *clsid = encoders[i].Clsid;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 Image::Image() : image_(new Gdiplus::Image(L"")) {}
 
 Image::Image(const base::FilePath& path)
@@ -38,6 +67,119 @@ Image::~Image() {
   delete image_;
 }
 
+// static
+NativeImage Image::PlatformDecode(const std::string& data,
+                                  const SizeF& max_size,
+                                  float scale_factor) {
+  Microsoft::WRL::ComPtr<IStream> stream;
+  stream.Attach(::SHCreateMemStream(reinterpret_cast<const BYTE*>(data.data()),
+                                    static_cast<UINT>(data.size())));
+  if (!stream)
+    return nullptr;
+  Gdiplus::Image image(stream.Get());
+  if (image.GetLastStatus() != Gdiplus::Ok ||
+      image.GetWidth() == 0 || image.GetHeight() == 0)
+    return nullptr;
+  SizeF size = GetDecodeSize(SizeF(image.GetWidth(), image.GetHeight()),
+                             max_size);
+  int width = static_cast<int>(size.width());
+  int height = static_cast<int>(size.height());
+  // Draw the first frame into a premultiplied bitmap, so the image is fully
+  // decoded and needs no conversion when drawing.
+  Gdiplus::Bitmap* bitmap =
+      new Gdiplus::Bitmap(width, height, PixelFormat32bppPARGB);
+  Gdiplus::Graphics graphics(bitmap);
+  graphics.SetCompositingMode(Gdiplus::CompositingModeSourceCopy);
+  graphics.SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic);
+  graphics.SetPixelOffsetMode(Gdiplus::PixelOffsetModeHalf);
+  if (graphics.DrawImage(&image, 0, 0, width, height) != Gdiplus::Ok) {
+    delete bitmap;
+    return nullptr;
+  }
+  return bitmap;
+}
+
+NativeImage Image::PlatformResize(const SizeF& size,
+                                  ImageQuality quality) const {
+  // Resize from the decoded frame to avoid decoding again.
+  Gdiplus::Image* source = GetCachedBitmap();
+  if (!source)
+    source = image_;
+  int width = static_cast<int>(size.width());
+  int height = static_cast<int>(size.height());
+  Gdiplus::Bitmap* bitmap =
+      new Gdiplus::Bitmap(width, height, PixelFormat32bppPARGB);
+  Gdiplus::Graphics graphics(bitmap);
+  graphics.SetCompositingMode(Gdiplus::CompositingModeSourceCopy);
+  switch (quality) {
+    case ImageQuality::Low:
+      graphics.SetInterpolationMode(Gdiplus::InterpolationModeNearestNeighbor);
+      break;
+    case ImageQuality::Medium:
+      graphics.SetInterpolationMode(
+          Gdiplus::InterpolationModeHighQualityBilinear);
+      break;
+    case ImageQuality::High:
+      graphics.SetInterpolationMode(
+          Gdiplus::InterpolationModeHighQualityBicubic);
+      break;
+  }
+  graphics.SetPixelOffsetMode(Gdiplus::PixelOffsetModeHalf);
+  // Clamp the edges so pixels outside the image are not blended in.
+  Gdiplus::ImageAttributes attributes;
+  attributes.SetWrapMode(Gdiplus::WrapModeTileFlipXY);
+  if (graphics.DrawImage(source, Gdiplus::Rect(0, 0, width, height),
+                         0, 0, static_cast<int>(source->GetWidth()),
+                         static_cast<int>(source->GetHeight()),
+                         Gdiplus::UnitPixel, &attributes) != Gdiplus::Ok) {
+    delete bitmap;
+    return nullptr;
+  }
+  return bitmap;
+}
+
+// static
+bool Image::PlatformEncode(const void* pixels,
+                           const Size& size,
+                           int stride,
+                           const std::string& format,
+                           const EncodeOptions& options,
+                           std::string* output) {
+  CLSID clsid;
+  if (!GetEncoderClsid(format == "jpeg" ? L"image/jpeg" :
+                       format == "png" ? L"image/png" : L"", &clsid))
+    return false;
+  Gdiplus::Bitmap bitmap(size.width(), size.height(), stride,
+                         PixelFormat32bppPARGB,
+                         static_cast<BYTE*>(const_cast<void*>(pixels)));
+  Microsoft::WRL::ComPtr<IStream> stream;
+  stream.Attach(::SHCreateMemStream(nullptr, 0));
+  if (!stream)
+    return false;
+  ULONG quality = static_cast<ULONG>(options.quality);
+  Gdiplus::EncoderParameters params;
+  params.Count = 1;
+  params.Parameter[0].Guid = Gdiplus::EncoderQuality;
+  params.Parameter[0].Type = Gdiplus::EncoderParameterValueTypeLong;
+  params.Parameter[0].NumberOfValues = 1;
+  params.Parameter[0].Value = &quality;
+  if (bitmap.Save(stream.Get(), &clsid,
+                  format == "jpeg" ? &params : nullptr) != Gdiplus::Ok)
+    return false;
+  STATSTG stat;
+  if (FAILED(stream->Stat(&stat, STATFLAG_NONAME)))
+    return false;
+  output->resize(static_cast<size_t>(stat.cbSize.QuadPart));
+  LARGE_INTEGER zero = {};
+  ULONG read = 0;
+  if (FAILED(stream->Seek(zero, STREAM_SEEK_SET, nullptr)) ||
+      FAILED(stream->Read(&(*output)[0], static_cast<ULONG>(output->size()),
+                          &read)) ||
+      read != output->size())
+    return false;
+  return true;
+}
+
 bool Image::IsEmpty() const {
   Gdiplus::Image* image = const_cast<Gdiplus::Image*>(image_);
   return image->GetWidth() == 0 || image->GetHeight() == 0;
@@ -49,6 +191,113 @@ SizeF Image::GetSize() const {
                    1.f / scale_factor_);
 }
 
+bool Image::IsAnimated() const {
+  InitFrames();
+  return frame_delays_.size() > 1;
+}
+
+int Image::AdvanceFrame() {
+  if (!IsAnimated())
+    return 0;
+  frame_ = (frame_ + 1) % static_cast<int>(frame_delays_.size());
+  return frame_delays_[frame_];
+}
+
+void Image::InitFrames() const {
+  if (frames_checked_)
+    return;
+  frames_checked_ = true;
+  if (IsEmpty())
+    return;
+  UINT frames_count = 1;
+  // Frame dimensions:
+  // frames[animation_frame_index][how_many_animation]
+  UINT dimensions_count = image_->GetFrameDimensionsCount();
+  if (dimensions_count > 0) {
+    // For GIF, only #0 is meaningful.
+    std::vector<GUID> ids(dimensions_count);
+    image_->GetFrameDimensionsList(ids.data(), dimensions_count);
+    frames_count = std::max(image_->GetFrameCount(&ids[0]), 1u);
+  }
+  frame_delays_.resize(frames_count, 100);
+  cached_bitmaps_.resize(frames_count);
+  device_bitmaps_.resize(frames_count);
+  d2d_bitmaps_.resize(frames_count);
+  if (frames_count < 2)
+    return;
+  // The delays are in units of 10ms.
+  UINT size = image_->GetPropertyItemSize(PropertyTagFrameDelay);
+  if (size == 0)
+    return;
+  std::unique_ptr<BYTE[]> buffer(new BYTE[size]);
+  auto* item = reinterpret_cast<Gdiplus::PropertyItem*>(buffer.get());
+  if (image_->GetPropertyItem(PropertyTagFrameDelay, size, item) !=
+      Gdiplus::Ok)
+    return;
+  auto* delays = static_cast<UINT*>(item->value);
+  UINT delays_count = std::min<UINT>(item->length / sizeof(UINT),
+                                     frames_count);
+  for (UINT i = 0; i < delays_count; ++i)
+    frame_delays_[i] = delays[i] * 10;
+}
+
+Gdiplus::Bitmap* Image::GetCachedBitmap() const {
+  InitFrames();
+  if (cached_bitmaps_.empty())
+    return nullptr;
+  UINT frame = GetActiveFrame();
+  std::unique_ptr<Gdiplus::Bitmap>& bitmap = cached_bitmaps_[frame];
+  if (bitmap)
+    return bitmap.get();
+  // Each frame is decoded only once, and shared by all players.
+  if (cached_bitmaps_.size() > 1)
+    image_->SelectActiveFrame(&Gdiplus::FrameDimensionTime, frame);
+  int width = static_cast<int>(image_->GetWidth());
+  int height = static_cast<int>(image_->GetHeight());
+  bitmap.reset(new Gdiplus::Bitmap(width, height, PixelFormat32bppPARGB));
+  Gdiplus::Graphics graphics(bitmap.get());
+  graphics.SetCompositingMode(Gdiplus::CompositingModeSourceCopy);
+  graphics.DrawImage(image_, 0, 0, width, height);
+  return bitmap.get();
+}
+
+Gdiplus::CachedBitmap* Image::GetDeviceBitmap(
+    Gdiplus::Graphics* graphics) const {
+  Gdiplus::Bitmap* bitmap = GetCachedBitmap();
+  if (!bitmap)
+    return nullptr;
+  std::unique_ptr<Gdiplus::CachedBitmap>& device_bitmap =
+      device_bitmaps_[GetActiveFrame()];
+  if (!device_bitmap) {
+    device_bitmap.reset(new Gdiplus::CachedBitmap(bitmap, graphics));
+    if (device_bitmap->GetLastStatus() != Gdiplus::Ok)
+      device_bitmap.reset();
+  }
+  return device_bitmap.get();
+}
+
+void Image::ResetDeviceBitmap() const {
+  if (!device_bitmaps_.empty())
+    device_bitmaps_[GetActiveFrame()].reset();
+}
+
+ID2D1Bitmap* Image::GetDirect2DBitmap(ID2D1RenderTarget* target) const {
+  Gdiplus::Bitmap* bitmap = GetCachedBitmap();
+  if (!bitmap)
+    return nullptr;
+  // Bitmaps can only be drawn by the target that created them.
+  if (d2d_target_.Get() != target) {
+    d2d_target_ = target;
+    for (Microsoft::WRL::ComPtr<ID2D1Bitmap>& d2d_bitmap : d2d_bitmaps_)
+      d2d_bitmap.Reset();
+  }
+  Microsoft::WRL::ComPtr<ID2D1Bitmap>& d2d_bitmap =
+      d2d_bitmaps_[GetActiveFrame()];
+  if (!d2d_bitmap)
+    d2d_bitmap = PainterD2D::CreateBitmapFromPARGB(target, bitmap);
+  return d2d_bitmap.Get();
+}
+
 base::win::ScopedHICON Image::GetHICON(const SizeF& size) const {
   scoped_refptr<Canvas> canvas = new Canvas(size);
   canvas->GetPainter()->DrawImage(this, RectF(size));
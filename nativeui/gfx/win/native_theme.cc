@@ -6,12 +6,17 @@
 #include "nativeui/gfx/win/native_theme.h"
 
 #include <stddef.h>
+#include <string.h>
 #include <vsstyle.h>
 #include <vssym32.h>
 
+#include <algorithm>
+
 #include "base/check_op.h"
 #include "base/notreached.h"
 #include "base/stl_util.h"
+#include "base/win/scoped_hdc.h"
+#include "base/win/scoped_select_object.h"
 
 namespace nu {
 
@@ -77,6 +82,73 @@ int GetWindowsState(NativeTheme::Part part, ControlState state) {
   }
 }
 
+// Larger parts like tab panels are drawn directly.
+const int kMaxCachedPartPixels = 64 * 1024;
+
+// The cache is cleared when it grows larger than this.
+const int kMaxCachedPixels = 4 * 1024 * 1024;
+
+// Return false if |part| can not be cached, otherwise put the fields of
+// |extra| used by |part| in |key|.
+bool GetExtraCacheKey(NativeTheme::Part part,
+                      const NativeTheme::ExtraParams& extra,
+                      int* key) {
+  switch (part) {
+    case NativeTheme::Part::Checkbox:
+    case NativeTheme::Part::Radio:
+    case NativeTheme::Part::Button:
+      *key = extra.button.checked |
+             (extra.button.indeterminate << 1) |
+             (extra.button.is_default << 2);
+      return true;
+    case NativeTheme::Part::ScrollbarUpArrow:
+    case NativeTheme::Part::ScrollbarDownArrow:
+    case NativeTheme::Part::ScrollbarLeftArrow:
+    case NativeTheme::Part::ScrollbarRightArrow:
+      *key = extra.scrollbar_arrow.is_hovering;
+      return true;
+    case NativeTheme::Part::ScrollbarHorizontalThumb:
+    case NativeTheme::Part::ScrollbarVerticalThumb:
+    case NativeTheme::Part::ScrollbarHorizontalGripper:
+    case NativeTheme::Part::ScrollbarVerticalGripper:
+      *key = extra.scrollbar_thumb.is_hovering;
+      return true;
+    case NativeTheme::Part::ScrollbarHorizontalTrack:
+    case NativeTheme::Part::ScrollbarVerticalTrack:
+      *key = extra.scrollbar_track.is_upper;
+      return true;
+    case NativeTheme::Part::TabPanel:
+    case NativeTheme::Part::TabItem:
+      *key = 0;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether drawing to |hdc| goes through a scaling transform, in which case
+// PaintScaledTheme has to see the transform.
+bool HasScaledTransform(HDC hdc) {
+  XFORM transform;
+  if (!GetWorldTransform(hdc, &transform))
+    return false;
+  return transform.eM11 != 1 || transform.eM22 != 1 ||
+         transform.eM12 != 0 || transform.eM21 != 0;
+}
+
+HBITMAP CreateDIB(HDC hdc, const Size& size, uint8_t** bits) {
+  BITMAPINFOHEADER bih = { 0 };
+  bih.biSize = sizeof(BITMAPINFOHEADER);
+  bih.biWidth = size.width();
+  bih.biHeight = -size.height();
+  bih.biPlanes = 1;
+  bih.biBitCount = 32;
+  bih.biCompression = BI_RGB;
+  return ::CreateDIBSection(hdc, reinterpret_cast<BITMAPINFO*>(&bih),
+                            DIB_RGB_COLORS, reinterpret_cast<void**>(bits),
+                            NULL, 0);
+}
+
 }  // namespace
 
 NativeTheme::NativeTheme()
@@ -118,12 +190,93 @@ Size NativeTheme::GetThemePartSize(HDC hdc,
       return Size(size.cx, size.cy);
   }
 
-  return (part == Part::Checkbox || part == Part::Radio) ? Size(13, 13)
-                                                         : Size();
+  if (part == Part::Checkbox || part == Part::Radio)
+    return Size(13, 13);
+  else
+    return Size();
 }
 
 void NativeTheme::Paint(Part part, HDC hdc, ControlState state,
                         const Rect& rect, const ExtraParams& extra) {
+  if (!PaintCached(part, hdc, state, rect, extra))
+    PaintDirectly(part, hdc, state, rect, extra);
+}
+
+void NativeTheme::ThemeChanged() {
+  CloseHandles();
+  bitmap_cache_.clear();
+  cached_pixels_ = 0;
+}
+
+bool NativeTheme::PaintCached(Part part, HDC hdc, ControlState state,
+                              const Rect& rect, const ExtraParams& extra) {
+  CacheKey key = {part, state, rect.width(), rect.height(), 0, 0};
+  if (rect.IsEmpty() || rect.width() * rect.height() > kMaxCachedPartPixels ||
+      !GetExtraCacheKey(part, extra, &key.extra) || HasScaledTransform(hdc))
+    return false;
+  key.dpi = ::GetDeviceCaps(hdc, LOGPIXELSY);
+
+  auto it = bitmap_cache_.find(key);
+  if (it == bitmap_cache_.end()) {
+    HBITMAP bitmap = RenderBitmap(part, hdc, state, rect.size(), extra);
+    if (!bitmap)
+      return false;
+    int pixels = rect.width() * rect.height();
+    if (cached_pixels_ + pixels > kMaxCachedPixels) {
+      bitmap_cache_.clear();
+      cached_pixels_ = 0;
+    }
+    cached_pixels_ += pixels;
+    it = bitmap_cache_.emplace(key, base::win::ScopedBitmap(bitmap)).first;
+  }
+
+  base::win::ScopedCreateDC mem_dc(::CreateCompatibleDC(hdc));
+  base::win::ScopedSelectObject select_bitmap(mem_dc.Get(), it->second.get());
+  BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+  return ::AlphaBlend(hdc, rect.x(), rect.y(), rect.width(), rect.height(),
+                      mem_dc.Get(), 0, 0, rect.width(), rect.height(), blend);
+}
+
+HBITMAP NativeTheme::RenderBitmap(Part part, HDC hdc, ControlState state,
+                                  const Size& size,
+                                  const ExtraParams& extra) const {
+  // Render the part on black and on white, the difference between the two
+  // gives the alpha channel, and the one on black has premultiplied colors.
+  uint8_t* black = nullptr;
+  uint8_t* white = nullptr;
+  base::win::ScopedBitmap black_bitmap(CreateDIB(hdc, size, &black));
+  base::win::ScopedBitmap white_bitmap(CreateDIB(hdc, size, &white));
+  if (!black_bitmap.is_valid() || !white_bitmap.is_valid())
+    return NULL;
+  size_t bytes = size.width() * size.height() * 4;
+  memset(black, 0, bytes);
+  memset(white, 0xFF, bytes);
+  {
+    base::win::ScopedCreateDC mem_dc(::CreateCompatibleDC(hdc));
+    {
+      base::win::ScopedSelectObject select(mem_dc.Get(), black_bitmap.get());
+      PaintDirectly(part, mem_dc.Get(), state, Rect(size), extra);
+    }
+    {
+      base::win::ScopedSelectObject select(mem_dc.Get(), white_bitmap.get());
+      PaintDirectly(part, mem_dc.Get(), state, Rect(size), extra);
+    }
+  }
+  ::GdiFlush();
+
+  for (size_t i = 0; i < bytes; i += 4) {
+    int alpha = 255 - (white[i + 1] - black[i + 1]);
+    alpha = std::max(0, std::min(alpha, 255));
+    for (size_t c = 0; c < 3; ++c)
+      black[i + c] = std::min<int>(black[i + c], alpha);
+    black[i + 3] = alpha;
+  }
+  return black_bitmap.release();
+}
+
+void NativeTheme::PaintDirectly(Part part, HDC hdc, ControlState state,
+                                const Rect& rect,
+                                const ExtraParams& extra) const {
   switch (part) {
     case Part::Checkbox:
       PaintCheckbox(hdc, state, rect, extra.button);
@@ -614,6 +767,11 @@ HANDLE NativeTheme::GetThemeHandle(Part part) const {
   return handle;
 }
 
+void NativeTheme::OpenHandles() const {
+  for (int i = 0; i < static_cast<int>(Part::Count); ++i)
+    GetThemeHandle(static_cast<Part>(i));
+}
+
 void NativeTheme::CloseHandles() const {
   if (!close_theme_)
     return;
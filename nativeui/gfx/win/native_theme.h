@@ -15,8 +15,10 @@
 #include <uxtheme.h>  // NOLINT
 
 #include <map>
+#include <tuple>
 
 #include "base/macros.h"
+#include "base/win/scoped_gdi_object.h"
 #include "nativeui/gfx/color.h"
 #include "nativeui/gfx/geometry/rect.h"
 #include "nativeui/gfx/geometry/size.h"
@@ -100,7 +102,44 @@ class NativeTheme {
   void Paint(Part part, HDC hdc, ControlState state, const Rect& rect,
              const ExtraParams& extra);
 
+  // Drop the cached theme handles and bitmaps, called when the system theme
+  // has changed.
+  void ThemeChanged();
+
+  // Open the theme handles of all parts before the first paint.
+  void OpenHandles() const;
+
  private:
+  // Painted parts are cached as bitmaps with alpha channel, since calling
+  // uxtheme for each part on each paint is slow.
+  struct CacheKey {
+    Part part;
+    ControlState state;
+    int width;
+    int height;
+    int dpi;
+    int extra;  // the fields of ExtraParams that change how the part looks
+
+    bool operator<(const CacheKey& other) const {
+      return std::tie(part, state, width, height, dpi, extra) <
+             std::tie(other.part, other.state, other.width, other.height,
+                      other.dpi, other.extra);
+    }
+  };
+
+  // Draw the part from the bitmap cache, return false if the part can not be
+  // cached.
+  bool PaintCached(Part part, HDC hdc, ControlState state, const Rect& rect,
+                   const ExtraParams& extra);
+
+  // Render the part into a new bitmap with premultiplied alpha.
+  HBITMAP RenderBitmap(Part part, HDC hdc, ControlState state,
+                       const Size& size, const ExtraParams& extra) const;
+
+  // Call uxtheme or draw the classic controls.
+  void PaintDirectly(Part part, HDC hdc, ControlState state, const Rect& rect,
+                     const ExtraParams& extra) const;
+
   HRESULT PaintPushButton(HDC hdc,
                           ControlState state,
                           const Rect& rect,
@@ -216,6 +255,10 @@ class NativeTheme {
   // A cache of open theme handles.
   mutable HANDLE theme_handles_[static_cast<size_t>(Part::Count)];
 
+  // The rendered parts, and the total number of pixels they take.
+  std::map<CacheKey, base::win::ScopedBitmap> bitmap_cache_;
+  int cached_pixels_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(NativeTheme);
 };
 
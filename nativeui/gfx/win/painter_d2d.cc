@@ -0,0 +1,553 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/win/painter_d2d.h"
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <dwrite.h>
+
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "base/logging.h"
+#include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/font.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
+#include "nativeui/gfx/win/attributed_text_win.h"
+#include "nativeui/gfx/win/gdiplus.h"
+#include "nativeui/gfx/win/path_win.h"
+#include "nativeui/state.h"
+#include "nativeui/win/util/direct2d_holder.h"
+
+namespace nu {
+
+namespace {
+
+inline D2D1_POINT_2F ToD2D(const PointF& point) {
+  return D2D1::Point2F(point.x(), point.y());
+}
+
+inline D2D1_RECT_F ToD2D(const RectF& rect) {
+  return D2D1::RectF(rect.x(), rect.y(), rect.right(), rect.bottom());
+}
+
+inline D2D1_COLOR_F ToD2D(Color color) {
+  return D2D1::ColorF(color.r() / 255.f, color.g() / 255.f, color.b() / 255.f,
+                      color.a() / 255.f);
+}
+
+inline DWRITE_TEXT_ALIGNMENT ToDWrite(TextAlign align) {
+  switch (align) {
+    case TextAlign::Center: return DWRITE_TEXT_ALIGNMENT_CENTER;
+    case TextAlign::End: return DWRITE_TEXT_ALIGNMENT_TRAILING;
+    default: return DWRITE_TEXT_ALIGNMENT_LEADING;
+  }
+}
+
+inline DWRITE_PARAGRAPH_ALIGNMENT ToDWriteParagraph(TextAlign align) {
+  switch (align) {
+    case TextAlign::Center: return DWRITE_PARAGRAPH_ALIGNMENT_CENTER;
+    case TextAlign::End: return DWRITE_PARAGRAPH_ALIGNMENT_FAR;
+    default: return DWRITE_PARAGRAPH_ALIGNMENT_NEAR;
+  }
+}
+
+inline DWRITE_FONT_STYLE ToDWrite(Font::Style style) {
+  return style == Font::Style::Italic ? DWRITE_FONT_STYLE_ITALIC
+                                      : DWRITE_FONT_STYLE_NORMAL;
+}
+
+// The |end| of -1 means the rest of text, DirectWrite ignores the part of
+// range beyond the text.
+inline DWRITE_TEXT_RANGE ToDWrite(int start, int end) {
+  UINT32 length = end < 0 ? std::numeric_limits<UINT32>::max() - start
+                          : static_cast<UINT32>(end - start);
+  return {static_cast<UINT32>(start), length};
+}
+
+inline D2D1_POINT_2F PointOnArc(const PointF& center, float radius,
+                                float angle) {
+  return D2D1::Point2F(center.x() + radius * cosf(angle),
+                       center.y() + radius * sinf(angle));
+}
+
+}  // namespace
+
+PainterD2D::PainterD2D(HDC hdc, const nu::Rect& rect, float scale_factor,
+                       bool shared_target)
+    : hdc_(hdc),
+      rect_(rect.ToRECT()),
+      scale_factor_(scale_factor),
+      shared_target_(shared_target) {
+  states_.emplace();
+  CreateTarget();
+}
+
+PainterD2D::~PainterD2D() {
+  for (auto it = clips_.rbegin(); it != clips_.rend(); ++it)
+    PopClip(*it);
+  HRESULT hr = target_->EndDraw();
+  if (shared_target_)
+    State::GetCurrent()->GetDirect2DHolder()->ReleaseDCRenderTarget(
+        hr == D2DERR_RECREATE_TARGET);
+}
+
+void PainterD2D::Flush() {
+  // Clips must be popped before ending drawing.
+  for (auto it = clips_.rbegin(); it != clips_.rend(); ++it)
+    PopClip(*it);
+  if (target_->EndDraw() == D2DERR_RECREATE_TARGET) {
+    brush_.Reset();
+    for (ClipEntry& entry : clips_)
+      entry.layer.Reset();
+    if (shared_target_)
+      State::GetCurrent()->GetDirect2DHolder()->ReleaseDCRenderTarget(true);
+    target_.Reset();
+    CreateTarget();
+  } else {
+    target_->BeginDraw();
+  }
+  for (ClipEntry& entry : clips_)
+    PushClip(&entry);
+  target_->SetTransform(top().transform);
+}
+
+void PainterD2D::Save() {
+  states_.push(top());
+  top().clip_count = clips_.size();
+}
+
+void PainterD2D::Restore() {
+  if (states_.size() == 1)
+    return;
+  while (clips_.size() > top().clip_count) {
+    PopClip(clips_.back());
+    clips_.pop_back();
+  }
+  states_.pop();
+  target_->SetTransform(top().transform);
+}
+
+void PainterD2D::BeginPath() {
+  sink_.Reset();
+  path_.Reset();
+  in_figure_ = false;
+  has_current_point_ = false;
+}
+
+void PainterD2D::ClosePath() {
+  if (!in_figure_)
+    return;
+  sink_->EndFigure(D2D1_FIGURE_END_CLOSED);
+  in_figure_ = false;
+  current_point_ = figure_start_;
+}
+
+void PainterD2D::MoveTo(const PointF& point) {
+  if (in_figure_) {
+    sink_->EndFigure(D2D1_FIGURE_END_OPEN);
+    in_figure_ = false;
+  }
+  has_current_point_ = true;
+  current_point_ = ToD2D(point);
+}
+
+void PainterD2D::LineTo(const PointF& point) {
+  if (!has_current_point_) {
+    MoveTo(point);
+    return;
+  }
+  EnsureFigure();
+  current_point_ = ToD2D(point);
+  sink_->AddLine(current_point_);
+}
+
+void PainterD2D::BezierCurveTo(const PointF& cp1,
+                               const PointF& cp2,
+                               const PointF& ep) {
+  if (!has_current_point_) {
+    MoveTo(ep);
+    return;
+  }
+  EnsureFigure();
+  current_point_ = ToD2D(ep);
+  sink_->AddBezier(D2D1::BezierSegment(ToD2D(cp1), ToD2D(cp2),
+                                       current_point_));
+}
+
+void PainterD2D::Arc(const PointF& point, float radius, float sa, float ea) {
+  // Normalize the angle, same with PainterWin.
+  if (ea < sa) {
+    while (ea <= sa)
+      ea += 2.0f * static_cast<float>(M_PI);
+  }
+  float angle = ea - sa;
+
+  // Connect current point to the start of arc.
+  D2D1_POINT_2F start = PointOnArc(point, radius, sa);
+  if (has_current_point_) {
+    EnsureFigure();
+    sink_->AddLine(start);
+  } else {
+    has_current_point_ = true;
+  }
+  current_point_ = start;
+  EnsureFigure();
+
+  // An arc segment can not describe a full circle, so split large arcs.
+  int segments = angle > static_cast<float>(M_PI) ? 2 : 1;
+  for (int i = 1; i <= segments; ++i) {
+    current_point_ = PointOnArc(point, radius, sa + angle * i / segments);
+    sink_->AddArc(D2D1::ArcSegment(current_point_,
+                                   D2D1::SizeF(radius, radius),
+                                   0.f,
+                                   D2D1_SWEEP_DIRECTION_CLOCKWISE,
+                                   D2D1_ARC_SIZE_SMALL));
+  }
+}
+
+void PainterD2D::Rect(const RectF& rect) {
+  MoveTo(rect.origin());
+  LineTo(rect.top_right());
+  LineTo(rect.bottom_right());
+  LineTo(rect.bottom_left());
+  ClosePath();
+  // Drawing rectangle should update current point.
+  MoveTo(rect.origin());
+}
+
+void PainterD2D::Clip() {
+  ClipEntry entry;
+  entry.transform = top().transform;
+  entry.rect = D2D1::InfiniteRect();
+  entry.geometry = TakePath();
+  // Clipping with empty path hides everything.
+  if (!entry.geometry)
+    entry.rect = D2D1::RectF();
+  PushClip(&entry);
+  clips_.push_back(std::move(entry));
+}
+
+void PainterD2D::ClipRect(const RectF& rect) {
+  ClipEntry entry;
+  entry.transform = top().transform;
+  entry.rect = ToD2D(rect);
+  PushClip(&entry);
+  clips_.push_back(std::move(entry));
+}
+
+void PainterD2D::Translate(const Vector2dF& offset) {
+  top().transform = D2D1::Matrix3x2F::Translation(offset.x(), offset.y()) *
+                    top().transform;
+  target_->SetTransform(top().transform);
+}
+
+void PainterD2D::Rotate(float angle) {
+  top().transform = D2D1::Matrix3x2F::Rotation(angle / M_PI * 180.0f) *
+                    top().transform;
+  target_->SetTransform(top().transform);
+}
+
+void PainterD2D::Scale(const Vector2dF& scale) {
+  top().transform = D2D1::Matrix3x2F::Scale(scale.x(), scale.y()) *
+                    top().transform;
+  target_->SetTransform(top().transform);
+}
+
+void PainterD2D::SetColor(Color color) {
+  top().stroke_color = color;
+  top().fill_color = color;
+}
+
+void PainterD2D::SetStrokeColor(Color color) {
+  top().stroke_color = color;
+}
+
+void PainterD2D::SetFillColor(Color color) {
+  top().fill_color = color;
+}
+
+void PainterD2D::SetLineWidth(float width) {
+  top().line_width = width;
+}
+
+void PainterD2D::Stroke() {
+  Microsoft::WRL::ComPtr<ID2D1PathGeometry> path = TakePath();
+  if (path)
+    target_->DrawGeometry(path.Get(), GetBrush(top().stroke_color),
+                          top().line_width);
+}
+
+void PainterD2D::Fill() {
+  Microsoft::WRL::ComPtr<ID2D1PathGeometry> path = TakePath();
+  if (path)
+    target_->FillGeometry(path.Get(), GetBrush(top().fill_color));
+}
+
+void PainterD2D::StrokePath(Path* path) {
+  ID2D1PathGeometry* geometry = GetGeometry(path);
+  if (geometry)
+    target_->DrawGeometry(geometry, GetBrush(top().stroke_color),
+                          top().line_width);
+}
+
+void PainterD2D::FillPath(Path* path) {
+  ID2D1PathGeometry* geometry = GetGeometry(path);
+  if (geometry)
+    target_->FillGeometry(geometry, GetBrush(top().fill_color));
+}
+
+void PainterD2D::Clear() {
+  target_->Clear(D2D1::ColorF(0, 0, 0, 0));
+}
+
+void PainterD2D::StrokeRect(const RectF& rect) {
+  target_->DrawRectangle(ToD2D(rect), GetBrush(top().stroke_color),
+                         top().line_width);
+  // Should clear current path.
+  BeginPath();
+}
+
+void PainterD2D::FillRect(const RectF& rect) {
+  target_->FillRectangle(ToD2D(rect), GetBrush(top().fill_color));
+  // Should clear current path.
+  BeginPath();
+}
+
+void PainterD2D::DrawImage(const Image* image, const RectF& rect) {
+  image = image->GetMipmapFor(rect, nullptr);
+  Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap = GetBitmap(image);
+  if (bitmap)
+    target_->DrawBitmap(bitmap.Get(), ToD2D(rect));
+}
+
+void PainterD2D::DrawImageFromRect(const Image* image, const RectF& src,
+                                   const RectF& dest) {
+  RectF level_src(src);
+  image = image->GetMipmapFor(dest, &level_src);
+  Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap = GetBitmap(image);
+  if (!bitmap)
+    return;
+  // The bitmap is created with 96 DPI, so the source rect is in pixels.
+  D2D1_RECT_F ps = ToD2D(ScaleRect(level_src, image->GetScaleFactor()));
+  target_->DrawBitmap(bitmap.Get(), ToD2D(dest), 1.f,
+                      D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, &ps);
+}
+
+void PainterD2D::DrawCanvas(Canvas* canvas, const RectF& rect) {
+  ID2D1Bitmap* bitmap = canvas->GetDirect2DBitmap(target_.Get());
+  if (bitmap)
+    target_->DrawBitmap(bitmap, ToD2D(rect));
+}
+
+void PainterD2D::DrawCanvasFromRect(Canvas* canvas, const RectF& src,
+                                    const RectF& dest) {
+  ID2D1Bitmap* bitmap = canvas->GetDirect2DBitmap(target_.Get());
+  if (!bitmap)
+    return;
+  D2D1_RECT_F ps = ToD2D(ScaleRect(src, canvas->GetScaleFactor()));
+  target_->DrawBitmap(bitmap, ToD2D(dest), 1.f,
+                      D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, &ps);
+}
+
+void PainterD2D::DrawAttributedText(scoped_refptr<AttributedText> text,
+                                    const RectF& rect) {
+  AttributedTextImpl* str = text->GetNative();
+  const TextFormat& format = text->GetFormat();
+  Direct2DHolder* holder = State::GetCurrent()->GetDirect2DHolder();
+  IDWriteTextFormat* text_format = holder->GetTextFormat(str->font.get());
+  if (!text_format)
+    return;
+
+  // The text format is shared, so the paragraph format and attributes of
+  // ranges are applied to the layout.
+  IDWriteFactory* factory = holder->dwrite_factory();
+  Microsoft::WRL::ComPtr<IDWriteTextLayout> layout;
+  HRESULT hr = factory->CreateTextLayout(
+      str->text.data(), static_cast<UINT32>(str->text.size()), text_format,
+      rect.width(), rect.height(), &layout);
+  if (FAILED(hr)) {
+    LOG(ERROR) << "Failed to create text layout: " << hr;
+    return;
+  }
+  layout->SetTextAlignment(ToDWrite(format.align));
+  layout->SetParagraphAlignment(ToDWriteParagraph(format.valign));
+  layout->SetWordWrapping(format.wrap ? DWRITE_WORD_WRAPPING_WRAP
+                                      : DWRITE_WORD_WRAPPING_NO_WRAP);
+  if (format.ellipsis) {
+    Microsoft::WRL::ComPtr<IDWriteInlineObject> sign;
+    if (SUCCEEDED(factory->CreateEllipsisTrimmingSign(layout.Get(), &sign))) {
+      DWRITE_TRIMMING trimming = {DWRITE_TRIMMING_GRANULARITY_CHARACTER, 0, 0};
+      layout->SetTrimming(&trimming, sign.Get());
+    }
+  }
+  for (const AttributedTextImpl::FontRange& range : str->font_ranges) {
+    DWRITE_TEXT_RANGE text_range = ToDWrite(range.start, range.end);
+    Font* font = range.font.get();
+    layout->SetFontFamilyName(font->GetName16().c_str(), text_range);
+    layout->SetFontSize(font->GetSize(), text_range);
+    layout->SetFontWeight(static_cast<DWRITE_FONT_WEIGHT>(font->GetWeight()),
+                          text_range);
+    layout->SetFontStyle(ToDWrite(font->GetStyle()), text_range);
+  }
+  // The layout keeps references to the brushes of ranges.
+  for (const AttributedTextImpl::ColorRange& range : str->color_ranges) {
+    Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> brush;
+    if (SUCCEEDED(target_->CreateSolidColorBrush(ToD2D(range.color),
+                                                 &brush)))
+      layout->SetDrawingEffect(brush.Get(), ToDWrite(range.start, range.end));
+  }
+
+  Gdiplus::Color color;
+  str->brush->GetColor(&color);
+  target_->DrawTextLayout(ToD2D(rect.origin()), layout.Get(),
+                          GetBrush(Color(color.GetValue())));
+}
+
+void PainterD2D::CreateTarget() {
+  Direct2DHolder* holder = State::GetCurrent()->GetDirect2DHolder();
+  if (shared_target_)
+    target_ = holder->AcquireDCRenderTarget();
+  // Another painter is drawing with the shared target.
+  if (!target_) {
+    shared_target_ = false;
+    target_ = holder->CreateDCRenderTarget();
+  }
+  // Use the DPI of scale factor so drawing is done in DIPs.
+  target_->SetDpi(96.f * scale_factor_, 96.f * scale_factor_);
+  target_->BindDC(hdc_, &rect_);
+  target_->BeginDraw();
+  target_->SetTransform(top().transform);
+}
+
+void PainterD2D::EnsureFigure() {
+  if (in_figure_)
+    return;
+  if (!sink_) {
+    ID2D1Factory* factory =
+        State::GetCurrent()->GetDirect2DHolder()->d2d_factory();
+    factory->CreatePathGeometry(&path_);
+    path_->Open(&sink_);
+  }
+  sink_->BeginFigure(current_point_, D2D1_FIGURE_BEGIN_FILLED);
+  in_figure_ = true;
+  figure_start_ = current_point_;
+}
+
+Microsoft::WRL::ComPtr<ID2D1PathGeometry> PainterD2D::TakePath() {
+  Microsoft::WRL::ComPtr<ID2D1PathGeometry> path;
+  if (sink_) {
+    if (in_figure_)
+      sink_->EndFigure(D2D1_FIGURE_END_OPEN);
+    sink_->Close();
+    path = std::move(path_);
+  }
+  BeginPath();
+  return path;
+}
+
+ID2D1PathGeometry* PainterD2D::GetGeometry(Path* path) {
+  PathImpl* impl = path->GetNative();
+  if (impl->geometry)
+    return impl->geometry.Get();
+  // Build the geometry with the path methods of this painter, and then
+  // restore current path. The geometry does not depend on the render target
+  // so it can be shared by all painters.
+  Microsoft::WRL::ComPtr<ID2D1PathGeometry> current_path = std::move(path_);
+  Microsoft::WRL::ComPtr<ID2D1GeometrySink> current_sink = std::move(sink_);
+  bool in_figure = in_figure_;
+  bool has_current_point = has_current_point_;
+  D2D1_POINT_2F current_point = current_point_;
+  D2D1_POINT_2F figure_start = figure_start_;
+  BeginPath();
+  path->AddTo(this);
+  impl->geometry = TakePath();
+  path_ = std::move(current_path);
+  sink_ = std::move(current_sink);
+  in_figure_ = in_figure;
+  has_current_point_ = has_current_point;
+  current_point_ = current_point;
+  figure_start_ = figure_start;
+  return impl->geometry.Get();
+}
+
+ID2D1SolidColorBrush* PainterD2D::GetBrush(Color color) {
+  if (brush_)
+    brush_->SetColor(ToD2D(color));
+  else
+    target_->CreateSolidColorBrush(ToD2D(color), &brush_);
+  return brush_.Get();
+}
+
+// static
+Microsoft::WRL::ComPtr<ID2D1Bitmap> PainterD2D::CreateBitmapFromPARGB(
+    ID2D1RenderTarget* target,
+    Gdiplus::Bitmap* bitmap) {
+  UINT width = bitmap->GetWidth();
+  UINT height = bitmap->GetHeight();
+  Gdiplus::Rect rect(0, 0, width, height);
+  Gdiplus::BitmapData data;
+  if (bitmap->LockBits(&rect, Gdiplus::ImageLockModeRead,
+                       PixelFormat32bppPARGB, &data) != Gdiplus::Ok)
+    return nullptr;
+  Microsoft::WRL::ComPtr<ID2D1Bitmap> result;
+  target->CreateBitmap(
+      D2D1::SizeU(width, height), data.Scan0, data.Stride,
+      D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM,
+                                               D2D1_ALPHA_MODE_PREMULTIPLIED),
+                             96.f, 96.f),
+      &result);
+  bitmap->UnlockBits(&data);
+  return result;
+}
+
+Microsoft::WRL::ComPtr<ID2D1Bitmap> PainterD2D::GetBitmap(const Image* image) {
+  ID2D1Bitmap* cached = image->GetDirect2DBitmap(target_.Get());
+  if (cached)
+    return cached;
+  return CreateBitmap(image->GetNative());
+}
+
+Microsoft::WRL::ComPtr<ID2D1Bitmap> PainterD2D::CreateBitmap(
+    Gdiplus::Image* image) {
+  // Draw the image into a premultiplied bitmap, which is the only format
+  // accepted by the render target.
+  UINT width = image->GetWidth();
+  UINT height = image->GetHeight();
+  Gdiplus::Bitmap bitmap(width, height, PixelFormat32bppPARGB);
+  {
+    Gdiplus::Graphics graphics(&bitmap);
+    graphics.DrawImage(image, 0, 0, width, height);
+  }
+  return CreateBitmapFromPARGB(target_.Get(), &bitmap);
+}
+
+void PainterD2D::PushClip(ClipEntry* entry) {
+  target_->SetTransform(entry->transform);
+  if (entry->geometry) {
+    // The layer is created lazily, and after the target is recreated.
+    if (!entry->layer)
+      target_->CreateLayer(&entry->layer);
+    target_->PushLayer(
+        D2D1::LayerParameters(D2D1::InfiniteRect(), entry->geometry.Get()),
+        entry->layer.Get());
+  } else {
+    target_->PushAxisAlignedClip(entry->rect, D2D1_ANTIALIAS_MODE_ALIASED);
+  }
+  target_->SetTransform(top().transform);
+}
+
+void PainterD2D::PopClip(const ClipEntry& entry) {
+  if (entry.geometry)
+    target_->PopLayer();
+  else
+    target_->PopAxisAlignedClip();
+}
+
+}  // namespace nu
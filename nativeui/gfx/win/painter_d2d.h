@@ -0,0 +1,157 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_WIN_PAINTER_D2D_H_
+#define NATIVEUI_GFX_WIN_PAINTER_D2D_H_
+
+#include <d2d1.h>
+#include <wrl/client.h>
+
+#include <stack>
+#include <vector>
+
+#include "nativeui/gfx/painter.h"
+
+namespace Gdiplus {
+class Bitmap;
+class Image;
+}
+
+namespace nu {
+
+// Painter implemented with Direct2D and DirectWrite, the drawing is done by
+// GPU when hardware acceleration is available.
+//
+// The coordinates are in DIPs, the DPI of render target is set from the scale
+// factor so there is no need to scale the values manually.
+class PainterD2D : public Painter {
+ public:
+  // Paint on the |rect| of HDC, the |rect| is in pixels.
+  //
+  // When |shared_target| is true the render target shared by painters is
+  // borrowed, so bitmaps cached for it can be reused, which should only be
+  // done by painters that are destroyed right after painting.
+  PainterD2D(HDC hdc, const nu::Rect& rect, float scale_factor,
+             bool shared_target);
+  // The drawing is submitted to HDC when the painter is destroyed.
+  ~PainterD2D() override;
+
+  // Submit current drawing to HDC, used when the painter is kept for a long
+  // time like in Canvas.
+  void Flush();
+
+  // Painter:
+  void Save() override;
+  void Restore() override;
+  void BeginPath() override;
+  void ClosePath() override;
+  void MoveTo(const PointF& point) override;
+  void LineTo(const PointF& point) override;
+  void BezierCurveTo(const PointF& cp1,
+                     const PointF& cp2,
+                     const PointF& ep) override;
+  void Arc(const PointF& point, float radius, float sa, float ea) override;
+  void Rect(const RectF& rect) override;
+  void Clip() override;
+  void ClipRect(const RectF& rect) override;
+  void Translate(const Vector2dF& offset) override;
+  void Rotate(float angle) override;
+  void Scale(const Vector2dF& scale) override;
+  void SetColor(Color color) override;
+  void SetStrokeColor(Color color) override;
+  void SetFillColor(Color color) override;
+  void SetLineWidth(float width) override;
+  void Stroke() override;
+  void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
+  void Clear() override;
+  void StrokeRect(const RectF& rect) override;
+  void FillRect(const RectF& rect) override;
+  void DrawImage(const Image* image, const RectF& rect) override;
+  void DrawImageFromRect(const Image* image, const RectF& src,
+                         const RectF& dest) override;
+  void DrawCanvas(Canvas* canvas, const RectF& rect) override;
+  void DrawCanvasFromRect(Canvas* canvas, const RectF& src,
+                          const RectF& dest) override;
+  void DrawAttributedText(scoped_refptr<AttributedText> text,
+                          const RectF& rect) override;
+
+  // Internal: Upload the pixels of premultiplied |bitmap| to |target|.
+  static Microsoft::WRL::ComPtr<ID2D1Bitmap> CreateBitmapFromPARGB(
+      ID2D1RenderTarget* target,
+      Gdiplus::Bitmap* bitmap);
+
+ private:
+  // Create the render target and start drawing.
+  void CreateTarget();
+
+  // Begin a figure at current point if there is no one.
+  void EnsureFigure();
+
+  // Close the geometry sink and return current path, the path is reset.
+  Microsoft::WRL::ComPtr<ID2D1PathGeometry> TakePath();
+
+  // Return the cached geometry of |path|, build it if not cached.
+  ID2D1PathGeometry* GetGeometry(Path* path);
+
+  // Return the shared brush with |color|.
+  ID2D1SolidColorBrush* GetBrush(Color color);
+
+  // Return the bitmap of image cached for current target, and convert the
+  // GDI+ image when there is no cache.
+  Microsoft::WRL::ComPtr<ID2D1Bitmap> GetBitmap(const Image* image);
+  Microsoft::WRL::ComPtr<ID2D1Bitmap> CreateBitmap(Gdiplus::Image* image);
+
+  // The clip that has been pushed to render target, recorded so they can be
+  // pushed again after flushing.
+  struct ClipEntry {
+    D2D1::Matrix3x2F transform;
+    D2D1_RECT_F rect;
+    // Clip by path is implemented with layer.
+    Microsoft::WRL::ComPtr<ID2D1PathGeometry> geometry;
+    Microsoft::WRL::ComPtr<ID2D1Layer> layer;
+  };
+  void PushClip(ClipEntry* entry);
+  void PopClip(const ClipEntry& entry);
+
+  // The saved state.
+  struct PainterState {
+    D2D1::Matrix3x2F transform = D2D1::Matrix3x2F::Identity();
+    float line_width = 1.f;
+    Color stroke_color;
+    Color fill_color;
+    // Number of clips when the state was saved.
+    size_t clip_count = 0;
+  };
+
+  // Return the top state.
+  PainterState& top() { return states_.top(); }
+
+  // The stack for all saved states.
+  std::stack<PainterState> states_;
+
+  // The clips in the order of pushing.
+  std::vector<ClipEntry> clips_;
+
+  HDC hdc_;
+  RECT rect_;
+  float scale_factor_;
+  bool shared_target_;
+
+  Microsoft::WRL::ComPtr<ID2D1DCRenderTarget> target_;
+  Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> brush_;
+
+  // Current path.
+  Microsoft::WRL::ComPtr<ID2D1PathGeometry> path_;
+  Microsoft::WRL::ComPtr<ID2D1GeometrySink> sink_;
+  bool in_figure_ = false;
+  bool has_current_point_ = false;
+  D2D1_POINT_2F current_point_ = {0, 0};
+  D2D1_POINT_2F figure_start_ = {0, 0};
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_WIN_PAINTER_D2D_H_
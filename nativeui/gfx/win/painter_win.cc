@@ -7,6 +7,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include <cmath>
 #include <memory>
 #include <utility>
 
@@ -20,12 +21,35 @@
 #include "nativeui/gfx/geometry/size_conversions.h"
 #include "nativeui/gfx/geometry/vector2d_conversions.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/path.h"
 #include "nativeui/gfx/win/attributed_text_win.h"
 #include "nativeui/gfx/win/double_buffer.h"
+#include "nativeui/gfx/win/path_win.h"
 #include "nativeui/state.h"
 
 namespace nu {
 
+namespace {
+
+// Whether |bitmap| would be drawn to |dest| in its original size, which allows
+// drawing with CachedBitmap.
+bool IsDrawingUnscaled(Gdiplus::Graphics* graphics,
+                       Gdiplus::Bitmap* bitmap,
+                       const Gdiplus::RectF& dest) {
+  if (dest.Width != bitmap->GetWidth() || dest.Height != bitmap->GetHeight() ||
+      dest.X != std::round(dest.X) || dest.Y != std::round(dest.Y))
+    return false;
+  // CachedBitmap only supports translation.
+  Gdiplus::Matrix matrix;
+  graphics->GetTransform(&matrix);
+  Gdiplus::REAL m[6];
+  matrix.GetElements(m);
+  return m[0] == 1 && m[1] == 0 && m[2] == 0 && m[3] == 1 &&
+         m[4] == std::round(m[4]) && m[5] == std::round(m[5]);
+}
+
+}  // namespace
+
 PainterWin::PainterWin(HDC hdc, Size size, float scale_factor)
     : graphics_(hdc), scale_factor_(scale_factor) {
   Initialize(std::move(size), scale_factor);
@@ -148,6 +172,16 @@ void PainterWin::Fill() {
   path_.Reset();
 }
 
+void PainterWin::StrokePath(Path* path) {
+  Gdiplus::Pen pen(ToGdi(top().stroke_color), top().line_width);
+  graphics_.DrawPath(&pen, GetGdiplusPath(path));
+}
+
+void PainterWin::FillPath(Path* path) {
+  Gdiplus::SolidBrush brush(ToGdi(top().fill_color));
+  graphics_.FillPath(&brush, GetGdiplusPath(path));
+}
+
 void PainterWin::Clear() {
   auto state = graphics_.Save();
   Gdiplus::SolidBrush brush(Gdiplus::Color(0, 0, 0, 0));
@@ -165,14 +199,35 @@ void PainterWin::FillRect(const RectF& rect) {
 }
 
 void PainterWin::DrawImage(const Image* image, const RectF& rect) {
-  graphics_.DrawImage(image->GetNative(),
-                      ToGdi(ScaleRect(rect, scale_factor_)));
+  image = image->GetMipmapFor(rect, nullptr);
+  Gdiplus::RectF dest = ToGdi(ScaleRect(rect, scale_factor_));
+  Gdiplus::Bitmap* bitmap = image->GetCachedBitmap();
+  if (!bitmap) {
+    graphics_.DrawImage(image->GetNative(), dest);
+    return;
+  }
+  // Blit the device-dependent bitmap when possible.
+  if (IsDrawingUnscaled(&graphics_, bitmap, dest)) {
+    Gdiplus::CachedBitmap* cached = image->GetDeviceBitmap(&graphics_);
+    if (cached &&
+        graphics_.DrawCachedBitmap(cached,
+                                   static_cast<int>(dest.X),
+                                   static_cast<int>(dest.Y)) == Gdiplus::Ok)
+      return;
+    // The display format may have changed.
+    image->ResetDeviceBitmap();
+  }
+  graphics_.DrawImage(bitmap, dest);
 }
 
 void PainterWin::DrawImageFromRect(const Image* image, const RectF& src,
                                    const RectF& dest) {
-  RectF ps = ScaleRect(src, image->GetScaleFactor());
-  graphics_.DrawImage(image->GetNative(),
+  RectF level_src(src);
+  image = image->GetMipmapFor(dest, &level_src);
+  RectF ps = ScaleRect(level_src, image->GetScaleFactor());
+  Gdiplus::Bitmap* bitmap = image->GetCachedBitmap();
+  graphics_.DrawImage(bitmap ? static_cast<Gdiplus::Image*>(bitmap)
+                             : image->GetNative(),
                       ToGdi(ScaleRect(dest, scale_factor_)),
                       ps.x(), ps.y(), ps.width(), ps.height(),
                       Gdiplus::UnitPixel);
@@ -288,6 +343,27 @@ void PainterWin::FillRectPixel(const nu::Rect& rect) {
   path_.Reset();
 }
 
+HDC PainterWin::GetRawHDC() {
+  return graphics_.GetHDC();
+}
+
+void PainterWin::ReleaseRawHDC(HDC hdc) {
+  graphics_.ReleaseHDC(hdc);
+}
+
+Vector2d PainterWin::GetTranslationPixel() {
+  Gdiplus::Matrix matrix;
+  graphics_.GetTransform(&matrix);
+  return Vector2d(static_cast<int>(std::round(matrix.OffsetX())),
+                  static_cast<int>(std::round(matrix.OffsetY())));
+}
+
+nu::Rect PainterWin::GetClipBoundsPixel() {
+  Gdiplus::Rect bounds;
+  graphics_.GetClipBounds(&bounds);
+  return nu::Rect(bounds.X, bounds.Y, bounds.Width, bounds.Height);
+}
+
 void PainterWin::SaveWithSize(SizeF size) {
   SaveWithSize(ToRoundedSize(ScaleSize(size, scale_factor_)));
 }
@@ -318,6 +394,26 @@ bool PainterWin::GetCurrentPoint(Gdiplus::PointF* point) {
   return true;
 }
 
+Gdiplus::GraphicsPath* PainterWin::GetGdiplusPath(Path* path) {
+  PathImpl* impl = path->GetNative();
+  if (impl->gdi_path && impl->scale_factor == scale_factor_)
+    return impl->gdi_path.get();
+  // Build the path with the path methods of this painter so the result is the
+  // same with drawing current path, and then restore current path.
+  std::unique_ptr<Gdiplus::GraphicsPath> current(path_.Clone());
+  bool use_gdi_current_point = use_gdi_current_point_;
+  Gdiplus::PointF current_point = current_point_;
+  BeginPath();
+  path->AddTo(this);
+  impl->gdi_path.reset(path_.Clone());
+  impl->scale_factor = scale_factor_;
+  path_.Reset();
+  path_.AddPath(current.get(), FALSE);
+  use_gdi_current_point_ = use_gdi_current_point;
+  current_point_ = current_point;
+  return impl->gdi_path.get();
+}
+
 HDC PainterWin::GetHDC() {
   // Get the clip region of graphics.
   Gdiplus::Region clip;
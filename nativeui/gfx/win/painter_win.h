@@ -54,6 +54,8 @@ class PainterWin : public Painter {
   void SetLineWidth(float width) override;
   void Stroke() override;
   void Fill() override;
+  void StrokePath(Path* path) override;
+  void FillPath(Path* path) override;
   void Clear() override;
   void StrokeRect(const RectF& rect) override;
   void FillRect(const RectF& rect) override;
@@ -80,6 +82,17 @@ class PainterWin : public Painter {
   void StrokeRectPixel(const nu::Rect& rect);
   void FillRectPixel(const nu::Rect& rect);
 
+  // Internal: Return the HDC without applying clip and transform, used for
+  // binding other renderers like Direct2D to the same surface.
+  HDC GetRawHDC();
+  void ReleaseRawHDC(HDC hdc);
+
+  // Internal: Return current translation in pixels.
+  Vector2d GetTranslationPixel();
+
+  // Internal: Return the bounds of current clip in pixels.
+  nu::Rect GetClipBoundsPixel();
+
   // Internal: Save with the information of relevant size.
   void SaveWithSize(SizeF size);
   void SaveWithSize(Size size);
@@ -91,6 +104,9 @@ class PainterWin : public Painter {
   // Get current point.
   bool GetCurrentPoint(Gdiplus::PointF* point);
 
+  // Return the cached GDI+ path of |path|, build it if not cached.
+  Gdiplus::GraphicsPath* GetGdiplusPath(Path* path);
+
   // Receive the HDC that can be painted on.
   HDC GetHDC();
   void ReleaseHDC(HDC dc);
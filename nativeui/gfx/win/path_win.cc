@@ -0,0 +1,24 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/win/path_win.h"
+
+#include "nativeui/gfx/path.h"
+
+namespace nu {
+
+PathImpl::PathImpl() {}
+
+PathImpl::~PathImpl() {}
+
+NativePath Path::PlatformCreate() const {
+  return new PathImpl;
+}
+
+// static
+void Path::PlatformDestroy(NativePath path) {
+  delete path;
+}
+
+}  // namespace nu
@@ -0,0 +1,33 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_WIN_PATH_WIN_H_
+#define NATIVEUI_GFX_WIN_PATH_WIN_H_
+
+#include <d2d1.h>
+#include <wrl/client.h>
+
+#include <memory>
+
+#include "nativeui/gfx/win/gdiplus.h"
+
+namespace nu {
+
+// The native paths are built by the painters on first drawing, since they
+// depend on how the painters draw.
+struct PathImpl {
+  PathImpl();
+  ~PathImpl();
+
+  // Used by PainterWin, in pixels of |scale_factor|.
+  std::unique_ptr<Gdiplus::GraphicsPath> gdi_path;
+  float scale_factor = 0.f;
+
+  // Used by PainterD2D, in DIPs.
+  Microsoft::WRL::ComPtr<ID2D1PathGeometry> geometry;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_WIN_PATH_WIN_H_
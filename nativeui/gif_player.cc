@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "nativeui/gfx/image.h"
+#include "nativeui/util/frame_clock.h"
 
 namespace nu {
 
@@ -16,7 +17,9 @@ const char GifPlayer::kClassName[] = "GifPlayer";
 
 void GifPlayer::SetImage(scoped_refptr<Image> image) {
   image_ = std::move(image);
-  PlatformSetImage(image_.get());
+  SchedulePaint();
+  // Start animation by default.
+  SetAnimating(!!image_);
   UpdateDefaultStyle();
 }
 
@@ -35,7 +38,7 @@ void GifPlayer::SetAnimating(bool animates) {
   is_animating_ = animates;
   // Create a timer to play animation.
   if (is_animating_ && IsTreeVisible())
-    ScheduleFrame();
+    StartAnimationTimer();
 }
 
 bool GifPlayer::IsAnimating() const {
@@ -52,16 +55,27 @@ ImageScale GifPlayer::GetScale() const {
 }
 
 bool GifPlayer::IsPlaying() const {
-  return timer_ != 0;
+  return is_playing_;
 }
 
 void GifPlayer::StopAnimationTimer() {
-  if (timer_ != 0) {
-    MessageLoop::ClearTimeout(timer_);
-    timer_ = 0;
+  if (is_playing_) {
+    FrameClock::GetCurrent()->RemovePlayer(this);
+    is_playing_ = false;
   }
 }
 
+bool GifPlayer::CanAnimate() const {
+  return image_ && image_->IsAnimated();
+}
+
+void GifPlayer::StartAnimationTimer() {
+  if (is_playing_ || !is_animating_)
+    return;
+  is_playing_ = true;
+  FrameClock::GetCurrent()->AddPlayer(this);
+}
+
 void GifPlayer::Paint(Painter* painter) {
   // Calulate image position.
   RectF bounds = GetBounds();
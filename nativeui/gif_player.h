@@ -5,10 +5,7 @@
 #ifndef NATIVEUI_GIF_PLAYER_H_
 #define NATIVEUI_GIF_PLAYER_H_
 
-#include <memory>
-
 #include "nativeui/gfx/painter.h"
-#include "nativeui/message_loop.h"
 #include "nativeui/standard_enums.h"
 #include "nativeui/view.h"
 
@@ -43,8 +40,8 @@ class NATIVEUI_EXPORT GifPlayer : public View {
   // Internal: Whether the image can animate.
   bool CanAnimate() const;
 
-  // Internal: Schedule to draw next animation frame.
-  void ScheduleFrame();
+  // Internal: Start playing the animation with the shared frame clock.
+  void StartAnimationTimer();
 
   // View:
   const char* GetClassName() const override;
@@ -54,20 +51,7 @@ class NATIVEUI_EXPORT GifPlayer : public View {
   ~GifPlayer() override;
 
  private:
-  void PlatformSetImage(Image* image);
-
-#if defined(OS_MACOSX)
-  unsigned int frames_count_ = 0;
-  unsigned int frame_ = 0;
-  NSBitmapImageRep* animation_rep_ = nullptr;
-#elif defined(OS_WIN)
-  UINT frames_count_ = 0;
-  UINT frame_ = 0;
-  std::unique_ptr<BYTE[]> frame_delays_;
-#endif
-
-  MessageLoop::TimerId timer_ = 0;
-
+  bool is_playing_ = false;
   bool is_animating_ = false;
   ImageScale scale_ = ImageScale::None;
   scoped_refptr<Image> image_;
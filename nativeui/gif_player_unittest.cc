@@ -5,6 +5,7 @@
 #include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "nativeui/nativeui.h"
+#include "nativeui/util/frame_clock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 class GifPlayerTest : public testing::Test {
@@ -72,4 +73,18 @@ TEST_F(GifPlayerTest, HiddenView) {
   gif_->SetVisible(true);
   EXPECT_TRUE(gif_->IsPlaying());
 }
+
+TEST_F(GifPlayerTest, SharedAnimation) {
+  scoped_refptr<nu::GifPlayer> other = new nu::GifPlayer();
+  gif_->SetImage(animated_img_.get());
+  other->SetImage(animated_img_.get());
+  nu::FrameClock* clock = state_.GetFrameClock();
+  EXPECT_EQ(clock->GetAnimationCount(), 1);
+  EXPECT_EQ(clock->GetPlayerCount(), 2);
+  other->SetAnimating(false);
+  EXPECT_EQ(clock->GetPlayerCount(), 1);
+  other = nullptr;
+  gif_->SetImage(static_img_.get());
+  EXPECT_EQ(clock->GetAnimationCount(), 0);
+}
 #endif
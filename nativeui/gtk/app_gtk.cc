@@ -0,0 +1,41 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/app.h"
+
+#include <gio/gio.h>
+
+namespace nu {
+
+#if GLIB_CHECK_VERSION(2, 64, 0)
+namespace {
+
+// GMemoryMonitor reads the pressure stall information of kernel through the
+// low-memory-monitor service.
+void OnLowMemoryWarning(GMemoryMonitor* monitor,
+                        GMemoryMonitorWarningLevel level,
+                        App* app) {
+  app->NotifyMemoryPressure(level >= G_MEMORY_MONITOR_WARNING_LEVEL_CRITICAL);
+}
+
+}  // namespace
+#endif
+
+void App::PlatformInit() {
+#if GLIB_CHECK_VERSION(2, 64, 0)
+  memory_monitor_ = g_memory_monitor_dup_default();
+  memory_signal_ = g_signal_connect(memory_monitor_, "low-memory-warning",
+                                    G_CALLBACK(OnLowMemoryWarning), this);
+#endif
+}
+
+void App::PlatformDestroy() {
+  if (!memory_monitor_)
+    return;
+  g_signal_handler_disconnect(memory_monitor_, memory_signal_);
+  g_object_unref(memory_monitor_);
+  memory_monitor_ = nullptr;
+}
+
+}  // namespace nu
@@ -26,16 +26,24 @@ std::string JSStringToString(JSStringRef js) {
   return str;
 }
 
-base::Value JSResultToBaseValue(WebKitJavascriptResult* js_result) {
+// Serialize the result with the JSON serializer of JavaScriptCore, which does
+// not depend on the eval permission of page. Returns "null" for values that
+// can not be represented in JSON.
+std::string JSResultToJSON(WebKitJavascriptResult* js_result) {
   auto* context = webkit_javascript_result_get_global_context(js_result);
   auto* value = webkit_javascript_result_get_value(js_result);
-  // TODO(zcbenz): Convert types directly instead of using JSON parsing.
   JSStringRef json = JSValueCreateJSONString(context, value, 0, nullptr);
   if (!json)
-    return base::Value();
+    return "null";
   std::string json_str = JSStringToString(json);
   JSStringRelease(json);
-  base::Optional<base::Value> result = base::JSONReader::Read(json_str);
+  return json_str;
+}
+
+base::Value JSResultToBaseValue(WebKitJavascriptResult* js_result) {
+  // TODO(zcbenz): Convert types directly instead of using JSON parsing.
+  base::Optional<base::Value> result =
+      base::JSONReader::Read(JSResultToJSON(js_result));
   if (!result)
     return base::Value();
   return std::move(*result);
@@ -115,6 +123,20 @@ void OnJavaScriptFinish(WebKitWebView* webview,
   delete callback;
 }
 
+void OnJavaScriptRawFinish(WebKitWebView* webview,
+                           GAsyncResult* result,
+                           Browser::RawExecutionCallback* callback) {
+  auto* js_result = webkit_web_view_run_javascript_finish(
+      webview, result, nullptr);
+  if (js_result) {
+    (*callback)(true, JSResultToJSON(js_result));
+    webkit_javascript_result_unref(js_result);
+  } else {
+    (*callback)(false, std::string());
+  }
+  delete callback;
+}
+
 void OnScriptMessage(WebKitUserContentManager* manager,
                      WebKitJavascriptResult* js_result,
                      Browser* browser) {
@@ -138,6 +160,144 @@ void OnNullProtocolRequest(WebKitURISchemeRequest* request, gpointer) {
   g_error_free(error);
 }
 
+void OnContentBytesFree(gpointer data) {
+  delete static_cast<scoped_refptr<ProtocolJob>*>(data);
+}
+
+#if WEBKIT_CHECK_VERSION(2, 36, 0)
+std::string GetRequestHeader(WebKitURISchemeRequest* request,
+                             const char* name) {
+  SoupMessageHeaders* headers =
+      webkit_uri_scheme_request_get_http_headers(request);
+  const char* value = headers ? soup_message_headers_get_one(headers, name)
+                              : nullptr;
+  return value ? value : std::string();
+}
+#endif
+
+// Send the response of a started job, the references to |request| and
+// |protocol_stream| are taken.
+void FinishProtocolRequest(WebKitURISchemeRequest* request,
+                           ProtocolJob* protocol_job,
+                           GInputStream* protocol_stream,
+                           const std::string& mime_type,
+                           int size) {
+  // Serve content in memory directly, the bytes keep a reference to the
+  // job which owns the memory.
+  base::StringPiece content;
+  GInputStream* stream = protocol_stream;
+  bool in_memory = protocol_job->GetContent(&content);
+  bool not_modified = false;
+#if WEBKIT_CHECK_VERSION(2, 36, 0)
+  // Serve range requests, the stream can only be read to the end so ranges
+  // of content not in memory are extended to the end.
+  int64_t first = 0, last = 0;
+  bool ranged =
+      ProtocolJob::ParseRange(GetRequestHeader(request, "Range"), size,
+                              &first, &last) &&
+      (in_memory || protocol_job->Seek(first));
+  if (ranged && !in_memory)
+    last = size - 1;
+  if (ranged && in_memory)
+    content = content.substr(first, last - first + 1);
+  std::string etag;
+  not_modified = protocol_job->GetETag(&etag) &&
+                 GetRequestHeader(request, "If-None-Match") == etag;
+  if (not_modified)
+    content = base::StringPiece();
+#endif
+  if (in_memory) {
+    GBytes* bytes = g_bytes_new_with_free_func(
+        content.data(), content.size(), OnContentBytesFree,
+        new scoped_refptr<ProtocolJob>(protocol_job));
+    stream = g_memory_input_stream_new_from_bytes(bytes);
+    g_bytes_unref(bytes);
+    g_object_unref(protocol_stream);
+  } else if (not_modified) {
+    stream = g_memory_input_stream_new();
+    g_object_unref(protocol_stream);
+  }
+#if WEBKIT_CHECK_VERSION(2, 36, 0)
+  // Send headers for caching and ranges.
+  int64_t length = not_modified ? 0 : (ranged ? last - first + 1 : size);
+  WebKitURISchemeResponse* response =
+      webkit_uri_scheme_response_new(stream, length);
+  webkit_uri_scheme_response_set_status(
+      response, not_modified ? 304 : (ranged ? 206 : 200), nullptr);
+  if (!mime_type.empty())
+    webkit_uri_scheme_response_set_content_type(response,
+                                                mime_type.c_str());
+  SoupMessageHeaders* headers =
+      soup_message_headers_new(SOUP_MESSAGE_HEADERS_RESPONSE);
+  if (size > 0)
+    soup_message_headers_append(headers, "Accept-Ranges", "bytes");
+  if (ranged)
+    soup_message_headers_set_content_range(headers, first, last, size);
+  if (!etag.empty())
+    soup_message_headers_append(headers, "ETag", etag.c_str());
+  const std::string& cache_control = protocol_job->GetCacheControl();
+  if (!cache_control.empty())
+    soup_message_headers_append(headers, "Cache-Control",
+                                cache_control.c_str());
+  // The response takes the ownership of headers.
+  webkit_uri_scheme_response_set_http_headers(response, headers);
+  webkit_uri_scheme_request_finish_with_response(request, response);
+  g_object_unref(response);
+#else
+  webkit_uri_scheme_request_finish(
+      request, stream, size,
+      mime_type.empty() ? nullptr : mime_type.c_str());
+#endif
+  g_object_unref(stream);
+  g_object_unref(request);
+}
+
+void FailProtocolRequest(WebKitURISchemeRequest* request,
+                         GInputStream* protocol_stream) {
+  GError* error = g_error_new_literal(
+      g_quark_from_static_string("yue"),
+      WEBKIT_NETWORK_ERROR_FAILED,
+      "The protocol request job failed to start");
+  webkit_uri_scheme_request_finish_error(request, error);
+  g_error_free(error);
+  // Free on failure.
+  g_object_unref(protocol_stream);
+  g_object_unref(request);
+}
+
+// The request whose job is started in a worker thread.
+struct StartingRequest {
+  WebKitURISchemeRequest* request;
+  scoped_refptr<ProtocolJob> protocol_job;
+  GInputStream* protocol_stream;
+  std::string mime_type;
+  int size = -1;
+};
+
+void DeleteStartingRequest(gpointer data) {
+  delete static_cast<StartingRequest*>(data);
+}
+
+void StartProtocolJobInThread(GTask* task, gpointer, gpointer data,
+                              GCancellable*) {
+  auto* starting = static_cast<StartingRequest*>(data);
+  g_task_return_boolean(task, starting->protocol_job->Start());
+}
+
+void OnProtocolJobStarted(GObject*, GAsyncResult* result, gpointer) {
+  auto* starting =
+      static_cast<StartingRequest*>(g_task_get_task_data(G_TASK(result)));
+  if (g_task_propagate_boolean(G_TASK(result), nullptr)) {
+    FinishProtocolRequest(starting->request,
+                          starting->protocol_job.get(),
+                          starting->protocol_stream,
+                          starting->mime_type,
+                          starting->size);
+  } else {
+    FailProtocolRequest(starting->request, starting->protocol_stream);
+  }
+}
+
 void OnProtocolRequest(WebKitURISchemeRequest* request,
                        Browser::ProtocolHandler* handler) {
   // Create job.
@@ -152,31 +312,39 @@ void OnProtocolRequest(WebKitURISchemeRequest* request,
     g_error_free(error);
     return;
   }
-  // Manage the protocol_job with the stream.
-  // DO NOT pass protocol_job to the lambda, it would cause circular ref.
+  // Manage the protocol_job with the stream, which is read asynchronously by
+  // WebKit, and GIO runs the reads in its worker threads.
+  // DO NOT pass a reference of protocol_job to the lambda, it would cause
+  // circular ref.
   GInputStream* protocol_stream = nu_protocol_stream_new(protocol_job);
   std::string mime_type;
   protocol_job->GetMimeType(&mime_type);
-  // Start.
   g_object_ref(request);
-  protocol_job->Plug([protocol_stream, request, mime_type](int size) {
-    webkit_uri_scheme_request_finish(
-        request, protocol_stream, size,
-        mime_type.empty() ? nullptr : mime_type.c_str());
-    g_object_unref(protocol_stream);
-    g_object_unref(request);
-  });
-  if (!protocol_job->Start()) {
-    GError* error = g_error_new_literal(
-        g_quark_from_static_string("yue"),
-        WEBKIT_NETWORK_ERROR_FAILED,
-        "The protocol request job failed to start");
-    webkit_uri_scheme_request_finish_error(request, error);
-    g_error_free(error);
-    // Free on failure.
-    g_object_unref(protocol_stream);
-    g_object_unref(request);
+
+  // Jobs that may block are started in a worker thread, and the request is
+  // finished when the task returns to the main thread.
+  if (protocol_job->MayBlock()) {
+    auto* starting = new StartingRequest;
+    starting->request = request;
+    starting->protocol_job = protocol_job;
+    starting->protocol_stream = protocol_stream;
+    starting->mime_type = mime_type;
+    protocol_job->Plug([starting](int size) { starting->size = size; });
+    GTask* task = g_task_new(nullptr, nullptr, OnProtocolJobStarted, nullptr);
+    g_task_set_task_data(task, starting, DeleteStartingRequest);
+    g_task_run_in_thread(task, StartProtocolJobInThread);
+    g_object_unref(task);
+    return;
   }
+
+  // Start.
+  protocol_job->Plug([protocol_job, protocol_stream, request,
+                      mime_type](int size) {
+    FinishProtocolRequest(request, protocol_job, protocol_stream, mime_type,
+                          size);
+  });
+  if (!protocol_job->Start())
+    FailProtocolRequest(request, protocol_stream);
 }
 
 }  // namespace
@@ -273,6 +441,17 @@ void Browser::ExecuteJavaScript(const std::string& code,
       new ExecutionCallback(callback));
 }
 
+void Browser::PlatformExecuteJavaScriptRaw(
+    const std::string& code,
+    const RawExecutionCallback& callback) {
+  webkit_web_view_run_javascript(
+      WEBKIT_WEB_VIEW(GetNative()),
+      code.c_str(),
+      nullptr,
+      reinterpret_cast<GAsyncReadyCallback>(&OnJavaScriptRawFinish),
+      new RawExecutionCallback(callback));
+}
+
 void Browser::GoBack() {
   webkit_web_view_go_back(WEBKIT_WEB_VIEW(GetNative()));
 }
@@ -316,8 +495,8 @@ void Browser::PlatformUpdateBindings() {
 }
 
 // static
-bool Browser::RegisterProtocol(const std::string& scheme,
-                               const ProtocolHandler& handler) {
+bool Browser::PlatformRegisterProtocol(const std::string& scheme,
+                                       const ProtocolHandler& handler) {
   WebKitWebContext* context = webkit_web_context_get_default();
   webkit_web_context_register_uri_scheme(
       context,
@@ -329,7 +508,7 @@ bool Browser::RegisterProtocol(const std::string& scheme,
 }
 
 // static
-void Browser::UnregisterProtocol(const std::string& scheme) {
+void Browser::PlatformUnregisterProtocol(const std::string& scheme) {
   // There is no unregister API, just replace with a handler to return error.
   WebKitWebContext* context = webkit_web_context_get_default();
   webkit_web_context_register_uri_scheme(
@@ -4,6 +4,8 @@
 
 #include "nativeui/clipboard.h"
 
+#include <map>
+
 #include "base/notreached.h"
 #include "nativeui/gtk/util/clipboard_util.h"
 
@@ -24,10 +26,37 @@ void ClipboardClear(GtkClipboard* clipboard,
   delete objects;
 }
 
+// The provider and the data it has created.
+struct ProvidedData {
+  Clipboard::DataProvider provider;
+  std::map<Clipboard::Data::Type, Clipboard::Data> cache;
+};
+
+void ProvidedDataGet(GtkClipboard* clipboard,
+                     GtkSelectionData* selection,
+                     guint info,
+                     ProvidedData* provided) {
+  // Each target may be requested many times, only create the data once.
+  auto type = static_cast<Clipboard::Data::Type>(info);
+  auto it = provided->cache.find(type);
+  if (it == provided->cache.end())
+    it = provided->cache.emplace(type, provided->provider(type)).first;
+  if (it->second.type() == type)
+    FillSelection(selection, it->second);
+}
+
+void ProvidedDataClear(GtkClipboard* clipboard, ProvidedData* provided) {
+  delete provided;
+}
+
 void OnClipboardOnwerChange(GtkClipboard*, GdkEvent*, Clipboard* clipboard) {
   clipboard->on_change.Emit(clipboard);
 }
 
+void OnOwnerChangeCount(GtkClipboard*, GdkEvent*, int64_t* count) {
+  ++*count;
+}
+
 }  // namespace
 
 NativeClipboard Clipboard::PlatformCreate(Type type) {
@@ -43,17 +72,52 @@ NativeClipboard Clipboard::PlatformCreate(Type type) {
 }
 
 void Clipboard::PlatformDestroy() {
+  if (owner_change_signal_)
+    g_signal_handler_disconnect(clipboard_, owner_change_signal_);
 }
 
-bool Clipboard::IsDataAvailable(Data::Type type) const {
+bool Clipboard::PlatformIsDataAvailable(Data::Type type) const {
   return IsDataAvailableInClipboard(clipboard_, type);
 }
 
+int64_t Clipboard::PlatformGetChangeCount() const {
+  // Changes made by other apps are only reported by the owner-change signal.
+  if (!gdk_display_supports_selection_notification(
+          gtk_clipboard_get_display(clipboard_)))
+    return -1;
+  if (!owner_change_signal_) {
+    owner_change_signal_ = g_signal_connect(
+        clipboard_, "owner-change", G_CALLBACK(OnOwnerChangeCount),
+        const_cast<int64_t*>(&owner_change_count_));
+  }
+  return owner_change_count_;
+}
+
 Clipboard::Data Clipboard::GetData(Data::Type type) const {
   return GetDataFromClipboard(clipboard_, type);
 }
 
+int64_t Clipboard::GetDataSize(Data::Type type) const {
+  GtkSelectionData* selection = GetRawDataFromClipboard(clipboard_, type);
+  if (!selection)
+    return -1;
+  int64_t size = gtk_selection_data_get_length(selection);
+  gtk_selection_data_free(selection);
+  return size;
+}
+
+bool Clipboard::ReadData(Data::Type type, const DataReader& reader) const {
+  GtkSelectionData* selection = GetRawDataFromClipboard(clipboard_, type);
+  if (!selection)
+    return false;
+  bool ret = ReadDataFromSelection(selection, type, reader);
+  gtk_selection_data_free(selection);
+  return ret;
+}
+
 void Clipboard::SetData(std::vector<Data> objects) {
+  // The owner-change signal of our own change arrives later.
+  ++owner_change_count_;
   GtkTargetList* targets = gtk_target_list_new(0, 0);
   for (size_t i = 0; i < objects.size(); ++i)
     FillTargetList(targets, objects[i].type(), i);
@@ -75,6 +139,29 @@ void Clipboard::SetData(std::vector<Data> objects) {
   gtk_target_list_unref(targets);
 }
 
+void Clipboard::SetDataProvider(const std::vector<Data::Type>& types,
+                                const DataProvider& provider) {
+  ++owner_change_count_;
+  GtkTargetList* targets = gtk_target_list_new(0, 0);
+  for (Data::Type type : types)
+    FillTargetList(targets, type, static_cast<int>(type));
+
+  int number = 0;
+  GtkTargetEntry* table = gtk_target_table_new_from_list(targets, &number);
+  if (table && number > 0) {
+    gtk_clipboard_set_with_data(clipboard_, table, number,
+                                (GtkClipboardGetFunc)ProvidedDataGet,
+                                (GtkClipboardClearFunc)ProvidedDataClear,
+                                new ProvidedData{provider});
+  } else {
+    gtk_clipboard_clear(clipboard_);
+  }
+
+  if (table)
+    gtk_target_table_free(table, number);
+  gtk_target_list_unref(targets);
+}
+
 void Clipboard::PlatformStartWatching() {
   DCHECK_EQ(signal_, 0u);
   signal_ = g_signal_connect(GetNative(), "owner-change",
@@ -15,7 +15,7 @@ void OnComTextChange(GObject* widget, ComboBox* combbox) {
     g_object_set_data(widget, "ignore-change", nullptr);
     return;
   }
-  combbox->on_text_change.Emit(combbox);
+  combbox->NotifyTextChange();
 }
 
 }  // namespace
@@ -47,4 +47,14 @@ void ComboBox::AddItem(const std::string& text) {
       GTK_COMBO_BOX_TEXT(GetNative()), nullptr, text.c_str());
 }
 
+void ComboBox::SetItems(const std::vector<std::string>& items) {
+  // Replacing items may change the text, which should not be notified.
+  GtkWidget* entry = gtk_bin_get_child(GTK_BIN(GetNative()));
+  g_signal_handlers_block_by_func(
+      entry, reinterpret_cast<gpointer>(OnComTextChange), this);
+  Picker::SetItems(items);
+  g_signal_handlers_unblock_by_func(
+      entry, reinterpret_cast<gpointer>(OnComTextChange), this);
+}
+
 }  // namespace nu
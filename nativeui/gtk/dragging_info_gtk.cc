@@ -30,4 +30,22 @@ Clipboard::Data DraggingInfoGtk::GetData(Data::Type type) const {
   return it == data_.end() ? Data() : it->second.Clone();
 }
 
+int64_t DraggingInfoGtk::GetDataSize(Data::Type type) const {
+  // Only strings are kept undecoded after the drop.
+  if (type != Data::Type::Text && type != Data::Type::HTML)
+    return -1;
+  auto it = data_.find(type);
+  if (it == data_.end() || it->second.type() != type)
+    return -1;
+  return static_cast<int64_t>(it->second.str().size());
+}
+
+bool DraggingInfoGtk::ReadData(Data::Type type,
+                               const Clipboard::DataReader& reader) const {
+  if (GetDataSize(type) < 0)
+    return false;
+  const std::string& str = data_.find(type)->second.str();
+  return Clipboard::ReadChunks(str.data(), str.size(), reader);
+}
+
 }  // namespace nu
@@ -22,6 +22,9 @@ class DraggingInfoGtk : public DraggingInfo {
   // DraggingInfo:
   bool IsDataAvailable(Data::Type type) const override;
   Data GetData(Data::Type type) const override;
+  int64_t GetDataSize(Data::Type type) const override;
+  bool ReadData(Data::Type type,
+                const Clipboard::DataReader& reader) const override;
 
  private:
   std::map<Data::Type, Data> data_;
@@ -6,6 +6,8 @@
 
 #include <gtk/gtk.h>
 
+#include <string>
+
 #include "nativeui/gtk/util/widget_util.h"
 
 namespace nu {
@@ -18,7 +20,35 @@ void OnActivate(GtkEntry*, Entry* entry) {
 
 void OnEntryTextChange(GtkEditable* widget, Entry* entry) {
   if (!g_object_get_data(G_OBJECT(widget), "is-editing"))
-    entry->on_text_change.Emit(entry);
+    entry->NotifyTextChange();
+}
+
+void OnPreeditChanged(GtkEntry* widget, gchar* preedit, Entry* entry) {
+  // The preedit text is not part of the entry's text, but the committed text
+  // may be inserted before the composition ends.
+  bool composing = preedit && *preedit;
+  bool was_composing = g_object_get_data(G_OBJECT(widget), "is-composing");
+  g_object_set_data(G_OBJECT(widget), "is-composing",
+                    composing ? entry : nullptr);
+  if (was_composing && !composing)
+    entry->NotifyCompositionEnd();
+}
+
+void OnEntryInsertText(GtkEditable* widget,
+                       gchar* text, gint length, gint* position,
+                       Entry* entry) {
+  if (g_object_get_data(G_OBJECT(widget), "is-editing"))
+    return;
+  // The position has been moved to the end of inserted text.
+  int start = *position - g_utf8_strlen(text, length);
+  entry->on_text_range_change.Emit(entry, start, 0, std::string(text, length));
+}
+
+void OnEntryDeleteText(GtkEditable* widget, gint start, gint end,
+                       Entry* entry) {
+  if (g_object_get_data(G_OBJECT(widget), "is-editing"))
+    return;
+  entry->on_text_range_change.Emit(entry, start, end - start, std::string());
 }
 
 }  // namespace
@@ -35,6 +65,12 @@ Entry::Entry(Type type) {
 
   g_signal_connect(GetNative(), "activate", G_CALLBACK(OnActivate), this);
   g_signal_connect(GetNative(), "changed", G_CALLBACK(OnEntryTextChange), this);
+  g_signal_connect(GetNative(), "preedit-changed",
+                   G_CALLBACK(OnPreeditChanged), this);
+  g_signal_connect_after(GetNative(), "insert-text",
+                         G_CALLBACK(OnEntryInsertText), this);
+  g_signal_connect_after(GetNative(), "delete-text",
+                         G_CALLBACK(OnEntryDeleteText), this);
 }
 
 Entry::~Entry() {
@@ -50,6 +86,10 @@ std::string Entry::GetText() const {
   return gtk_entry_get_text(GTK_ENTRY(GetNative()));
 }
 
+bool Entry::IsComposing() const {
+  return g_object_get_data(G_OBJECT(GetNative()), "is-composing");
+}
+
 SizeF Entry::GetMinimumSize() const {
   return GetPreferredSizeForWidget(GetNative());
 }
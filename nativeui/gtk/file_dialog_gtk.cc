@@ -25,6 +25,13 @@ gboolean FileFilterCaseInsensitive(const GtkFileFilterInfo* file_info,
     file_extension, base::CompareCase::INSENSITIVE_ASCII);
 }
 
+void OnResponse(GtkDialog* dialog, int response, FileDialog* self) {
+  g_signal_handlers_disconnect_by_func(
+      dialog, reinterpret_cast<gpointer>(&OnResponse), self);
+  gtk_widget_hide(GTK_WIDGET(dialog));
+  self->OnClose(response == GTK_RESPONSE_ACCEPT);
+}
+
 }  // namespace
 
 FileDialog::FileDialog(NativeFileDialog dialog) : dialog_(dialog) {
@@ -54,6 +61,14 @@ bool FileDialog::RunForWindow(Window* window) {
   return Run();
 }
 
+void FileDialog::PlatformShowForWindow(Window* window) {
+  gtk_window_set_transient_for(GTK_WINDOW(dialog_),
+                               window ? window->GetNative() : nullptr);
+  gtk_window_set_modal(GTK_WINDOW(dialog_), true);
+  g_signal_connect(dialog_, "response", G_CALLBACK(OnResponse), this);
+  gtk_widget_show_all(GTK_WIDGET(dialog_));
+}
+
 void FileDialog::SetTitle(const std::string& title) {
   gtk_window_set_title(GTK_WINDOW(dialog_), title.c_str());
 }
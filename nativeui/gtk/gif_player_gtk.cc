@@ -33,7 +33,7 @@ gboolean OnDraw(GtkWidget* widget, cairo_t* cr, GifPlayer* view) {
 // Callback when widget is show.
 void OnShow(GtkWidget* widget, GifPlayer* view) {
   if (view->IsAnimating() && !view->IsPlaying())
-    view->ScheduleFrame();
+    view->StartAnimationTimer();
 }
 
 // Callback when widget is hidden.
@@ -52,31 +52,7 @@ GifPlayer::GifPlayer() {
 }
 
 GifPlayer::~GifPlayer() {
-  if (timer_ > 0)
-    StopAnimationTimer();
-}
-
-void GifPlayer::PlatformSetImage(Image* image) {
-  SchedulePaint();
-  // Start animation by default.
-  SetAnimating(!!image);
-}
-
-bool GifPlayer::CanAnimate() const {
-  return image_ && !gdk_pixbuf_animation_is_static_image(image_->GetNative());
-}
-
-void GifPlayer::ScheduleFrame() {
-  // Advance frame.
-  image_->AdvanceFrame();
-  // Emit draw event.
-  SchedulePaint();
-  // Schedule next call.
-  if (is_animating_) {
-    timer_ = MessageLoop::SetTimeout(
-        gdk_pixbuf_animation_iter_get_delay_time(image_->iter()),
-        std::bind(&GifPlayer::ScheduleFrame, this));
-  }
+  StopAnimationTimer();
 }
 
 }  // namespace nu
@@ -15,4 +15,9 @@ void Lifetime::PlatformInit() {
 void Lifetime::PlatformDestroy() {
 }
 
+void Lifetime::PlatformFlushBeforeExit() {
+  // Hand the data put in clipboard by this process to clipboard manager.
+  gtk_clipboard_store(gtk_clipboard_get(GDK_SELECTION_CLIPBOARD));
+}
+
 }  // namespace nu
@@ -34,11 +34,17 @@ GtkRadioMenuItem* SearchRadioInSameGroup(MenuBase* menu, MenuItem* radio,
   return nullptr;
 }
 
+void OnMap(GtkWidget*, MenuBase* menu) {
+  menu->NotifyWillOpen();
+}
+
 }  // namespace
 
 void MenuBase::PlatformInit() {
   gtk_widget_show(GTK_WIDGET(menu_));
   g_object_ref_sink(menu_);
+  // A menu is mapped every time it is shown on screen.
+  g_signal_connect(menu_, "map", G_CALLBACK(OnMap), this);
 }
 
 void MenuBase::PlatformDestroy() {
@@ -5,7 +5,9 @@
 #include "nativeui/menu_item.h"
 
 #include <gtk/gtk.h>
+#if defined(BROWSER_SUPPORT)
 #include <webkit2/webkit2.h>
+#endif
 
 #include "nativeui/gtk/util/undoable_text_buffer.h"
 #include "nativeui/menu.h"
@@ -16,19 +18,27 @@ namespace nu {
 
 namespace {
 
+#if defined(BROWSER_SUPPORT)
+#define WEBKIT_COMMAND(name) WEBKIT_EDITING_COMMAND_##name
+#else
+#define WEBKIT_COMMAND(name) nullptr
+#endif
+
 // Maps roles to stock IDs.
 struct {
   const gchar* stock_id;
   const char* webkit_command;
 } g_stock_map[] = {
-  { GTK_STOCK_COPY, WEBKIT_EDITING_COMMAND_COPY },
-  { GTK_STOCK_CUT, WEBKIT_EDITING_COMMAND_CUT },
-  { GTK_STOCK_PASTE, WEBKIT_EDITING_COMMAND_PASTE },
-  { GTK_STOCK_SELECT_ALL, WEBKIT_EDITING_COMMAND_SELECT_ALL },
-  { GTK_STOCK_UNDO, WEBKIT_EDITING_COMMAND_UNDO },
-  { GTK_STOCK_REDO, WEBKIT_EDITING_COMMAND_REDO },
+  { GTK_STOCK_COPY, WEBKIT_COMMAND(COPY) },
+  { GTK_STOCK_CUT, WEBKIT_COMMAND(CUT) },
+  { GTK_STOCK_PASTE, WEBKIT_COMMAND(PASTE) },
+  { GTK_STOCK_SELECT_ALL, WEBKIT_COMMAND(SELECT_ALL) },
+  { GTK_STOCK_UNDO, WEBKIT_COMMAND(UNDO) },
+  { GTK_STOCK_REDO, WEBKIT_COMMAND(REDO) },
 };
 
+#undef WEBKIT_COMMAND
+
 static_assert(
     base::size(g_stock_map) == static_cast<size_t>(MenuItem::Role::ItemCount),
     "Stock items should map the roles");
@@ -49,53 +59,56 @@ void OnStockClick(GtkWidget*, MenuItem* item) {
   if (!widget)
     return;
 
+#if defined(BROWSER_SUPPORT)
   if (WEBKIT_IS_WEB_VIEW(widget)) {
     webkit_web_view_execute_editing_command(
         WEBKIT_WEB_VIEW(widget),
         g_stock_map[static_cast<int>(item->GetRole())].webkit_command);
-  } else {
-    switch (item->GetRole()) {
-      case MenuItem::Role::Copy:
-        if (GTK_IS_ENTRY(widget) || GTK_IS_TEXT_VIEW(widget))
-          g_signal_emit_by_name(widget, "copy-clipboard", nullptr);
-        break;
-      case MenuItem::Role::Cut:
-        if (GTK_IS_ENTRY(widget) || GTK_IS_TEXT_VIEW(widget))
-          g_signal_emit_by_name(widget, "cut-clipboard", nullptr);
-        break;
-      case MenuItem::Role::Paste:
-        if (GTK_IS_ENTRY(widget) || GTK_IS_TEXT_VIEW(widget))
-          g_signal_emit_by_name(widget, "paste-clipboard", nullptr);
-        break;
-      case MenuItem::Role::SelectAll:
-        if (GTK_IS_TEXT_VIEW(widget))
-          g_signal_emit_by_name(widget, "select-all", TRUE, nullptr);
-        else if (GTK_IS_ENTRY(widget))
-          gtk_widget_grab_focus(widget);
-        break;
-      case MenuItem::Role::Undo:
-        if (GTK_IS_TEXT_VIEW(widget)) {
-          auto* buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(widget));
-          if (TextBufferIsUndoable(buffer))
-            TextBufferUndo(buffer);
-        }
-        break;
-      case MenuItem::Role::Redo:
-        if (GTK_IS_TEXT_VIEW(widget)) {
-          auto* buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(widget));
-          if (TextBufferIsUndoable(buffer))
-            TextBufferRedo(buffer);
-        }
-        break;
-      default:
-        break;
-    }
+    return;
+  }
+#endif
+
+  switch (item->GetRole()) {
+    case MenuItem::Role::Copy:
+      if (GTK_IS_ENTRY(widget) || GTK_IS_TEXT_VIEW(widget))
+        g_signal_emit_by_name(widget, "copy-clipboard", nullptr);
+      break;
+    case MenuItem::Role::Cut:
+      if (GTK_IS_ENTRY(widget) || GTK_IS_TEXT_VIEW(widget))
+        g_signal_emit_by_name(widget, "cut-clipboard", nullptr);
+      break;
+    case MenuItem::Role::Paste:
+      if (GTK_IS_ENTRY(widget) || GTK_IS_TEXT_VIEW(widget))
+        g_signal_emit_by_name(widget, "paste-clipboard", nullptr);
+      break;
+    case MenuItem::Role::SelectAll:
+      if (GTK_IS_TEXT_VIEW(widget))
+        g_signal_emit_by_name(widget, "select-all", TRUE, nullptr);
+      else if (GTK_IS_ENTRY(widget))
+        gtk_widget_grab_focus(widget);
+      break;
+    case MenuItem::Role::Undo:
+      if (GTK_IS_TEXT_VIEW(widget)) {
+        auto* buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(widget));
+        if (TextBufferIsUndoable(buffer))
+          TextBufferUndo(buffer);
+      }
+      break;
+    case MenuItem::Role::Redo:
+      if (GTK_IS_TEXT_VIEW(widget)) {
+        auto* buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(widget));
+        if (TextBufferIsUndoable(buffer))
+          TextBufferRedo(buffer);
+      }
+      break;
+    default:
+      break;
   }
 }
 
 // Normal handling of the clicking.
 void OnItemClick(GtkMenuItem*, MenuItem* item) {
-  item->on_click.Emit(item);
+  item->NotifyClick();
 }
 
 }  // namespace
@@ -30,26 +30,51 @@ void MessageLoop::Quit() {
 }
 
 // static
-void MessageLoop::PostTask(Task task) {
-  g_idle_add_full(G_PRIORITY_DEFAULT, reinterpret_cast<GSourceFunc>(OnSource),
+void MessageLoop::PlatformPostTask(Priority priority, Task task) {
+  // GDK dispatches events at G_PRIORITY_DEFAULT and redraws at
+  // GDK_PRIORITY_REDRAW, which is between G_PRIORITY_HIGH_IDLE and
+  // G_PRIORITY_DEFAULT_IDLE.
+  int source_priority = G_PRIORITY_DEFAULT_IDLE;
+  if (priority == Priority::UserBlocking)
+    source_priority = G_PRIORITY_HIGH;
+  g_idle_add_full(source_priority, reinterpret_cast<GSourceFunc>(OnSource),
                   new Task(std::move(task)), Delete<Task>);
 }
 
 // static
-void MessageLoop::PostDelayedTask(int ms, Task task) {
-  SetTimeout(ms, std::move(task));
+bool MessageLoop::WakeupForTasks() {
+  g_idle_add_full(G_PRIORITY_DEFAULT, [](gpointer) -> gboolean {
+    RunTasks();
+    return G_SOURCE_REMOVE;
+  }, nullptr, nullptr);
+  return true;
 }
 
 // static
-MessageLoop::TimerId MessageLoop::SetTimeout(int ms, Task task) {
-  return g_timeout_add_full(G_PRIORITY_DEFAULT, ms,
-                            reinterpret_cast<GSourceFunc>(OnSource),
-                            new Task(std::move(task)), Delete<Task>);
+void MessageLoop::ScheduleTimer(int ms) {
+  // One source is attached for all timeouts, and its ready time is moved to
+  // the next wakeup of timer wheel.
+  static GSource* source = nullptr;
+  if (!source) {
+    static GSourceFuncs funcs = {
+      nullptr, nullptr,
+      [](GSource* source, GSourceFunc, gpointer) -> gboolean {
+        g_source_set_ready_time(source, -1);
+        RunTimers();
+        return G_SOURCE_CONTINUE;
+      },
+      nullptr,
+    };
+    source = g_source_new(&funcs, sizeof(GSource));
+    g_source_set_priority(source, G_PRIORITY_DEFAULT);
+    g_source_attach(source, nullptr);
+  }
+  g_source_set_ready_time(source, g_get_monotonic_time() + ms * 1000);
 }
 
 // static
-void MessageLoop::ClearTimeout(TimerId id) {
-  g_source_remove(id);
+void MessageLoop::PlatformSetTimersPrecise(bool precise) {
+  // There is no App Nap on Linux.
 }
 
 }  // namespace nu
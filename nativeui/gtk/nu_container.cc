@@ -6,6 +6,8 @@
 
 #include "nativeui/container.h"
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/paint_stats.h"
+#include "nativeui/trace_event.h"
 
 namespace nu {
 
@@ -157,6 +159,7 @@ static void nu_container_style_updated(GtkWidget* widget) {
 }
 
 static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
+  NU_TRACE_EVENT("paint", "NUContainer::Draw");
   int width = gtk_widget_get_allocated_width(widget);
   int height = gtk_widget_get_allocated_height(widget);
   gtk_render_background(gtk_widget_get_style_context(widget), cr,
@@ -164,11 +167,14 @@ static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
 
   Container* delegate = NU_CONTAINER(widget)->priv->delegate;
   PainterGtk painter(cr, SizeF(width, height));
-  delegate->on_draw.Emit(delegate, &painter, nu::RectF(0, 0, width, height));
+  delegate->DrawCustomContent(&painter, nu::RectF(0, 0, width, height));
 
-  for (int i = 0; i < delegate->ChildCount(); ++i)
-    gtk_container_propagate_draw(GTK_CONTAINER(widget),
-                                 delegate->ChildAt(i)->GetNative(), cr);
+  for (int i = 0; i < delegate->ChildCount(); ++i) {
+    View* child = delegate->ChildAt(i);
+    if (gtk_widget_is_drawable(child->GetNative()))
+      ScopedPaintTimer::CountView(child);
+    gtk_container_propagate_draw(GTK_CONTAINER(widget), child->GetNative(), cr);
+  }
   return FALSE;
 }
 
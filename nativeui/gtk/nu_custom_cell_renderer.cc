@@ -6,6 +6,7 @@
 
 #include "base/values.h"
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/table_cell_cache.h"
 
 namespace nu {
 
@@ -14,6 +15,8 @@ enum { PROP_VALUE = 1 };
 struct _NUCustomCellRendererPrivate {
   Table::ColumnOptions options;
   base::Value value;
+  uint32_t row;
+  scoped_refptr<TableCellCache> cache;
 };
 
 static void nu_custom_cell_renderer_class_init(
@@ -63,6 +66,7 @@ static void nu_custom_cell_renderer_finalize(GObject* object) {
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
   priv->options.Table::ColumnOptions::~ColumnOptions();
   priv->value.base::Value::~Value();
+  priv->cache.~scoped_refptr<TableCellCache>();
 
   G_OBJECT_CLASS(nu_custom_cell_renderer_parent_class)->finalize(object);
 }
@@ -114,10 +118,11 @@ static void nu_custom_cell_renderer_render(GtkCellRenderer* cell,
   cairo_rectangle(cr, 0, 0, cell_area->width, cell_area->height);
   cairo_clip(cr);
 
+  // The handler is only called when the value or size of cell has changed.
   PainterGtk painter(cr, SizeF(cell_area->width, cell_area->height));
-  priv->options.on_draw(&painter,
+  priv->cache->DrawCell(&painter, priv->row,
                         nu::RectF(0, 0, cell_area->width, cell_area->height),
-                        priv->value);
+                        gtk_widget_get_scale_factor(widget), priv->value);
 }
 
 static void nu_custom_cell_renderer_init(NUCustomCellRenderer* cell) {
@@ -125,6 +130,8 @@ static void nu_custom_cell_renderer_init(NUCustomCellRenderer* cell) {
   cell->priv = static_cast<NUCustomCellRendererPrivate*>(
       nu_custom_cell_renderer_get_instance_private(cell));
   new(&cell->priv->value) base::Value();
+  new(&cell->priv->cache) scoped_refptr<TableCellCache>();
+  cell->priv->row = 0;
 }
 
 GtkCellRenderer* nu_custom_cell_renderer_new(
@@ -133,7 +140,12 @@ GtkCellRenderer* nu_custom_cell_renderer_new(
   // Do in-place new since memory has already been allocated.
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
   new(&priv->options) Table::ColumnOptions(options);
+  priv->cache = new TableCellCache(options);
   return GTK_CELL_RENDERER(object);
 }
 
+void nu_custom_cell_renderer_set_row(GtkCellRenderer* renderer, uint32_t row) {
+  NU_CUSTOM_CELL_RENDERER(renderer)->priv->row = row;
+}
+
 }  // namespace nu
@@ -37,6 +37,9 @@ GType nu_custom_cell_renderer_get_type();
 GtkCellRenderer* nu_custom_cell_renderer_new(
     const Table::ColumnOptions& options);
 
+// Set which row is being rendered, used for caching the drawings.
+void nu_custom_cell_renderer_set_row(GtkCellRenderer* renderer, uint32_t row);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_NU_CUSTOM_CELL_RENDERER_H_
@@ -5,15 +5,27 @@
 #include "nativeui/gtk/nu_label.h"
 
 #include "nativeui/gfx/attributed_text.h"
-#include "nativeui/gfx/gtk/painter_gtk.h"
 #include "nativeui/label.h"
 
 namespace nu {
 
 struct _NULabelPrivate {
   Label* label;
+  // A copy of the text's layout configured for the allocation, so measuring
+  // the text does not have to reconfigure the layout being drawn.
+  PangoLayout* layout;
+  // The text that |layout| is copied from, a reference is kept so a new text
+  // can never be mistaken for it.
+  AttributedText* text;
+  int revision;
+  int width;
+  int height;
+  // The vertical offset of |layout|.
+  int y;
 };
 
+static void nu_label_finalize(GObject* object);
+
 static void nu_label_get_preferred_width(GtkWidget* widget,
                                          gint* minimum,
                                          gint* natural);
@@ -25,6 +37,9 @@ static gboolean nu_label_draw(GtkWidget* widget, cairo_t* cr);
 G_DEFINE_TYPE_WITH_PRIVATE(NULabel, nu_label, GTK_TYPE_WIDGET)
 
 static void nu_label_class_init(NULabelClass* nu_class) {
+  GObjectClass* object_class = G_OBJECT_CLASS(nu_class);
+  object_class->finalize = nu_label_finalize;
+
   GtkWidgetClass* widget_class =
       reinterpret_cast<GtkWidgetClass*>(nu_class);
 
@@ -33,6 +48,15 @@ static void nu_label_class_init(NULabelClass* nu_class) {
   widget_class->draw = nu_label_draw;
 }
 
+static void nu_label_finalize(GObject* object) {
+  NULabelPrivate* priv = NU_LABEL(object)->priv;
+  if (priv->layout)
+    g_object_unref(priv->layout);
+  if (priv->text)
+    priv->text->Release();
+  G_OBJECT_CLASS(nu_label_parent_class)->finalize(object);
+}
+
 static void nu_label_get_preferred_width(GtkWidget* widget,
                                          gint* minimum,
                                          gint* natural) {
@@ -45,16 +69,59 @@ static void nu_label_get_preferred_height(GtkWidget* widget,
   *minimum = *natural = 0;
 }
 
+// Revalidate the layout only when the text or the allocation has changed.
+static void nu_label_update_layout(NULabelPrivate* priv,
+                                   int width, int height) {
+  AttributedText* text = priv->label->GetAttributedText();
+  bool text_changed = priv->text != text ||
+                      priv->revision != text->revision();
+  if (!text_changed && priv->width == width && priv->height == height)
+    return;
+
+  if (text_changed) {
+    if (priv->text != text) {
+      text->AddRef();
+      if (priv->text)
+        priv->text->Release();
+      priv->text = text;
+    }
+    if (priv->layout)
+      g_object_unref(priv->layout);
+    priv->layout = pango_layout_copy(text->GetNative());
+    priv->revision = text->revision();
+  }
+  priv->width = width;
+  priv->height = height;
+
+  const TextFormat& format = text->GetFormat();
+  if (format.wrap) {
+    pango_layout_set_width(priv->layout, width * PANGO_SCALE);
+    pango_layout_set_height(priv->layout, height * PANGO_SCALE);
+  }
+  int text_height;
+  pango_layout_get_pixel_size(priv->layout, nullptr, &text_height);
+  if (format.valign == TextAlign::Center)
+    priv->y = (height - text_height) / 2;
+  else if (format.valign == TextAlign::End)
+    priv->y = height - text_height;
+  else
+    priv->y = 0;
+}
+
 static gboolean nu_label_draw(GtkWidget* widget, cairo_t* cr) {
   int width = gtk_widget_get_allocated_width(widget);
   int height = gtk_widget_get_allocated_height(widget);
   gtk_render_background(gtk_widget_get_style_context(widget), cr,
                         0, 0, width, height);
 
-  auto* label = NU_LABEL(widget)->priv->label;
-  PainterGtk painter(cr, SizeF(width, height));
-  painter.DrawAttributedText(label->GetAttributedText(),
-                             RectF(0, 0, width, height));
+  NULabelPrivate* priv = NU_LABEL(widget)->priv;
+  nu_label_update_layout(priv, width, height);
+  cairo_save(cr);
+  cairo_rectangle(cr, 0, 0, width, height);
+  cairo_clip(cr);
+  cairo_move_to(cr, 0, priv->y);
+  pango_cairo_show_layout(cr, priv->layout);
+  cairo_restore(cr);
   return false;
 }
 
@@ -12,6 +12,10 @@ namespace nu {
 struct _NUTreeModelPrivate {
   Table* table;
   TableModel* model;
+  // GtkTreeView walks every row with iter_next when a model is set, and
+  // GetRowCount may call into script, so the count is cached and only read
+  // again when the table is notified of row changes.
+  uint32_t row_count;
 };
 
 static void nu_tree_model_tree_model_init(GtkTreeModelIface* iface);
@@ -99,7 +103,7 @@ static gboolean nu_tree_model_get_iter(GtkTreeModel* tree_model,
   if (gtk_tree_path_get_depth(path) != 1)
     return false;
   gint row = gtk_tree_path_get_indices(path)[0];
-  if (row < 0 || static_cast<uint32_t>(row) >= priv->model->GetRowCount())
+  if (row < 0 || static_cast<uint32_t>(row) >= priv->row_count)
     return false;
   iter->stamp = true;
   iter->user_data = GINT_TO_POINTER(row);
@@ -133,7 +137,7 @@ static gboolean nu_tree_model_iter_next(GtkTreeModel* tree_model,
     return false;
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
   gint row = GPOINTER_TO_INT(iter->user_data);
-  if (row + 1 >= static_cast<int>(priv->model->GetRowCount())) {
+  if (row + 1 >= static_cast<int>(priv->row_count)) {
     iter->stamp = false;
     return false;
   }
@@ -170,7 +174,7 @@ static gboolean nu_tree_model_iter_has_child(GtkTreeModel* tree_model,
 static gint nu_tree_model_iter_n_children(GtkTreeModel* tree_model,
                                           GtkTreeIter* iter) {
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
-  return iter ? 0 : priv->table->GetColumnCount();
+  return iter ? 0 : static_cast<gint>(priv->row_count);
 }
 
 static gboolean nu_tree_model_iter_nth_child(GtkTreeModel* tree_model,
@@ -181,7 +185,7 @@ static gboolean nu_tree_model_iter_nth_child(GtkTreeModel* tree_model,
   if (parent)
     return false;
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
-  if (n < 0 || static_cast<uint32_t>(n) >= priv->model->GetRowCount())
+  if (n < 0 || static_cast<uint32_t>(n) >= priv->row_count)
     return false;
   iter->stamp = true;
   iter->user_data = GINT_TO_POINTER(n);
@@ -204,7 +208,13 @@ NUTreeModel* nu_tree_model_new(Table* table, TableModel* model) {
   void* obj = g_object_new(NU_TYPE_TREE_MODEL, nullptr);
   NU_TREE_MODEL(obj)->priv->table = table;
   NU_TREE_MODEL(obj)->priv->model = model;
+  NU_TREE_MODEL(obj)->priv->row_count = model->GetRowCount();
   return NU_TREE_MODEL(obj);
 }
 
+void nu_tree_model_update_row_count(NUTreeModel* tree_model) {
+  NUTreeModelPrivate* priv = tree_model->priv;
+  priv->row_count = priv->model->GetRowCount();
+}
+
 }  // namespace nu
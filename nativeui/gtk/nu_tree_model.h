@@ -36,6 +36,10 @@ struct _NUTreeModelClass {
 GType nu_tree_model_get_type();
 NUTreeModel* nu_tree_model_new(Table* table, TableModel* model);
 
+// Read the row count from the TableModel again, must be called before
+// emitting signals for inserted or deleted rows.
+void nu_tree_model_update_row_count(NUTreeModel* tree_model);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_NU_TREE_MODEL_H_
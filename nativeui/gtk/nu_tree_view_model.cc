@@ -0,0 +1,241 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/nu_tree_view_model.h"
+
+namespace nu {
+
+struct _NUTreeViewModelPrivate {
+  TreeView* view;
+};
+
+namespace {
+
+// The stamp of valid iters.
+const gint kStamp = 1;
+
+inline TreeView::Node* GetNode(GtkTreeIter* iter) {
+  return static_cast<TreeView::Node*>(iter->user_data);
+}
+
+}  // namespace
+
+static void nu_tree_view_model_tree_model_init(GtkTreeModelIface* iface);
+static GtkTreeModelFlags nu_tree_view_model_get_flags(GtkTreeModel* model);
+static gint nu_tree_view_model_get_n_columns(GtkTreeModel* model);
+static GType nu_tree_view_model_get_column_type(GtkTreeModel* model,
+                                                gint index);
+static gboolean nu_tree_view_model_get_iter(GtkTreeModel* model,
+                                            GtkTreeIter* iter,
+                                            GtkTreePath* path);
+static GtkTreePath* nu_tree_view_model_get_path(GtkTreeModel* model,
+                                                GtkTreeIter* iter);
+static void nu_tree_view_model_get_value(GtkTreeModel* model,
+                                         GtkTreeIter* iter,
+                                         gint column,
+                                         GValue* value);
+static gboolean nu_tree_view_model_iter_next(GtkTreeModel* model,
+                                             GtkTreeIter* iter);
+static gboolean nu_tree_view_model_iter_previous(GtkTreeModel* model,
+                                                 GtkTreeIter* iter);
+static gboolean nu_tree_view_model_iter_children(GtkTreeModel* model,
+                                                 GtkTreeIter* iter,
+                                                 GtkTreeIter* parent);
+static gboolean nu_tree_view_model_iter_has_child(GtkTreeModel* model,
+                                                  GtkTreeIter* iter);
+static gint nu_tree_view_model_iter_n_children(GtkTreeModel* model,
+                                               GtkTreeIter* iter);
+static gboolean nu_tree_view_model_iter_nth_child(GtkTreeModel* model,
+                                                  GtkTreeIter* iter,
+                                                  GtkTreeIter* parent,
+                                                  gint n);
+static gboolean nu_tree_view_model_iter_parent(GtkTreeModel* model,
+                                               GtkTreeIter* iter,
+                                               GtkTreeIter* child);
+
+G_DEFINE_TYPE_WITH_CODE(NUTreeViewModel, nu_tree_view_model, G_TYPE_OBJECT,
+                        G_ADD_PRIVATE(NUTreeViewModel)
+                        G_IMPLEMENT_INTERFACE(
+                            GTK_TYPE_TREE_MODEL,
+                            nu_tree_view_model_tree_model_init))
+
+static void nu_tree_view_model_class_init(NUTreeViewModelClass* cl) {
+}
+
+static void nu_tree_view_model_tree_model_init(GtkTreeModelIface* iface) {
+  iface->get_flags = nu_tree_view_model_get_flags;
+  iface->get_n_columns = nu_tree_view_model_get_n_columns;
+  iface->get_column_type = nu_tree_view_model_get_column_type;
+  iface->get_iter = nu_tree_view_model_get_iter;
+  iface->get_path = nu_tree_view_model_get_path;
+  iface->get_value = nu_tree_view_model_get_value;
+  iface->iter_next = nu_tree_view_model_iter_next;
+  iface->iter_previous = nu_tree_view_model_iter_previous;
+  iface->iter_children = nu_tree_view_model_iter_children;
+  iface->iter_has_child = nu_tree_view_model_iter_has_child;
+  iface->iter_n_children = nu_tree_view_model_iter_n_children;
+  iface->iter_nth_child = nu_tree_view_model_iter_nth_child;
+  iface->iter_parent = nu_tree_view_model_iter_parent;
+}
+
+static GtkTreeModelFlags nu_tree_view_model_get_flags(GtkTreeModel* model) {
+  // The nodes live until they are removed from model.
+  return GTK_TREE_MODEL_ITERS_PERSIST;
+}
+
+static gint nu_tree_view_model_get_n_columns(GtkTreeModel* model) {
+  NUTreeViewModelPrivate* priv = NU_TREE_VIEW_MODEL(model)->priv;
+  return priv->view->GetColumnCount();
+}
+
+static GType nu_tree_view_model_get_column_type(GtkTreeModel* model,
+                                                gint index) {
+  return G_TYPE_POINTER;
+}
+
+static gboolean nu_tree_view_model_get_iter(GtkTreeModel* model,
+                                            GtkTreeIter* iter,
+                                            GtkTreePath* path) {
+  NUTreeViewModelPrivate* priv = NU_TREE_VIEW_MODEL(model)->priv;
+  iter->stamp = 0;
+  gint depth = 0;
+  gint* indices = gtk_tree_path_get_indices_with_depth(path, &depth);
+  TreeView::Node* node = priv->view->GetRoot();
+  for (gint i = 0; i < depth; ++i) {
+    const TreeView::Nodes& children = priv->view->GetChildren(node);
+    if (indices[i] < 0 || static_cast<size_t>(indices[i]) >= children.size())
+      return false;
+    node = children[indices[i]].get();
+  }
+  if (depth == 0)
+    return false;
+  nu_tree_view_model_get_node_iter(node, iter);
+  return true;
+}
+
+static GtkTreePath* nu_tree_view_model_get_path(GtkTreeModel* model,
+                                                GtkTreeIter* iter) {
+  if (iter->stamp != kStamp)
+    return nullptr;
+  return nu_tree_view_model_get_node_path(GetNode(iter));
+}
+
+static void nu_tree_view_model_get_value(GtkTreeModel* model,
+                                         GtkTreeIter* iter,
+                                         gint column,
+                                         GValue* value) {
+  if (iter->stamp != kStamp)
+    return;
+  NUTreeViewModelPrivate* priv = NU_TREE_VIEW_MODEL(model)->priv;
+  TreeModel* tree_model = priv->view->GetModel();
+  g_value_init(value, G_TYPE_POINTER);
+  if (tree_model) {
+    g_value_set_pointer(value, const_cast<base::Value*>(
+        tree_model->GetValue(GetNode(iter)->id, column)));
+  }
+}
+
+static gboolean nu_tree_view_model_iter_next(GtkTreeModel* model,
+                                             GtkTreeIter* iter) {
+  if (iter->stamp != kStamp)
+    return false;
+  TreeView::Node* node = GetNode(iter);
+  const TreeView::Nodes& siblings = node->parent->children;
+  if (node->index + 1 >= siblings.size()) {
+    iter->stamp = 0;
+    return false;
+  }
+  iter->user_data = siblings[node->index + 1].get();
+  return true;
+}
+
+static gboolean nu_tree_view_model_iter_previous(GtkTreeModel* model,
+                                                 GtkTreeIter* iter) {
+  if (iter->stamp != kStamp)
+    return false;
+  TreeView::Node* node = GetNode(iter);
+  if (node->index == 0) {
+    iter->stamp = 0;
+    return false;
+  }
+  iter->user_data = node->parent->children[node->index - 1].get();
+  return true;
+}
+
+static gboolean nu_tree_view_model_iter_children(GtkTreeModel* model,
+                                                 GtkTreeIter* iter,
+                                                 GtkTreeIter* parent) {
+  return nu_tree_view_model_iter_nth_child(model, iter, parent, 0);
+}
+
+static gboolean nu_tree_view_model_iter_has_child(GtkTreeModel* model,
+                                                  GtkTreeIter* iter) {
+  if (iter->stamp != kStamp)
+    return false;
+  NUTreeViewModelPrivate* priv = NU_TREE_VIEW_MODEL(model)->priv;
+  // Do not read the children until the node is expanded.
+  return priv->view->HasChildren(GetNode(iter));
+}
+
+static gint nu_tree_view_model_iter_n_children(GtkTreeModel* model,
+                                               GtkTreeIter* iter) {
+  NUTreeViewModelPrivate* priv = NU_TREE_VIEW_MODEL(model)->priv;
+  TreeView::Node* node = iter ? GetNode(iter) : priv->view->GetRoot();
+  return static_cast<gint>(priv->view->GetChildren(node).size());
+}
+
+static gboolean nu_tree_view_model_iter_nth_child(GtkTreeModel* model,
+                                                  GtkTreeIter* iter,
+                                                  GtkTreeIter* parent,
+                                                  gint n) {
+  NUTreeViewModelPrivate* priv = NU_TREE_VIEW_MODEL(model)->priv;
+  iter->stamp = 0;
+  TreeView::Node* node = parent ? GetNode(parent) : priv->view->GetRoot();
+  const TreeView::Nodes& children = priv->view->GetChildren(node);
+  if (n < 0 || static_cast<size_t>(n) >= children.size())
+    return false;
+  nu_tree_view_model_get_node_iter(children[n].get(), iter);
+  return true;
+}
+
+static gboolean nu_tree_view_model_iter_parent(GtkTreeModel* model,
+                                               GtkTreeIter* iter,
+                                               GtkTreeIter* child) {
+  iter->stamp = 0;
+  if (child->stamp != kStamp)
+    return false;
+  TreeView::Node* parent = GetNode(child)->parent;
+  if (!parent->parent)  // root
+    return false;
+  nu_tree_view_model_get_node_iter(parent, iter);
+  return true;
+}
+
+static void nu_tree_view_model_init(NUTreeViewModel* model) {
+  model->priv = static_cast<NUTreeViewModelPrivate*>(
+      nu_tree_view_model_get_instance_private(model));
+}
+
+NUTreeViewModel* nu_tree_view_model_new(TreeView* view) {
+  void* obj = g_object_new(NU_TYPE_TREE_VIEW_MODEL, nullptr);
+  NU_TREE_VIEW_MODEL(obj)->priv->view = view;
+  return NU_TREE_VIEW_MODEL(obj);
+}
+
+void nu_tree_view_model_get_node_iter(TreeView::Node* node,
+                                      GtkTreeIter* iter) {
+  iter->stamp = kStamp;
+  iter->user_data = node;
+  iter->user_data2 = nullptr;
+  iter->user_data3 = nullptr;
+}
+
+GtkTreePath* nu_tree_view_model_get_node_path(TreeView::Node* node) {
+  GtkTreePath* path = gtk_tree_path_new();
+  for (; node->parent; node = node->parent)
+    gtk_tree_path_prepend_index(path, node->index);
+  return path;
+}
+
+}  // namespace nu
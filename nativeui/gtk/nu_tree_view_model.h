@@ -0,0 +1,45 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GTK_NU_TREE_VIEW_MODEL_H_
+#define NATIVEUI_GTK_NU_TREE_VIEW_MODEL_H_
+
+#include <gtk/gtk.h>
+
+#include "nativeui/tree_view.h"
+
+// Custom tree model type for TreeModel, the user_data of iters are the nodes
+// of TreeView.
+
+namespace nu {
+
+#define NU_TYPE_TREE_VIEW_MODEL (nu_tree_view_model_get_type())
+#define NU_TREE_VIEW_MODEL(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), \
+                                 NU_TYPE_TREE_VIEW_MODEL, NUTreeViewModel))
+#define NU_IS_TREE_VIEW_MODEL(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj), \
+                                    NU_TYPE_TREE_VIEW_MODEL))
+
+typedef struct _NUTreeViewModel        NUTreeViewModel;
+typedef struct _NUTreeViewModelPrivate NUTreeViewModelPrivate;
+typedef struct _NUTreeViewModelClass   NUTreeViewModelClass;
+
+struct _NUTreeViewModel {
+  GObject parent;
+  NUTreeViewModelPrivate* priv;
+};
+
+struct _NUTreeViewModelClass {
+  GObjectClass parent_class;
+};
+
+GType nu_tree_view_model_get_type();
+NUTreeViewModel* nu_tree_view_model_new(TreeView* view);
+
+// Helpers for converting nodes.
+void nu_tree_view_model_get_node_iter(TreeView::Node* node, GtkTreeIter* iter);
+GtkTreePath* nu_tree_view_model_get_node_path(TreeView::Node* node);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GTK_NU_TREE_VIEW_MODEL_H_
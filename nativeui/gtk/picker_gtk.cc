@@ -6,6 +6,8 @@
 
 #include <gtk/gtk.h>
 
+#include <unordered_set>
+
 #include "nativeui/gtk/util/widget_util.h"
 
 namespace nu {
@@ -72,6 +74,36 @@ void Picker::AddItem(const std::string& text) {
     SelectItemAt(0);
 }
 
+void Picker::SetItems(const std::vector<std::string>& items) {
+  GtkComboBox* combobox = GTK_COMBO_BOX(GetNative());
+  bool has_entry = gtk_combo_box_get_has_entry(combobox);
+  // Changing items is not a selection made by user.
+  g_signal_handlers_block_by_func(combobox,
+                                  reinterpret_cast<gpointer>(OnChanged), this);
+  // Detach the model so the view is not updated for every item.
+  GtkListStore* store = GTK_LIST_STORE(gtk_combo_box_get_model(combobox));
+  g_object_ref(store);
+  gtk_combo_box_set_model(combobox, nullptr);
+  gtk_list_store_clear(store);
+  int column = gtk_combo_box_get_entry_text_column(combobox);
+  std::unordered_set<std::string> added;
+  for (const std::string& item : items) {
+    // ComboBox allows duplicate items.
+    if (!has_entry && !added.insert(item).second)
+      continue;
+    gtk_list_store_insert_with_values(store, nullptr, -1,
+                                      column, item.c_str(), -1);
+  }
+  gtk_combo_box_set_model(combobox, GTK_TREE_MODEL(store));
+  g_object_unref(store);
+  // Select the first item by default.
+  if (!has_entry && !items.empty())
+    gtk_combo_box_set_active(combobox, 0);
+  g_signal_handlers_unblock_by_func(combobox,
+                                    reinterpret_cast<gpointer>(OnChanged),
+                                    this);
+}
+
 void Picker::RemoveItemAt(int index) {
   gtk_combo_box_text_remove(GTK_COMBO_BOX_TEXT(GetNative()), index);
 }
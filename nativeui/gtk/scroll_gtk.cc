@@ -6,6 +6,8 @@
 
 #include <gtk/gtk.h>
 
+#include <algorithm>
+
 #include "nativeui/gtk/util/widget_util.h"
 
 namespace nu {
@@ -30,13 +32,23 @@ Scroll::Policy PolicyFromGTK(GtkPolicyType policy) {
     return Scroll::Policy::Automatic;
 }
 
+void OnAdjustmentValueChanged(GtkAdjustment*, Scroll* scroll) {
+  scroll->NotifyScroll();
+}
+
 }  // namespace
 
 void Scroll::PlatformInit() {
   TakeOverView(gtk_scrolled_window_new(nullptr, nullptr));
-  GtkWidget* viewport = gtk_viewport_new(
-      gtk_scrolled_window_get_hadjustment(GTK_SCROLLED_WINDOW(GetNative())),
-      gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(GetNative())));
+  auto* h_adjust = gtk_scrolled_window_get_hadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  auto* v_adjust = gtk_scrolled_window_get_vadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  g_signal_connect(h_adjust, "value-changed",
+                   G_CALLBACK(OnAdjustmentValueChanged), this);
+  g_signal_connect(v_adjust, "value-changed",
+                   G_CALLBACK(OnAdjustmentValueChanged), this);
+  GtkWidget* viewport = gtk_viewport_new(h_adjust, v_adjust);
   gtk_widget_show(viewport);
   gtk_container_add(GTK_CONTAINER(GetNative()), viewport);
 }
@@ -76,6 +88,41 @@ void Scroll::SetContentSize(const SizeF& size) {
   gtk_adjustment_set_value(v_adjust, gtk_adjustment_get_lower(v_adjust));
 }
 
+void Scroll::PlatformSetScrollPosition(float horizon, float vertical) {
+  auto* h_adjust = gtk_scrolled_window_get_hadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  gtk_adjustment_set_value(h_adjust,
+                           gtk_adjustment_get_lower(h_adjust) + horizon);
+  auto* v_adjust = gtk_scrolled_window_get_vadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  gtk_adjustment_set_value(v_adjust,
+                           gtk_adjustment_get_lower(v_adjust) + vertical);
+}
+
+std::tuple<float, float> Scroll::GetScrollPosition() const {
+  auto* h_adjust = gtk_scrolled_window_get_hadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  auto* v_adjust = gtk_scrolled_window_get_vadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  return std::make_tuple(
+      gtk_adjustment_get_value(h_adjust) - gtk_adjustment_get_lower(h_adjust),
+      gtk_adjustment_get_value(v_adjust) - gtk_adjustment_get_lower(v_adjust));
+}
+
+std::tuple<float, float> Scroll::GetMaximumScrollPosition() const {
+  auto* h_adjust = gtk_scrolled_window_get_hadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  auto* v_adjust = gtk_scrolled_window_get_vadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  return std::make_tuple(
+      std::max(0.0, gtk_adjustment_get_upper(h_adjust) -
+                    gtk_adjustment_get_lower(h_adjust) -
+                    gtk_adjustment_get_page_size(h_adjust)),
+      std::max(0.0, gtk_adjustment_get_upper(v_adjust) -
+                    gtk_adjustment_get_lower(v_adjust) -
+                    gtk_adjustment_get_page_size(v_adjust)));
+}
+
 void Scroll::SetOverlayScrollbar(bool overlay) {
   if (GtkVersionCheck(3, 16))
     gtk_scrolled_window_set_overlay_scrolling(GTK_SCROLLED_WINDOW(GetNative()),
@@ -4,13 +4,32 @@
 
 #include "nativeui/state.h"
 
+#include <pango/pangocairo.h>
+
+#include "nativeui/gfx/font.h"
 #include "nativeui/gfx/gtk/gtk_theme.h"
+#include "nativeui/gtk/util/fontconfig.h"
 
 namespace nu {
 
 void State::PlatformInit() {
 }
 
+void State::PlatformPrewarm() {
+  GetGtkTheme();
+
+  // The cold initialization of fontconfig scans all fonts of the system,
+  // which happens when pango loads the first font.
+  GetGlobalFontConfig();
+  PangoFontMap* font_map = pango_cairo_font_map_get_default();
+  PangoContext* context = pango_font_map_create_context(font_map);
+  PangoFont* font = pango_font_map_load_font(font_map, context,
+                                             Font::Default()->GetNative());
+  if (font)
+    g_object_unref(font);
+  g_object_unref(context);
+}
+
 GtkTheme* State::GetGtkTheme() {
   if (!gtk_theme_)
     gtk_theme_.reset(new GtkTheme);
@@ -12,8 +12,8 @@ namespace nu {
 
 namespace {
 
-void OnSwitchPage(GtkNotebook*, GtkWidget*, guint, Tab* tab) {
-  tab->on_selected_page_change.Emit(tab);
+void OnSwitchPage(GtkNotebook*, GtkWidget*, guint index, Tab* tab) {
+  tab->NotifyPageSelected(index);
 }
 
 }  // namespace
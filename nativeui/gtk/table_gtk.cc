@@ -4,6 +4,8 @@
 
 #include "nativeui/table.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/values.h"
 #include "nativeui/gtk/nu_custom_cell_renderer.h"
@@ -15,6 +17,9 @@ namespace nu {
 
 namespace {
 
+// Notifying more rows than this reloads the whole model instead.
+const uint32_t kMaxRowsToNotify = 1000;
+
 // Calculate the default row height of cell.
 int GetDefaultRowHeight() {
   // Cache calls.
@@ -77,12 +82,18 @@ void TreeCellData(GtkTreeViewColumn* tree_column,
     }
 
     case nu::Table::ColumnType::Custom: {
+      nu_custom_cell_renderer_set_row(renderer,
+                                      GPOINTER_TO_INT(iter->user_data));
       g_object_set(renderer, "value", value, nullptr);
       break;
     }
   }
 }
 
+void OnAdjustmentChanged(GtkAdjustment* adjustment, Table* table) {
+  table->OnVisibleRangeMayChange();
+}
+
 }  // namespace
 
 NativeView Table::PlatformCreate() {
@@ -95,6 +106,14 @@ NativeView Table::PlatformCreate() {
   g_object_set_data(G_OBJECT(scroll), "row-height",
                     GINT_TO_POINTER(GetDefaultRowHeight()));
   gtk_container_add(GTK_CONTAINER(scroll), tree_view);
+
+  // Scrolling and resizing both change the vertical adjustment.
+  GtkAdjustment* vadjustment =
+      gtk_scrolled_window_get_vadjustment(GTK_SCROLLED_WINDOW(scroll));
+  g_signal_connect(vadjustment, "value-changed",
+                   G_CALLBACK(OnAdjustmentChanged), this);
+  g_signal_connect(vadjustment, "changed",
+                   G_CALLBACK(OnAdjustmentChanged), this);
   return scroll;
 }
 
@@ -109,6 +128,7 @@ void Table::PlatformSetModel(TableModel* model) {
                                                     "tree-view"));
   NUTreeModel* tree_model = nu_tree_model_new(this, model);
   gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(tree_model));
+  g_object_unref(tree_model);  // owned by tree view
 }
 
 void Table::AddColumnWithOptions(const std::string& title,
@@ -209,29 +229,99 @@ int Table::GetSelectedRow() const {
   return -1;
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+std::tuple<int, int> Table::GetVisibleRowRange() const {
+  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
+                                                    "tree-view"));
+  GtkTreePath* start_path;
+  GtkTreePath* end_path;
+  if (!gtk_tree_view_get_model(tree_view) ||
+      !gtk_tree_view_get_visible_range(tree_view, &start_path, &end_path))
+    return std::make_tuple(-1, -1);
+  int start = gtk_tree_path_get_indices(start_path)[0];
+  int end = gtk_tree_path_get_indices(end_path)[0] + 1;
+  gtk_tree_path_free(start_path);
+  gtk_tree_path_free(end_path);
+  return std::make_tuple(start, end);
+}
+
+void Table::PlatformScrollToRow(int row, ScrollAlign align) {
+  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
+                                                    "tree-view"));
+  float row_align = 0.f;
+  if (align == ScrollAlign::Center)
+    row_align = 0.5f;
+  else if (align == ScrollAlign::End)
+    row_align = 1.f;
+  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
+  gtk_tree_view_scroll_to_cell(tree_view, tree_path, nullptr,
+                               align != ScrollAlign::Nearest, row_align, 0);
+  gtk_tree_path_free(tree_path);
+}
+
+void Table::NotifyRowsInserted(uint32_t start, uint32_t count) {
   auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
                                                     "tree-view"));
   auto* tree_model = gtk_tree_view_get_model(tree_view);
   if (!tree_model)
     return;
-  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_inserted(tree_model, tree_path, &iter);
-  gtk_tree_path_free(tree_path);
+  // GtkTreeModel has no API for batch changes, and notifying each row costs
+  // more than reloading the model when there are many rows.
+  if (count > kMaxRowsToNotify) {
+    NotifyReset();
+    return;
+  }
+  nu_tree_model_update_row_count(NU_TREE_MODEL(tree_model));
+  for (uint32_t row = start; row < start + count; ++row) {
+    GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+    GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
+    gtk_tree_model_row_inserted(tree_model, tree_path, &iter);
+    gtk_tree_path_free(tree_path);
+  }
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::NotifyRowsDeleted(uint32_t start, uint32_t count) {
   auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
                                                     "tree-view"));
   auto* tree_model = gtk_tree_view_get_model(tree_view);
   if (!tree_model)
     return;
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_deleted(tree_model, tree_path);
+  if (count > kMaxRowsToNotify) {
+    NotifyReset();
+    return;
+  }
+  nu_tree_model_update_row_count(NU_TREE_MODEL(tree_model));
+  // Deleting rows at |start| one by one.
+  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(start, -1);
+  for (uint32_t i = 0; i < count; ++i)
+    gtk_tree_model_row_deleted(tree_model, tree_path);
   gtk_tree_path_free(tree_path);
 }
 
+void Table::NotifyRangeChanged(uint32_t start, uint32_t count) {
+  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
+                                                    "tree-view"));
+  auto* tree_model = gtk_tree_view_get_model(tree_view);
+  if (!tree_model)
+    return;
+  // Rows out of the visible range are read again when scrolled into view.
+  GtkTreePath* start_path;
+  GtkTreePath* end_path;
+  if (!gtk_tree_view_get_visible_range(tree_view, &start_path, &end_path))
+    return;
+  uint32_t first = std::max<uint32_t>(
+      start, gtk_tree_path_get_indices(start_path)[0]);
+  uint32_t last = std::min<uint32_t>(
+      start + count - 1, gtk_tree_path_get_indices(end_path)[0]);
+  gtk_tree_path_free(start_path);
+  gtk_tree_path_free(end_path);
+  for (uint32_t row = first; row <= last; ++row) {
+    GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+    GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
+    gtk_tree_model_row_changed(tree_model, tree_path, &iter);
+    gtk_tree_path_free(tree_path);
+  }
+}
+
 void Table::NotifyValueChange(uint32_t column, uint32_t row) {
   auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
                                                     "tree-view"));
@@ -244,4 +334,18 @@ void Table::NotifyValueChange(uint32_t column, uint32_t row) {
   gtk_tree_path_free(tree_path);
 }
 
+void Table::NotifyReset() {
+  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
+                                                    "tree-view"));
+  auto* tree_model = gtk_tree_view_get_model(tree_view);
+  if (!tree_model)
+    return;
+  // Reattaching the model makes the tree view read the rows again.
+  nu_tree_model_update_row_count(NU_TREE_MODEL(tree_model));
+  g_object_ref(tree_model);
+  gtk_tree_view_set_model(tree_view, nullptr);
+  gtk_tree_view_set_model(tree_view, tree_model);
+  g_object_unref(tree_model);
+}
+
 }  // namespace nu
@@ -7,6 +7,10 @@
 #include <gdk/gdkkeysyms.h>
 #include <gtk/gtk.h>
 
+#include <cstdlib>
+#include <string>
+
+#include "base/strings/stringprintf.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gtk/util/undoable_text_buffer.h"
 #include "nativeui/gtk/util/widget_util.h"
@@ -24,10 +28,97 @@ GtkPolicyType ToGTK(Scroll::Policy policy) {
     return GTK_POLICY_AUTOMATIC;
 }
 
+// The tags of range attributes are named after their values, so ranges with
+// the same attributes share one tag.
+const char kFontTagPrefix[] = "nu-font-";
+const char kColorTagPrefix[] = "nu-color-";
+
+GtkTextTag* GetFontTag(GtkTextBuffer* buffer, Font* font) {
+  gchar* desc = pango_font_description_to_string(font->GetNative());
+  std::string name = kFontTagPrefix + std::string(desc);
+  g_free(desc);
+  GtkTextTag* tag = gtk_text_tag_table_lookup(
+      gtk_text_buffer_get_tag_table(buffer), name.c_str());
+  if (!tag)
+    tag = gtk_text_buffer_create_tag(buffer, name.c_str(),
+                                     "font-desc", font->GetNative(), nullptr);
+  return tag;
+}
+
+GtkTextTag* GetColorTag(GtkTextBuffer* buffer, Color color) {
+  std::string name = base::StringPrintf("%s%08X", kColorTagPrefix,
+                                        color.value());
+  GtkTextTag* tag = gtk_text_tag_table_lookup(
+      gtk_text_buffer_get_tag_table(buffer), name.c_str());
+  if (!tag) {
+    GdkRGBA rgba = color.ToGdkRGBA();
+    tag = gtk_text_buffer_create_tag(buffer, name.c_str(),
+                                     "foreground-rgba", &rgba, nullptr);
+  }
+  return tag;
+}
+
+struct RemoveTagsData {
+  GtkTextBuffer* buffer;
+  const char* prefix;
+  GtkTextIter* start;
+  GtkTextIter* end;
+};
+
+void RemoveTagWithPrefix(GtkTextTag* tag, RemoveTagsData* data) {
+  gchar* name = nullptr;
+  g_object_get(tag, "name", &name, nullptr);
+  if (name && g_str_has_prefix(name, data->prefix))
+    gtk_text_buffer_remove_tag(data->buffer, tag, data->start, data->end);
+  g_free(name);
+}
+
+// Replace the tags of the same kind with |tag| in range, otherwise the tag
+// with higher priority would win.
+void ApplyTag(GtkTextBuffer* buffer, GtkTextTag* tag, const char* prefix,
+              GtkTextIter* start, GtkTextIter* end) {
+  RemoveTagsData data = {buffer, prefix, start, end};
+  gtk_text_tag_table_foreach(gtk_text_buffer_get_tag_table(buffer),
+                             reinterpret_cast<GtkTextTagTableForeach>(
+                                 RemoveTagWithPrefix),
+                             &data);
+  gtk_text_buffer_apply_tag(buffer, tag, start, end);
+}
+
 void OnTextChange(GtkTextBuffer*, TextEdit* edit) {
   edit->on_text_change.Emit(edit);
 }
 
+void OnInsertText(GtkTextBuffer*,
+                  GtkTextIter* iter,
+                  gchar* text, gint length,
+                  TextEdit* edit) {
+  // The iter has been moved to the end of inserted text.
+  int start = gtk_text_iter_get_offset(iter) - g_utf8_strlen(text, length);
+  edit->on_text_range_change.Emit(edit, start, 0, std::string(text, length));
+}
+
+void OnBeforeDeleteRange(GtkTextBuffer* buffer,
+                         GtkTextIter* start_iter,
+                         GtkTextIter* end_iter,
+                         TextEdit* edit) {
+  // Both iters point to the start after deletion, so remember the length.
+  int removed = std::abs(gtk_text_iter_get_offset(end_iter) -
+                         gtk_text_iter_get_offset(start_iter));
+  g_object_set_data(G_OBJECT(buffer), "removed-length",
+                    GINT_TO_POINTER(removed));
+}
+
+void OnDeleteRange(GtkTextBuffer* buffer,
+                   GtkTextIter* start_iter,
+                   GtkTextIter* end_iter,
+                   TextEdit* edit) {
+  int removed = GPOINTER_TO_INT(
+      g_object_get_data(G_OBJECT(buffer), "removed-length"));
+  edit->on_text_range_change.Emit(edit, gtk_text_iter_get_offset(start_iter),
+                                  removed, std::string());
+}
+
 gboolean OnKeyPress(GtkWidget*, GdkEventKey* event, TextEdit* edit) {
   if (event->type == GDK_KEY_PRESS && event->keyval == GDK_KEY_Return &&
       edit->should_insert_new_line)
@@ -51,6 +142,12 @@ TextEdit::TextEdit() {
   GtkTextBuffer* buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(text_view));
   TextBufferMakeUndoable(buffer);
   g_signal_connect(buffer, "changed", G_CALLBACK(OnTextChange), this);
+  g_signal_connect_after(buffer, "insert-text", G_CALLBACK(OnInsertText),
+                         this);
+  g_signal_connect(buffer, "delete-range", G_CALLBACK(OnBeforeDeleteRange),
+                   this);
+  g_signal_connect_after(buffer, "delete-range", G_CALLBACK(OnDeleteRange),
+                         this);
 }
 
 TextEdit::~TextEdit() {
@@ -59,7 +156,7 @@ TextEdit::~TextEdit() {
 void TextEdit::SetText(const std::string& text) {
   GtkTextBuffer* buffer = gtk_text_view_get_buffer(
       GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
-  gtk_text_buffer_set_text(buffer, text.c_str(), text.size());
+  TextBufferResetText(buffer, text.c_str(), text.size());
 }
 
 std::string TextEdit::GetText() const {
@@ -201,6 +298,86 @@ void TextEdit::SetScrollbarPolicy(Scroll::Policy h_policy,
                                  ToGTK(h_policy), ToGTK(v_policy));
 }
 
+void TextEdit::PlatformAppendText(const std::string& text) {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  GtkTextIter iter;
+  gtk_text_buffer_get_end_iter(buffer, &iter);
+  // Appending does not move the positions of recorded actions.
+  TextBufferBeginNotUndoable(buffer);
+  gtk_text_buffer_insert(buffer, &iter, text.c_str(), text.size());
+  TextBufferEndNotUndoable(buffer);
+}
+
+int TextEdit::PlatformGetLineCount() const {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  return gtk_text_buffer_get_line_count(buffer);
+}
+
+void TextEdit::PlatformDeleteLines(int count) {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  GtkTextIter start_iter, end_iter;
+  gtk_text_buffer_get_start_iter(buffer, &start_iter);
+  gtk_text_buffer_get_iter_at_line(buffer, &end_iter, count);
+  TextBufferBeginNotUndoable(buffer);
+  gtk_text_buffer_delete(buffer, &start_iter, &end_iter);
+  TextBufferEndNotUndoable(buffer);
+  TextBufferClearUndo(buffer);
+}
+
+bool TextEdit::PlatformIsScrolledToEnd() const {
+  GtkAdjustment* adjust = gtk_scrolled_window_get_vadjustment(
+      GTK_SCROLLED_WINDOW(GetNative()));
+  return gtk_adjustment_get_value(adjust) +
+         gtk_adjustment_get_page_size(adjust) >=
+         gtk_adjustment_get_upper(adjust) - 1;
+}
+
+void TextEdit::PlatformScrollToEnd() {
+  GtkTextView* text_view =
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view"));
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(text_view);
+  // The mark stays at the end, and scrolling to it is done after the lines
+  // near it are validated, without laying out the whole buffer.
+  GtkTextMark* mark = gtk_text_buffer_get_mark(buffer, "nu-end");
+  if (!mark) {
+    GtkTextIter iter;
+    gtk_text_buffer_get_end_iter(buffer, &iter);
+    mark = gtk_text_buffer_create_mark(buffer, "nu-end", &iter, FALSE);
+  }
+  gtk_text_view_scroll_mark_onscreen(text_view, mark);
+}
+
+void TextEdit::SetAttributesForRanges(
+    const std::vector<RangeAttributes>& ranges) {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  // Tags do not go through the undo stack, and the view is only redrawn once
+  // after all tags are applied.
+  for (const RangeAttributes& range : ranges) {
+    GtkTextIter start_iter, end_iter;
+    gtk_text_buffer_get_iter_at_offset(buffer, &start_iter, range.start);
+    gtk_text_buffer_get_iter_at_offset(buffer, &end_iter, range.end);
+    if (range.font)
+      ApplyTag(buffer, GetFontTag(buffer, range.font.get()), kFontTagPrefix,
+               &start_iter, &end_iter);
+    if (range.color)
+      ApplyTag(buffer, GetColorTag(buffer, *range.color), kColorTagPrefix,
+               &start_iter, &end_iter);
+  }
+}
+
+void TextEdit::ClearAttributesInRange(int start, int end) {
+  GtkTextBuffer* buffer = gtk_text_view_get_buffer(
+      GTK_TEXT_VIEW(g_object_get_data(G_OBJECT(GetNative()), "text-view")));
+  GtkTextIter start_iter, end_iter;
+  gtk_text_buffer_get_iter_at_offset(buffer, &start_iter, start);
+  gtk_text_buffer_get_iter_at_offset(buffer, &end_iter, end);
+  gtk_text_buffer_remove_all_tags(buffer, &start_iter, &end_iter);
+}
+
 RectF TextEdit::GetTextBounds() const {
   // There is no reliable way to get the real text extends with GtkTextView
   // APIs, getting widget preferred size or scroll window upper value does not
@@ -11,9 +11,11 @@
 #include "base/base_paths.h"
 #include "base/check.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/logging.h"
 #include "base/path_service.h"
 #include "base/strings/stringprintf.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/image.h"
 #include "nativeui/menu.h"
 
@@ -196,6 +198,30 @@ void Tray::SetImage(scoped_refptr<Image> icon) {
   app_indicator_set_icon_full(tray_, name.c_str(), "icon");
 }
 
+void Tray::SetImageFromCanvas(scoped_refptr<Canvas> canvas) {
+  if (!tray_)
+    return;
+
+  // Write to the existing temp dir, which is already the icon theme path,
+  // instead of recreating it for every update. The name must change for the
+  // indicator to reload the icon.
+  base::FilePath previous = temp_dir_.GetPath().Append(base::StringPrintf(
+      "%s-%d.png", id_.c_str(), icon_change_count_ - 1));
+  std::string name = base::StringPrintf("%s-%d",
+                                        id_.c_str(), icon_change_count_++);
+  base::FilePath icon_path = temp_dir_.GetPath().Append(name + ".png");
+  cairo_surface_t* surface = canvas->GetBitmap();
+  cairo_surface_flush(surface);
+  if (cairo_surface_write_to_png(surface, icon_path.value().c_str()) !=
+      CAIRO_STATUS_SUCCESS) {
+    LOG(ERROR) << "Unable to save tray icon to temp dir";
+    return;
+  }
+
+  app_indicator_set_icon_full(tray_, name.c_str(), "icon");
+  base::DeleteFile(previous, false);
+}
+
 void Tray::SetMenu(scoped_refptr<Menu> menu) {
   if (!tray_)
     return;
@@ -0,0 +1,240 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree_view.h"
+
+#include "base/values.h"
+#include "nativeui/gtk/nu_tree_view_model.h"
+
+namespace nu {
+
+namespace {
+
+// Notifying more rows than this reloads the whole model instead.
+const uint32_t kMaxRowsToNotify = 1000;
+
+inline GtkTreeView* GetTreeView(const TreeView* view) {
+  return GTK_TREE_VIEW(g_object_get_data(G_OBJECT(view->GetNative()),
+                                         "tree-view"));
+}
+
+// Called to provide data to cell renderer.
+void TreeCellData(GtkTreeViewColumn* tree_column,
+                  GtkCellRenderer* renderer,
+                  GtkTreeModel* tree_model,
+                  GtkTreeIter* iter,
+                  void* user_data) {
+  GValue gval = G_VALUE_INIT;
+  gtk_tree_model_get_value(tree_model, iter, GPOINTER_TO_INT(user_data),
+                           &gval);
+  const auto* value =
+      static_cast<const base::Value*>(g_value_get_pointer(&gval));
+  g_value_unset(&gval);
+  g_object_set(renderer, "text",
+               value && value->is_string() ? value->GetString().c_str() : "",
+               nullptr);
+}
+
+gboolean OnTestExpandRow(GtkTreeView* tree_view,
+                         GtkTreeIter* iter,
+                         GtkTreePath* path,
+                         TreeView* view) {
+  view->OnNodeExpand(static_cast<TreeView::Node*>(iter->user_data));
+  // Allow expanding.
+  return false;
+}
+
+void OnRowCollapsed(GtkTreeView* tree_view,
+                    GtkTreeIter* iter,
+                    GtkTreePath* path,
+                    TreeView* view) {
+  view->OnNodeCollapse(static_cast<TreeView::Node*>(iter->user_data));
+}
+
+void OnSelectionChanged(GtkTreeSelection* selection, TreeView* view) {
+  view->on_selection_change.Emit(view);
+}
+
+// Expand the rows that were expanded before reloading.
+void RestoreExpanded(GtkTreeView* tree_view, TreeView::Node* node) {
+  for (const auto& child : node->children) {
+    if (!child->expanded)
+      continue;
+    GtkTreePath* path = nu_tree_view_model_get_node_path(child.get());
+    gtk_tree_view_expand_row(tree_view, path, false);
+    gtk_tree_path_free(path);
+    RestoreExpanded(tree_view, child.get());
+  }
+}
+
+// Reattaching the model makes the tree view read the rows again.
+void ReloadModel(TreeView* view) {
+  GtkTreeView* tree_view = GetTreeView(view);
+  GtkTreeModel* tree_model = gtk_tree_view_get_model(tree_view);
+  if (!tree_model)
+    return;
+  g_object_ref(tree_model);
+  gtk_tree_view_set_model(tree_view, nullptr);
+  gtk_tree_view_set_model(tree_view, tree_model);
+  g_object_unref(tree_model);
+  RestoreExpanded(tree_view, view->GetRoot());
+}
+
+}  // namespace
+
+NativeView TreeView::PlatformCreate() {
+  GtkWidget* tree_view = gtk_tree_view_new();
+  gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(tree_view), true);
+  g_signal_connect(tree_view, "test-expand-row",
+                   G_CALLBACK(OnTestExpandRow), this);
+  g_signal_connect(tree_view, "row-collapsed",
+                   G_CALLBACK(OnRowCollapsed), this);
+  g_signal_connect(gtk_tree_view_get_selection(GTK_TREE_VIEW(tree_view)),
+                   "changed", G_CALLBACK(OnSelectionChanged), this);
+  gtk_widget_show(tree_view);
+
+  GtkWidget* scroll = gtk_scrolled_window_new(nullptr, nullptr);
+  g_object_set_data(G_OBJECT(scroll), "tree-view", tree_view);
+  gtk_container_add(GTK_CONTAINER(scroll), tree_view);
+  return scroll;
+}
+
+void TreeView::PlatformDestroy() {
+  // The widget relies on TreeView to get nodes, so we must ensure the
+  // widget is destroyed before this class.
+  View::PlatformDestroy();
+}
+
+void TreeView::PlatformSetModel(TreeModel* model) {
+  GtkTreeView* tree_view = GetTreeView(this);
+  if (!model) {
+    gtk_tree_view_set_model(tree_view, nullptr);
+    return;
+  }
+  NUTreeViewModel* tree_model = nu_tree_view_model_new(this);
+  gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(tree_model));
+  g_object_unref(tree_model);
+}
+
+void TreeView::AddColumn(const std::string& title) {
+  GtkTreeView* tree_view = GetTreeView(this);
+  int column = GetColumnCount();
+  GtkCellRenderer* renderer = gtk_cell_renderer_text_new();
+  auto* tree_column = gtk_tree_view_column_new_with_attributes(
+      title.c_str(), renderer, nullptr);
+  gtk_tree_view_column_set_sizing(tree_column, GTK_TREE_VIEW_COLUMN_FIXED);
+  gtk_tree_view_column_set_resizable(tree_column, true);
+  gtk_tree_view_column_set_cell_data_func(
+      tree_column, renderer, &TreeCellData, GINT_TO_POINTER(column), nullptr);
+  gtk_tree_view_append_column(tree_view, tree_column);
+}
+
+int TreeView::GetColumnCount() const {
+  return gtk_tree_view_get_n_columns(GetTreeView(this));
+}
+
+void TreeView::SetColumnsVisible(bool visible) {
+  gtk_tree_view_set_headers_visible(GetTreeView(this), visible);
+}
+
+bool TreeView::IsColumnsVisible() const {
+  return gtk_tree_view_get_headers_visible(GetTreeView(this));
+}
+
+void TreeView::PlatformExpandNode(Node* node, bool expand) {
+  GtkTreeView* tree_view = GetTreeView(this);
+  GtkTreePath* path = nu_tree_view_model_get_node_path(node);
+  if (expand)
+    gtk_tree_view_expand_row(tree_view, path, false);
+  else
+    gtk_tree_view_collapse_row(tree_view, path);
+  gtk_tree_path_free(path);
+}
+
+void TreeView::PlatformSelectNode(Node* node) {
+  GtkTreeView* tree_view = GetTreeView(this);
+  if (!gtk_tree_view_get_model(tree_view))
+    return;
+  GtkTreeIter iter;
+  nu_tree_view_model_get_node_iter(node, &iter);
+  gtk_tree_selection_select_iter(gtk_tree_view_get_selection(tree_view),
+                                 &iter);
+}
+
+TreeView::Node* TreeView::PlatformGetSelectedNode() const {
+  GtkTreeView* tree_view = GetTreeView(this);
+  GtkTreeModel* tree_model = gtk_tree_view_get_model(tree_view);
+  if (!tree_model)
+    return nullptr;
+  GtkTreeIter iter;
+  GtkTreeSelection* selection = gtk_tree_view_get_selection(tree_view);
+  if (gtk_tree_selection_get_selected(selection, &tree_model, &iter))
+    return static_cast<Node*>(iter.user_data);
+  return nullptr;
+}
+
+void TreeView::PlatformChildrenInserted(Node* parent,
+                                        uint32_t start,
+                                        uint32_t count) {
+  GtkTreeModel* tree_model = gtk_tree_view_get_model(GetTreeView(this));
+  if (!tree_model)
+    return;
+  // GtkTreeModel has no API for batch changes, and notifying each row costs
+  // more than reloading the model when there are many rows.
+  if (count > kMaxRowsToNotify) {
+    ReloadModel(this);
+    return;
+  }
+  for (uint32_t i = start; i < start + count; ++i) {
+    GtkTreeIter iter;
+    nu_tree_view_model_get_node_iter(parent->children[i].get(), &iter);
+    GtkTreePath* path = nu_tree_view_model_get_node_path(
+        parent->children[i].get());
+    gtk_tree_model_row_inserted(tree_model, path, &iter);
+    gtk_tree_path_free(path);
+  }
+  // The parent just got its first children.
+  if (parent->parent && parent->children.size() == count)
+    PlatformNodeChanged(parent);
+}
+
+void TreeView::PlatformChildrenDeleted(Node* parent,
+                                       uint32_t start,
+                                       const Nodes& removed) {
+  GtkTreeModel* tree_model = gtk_tree_view_get_model(GetTreeView(this));
+  if (!tree_model)
+    return;
+  if (removed.size() > kMaxRowsToNotify) {
+    ReloadModel(this);
+    return;
+  }
+  // Deleting rows at |start| one by one.
+  GtkTreePath* path = nu_tree_view_model_get_node_path(parent);
+  gtk_tree_path_append_index(path, start);
+  for (size_t i = 0; i < removed.size(); ++i)
+    gtk_tree_model_row_deleted(tree_model, path);
+  gtk_tree_path_free(path);
+  if (parent->parent && parent->children.empty())
+    PlatformNodeChanged(parent);
+}
+
+void TreeView::PlatformNodeChanged(Node* node) {
+  GtkTreeModel* tree_model = gtk_tree_view_get_model(GetTreeView(this));
+  if (!tree_model || !node->parent)
+    return;
+  GtkTreeIter iter;
+  nu_tree_view_model_get_node_iter(node, &iter);
+  GtkTreePath* path = nu_tree_view_model_get_node_path(node);
+  gtk_tree_model_row_changed(tree_model, path, &iter);
+  gtk_tree_model_row_has_child_toggled(tree_model, path, &iter);
+  gtk_tree_path_free(path);
+}
+
+void TreeView::PlatformChildrenReset(Node* parent, const Nodes& removed) {
+  // Removing the rows one by one would make GtkTreeView read the new children
+  // in the middle of deletions.
+  ReloadModel(this);
+}
+
+}  // namespace nu
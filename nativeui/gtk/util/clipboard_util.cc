@@ -229,4 +229,44 @@ Data GetDataFromClipboard(GtkClipboard* clipboard,
   return Data();
 }
 
+GtkSelectionData* GetRawDataFromClipboard(GtkClipboard* clipboard,
+                                          Clipboard::Data::Type type) {
+  switch (type) {
+    case Data::Type::Text:
+      return gtk_clipboard_wait_for_contents(
+          clipboard, gdk_atom_intern_static_string("UTF8_STRING"));
+    case Data::Type::HTML:
+    case Data::Type::Image:
+      return gtk_clipboard_wait_for_contents(clipboard, GetAtomForType(type));
+    default:
+      return nullptr;
+  }
+}
+
+bool ReadDataFromSelection(GtkSelectionData* selection,
+                           Clipboard::Data::Type type,
+                           const Clipboard::DataReader& reader) {
+  const char* data =
+      reinterpret_cast<const char*>(gtk_selection_data_get_data(selection));
+  int size = gtk_selection_data_get_length(selection);
+  if (!data || size < 0)
+    return false;
+  switch (type) {
+    case Data::Type::Text:
+      // Text may have a terminating NULL.
+      if (size > 0 && data[size - 1] == '\0')
+        --size;
+      return Clipboard::ReadChunks(data, size, reader);
+    case Data::Type::HTML: {
+      // Markup may be in UTF-16 and have prefix, which requires converting.
+      std::string markup = ReadMarkupFromSelectionData(selection);
+      return Clipboard::ReadChunks(markup.data(), markup.size(), reader);
+    }
+    case Data::Type::Image:
+      return Clipboard::ReadChunks(data, size, reader);
+    default:
+      return false;
+  }
+}
+
 }  // namespace nu
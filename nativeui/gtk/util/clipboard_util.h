@@ -36,6 +36,16 @@ Clipboard::Data GetDataFromSelection(GtkSelectionData* selection,
 Clipboard::Data GetDataFromClipboard(GtkClipboard* clipboard,
                                      Clipboard::Data::Type type);
 
+// Get the undecoded data of type from GtkClipboard, the result must be freed
+// with gtk_selection_data_free.
+GtkSelectionData* GetRawDataFromClipboard(GtkClipboard* clipboard,
+                                          Clipboard::Data::Type type);
+
+// Read the undecoded data from GtkSelectionData in chunks.
+bool ReadDataFromSelection(GtkSelectionData* selection,
+                           Clipboard::Data::Type type,
+                           const Clipboard::DataReader& reader);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_UTIL_CLIPBOARD_UTIL_H_
@@ -168,4 +168,30 @@ bool TextBufferCanRedo(GtkTextBuffer* buffer) {
   return !data->redo_stack.empty();
 }
 
+void TextBufferResetText(GtkTextBuffer* buffer, const char* text, int length) {
+  TextBufferBeginNotUndoable(buffer);
+  gtk_text_buffer_set_text(buffer, text, length);
+  TextBufferEndNotUndoable(buffer);
+  TextBufferClearUndo(buffer);
+}
+
+void TextBufferBeginNotUndoable(GtkTextBuffer* buffer) {
+  auto* data = static_cast<UndoableData*>(
+      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
+  data->ignore_events = true;
+}
+
+void TextBufferEndNotUndoable(GtkTextBuffer* buffer) {
+  auto* data = static_cast<UndoableData*>(
+      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
+  data->ignore_events = false;
+}
+
+void TextBufferClearUndo(GtkTextBuffer* buffer) {
+  auto* data = static_cast<UndoableData*>(
+      g_object_get_data(G_OBJECT(buffer), "undoable-data"));
+  data->undo_stack = std::stack<UndoableAction>();
+  data->redo_stack = std::stack<UndoableAction>();
+}
+
 }  // namespace nu
@@ -19,6 +19,18 @@ bool TextBufferCanUndo(GtkTextBuffer* buffer);
 void TextBufferRedo(GtkTextBuffer* buffer);
 bool TextBufferCanRedo(GtkTextBuffer* buffer);
 
+// Replace the whole text without recording undo actions, the stacks are
+// cleared so the old text is not kept in memory.
+void TextBufferResetText(GtkTextBuffer* buffer, const char* text, int length);
+
+// Changes made until TextBufferEndNotUndoable are not recorded.
+void TextBufferBeginNotUndoable(GtkTextBuffer* buffer);
+void TextBufferEndNotUndoable(GtkTextBuffer* buffer);
+
+// Clear the undo/redo stacks, needed when changes that are not recorded move
+// the positions of recorded actions.
+void TextBufferClearUndo(GtkTextBuffer* buffer);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_UTIL_UNDOABLE_TEXT_BUFFER_H_
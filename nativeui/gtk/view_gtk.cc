@@ -10,12 +10,15 @@
 #include "nativeui/container.h"
 #include "nativeui/cursor.h"
 #include "nativeui/events/event.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/point_f.h"
 #include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/gfx/geometry/rect_f.h"
+#include "nativeui/gfx/gtk/painter_gtk.h"
 #include "nativeui/gtk/dragging_info_gtk.h"
 #include "nativeui/gtk/nu_container.h"
+#include "nativeui/gtk/nu_label.h"
 #include "nativeui/gtk/util/clipboard_util.h"
 #include "nativeui/gtk/util/widget_util.h"
 
@@ -28,9 +31,25 @@ View* g_grabbed_view = nullptr;
 
 // View private data.
 struct NUViewPrivate {
+  ~NUViewPrivate() {
+    if (layer)
+      cairo_surface_destroy(layer);
+  }
+
   View* delegate;
   // Current view size.
   Size size;
+  // Current position relative to parent.
+  Point origin;
+
+  // The cached contents of layer-backed view.
+  cairo_surface_t* layer = nullptr;
+  Size layer_size;
+  int layer_scale = 0;
+  bool layer_dirty = true;
+  // Whether the widget is drawing into the layer.
+  bool painting_layer = false;
+  gulong draw_layer_handler = 0;
 
   // The current drop session (dest).
   GdkDragContext* drop_context = nullptr;
@@ -60,6 +79,81 @@ void NUSetCursor(GtkWidget* widget, GdkCursor* cursor) {
     gdk_window_set_cursor(window, cursor);
 }
 
+NUViewPrivate* GetPrivate(const View* view) {
+  return static_cast<NUViewPrivate*>(
+      g_object_get_data(G_OBJECT(view->GetNative()), "private"));
+}
+
+// Mark the layers of |view| and its parents as dirty.
+void InvalidateLayers(View* view) {
+  for (; view; view = view->GetParent()) {
+    if (view->IsLayerBacked())
+      GetPrivate(view)->layer_dirty = true;
+  }
+}
+
+// Whether |widget| and its children are only drawn by our own widgets, whose
+// repaints always go through View::SchedulePaint. Native GTK widgets queue
+// redraws by themselves, for example when animating or blinking cursor,
+// which would leave a cached layer stale.
+bool IsDrawnByViews(GtkWidget* widget) {
+  if (G_TYPE_CHECK_INSTANCE_TYPE(widget, NU_TYPE_LABEL))
+    return true;
+  // The event box is used for wrapping labels.
+  if (!NU_IS_CONTAINER(widget) && !GTK_IS_EVENT_BOX(widget))
+    return false;
+  bool result = true;
+  gtk_container_forall(GTK_CONTAINER(widget), [](GtkWidget* child,
+                                                 gpointer data) {
+    bool* result = static_cast<bool*>(data);
+    if (*result && !IsDrawnByViews(child))
+      *result = false;
+  }, &result);
+  return result;
+}
+
+gboolean OnDrawLayer(GtkWidget* widget, cairo_t* cr, NUViewPrivate* priv) {
+  // Let the widget draw itself into the layer.
+  if (priv->painting_layer)
+    return FALSE;
+
+  // Layers containing native widgets are not cached.
+  if (!IsDrawnByViews(widget)) {
+    if (priv->layer) {
+      cairo_surface_destroy(priv->layer);
+      priv->layer = nullptr;
+    }
+    return FALSE;
+  }
+
+  Size size(gtk_widget_get_allocated_width(widget),
+            gtk_widget_get_allocated_height(widget));
+  int scale = gtk_widget_get_scale_factor(widget);
+  if (!priv->layer || priv->layer_size != size || priv->layer_scale != scale) {
+    if (priv->layer)
+      cairo_surface_destroy(priv->layer);
+    priv->layer = gdk_window_create_similar_surface(
+        gtk_widget_get_window(widget), CAIRO_CONTENT_COLOR_ALPHA,
+        size.width(), size.height());
+    priv->layer_size = size;
+    priv->layer_scale = scale;
+    priv->layer_dirty = true;
+  }
+
+  if (priv->layer_dirty) {
+    cairo_t* layer_cr = cairo_create(priv->layer);
+    priv->painting_layer = true;
+    gtk_widget_draw(widget, layer_cr);
+    priv->painting_layer = false;
+    cairo_destroy(layer_cr);
+    priv->layer_dirty = false;
+  }
+
+  cairo_set_source_surface(cr, priv->layer, 0, 0);
+  cairo_paint(cr);
+  return TRUE;
+}
+
 void OnSizeAllocate(GtkWidget* widget, GdkRectangle* allocation,
                     NUViewPrivate* priv) {
   // Ignore empty sizes on initialization.
@@ -67,8 +161,22 @@ void OnSizeAllocate(GtkWidget* widget, GdkRectangle* allocation,
       allocation->width == 1 && allocation->height == 1)
     return;
 
+  // Moving a view only changes the layers of its parents, children are
+  // allocated before parent so the parent's allocation is already updated.
+  View* parent = priv->delegate->GetParent();
+  Point origin(allocation->x, allocation->y);
+  if (parent) {
+    GdkRectangle pb;
+    gtk_widget_get_allocation(parent->GetNative(), &pb);
+    origin -= Vector2d(pb.x, pb.y);
+  }
+
   // Size allocation happens unnecessarily often.
   Size size(allocation->width, allocation->height);
+  if (size != priv->size || origin != priv->origin) {
+    priv->origin = origin;
+    InvalidateLayers(parent);
+  }
   if (size != priv->size) {
     priv->size = size;
     priv->delegate->OnSizeChanged();
@@ -97,7 +205,7 @@ gboolean OnMouseMove(GtkWidget* widget, GdkEvent* event, View* view) {
 
   // Otherwise dispatch the event.
   if (!view->on_mouse_move.IsEmpty()) {
-    view->on_mouse_move.Emit(view, MouseEvent(event, widget));
+    view->EmitMouseMove(MouseEvent(event, widget));
     return false;
   }
 
@@ -105,16 +213,14 @@ gboolean OnMouseMove(GtkWidget* widget, GdkEvent* event, View* view) {
 }
 
 gboolean OnMouseEvent(GtkWidget* widget, GdkEvent* event, View* view) {
+  view->FlushMouseMove();
   switch (event->any.type) {
     case GDK_BUTTON_PRESS:
-      return view->on_mouse_down.Emit(view, MouseEvent(event, widget));
     case GDK_BUTTON_RELEASE:
-      return view->on_mouse_up.Emit(view, MouseEvent(event, widget));
+      return view->EmitMouseEvent(MouseEvent(event, widget));
     case GDK_ENTER_NOTIFY:
-      view->on_mouse_enter.Emit(view, MouseEvent(event, widget));
-      return false;
     case GDK_LEAVE_NOTIFY:
-      view->on_mouse_leave.Emit(view, MouseEvent(event, widget));
+      view->EmitMouseEvent(MouseEvent(event, widget));
       return false;
     default:
       return false;
@@ -122,11 +228,11 @@ gboolean OnMouseEvent(GtkWidget* widget, GdkEvent* event, View* view) {
 }
 
 gboolean OnKeyDown(GtkWidget* widget, GdkEvent* event, View* view) {
-  return view->on_key_down.Emit(view, KeyEvent(event, widget));
+  return view->EmitKeyEvent(KeyEvent(event, widget));
 }
 
 gboolean OnKeyUp(GtkWidget* widget, GdkEvent* event, View* view) {
-  return view->on_key_up.Emit(view, KeyEvent(event, widget));
+  return view->EmitKeyEvent(KeyEvent(event, widget));
 }
 
 void OnDragEnd(GtkWidget*, GdkDragContext*, NUViewPrivate* priv) {
@@ -333,10 +439,12 @@ Rect View::GetPixelBounds() const {
 }
 
 void View::SchedulePaint() {
+  InvalidateLayers(this);
   gtk_widget_queue_draw(view_);
 }
 
 void View::SchedulePaintRect(const RectF& rect) {
+  InvalidateLayers(this);
   gtk_widget_queue_draw_area(view_,
                              rect.x(), rect.y(), rect.width(), rect.height());
 }
@@ -373,6 +481,7 @@ bool View::HasFocus() const {
 }
 
 void View::SetFocusable(bool focusable) {
+  properties_changed_ = true;
   gtk_widget_set_can_focus(view_, focusable);
 }
 
@@ -415,6 +524,7 @@ bool View::HasCapture() const {
 }
 
 void View::SetMouseDownCanMoveWindow(bool yes) {
+  properties_changed_ = true;
   g_object_set_data(G_OBJECT(view_), "draggable", yes ? this : nullptr);
 }
 
@@ -493,6 +603,36 @@ void View::RegisterDraggedTypes(std::set<Clipboard::Data::Type> types) {
   gtk_target_list_unref(targets);
 }
 
+void View::RenderToCanvas(Canvas* canvas, const RectF& rect) {
+  int width = gtk_widget_get_allocated_width(view_);
+  int height = gtk_widget_get_allocated_height(view_);
+  if (width <= 1 || height <= 1 || !gtk_widget_get_visible(view_))
+    return;
+  cairo_t* cr = static_cast<PainterGtk*>(canvas->GetPainter())->context();
+  cairo_save(cr);
+  cairo_translate(cr, rect.x(), rect.y());
+  cairo_scale(cr, rect.width() / width, rect.height() / height);
+  gtk_widget_draw(view_, cr);
+  cairo_restore(cr);
+}
+
+void View::PlatformSetLayerBacked(bool backed) {
+  NUViewPrivate* priv = GetPrivate(this);
+  if (backed) {
+    priv->draw_layer_handler = g_signal_connect(
+        view_, "draw", G_CALLBACK(OnDrawLayer), priv);
+  } else {
+    g_signal_handler_disconnect(view_, priv->draw_layer_handler);
+    priv->draw_layer_handler = 0;
+    if (priv->layer) {
+      cairo_surface_destroy(priv->layer);
+      priv->layer = nullptr;
+    }
+  }
+  priv->layer_dirty = true;
+  SchedulePaint();
+}
+
 void View::PlatformSetCursor(Cursor* cursor) {
   if (!gtk_widget_get_has_window(view_) && !IsContainer())
     gtk_widget_set_has_window(view_, true);
@@ -500,16 +640,21 @@ void View::PlatformSetCursor(Cursor* cursor) {
 }
 
 void View::PlatformSetFont(Font* font) {
+  InvalidateLayers(this);
   gtk_widget_override_font(view_, font->GetNative());
 }
 
 void View::SetColor(Color color) {
+  properties_changed_ = true;
+  InvalidateLayers(this);
   ApplyStyle(view_, "color",
              base::StringPrintf("* { color: %s; }",
                                 color.ToString().c_str()));
 }
 
 void View::SetBackgroundColor(Color color) {
+  properties_changed_ = true;
+  InvalidateLayers(this);
   ApplyStyle(view_, "background-color",
              base::StringPrintf("* { background-color: %s; }",
                                 color.ToString().c_str()));
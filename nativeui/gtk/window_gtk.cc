@@ -7,9 +7,12 @@
 #include <gtk/gtk.h>
 
 #include <algorithm>
+#include <memory>
 
 #include "nativeui/gtk/util/widget_util.h"
 #include "nativeui/menu_bar.h"
+#include "nativeui/paint_stats.h"
+#include "nativeui/state.h"
 
 namespace nu {
 
@@ -33,6 +36,8 @@ struct NUWindowPrivate {
   bool is_input_shape_set = false;
   bool is_draw_handler_set = false;
   guint draw_handler_id = 0;
+  // The paint in progress.
+  std::unique_ptr<ScopedPaintTimer> paint_timer;
 };
 
 // Helper to receive private data.
@@ -135,6 +140,9 @@ gboolean OnMap(GtkWidget* widget, GdkEvent* event, NUWindowPrivate* priv) {
 gboolean OnWindowState(GtkWidget* widget, GdkEvent* event,
                        NUWindowPrivate* priv) {
   priv->window_state = event->window_state.new_window_state;
+  if (event->window_state.changed_mask &
+      (GDK_WINDOW_STATE_ICONIFIED | GDK_WINDOW_STATE_WITHDRAWN))
+    priv->delegate->NotifyOcclusionChanged();
   return FALSE;
 }
 
@@ -166,6 +174,29 @@ gboolean OnDrawBackground(GtkWidget* widget, cairo_t* cr,
   return FALSE;
 }
 
+// Start recording the paint before the window is drawn.
+gboolean OnDrawStart(GtkWidget* widget, cairo_t* cr, NUWindowPrivate* priv) {
+  if (!State::GetCurrent()->IsPaintStatsEnabled())
+    return FALSE;
+  GdkRectangle clip;
+  if (!gdk_cairo_get_clip_rectangle(cr, &clip))
+    return FALSE;
+  int scale = gtk_widget_get_scale_factor(widget);
+  priv->paint_timer.reset(new ScopedPaintTimer(
+      priv->delegate,
+      Rect(clip.x * scale, clip.y * scale,
+           clip.width * scale, clip.height * scale)));
+  if (priv->delegate->GetContentView())
+    ScopedPaintTimer::CountView(priv->delegate->GetContentView());
+  return FALSE;
+}
+
+// Finish recording the paint after the window is drawn.
+gboolean OnDrawEnd(GtkWidget* widget, cairo_t* cr, NUWindowPrivate* priv) {
+  priv->paint_timer.reset();
+  return FALSE;
+}
+
 // Get the height of menubar.
 inline int GetMenuBarHeight(const Window* window) {
   int menu_bar_height = 0;
@@ -197,6 +228,8 @@ void Window::PlatformInit(const Options& options) {
                    G_CALLBACK(OnWindowState), priv);
   g_signal_connect(window_, "notify::is-active",
                    G_CALLBACK(OnIsActiveChanged), this);
+  g_signal_connect(window_, "draw", G_CALLBACK(OnDrawStart), priv);
+  g_signal_connect_after(window_, "draw", G_CALLBACK(OnDrawEnd), priv);
 
   if (!options.frame) {
     // Rely on client-side decoration to provide window features for frameless
@@ -404,6 +437,7 @@ std::tuple<SizeF, SizeF> Window::GetContentSizeConstraints() const {
 }
 
 void Window::Activate() {
+  NotifyWillShow();
   if (!IsVisible())
     gtk_window_set_focus_on_map(window_, true);
   gtk_window_present(window_);
@@ -418,6 +452,8 @@ bool Window::IsActive() const {
 }
 
 void Window::SetVisible(bool visible) {
+  if (visible)
+    NotifyWillShow();
   gtk_widget_set_visible(GTK_WIDGET(window_), visible);
 }
 
@@ -425,6 +461,11 @@ bool Window::IsVisible() const {
   return gtk_widget_get_visible(GTK_WIDGET(window_));
 }
 
+bool Window::IsOccluded() const {
+  // There is no reliable way to know whether the window is covered by others.
+  return !IsVisible() || IsMinimized();
+}
+
 void Window::SetAlwaysOnTop(bool top) {
   gtk_window_set_keep_above(window_, top);
 }
@@ -585,4 +626,22 @@ void Window::PlatformRemoveChildWindow(Window* child) {
   gtk_window_set_transient_for(child->GetNative(), nullptr);
 }
 
+void Window::PlatformRequestFrame() {
+  if (!window_ || tick_callback_id_)
+    return;
+  auto on_tick = [](GtkWidget*, GdkFrameClock* clock,
+                    gpointer data) -> gboolean {
+    auto* self = static_cast<Window*>(data);
+    // The frame time is in microseconds of the monotonic clock.
+    double timestamp = gdk_frame_clock_get_frame_time(clock) / 1000.;
+    if (self->RunFrameCallbacks(timestamp))
+      return G_SOURCE_CONTINUE;
+    self->tick_callback_id_ = 0;
+    return G_SOURCE_REMOVE;
+  };
+  // The tick callback is removed together with the widget.
+  tick_callback_id_ = gtk_widget_add_tick_callback(GTK_WIDGET(window_),
+                                                   on_tick, this, nullptr);
+}
+
 }  // namespace nu
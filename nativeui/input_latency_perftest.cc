@@ -0,0 +1,166 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "nativeui/test/input_injector.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kSamples = 50;
+
+// Inputs whose reactions do not appear within the time are counted as lost.
+const int kTimeoutMs = 1000;
+
+// Time for the window to settle before injecting input.
+const int kSettleMs = 500;
+
+}  // namespace
+
+// Measures the time from injecting input to the first frame produced after
+// the widget reacts to it.
+//
+// The synthetic input goes through the input queue of the system, so the
+// tests take over the mouse and keyboard while running.
+class InputLatencyPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    nu::Window::Options options;
+    options.frame = false;
+    window_ = new nu::Window(options);
+    window_->SetContentSize(nu::SizeF(400, 300));
+    window_->Center();
+  }
+
+  void TearDown() override {
+    window_->Close();
+  }
+
+  // Show |view| in the window and wait for it to settle.
+  void ShowView(nu::View* view) {
+    window_->SetContentView(view);
+    window_->Activate();
+    nu::MessageLoop::PostDelayedTask(kSettleMs, []() {
+      nu::MessageLoop::Quit();
+    });
+    nu::MessageLoop::Run();
+  }
+
+  // Inject input with |inject| for kSamples times and report the latencies.
+  void Measure(const std::string& name, const std::function<bool()>& inject) {
+    std::vector<base::TimeDelta> samples;
+    int lost = 0;
+    for (int i = 0; i < kSamples; ++i) {
+      ++sample_id_;
+      waiting_ = true;
+      start_ = base::TimeTicks::Now();
+      if (!inject()) {
+        fprintf(stderr, "Skipping %s: input can not be injected.\n",
+                name.c_str());
+        return;
+      }
+      latency_ = base::TimeDelta();
+      nu::MessageLoop::TimerId timer = nu::MessageLoop::SetTimeout(
+          kTimeoutMs, [this]() {
+            waiting_ = false;
+            nu::MessageLoop::Quit();
+          });
+      nu::MessageLoop::Run();
+      nu::MessageLoop::ClearTimeout(timer);
+      if (latency_.is_zero())
+        ++lost;
+      else
+        samples.push_back(latency_);
+    }
+    EXPECT_LT(lost, kSamples / 10) << name << " lost too many inputs";
+    nu::ReportPercentiles(name, std::move(samples));
+  }
+
+  // Called when the widget reacts to the injected input, the latency is
+  // recorded when the next frame is produced.
+  void OnReacted() {
+    if (!waiting_)
+      return;
+    waiting_ = false;
+    int id = sample_id_;
+    window_->RequestFrame([this, id](double) {
+      if (id != sample_id_)
+        return;
+      latency_ = base::TimeTicks::Now() - start_;
+      nu::MessageLoop::Quit();
+    });
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+
+  int sample_id_ = 0;
+  bool waiting_ = false;
+  base::TimeTicks start_;
+  base::TimeDelta latency_;
+};
+
+TEST_F(InputLatencyPerfTest, ButtonClick) {
+  scoped_refptr<nu::Button> button = new nu::Button("Button");
+  button->on_click.Connect([this](nu::Button*) { OnReacted(); });
+  ShowView(button.get());
+  Measure("ButtonClickLatency",
+          [&]() { return nu::InjectClick(button.get()); });
+}
+
+TEST_F(InputLatencyPerfTest, CheckboxClick) {
+  scoped_refptr<nu::Button> checkbox =
+      new nu::Button("Checkbox", nu::Button::Type::Checkbox);
+  checkbox->on_click.Connect([this](nu::Button*) { OnReacted(); });
+  ShowView(checkbox.get());
+  Measure("CheckboxClickLatency",
+          [&]() { return nu::InjectClick(checkbox.get()); });
+}
+
+TEST_F(InputLatencyPerfTest, EntryKeyPress) {
+  scoped_refptr<nu::Entry> entry = new nu::Entry;
+  entry->on_text_change.Connect([this](nu::Entry*) { OnReacted(); });
+  ShowView(entry.get());
+  entry->Focus();
+  Measure("EntryKeyPressLatency",
+          []() { return nu::InjectKeyPress(nu::VKEY_A); });
+}
+
+TEST_F(InputLatencyPerfTest, TextEditKeyPress) {
+  scoped_refptr<nu::TextEdit> edit = new nu::TextEdit;
+  edit->on_text_change.Connect([this](nu::TextEdit*) { OnReacted(); });
+  ShowView(edit.get());
+  edit->Focus();
+  Measure("TextEditKeyPressLatency",
+          []() { return nu::InjectKeyPress(nu::VKEY_A); });
+}
+
+// A custom widget which repaints on mouse down, the reaction happens when the
+// new content is drawn.
+TEST_F(InputLatencyPerfTest, CustomDrawClick) {
+  scoped_refptr<nu::Container> custom = new nu::Container;
+  bool pressed = false;
+  custom->on_mouse_down.Connect([&](nu::View* view, const nu::MouseEvent&) {
+    pressed = !pressed;
+    view->SchedulePaint();
+    return true;
+  });
+  custom->on_draw.Connect([&](nu::Container*, nu::Painter* painter,
+                              const nu::RectF& dirty) {
+    painter->SetFillColor(pressed ? nu::Color(0xFF, 0xFF, 0, 0)
+                                  : nu::Color(0xFF, 0, 0, 0xFF));
+    painter->FillRect(dirty);
+    OnReacted();
+  });
+  ShowView(custom.get());
+  Measure("CustomDrawClickLatency",
+          [&]() { return nu::InjectClick(custom.get()); });
+}
@@ -4,11 +4,18 @@
 
 #include "nativeui/label.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "nativeui/app.h"
 #include "nativeui/gfx/attributed_text.h"
 #include "nativeui/gfx/font.h"
+#include "nativeui/gfx/text_layout_cache.h"
+#include "nativeui/layout_stats.h"
+#include "nativeui/state.h"
+#include "nativeui/util/yoga_util.h"
+#include "nativeui/window.h"
 #include "third_party/yoga/Yoga.h"
 
 namespace nu {
@@ -19,8 +26,8 @@ YGSize MeasureLabel(YGNodeRef node,
                     float width, YGMeasureMode mode,
                     float height, YGMeasureMode height_mode) {
   auto* label = static_cast<Label*>(YGNodeGetContext(node));
-  SizeF size = label->GetAttributedText()
-                    ->GetBoundsFor(SizeF(width, height)).size();
+  ScopedMeasureTimer timer(label->GetClassName());
+  SizeF size = label->GetTextSizeFor(SizeF(width, height));
   size.Enlarge(1, 1);  // leave space for border
   return {std::ceil(size.width()), std::ceil(size.height())};
 }
@@ -49,6 +56,9 @@ void Label::SetText(const std::string& text) {
             : TextFormat({TextAlign::Center, TextAlign::Center, true, false});
   SetAttributedText(new AttributedText(text, format));
 
+  plain_text_ = true;
+  plain_text_generation_ = text_->generation();
+  plain_text_font_ = nullptr;
   use_system_color_ = true;
   system_color_ = Color::Get(Color::Name::Text);
 }
@@ -58,20 +68,25 @@ std::string Label::GetText() const {
 }
 
 void Label::SetAlign(TextAlign align) {
+  bool plain = IsPlainText();
   TextFormat format = text_->GetFormat();
   format.align = align;
   text_->SetFormat(std::move(format));
+  KeepPlainText(plain);
   MarkDirty();
 }
 
 void Label::SetVAlign(TextAlign align) {
+  bool plain = IsPlainText();
   TextFormat format = text_->GetFormat();
   format.valign = align;
   text_->SetFormat(std::move(format));
+  KeepPlainText(plain);
   MarkDirty();
 }
 
 void Label::SetAttributedText(scoped_refptr<AttributedText> text) {
+  plain_text_ = false;
   use_system_color_ = false;
   text_ = std::move(text);
   MarkDirty();
@@ -87,12 +102,63 @@ void Label::UpdateColor() {
   system_color_ = color;
 }
 
+SizeF Label::GetTextSizeFor(const SizeF& size) {
+  // The measure modes are not part of the key, since the text bounds only
+  // depend on the constraint size.
+  if (measure_cache_generation_ != text_->generation()) {
+    measure_cache_generation_ = text_->generation();
+    measure_cache_size_ = 0;
+  } else {
+    for (size_t i = 0; i < measure_cache_size_; ++i) {
+      const MeasureResult& result = measure_cache_[i];
+      if (IsSameDimension(result.constraint.width(), size.width()) &&
+          IsSameDimension(result.constraint.height(), size.height()))
+        return result.size;
+    }
+  }
+  // Reuse the most recent measurement while window is being resized.
+  if (measure_cache_size_ > 0 && GetWindow() &&
+      GetWindow()->IsApproximatingLayout()) {
+    measure_approximated_ = true;
+    size_t last = (next_measure_cache_ + measure_cache_.size() - 1) %
+                  measure_cache_.size();
+    return measure_cache_[last].size;
+  }
+  SizeF result;
+  if (IsPlainText()) {
+    // Labels showing the same string share the measurement, the color does
+    // not affect bounds so the default one is used.
+    TextAttributes attributes(text_->GetFormat());
+    if (plain_text_font_)
+      attributes.font = plain_text_font_;
+    result = State::GetCurrent()->GetTextLayoutCache()->GetBoundsFor(
+        GetText(), attributes, size).size();
+  } else {
+    result = text_->GetBoundsFor(size).size();
+  }
+  measure_cache_[next_measure_cache_] = {size, result};
+  next_measure_cache_ = (next_measure_cache_ + 1) % measure_cache_.size();
+  measure_cache_size_ = std::min(measure_cache_size_ + 1,
+                                 measure_cache_.size());
+  return result;
+}
+
 void Label::Init() {
   TakeOverView(PlatformCreate());
   YGNodeSetMeasureFunc(node(), MeasureLabel);
 }
 
+bool Label::IsPlainText() const {
+  return plain_text_ && plain_text_generation_ == text_->generation();
+}
+
+void Label::KeepPlainText(bool plain) {
+  if (plain)
+    plain_text_generation_ = text_->generation();
+}
+
 void Label::MarkDirty() {
+  measure_cache_size_ = 0;
   YGNodeMarkDirty(node());
   SchedulePaint();
 }
@@ -101,8 +167,27 @@ const char* Label::GetClassName() const {
   return kClassName;
 }
 
+void Label::OnLiveResizeEnd() {
+  if (!measure_approximated_)
+    return;
+  measure_approximated_ = false;
+  MarkDirty();
+}
+
+bool Label::ResetForReuse() {
+  if (!ResetViewStates())
+    return false;
+  // Drop the old text so its format is not inherited.
+  text_ = nullptr;
+  SetText("");
+  return true;
+}
+
 void Label::SetFont(scoped_refptr<Font> font) {
+  bool plain = IsPlainText();
   text_->SetFont(font);
+  KeepPlainText(plain);
+  plain_text_font_ = font;
   View::SetFont(std::move(font));
   MarkDirty();  // layout has changed
 }
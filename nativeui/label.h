@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_LABEL_H_
 #define NATIVEUI_LABEL_H_
 
+#include <array>
 #include <string>
 
 #include "nativeui/gfx/text.h"
@@ -33,10 +34,16 @@ class NATIVEUI_EXPORT Label : public View {
   // Internal: Make sure the label is using system text color.
   void UpdateColor();
 
+  // Internal: Return the size of text when laid out in |size|, the results are
+  // cached until the text changes.
+  SizeF GetTextSizeFor(const SizeF& size);
+
   // View:
   const char* GetClassName() const override;
   void SetFont(scoped_refptr<Font> font) override;
   void SetColor(Color color) override;
+  void OnLiveResizeEnd() override;
+  bool ResetForReuse() override;
 
  protected:
   ~Label() override;
@@ -47,10 +54,37 @@ class NATIVEUI_EXPORT Label : public View {
   // Mark the yoga node as dirty.
   void MarkDirty();
 
+  // Whether the text has only been changed through Label since SetText.
+  bool IsPlainText() const;
+  // Keep the text shared after Label changed it, if it was |plain| before.
+  void KeepPlainText(bool plain);
+
   NativeView PlatformCreate();
 
   scoped_refptr<AttributedText> text_;
 
+  // Recently measured results, yoga may measure the same node several times
+  // with different constraints in one layout pass.
+  struct MeasureResult {
+    SizeF constraint;
+    SizeF size;
+  };
+  std::array<MeasureResult, 4> measure_cache_;
+  size_t measure_cache_size_ = 0;
+  size_t next_measure_cache_ = 0;
+  int measure_cache_generation_ = -1;
+
+  // Whether a measured size was reused for other constraints during the live
+  // resize of window.
+  bool measure_approximated_ = false;
+
+  // Whether the text is set from a plain string, whose measurement can be
+  // shared with other labels. Changes made directly to the AttributedText
+  // are detected by its generation.
+  bool plain_text_ = false;
+  int plain_text_generation_ = -1;
+  scoped_refptr<Font> plain_text_font_;
+
   bool use_system_color_ = false;
   Color system_color_;
 };
@@ -32,3 +32,16 @@ TEST_F(LabelTest, UpdateStyle) {
   EXPECT_EQ(height.value, YGNodeStyleGetMinHeight(label_->node()).value);
 }
 #endif
+
+TEST_F(LabelTest, MeasureCacheInvalidation) {
+  nu::SizeF bounds(1000, 1000);
+  label_->SetText("test");
+  nu::SizeF size = label_->GetTextSizeFor(bounds);
+  EXPECT_EQ(label_->GetTextSizeFor(bounds), size);
+  label_->SetText("longlongtest");
+  EXPECT_LT(size.width(), label_->GetTextSizeFor(bounds).width());
+  size = label_->GetTextSizeFor(bounds);
+  label_->GetAttributedText()->SetFont(nu::Font::Default()->Derive(
+      10, nu::Font::Weight::Normal, nu::Font::Style::Normal));
+  EXPECT_LT(size.height(), label_->GetTextSizeFor(bounds).height());
+}
@@ -0,0 +1,143 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "base/strings/string_number_conversions.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kIterations = 100;
+
+// A chain of nested containers with a label at the end.
+scoped_refptr<nu::Container> CreateDeepChain(int depth, nu::View** leaf) {
+  scoped_refptr<nu::Container> root = new nu::Container;
+  nu::Container* parent = root.get();
+  for (int i = 0; i < depth; ++i) {
+    nu::Container* child = new nu::Container;
+    child->SetStyle("padding", 1.f);
+    parent->AddChildView(child);
+    parent = child;
+  }
+  *leaf = new nu::Label("leaf");
+  parent->AddChildView(*leaf);
+  return root;
+}
+
+// A row of flexible children.
+scoped_refptr<nu::Container> CreateWideRow(int width) {
+  scoped_refptr<nu::Container> root = new nu::Container;
+  root->SetStyle("flexDirection", "row");
+  for (int i = 0; i < width; ++i) {
+    nu::Container* child = new nu::Container;
+    child->SetStyle("flex", 1.f, "minWidth", 1.f);
+    root->AddChildView(child);
+  }
+  return root;
+}
+
+// Rows of labels.
+scoped_refptr<nu::Container> CreateLabelGrid(int rows, int columns) {
+  scoped_refptr<nu::Container> root = new nu::Container;
+  for (int i = 0; i < rows; ++i) {
+    nu::Container* row = new nu::Container;
+    row->SetStyle("flexDirection", "row");
+    for (int j = 0; j < columns; ++j) {
+      nu::Label* label = new nu::Label(base::NumberToString(i * columns + j));
+      label->SetStyle("flex", 1.f);
+      row->AddChildView(label);
+    }
+    root->AddChildView(row);
+  }
+  return root;
+}
+
+}  // namespace
+
+class LayoutPerfTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(LayoutPerfTest, DeepChainLayout) {
+  nu::View* leaf;
+  scoped_refptr<nu::Container> root = CreateDeepChain(200, &leaf);
+  nu::RunPerfTest("DeepChainLayout", kIterations, [&](int i) {
+    root->SetBounds(nu::RectF(0, 0, 400 + i % 2, 400));
+    root->Layout();
+  });
+}
+
+TEST_F(LayoutPerfTest, DeepChainSetStyle) {
+  nu::View* leaf;
+  scoped_refptr<nu::Container> root = CreateDeepChain(200, &leaf);
+  root->SetBounds(nu::RectF(0, 0, 400, 400));
+  nu::RunPerfTest("DeepChainSetStyle", kIterations, [&](int i) {
+    leaf->SetStyle("height", static_cast<float>(10 + i % 2));
+  });
+}
+
+TEST_F(LayoutPerfTest, WideRowLayout) {
+  scoped_refptr<nu::Container> root = CreateWideRow(1000);
+  nu::RunPerfTest("WideRowLayout", kIterations, [&](int i) {
+    root->SetBounds(nu::RectF(0, 0, 2000 + i % 2, 400));
+    root->Layout();
+  });
+}
+
+TEST_F(LayoutPerfTest, WideRowSetStyle) {
+  scoped_refptr<nu::Container> root = CreateWideRow(1000);
+  root->SetBounds(nu::RectF(0, 0, 2000, 400));
+  nu::View* child = root->ChildAt(500);
+  nu::RunPerfTest("WideRowSetStyle", kIterations, [&](int i) {
+    child->SetStyle("flex", static_cast<float>(1 + i % 2));
+  });
+}
+
+TEST_F(LayoutPerfTest, WideRowAddRemoveChildView) {
+  scoped_refptr<nu::Container> root = CreateWideRow(1000);
+  root->SetBounds(nu::RectF(0, 0, 2000, 400));
+  scoped_refptr<nu::Container> child = new nu::Container;
+  child->SetStyle("flex", 1.f);
+  nu::RunPerfTest("WideRowAddRemoveChildView", kIterations, [&](int i) {
+    root->AddChildViewAt(child, 500);
+    root->RemoveChildView(child.get());
+  });
+}
+
+TEST_F(LayoutPerfTest, WideRowSetChildBoundsFromCSS) {
+  scoped_refptr<nu::Container> root = CreateWideRow(1000);
+  root->SetBounds(nu::RectF(0, 0, 2000, 400));
+  nu::RunPerfTest("WideRowSetChildBoundsFromCSS", kIterations, [&](int i) {
+    root->SetChildBoundsFromCSS();
+  });
+}
+
+TEST_F(LayoutPerfTest, LabelGridLayout) {
+  scoped_refptr<nu::Container> root = CreateLabelGrid(30, 30);
+  nu::RunPerfTest("LabelGridLayout", kIterations, [&](int i) {
+    root->SetBounds(nu::RectF(0, 0, 800 + i % 2, 600));
+    root->Layout();
+  });
+}
+
+TEST_F(LayoutPerfTest, LabelGridSetText) {
+  scoped_refptr<nu::Container> root = CreateLabelGrid(30, 30);
+  root->SetBounds(nu::RectF(0, 0, 800, 600));
+  auto* label = static_cast<nu::Label*>(
+      static_cast<nu::Container*>(root->ChildAt(15))->ChildAt(15));
+  nu::RunPerfTest("LabelGridSetText", kIterations, [&](int i) {
+    label->SetText(i % 2 ? "short" : "a much longer text");
+  });
+}
+
+TEST_F(LayoutPerfTest, LabelGridSetChildBoundsFromCSS) {
+  scoped_refptr<nu::Container> root = CreateLabelGrid(30, 30);
+  root->SetBounds(nu::RectF(0, 0, 800, 600));
+  nu::RunPerfTest("LabelGridSetChildBoundsFromCSS", kIterations, [&](int i) {
+    root->SetChildBoundsFromCSS();
+  });
+}
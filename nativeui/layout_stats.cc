@@ -0,0 +1,51 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/layout_stats.h"
+
+#include <algorithm>
+
+#include "nativeui/state.h"
+
+namespace nu {
+
+LayoutStats::LayoutStats() {}
+
+LayoutStats::LayoutStats(const LayoutStats& other) = default;
+
+LayoutStats::~LayoutStats() {}
+
+ScopedLayoutTimer::ScopedLayoutTimer()
+    : enabled_(State::GetCurrent()->IsLayoutStatsEnabled()) {
+  if (enabled_)
+    start_ = base::TimeTicks::Now();
+}
+
+ScopedLayoutTimer::~ScopedLayoutTimer() {
+  if (!enabled_)
+    return;
+  base::TimeDelta duration = base::TimeTicks::Now() - start_;
+  LayoutStats* stats = State::GetCurrent()->layout_stats();
+  stats->layout_count++;
+  stats->total_duration += duration;
+  stats->max_duration = std::max(stats->max_duration, duration);
+}
+
+ScopedMeasureTimer::ScopedMeasureTimer(const char* class_name)
+    : class_name_(State::GetCurrent()->IsLayoutStatsEnabled() ? class_name
+                                                               : nullptr) {
+  if (class_name_)
+    start_ = base::TimeTicks::Now();
+}
+
+ScopedMeasureTimer::~ScopedMeasureTimer() {
+  if (!class_name_)
+    return;
+  LayoutStats::MeasureStats& stats =
+      State::GetCurrent()->layout_stats()->measures[class_name_];
+  stats.count++;
+  stats.duration += base::TimeTicks::Now() - start_;
+}
+
+}  // namespace nu
@@ -0,0 +1,65 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_LAYOUT_STATS_H_
+#define NATIVEUI_LAYOUT_STATS_H_
+
+#include <map>
+#include <string>
+
+#include "base/time/time.h"
+#include "nativeui/nativeui_export.h"
+#include "nativeui/startup_stats.h"
+
+namespace nu {
+
+// Statistics about the cost of layout.
+struct NATIVEUI_EXPORT LayoutStats {
+  LayoutStats();
+  LayoutStats(const LayoutStats& other);
+  ~LayoutStats();
+
+  struct MeasureStats {
+    int count = 0;
+    base::TimeDelta duration;
+  };
+
+  // Number of YGNodeCalculateLayout calls and the time spent in them.
+  int layout_count = 0;
+  base::TimeDelta total_duration;
+  base::TimeDelta max_duration;
+
+  // Number of nodes visited when setting bounds from layout results.
+  int nodes_visited = 0;
+
+  // Measurements grouped by view class names.
+  std::map<std::string, MeasureStats> measures;
+};
+
+// Internal: Record the time spent in the scope as one layout pass.
+class NATIVEUI_EXPORT ScopedLayoutTimer {
+ public:
+  ScopedLayoutTimer();
+  ~ScopedLayoutTimer();
+
+ private:
+  ScopedStartupPhase startup_phase_{StartupPhase::FirstLayout};
+  base::TimeTicks start_;
+  bool enabled_;
+};
+
+// Internal: Record the time spent in the scope as one measurement.
+class NATIVEUI_EXPORT ScopedMeasureTimer {
+ public:
+  explicit ScopedMeasureTimer(const char* class_name);
+  ~ScopedMeasureTimer();
+
+ private:
+  base::TimeTicks start_;
+  const char* class_name_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_LAYOUT_STATS_H_
@@ -0,0 +1,119 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/layout_transaction.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/auto_reset.h"
+#include "base/logging.h"
+#include "nativeui/container.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/state.h"
+#include "third_party/yoga/Yoga.h"
+
+namespace nu {
+
+LayoutTransaction::LayoutTransaction() {
+  Begin();
+}
+
+LayoutTransaction::~LayoutTransaction() {
+  Commit();
+}
+
+// static
+void LayoutTransaction::Begin() {
+  ++State::GetCurrent()->layout_transaction_depth();
+}
+
+// static
+void LayoutTransaction::Commit() {
+  int& depth = State::GetCurrent()->layout_transaction_depth();
+  if (depth <= 0) {
+    LOG(ERROR) << "There is no layout transaction to commit.";
+    return;
+  }
+  if (--depth == 0)
+    FlushPendingLayouts();
+}
+
+// static
+bool LayoutTransaction::IsActive() {
+  return State::GetCurrent()->layout_transaction_depth() > 0;
+}
+
+// static
+void LayoutTransaction::SetDeferredLayout(bool defer) {
+  State* state = State::GetCurrent();
+  state->defer_layout() = defer;
+  // Do not leave pending layouts behind when turning off.
+  if (!defer && state->layout_transaction_depth() == 0)
+    FlushPendingLayouts();
+}
+
+// static
+bool LayoutTransaction::IsDeferredLayout() {
+  return State::GetCurrent()->defer_layout();
+}
+
+// static
+void LayoutTransaction::Flush() {
+  if (IsActive()) {
+    LOG(ERROR) << "Can not flush layouts inside a transaction.";
+    return;
+  }
+  FlushPendingLayouts();
+}
+
+// static
+bool LayoutTransaction::DeferLayout(Container* container) {
+  State* state = State::GetCurrent();
+  if (state->layout_transaction_depth() == 0) {
+    if (!state->defer_layout())
+      return false;
+    if (!state->layout_flush_scheduled()) {
+      state->layout_flush_scheduled() = true;
+      MessageLoop::PostTask([]() {
+        State* state = State::GetCurrent();
+        if (!state)  // state has been destroyed
+          return;
+        state->layout_flush_scheduled() = false;
+        // A transaction is still going on, leave the job to it.
+        if (state->layout_transaction_depth() == 0)
+          FlushPendingLayouts();
+      });
+    }
+  }
+  if (!container->layout_deferred_) {
+    container->layout_deferred_ = true;
+    state->pending_layouts().push_back(container);
+  }
+  return true;
+}
+
+// static
+void LayoutTransaction::FlushPendingLayouts() {
+  State* state = State::GetCurrent();
+  // The layouts must happen immediately when flushing.
+  base::AutoReset<bool> auto_reset(&state->defer_layout(), false);
+  std::vector<scoped_refptr<Container>> pending;
+  pending.swap(state->pending_layouts());
+  for (const auto& container : pending)
+    container->layout_deferred_ = false;
+  // Layout the root containers first, which would also update the bounds of
+  // children whose sizes have changed.
+  for (const auto& container : pending) {
+    if (!YGNodeGetParent(container->node()))
+      container->Layout();
+  }
+  // Then update the child containers that were not touched by their parents.
+  for (const auto& container : pending) {
+    if (container->dirty_)
+      container->UpdateChildBounds(false);
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,60 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_LAYOUT_TRANSACTION_H_
+#define NATIVEUI_LAYOUT_TRANSACTION_H_
+
+#include "base/macros.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class Container;
+
+// Batch layout requests, so changing styles of many views only results in one
+// layout pass for each root container.
+//
+// The transaction can either be used as a scoped object, or be controlled
+// manually with Begin and Commit, and transactions can be nested.
+//
+// When deferred layout is enabled, layout requests made outside transactions
+// are also batched, and done together in the next tick of message loop.
+class NATIVEUI_EXPORT LayoutTransaction {
+ public:
+  LayoutTransaction();
+  ~LayoutTransaction();
+
+  // Start a transaction, the layouts requested before Commit is called are
+  // deferred.
+  static void Begin();
+
+  // End a transaction, the deferred layouts are done when the outermost
+  // transaction is committed.
+  static void Commit();
+
+  // Whether there is a transaction going on.
+  static bool IsActive();
+
+  // Defer all layouts to the next tick of message loop.
+  static void SetDeferredLayout(bool defer);
+  static bool IsDeferredLayout();
+
+  // Do the deferred layouts immediately.
+  static void Flush();
+
+  // Internal: Defer the layout of |container| if there is an active
+  // transaction or deferred layout is enabled, returns false if the layout
+  // should be done immediately.
+  static bool DeferLayout(Container* container);
+
+ private:
+  // Do the layouts of all deferred containers.
+  static void FlushPendingLayouts();
+
+  DISALLOW_COPY_AND_ASSIGN(LayoutTransaction);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_LAYOUT_TRANSACTION_H_
@@ -4,7 +4,11 @@
 
 #include "nativeui/lifetime.h"
 
+#include <stdio.h>
+
 #include "base/logging.h"
+#include "base/process/process.h"
+#include "nativeui/startup_stats.h"
 #include "nativeui/state.h"
 
 namespace nu {
@@ -25,6 +29,7 @@ Lifetime::Lifetime() : weak_factory_(this) {
   CHECK(!g_lifetime) << "Lifetime can not be created twice";
   g_lifetime = this;
   logging::SetMinLogLevel(logging::LOG_ERROR);
+  ScopedStartupPhase startup_phase(StartupPhase::Lifetime);
   PlatformInit();
 }
 
@@ -33,4 +38,11 @@ Lifetime::~Lifetime() {
   PlatformDestroy();
 }
 
+void Lifetime::FastExit(int code) {
+  on_fast_exit.Emit();
+  PlatformFlushBeforeExit();
+  fflush(nullptr);
+  base::Process::TerminateCurrentProcessImmediately(code);
+}
+
 }  // namespace nu
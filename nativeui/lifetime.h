@@ -29,17 +29,25 @@ class NATIVEUI_EXPORT Lifetime {
 
   static Lifetime* GetCurrent();
 
+  // Emit on_fast_exit and terminate the process with |code| immediately,
+  // without destroying windows, views and other objects one by one.
+  [[noreturn]] void FastExit(int code);
+
   // Events.
 #if defined(OS_MACOSX)
   Signal<void()> on_ready;
   Signal<void()> on_activate;
 #endif
+  Signal<void()> on_fast_exit;
 
   base::WeakPtr<Lifetime> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
 
  private:
   void PlatformInit();
   void PlatformDestroy();
+  // Save the states that would otherwise be lost when the process is
+  // terminated without cleanup.
+  void PlatformFlushBeforeExit();
 
 #if defined(OS_MACOSX)
   base::mac::ScopedNSAutoreleasePool autorelease_pool_;
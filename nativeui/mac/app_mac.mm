@@ -10,6 +10,26 @@
 
 namespace nu {
 
+void App::PlatformInit() {
+  memory_pressure_source_ = dispatch_source_create(
+      DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+      DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+      dispatch_get_main_queue());
+  dispatch_source_t source = memory_pressure_source_;
+  dispatch_source_set_event_handler(source, ^{
+    NotifyMemoryPressure(dispatch_source_get_data(source) &
+                         DISPATCH_MEMORYPRESSURE_CRITICAL);
+  });
+  dispatch_resume(source);
+}
+
+void App::PlatformDestroy() {
+  // The handler runs in main thread, so it will not be called after this.
+  dispatch_source_cancel(memory_pressure_source_);
+  dispatch_release(memory_pressure_source_);
+  memory_pressure_source_ = nullptr;
+}
+
 void App::SetApplicationMenu(scoped_refptr<MenuBar> menu) {
   application_menu_ = std::move(menu);
   [NSApp setMainMenu:application_menu_->GetNative()];
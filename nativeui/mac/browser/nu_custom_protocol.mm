@@ -4,9 +4,11 @@
 
 #include "nativeui/mac/browser/nu_custom_protocol.h"
 
+#include <algorithm>
 #include <map>
 
 #include "base/mac/scoped_nsobject.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/sys_string_conversions.h"
 #include "base/synchronization/lock.h"
 
@@ -104,23 +106,86 @@ base::Lock g_lock;
   protocol_job_->Plug([&](int size) {
     std::string mime_type;
     protocol_job_->GetMimeType(&mime_type);
+    // Serve range requests, which are used by media elements for seeking, the
+    // content in memory is sliced directly.
+    base::StringPiece content;
+    bool in_memory = protocol_job_->GetContent(&content);
+    NSString* range = [self.request valueForHTTPHeaderField:@"Range"];
+    int64_t first = 0, last = 0;
+    bool ranged =
+        range &&
+        nu::ProtocolJob::ParseRange([range UTF8String], size, &first, &last) &&
+        (in_memory || protocol_job_->Seek(first));
+    // Build headers.
+    NSMutableDictionary* headers = [NSMutableDictionary dictionary];
+    if (!mime_type.empty())
+      headers[@"Content-Type"] = base::SysUTF8ToNSString(mime_type);
+    if (ranged) {
+      headers[@"Content-Length"] = [@(last - first + 1) stringValue];
+      headers[@"Content-Range"] = base::SysUTF8ToNSString(
+          base::StringPrintf("bytes %lld-%lld/%d", first, last, size));
+    } else if (size >= 0) {
+      headers[@"Content-Length"] = [@(size) stringValue];
+    }
+    if (size > 0)
+      headers[@"Accept-Ranges"] = @"bytes";
+    std::string etag;
+    bool not_modified = false;
+    if (protocol_job_->GetETag(&etag)) {
+      headers[@"ETag"] = base::SysUTF8ToNSString(etag);
+      NSString* if_none_match =
+          [self.request valueForHTTPHeaderField:@"If-None-Match"];
+      not_modified = if_none_match && etag == [if_none_match UTF8String];
+    }
+    const std::string& cache_control = protocol_job_->GetCacheControl();
+    if (!cache_control.empty())
+      headers[@"Cache-Control"] = base::SysUTF8ToNSString(cache_control);
     // Send response.
-    base::scoped_nsobject<NSURLResponse> response(
-        [[NSURLResponse alloc] initWithURL:self.request.URL
-                                  MIMEType:base::SysUTF8ToNSString(mime_type)
-                     expectedContentLength:size
-                          textEncodingName:nil]);
+    int status = not_modified ? 304 : (ranged ? 206 : 200);
+    base::scoped_nsobject<NSHTTPURLResponse> response(
+        [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                    statusCode:status
+                                   HTTPVersion:@"HTTP/1.1"
+                                  headerFields:headers]);
     [[self client] URLProtocol:self
             didReceiveResponse:response
-            cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+            cacheStoragePolicy:cache_control.empty()
+                                   ? NSURLCacheStorageNotAllowed
+                                   : NSURLCacheStorageAllowed];
+    // The cached content is used.
+    if (not_modified) {
+      [[self client] URLProtocolDidFinishLoading:self];
+      return;
+    }
+    // Send the content in memory without copying, the data keeps a reference
+    // to the job which owns the memory.
+    if (in_memory) {
+      if (ranged)
+        content = content.substr(first, last - first + 1);
+      scoped_refptr<nu::ProtocolJob> job = protocol_job_;
+      base::scoped_nsobject<NSData> data([[NSData alloc]
+          initWithBytesNoCopy:const_cast<char*>(content.data())
+                       length:content.size()
+                  deallocator:^(void*, NSUInteger) {
+                    // Release the job after the data is freed.
+                    (void)job;
+                  }]);
+      [[self client] URLProtocol:self didLoadData:data];
+      [[self client] URLProtocolDidFinishLoading:self];
+      return;
+    }
     // Read data.
-    char bytes[4089];
+    char bytes[4096];
     size_t nread = 0;
-    while ((nread = protocol_job_->Read(bytes, sizeof(bytes))) > 0) {
+    uint64_t left = ranged ? last - first + 1 : UINT64_MAX;
+    while (left > 0 &&
+           (nread = protocol_job_->Read(
+                bytes, std::min<uint64_t>(sizeof(bytes), left))) > 0) {
       NSData* data = [NSData dataWithBytesNoCopy:bytes
                                           length:nread
                                     freeWhenDone:NO];
       [[self client] URLProtocol:self didLoadData:data];
+      left -= nread;
     }
     // Done.
     [[self client] URLProtocolDidFinishLoading:self];
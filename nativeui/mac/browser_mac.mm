@@ -214,6 +214,29 @@
 
 namespace nu {
 
+namespace {
+
+// Serialize the result of evaluateJavaScript, whose types are the ones
+// accepted by NSJSONSerialization, except for undefined which is nil.
+std::string ResultToJSON(id result) {
+  if (!result)
+    return "null";
+  // Top-level fragments are only accepted by newer systems, so serialize an
+  // array and strip the brackets.
+  NSArray* wrapper = @[ result ];
+  if (![NSJSONSerialization isValidJSONObject:wrapper])
+    return "null";
+  NSData* data = [NSJSONSerialization dataWithJSONObject:wrapper
+                                                 options:0
+                                                   error:nil];
+  if (!data || [data length] < 2)
+    return "null";
+  return std::string(static_cast<const char*>([data bytes]) + 1,
+                     [data length] - 2);
+}
+
+}  // namespace
+
 void Browser::PlatformInit(Options options) {
   NUWebView* webview = [[NUWebView alloc] initWithShell:this
                                                 options:std::move(options)];
@@ -281,6 +304,20 @@ void Browser::ExecuteJavaScript(const std::string& code,
   }];
 }
 
+void Browser::PlatformExecuteJavaScriptRaw(
+    const std::string& code,
+    const RawExecutionCallback& callback) {
+  __block RawExecutionCallback copied_callback = callback;
+  [static_cast<NUWebView*>(GetNative())
+      evaluateJavaScript:base::SysUTF8ToNSString(code)
+       completionHandler:^(id result, NSError* error) {
+    if (error)
+      copied_callback(false, std::string());
+    else
+      copied_callback(true, ResultToJSON(result));
+  }];
+}
+
 void Browser::GoBack() {
   [static_cast<NUWebView*>(GetNative()) goBack:nil];
 }
@@ -315,14 +352,14 @@ void Browser::PlatformUpdateBindings() {
 }
 
 // static
-bool Browser::RegisterProtocol(const std::string& scheme,
-                               const ProtocolHandler& handler) {
+bool Browser::PlatformRegisterProtocol(const std::string& scheme,
+                                       const ProtocolHandler& handler) {
   return [NUCustomProtocol registerProtocol:base::SysUTF8ToNSString(scheme)
                                 withHandler:handler];
 }
 
 // static
-void Browser::UnregisterProtocol(const std::string& scheme) {
+void Browser::PlatformUnregisterProtocol(const std::string& scheme) {
   [NUCustomProtocol unregisterProtocol:base::SysUTF8ToNSString(scheme)];
 }
 
@@ -5,6 +5,9 @@
 #include "nativeui/clipboard.h"
 
 #import <Cocoa/Cocoa.h>
+#include <string.h>
+
+#include <algorithm>
 
 #include "base/notreached.h"
 #include "base/mac/foundation_util.h"
@@ -16,7 +19,10 @@ namespace nu {
 
 namespace {
 
-const int kPollingTimeout = 500;
+// The polling interval starts from the minimum, and doubles every time the
+// clipboard is found unchanged, so idle apps rarely wake up.
+const int kMinPollingTimeout = 250;
+const int kMaxPollingTimeout = 4000;
 
 const char kMarkupPrefix[] = "<meta charset='utf-8'>";
 
@@ -39,8 +45,91 @@ NSString* GetHTMLFromRTFOnPasteboard(NSPasteboard* pboard) {
                                 encoding:NSUTF8StringEncoding] autorelease];
 }
 
+// Return the data of |type| without decoding it, or nil if not available.
+NSData* GetRawDataFromPasteboard(NSPasteboard* pboard,
+                                 Clipboard::Data::Type type) {
+  switch (type) {
+    case Clipboard::Data::Type::Text:
+      return [pboard dataForType:NSPasteboardTypeString];
+    case Clipboard::Data::Type::HTML:
+      if ([pboard availableTypeFromArray:@[NSHTMLPboardType]])
+        return [pboard dataForType:NSHTMLPboardType];
+      return [GetHTMLFromRTFOnPasteboard(pboard)
+          dataUsingEncoding:NSUTF8StringEncoding];
+    case Clipboard::Data::Type::Image: {
+      NSString* bestType = [pboard availableTypeFromArray:@[
+          NSPasteboardTypePNG, NSPasteboardTypeTIFF]];
+      return bestType ? [pboard dataForType:bestType] : nil;
+    }
+    default:
+      return nil;
+  }
+}
+
 }  // namespace
 
+}  // namespace nu
+
+// Provides data for the types declared by SetDataProvider.
+@interface NUClipboardDataOwner : NSObject {
+ @private
+  nu::Clipboard::DataProvider provider_;
+}
+- (id)initWithProvider:(const nu::Clipboard::DataProvider&)provider;
+- (void)invalidate;
+@end
+
+@implementation NUClipboardDataOwner
+
+- (id)initWithProvider:(const nu::Clipboard::DataProvider&)provider {
+  if ((self = [super init]))
+    provider_ = provider;
+  return self;
+}
+
+- (void)invalidate {
+  provider_ = nullptr;
+}
+
+- (void)pasteboard:(NSPasteboard*)sender provideDataForType:(NSString*)type {
+  if (!provider_)
+    return;
+  using Data = nu::Clipboard::Data;
+  if ([type isEqualToString:NSPasteboardTypeString]) {
+    Data data = provider_(Data::Type::Text);
+    if (data.type() == Data::Type::Text)
+      [sender setString:base::SysUTF8ToNSString(data.str()) forType:type];
+  } else if ([type isEqualToString:NSHTMLPboardType]) {
+    Data data = provider_(Data::Type::HTML);
+    if (data.type() == Data::Type::HTML) {
+      // We need to mark it as utf-8. (see crbug.com/11957)
+      std::string html = nu::kMarkupPrefix + data.str();
+      [sender setString:base::SysUTF8ToNSString(html) forType:type];
+    }
+  } else if ([type isEqualToString:NSPasteboardTypeTIFF]) {
+    Data data = provider_(Data::Type::Image);
+    if (data.type() == Data::Type::Image)
+      [sender setData:[data.image()->GetNative() TIFFRepresentation]
+              forType:type];
+  } else if ([type isEqualToString:NSFilenamesPboardType]) {
+    Data data = provider_(Data::Type::FilePaths);
+    if (data.type() == Data::Type::FilePaths) {
+      NSMutableArray* filePaths = [NSMutableArray array];
+      for (const auto& path : data.file_paths())
+        [filePaths addObject:base::SysUTF8ToNSString(path.value())];
+      [sender setPropertyList:filePaths forType:type];
+    }
+  }
+}
+
+- (void)pasteboardChangedOwner:(NSPasteboard*)sender {
+  provider_ = nullptr;
+}
+
+@end
+
+namespace nu {
+
 Clipboard::Clipboard(NativeClipboard clipboard)
     : type_(Type::Drag), clipboard_(clipboard), weak_factory_(this) {}
 
@@ -61,9 +150,11 @@ NativeClipboard Clipboard::PlatformCreate(Type type) {
 }
 
 void Clipboard::PlatformDestroy() {
+  [data_owner_ invalidate];
+  [data_owner_ release];
 }
 
-bool Clipboard::IsDataAvailable(Data::Type type) const {
+bool Clipboard::PlatformIsDataAvailable(Data::Type type) const {
   NSArray* types = clipboard_.types;
   switch (type) {
     case Data::Type::Text:
@@ -81,6 +172,10 @@ bool Clipboard::IsDataAvailable(Data::Type type) const {
   }
 }
 
+int64_t Clipboard::PlatformGetChangeCount() const {
+  return [clipboard_ changeCount];
+}
+
 Clipboard::Data Clipboard::GetData(Data::Type type) const {
   switch (type) {
     case Data::Type::Text: {
@@ -132,7 +227,30 @@ Clipboard::Data Clipboard::GetData(Data::Type type) const {
   }
 }
 
+int64_t Clipboard::GetDataSize(Data::Type type) const {
+  NSData* data = GetRawDataFromPasteboard(clipboard_, type);
+  return data ? static_cast<int64_t>([data length]) : -1;
+}
+
+bool Clipboard::ReadData(Data::Type type, const DataReader& reader) const {
+  NSData* data = GetRawDataFromPasteboard(clipboard_, type);
+  if (!data)
+    return false;
+  const char* bytes = static_cast<const char*>([data bytes]);
+  size_t size = [data length];
+  // Remove the meta prefix in HTML like GetData.
+  const size_t prefix_size = base::size(kMarkupPrefix) - 1;
+  if (type == Data::Type::HTML && size >= prefix_size &&
+      memcmp(bytes, kMarkupPrefix, prefix_size) == 0) {
+    bytes += prefix_size;
+    size -= prefix_size;
+  }
+  return ReadChunks(bytes, size, reader);
+}
+
 void Clipboard::SetData(std::vector<Data> objects) {
+  // Notice the change soon when watching.
+  RestartPolling();
   [clipboard_ declareTypes:@[] owner:nil];
 
   for (const auto& data : objects) {
@@ -167,10 +285,42 @@ void Clipboard::SetData(std::vector<Data> objects) {
   }
 }
 
+void Clipboard::SetDataProvider(const std::vector<Data::Type>& types,
+                                const DataProvider& provider) {
+  RestartPolling();
+  NSMutableArray* pboardTypes = [NSMutableArray array];
+  for (Data::Type type : types) {
+    switch (type) {
+      case Data::Type::Text:
+        [pboardTypes addObject:NSPasteboardTypeString];
+        break;
+      case Data::Type::HTML:
+        [pboardTypes addObject:NSHTMLPboardType];
+        break;
+      case Data::Type::Image:
+        [pboardTypes addObject:NSPasteboardTypeTIFF];
+        break;
+      case Data::Type::FilePaths:
+        [pboardTypes addObject:NSFilenamesPboardType];
+        break;
+      default:
+        NOTREACHED() << "Can not set clipboard data without type";
+    }
+  }
+  // The pasteboard does not retain its owner, and the previous owner must
+  // be kept alive until the pasteboard has changed its owner.
+  NUClipboardDataOwner* previous_owner = data_owner_;
+  data_owner_ = [[NUClipboardDataOwner alloc] initWithProvider:provider];
+  [clipboard_ declareTypes:pboardTypes owner:data_owner_];
+  [previous_owner invalidate];
+  [previous_owner release];
+}
+
 void Clipboard::PlatformStartWatching() {
   DCHECK_EQ(timer_, 0u);
   change_count_ = [clipboard_ changeCount];
-  timer_ = MessageLoop::SetTimeout(kPollingTimeout,
+  polling_timeout_ = kMinPollingTimeout;
+  timer_ = MessageLoop::SetTimeout(polling_timeout_,
                                    std::bind(&Clipboard::OnTimer, this));
 }
 
@@ -181,12 +331,27 @@ void Clipboard::PlatformStopWatching() {
 }
 
 void Clipboard::OnTimer() {
-  timer_ = MessageLoop::SetTimeout(kPollingTimeout,
+  bool changed = change_count_ != [clipboard_ changeCount];
+  // Poll quickly after changes, since they usually come in bursts.
+  if (changed)
+    polling_timeout_ = kMinPollingTimeout;
+  else
+    polling_timeout_ = std::min(polling_timeout_ * 2, kMaxPollingTimeout);
+  timer_ = MessageLoop::SetTimeout(polling_timeout_,
                                    std::bind(&Clipboard::OnTimer, this));
-  if (change_count_ != [clipboard_ changeCount]) {
+  if (changed) {
     change_count_ = [clipboard_ changeCount];
     on_change.Emit(this);
   }
 }
 
+void Clipboard::RestartPolling() {
+  if (!timer_ || polling_timeout_ == kMinPollingTimeout)
+    return;
+  MessageLoop::ClearTimeout(timer_);
+  polling_timeout_ = kMinPollingTimeout;
+  timer_ = MessageLoop::SetTimeout(polling_timeout_,
+                                   std::bind(&Clipboard::OnTimer, this));
+}
+
 }  // namespace nu
@@ -57,7 +57,7 @@
 }
 
 - (void)controlTextDidChange:(NSNotification*)notification {
-  shell_->on_text_change.Emit(shell_);
+  shell_->NotifyTextChange();
 }
 
 - (void)comboBoxWillDismiss:(NSNotification*)notification {
@@ -73,7 +73,7 @@
 - (void)onDissmiss {
   if (currentText_ != shell_->GetText()) {
     // The controlTextDidChange does not emit when user selects an item.
-    shell_->on_text_change.Emit(shell_);
+    shell_->NotifyTextChange();
     // The comboBoxSelectionDidChange does not work as expect, and is actually
     // quite useless. We just emulate the event by comparing text.
     shell_->on_selection_change.Emit(shell_);
@@ -111,6 +111,15 @@ void ComboBox::AddItem(const std::string& text) {
   [combobox addItemWithObjectValue:base::SysUTF8ToNSString(text)];
 }
 
+void ComboBox::SetItems(const std::vector<std::string>& items) {
+  auto* combobox = static_cast<NUComboBox*>(GetNative());
+  NSMutableArray* values = [NSMutableArray arrayWithCapacity:items.size()];
+  for (const std::string& item : items)
+    [values addObject:base::SysUTF8ToNSString(item)];
+  [combobox removeAllItems];
+  [combobox addItemsWithObjectValues:values];
+}
+
 void ComboBox::RemoveItemAt(int index) {
   auto* combobox = static_cast<NUComboBox*>(GetNative());
   [combobox removeItemAtIndex:index];
@@ -4,7 +4,10 @@
 
 #include "nativeui/mac/container_mac.h"
 
+#include "nativeui/gfx/geometry/rect_conversions.h"
 #include "nativeui/gfx/mac/painter_mac.h"
+#include "nativeui/paint_stats.h"
+#include "nativeui/trace_event.h"
 
 @implementation NUContainer
 
@@ -34,22 +37,71 @@
   return YES;
 }
 
+// Containers without custom drawing only have a background color, which can
+// be set on the layer directly instead of rasterizing it in drawRect:.
+- (BOOL)wantsUpdateLayer {
+  nu::Container* shell = static_cast<nu::Container*>([self shell]);
+  return shell && !shell->HasCustomDraw();
+}
+
+- (void)updateLayer {
+  self.layer.backgroundColor = background_color_.ToNSColor().CGColor;
+}
+
 - (void)drawRect:(NSRect)dirtyRect {
   nu::Container* shell = static_cast<nu::Container*>([self shell]);
   if (!shell)
     return;
 
+  NU_TRACE_EVENT("paint", "NUContainer::drawRect");
+  // AppKit draws views separately, so each drawRect: is recorded as one paint.
+  nu::ScopedPaintTimer paint_timer(
+      shell->GetWindow(),
+      nu::ToEnclosingRect(nu::RectF([self convertRectToBacking:dirtyRect])));
+  nu::ScopedPaintTimer::CountView(shell);
+
   nu::RectF dirty(dirtyRect);
   nu::PainterMac painter(self);
   painter.SetColor(background_color_);
   painter.FillRect(dirty);
-  shell->on_draw.Emit(shell, &painter, dirty);
+  shell->DrawCustomContent(&painter, dirty);
 }
 
 @end
 
 namespace nu {
 
+namespace {
+
+void SetHoverTrackedByParent(NSView* view, bool tracked) {
+  if (!IsNUView(view))
+    return;
+  NUPrivate* priv = [view nuPrivate];
+  if (priv->hover_tracked_by_parent == tracked)
+    return;
+  priv->hover_tracked_by_parent = tracked;
+  if (tracked)
+    [view disableTracking];
+  else
+    [view enableTracking];
+}
+
+}  // namespace
+
+void Container::SetTrackChildrenHover(bool track) {
+  NUPrivate* priv = [GetNative() nuPrivate];
+  if (priv->track_children_hover == track)
+    return;
+  priv->track_children_hover = track;
+  priv->hovered_child.reset();
+  for (int i = 0; i < ChildCount(); ++i)
+    SetHoverTrackedByParent(ChildAt(i)->GetNative(), track);
+}
+
+bool Container::IsTrackChildrenHover() const {
+  return [GetNative() nuPrivate]->track_children_hover;
+}
+
 void Container::PlatformInit() {
   TakeOverView([[NUContainer alloc] init]);
 }
@@ -74,12 +126,18 @@ void Container::PlatformAddChildView(View* child) {
         [ChildAt(i)->GetNative() setWantsLayer:YES];
     }
   }
+  if (priv->track_children_hover)
+    SetHoverTrackedByParent(child->GetNative(), true);
 }
 
 void Container::PlatformRemoveChildView(View* child) {
   [child->GetNative() removeFromSuperview];
-  // Revert wantsLayer to default.
+  NUPrivate* priv = [GetNative() nuPrivate];
   NSView* nc = child->GetNative();
+  if (priv->hovered_child.get() == nc)
+    priv->hovered_child.reset();
+  SetHoverTrackedByParent(nc, false);
+  // Revert wantsLayer to default.
   if (IsNUView(nc))
     [nc setWantsLayer:[nc nuPrivate]->wants_layer];
   else
@@ -0,0 +1,21 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_MAC_DRAG_DROP_FILE_PROMISE_DELEGATE_H_
+#define NATIVEUI_MAC_DRAG_DROP_FILE_PROMISE_DELEGATE_H_
+
+#import <Cocoa/Cocoa.h>
+
+#include "nativeui/dragging_info.h"
+
+// Write the promised file in a worker queue after it is dropped.
+API_AVAILABLE(macos(10.12))
+@interface FilePromiseDelegate : NSObject<NSFilePromiseProviderDelegate>
+// Return a provider that keeps its delegate alive.
++ (NSFilePromiseProvider*)providerWithFilePromise:
+    (const nu::FilePromise&)promise;
+- (instancetype)initWithFilePromise:(const nu::FilePromise&)promise;
+@end
+
+#endif  // NATIVEUI_MAC_DRAG_DROP_FILE_PROMISE_DELEGATE_H_
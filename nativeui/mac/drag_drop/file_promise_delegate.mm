@@ -0,0 +1,87 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/mac/drag_drop/file_promise_delegate.h"
+
+#import <CoreServices/CoreServices.h>
+
+#include "base/mac/foundation_util.h"
+#include "base/mac/scoped_cftyperef.h"
+#include "base/mac/scoped_nsobject.h"
+#include "base/strings/sys_string_conversions.h"
+
+namespace {
+
+// Return the UTI of file by its extension.
+NSString* UTIFromFileName(const base::FilePath& file_name) {
+  std::string extension = file_name.Extension();
+  if (extension.empty())
+    return base::mac::CFToNSCast(kUTTypeData);
+  base::ScopedCFTypeRef<CFStringRef> ext_cf(
+      base::SysUTF8ToCFStringRef(extension.substr(1)));
+  base::ScopedCFTypeRef<CFStringRef> uti(UTTypeCreatePreferredIdentifierForTag(
+      kUTTagClassFilenameExtension, ext_cf.get(), nullptr));
+  if (!uti)
+    return base::mac::CFToNSCast(kUTTypeData);
+  return [[base::mac::CFToNSCast(uti.get()) retain] autorelease];
+}
+
+}  // namespace
+
+@implementation FilePromiseDelegate {
+  base::FilePath fileName_;
+  nu::FilePromise::Writer writer_;
+}
+
++ (NSFilePromiseProvider*)providerWithFilePromise:
+    (const nu::FilePromise&)promise {
+  base::scoped_nsobject<FilePromiseDelegate> delegate(
+      [[FilePromiseDelegate alloc] initWithFilePromise:promise]);
+  NSFilePromiseProvider* provider = [[[NSFilePromiseProvider alloc]
+      initWithFileType:UTIFromFileName(promise.file_name)
+              delegate:delegate.get()] autorelease];
+  // The delegate is a weak reference, keep it alive with the provider.
+  [provider setUserInfo:delegate.get()];
+  return provider;
+}
+
+- (instancetype)initWithFilePromise:(const nu::FilePromise&)promise {
+  if ((self = [super init])) {
+    fileName_ = promise.file_name.BaseName();
+    writer_ = promise.writer;
+  }
+  return self;
+}
+
+- (NSString*)filePromiseProvider:(NSFilePromiseProvider*)filePromiseProvider
+                 fileNameForType:(NSString*)fileType {
+  return base::mac::FilePathToNSString(fileName_);
+}
+
+- (void)filePromiseProvider:(NSFilePromiseProvider*)filePromiseProvider
+          writePromiseToURL:(NSURL*)url
+          completionHandler:(void (^)(NSError* errorOrNil))completionHandler {
+  base::FilePath path = base::mac::NSStringToFilePath([url path]);
+  if (writer_ && writer_(path)) {
+    completionHandler(nil);
+  } else {
+    completionHandler([NSError errorWithDomain:NSCocoaErrorDomain
+                                          code:NSFileWriteUnknownError
+                                      userInfo:nil]);
+  }
+}
+
+- (NSOperationQueue*)operationQueueForFilePromiseProvider:
+    (NSFilePromiseProvider*)filePromiseProvider {
+  // The main queue is used by default, write files in background instead.
+  static NSOperationQueue* queue = nil;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    queue = [[NSOperationQueue alloc] init];
+    [queue setQualityOfService:NSQualityOfServiceUserInitiated];
+  });
+  return queue;
+}
+
+@end
@@ -26,4 +26,13 @@ Clipboard::Data DraggingInfoMac::GetData(Data::Type type) const {
   return clipboard_.GetData(type);
 }
 
+int64_t DraggingInfoMac::GetDataSize(Data::Type type) const {
+  return clipboard_.GetDataSize(type);
+}
+
+bool DraggingInfoMac::ReadData(Data::Type type,
+                               const Clipboard::DataReader& reader) const {
+  return clipboard_.ReadData(type, reader);
+}
+
 }  // namespace nu
@@ -4,6 +4,7 @@
 
 #include "nativeui/entry.h"
 
+#include "base/mac/scoped_nsobject.h"
 #include "base/strings/sys_string_conversions.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/mac/nu_private.h"
@@ -81,9 +82,12 @@
 @interface NUEntryDelegate : NSObject<NSTextFieldDelegate> {
  @private
   nu::Entry* shell_;
+  // The text when last change was notified.
+  base::scoped_nsobject<NSString> text_;
 }
 - (id)initWithShell:(nu::Entry*)shell;
 - (IBAction)onActivate:(id)sender;
+- (void)resetText:(NSString*)text;
 @end
 
 @implementation NUEntryDelegate
@@ -98,8 +102,37 @@
   shell_->on_activate.Emit(shell_);
 }
 
+- (void)resetText:(NSString*)text {
+  text_.reset([text copy]);
+}
+
 - (void)controlTextDidChange:(NSNotification*)notification {
-  shell_->on_text_change.Emit(shell_);
+  // The marked text is part of the string, committing or canceling it also
+  // changes the text so the composition end does not need to be notified.
+  shell_->NotifyTextChange();
+  NSString* text = [[notification object] stringValue];
+  if (!shell_->on_text_range_change.IsEmpty()) {
+    // The field editor does not tell the edited range, but the text of an
+    // entry is short enough to compare.
+    NSString* old = text_ ? text_.get() : @"";
+    NSUInteger old_length = [old length];
+    NSUInteger length = [text length];
+    NSUInteger prefix = 0;
+    while (prefix < old_length && prefix < length &&
+           [old characterAtIndex:prefix] == [text characterAtIndex:prefix])
+      ++prefix;
+    NSUInteger suffix = 0;
+    while (suffix < old_length - prefix && suffix < length - prefix &&
+           [old characterAtIndex:old_length - suffix - 1] ==
+               [text characterAtIndex:length - suffix - 1])
+      ++suffix;
+    NSString* inserted = [text substringWithRange:
+        NSMakeRange(prefix, length - prefix - suffix)];
+    shell_->on_text_range_change.Emit(shell_, prefix,
+                                      old_length - prefix - suffix,
+                                      base::SysNSStringToUTF8(inserted));
+  }
+  [self resetText:text];
 }
 
 @end
@@ -128,6 +161,7 @@ Entry::~Entry() {
 void Entry::SetText(const std::string& text) {
   auto* entry = static_cast<NSTextField*>(GetNative());
   [entry setStringValue:base::SysUTF8ToNSString(text)];
+  [static_cast<NUEntryDelegate*>(entry.target) resetText:[entry stringValue]];
 }
 
 std::string Entry::GetText() const {
@@ -135,6 +169,15 @@ std::string Entry::GetText() const {
   return base::SysNSStringToUTF8([entry stringValue]);
 }
 
+bool Entry::IsComposing() const {
+  // The marked text lives in the field editor, which only exists when the
+  // entry is being edited.
+  auto* entry = static_cast<NSTextField*>(GetNative());
+  NSText* editor = [entry currentEditor];
+  return [editor conformsToProtocol:@protocol(NSTextInputClient)] &&
+         [static_cast<id<NSTextInputClient>>(editor) hasMarkedText];
+}
+
 SizeF Entry::GetMinimumSize() const {
   auto* entry = static_cast<NSTextField*>(GetNative());
   return SizeF(0, [[entry cell] cellSize].height);
@@ -6,6 +6,7 @@
 
 #include <objc/objc-runtime.h>
 
+#include "base/mac/scoped_nsobject.h"
 #include "base/notreached.h"
 #include "nativeui/events/event.h"
 #include "nativeui/mac/dragging_info_mac.h"
@@ -38,15 +39,15 @@ void OnKeyEvent(NSView* self, SEL _cmd, NSEvent* event) {
   View* view = [self shell];
   DCHECK(view);
 
-  // Emit the event to View.
+  // Emit the event to View, the event is not converted when there is no
+  // one listening.
   bool prevent_default = false;
-  KeyEvent key_event(event, self);
-  if (key_event.type == EventType::KeyDown)
-    prevent_default = view->on_key_down.Emit(view, key_event);
-  else if (key_event.type == EventType::KeyUp)
-    prevent_default = view->on_key_up.Emit(view, key_event);
-  else
-    NOTREACHED();
+  if (!view->on_key_down.IsEmpty() || !view->on_key_up.IsEmpty()) {
+    KeyEvent key_event(event, self);
+    DCHECK(key_event.type == EventType::KeyDown ||
+           key_event.type == EventType::KeyUp);
+    prevent_default = view->EmitKeyEvent(key_event);
+  }
 
   // Transfer the event to super class.
   if (!prevent_default) {
@@ -111,6 +112,54 @@ void DraggingSessionEnded(NSView* self, SEL _cmd, NSDraggingSession*,
   [self shell]->CancelDrag();
 }
 
+// Send enter or exit event to a child whose hover is tracked by its parent.
+void SendEnterExitEvent(NSView* child, NSEvent* event, NSEventType type) {
+  View* view = [child shell];
+  if (!view)
+    return;
+  NSEvent* fake = [NSEvent enterExitEventWithType:type
+                                         location:[event locationInWindow]
+                                    modifierFlags:[event modifierFlags]
+                                        timestamp:[event timestamp]
+                                     windowNumber:[event windowNumber]
+                                          context:nil
+                                      eventNumber:0
+                                   trackingNumber:0
+                                         userData:nil];
+  DispatchMouseEvent(view, fake);
+}
+
+// Find the direct child under the mouse that has its hover tracked by parent.
+NSView* FindHoveredChild(NSView* self, NSEvent* event) {
+  if ([event type] == NSMouseExited || ![self superview])
+    return nil;
+  NSPoint point = [[self superview] convertPoint:[event locationInWindow]
+                                        fromView:nil];
+  NSView* hit = [self hitTest:point];
+  while (hit && [hit superview] != self)
+    hit = [hit superview];
+  if (!hit || !IsNUView(hit) || ![hit nuPrivate]->hover_tracked_by_parent)
+    return nil;
+  return hit;
+}
+
+// Emit enter and leave events for children of a container that tracks hover
+// for its children, and forward mouse move events to the hovered child.
+void UpdateHoveredChild(NSView* self, NSEvent* event) {
+  NUPrivate* priv = [self nuPrivate];
+  NSView* child = FindHoveredChild(self, event);
+  if (child != priv->hovered_child.get()) {
+    base::scoped_nsobject<NSView> previous(priv->hovered_child);
+    priv->hovered_child.reset([child retain]);
+    if (previous)
+      SendEnterExitEvent(previous, event, NSMouseExited);
+    if (child)
+      SendEnterExitEvent(child, event, NSMouseEntered);
+  }
+  if (child && [event type] == NSMouseMoved)
+    DispatchMouseEvent([child shell], event);
+}
+
 }  // namespace
 
 void AddMouseEventHandlerToClass(Class cl) {
@@ -150,34 +199,54 @@ void AddDragDropHandlerToClass(Class cl) {
 }
 
 bool DispatchMouseEvent(View* view, NSEvent* event) {
-  bool prevent_default = false;
-  NUPrivate* priv = [view->GetNative() nuPrivate];
-  MouseEvent mouse_event(event, view->GetNative());
-  switch (mouse_event.type) {
-    case EventType::MouseDown:
-      prevent_default = view->on_mouse_down.Emit(view, mouse_event);
-      break;
-    case EventType::MouseUp:
-      prevent_default = view->on_mouse_up.Emit(view, mouse_event);
-      break;
-    case EventType::MouseMove:
-      view->on_mouse_move.Emit(view, mouse_event);
-      prevent_default = true;
-      break;
-    case EventType::MouseEnter:
+  NSView* self = view->GetNative();
+  NUPrivate* priv = [self nuPrivate];
+  NSEventType type = [event type];
+  if (priv->track_children_hover &&
+      (type == NSMouseMoved || type == NSMouseEntered ||
+       type == NSMouseExited))
+    UpdateHoveredChild(self, event);
+
+  // The MouseEvent is only created when there is handler, which saves the
+  // conversions of coordinates for views that are not observed.
+  switch (type) {
+    case NSLeftMouseDown:
+    case NSRightMouseDown:
+    case NSOtherMouseDown:
+      view->FlushMouseMove();
+      if (view->on_mouse_down.IsEmpty())
+        return false;
+      return view->EmitMouseEvent(MouseEvent(event, self));
+    case NSLeftMouseUp:
+    case NSRightMouseUp:
+    case NSOtherMouseUp:
+      view->FlushMouseMove();
+      if (view->on_mouse_up.IsEmpty())
+        return false;
+      return view->EmitMouseEvent(MouseEvent(event, self));
+    case NSMouseMoved:
+    case NSLeftMouseDragged:
+    case NSRightMouseDragged:
+    case NSOtherMouseDragged:
+      if (!view->on_mouse_move.IsEmpty())
+        view->EmitMouseMove(MouseEvent(event, self));
+      return true;
+    case NSMouseEntered:
+      view->FlushMouseMove();
       priv->hovered = true;
-      view->on_mouse_enter.Emit(view, mouse_event);
-      prevent_default = true;
-      break;
-    case EventType::MouseLeave:
+      if (!view->on_mouse_enter.IsEmpty())
+        view->EmitMouseEvent(MouseEvent(event, self));
+      return true;
+    case NSMouseExited:
+      view->FlushMouseMove();
       priv->hovered = false;
-      view->on_mouse_leave.Emit(view, mouse_event);
-      prevent_default = true;
-      break;
+      if (!view->on_mouse_leave.IsEmpty())
+        view->EmitMouseEvent(MouseEvent(event, self));
+      return true;
     default:
-      break;
+      view->FlushMouseMove();
+      return false;
   }
-  return prevent_default;
 }
 
 }  // namespace nu
@@ -45,6 +45,19 @@ bool FileDialog::RunForWindow(Window* window) {
   return chosen == NSFileHandlingPanelOKButton;
 }
 
+void FileDialog::PlatformShowForWindow(Window* window) {
+  // The dialog is kept alive by ShowForWindow until OnClose.
+  FileDialog* self = this;
+  auto handler = ^(NSInteger chosen) {
+    self->OnClose(chosen == NSFileHandlingPanelOKButton);
+  };
+  if (window)
+    [dialog_ beginSheetModalForWindow:window->GetNative()
+                    completionHandler:handler];
+  else
+    [dialog_ beginWithCompletionHandler:handler];
+}
+
 void FileDialog::SetTitle(const std::string& title) {
   dialog_.title = base::SysUTF8ToNSString(title);
 }
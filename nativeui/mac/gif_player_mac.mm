@@ -69,7 +69,7 @@
   [super viewDidUnhide];
   auto* gif = static_cast<nu::GifPlayer*>([self shell]);
   if (gif && gif->IsAnimating() && !gif->IsPlaying())
-    gif->ScheduleFrame();
+    gif->StartAnimationTimer();
 }
 
 @end
@@ -82,42 +82,7 @@ GifPlayer::GifPlayer() {
 }
 
 GifPlayer::~GifPlayer() {
-  if (timer_ > 0)
-    StopAnimationTimer();
-}
-
-void GifPlayer::PlatformSetImage(Image* image) {
-  SchedulePaint();
-  // Reset animation data.
-  frames_count_ = 0;
-  frame_ = 0;
-  animation_rep_ = image ? image->GetAnimationRep() : nullptr;
-  if (animation_rep_) {
-    NSNumber* frames = [animation_rep_ valueForProperty:NSImageFrameCount];
-    frames_count_ = [frames intValue];
-    frame_ = frames_count_ - 1;
-  }
-  // Start animation by default.
-  SetAnimating(!!image);
-}
-
-bool GifPlayer::CanAnimate() const {
-  return animation_rep_ != nullptr;
-}
-
-void GifPlayer::ScheduleFrame() {
-  // Advance frame.
-  frame_ = (frame_ + 1) % frames_count_;
-  [animation_rep_ setProperty:NSImageCurrentFrame
-                    withValue:[NSNumber numberWithInteger:frame_]];
-  // Emit draw event.
-  SchedulePaint();
-  // Schedule next call.
-  if (is_animating_) {
-    timer_ = MessageLoop::SetTimeout(
-        image_->GetAnimationDuration(frame_),
-        std::bind(&GifPlayer::ScheduleFrame, this));
-  }
+  StopAnimationTimer();
 }
 
 }  // namespace nu
@@ -20,4 +20,9 @@ void Lifetime::PlatformDestroy() {
   [app_delegate_ release];
 }
 
+void Lifetime::PlatformFlushBeforeExit() {
+  // Autosaved window frames are written to user defaults lazily.
+  [[NSUserDefaults standardUserDefaults] synchronize];
+}
+
 }  // namespace nu
@@ -8,13 +8,39 @@
 
 #include "nativeui/menu_item.h"
 
+@interface NUMenuDelegate : NSObject<NSMenuDelegate> {
+ @private
+  nu::MenuBase* shell_;
+}
+- (id)initWithShell:(nu::MenuBase*)shell;
+@end
+
+@implementation NUMenuDelegate
+
+- (id)initWithShell:(nu::MenuBase*)shell {
+  if ((self = [super init]))
+    shell_ = shell;
+  return self;
+}
+
+- (void)menuNeedsUpdate:(NSMenu*)menu {
+  shell_->NotifyWillOpen();
+}
+
+@end
+
 namespace nu {
 
 void MenuBase::PlatformInit() {
   [menu_ setAutoenablesItems:NO];
+  [menu_ setDelegate:[[NUMenuDelegate alloc] initWithShell:this]];
 }
 
 void MenuBase::PlatformDestroy() {
+  // The delegate is not retained by the menu.
+  id delegate = [menu_ delegate];
+  [menu_ setDelegate:nil];
+  [delegate release];
   [menu_ release];
 }
 
@@ -31,7 +31,7 @@
     shell_->SetChecked(!shell_->IsChecked());
   else if (shell_->GetType() == nu::MenuItem::Type::Radio)
     shell_->SetChecked(true);
-  shell_->on_click.Emit(shell_);
+  shell_->NotifyClick();
 }
 
 @end
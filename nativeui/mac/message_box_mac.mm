@@ -11,6 +11,56 @@
 #include "nativeui/gfx/image.h"
 #include "nativeui/window.h"
 
+// Handles the buttons of NSAlert when it is shown without a parent window,
+// since NSAlert only has blocking API in that case.
+@interface NUAlertTarget : NSObject {
+ @private
+  scoped_refptr<nu::MessageBox> box_;
+  id originalTarget_;  // weak ptr
+  SEL originalAction_;
+}
+- (id)initWithMessageBox:(nu::MessageBox*)box;
+- (void)onButton:(id)sender;
+- (void)closeWithResponse:(base::Optional<int>)response;
+@end
+
+@implementation NUAlertTarget
+
+- (id)initWithMessageBox:(nu::MessageBox*)box {
+  if ((self = [super init])) {
+    box_ = box;
+    NSButton* first = [[box->GetNative() buttons] firstObject];
+    originalTarget_ = [first target];
+    originalAction_ = [first action];
+    for (NSButton* button in [box->GetNative() buttons]) {
+      [button setTarget:self];
+      [button setAction:@selector(onButton:)];
+    }
+  }
+  return self;
+}
+
+- (void)onButton:(id)sender {
+  [self closeWithResponse:static_cast<int>([sender tag])];
+}
+
+- (void)closeWithResponse:(base::Optional<int>)response {
+  scoped_refptr<nu::MessageBox> box = std::move(box_);
+  if (!box)
+    return;
+  NSAlert* alert = box->GetNative();
+  [[alert window] orderOut:nil];
+  // Restore the buttons so the alert can still be run modally.
+  for (NSButton* button in [alert buttons]) {
+    [button setTarget:originalTarget_];
+    [button setAction:originalAction_];
+  }
+  [self release];  // balances the alloc in PlatformShow
+  box->OnClose(response);
+}
+
+@end
+
 namespace nu {
 
 namespace {
@@ -44,6 +94,17 @@ int MessageBox::PlatformRunForWindow(Window* window) {
   return res == kCancelId ? cancel_response_ : res;
 }
 
+void MessageBox::PlatformShow() {
+  // NSAlert adds an OK button when running without buttons.
+  if ([[box_ buttons] count] == 0)
+    [[box_ addButtonWithTitle:@"OK"] setTag:NSAlertFirstButtonReturn];
+  // Released when closed.
+  [[NUAlertTarget alloc] initWithMessageBox:this];
+  [box_ layout];
+  [[box_ window] center];
+  [[box_ window] makeKeyAndOrderFront:nil];
+}
+
 void MessageBox::PlatformShowForWindow(Window* window) {
   __block scoped_refptr<MessageBox> ref = this;
   [box_ beginSheetModalForWindow:window->GetNative()
@@ -53,7 +114,13 @@ void MessageBox::PlatformShowForWindow(Window* window) {
 }
 
 void MessageBox::PlatformClose() {
-  [NSApp endSheet:box_.window];
+  if ([box_.window sheetParent]) {
+    [NSApp endSheet:box_.window];
+    return;
+  }
+  id target = [[[box_ buttons] firstObject] target];
+  if ([target isKindOfClass:[NUAlertTarget class]])
+    [target closeWithResponse:base::nullopt];
 }
 
 void MessageBox::SetType(Type type) {
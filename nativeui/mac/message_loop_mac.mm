@@ -6,11 +6,18 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <limits.h>
+
+#include <utility>
+
+#include "base/logging.h"
+
 namespace nu {
 
 namespace {
 
-unsigned int g_task_id = 0;
+// Observes the main run loop to run idle tasks before it goes to sleep.
+CFRunLoopObserverRef g_idle_observer = nullptr;
 
 }  // namespace
 
@@ -18,7 +25,7 @@ unsigned int g_task_id = 0;
 base::Lock MessageLoop::lock_;
 
 // static
-std::unordered_map<MessageLoop::TimerId, MessageLoop::Task> MessageLoop::tasks_;
+std::deque<MessageLoop::Task> MessageLoop::idle_tasks_;
 
 // static
 void MessageLoop::Run() {
@@ -42,52 +49,118 @@ void MessageLoop::Quit() {
 }
 
 // static
-void MessageLoop::PostTask(Task task) {
-  __block Task callback = std::move(task);
-  dispatch_async(dispatch_get_main_queue(), ^{
-    callback();
+bool MessageLoop::WakeupForTasks() {
+  // A run loop source is signaled instead of dispatching a block for each
+  // task, so a batch of tasks costs one wakeup.
+  static CFRunLoopSourceRef source = nullptr;
+  static dispatch_once_t once;
+  dispatch_once(&once, ^{
+    CFRunLoopSourceContext context = {};
+    context.perform = [](void*) { RunTasks(); };
+    source = CFRunLoopSourceCreate(kCFAllocatorDefault, 0, &context);
+    CFRunLoopAddSource(CFRunLoopGetMain(), source, kCFRunLoopCommonModes);
   });
+  CFRunLoopSourceSignal(source);
+  CFRunLoopWakeUp(CFRunLoopGetMain());
+  return true;
 }
 
 // static
-void MessageLoop::PostDelayedTask(int ms, Task task) {
-  __block Task callback = std::move(task);
-  dispatch_time_t t = dispatch_time(DISPATCH_TIME_NOW, ms * NSEC_PER_MSEC);
-  dispatch_after(t, dispatch_get_main_queue(), ^{
-    callback();
-  });
+void MessageLoop::PlatformPostTask(Priority priority, Task task) {
+  switch (priority) {
+    case Priority::UserBlocking: {
+      // Blocks added to the run loop are performed before the sources, which
+      // include the port delivering events.
+      __block Task callback = std::move(task);
+      CFRunLoopRef run_loop = CFRunLoopGetMain();
+      CFRunLoopPerformBlock(run_loop, kCFRunLoopCommonModes, ^{
+        callback();
+      });
+      CFRunLoopWakeUp(run_loop);
+      break;
+    }
+    case Priority::Idle:
+      AddIdleTask(std::move(task));
+      break;
+    case Priority::Normal:
+      NOTREACHED();
+      break;
+  }
 }
 
 // static
-MessageLoop::TimerId MessageLoop::SetTimeout(int ms, Task task) {
-  // Store the callback.
-  __block TimerId id;
-  {
-    base::AutoLock auto_lock(lock_);
-    id = ++g_task_id;
-    tasks_[id] = std::move(task);
+void MessageLoop::ScheduleTimer(int ms) {
+  // One timer source is created for all timeouts, and it is re-armed for the
+  // next wakeup of timer wheel.
+  static dispatch_source_t timer = nullptr;
+  if (!timer) {
+    timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0,
+                                   dispatch_get_main_queue());
+    dispatch_source_set_event_handler(timer, ^{
+      RunTimers();
+    });
+    dispatch_resume(timer);
   }
-  // Schedule a task to run the callback.
-  dispatch_time_t t = dispatch_time(DISPATCH_TIME_NOW, ms * NSEC_PER_MSEC);
-  dispatch_after(t, dispatch_get_main_queue(), ^{
-    Task task;
-    {
-      base::AutoLock auto_lock(lock_);
-      auto it = tasks_.find(id);
-      if (it == tasks_.end())  // cleared
-        return;
-      task = std::move(it->second);
-      tasks_.erase(it);
-    }
-    task();
-  });
-  return id;
+  dispatch_source_set_timer(timer,
+                            dispatch_time(DISPATCH_TIME_NOW,
+                                          ms * NSEC_PER_MSEC),
+                            DISPATCH_TIME_FOREVER,
+                            NSEC_PER_MSEC / 10);
 }
 
 // static
-void MessageLoop::ClearTimeout(TimerId id) {
+void MessageLoop::PlatformSetTimersPrecise(bool precise) {
+  // App Nap is only prevented while unthrottled timers are pending in
+  // background mode, so it can still save power for throttled apps.
+  static id<NSObject> activity = nil;
+  NSProcessInfo* info = [NSProcessInfo processInfo];
+  if (precise) {
+    activity = [[info
+        beginActivityWithOptions:NSActivityUserInitiatedAllowingIdleSystemSleep
+                          reason:@"Unthrottled timers"] retain];
+  } else if (activity) {
+    [info endActivity:activity];
+    [activity release];
+    activity = nil;
+  }
+}
+
+// static
+void MessageLoop::AddIdleTask(Task task) {
   base::AutoLock auto_lock(lock_);
-  tasks_.erase(id);
+  idle_tasks_.push_back(std::move(task));
+  if (!g_idle_observer) {
+    g_idle_observer = CFRunLoopObserverCreateWithHandler(
+        kCFAllocatorDefault, kCFRunLoopBeforeWaiting, true,
+        // Run after the observer that flushes CoreAnimation transactions.
+        INT_MAX,
+        ^(CFRunLoopObserverRef, CFRunLoopActivity) {
+          RunIdleTask();
+        });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), g_idle_observer,
+                         kCFRunLoopCommonModes);
+  }
+  CFRunLoopWakeUp(CFRunLoopGetMain());
+}
+
+// static
+void MessageLoop::RunIdleTask() {
+  // Only run one task in each iteration, so events received in the meanwhile
+  // can be handled first.
+  Task task;
+  bool has_more;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (idle_tasks_.empty())
+      return;
+    task = std::move(idle_tasks_.front());
+    idle_tasks_.pop_front();
+    has_more = !idle_tasks_.empty();
+  }
+  // Wake up the run loop so there is another iteration for remaining tasks.
+  if (has_more)
+    CFRunLoopWakeUp(CFRunLoopGetMain());
+  task();
 }
 
 }  // namespace nu
@@ -34,8 +34,12 @@ struct NUPrivate {
   bool is_content_view = false;
   bool wants_layer = false;  // default value for wantsLayer
   bool wants_layer_infected = false;  // infects the wantsLayer property
+  bool draws_asynchronously = false;  // applied to the layer when created
   base::scoped_nsobject<NSCursor> cursor;
   base::scoped_nsobject<NSTrackingArea> tracking_area;
+  bool track_children_hover = false;  // children have no tracking areas
+  bool hover_tracked_by_parent = false;  // hover is emitted by parent
+  base::scoped_nsobject<NSView> hovered_child;  // child under the mouse
   std::unique_ptr<MouseCapture> mouse_capture;
 
   // Drag target properties.
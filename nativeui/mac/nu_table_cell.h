@@ -7,16 +7,24 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include <string>
+
 #include "nativeui/table.h"
 
+namespace nu {
+class TableCellCache;
+}
+
 @interface NUTableCell : NSTableCellView {
  @private
   nu::Table::ColumnType type_;
   nu::TableModel* model_;  // weak ptr
   uint32_t column_;
   uint32_t row_;
+  std::string text_;  // the text shown in textField
 }
-- (id)initWithColumnOptions:(const nu::Table::ColumnOptions&)options;
+- (id)initWithColumnOptions:(const nu::Table::ColumnOptions&)options
+                  cellCache:(nu::TableCellCache*)cellCache;
 - (void)setTableModel:(nu::TableModel*)model
                column:(uint32_t)column
                   row:(uint32_t)row;
@@ -5,45 +5,57 @@
 #include "nativeui/mac/nu_table_cell.h"
 
 #include "base/mac/scoped_nsobject.h"
+#include "base/strings/string_util.h"
 #include "base/strings/sys_string_conversions.h"
 #include "base/values.h"
 #include "nativeui/gfx/mac/painter_mac.h"
-#include "nativeui/mac/value_conversion.h"
+#include "nativeui/table_cell_cache.h"
 #include "nativeui/table_model.h"
 
 @interface NUCustomTableCellView : NSView {
  @private
-  nu::Table::ColumnOptions options_;
+  scoped_refptr<nu::TableCellCache> cellCache_;
   base::Value value_;
+  uint32_t row_;
 }
-- (id)initWithColumnOptions:(const nu::Table::ColumnOptions&)options;
-- (void)setValue:(base::Value)value;
+- (id)initWithCellCache:(nu::TableCellCache*)cellCache;
+- (void)setValue:(const base::Value&)value row:(uint32_t)row;
 @end
 
 @implementation NUCustomTableCellView
 
-- (id)initWithColumnOptions:(const nu::Table::ColumnOptions&)options {
-  if ((self = [super init]))
-    options_ = options;
+- (id)initWithCellCache:(nu::TableCellCache*)cellCache {
+  if ((self = [super init])) {
+    cellCache_ = cellCache;
+    row_ = 0;
+  }
   return self;
 }
 
-- (void)setValue:(base::Value)value {
-  value_ = std::move(value);
+- (void)setValue:(const base::Value&)value row:(uint32_t)row {
+  row_ = row;
+  // Recycled views or reloading do not need repainting if the value is the
+  // same.
+  if (value_ == value)
+    return;
+  value_ = value.Clone();
+  [self setNeedsDisplay:YES];
 }
 
 - (void)drawRect:(NSRect)dirtyRect {
-  if (options_.on_draw) {
-    nu::PainterMac painter(self);
-    options_.on_draw(&painter, nu::RectF(dirtyRect), value_);
-  }
+  float scaleFactor = [self window] ? [[self window] backingScaleFactor]
+                                    : [[NSScreen mainScreen] backingScaleFactor];
+  nu::PainterMac painter(self);
+  cellCache_->DrawCell(&painter, row_, nu::RectF([self bounds]), scaleFactor,
+                       value_);
 }
 
 @end
 
 @implementation NUTableCell
 
-- (id)initWithColumnOptions:(const nu::Table::ColumnOptions&)options {
+- (id)initWithColumnOptions:(const nu::Table::ColumnOptions&)options
+                  cellCache:(nu::TableCellCache*)cellCache {
   if ((self = [super init])) {
     type_ = options.type;
     model_ = nullptr;
@@ -70,7 +82,7 @@
 
       case nu::Table::ColumnType::Custom: {
         base::scoped_nsobject<NUCustomTableCellView> customView(
-            [[NUCustomTableCellView alloc] initWithColumnOptions:options]);
+            [[NUCustomTableCellView alloc] initWithCellCache:cellCache]);
         [customView setAutoresizingMask:(NSViewWidthSizable | NSViewHeightSizable)];
         [self addSubview:customView];
         break;
@@ -86,32 +98,31 @@
   model_ = model;
   column_ = column;
   row_ = row;
-}
-
-- (void)setObjectValue:(id)obj {
-  [super setObjectValue:obj];
 
-  // A nil value may be passed to do clear work.
-  if (!obj)
-    return;
-
-  // Note: we have to store a copy of the value, the reference will be away
-  // after current stack ends.
-  const base::Value* value = static_cast<const base::Value*>(
-      [static_cast<NSValue*>(obj) pointerValue]);
+  // Bind the value straight from the model, instead of boxing it as the
+  // objectValue of the cell.
+  const base::Value* value = model->GetValue(column, row);
   switch (type_) {
     case nu::Table::ColumnType::Text:
     case nu::Table::ColumnType::Edit: {
-      if (value && value->is_string())
-        self.textField.stringValue = base::SysUTF8ToNSString(value->GetString());
+      // Reloaded or recycled cells often show the same text, which does not
+      // need a new NSString.
+      const std::string& text = value && value->is_string() ?
+          value->GetString() : base::EmptyString();
+      if (text == text_)
+        break;
+      text_ = text;
+      self.textField.stringValue = base::SysUTF8ToNSString(text);
       break;
     }
 
     case nu::Table::ColumnType::Custom: {
+      // Note: we have to store a copy of the value, the reference will be
+      // away after current stack ends.
       auto* customView = static_cast<NUCustomTableCellView*>(
           [[self subviews] firstObject]);
-      [customView setValue:(value ? value->Clone() : base::Value())];
-      [customView setNeedsDisplay:YES];
+      const base::Value empty;
+      [customView setValue:(value ? *value : empty) row:row_];
       break;
     }
   }
@@ -120,8 +131,8 @@
 - (void)onEditDone:(id)sender {
   if (!model_)
     return;
-  model_->SetValue(column_, row_,
-                   base::Value(base::SysNSStringToUTF8([sender stringValue])));
+  text_ = base::SysNSStringToUTF8([sender stringValue]);
+  model_->SetValue(column_, row_, base::Value(text_));
 }
 
 @end
@@ -8,14 +8,21 @@
 #import <Cocoa/Cocoa.h>
 
 #include "nativeui/table.h"
+#include "nativeui/table_cell_cache.h"
 
-@interface NUTableColumn : NSTableColumn
+@interface NUTableColumn : NSTableColumn {
+ @private
+  scoped_refptr<nu::TableCellCache> cellCache_;
+}
 @property uint32_t columnInModel;
 @property nu::Table::ColumnOptions options;
 
 - (id)initWithTable:(nu::Table*)table
               title:(const std::string&)title
             options:(const nu::Table::ColumnOptions&)options;
+
+// The drawings of custom cells, null for other types of columns.
+- (nu::TableCellCache*)cellCache;
 @end
 
 #endif  // NATIVEUI_MAC_NU_TABLE_COLUMN_H_
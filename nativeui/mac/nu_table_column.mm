@@ -26,6 +26,8 @@ int g_next_id = 0;
     self.columnInModel = options.column == -1 ? table->GetColumnCount()
                                               : columnOptions.column;
     self.options = columnOptions;
+    if (columnOptions.type == nu::Table::ColumnType::Custom)
+      cellCache_ = new nu::TableCellCache(columnOptions);
     self.headerCell.stringValue = base::SysUTF8ToNSString(title);
 
     // Handle width property.
@@ -39,4 +41,8 @@ int g_next_id = 0;
   return self;
 }
 
+- (nu::TableCellCache*)cellCache {
+  return cellCache_.get();
+}
+
 @end
@@ -70,6 +70,8 @@ void ResetCursorRects(NSView* self, SEL _cmd) {
 
 void EnableTracking(NSView* self, SEL _cmd) {
   NUPrivate* priv = [self nuPrivate];
+  if (priv->hover_tracked_by_parent)
+    return;
   NSTrackingAreaOptions trackingOptions = NSTrackingMouseEnteredAndExited |
                                           NSTrackingMouseMoved |
                                           NSTrackingActiveAlways |
@@ -96,7 +98,7 @@ void UpdateTrackingAreas(NSView* self, SEL _cmd) {
       [[self superclass] instanceMethodForSelector:_cmd]);
   super_impl(self, _cmd);
 
-  if (![self window])
+  if (![self window] || [self nuPrivate]->hover_tracked_by_parent)
     return;
 
   [self disableTracking];
@@ -95,6 +95,17 @@ void Picker::AddItem(const std::string& text) {
   [picker synchronizeTitleAndSelectedItem];
 }
 
+void Picker::SetItems(const std::vector<std::string>& items) {
+  auto* picker = static_cast<NUPicker*>(GetNative());
+  NSMutableArray* titles = [NSMutableArray arrayWithCapacity:items.size()];
+  for (const std::string& item : items)
+    [titles addObject:base::SysUTF8ToNSString(item)];
+  // Duplicate titles are removed by NSPopUpButton.
+  [picker removeAllItems];
+  [picker addItemsWithTitles:titles];
+  [picker synchronizeTitleAndSelectedItem];
+}
+
 void Picker::RemoveItemAt(int index) {
   auto* picker = static_cast<NUPicker*>(GetNative());
   [picker removeItemAtIndex:index];
@@ -4,6 +4,8 @@
 
 #include "nativeui/scroll.h"
 
+#include <algorithm>
+
 #include "nativeui/mac/nu_private.h"
 #include "nativeui/mac/nu_view.h"
 
@@ -13,10 +15,16 @@
   NSSize content_size_;
 }
 - (void)setContentSize:(NSSize)size;
+- (void)onScroll:(NSNotification*)notification;
 @end
 
 @implementation NUScroll
 
+- (void)dealloc {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  [super dealloc];
+}
+
 - (nu::NUPrivate*)nuPrivate {
   return &private_;
 }
@@ -41,6 +49,12 @@
   content_size_ = size;
 }
 
+- (void)onScroll:(NSNotification*)notification {
+  auto* shell = static_cast<nu::Scroll*>([self shell]);
+  if (shell)
+    shell->NotifyScroll();
+}
+
 - (void)resizeSubviewsWithOldSize:(NSSize)oldBoundsSize {
   // Automatically resize the content view when ScrollView is larger than the
   // content size.
@@ -66,6 +80,13 @@ void Scroll::PlatformInit() {
     scroll.hasVerticalScroller = YES;
   }
   [scroll.contentView setCopiesOnScroll:NO];
+  // Receive notifications when the clip view scrolls.
+  scroll.contentView.postsBoundsChangedNotifications = YES;
+  [[NSNotificationCenter defaultCenter]
+      addObserver:scroll
+         selector:@selector(onScroll:)
+             name:NSViewBoundsDidChangeNotification
+           object:scroll.contentView];
   TakeOverView(scroll);
 }
 
@@ -81,6 +102,30 @@ void Scroll::SetContentSize(const SizeF& size) {
   [scroll.documentView setFrameSize:content_size];
 }
 
+void Scroll::PlatformSetScrollPosition(float horizon, float vertical) {
+  auto* scroll = static_cast<NUScroll*>(GetNative());
+  auto max = GetMaximumScrollPosition();
+  horizon = std::max(0.f, std::min(horizon, std::get<0>(max)));
+  vertical = std::max(0.f, std::min(vertical, std::get<1>(max)));
+  // The document view of Scroll is flipped.
+  [scroll.contentView scrollToPoint:NSMakePoint(horizon, vertical)];
+  [scroll reflectScrolledClipView:scroll.contentView];
+}
+
+std::tuple<float, float> Scroll::GetScrollPosition() const {
+  auto* scroll = static_cast<NUScroll*>(GetNative());
+  NSPoint point = scroll.contentView.bounds.origin;
+  return std::make_tuple(point.x, point.y);
+}
+
+std::tuple<float, float> Scroll::GetMaximumScrollPosition() const {
+  auto* scroll = static_cast<NUScroll*>(GetNative());
+  NSSize content = scroll.documentView.frame.size;
+  NSSize viewport = scroll.contentView.bounds.size;
+  return std::make_tuple(std::max(0.0, content.width - viewport.width),
+                         std::max(0.0, content.height - viewport.height));
+}
+
 void Scroll::SetOverlayScrollbar(bool overlay) {
   auto* scroll = static_cast<NUScroll*>(GetNative());
   scroll.scrollerStyle = overlay ? NSScrollerStyleOverlay
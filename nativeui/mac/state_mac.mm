@@ -26,4 +26,8 @@ void State::PlatformInit() {
                               [NSScreen mainScreen].backingScaleFactor);
 }
 
+void State::PlatformPrewarm() {
+  // Cocoa has nothing to register before creating windows.
+}
+
 }  // namespace nu
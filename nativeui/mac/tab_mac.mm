@@ -27,7 +27,7 @@
 
 - (void)tabView:(NSTabView*)tabView
     didSelectTabViewItem:(NSTabViewItem*)tabViewItem {
-  shell_->on_selected_page_change.Emit(shell_);
+  shell_->NotifyPageSelected([tabView indexOfTabViewItem:tabViewItem]);
 }
 
 @end
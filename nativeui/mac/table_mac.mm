@@ -4,6 +4,8 @@
 
 #include "nativeui/table.h"
 
+#include <algorithm>
+
 #include "base/mac/scoped_nsobject.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/mac/nu_private.h"
@@ -34,11 +36,15 @@
   auto* reuse = [tableView makeViewWithIdentifier:[tableColumn identifier]
                                             owner:self];
   NUTableCell* tableCell = nullptr;
-  if (reuse)
+  if (reuse) {
     tableCell = static_cast<NUTableCell*>(reuse);
-  else
+  } else {
     tableCell = [[[NUTableCell alloc]
-        initWithColumnOptions:[tableColumn options]] autorelease];
+        initWithColumnOptions:[tableColumn options]
+                    cellCache:[tableColumn cellCache]] autorelease];
+    // Views are only reused when having the identifier.
+    [tableCell setIdentifier:[tableColumn identifier]];
+  }
   [tableCell setTableModel:shell_->GetModel()
                     column:[tableColumn columnInModel]
                        row:row];
@@ -57,6 +63,7 @@
 }
 - (id)initWithShell:(nu::Table*)shell;
 - (void)setColumnsVisible:(bool)visible;
+- (void)onClipViewChange:(NSNotification*)notification;
 @end
 
 @implementation NUTable
@@ -70,10 +77,34 @@
     [self setHasVerticalScroller:YES];
     [self setHasHorizontalScroller:YES];
     [self setDocumentView:tableView_];
+    // Receive notifications when the clip view scrolls or resizes.
+    NSClipView* clipView = [self contentView];
+    [clipView setPostsBoundsChangedNotifications:YES];
+    [clipView setPostsFrameChangedNotifications:YES];
+    NSNotificationCenter* center = [NSNotificationCenter defaultCenter];
+    [center addObserver:self
+               selector:@selector(onClipViewChange:)
+                   name:NSViewBoundsDidChangeNotification
+                 object:clipView];
+    [center addObserver:self
+               selector:@selector(onClipViewChange:)
+                   name:NSViewFrameDidChangeNotification
+                 object:clipView];
   }
   return self;
 }
 
+- (void)dealloc {
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+  [super dealloc];
+}
+
+- (void)onClipViewChange:(NSNotification*)notification {
+  auto* shell = static_cast<nu::Table*>([self shell]);
+  if (shell)
+    shell->OnVisibleRangeMayChange();
+}
+
 - (void)setColumnsVisible:(bool)visible {
   if (visible) {
     [tableView_ setHeaderView:headerView_];
@@ -188,20 +219,67 @@ int Table::GetSelectedRow() const {
   return [tableView selectedRow];
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+std::tuple<int, int> Table::GetVisibleRowRange() const {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
-  [tableView insertRowsAtIndexes:[NSIndexSet indexSetWithIndex:row]
+  NSRange range = [tableView rowsInRect:[tableView visibleRect]];
+  if (range.length == 0)
+    return std::make_tuple(-1, -1);
+  return std::make_tuple(static_cast<int>(range.location),
+                         static_cast<int>(NSMaxRange(range)));
+}
+
+void Table::PlatformScrollToRow(int row, ScrollAlign align) {
+  auto* table = static_cast<NUTable*>(GetNative());
+  auto* tableView = static_cast<NSTableView*>([table documentView]);
+  if (align == ScrollAlign::Nearest) {
+    [tableView scrollRowToVisible:row];
+    return;
+  }
+  NSClipView* clipView = [table contentView];
+  NSRect rowRect = [tableView rectOfRow:row];
+  CGFloat height = NSHeight([clipView bounds]);
+  CGFloat y = NSMinY(rowRect);
+  if (align == ScrollAlign::Center)
+    y -= (height - NSHeight(rowRect)) / 2;
+  else if (align == ScrollAlign::End)
+    y -= height - NSHeight(rowRect);
+  // Do not scroll beyond the content.
+  CGFloat max_y = NSHeight([tableView frame]) - height;
+  y = std::max<CGFloat>(0, std::min(y, max_y));
+  // The header view covers the top of clip view.
+  if ([tableView headerView])
+    y -= NSHeight([[tableView headerView] frame]);
+  [clipView scrollToPoint:NSMakePoint(NSMinX([clipView bounds]), y)];
+  [table reflectScrolledClipView:clipView];
+}
+
+void Table::NotifyRowsInserted(uint32_t start, uint32_t count) {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  [tableView insertRowsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                      NSMakeRange(start, count)]
                    withAnimation:NSTableViewAnimationEffectNone];
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::NotifyRowsDeleted(uint32_t start, uint32_t count) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
-  [tableView removeRowsAtIndexes:[NSIndexSet indexSetWithIndex:row]
+  [tableView removeRowsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                      NSMakeRange(start, count)]
                    withAnimation:NSTableViewAnimationEffectNone];
 }
 
+void Table::NotifyRangeChanged(uint32_t start, uint32_t count) {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  NSRange columns = NSMakeRange(0, [tableView numberOfColumns]);
+  [tableView reloadDataForRowIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                          NSMakeRange(start, count)]
+                       columnIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                          columns]];
+}
+
 void Table::NotifyValueChange(uint32_t column, uint32_t row) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
@@ -209,4 +287,10 @@ void Table::NotifyValueChange(uint32_t column, uint32_t row) {
                        columnIndexes:[NSIndexSet indexSetWithIndex:column]];
 }
 
+void Table::NotifyReset() {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  [tableView reloadData];
+}
+
 }  // namespace nu
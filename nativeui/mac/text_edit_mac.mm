@@ -4,7 +4,10 @@
 
 #include "nativeui/text_edit.h"
 
+#include <algorithm>
+
 #include "base/mac/scoped_nsobject.h"
+#include "base/stl_util.h"
 #include "base/strings/sys_string_conversions.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/mac/nu_private.h"
@@ -13,8 +16,17 @@
 @interface NUTextViewDelegate : NSObject<NSTextViewDelegate> {
  @private
   nu::TextEdit* shell_;
+  // The length of text when last change was notified.
+  NSUInteger length_;
+  // The change that is going to happen.
+  BOOL hasPendingChange_;
+  NSRange pendingRange_;
+  NSUInteger pendingLength_;
 }
 - (id)initWithShell:(nu::TextEdit*)shell;
+- (void)notifyChangeInRange:(NSRange)range
+          replacementLength:(NSUInteger)length
+                 ofTextView:(NSTextView*)textView;
 @end
 
 @implementation NUTextViewDelegate
@@ -25,8 +37,45 @@
   return self;
 }
 
+- (void)notifyChangeInRange:(NSRange)range
+          replacementLength:(NSUInteger)length
+                 ofTextView:(NSTextView*)textView {
+  length_ = length_ - range.length + length;
+  if (shell_->on_text_range_change.IsEmpty())
+    return;
+  NSString* inserted = [[textView string]
+      substringWithRange:NSMakeRange(range.location, length)];
+  shell_->on_text_range_change.Emit(shell_, range.location, range.length,
+                                    base::SysNSStringToUTF8(inserted));
+}
+
+- (BOOL)textView:(NSTextView*)textView
+    shouldChangeTextInRange:(NSRange)range
+          replacementString:(NSString*)string {
+  // Changes of attributes do not have replacement string.
+  if (string) {
+    hasPendingChange_ = YES;
+    pendingRange_ = range;
+    pendingLength_ = [string length];
+  }
+  return YES;
+}
+
 - (void)textDidChange:(NSNotification*)notification {
   shell_->on_text_change.Emit(shell_);
+  auto* textView = static_cast<NSTextView*>([notification object]);
+  NSUInteger length = [[textView string] length];
+  // Changes that did not ask for permission, like undoing, are notified as
+  // replacing the whole text.
+  if (!hasPendingChange_ ||
+      length_ - pendingRange_.length + pendingLength_ != length) {
+    pendingRange_ = NSMakeRange(0, length_);
+    pendingLength_ = length;
+  }
+  hasPendingChange_ = NO;
+  [self notifyChangeInRange:pendingRange_
+           replacementLength:pendingLength_
+                  ofTextView:textView];
 }
 
 - (BOOL)textView:(NSTextView*)textView
@@ -63,6 +112,8 @@
     [textView_ setAutoresizingMask:(NSViewWidthSizable | NSViewHeightSizable)];
     [[textView_ textContainer] setContainerSize:NSMakeSize(FLT_MAX, FLT_MAX)];
     [[textView_ textContainer] setWidthTracksTextView:YES];
+    // Only lay out the visible part of large documents.
+    [[textView_ layoutManager] setAllowsNonContiguousLayout:YES];
     self.documentView = textView_.get();
   }
   return self;
@@ -110,7 +161,12 @@ TextEdit::~TextEdit() {
 void TextEdit::SetText(const std::string& text) {
   auto* textView = static_cast<NSTextView*>(
       [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  NSUInteger length = [[textView string] length];
   [textView setString:base::SysUTF8ToNSString(text)];
+  [static_cast<NUTextViewDelegate*>([textView delegate])
+      notifyChangeInRange:NSMakeRange(0, length)
+        replacementLength:[[textView string] length]
+               ofTextView:textView];
 }
 
 std::string TextEdit::GetText() const {
@@ -228,6 +284,103 @@ void TextEdit::SetScrollbarPolicy(Scroll::Policy h_policy,
   scroll.hasVerticalScroller = v_policy != Scroll::Policy::Never;
 }
 
+void TextEdit::PlatformAppendText(const std::string& text) {
+  auto* textView = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  NSTextStorage* storage = [textView textStorage];
+  NSUInteger length = [storage length];
+  // Editing the storage directly does not change selection or register undo.
+  base::scoped_nsobject<NSAttributedString> str([[NSAttributedString alloc]
+      initWithString:base::SysUTF8ToNSString(text)
+          attributes:[textView typingAttributes]]);
+  [storage beginEditing];
+  [storage appendAttributedString:str.get()];
+  [storage endEditing];
+  on_text_change.Emit(this);
+  [static_cast<NUTextViewDelegate*>([textView delegate])
+      notifyChangeInRange:NSMakeRange(length, 0)
+        replacementLength:[str length]
+               ofTextView:textView];
+}
+
+int TextEdit::PlatformGetLineCount() const {
+  auto* textView = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  NSString* str = [[textView textStorage] string];
+  NSUInteger length = [str length];
+  int count = 1;
+  unichar buffer[1024];
+  for (NSUInteger i = 0; i < length; i += base::size(buffer)) {
+    NSRange range =
+        NSMakeRange(i, std::min<NSUInteger>(length - i, base::size(buffer)));
+    [str getCharacters:buffer range:range];
+    count += std::count(buffer, buffer + range.length, '\n');
+  }
+  return count;
+}
+
+void TextEdit::PlatformDeleteLines(int count) {
+  auto* textView = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  NSTextStorage* storage = [textView textStorage];
+  NSString* str = [storage string];
+  NSUInteger end = 0;
+  for (int i = 0; i < count && end < [str length]; ++i)
+    end = NSMaxRange([str lineRangeForRange:NSMakeRange(end, 0)]);
+  [storage deleteCharactersInRange:NSMakeRange(0, end)];
+  // The recorded actions no longer match the positions of text.
+  [[textView undoManager] removeAllActions];
+  on_text_change.Emit(this);
+  [static_cast<NUTextViewDelegate*>([textView delegate])
+      notifyChangeInRange:NSMakeRange(0, end)
+        replacementLength:0
+               ofTextView:textView];
+}
+
+bool TextEdit::PlatformIsScrolledToEnd() const {
+  auto* scroll = static_cast<NSScrollView*>(GetNative());
+  NSRect visible = [[scroll contentView] documentVisibleRect];
+  return NSMaxY(visible) >= NSHeight([[scroll documentView] frame]) - 1;
+}
+
+void TextEdit::PlatformScrollToEnd() {
+  auto* textView = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  [textView scrollRangeToVisible:NSMakeRange([[textView string] length], 0)];
+}
+
+void TextEdit::SetAttributesForRanges(
+    const std::vector<RangeAttributes>& ranges) {
+  auto* textView = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  NSTextStorage* storage = [textView textStorage];
+  // The layout is only invalidated once when editing ends.
+  [storage beginEditing];
+  for (const RangeAttributes& range : ranges) {
+    NSRange ns_range = NSMakeRange(range.start, range.end - range.start);
+    if (range.font)
+      [storage addAttribute:NSFontAttributeName
+                      value:range.font->GetNative()
+                      range:ns_range];
+    if (range.color)
+      [storage addAttribute:NSForegroundColorAttributeName
+                      value:range.color->ToNSColor()
+                      range:ns_range];
+  }
+  [storage endEditing];
+}
+
+void TextEdit::ClearAttributesInRange(int start, int end) {
+  auto* textView = static_cast<NSTextView*>(
+      [static_cast<NUTextEdit*>(GetNative()) documentView]);
+  NSTextStorage* storage = [textView textStorage];
+  if (end < 0)
+    end = [storage length];
+  // Plain text views keep the view's font and color in typing attributes.
+  [storage setAttributes:[textView typingAttributes]
+                   range:NSMakeRange(start, end - start)];
+}
+
 RectF TextEdit::GetTextBounds() const {
   auto* textView = static_cast<NSTextView*>(
       [static_cast<NUTextEdit*>(GetNative()) documentView]);
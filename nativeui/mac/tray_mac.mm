@@ -6,7 +6,9 @@
 
 #import <Cocoa/Cocoa.h>
 
+#include "base/mac/scoped_cftyperef.h"
 #include "base/strings/sys_string_conversions.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/geometry/rect_f.h"
 #include "nativeui/gfx/image.h"
 #include "nativeui/gfx/mac/coordinate_conversion.h"
@@ -83,9 +85,31 @@ void Tray::SetTitle(const std::string& title) {
 }
 
 void Tray::SetImage(scoped_refptr<Image> icon) {
+  canvas_ = nullptr;
   [[tray_ button] setImage:icon->GetNative()];
 }
 
+void Tray::SetImageFromCanvas(scoped_refptr<Canvas> canvas) {
+  NSStatusBarButton* button = [tray_ button];
+  if (canvas_ == canvas) {
+    // The image reads the canvas whenever it is drawn.
+    [button setNeedsDisplay:YES];
+    return;
+  }
+  canvas_ = canvas;
+  NSImage* image = [NSImage imageWithSize:canvas->GetSize().ToCGSize()
+                                  flipped:NO
+                           drawingHandler:^BOOL(NSRect rect) {
+    base::ScopedCFTypeRef<CGImageRef> cgimage(
+        CGBitmapContextCreateImage(canvas->GetBitmap()));
+    CGContextDrawImage([[NSGraphicsContext currentContext] CGContext],
+                       NSRectToCGRect(rect), cgimage);
+    return YES;
+  }];
+  [image setCacheMode:NSImageCacheNever];
+  [button setImage:image];
+}
+
 void Tray::SetPressedImage(scoped_refptr<Image> icon) {
   [[tray_ button] setAlternateImage:icon->GetNative()];
 }
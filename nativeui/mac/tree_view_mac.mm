@@ -0,0 +1,325 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree_view.h"
+
+#include <unordered_map>
+
+#include "base/mac/scoped_nsobject.h"
+#include "base/strings/sys_string_conversions.h"
+#include "base/values.h"
+#include "nativeui/gfx/font.h"
+#include "nativeui/mac/nu_private.h"
+#include "nativeui/mac/nu_view.h"
+
+// Provides nodes to NSOutlineView, the items are NSValues wrapping the nodes
+// and each node must always be represented by the same item.
+@interface NUTreeViewDelegate : NSObject<NSOutlineViewDataSource,
+                                         NSOutlineViewDelegate> {
+ @private
+  nu::TreeView* shell_;
+  std::unordered_map<nu::TreeView::Node*,
+                     base::scoped_nsobject<NSValue>> items_;
+}
+- (id)initWithShell:(nu::TreeView*)shell;
+- (id)itemForNode:(nu::TreeView::Node*)node;
+- (void)forgetNodes:(const nu::TreeView::Nodes&)nodes;
+- (void)forgetAllNodes;
+@end
+
+namespace {
+
+inline nu::TreeView::Node* GetNode(nu::TreeView* shell, id item) {
+  if (!item)
+    return shell->GetRoot();
+  return static_cast<nu::TreeView::Node*>([item pointerValue]);
+}
+
+}  // namespace
+
+@implementation NUTreeViewDelegate
+
+- (id)initWithShell:(nu::TreeView*)shell {
+  if ((self = [super init]))
+    shell_ = shell;
+  return self;
+}
+
+- (id)itemForNode:(nu::TreeView::Node*)node {
+  if (!node->parent)  // root
+    return nil;
+  auto& item = items_[node];
+  if (!item)
+    item.reset([[NSValue valueWithPointer:node] retain]);
+  return item.get();
+}
+
+- (void)forgetNodes:(const nu::TreeView::Nodes&)nodes {
+  for (const auto& node : nodes) {
+    items_.erase(node.get());
+    [self forgetNodes:node->children];
+  }
+}
+
+- (void)forgetAllNodes {
+  items_.clear();
+}
+
+- (NSInteger)outlineView:(NSOutlineView*)outlineView
+    numberOfChildrenOfItem:(id)item {
+  return shell_->GetChildren(GetNode(shell_, item)).size();
+}
+
+- (id)outlineView:(NSOutlineView*)outlineView
+            child:(NSInteger)index
+           ofItem:(id)item {
+  const auto& children = shell_->GetChildren(GetNode(shell_, item));
+  return [self itemForNode:children[index].get()];
+}
+
+- (BOOL)outlineView:(NSOutlineView*)outlineView isItemExpandable:(id)item {
+  return shell_->HasChildren(GetNode(shell_, item));
+}
+
+- (NSView*)outlineView:(NSOutlineView*)outlineView
+    viewForTableColumn:(NSTableColumn*)tableColumn
+                  item:(id)item {
+  auto* cell = static_cast<NSTextField*>(
+      [outlineView makeViewWithIdentifier:[tableColumn identifier]
+                                    owner:self]);
+  if (!cell) {
+    cell = [[[NSTextField alloc] init] autorelease];
+    [cell setBezeled:NO];
+    [cell setDrawsBackground:NO];
+    [cell setEditable:NO];
+    [cell setSelectable:NO];
+    [[cell cell] setLineBreakMode:NSLineBreakByTruncatingTail];
+    // Views are only reused when having the identifier.
+    [cell setIdentifier:[tableColumn identifier]];
+  }
+  nu::TreeModel* model = shell_->GetModel();
+  const base::Value* value = model ?
+      model->GetValue(GetNode(shell_, item)->id,
+                      [[tableColumn identifier] intValue]) :
+      nullptr;
+  if (value && value->is_string())
+    [cell setStringValue:base::SysUTF8ToNSString(value->GetString())];
+  else
+    [cell setStringValue:@""];
+  return cell;
+}
+
+- (void)outlineViewItemWillExpand:(NSNotification*)notification {
+  id item = [[notification userInfo] objectForKey:@"NSObject"];
+  shell_->OnNodeExpand(GetNode(shell_, item));
+}
+
+- (void)outlineViewItemDidCollapse:(NSNotification*)notification {
+  id item = [[notification userInfo] objectForKey:@"NSObject"];
+  shell_->OnNodeCollapse(GetNode(shell_, item));
+}
+
+- (void)outlineViewSelectionDidChange:(NSNotification*)notification {
+  shell_->on_selection_change.Emit(shell_);
+}
+
+@end
+
+@interface NUTreeView : NSScrollView<NUView> {
+ @private
+  base::scoped_nsobject<NSOutlineView> outlineView_;
+  base::scoped_nsobject<NUTreeViewDelegate> delegate_;
+  base::scoped_nsobject<NSTableHeaderView> headerView_;
+  nu::NUPrivate private_;
+}
+- (id)initWithShell:(nu::TreeView*)shell;
+- (NSOutlineView*)outlineView;
+- (NUTreeViewDelegate*)treeDelegate;
+- (void)setColumnsVisible:(bool)visible;
+@end
+
+@implementation NUTreeView
+
+- (id)initWithShell:(nu::TreeView*)shell {
+  if ((self = [super init])) {
+    outlineView_.reset([[NSOutlineView alloc] init]);
+    delegate_.reset([[NUTreeViewDelegate alloc] initWithShell:shell]);
+    [outlineView_ setDelegate:delegate_];
+    [self setBorderType:NSNoBorder];
+    [self setHasVerticalScroller:YES];
+    [self setHasHorizontalScroller:YES];
+    [self setDocumentView:outlineView_];
+  }
+  return self;
+}
+
+- (NSOutlineView*)outlineView {
+  return outlineView_.get();
+}
+
+- (NUTreeViewDelegate*)treeDelegate {
+  return delegate_.get();
+}
+
+- (void)setColumnsVisible:(bool)visible {
+  if (visible) {
+    [outlineView_ setHeaderView:headerView_];
+    headerView_.reset();
+  } else {
+    headerView_.reset([[outlineView_ headerView] retain]);
+    [outlineView_ setHeaderView:nil];
+  }
+}
+
+- (nu::NUPrivate*)nuPrivate {
+  return &private_;
+}
+
+- (void)setNUFont:(nu::Font*)font {
+  [outlineView_ setFont:font->GetNative()];
+}
+
+- (void)setNUColor:(nu::Color)color {
+}
+
+- (void)setNUBackgroundColor:(nu::Color)color {
+  [outlineView_ setBackgroundColor:color.ToNSColor()];
+}
+
+- (void)setNUEnabled:(BOOL)enabled {
+  [outlineView_ setEnabled:enabled];
+}
+
+- (BOOL)isNUEnabled {
+  return [outlineView_ isEnabled];
+}
+
+@end
+
+namespace nu {
+
+NativeView TreeView::PlatformCreate() {
+  return [[NUTreeView alloc] initWithShell:this];
+}
+
+void TreeView::PlatformDestroy() {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  // The outline view may outlive this class in autorelease pool.
+  [[tree outlineView] setDataSource:nil];
+  [[tree outlineView] setDelegate:nil];
+}
+
+void TreeView::PlatformSetModel(TreeModel* model) {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  [[tree treeDelegate] forgetAllNodes];
+  [[tree outlineView] setDataSource:model ? [tree treeDelegate] : nil];
+  [[tree outlineView] reloadData];
+}
+
+void TreeView::AddColumn(const std::string& title) {
+  auto* outlineView = [static_cast<NUTreeView*>(GetNative()) outlineView];
+  NSString* identifier = [NSString stringWithFormat:@"%d", GetColumnCount()];
+  base::scoped_nsobject<NSTableColumn> column(
+      [[NSTableColumn alloc] initWithIdentifier:identifier]);
+  [[column headerCell] setStringValue:base::SysUTF8ToNSString(title)];
+  [outlineView addTableColumn:column];
+  // The expanders are shown in the first column.
+  if ([outlineView numberOfColumns] == 1)
+    [outlineView setOutlineTableColumn:column];
+}
+
+int TreeView::GetColumnCount() const {
+  auto* outlineView = [static_cast<NUTreeView*>(GetNative()) outlineView];
+  return [outlineView numberOfColumns];
+}
+
+void TreeView::SetColumnsVisible(bool visible) {
+  if (visible == IsColumnsVisible())
+    return;
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  [tree setColumnsVisible:visible];
+}
+
+bool TreeView::IsColumnsVisible() const {
+  auto* outlineView = [static_cast<NUTreeView*>(GetNative()) outlineView];
+  return [outlineView headerView];
+}
+
+void TreeView::PlatformExpandNode(Node* node, bool expand) {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  id item = [[tree treeDelegate] itemForNode:node];
+  if (expand)
+    [[tree outlineView] expandItem:item];
+  else
+    [[tree outlineView] collapseItem:item];
+}
+
+void TreeView::PlatformSelectNode(Node* node) {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  NSInteger row = [[tree outlineView]
+      rowForItem:[[tree treeDelegate] itemForNode:node]];
+  if (row < 0)
+    return;
+  [[tree outlineView] selectRowIndexes:[NSIndexSet indexSetWithIndex:row]
+                  byExtendingSelection:NO];
+}
+
+TreeView::Node* TreeView::PlatformGetSelectedNode() const {
+  auto* outlineView = [static_cast<NUTreeView*>(GetNative()) outlineView];
+  NSInteger row = [outlineView selectedRow];
+  if (row < 0)
+    return nullptr;
+  return static_cast<Node*>([[outlineView itemAtRow:row] pointerValue]);
+}
+
+void TreeView::PlatformChildrenInserted(Node* parent,
+                                        uint32_t start,
+                                        uint32_t count) {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  id item = [[tree treeDelegate] itemForNode:parent];
+  [[tree outlineView]
+      insertItemsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                NSMakeRange(start, count)]
+                  inParent:item
+             withAnimation:NSTableViewAnimationEffectNone];
+  // The parent just got its first children.
+  if (item && parent->children.size() == count)
+    [[tree outlineView] reloadItem:item];
+}
+
+void TreeView::PlatformChildrenDeleted(Node* parent,
+                                       uint32_t start,
+                                       const Nodes& removed) {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  id item = [[tree treeDelegate] itemForNode:parent];
+  [[tree outlineView]
+      removeItemsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:
+                                NSMakeRange(start, removed.size())]
+                  inParent:item
+             withAnimation:NSTableViewAnimationEffectNone];
+  [[tree treeDelegate] forgetNodes:removed];
+  if (item && parent->children.empty())
+    [[tree outlineView] reloadItem:item];
+}
+
+void TreeView::PlatformNodeChanged(Node* node) {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  id item = [[tree treeDelegate] itemForNode:node];
+  if (item)
+    [[tree outlineView] reloadItem:item];
+  else
+    [[tree outlineView] reloadData];
+}
+
+void TreeView::PlatformChildrenReset(Node* parent, const Nodes& removed) {
+  auto* tree = static_cast<NUTreeView*>(GetNative());
+  id item = [[tree treeDelegate] itemForNode:parent];
+  if (item)
+    [[tree outlineView] reloadItem:item reloadChildren:YES];
+  else
+    [[tree outlineView] reloadData];
+  [[tree treeDelegate] forgetNodes:removed];
+}
+
+}  // namespace nu
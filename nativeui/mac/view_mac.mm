@@ -5,16 +5,20 @@
 
 #include "nativeui/mac/nu_view.h"
 
+#include <string.h>
+
 #include "base/mac/foundation_util.h"
 #include "base/mac/scoped_cftyperef.h"
-#include "nativeui/browser.h"
 #include "nativeui/container.h"
 #include "nativeui/cursor.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/point_conversions.h"
 #include "nativeui/gfx/geometry/rect_conversions.h"
+#include "nativeui/gfx/image.h"
 #include "nativeui/gfx/mac/painter_mac.h"
 #include "nativeui/mac/drag_drop/data_provider.h"
+#include "nativeui/mac/drag_drop/file_promise_delegate.h"
 #include "nativeui/mac/drag_drop/nested_run_loop.h"
 #include "nativeui/mac/events_handler.h"
 #include "nativeui/mac/mouse_capture.h"
@@ -62,7 +66,8 @@ void View::TakeOverView(NativeView view) {
   if (!NUViewMethodsInstalled(cl)) {
     InstallNUViewMethods(cl);
     // TODO(zcbenz): Lazily install the event hooks.
-    if (GetClassName() != Browser::kClassName) {
+    // Compare by name since Browser may not be built.
+    if (strcmp(GetClassName(), "Browser") != 0) {
       // WKWebView does not like having mouse event handlers installed.
       AddMouseEventHandlerToClass(cl);
     }
@@ -93,6 +98,9 @@ void View::TakeOverView(NativeView view) {
 
 void View::SetBounds(const RectF& bounds) {
   NSRect frame = bounds.ToCGRect();
+  // The layer of layer-backed view is only redrawn on request.
+  if (IsLayerBacked() && !NSEqualSizes(frame.size, [view_ frame].size))
+    [view_ setNeedsDisplay:YES];
   [view_ setFrame:frame];
   // Calling setFrame manually does not trigger resizeSubviewsWithOldSize.
   [view_ resizeSubviewsWithOldSize:frame.size];
@@ -161,6 +169,7 @@ bool View::HasFocus() const {
 }
 
 void View::SetFocusable(bool focusable) {
+  properties_changed_ = true;
   NUPrivate* priv = [view_ nuPrivate];
   priv->focusable = focusable;
 }
@@ -193,6 +202,7 @@ bool View::HasCapture() const {
 }
 
 void View::SetMouseDownCanMoveWindow(bool yes) {
+  properties_changed_ = true;
   NUPrivate* priv = [view_ nuPrivate];
   priv->draggable = yes;
 
@@ -209,13 +219,39 @@ bool View::IsMouseDownCanMoveWindow() const {
 int View::DoDragWithOptions(std::vector<Clipboard::Data> data,
                             int operations,
                             const DragOptions& options) {
-  // Cocoa throws exception without data in drag session.
-  if (data.empty())
-    return DRAG_OPERATION_NONE;
-
+  NSMutableArray* pasteboard_writers = [NSMutableArray array];
   NUPrivate* priv = [view_ nuPrivate];
   priv->supported_drag_operation = operations;
-  priv->data_source.reset([[DataProvider alloc] initWithData:std::move(data)]);
+  if (data.empty()) {
+    priv->data_source.reset();
+  } else {
+    priv->data_source.reset(
+        [[DataProvider alloc] initWithData:std::move(data)]);
+
+    // The drag pasteboard only accepts UTI type strings.
+    NSArray* types = [[priv->data_source pasteboard] types];
+    NSMutableArray* newTypes = [NSMutableArray array];
+    for (NSString* type in types)
+      [newTypes addObject:UTIFromPboardType(type)];
+
+    base::scoped_nsobject<NSPasteboardItem> item(
+        [[NSPasteboardItem alloc] init]);
+    [item setDataProvider:priv->data_source
+                 forTypes:newTypes];
+    [pasteboard_writers addObject:item.get()];
+  }
+
+  // Promised files are written by their providers after dropping.
+  if (@available(macOS 10.12, *)) {
+    for (const FilePromise& promise : options.file_promises) {
+      [pasteboard_writers
+          addObject:[FilePromiseDelegate providerWithFilePromise:promise]];
+    }
+  }
+
+  // Cocoa throws exception without data in drag session.
+  if ([pasteboard_writers count] == 0)
+    return DRAG_OPERATION_NONE;
 
   // Release capture before beginning the dragging session. Capture may have
   // been acquired on the mouseDown, but capture is not required during the
@@ -237,30 +273,25 @@ int View::DoDragWithOptions(std::vector<Clipboard::Data> data,
                                     clickCount:1
                                       pressure:1.0];
 
-  // The drag pasteboard only accepts UTI type strings.
-  NSArray* types = [[priv->data_source pasteboard] types];
-  NSMutableArray* newTypes = [NSMutableArray array];
-  for (NSString* type in types)
-    [newTypes addObject:UTIFromPboardType(type)];
-
-  base::scoped_nsobject<NSPasteboardItem> item([[NSPasteboardItem alloc] init]);
-  [item setDataProvider:priv->data_source
-               forTypes:newTypes];
-
-  base::scoped_nsobject<NSDraggingItem> drag_item(
-      [[NSDraggingItem alloc] initWithPasteboardWriter:item.get()]);
-
-  // Set drag image.
-  if (options.image) {
-    NSImage* image = options.image->GetNative();
-    NSRect dragging_frame = NSMakeRect([event locationInWindow].x, 0,
-                                       [image size].width, [image size].height);
-    [drag_item setDraggingFrame:dragging_frame contents:image];
-  } else {
-    [drag_item setDraggingFrame:NSMakeRect(0, 0, 100, 100) contents:nil];
+  NSMutableArray* drag_items = [NSMutableArray array];
+  for (id<NSPasteboardWriting> writer in pasteboard_writers) {
+    base::scoped_nsobject<NSDraggingItem> drag_item(
+        [[NSDraggingItem alloc] initWithPasteboardWriter:writer]);
+
+    // Set drag image.
+    if (options.image) {
+      NSImage* image = options.image->GetNative();
+      NSRect dragging_frame = NSMakeRect([event locationInWindow].x, 0,
+                                         [image size].width,
+                                         [image size].height);
+      [drag_item setDraggingFrame:dragging_frame contents:image];
+    } else {
+      [drag_item setDraggingFrame:NSMakeRect(0, 0, 100, 100) contents:nil];
+    }
+    [drag_items addObject:drag_item.get()];
   }
 
-  [view_ beginDraggingSessionWithItems:@[drag_item.get()]
+  [view_ beginDraggingSessionWithItems:drag_items
                                  event:event
                                 source:(id<NSDraggingSource>)view_];
 
@@ -324,22 +355,69 @@ void View::PlatformSetFont(Font* font) {
 }
 
 void View::SetColor(Color color) {
+  properties_changed_ = true;
   if (IsNUView(view_))
     [view_ setNUColor:color];
 }
 
 void View::SetBackgroundColor(Color color) {
+  properties_changed_ = true;
   if (IsNUView(view_))
     [view_ setNUBackgroundColor:color];
 }
 
 void View::SetWantsLayer(bool wants) {
-  [view_ nuPrivate]->wants_layer = wants;
+  properties_changed_ = true;
+  NUPrivate* priv = [view_ nuPrivate];
+  priv->wants_layer = wants;
   [view_ setWantsLayer:wants];
+  // AppKit creates a new layer when wantsLayer is turned on again.
+  if (wants)
+    [view_ layer].drawsAsynchronously = priv->draws_asynchronously;
 }
 
 bool View::WantsLayer() const {
   return [view_ wantsLayer];
 }
 
+void View::SetDrawsAsynchronously(bool async) {
+  properties_changed_ = true;
+  [view_ nuPrivate]->draws_asynchronously = async;
+  if (async && ![view_ wantsLayer])
+    SetWantsLayer(true);
+  else
+    [view_ layer].drawsAsynchronously = async;
+}
+
+bool View::DrawsAsynchronously() const {
+  return [view_ nuPrivate]->draws_asynchronously;
+}
+
+void View::RenderToCanvas(Canvas* canvas, const RectF& rect) {
+  NSRect bounds = [view_ bounds];
+  if (NSIsEmptyRect(bounds) || [view_ isHidden])
+    return;
+  NSBitmapImageRep* rep = [view_ bitmapImageRepForCachingDisplayInRect:bounds];
+  [view_ cacheDisplayInRect:bounds toBitmapImageRep:rep];
+  NSImage* image = [[NSImage alloc] initWithSize:bounds.size];
+  [image addRepresentation:rep];
+  scoped_refptr<Image> nu_image = new Image(image);
+  canvas->GetPainter()->DrawImage(nu_image.get(), rect);
+}
+
+void View::PlatformSetLayerBacked(bool backed) {
+  // The layer backing is restored by ResetViewStates.
+  bool properties_changed = properties_changed_;
+  SetWantsLayer(backed);
+  properties_changed_ = properties_changed;
+  // Only redraw the layer when asked to, so moving and resizing the view are
+  // done by compositing.
+  [view_ setLayerContentsRedrawPolicy:
+      backed ? NSViewLayerContentsRedrawOnSetNeedsDisplay
+             : NSViewLayerContentsRedrawDuringViewResize];
+  // Draw the children into the view's layer instead of giving each of them
+  // a layer, which is what caching the contents of the subtree means.
+  [view_ setCanDrawSubviewsIntoLayer:backed];
+}
+
 }  // namespace nu
@@ -5,6 +5,8 @@
 #include "nativeui/window.h"
 
 #import <Cocoa/Cocoa.h>
+#import <CoreVideo/CoreVideo.h>
+#include <mach/mach_time.h>
 
 #include "base/mac/mac_util.h"
 #include "base/strings/sys_string_conversions.h"
@@ -12,7 +14,7 @@
 #include "nativeui/mac/nu_private.h"
 #include "nativeui/mac/nu_view.h"
 #include "nativeui/mac/nu_window.h"
-#include "third_party/yoga/Yoga.h"
+#include "nativeui/state.h"
 
 #if defined(OS_MACOSX)
 #include "nativeui/toolbar.h"
@@ -49,10 +51,48 @@
   shell_->on_blur.Emit(shell_);
 }
 
+- (void)windowDidChangeOcclusionState:(NSNotification*)notification {
+  shell_->NotifyOcclusionChanged();
+}
+
+- (void)windowWillStartLiveResize:(NSNotification*)notification {
+  shell_->NotifyLiveResizeStart();
+}
+
+- (void)windowDidEndLiveResize:(NSNotification*)notification {
+  shell_->NotifyLiveResizeEnd();
+}
+
 @end
 
 namespace nu {
 
+namespace {
+
+// Called in the display link's thread.
+CVReturn OnDisplayLink(CVDisplayLinkRef display_link,
+                       const CVTimeStamp* now,
+                       const CVTimeStamp* output_time,
+                       CVOptionFlags flags_in,
+                       CVOptionFlags* flags_out,
+                       void* context) {
+  static mach_timebase_info_data_t timebase;
+  if (timebase.denom == 0)
+    mach_timebase_info(&timebase);
+  double timestamp = static_cast<double>(output_time->hostTime) *
+                     timebase.numer / timebase.denom / NSEC_PER_MSEC;
+  // The block retains the window, and the shell is reset when destroyed.
+  NUWindow* window = static_cast<NUWindow*>(context);
+  dispatch_async(dispatch_get_main_queue(), ^{
+    Window* shell = [window shell];
+    if (shell && !shell->RunFrameCallbacks(timestamp))
+      CVDisplayLinkStop(display_link);
+  });
+  return kCVReturnSuccess;
+}
+
+}  // namespace
+
 void Window::PlatformInit(const Options& options) {
   NSUInteger styleMask = NSTitledWindowMask | NSMiniaturizableWindowMask |
                          NSClosableWindowMask | NSResizableWindowMask |
@@ -72,8 +112,8 @@ void Window::PlatformInit(const Options& options) {
   if (base::mac::IsAtLeastOS10_12())
     [window_ setTabbingMode:NSWindowTabbingModeDisallowed];
 
-  YGConfigSetPointScaleFactor(yoga_config_,
-                              [window_ screen].backingScaleFactor);
+  yoga_config_ = State::GetCurrent()->GetYogaConfig(
+      [window_ screen].backingScaleFactor);
 
   if (!HasFrame()) {
     // Remove title bar.
@@ -104,6 +144,14 @@ void Window::PlatformInit(const Options& options) {
 }
 
 void Window::PlatformDestroy() {
+  // Stopping waits for the running callback of display link.
+  if (display_link_) {
+    auto display_link = static_cast<CVDisplayLinkRef>(display_link_);
+    CVDisplayLinkStop(display_link);
+    CVDisplayLinkRelease(display_link);
+  }
+  [static_cast<NUWindow*>(window_) setShell:nullptr];
+
   // Clear the delegate class.
   [[window_ delegate] release];
   [window_ setDelegate:nil];
@@ -129,6 +177,9 @@ bool Window::HasShadow() const {
 }
 
 void Window::PlatformSetContentView(View* view) {
+  // Show the old and new content views in the same frame.
+  [window_ disableScreenUpdatesUntilFlush];
+
   if (content_view_) {
     [content_view_->GetNative() removeFromSuperview];
     if (IsNUView(content_view_->GetNative())) {
@@ -221,6 +272,7 @@ std::tuple<SizeF, SizeF> Window::GetContentSizeConstraints() const {
 }
 
 void Window::Activate() {
+  NotifyWillShow();
   [NSApp activateIgnoringOtherApps:YES];
   [window_ makeKeyAndOrderFront:nil];
 }
@@ -234,16 +286,22 @@ bool Window::IsActive() const {
 }
 
 void Window::SetVisible(bool visible) {
-  if (visible)
+  if (visible) {
+    NotifyWillShow();
     [window_ orderFrontRegardless];
-  else
+  } else {
     [window_ orderOut:nil];
+  }
 }
 
 bool Window::IsVisible() const {
   return [window_ isVisible];
 }
 
+bool Window::IsOccluded() const {
+  return !([window_ occlusionState] & NSWindowOcclusionStateVisible);
+}
+
 void Window::SetAlwaysOnTop(bool top) {
   [window_ setLevel:(top ? NSFloatingWindowLevel : NSNormalWindowLevel)];
 }
@@ -375,4 +433,24 @@ void Window::PlatformRemoveChildWindow(Window* child) {
   [window_ removeChildWindow:child->GetNative()];
 }
 
+void Window::PlatformRequestFrame() {
+  if (!display_link_) {
+    CVDisplayLinkRef display_link;
+    if (CVDisplayLinkCreateWithActiveCGDisplays(&display_link) !=
+        kCVReturnSuccess)
+      return;
+    CVDisplayLinkSetOutputCallback(display_link, &OnDisplayLink, window_);
+    display_link_ = display_link;
+  }
+  auto display_link = static_cast<CVDisplayLinkRef>(display_link_);
+  // Follow the display the window is on.
+  NSNumber* screen_number =
+      [[[window_ screen] deviceDescription] objectForKey:@"NSScreenNumber"];
+  if (screen_number)
+    CVDisplayLinkSetCurrentCGDisplay(display_link,
+                                     [screen_number unsignedIntValue]);
+  if (!CVDisplayLinkIsRunning(display_link))
+    CVDisplayLinkStart(display_link);
+}
+
 }  // namespace nu
@@ -0,0 +1,30 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/memory_report.h"
+
+#include "nativeui/state.h"
+
+namespace nu {
+
+MemoryReport::MemoryReport() {}
+
+MemoryReport::MemoryReport(const MemoryReport& other) = default;
+
+MemoryReport::~MemoryReport() {}
+
+LiveObjectTracker::LiveObjectTracker(LiveObjectType type, const void* object)
+    : type_(type), object_(object), state_(State::GetCurrent()) {
+  // Objects created in threads without a state are not tracked.
+  if (state_)
+    state_->live_objects(type_).insert(object_);
+}
+
+LiveObjectTracker::~LiveObjectTracker() {
+  // The state may be destroyed before objects leaked on exit.
+  if (state_ && State::GetCurrent() == state_)
+    state_->live_objects(type_).erase(object_);
+}
+
+}  // namespace nu
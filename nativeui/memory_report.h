@@ -0,0 +1,88 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_MEMORY_REPORT_H_
+#define NATIVEUI_MEMORY_REPORT_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "base/macros.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class State;
+
+// Live objects and the estimated bytes they take, grouped by subsystems.
+struct NATIVEUI_EXPORT MemoryReport {
+  MemoryReport();
+  MemoryReport(const MemoryReport& other);
+  ~MemoryReport();
+
+  struct Entry {
+    int count = 0;
+    uint64_t bytes = 0;
+  };
+
+  // Live views grouped by view class names.
+  int view_count = 0;
+  std::map<std::string, int> views;
+  // Views kept by the recycling pool, which are also counted above.
+  int recycled_view_count = 0;
+
+  // Yoga nodes allocated, including the ones kept in the free list.
+  int yoga_node_count = 0;
+  int free_yoga_node_count = 0;
+
+  // The bytes of images are the decoded pixels.
+  Entry images;
+  // Fonts are only counted.
+  Entry fonts;
+  // The bytes of attributed texts are the lengths of texts.
+  Entry attributed_texts;
+  // The bytes of canvases are the pixels of their backing stores.
+  Entry canvases;
+
+  // Table models, and the rows and the cells stored by them.
+  int table_model_count = 0;
+  uint64_t table_rows = 0;
+  uint64_t table_cells = 0;
+
+  // Responses kept by the cache of custom protocols.
+  int protocol_cache_entries = 0;
+  uint64_t protocol_cache_bytes = 0;
+};
+
+// Internal: Kinds of objects tracked for memory reports.
+enum class LiveObjectType {
+  View,
+  Image,
+  Font,
+  AttributedText,
+  Canvas,
+  TableModel,
+  Count,
+};
+
+// Internal: Register |object| in the state of current thread during the
+// lifetime of this class, which should be a member of the object.
+class NATIVEUI_EXPORT LiveObjectTracker {
+ public:
+  LiveObjectTracker(LiveObjectType type, const void* object);
+  ~LiveObjectTracker();
+
+ private:
+  LiveObjectType type_;
+  const void* object_;
+  State* state_;
+
+  DISALLOW_COPY_AND_ASSIGN(LiveObjectTracker);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_MEMORY_REPORT_H_
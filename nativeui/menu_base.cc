@@ -5,12 +5,126 @@
 #include "nativeui/menu_base.h"
 
 #include <algorithm>
+#include <string>
 #include <utility>
 
+#include "nativeui/menu.h"
 #include "nativeui/menu_item.h"
 
 namespace nu {
 
+namespace {
+
+bool StringToType(const std::string& str, MenuItem::Type* out) {
+  if (str == "label")
+    *out = MenuItem::Type::Label;
+  else if (str == "checkbox")
+    *out = MenuItem::Type::Checkbox;
+  else if (str == "radio")
+    *out = MenuItem::Type::Radio;
+  else if (str == "separator")
+    *out = MenuItem::Type::Separator;
+  else if (str == "submenu")
+    *out = MenuItem::Type::Submenu;
+  else
+    return false;
+  return true;
+}
+
+bool StringToRole(const std::string& str, MenuItem::Role* out) {
+  if (str == "copy")
+    *out = MenuItem::Role::Copy;
+  else if (str == "cut")
+    *out = MenuItem::Role::Cut;
+  else if (str == "paste")
+    *out = MenuItem::Role::Paste;
+  else if (str == "select-all")
+    *out = MenuItem::Role::SelectAll;
+  else if (str == "undo")
+    *out = MenuItem::Role::Undo;
+  else if (str == "redo")
+    *out = MenuItem::Role::Redo;
+#if defined(OS_MACOSX)
+  else if (str == "about")
+    *out = MenuItem::Role::About;
+  else if (str == "hide")
+    *out = MenuItem::Role::Hide;
+  else if (str == "hide-others")
+    *out = MenuItem::Role::HideOthers;
+  else if (str == "unhide")
+    *out = MenuItem::Role::Unhide;
+  else if (str == "help")
+    *out = MenuItem::Role::Help;
+  else if (str == "window")
+    *out = MenuItem::Role::Window;
+  else if (str == "services")
+    *out = MenuItem::Role::Services;
+#endif
+  else
+    return false;
+  return true;
+}
+
+// Whether creating |items| would register any accelerator.
+bool HasAccelerators(const base::Value& items) {
+  for (const base::Value& item : items.GetList()) {
+    if (!item.is_dict())
+      continue;
+    if (item.FindKey("accelerator") || item.FindKey("role"))
+      return true;
+    const base::Value* submenu =
+        item.FindKeyOfType("submenu", base::Value::Type::LIST);
+    if (submenu && HasAccelerators(*submenu))
+      return true;
+  }
+  return false;
+}
+
+// Create an item from the template, the submenu is not handled. Follows the
+// same rules with the MenuItem.create API of language bindings.
+scoped_refptr<MenuItem> CreateItemFromTemplate(const base::Value& dict) {
+  scoped_refptr<MenuItem> item;
+  const base::Value* value = dict.FindKeyOfType("role",
+                                                base::Value::Type::STRING);
+  MenuItem::Role role;
+  if (value && StringToRole(value->GetString(), &role))
+    item = new MenuItem(role);
+  value = dict.FindKeyOfType("type", base::Value::Type::STRING);
+  MenuItem::Type type;
+  if (value && StringToType(value->GetString(), &type))
+    item = new MenuItem(type);
+  const base::Value* checked = dict.FindKeyOfType("checked",
+                                                  base::Value::Type::BOOLEAN);
+  if (!item) {
+    if (checked)
+      item = new MenuItem(MenuItem::Type::Checkbox);
+    else if (dict.FindKeyOfType("submenu", base::Value::Type::LIST))
+      item = new MenuItem(MenuItem::Type::Submenu);
+    else
+      item = new MenuItem(MenuItem::Type::Label);
+  }
+  if (checked)
+    item->SetChecked(checked->GetBool());
+  value = dict.FindKeyOfType("visible", base::Value::Type::BOOLEAN);
+  if (value)
+    item->SetVisible(value->GetBool());
+  value = dict.FindKeyOfType("enabled", base::Value::Type::BOOLEAN);
+  if (value)
+    item->SetEnabled(value->GetBool());
+  value = dict.FindKeyOfType("label", base::Value::Type::STRING);
+  if (value)
+    item->SetLabel(value->GetString());
+  value = dict.FindKeyOfType("id", base::Value::Type::STRING);
+  if (value)
+    item->SetId(value->GetString());
+  value = dict.FindKeyOfType("accelerator", base::Value::Type::STRING);
+  if (value)
+    item->SetAccelerator(Accelerator(value->GetString()));
+  return item;
+}
+
+}  // namespace
+
 MenuBase::MenuBase(NativeMenu menu) : menu_(menu) {
   PlatformInit();
 }
@@ -42,6 +156,37 @@ void MenuBase::Remove(MenuItem* item) {
   items_.erase(i);
 }
 
+void MenuBase::AppendTemplate(const base::Value& items) {
+  if (!items.is_list())
+    return;
+  for (const base::Value& dict : items.GetList()) {
+    if (!dict.is_dict())
+      continue;
+    scoped_refptr<MenuItem> item = CreateItemFromTemplate(dict);
+    const base::Value* submenu =
+        dict.FindKeyOfType("submenu", base::Value::Type::LIST);
+    if (submenu) {
+      scoped_refptr<Menu> menu(new Menu);
+      // Accelerators are registered when items are created, so a submenu
+      // with them can not wait until being opened.
+      if (HasAccelerators(*submenu))
+        menu->AppendTemplate(*submenu);
+      else
+        menu->pending_template_ = submenu->Clone();
+      item->SetSubmenu(std::move(menu));
+    }
+    Append(std::move(item));
+  }
+}
+
+void MenuBase::NotifyWillOpen() {
+  if (pending_template_.is_none())
+    return;
+  base::Value items = std::move(pending_template_);
+  pending_template_ = base::Value();
+  AppendTemplate(items);
+}
+
 void MenuBase::SetAcceleratorManager(AcceleratorManager* accel_manager) {
   accel_manager_ = accel_manager;
   for (int i = 0; i < ItemCount(); ++i)
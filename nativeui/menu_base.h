@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "base/memory/ref_counted.h"
+#include "base/values.h"
 #include "nativeui/nativeui_export.h"
+#include "nativeui/signal.h"
 #include "nativeui/types.h"
 
 namespace nu {
@@ -28,6 +30,14 @@ class NATIVEUI_EXPORT MenuBase : public base::RefCounted<MenuBase> {
   void Insert(scoped_refptr<MenuItem> item, int index);
   void Remove(MenuItem* item);
 
+  // Append the items described by |items|, which is a list of dictionaries
+  // with the keys "type", "role", "label", "id", "checked", "enabled",
+  // "visible", "accelerator" and "submenu".
+  //
+  // The items of a submenu are only created when it is opened for the first
+  // time, unless the submenu has accelerators that must work before opening.
+  void AppendTemplate(const base::Value& items);
+
   int ItemCount() const { return static_cast<int>(items_.size()); }
   MenuItem* ItemAt(int index) const {
     if (index < 0 || index >= ItemCount())
@@ -45,6 +55,14 @@ class NATIVEUI_EXPORT MenuBase : public base::RefCounted<MenuBase> {
   // Internal: Notify the change of AcceleratorManager.
   void SetAcceleratorManager(AcceleratorManager* accel_manager);
 
+  // Internal: Called by platforms before the menu is shown, creates the items
+  // that were deferred by AppendTemplate.
+  void NotifyWillOpen();
+
+  // Events.
+  // Emitted on the top-level menu when any item in it is clicked.
+  Signal<void(MenuBase*, MenuItem*)> on_item_click;
+
  protected:
   explicit MenuBase(NativeMenu menu);
   virtual ~MenuBase();
@@ -64,6 +82,9 @@ class NATIVEUI_EXPORT MenuBase : public base::RefCounted<MenuBase> {
   MenuItem* parent_ = nullptr;
   std::vector<scoped_refptr<MenuItem>> items_;
 
+  // The items that have not been created yet.
+  base::Value pending_template_;
+
   NativeMenu menu_;
 };
 
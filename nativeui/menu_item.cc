@@ -115,6 +115,14 @@ MenuBase* MenuItem::FindTopLevelMenu() const {
   return menu;
 }
 
+void MenuItem::NotifyClick() {
+  scoped_refptr<MenuItem> self(this);
+  on_click.Emit(this);
+  MenuBase* menu = FindTopLevelMenu();
+  if (menu)
+    menu->on_item_click.Emit(menu, this);
+}
+
 // Flip all radio items in the same group with |item|.
 void MenuItem::FlipRadioMenuItems(nu::MenuBase* menu, nu::MenuItem* sender) {
   // Find out from where the group starts.
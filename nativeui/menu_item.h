@@ -86,6 +86,10 @@ class NATIVEUI_EXPORT MenuItem : public base::RefCounted<MenuItem> {
   void SetAccelerator(const Accelerator& accelerator);
   Accelerator GetAccelerator() const;
 
+  // An identifier for the item, which is set from the "id" key of templates.
+  void SetId(const std::string& id) { id_ = id; }
+  const std::string& GetId() const { return id_; }
+
   // Return the type of menu item.
   Type GetType() const { return type_; }
 
@@ -107,6 +111,9 @@ class NATIVEUI_EXPORT MenuItem : public base::RefCounted<MenuItem> {
   // Internal: Search for the top-level menu.
   MenuBase* FindTopLevelMenu() const;
 
+  // Internal: Emit the click events of the item and its top-level menu.
+  void NotifyClick();
+
  private:
   friend class MenuBase;
   friend class base::RefCounted<MenuItem>;
@@ -137,6 +144,8 @@ class NATIVEUI_EXPORT MenuItem : public base::RefCounted<MenuItem> {
   // Stored accelerator instance.
   Accelerator accelerator_;
 
+  std::string id_;
+
   // Weak ref to the AcceleratorManager.
   AcceleratorManager* accel_manager_ = nullptr;
 
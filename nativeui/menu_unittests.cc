@@ -25,3 +25,56 @@ TEST_F(MenuTest, ItemCount) {
   menu_->Remove(menu_->ItemAt(0));
   EXPECT_EQ(menu_->ItemCount(), 0);
 }
+
+TEST_F(MenuTest, AppendTemplate) {
+  base::Value submenu(base::Value::Type::LIST);
+  base::Value child(base::Value::Type::DICTIONARY);
+  child.SetKey("label", base::Value("Child"));
+  child.SetKey("id", base::Value("child"));
+  submenu.GetList().push_back(std::move(child));
+  base::Value parent(base::Value::Type::DICTIONARY);
+  parent.SetKey("label", base::Value("Parent"));
+  parent.SetKey("submenu", std::move(submenu));
+  base::Value check(base::Value::Type::DICTIONARY);
+  check.SetKey("checked", base::Value(true));
+  base::Value items(base::Value::Type::LIST);
+  items.GetList().push_back(std::move(parent));
+  items.GetList().push_back(std::move(check));
+  menu_->AppendTemplate(items);
+  ASSERT_EQ(menu_->ItemCount(), 2);
+  EXPECT_EQ(menu_->ItemAt(0)->GetType(), nu::MenuItem::Type::Submenu);
+  EXPECT_EQ(menu_->ItemAt(0)->GetLabel(), "Parent");
+  EXPECT_EQ(menu_->ItemAt(1)->GetType(), nu::MenuItem::Type::Checkbox);
+  EXPECT_TRUE(menu_->ItemAt(1)->IsChecked());
+  // The submenu is populated when opened.
+  nu::Menu* sub = menu_->ItemAt(0)->GetSubmenu();
+  ASSERT_TRUE(sub);
+  EXPECT_EQ(sub->ItemCount(), 0);
+  sub->NotifyWillOpen();
+  ASSERT_EQ(sub->ItemCount(), 1);
+  EXPECT_EQ(sub->ItemAt(0)->GetId(), "child");
+  // Clicks are reported on the top-level menu.
+  std::string clicked;
+  menu_->on_item_click.Connect([&](nu::MenuBase* menu, nu::MenuItem* item) {
+    EXPECT_EQ(menu, menu_.get());
+    clicked = item->GetId();
+  });
+  sub->ItemAt(0)->Click();
+  EXPECT_EQ(clicked, "child");
+}
+
+TEST_F(MenuTest, AppendTemplateWithAccelerator) {
+  base::Value child(base::Value::Type::DICTIONARY);
+  child.SetKey("label", base::Value("Save"));
+  child.SetKey("accelerator", base::Value("CmdOrCtrl+S"));
+  base::Value submenu(base::Value::Type::LIST);
+  submenu.GetList().push_back(std::move(child));
+  base::Value parent(base::Value::Type::DICTIONARY);
+  parent.SetKey("submenu", std::move(submenu));
+  base::Value items(base::Value::Type::LIST);
+  items.GetList().push_back(std::move(parent));
+  menu_->AppendTemplate(items);
+  ASSERT_EQ(menu_->ItemCount(), 1);
+  // Submenus with accelerators are created immediately.
+  EXPECT_EQ(menu_->ItemAt(0)->GetSubmenu()->ItemCount(), 1);
+}
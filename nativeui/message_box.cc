@@ -41,7 +41,6 @@ int MessageBox::RunForWindow(Window* window) {
   return res;
 }
 
-#if defined(OS_LINUX) || defined(OS_WIN)
 void MessageBox::Show() {
   if (is_showing_) {
     LOG(ERROR) << "MessageBox is already showing";
@@ -51,17 +50,12 @@ void MessageBox::Show() {
   AddRef();
   PlatformShow();
 }
-#endif
 
 void MessageBox::ShowForWindow(Window* window) {
-#if defined(OS_LINUX) || defined(OS_WIN)
   if (!window) {
     Show();
     return;
   }
-#else
-  CHECK(window);
-#endif
   if (is_showing_) {
     LOG(ERROR) << "MessageBox is already showing";
     return;
@@ -31,9 +31,7 @@ class NATIVEUI_EXPORT MessageBox : public base::RefCounted<MessageBox> {
 
   int Run();
   int RunForWindow(Window* window);
-#if defined(OS_LINUX) || defined(OS_WIN)
   void Show();
-#endif
   void ShowForWindow(Window* window);
   void Close();
 
@@ -0,0 +1,385 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/message_loop.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "nativeui/state.h"
+#include "nativeui/trace_event.h"
+#include "nativeui/util/task_queue.h"
+#include "nativeui/util/timer_wheel.h"
+
+namespace nu {
+
+namespace {
+
+// Shared by all threads, and intentionally leaked since tasks may still be
+// posted when exiting.
+TaskQueue* GetTaskQueue() {
+  static TaskQueue* queue = new TaskQueue;
+  return queue;
+}
+
+// All timeouts are managed by one timer wheel, which is driven by a single OS
+// timer armed for the next wakeup.
+struct TimerState {
+  base::Lock lock;
+  TimerWheel wheel;
+  // Expired timers that are going to run, can still be cleared.
+  std::deque<std::pair<TimerWheel::TimerId, MessageLoop::Task>> expired;
+  // The tick the OS timer is armed for, -1 if not armed.
+  int64_t scheduled_wakeup = -1;
+  // Throttled timers expire at multiples of this, 0 if not aligned.
+  int64_t alignment = 0;
+  // Pending timers set by PostUnthrottledDelayedTask.
+  std::unordered_set<TimerWheel::TimerId> unthrottled;
+  // Whether PlatformSetTimersPrecise(true) is in effect.
+  bool precise = false;
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  // The tick of the virtual clock, -1 if using the system clock.
+  int64_t virtual_tick = -1;
+
+  int64_t GetCurrentTick() const {
+    if (virtual_tick >= 0)
+      return virtual_tick;
+    return (base::TimeTicks::Now() - start_time).InMilliseconds();
+  }
+};
+
+TimerState* GetTimerState() {
+  static TimerState* state = new TimerState;
+  return state;
+}
+
+// Frames are assumed to be produced at 60fps.
+const double kFrameInterval = 1000. / 60;
+
+// When no frame is being produced, idle tasks get at most 50ms, so input is
+// still handled in time.
+const double kMaxIdleTime = 50;
+
+// Time of the latest frame, only accessed in main thread.
+base::TimeTicks g_last_frame_time;
+
+// Handlers run in idle time after frames, only accessed in main thread.
+struct FrameIdleHandlers {
+  std::vector<std::pair<int, MessageLoop::IdleTask>> handlers;
+  int next_id = 0;
+  // Whether an idle task has been posted to run the handlers.
+  bool posted = false;
+};
+
+FrameIdleHandlers* GetFrameIdleHandlers() {
+  static FrameIdleHandlers* handlers = new FrameIdleHandlers;
+  return handlers;
+}
+
+// Tasks can be posted from any thread, while the stats belong to the main
+// thread's state.
+bool IsStatsEnabled() {
+  State* state = State::GetMain();
+  return state && state->IsMessageLoopStatsEnabled();
+}
+
+}  // namespace
+
+// static
+void MessageLoop::PostTask(Task task, const base::Location& from_here) {
+  PostTask(Priority::Normal, std::move(task), from_here);
+}
+
+// static
+void MessageLoop::PostTask(Priority priority, Task task,
+                           const base::Location& from_here) {
+  PostTaskFrom(IsStatsEnabled() ? from_here.ToString() : std::string(),
+               priority, std::move(task));
+}
+
+// static
+void MessageLoop::PostDelayedTask(int ms, Task task,
+                                  const base::Location& from_here) {
+  SetTimeout(ms, std::move(task), from_here);
+}
+
+// static
+void MessageLoop::PostUnthrottledDelayedTask(int ms, Task task,
+                                             const base::Location& from_here) {
+  SetTimeoutFrom(IsStatsEnabled() ? from_here.ToString() : std::string(),
+                 ms, std::move(task), false);
+}
+
+// static
+MessageLoop::TimerId MessageLoop::SetTimeout(int ms, Task task,
+                                             const base::Location& from_here) {
+  return SetTimeoutFrom(
+      IsStatsEnabled() ? from_here.ToString() : std::string(),
+      ms, std::move(task));
+}
+
+// static
+void MessageLoop::PostTaskFrom(const std::string& posted_from,
+                               Priority priority,
+                               Task task) {
+  if (IsStatsEnabled())
+    task = InstrumentTask(std::move(task), posted_from, 0);
+  if (priority != Priority::Normal) {
+    // These tasks are run by the platform, so they can only be traced when
+    // the tracing has started before posting.
+    static const std::atomic<bool>* trace_flag =
+        TraceLog::GetInstance()->GetCategoryFlag("loop");
+    if (trace_flag->load(std::memory_order_relaxed))
+      task = TraceSlot("loop", "MessageLoop::RunTask", std::move(task));
+    PlatformPostTask(priority, std::move(task));
+  } else if (GetTaskQueue()->Push(std::move(task))) {
+    if (!WakeupForTasks())
+      GetTaskQueue()->CancelWakeup();
+  }
+}
+
+// static
+void MessageLoop::PostIdleTask(IdleTask task,
+                               const base::Location& from_here) {
+  PostIdleTaskFrom(IsStatsEnabled() ? from_here.ToString() : std::string(),
+                   std::move(task));
+}
+
+// static
+void MessageLoop::PostIdleTaskFrom(const std::string& posted_from,
+                                   IdleTask task) {
+  PostTaskFrom(posted_from, Priority::Idle, [task]() {
+    task(GetIdleTimeRemaining());
+  });
+}
+
+// static
+void MessageLoop::DidProduceFrame() {
+  g_last_frame_time = base::TimeTicks::Now();
+  // Only one idle task is posted no matter how many windows have painted.
+  FrameIdleHandlers* frame_idle = GetFrameIdleHandlers();
+  if (!frame_idle->handlers.empty() && !frame_idle->posted) {
+    frame_idle->posted = true;
+    PostTask(Priority::Idle, &RunFrameIdleHandlers);
+  }
+}
+
+// static
+int MessageLoop::AddFrameIdleHandler(IdleTask handler) {
+  FrameIdleHandlers* frame_idle = GetFrameIdleHandlers();
+  int id = ++frame_idle->next_id;
+  frame_idle->handlers.emplace_back(id, std::move(handler));
+  return id;
+}
+
+// static
+void MessageLoop::RemoveFrameIdleHandler(int id) {
+  auto& handlers = GetFrameIdleHandlers()->handlers;
+  auto it = std::find_if(handlers.begin(), handlers.end(),
+                         [id](const auto& it) { return it.first == id; });
+  if (it != handlers.end())
+    handlers.erase(it);
+}
+
+// static
+void MessageLoop::RunFrameIdleHandlers() {
+  FrameIdleHandlers* frame_idle = GetFrameIdleHandlers();
+  frame_idle->posted = false;
+  // The handlers may remove themselves when running.
+  auto handlers = frame_idle->handlers;
+  for (const auto& it : handlers)
+    it.second(GetIdleTimeRemaining());
+}
+
+// static
+double MessageLoop::GetIdleTimeRemaining() {
+  double elapsed =
+      (base::TimeTicks::Now() - g_last_frame_time).InMillisecondsF();
+  if (g_last_frame_time.is_null() || elapsed >= kMaxIdleTime)
+    return kMaxIdleTime;
+  // Time until the next frame after now.
+  return kFrameInterval - std::fmod(elapsed, kFrameInterval);
+}
+
+// static
+MessageLoop::TimerId MessageLoop::SetTimeoutFrom(const std::string& posted_from,
+                                                 int ms,
+                                                 Task task,
+                                                 bool throttled) {
+  if (IsStatsEnabled())
+    task = InstrumentTask(std::move(task), posted_from, ms);
+  TimerState* state = GetTimerState();
+  base::AutoLock auto_lock(state->lock);
+  int64_t now = state->GetCurrentTick();
+  int64_t expiration = now + std::max(ms, 0);
+  if (throttled && state->alignment > 0) {
+    expiration = (expiration + state->alignment - 1) / state->alignment *
+                 state->alignment;
+  }
+  TimerId id = state->wheel.Add(expiration, std::move(task));
+  if (!throttled) {
+    state->unthrottled.insert(id);
+    UpdateTimersPrecise();
+  }
+  UpdateTimer(now);
+  return id;
+}
+
+// static
+void MessageLoop::SetTimerAlignment(int ms) {
+  TimerState* state = GetTimerState();
+  base::AutoLock auto_lock(state->lock);
+  state->alignment = std::max(ms, 0);
+  UpdateTimersPrecise();
+}
+
+// static
+void MessageLoop::SetVirtualTimeEnabled(bool enabled) {
+  TimerState* state = GetTimerState();
+  base::AutoLock auto_lock(state->lock);
+  if (enabled == (state->virtual_tick >= 0))
+    return;
+  if (enabled) {
+    // Start the virtual clock from current time.
+    state->virtual_tick = state->GetCurrentTick();
+  } else {
+    // Continue the system clock from the virtual time, and arm the OS timer
+    // for the pending timers.
+    state->start_time = base::TimeTicks::Now() -
+                        base::TimeDelta::FromMilliseconds(state->virtual_tick);
+    state->virtual_tick = -1;
+    state->scheduled_wakeup = -1;
+    UpdateTimer(state->GetCurrentTick());
+  }
+}
+
+// static
+bool MessageLoop::IsVirtualTimeEnabled() {
+  TimerState* state = GetTimerState();
+  base::AutoLock auto_lock(state->lock);
+  return state->virtual_tick >= 0;
+}
+
+// static
+void MessageLoop::AdvanceVirtualTime(int ms) {
+  TimerState* state = GetTimerState();
+  {
+    base::AutoLock auto_lock(state->lock);
+    if (state->virtual_tick < 0)
+      return;
+    state->virtual_tick += std::max(ms, 0);
+  }
+  RunTimers();
+}
+
+// static
+void MessageLoop::ClearTimeout(TimerId id) {
+  TimerState* state = GetTimerState();
+  base::AutoLock auto_lock(state->lock);
+  state->wheel.Cancel(static_cast<TimerWheel::TimerId>(id));
+  auto it = std::find_if(state->expired.begin(), state->expired.end(),
+                         [id](const auto& it) { return it.first == id; });
+  if (it != state->expired.end())
+    state->expired.erase(it);
+  if (state->unthrottled.erase(static_cast<TimerWheel::TimerId>(id)) > 0)
+    UpdateTimersPrecise();
+}
+
+// static
+MessageLoop::Task MessageLoop::InstrumentTask(Task task,
+                                              const std::string& posted_from,
+                                              int delay_ms) {
+  base::TimeTicks ready_time = base::TimeTicks::Now() +
+                               base::TimeDelta::FromMilliseconds(delay_ms);
+  return [task, posted_from, ready_time]() {
+    base::TimeTicks start_time = base::TimeTicks::Now();
+    task();
+    // The stats may be disabled in the task, or the state may be gone.
+    State* state = State::GetCurrent();
+    if (!state || !state->IsMessageLoopStatsEnabled())
+      return;
+    base::TimeDelta run_time = base::TimeTicks::Now() - start_time;
+    base::TimeDelta queue_delay =
+        std::max(base::TimeDelta(), start_time - ready_time);
+    MessageLoopStats* stats = state->message_loop_stats();
+    stats->task_count++;
+    stats->total_queue_delay += queue_delay;
+    stats->max_queue_delay = std::max(stats->max_queue_delay, queue_delay);
+    stats->total_run_time += run_time;
+    stats->max_run_time = std::max(stats->max_run_time, run_time);
+    if (run_time >= state->GetLongTaskThreshold()) {
+      if (stats->long_tasks.size() >= MessageLoopStats::kMaxLongTasks)
+        stats->long_tasks.erase(stats->long_tasks.begin());
+      stats->long_tasks.push_back({posted_from, queue_delay, run_time});
+    }
+  };
+}
+
+// static
+void MessageLoop::RunTasks() {
+  GetTaskQueue()->Drain();
+}
+
+// static
+void MessageLoop::RunTimers() {
+  TimerState* state = GetTimerState();
+  {
+    base::AutoLock auto_lock(state->lock);
+    int64_t now = state->GetCurrentTick();
+    for (auto& it : state->wheel.Advance(now)) {
+      state->unthrottled.erase(it.first);
+      state->expired.push_back(std::move(it));
+    }
+    state->scheduled_wakeup = -1;
+    UpdateTimer(now);
+    UpdateTimersPrecise();
+  }
+  // Run the timers one by one, since a timer may clear the others.
+  while (true) {
+    Task task;
+    {
+      base::AutoLock auto_lock(state->lock);
+      if (state->expired.empty())
+        break;
+      task = std::move(state->expired.front().second);
+      state->expired.pop_front();
+    }
+    NU_TRACE_EVENT("loop", "MessageLoop::RunTimer");
+    task();
+  }
+}
+
+// static
+void MessageLoop::UpdateTimer(int64_t now) {
+  TimerState* state = GetTimerState();
+  state->lock.AssertAcquired();
+  int64_t wakeup = state->wheel.GetNextWakeup();
+  // The virtual clock is moved manually.
+  if (wakeup < 0 || state->virtual_tick >= 0)
+    return;
+  // The OS timer is only re-armed when the next wakeup becomes earlier.
+  if (state->scheduled_wakeup >= 0 && state->scheduled_wakeup <= wakeup)
+    return;
+  state->scheduled_wakeup = wakeup;
+  ScheduleTimer(static_cast<int>(std::max<int64_t>(wakeup - now, 0)));
+}
+
+// static
+void MessageLoop::UpdateTimersPrecise() {
+  TimerState* state = GetTimerState();
+  state->lock.AssertAcquired();
+  bool precise = state->alignment > 0 && !state->unthrottled.empty();
+  if (precise == state->precise)
+    return;
+  state->precise = precise;
+  PlatformSetTimersPrecise(precise);
+}
+
+}  // namespace nu
@@ -5,24 +5,68 @@
 #ifndef NATIVEUI_MESSAGE_LOOP_H_
 #define NATIVEUI_MESSAGE_LOOP_H_
 
-#include <unordered_map>
+#include <stdint.h>
 
+#include <deque>
+#include <functional>
+#include <string>
+
+#include "base/location.h"
 #include "base/synchronization/lock.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
 
 // Communicate with the GUI message loop. All methods are thread-safe.
+//
+// Tasks posted with PostTask from any thread are kept in one lock-free queue,
+// and the message loop is only woken up once for each batch of tasks.
 class NATIVEUI_EXPORT MessageLoop {
  public:
   // Function type for tasks.
   using Task = std::function<void()>;
 
+  // Priority of posted tasks.
+  //
+  // UserBlocking tasks run before pending input and paint events, Normal tasks
+  // run after them, and Idle tasks only run when there is nothing else to do.
+  enum class Priority {
+    UserBlocking,
+    Normal,
+    Idle,
+  };
+
   // Control message loop.
+  //
+  // The |from_here| is where the task is posted, which is shown in the long
+  // tasks of MessageLoopStats.
   static void Run();
   static void Quit();
-  static void PostTask(Task task);
-  static void PostDelayedTask(int ms, Task task);
+  static void PostTask(
+      Task task,
+      const base::Location& from_here = base::Location::Current());
+  static void PostTask(
+      Priority priority,
+      Task task,
+      const base::Location& from_here = base::Location::Current());
+  static void PostDelayedTask(
+      int ms,
+      Task task,
+      const base::Location& from_here = base::Location::Current());
+
+  // Like PostDelayedTask but the task is not delayed by the background
+  // throttling of App, which should only be used when the timing matters.
+  static void PostUnthrottledDelayedTask(
+      int ms,
+      Task task,
+      const base::Location& from_here = base::Location::Current());
+
+  // Run |task| when there is no pending input or paint, the task receives the
+  // time in milliseconds it has until the next frame.
+  using IdleTask = std::function<void(double)>;
+  static void PostIdleTask(
+      IdleTask task,
+      const base::Location& from_here = base::Location::Current());
 
   // Internal: Cancellable timers.
 #if defined(OS_WIN)
@@ -30,17 +74,97 @@ class NATIVEUI_EXPORT MessageLoop {
 #elif defined(OS_LINUX) || defined(OS_MACOSX)
   using TimerId = unsigned int;
 #endif
-  static TimerId SetTimeout(int ms, Task task);
+  static TimerId SetTimeout(
+      int ms,
+      Task task,
+      const base::Location& from_here = base::Location::Current());
   static void ClearTimeout(TimerId id);
 
+  // Internal: Post tasks with the posting site described by bindings, which
+  // is usually a location in script.
+  static void PostTaskFrom(const std::string& posted_from,
+                           Priority priority,
+                           Task task);
+  static TimerId SetTimeoutFrom(const std::string& posted_from,
+                                int ms,
+                                Task task,
+                                bool throttled = true);
+  static void PostIdleTaskFrom(const std::string& posted_from, IdleTask task);
+
+  // Internal: Record that a frame has just been produced, which is used for
+  // computing the deadlines of idle tasks.
+  static void DidProduceFrame();
+
+  // Internal: Run |handler| in idle time after each produced frame, with the
+  // time in milliseconds it has until the next frame. This is used by the
+  // bindings to run garbage collection between frames, and should only be
+  // called in main thread.
+  static int AddFrameIdleHandler(IdleTask handler);
+  static void RemoveFrameIdleHandler(int id);
+
+  // Internal: Align the expirations of timers set after this to multiples of
+  // |ms|, so timers wake up together and at most once in |ms|. Unthrottled
+  // timers are not aligned, and 0 disables the alignment. This is called by
+  // App when entering and leaving background mode.
+  static void SetTimerAlignment(int ms);
+
+  // Internal: Drive timers with a virtual clock instead of the system clock,
+  // which makes benchmarks and tests deterministic on loaded machines. While
+  // enabled no OS timer is armed, and timers only expire when the clock is
+  // moved by AdvanceVirtualTime.
+  static void SetVirtualTimeEnabled(bool enabled);
+  static bool IsVirtualTimeEnabled();
+
+  // Internal: Move the virtual clock forward by |ms| and run the expired
+  // timers in place.
+  static void AdvanceVirtualTime(int ms);
+
  private:
 #if defined(OS_WIN)
   friend class TimerHost;
 #endif
 
+  // Record the queue delay and run time of |task| in MessageLoopStats, the
+  // queue delay is counted from |delay_ms| after now.
+  static Task InstrumentTask(Task task,
+                             const std::string& posted_from,
+                             int delay_ms);
+
+  // Return the time until the next frame.
+  static double GetIdleTimeRemaining();
+
+  // Run the handlers added by AddFrameIdleHandler.
+  static void RunFrameIdleHandlers();
+
+  // Post tasks with UserBlocking or Idle priority, implemented by each
+  // platform.
+  static void PlatformPostTask(Priority priority, Task task);
+
+  // Ask the message loop to call RunTasks, implemented by each platform and
+  // called from any thread. Returns false if the wakeup can not be scheduled.
+  static bool WakeupForTasks();
+  // Run all tasks posted with PostTask.
+  static void RunTasks();
+
+  // Arm the OS timer to call RunTimers after |ms|, replacing the previous one,
+  // implemented by each platform and called with the timer lock held.
+  static void ScheduleTimer(int ms);
+  // Run expired timeouts.
+  static void RunTimers();
+  // Arm the OS timer if the next wakeup of timer wheel has changed.
+  static void UpdateTimer(int64_t now);
+  // Keep unthrottled timers precise while timers are being aligned, by
+  // preventing system from throttling the process. Implemented by each
+  // platform and called with the timer lock held.
+  static void PlatformSetTimersPrecise(bool precise);
+  static void UpdateTimersPrecise();
+
 #if defined(OS_MACOSX)
+  static void AddIdleTask(Task task);
+  static void RunIdleTask();
+
   static base::Lock lock_;
-  static std::unordered_map<TimerId, Task> tasks_;
+  static std::deque<Task> idle_tasks_;
 #endif
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MessageLoop);
@@ -0,0 +1,15 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/message_loop_stats.h"
+
+namespace nu {
+
+MessageLoopStats::MessageLoopStats() {}
+
+MessageLoopStats::MessageLoopStats(const MessageLoopStats& other) = default;
+
+MessageLoopStats::~MessageLoopStats() {}
+
+}  // namespace nu
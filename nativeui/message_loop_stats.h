@@ -0,0 +1,49 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_MESSAGE_LOOP_STATS_H_
+#define NATIVEUI_MESSAGE_LOOP_STATS_H_
+
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Statistics about the tasks run by the message loop.
+struct NATIVEUI_EXPORT MessageLoopStats {
+  MessageLoopStats();
+  MessageLoopStats(const MessageLoopStats& other);
+  ~MessageLoopStats();
+
+  // A task that ran longer than the long task threshold.
+  struct LongTask {
+    // Where the task was posted.
+    std::string posted_from;
+    base::TimeDelta queue_delay;
+    base::TimeDelta run_time;
+  };
+
+  // Only the most recent long tasks are kept.
+  static const size_t kMaxLongTasks = 100;
+
+  // Number of tasks run.
+  int task_count = 0;
+
+  // The time between a task becoming ready and starting to run.
+  base::TimeDelta total_queue_delay;
+  base::TimeDelta max_queue_delay;
+
+  // The time spent in running tasks.
+  base::TimeDelta total_run_time;
+  base::TimeDelta max_run_time;
+
+  std::vector<LongTask> long_tasks;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_MESSAGE_LOOP_STATS_H_
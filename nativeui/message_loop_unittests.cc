@@ -2,6 +2,9 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <thread>
+#include <vector>
+
 #include "nativeui/nativeui.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -20,3 +23,129 @@ TEST_F(MessageLoopTest, PostTask) {
   });
   nu::MessageLoop::Run();
 }
+
+TEST_F(MessageLoopTest, PostTaskWithPriority) {
+  std::vector<nu::MessageLoop::Priority> order;
+  nu::MessageLoop::PostTask(nu::MessageLoop::Priority::Normal, [&]() {
+    order.push_back(nu::MessageLoop::Priority::Normal);
+  });
+  nu::MessageLoop::PostTask(nu::MessageLoop::Priority::Idle, [&]() {
+    order.push_back(nu::MessageLoop::Priority::Idle);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::PostTask(nu::MessageLoop::Priority::UserBlocking, [&]() {
+    order.push_back(nu::MessageLoop::Priority::UserBlocking);
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(order.size(), 3u);
+  EXPECT_EQ(order[0], nu::MessageLoop::Priority::UserBlocking);
+  EXPECT_EQ(order[1], nu::MessageLoop::Priority::Normal);
+  EXPECT_EQ(order[2], nu::MessageLoop::Priority::Idle);
+}
+
+TEST_F(MessageLoopTest, PostIdleTask) {
+  double remaining = -1;
+  nu::MessageLoop::PostIdleTask([&](double time_remaining) {
+    remaining = time_remaining;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_GE(remaining, 0);
+  EXPECT_LE(remaining, 50);
+}
+
+TEST_F(MessageLoopTest, FrameIdleHandler) {
+  int count = 0;
+  double remaining = -1;
+  int id = nu::MessageLoop::AddFrameIdleHandler([&](double time_remaining) {
+    ++count;
+    remaining = time_remaining;
+    nu::MessageLoop::Quit();
+  });
+  // Frames produced before the handlers run only post one task.
+  nu::MessageLoop::DidProduceFrame();
+  nu::MessageLoop::DidProduceFrame();
+  nu::MessageLoop::Run();
+  EXPECT_EQ(count, 1);
+  EXPECT_GT(remaining, 0);
+  EXPECT_LE(remaining, 50);
+  nu::MessageLoop::RemoveFrameIdleHandler(id);
+  nu::MessageLoop::DidProduceFrame();
+  nu::MessageLoop::PostIdleTask([](double) { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(count, 1);
+}
+
+TEST_F(MessageLoopTest, PostTaskFromThreads) {
+  const int kThreads = 4;
+  const int kTasks = 1000;
+  int count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < kTasks; ++j) {
+        nu::MessageLoop::PostTask([&]() {
+          if (++count == kThreads * kTasks)
+            nu::MessageLoop::Quit();
+        });
+      }
+    });
+  }
+  nu::MessageLoop::Run();
+  for (std::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ(count, kThreads * kTasks);
+}
+
+TEST_F(MessageLoopTest, SetTimeout) {
+  std::vector<int> order;
+  nu::MessageLoop::SetTimeout(30, [&]() {
+    order.push_back(30);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::TimerId id = nu::MessageLoop::SetTimeout(10, [&]() {
+    order.push_back(10);
+  });
+  nu::MessageLoop::SetTimeout(1, [&]() {
+    order.push_back(1);
+    nu::MessageLoop::ClearTimeout(id);
+  });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(order, std::vector<int>({1, 30}));
+}
+
+TEST_F(MessageLoopTest, VirtualTime) {
+  nu::MessageLoop::SetVirtualTimeEnabled(true);
+  std::vector<int> order;
+  nu::MessageLoop::SetTimeout(20, [&]() { order.push_back(20); });
+  nu::MessageLoop::SetTimeout(10, [&]() { order.push_back(10); });
+  nu::MessageLoop::AdvanceVirtualTime(5);
+  EXPECT_TRUE(order.empty());
+  nu::MessageLoop::AdvanceVirtualTime(5);
+  EXPECT_EQ(order, std::vector<int>({10}));
+  nu::MessageLoop::AdvanceVirtualTime(100);
+  EXPECT_EQ(order, std::vector<int>({10, 20}));
+  // Pending timers fire with the system clock after disabling.
+  nu::MessageLoop::SetTimeout(1, [&]() {
+    order.push_back(1);
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::SetVirtualTimeEnabled(false);
+  nu::MessageLoop::Run();
+  EXPECT_EQ(order, std::vector<int>({10, 20, 1}));
+}
+
+TEST_F(MessageLoopTest, Stats) {
+  state_.SetMessageLoopStatsEnabled(true);
+  state_.SetLongTaskThreshold(base::TimeDelta());
+  nu::MessageLoop::PostTask([]() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  const nu::MessageLoopStats& stats = state_.GetMessageLoopStats();
+  EXPECT_EQ(stats.task_count, 1);
+  ASSERT_EQ(stats.long_tasks.size(), 1u);
+  EXPECT_FALSE(stats.long_tasks[0].posted_from.empty());
+  state_.ResetMessageLoopStats();
+  EXPECT_EQ(state_.GetMessageLoopStats().task_count, 0);
+}
@@ -6,11 +6,12 @@
 #define NATIVEUI_NATIVEUI_H_
 
 #include "nativeui/app.h"
-#include "nativeui/browser.h"
+#include "nativeui/async_layout.h"
 #include "nativeui/button.h"
 #include "nativeui/combo_box.h"
 #include "nativeui/cursor.h"
 #include "nativeui/entry.h"
+#include "nativeui/event_recorder.h"
 #include "nativeui/events/event.h"
 #include "nativeui/events/keyboard_code_conversion.h"
 #include "nativeui/events/keyboard_codes.h"
@@ -18,13 +19,18 @@
 #include "nativeui/file_save_dialog.h"
 #include "nativeui/gfx/attributed_text.h"
 #include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/display_list.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/gfx/geometry/insets.h"
 #include "nativeui/gfx/image.h"
+#include "nativeui/gfx/image_cache.h"
+#include "nativeui/gfx/monospace_text_renderer.h"
 #include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/path.h"
 #include "nativeui/gif_player.h"
 #include "nativeui/group.h"
 #include "nativeui/label.h"
+#include "nativeui/layout_transaction.h"
 #include "nativeui/lifetime.h"
 #include "nativeui/menu.h"
 #include "nativeui/menu_bar.h"
@@ -33,16 +39,24 @@
 #include "nativeui/message_loop.h"
 #include "nativeui/progress_bar.h"
 #include "nativeui/protocol_asar_job.h"
+#include "nativeui/render_thread.h"
 #include "nativeui/screen.h"
 #include "nativeui/scroll.h"
 #include "nativeui/separator.h"
 #include "nativeui/slider.h"
 #include "nativeui/state.h"
+#include "nativeui/style_sheet.h"
 #include "nativeui/tab.h"
 #include "nativeui/table.h"
 #include "nativeui/table_model.h"
+#include "nativeui/table_model_view.h"
 #include "nativeui/text_edit.h"
+#include "nativeui/trace_event.h"
 #include "nativeui/tray.h"
+#include "nativeui/tree_model.h"
+#include "nativeui/tree_view.h"
+#include "nativeui/view_template.h"
+#include "nativeui/virtual_list.h"
 #include "nativeui/window.h"
 
 #if defined(OS_MACOSX)
@@ -50,4 +64,8 @@
 #include "nativeui/vibrant.h"
 #endif
 
+#if defined(BROWSER_SUPPORT)
+#include "nativeui/browser.h"
+#endif
+
 #endif  // NATIVEUI_NATIVEUI_H_
@@ -0,0 +1,141 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/paint_stats.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/values.h"
+#include "nativeui/state.h"
+#include "nativeui/view.h"
+#include "nativeui/window.h"
+
+namespace nu {
+
+namespace {
+
+// Create an event of the Trace Event Format.
+base::Value CreateTraceEvent(const char* name, const char* phase, int tid) {
+  base::Value event(base::Value::Type::DICTIONARY);
+  event.SetKey("name", base::Value(name));
+  event.SetKey("ph", base::Value(phase));
+  event.SetKey("pid", base::Value(1));
+  event.SetKey("tid", base::Value(tid));
+  return event;
+}
+
+}  // namespace
+
+PaintStats::PaintStats() {}
+
+PaintStats::PaintStats(const PaintStats& other) = default;
+
+PaintStats::~PaintStats() {}
+
+PaintStats::Record::Record() {}
+
+PaintStats::Record::Record(const Record& other) = default;
+
+PaintStats::Record::~Record() {}
+
+std::string PaintStats::ToTraceJSON() const {
+  base::Value::ListStorage events;
+  // Each window is assigned a thread ID in the order of appearance.
+  std::map<std::string, int> threads;
+  for (const Record& record : records) {
+    int tid;
+    auto it = threads.find(record.window_title);
+    if (it == threads.end()) {
+      tid = static_cast<int>(threads.size()) + 1;
+      threads[record.window_title] = tid;
+      base::Value metadata = CreateTraceEvent("thread_name", "M", tid);
+      base::Value args(base::Value::Type::DICTIONARY);
+      args.SetKey("name", base::Value(record.window_title));
+      metadata.SetKey("args", std::move(args));
+      events.push_back(std::move(metadata));
+    } else {
+      tid = it->second;
+    }
+
+    base::Value event = CreateTraceEvent("Paint", "X", tid);
+    event.SetKey("cat", base::Value("nativeui"));
+    event.SetKey("ts", base::Value(
+        (record.start - base::TimeTicks()).InMicrosecondsF()));
+    event.SetKey("dur", base::Value(record.duration.InMicrosecondsF()));
+    base::Value views(base::Value::Type::DICTIONARY);
+    for (const auto& view : record.views)
+      views.SetKey(view.first, base::Value(view.second));
+    base::Value args(base::Value::Type::DICTIONARY);
+    args.SetKey("dirtyArea", base::Value(record.dirty_area));
+    args.SetKey("viewsDrawn", base::Value(record.views_drawn));
+    args.SetKey("views", std::move(views));
+    args.SetKey("onDrawCount", base::Value(record.on_draw_count));
+    args.SetKey("onDrawTime",
+                base::Value(record.on_draw_duration.InMillisecondsF()));
+    event.SetKey("args", std::move(args));
+    events.push_back(std::move(event));
+  }
+
+  base::Value trace(base::Value::Type::DICTIONARY);
+  trace.SetKey("traceEvents", base::Value(std::move(events)));
+  trace.SetKey("displayTimeUnit", base::Value("ms"));
+  std::string json;
+  base::JSONWriter::Write(trace, &json);
+  return json;
+}
+
+ScopedPaintTimer::ScopedPaintTimer(Window* window, const Rect& dirty)
+    : previous_(nullptr),
+      enabled_(State::GetCurrent()->IsPaintStatsEnabled()) {
+  if (!enabled_)
+    return;
+  State* state = State::GetCurrent();
+  previous_ = state->paint_timer();
+  state->paint_timer() = this;
+  if (window)
+    record_.window_title = window->GetTitle();
+  record_.dirty_area = dirty.width() * dirty.height();
+  record_.start = base::TimeTicks::Now();
+}
+
+ScopedPaintTimer::~ScopedPaintTimer() {
+  if (!enabled_)
+    return;
+  record_.duration = base::TimeTicks::Now() - record_.start;
+  State* state = State::GetCurrent();
+  state->paint_timer() = previous_;
+  PaintStats* stats = state->paint_stats();
+  stats->paint_count++;
+  stats->total_duration += record_.duration;
+  stats->max_duration = std::max(stats->max_duration, record_.duration);
+  if (stats->records.size() >= PaintStats::kMaxRecords)
+    stats->records.erase(stats->records.begin());
+  stats->records.push_back(std::move(record_));
+}
+
+// static
+void ScopedPaintTimer::CountView(View* view) {
+  ScopedPaintTimer* timer = State::GetCurrent()->paint_timer();
+  if (!timer)
+    return;
+  timer->record_.views_drawn++;
+  timer->record_.views[view->GetClassName()]++;
+}
+
+ScopedDrawHandlerTimer::ScopedDrawHandlerTimer()
+    : timer_(State::GetCurrent()->paint_timer()) {
+  if (timer_)
+    start_ = base::TimeTicks::Now();
+}
+
+ScopedDrawHandlerTimer::~ScopedDrawHandlerTimer() {
+  if (!timer_)
+    return;
+  timer_->record_.on_draw_count++;
+  timer_->record_.on_draw_duration += base::TimeTicks::Now() - start_;
+}
+
+}  // namespace nu
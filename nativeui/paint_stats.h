@@ -0,0 +1,95 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_PAINT_STATS_H_
+#define NATIVEUI_PAINT_STATS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "nativeui/gfx/geometry/rect.h"
+#include "nativeui/nativeui_export.h"
+#include "nativeui/startup_stats.h"
+
+namespace nu {
+
+class View;
+class Window;
+
+// Statistics about the paints of windows.
+struct NATIVEUI_EXPORT PaintStats {
+  PaintStats();
+  PaintStats(const PaintStats& other);
+  ~PaintStats();
+
+  // One paint of a window.
+  struct NATIVEUI_EXPORT Record {
+    Record();
+    Record(const Record& other);
+    ~Record();
+
+    // The title of the painted window.
+    std::string window_title;
+    base::TimeTicks start;
+    base::TimeDelta duration;
+    // The dirty area in pixels.
+    int dirty_area = 0;
+    // Number of views drawn, and grouped by view class names.
+    int views_drawn = 0;
+    std::map<std::string, int> views;
+    // The time spent in the on_draw handlers.
+    int on_draw_count = 0;
+    base::TimeDelta on_draw_duration;
+  };
+
+  // Only the most recent records are kept.
+  static const size_t kMaxRecords = 500;
+
+  // Number of paints and the time spent in them.
+  int paint_count = 0;
+  base::TimeDelta total_duration;
+  base::TimeDelta max_duration;
+
+  std::vector<Record> records;
+
+  // Export the records in the Trace Event Format, which can be loaded in
+  // chrome://tracing, each window is shown as one thread.
+  std::string ToTraceJSON() const;
+};
+
+// Internal: Record the time spent in the scope as one paint of |window|.
+class NATIVEUI_EXPORT ScopedPaintTimer {
+ public:
+  // The |dirty| rect is in pixels.
+  ScopedPaintTimer(Window* window, const Rect& dirty);
+  ~ScopedPaintTimer();
+
+  // Count |view| as drawn in current paint.
+  static void CountView(View* view);
+
+ private:
+  friend class ScopedDrawHandlerTimer;
+
+  ScopedStartupPhase startup_phase_{StartupPhase::FirstPaint};
+  PaintStats::Record record_;
+  ScopedPaintTimer* previous_;
+  bool enabled_;
+};
+
+// Internal: Record the time spent in the scope as running on_draw handlers.
+class NATIVEUI_EXPORT ScopedDrawHandlerTimer {
+ public:
+  ScopedDrawHandlerTimer();
+  ~ScopedDrawHandlerTimer();
+
+ private:
+  base::TimeTicks start_;
+  ScopedPaintTimer* timer_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_PAINT_STATS_H_
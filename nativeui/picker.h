@@ -22,6 +22,9 @@ class NATIVEUI_EXPORT Picker : public View {
   // Note: After adding any new method, make sure it is also implemented in
   // ComboBox on macOS.
   virtual void AddItem(const std::string& text);
+  // Replace all items in one batch, which is much faster than adding items
+  // one by one.
+  virtual void SetItems(const std::vector<std::string>& items);
   virtual void RemoveItemAt(int index);
   virtual std::vector<std::string> GetItems() const;
   virtual void SelectItemAt(int index);
@@ -53,3 +53,16 @@ TEST_F(PickerTest, SelectItemShouldNotEmitEvent) {
   picker_->SelectItemAt(1);
   EXPECT_FALSE(emitted);
 }
+
+TEST_F(PickerTest, SetItems) {
+  picker_->AddItem("old");
+  bool emitted = false;
+  picker_->on_selection_change.Connect([&emitted](nu::Picker*) {
+    emitted = true;
+  });
+  picker_->SetItems({"item1", "item2", "item1"});
+  EXPECT_EQ(picker_->GetItems(),
+            std::vector<std::string>({"item1", "item2"}));
+  EXPECT_EQ(picker_->GetSelectedItemIndex(), 0);
+  EXPECT_FALSE(emitted);
+}
@@ -4,10 +4,19 @@
 
 #include "nativeui/protocol_asar_job.h"
 
+#include <inttypes.h>
 #include <string.h>
 
+#include <algorithm>
+#include <utility>
+
 #include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/threading/platform_thread.h"
 #include "nativeui/asar_archive.h"
+#include "nativeui/trace_event.h"
+#include "nativeui/util/lz4.h"
 
 namespace nu {
 
@@ -16,6 +25,72 @@ namespace {
 // The old asar extension name.
 const base::FilePath::CharType kOldAsarExt[] = FILE_PATH_LITERAL(".asar");
 
+// Encrypted files not larger than this are decrypted at once when started,
+// larger ones are decrypted while reading.
+const size_t kMaxDecryptedInMemory = 32 * 1024 * 1024;
+
+// Compressed files not larger than this are decompressed at once when started,
+// larger ones are decompressed block by block while reading.
+const size_t kMaxDecompressedInMemory = 32 * 1024 * 1024;
+
+// Each compressed block is prefixed with its size in 4 bytes of little endian,
+// and the highest bit is set when the block is stored without compression.
+const size_t kBlockHeaderSize = 4;
+const uint32_t kBlockUncompressed = 0x80000000;
+
+// The smallest slice of data to decrypt in one thread.
+const size_t kMinDecryptSlice = 512 * 1024;
+
+class DecryptThread : public base::PlatformThread::Delegate {
+ public:
+  DecryptThread(const AES& aes, uint8_t* buf, size_t len)
+      : aes_(aes), buf_(buf), len_(len) {}
+
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override {
+    aes_.CBCDecryptBuffer(buf_, static_cast<uint32_t>(len_));
+  }
+
+ private:
+  AES aes_;
+  uint8_t* buf_;
+  size_t len_;
+};
+
+// Decrypt |buf| in slices on multiple threads, which works because in CBC
+// mode each block only depends on itself and the cipher block before it.
+void ParallelCBCDecrypt(const AES& aes, uint8_t* buf, size_t len) {
+  size_t count = std::min(
+      static_cast<size_t>(base::SysInfo::NumberOfProcessors()),
+      len / kMinDecryptSlice);
+  if (count <= 1) {
+    AES(aes).CBCDecryptBuffer(buf, static_cast<uint32_t>(len));
+    return;
+  }
+  size_t slice = len / count / AES_BLOCKLEN * AES_BLOCKLEN;
+  // The IVs must be taken before any slice gets decrypted in place.
+  std::vector<std::unique_ptr<DecryptThread>> threads;
+  for (size_t i = 1; i < count; ++i) {
+    size_t start = i * slice;
+    AES slice_aes(aes);
+    slice_aes.SetIV(buf + start - AES_BLOCKLEN);
+    threads.emplace_back(new DecryptThread(
+        slice_aes, buf + start, i == count - 1 ? len - start : slice));
+  }
+  std::vector<base::PlatformThreadHandle> handles(threads.size());
+  for (size_t i = 0; i < threads.size(); ++i) {
+    if (!base::PlatformThread::Create(0, threads[i].get(), &handles[i])) {
+      threads[i]->ThreadMain();
+      handles[i] = base::PlatformThreadHandle();
+    }
+  }
+  AES(aes).CBCDecryptBuffer(buf, static_cast<uint32_t>(slice));
+  for (base::PlatformThreadHandle& handle : handles) {
+    if (!handle.is_null())
+      base::PlatformThread::Join(handle);
+  }
+}
+
 }  // namespace
 
 ProtocolAsarJob::ProtocolAsarJob(const base::FilePath& asar,
@@ -25,97 +100,324 @@ ProtocolAsarJob::ProtocolAsarJob(const base::FilePath& asar,
   if (!file_.IsValid())
     return;
 
-  // Read asar.
-  AsarArchive archive(file_.Duplicate(), !asar.MatchesExtension(kOldAsarExt));
-  AsarArchive::FileInfo info;
-  if (!archive.IsValid() ||
-      !archive.GetFileInfo(path, &info)) {
+  // Read asar, the index of archive is shared by all jobs.
+  scoped_refptr<AsarArchive> archive =
+      AsarArchive::Open(asar, !asar.MatchesExtension(kOldAsarExt));
+  if (!archive || !archive->IsValid() ||
+      !archive->GetFileInfo(path, &info_)) {
     file_.Close();
     return;
   }
 
-  // Seek to the position of the path.
-  file_.Seek(base::File::FROM_BEGIN, info.offset);
   path_ = base::FilePath::FromUTF8Unsafe(path);
-  content_length_ = info.size;
+  size_ = info_.compressed ? info_.decompressed_size : info_.size;
+  content_length_ = size_;
+
+  // Read from the archive's mapping so reading does not need system calls,
+  // fallback to reading the file if failed.
+  if (info_.size > 0) {
+    base::StringPiece mapping = archive->AcquireMapping();
+    if (mapping.data()) {
+      archive_ = std::move(archive);
+      // Written this way so crafted offsets can not overflow the check.
+      if (info_.offset <= mapping.size() &&
+          info_.size <= mapping.size() - info_.offset)
+        mapped_ = reinterpret_cast<const uint8_t*>(mapping.data()) +
+                  info_.offset;
+    }
+  }
 }
 
 ProtocolAsarJob::~ProtocolAsarJob() {
+  if (archive_)
+    archive_->ReleaseMapping();
 }
 
 bool ProtocolAsarJob::SetDecipher(const std::string& key,
                                   const std::string& iv) {
-  return aes_.Init(key, iv);
+  if (!aes_.Init(key, iv))
+    return false;
+  iv_ = iv;
+  return true;
 }
 
 bool ProtocolAsarJob::Start() {
-  if (!aes_.IsValid())
-    return ProtocolFileJob::Start();
   if (!file_.IsValid())
     return false;
-  // Don't pass content length when stream is encrypted, since the decrypted
-  // size might be smaller.
-  notify_content_length(-1);
+  stored_size_ = info_.size;
+  if (aes_.IsValid() && !StartDecryption())
+    return false;
+  if (info_.compressed && !StartDecompression())
+    return false;
+  content_length_ = size_ - pos_;
+  notify_content_length(static_cast<int>(content_length_));
   return true;
 }
 
+void ProtocolAsarJob::Kill() {
+  ProtocolFileJob::Kill();
+  // The mapped memory may still be used by browser, so only stop reading.
+  content_length_ = 0;
+}
+
 size_t ProtocolAsarJob::Read(void* buf, size_t buf_size) {
+  NU_TRACE_EVENT("protocol", "ProtocolAsarJob::Read");
+  if (info_.compressed)
+    return ReadDecompressed(buf, buf_size);
+  if (aes_.IsValid())
+    return ReadDecrypted(buf, buf_size);
+  size_t size = static_cast<size_t>(
+      std::min(static_cast<int64_t>(buf_size), content_length_));
+  size_t nread = size > 0 ? ReadRaw(pos_, buf, size) : 0;
+  pos_ += nread;
+  content_length_ = nread == size ? content_length_ - nread : 0;
+  return nread;
+}
+
+bool ProtocolAsarJob::GetContent(base::StringPiece* content) {
+  if (decompressed_in_memory_) {
+    *content = decompressed_;
+    return true;
+  }
+  // Large compressed content must be decompressed by reading.
+  if (info_.compressed)
+    return false;
+  if (decrypted_in_memory_) {
+    *content = decrypted_;
+    return true;
+  }
+  // Large encrypted content must be decrypted by reading.
+  if (aes_.IsValid() || !mapped_)
+    return false;
+  *content = base::StringPiece(reinterpret_cast<const char*>(mapped_),
+                               info_.size);
+  return true;
+}
+
+bool ProtocolAsarJob::Seek(int64_t offset) {
+  if (offset < 0 || static_cast<uint64_t>(offset) > size_)
+    return false;
+  pos_ = offset;
+  content_length_ = size_ - offset;
+  return true;
+}
+
+bool ProtocolAsarJob::GetETag(std::string* etag) {
+  // The archive's tag with the entry's position.
+  std::string archive_etag;
+  if (!ProtocolFileJob::GetETag(&archive_etag))
+    return false;
+  archive_etag.pop_back();
+  *etag = base::StringPrintf("%s-%" PRIx64 "-%x\"", archive_etag.c_str(),
+                             info_.offset, info_.size);
+  return true;
+}
+
+size_t ProtocolAsarJob::ReadRaw(uint64_t pos, void* buf, size_t size) {
+  if (mapped_) {
+    memcpy(buf, mapped_ + pos, size);
+    return size;
+  }
+  if (!file_.IsValid())
+    return 0;
+  int nread = file_.Read(info_.offset + pos, static_cast<char*>(buf),
+                         static_cast<int>(size));
+  return nread > 0 ? nread : 0;
+}
+
+size_t ProtocolAsarJob::ReadStored(uint64_t pos, void* buf, size_t size) {
   if (!aes_.IsValid())
-    return ProtocolFileJob::Read(buf, buf_size);
-
-  if (buf_size < remaining_)
-    return 0;  // this is unlikely to happen
-
-  // Read as much as we can.
-  size_t nread = ProtocolFileJob::Read(static_cast<char*>(buf) + remaining_,
-                                       buf_size - remaining_);
-  if (nread == 0) {
-    if (remaining_ != 0) {
-      LOG(ERROR) << "The encrypted stream stored in asar is not aligned to "
-                 << AES_BLOCKLEN << "bytes";
+    return ReadRaw(pos, buf, size);
+  if (decrypted_in_memory_) {
+    memcpy(buf, decrypted_.data() + pos, size);
+    return size;
+  }
+
+  // Decrypt the blocks covering the range, directly in |buf| if possible.
+  uint64_t start = pos - pos % AES_BLOCKLEN;
+  size_t skip = static_cast<size_t>(pos - start);
+  size_t len = (skip + size + AES_BLOCKLEN - 1) / AES_BLOCKLEN * AES_BLOCKLEN;
+  uint8_t* data = static_cast<uint8_t*>(buf);
+  if (skip > 0 || len > size) {
+    scratch_.resize(len);
+    data = scratch_.data();
+  }
+  if (ReadRaw(start, data, len) != len)
+    return 0;
+  DecryptBlocks(start, data, len);
+  if (data != buf)
+    memcpy(buf, data + skip, size);
+  return size;
+}
+
+bool ProtocolAsarJob::StartDecryption() {
+  if (stored_size_ == 0 || stored_size_ % AES_BLOCKLEN != 0) {
+    LOG(ERROR) << "The encrypted stream stored in asar is not aligned to "
+               << AES_BLOCKLEN << "bytes";
+    return false;
+  }
+  // Only the last block is needed to know the padding, so the size of large
+  // files can be known without decrypting all of them.
+  uint8_t last[AES_BLOCKLEN];
+  const uint8_t* block = last;
+  if (stored_size_ <= kMaxDecryptedInMemory) {
+    decrypted_.resize(stored_size_);
+    uint8_t* data = reinterpret_cast<uint8_t*>(&decrypted_[0]);
+    if (ReadRaw(0, data, stored_size_) != stored_size_)
+      return false;
+    DecryptBlocks(0, data, stored_size_);
+    block = data + stored_size_ - AES_BLOCKLEN;
+  } else {
+    uint64_t pos = stored_size_ - AES_BLOCKLEN;
+    if (ReadRaw(pos, last, AES_BLOCKLEN) != AES_BLOCKLEN)
+      return false;
+    DecryptBlocks(pos, last, AES_BLOCKLEN);
+  }
+  // We should probably do some verification, but we don't really care when
+  // the encryption is corrupted.
+  size_t paddings = block[AES_BLOCKLEN - 1];
+  if (paddings == 0 || paddings > AES_BLOCKLEN) {
+    LOG(ERROR) << "The encrypted stream stored in asar has corrupted padding";
+    return false;
+  }
+  stored_size_ -= paddings;
+  if (!info_.compressed)
+    size_ = stored_size_;
+  if (stored_size_ <= kMaxDecryptedInMemory) {
+    decrypted_.resize(stored_size_);
+    decrypted_in_memory_ = true;
+  }
+  return true;
+}
+
+size_t ProtocolAsarJob::ReadDecrypted(void* buf, size_t buf_size) {
+  size_t size = static_cast<size_t>(
+      std::min(static_cast<int64_t>(buf_size), content_length_));
+  if (size == 0)
+    return 0;
+
+  // End the read at a block boundary, so the next read does not have to
+  // decrypt the same block again.
+  if (!decrypted_in_memory_ && size > AES_BLOCKLEN &&
+      static_cast<int64_t>(size) < content_length_)
+    size -= (pos_ + size) % AES_BLOCKLEN;
+
+  if (ReadStored(pos_, buf, size) != size) {
+    content_length_ = 0;
+    return 0;
+  }
+  pos_ += size;
+  content_length_ -= size;
+  return size;
+}
+
+void ProtocolAsarJob::DecryptBlocks(uint64_t pos, uint8_t* buf, size_t len) {
+  // The IV of a block is the cipher block before it.
+  uint8_t iv[AES_BLOCKLEN];
+  if (pos == 0)
+    memcpy(iv, iv_.data(), AES_BLOCKLEN);
+  else if (ReadRaw(pos - AES_BLOCKLEN, iv, AES_BLOCKLEN) != AES_BLOCKLEN)
+    memset(iv, 0, AES_BLOCKLEN);
+  aes_.SetIV(iv);
+  ParallelCBCDecrypt(aes_, buf, len);
+}
+
+bool ProtocolAsarJob::StartDecompression() {
+  // Walk through the headers of blocks, so any block can be found directly
+  // when seeking.
+  uint64_t pos = 0;
+  while (pos < stored_size_) {
+    uint8_t header[kBlockHeaderSize];
+    if (stored_size_ - pos < kBlockHeaderSize ||
+        ReadStored(pos, header, kBlockHeaderSize) != kBlockHeaderSize)
+      break;
+    uint32_t value = header[0] | (header[1] << 8) | (header[2] << 16) |
+                     (static_cast<uint32_t>(header[3]) << 24);
+    block_offsets_.push_back(pos);
+    block_headers_.push_back(value);
+    pos += kBlockHeaderSize + (value & ~kBlockUncompressed);
+  }
+  size_t blocks = (static_cast<size_t>(info_.decompressed_size) +
+                   info_.block_size - 1) / info_.block_size;
+  if (pos != stored_size_ || block_offsets_.size() != blocks) {
+    LOG(ERROR) << "The compressed stream stored in asar is corrupted";
+    return false;
+  }
+  if (size_ <= kMaxDecompressedInMemory) {
+    decompressed_.resize(size_);
+    uint8_t* data = reinterpret_cast<uint8_t*>(&decompressed_[0]);
+    for (size_t i = 0; i < blocks; ++i) {
+      if (!DecompressBlock(i, data + i * info_.block_size, GetBlockSize(i)))
+        return false;
     }
+    decompressed_in_memory_ = true;
+    // The decrypted data is no longer needed.
+    std::string().swap(decrypted_);
+    decrypted_in_memory_ = false;
+  }
+  return true;
+}
+
+size_t ProtocolAsarJob::ReadDecompressed(void* buf, size_t buf_size) {
+  size_t size = static_cast<size_t>(
+      std::min(static_cast<int64_t>(buf_size), content_length_));
+  if (size == 0)
     return 0;
+  if (decompressed_in_memory_) {
+    memcpy(buf, decompressed_.data() + pos_, size);
+    pos_ += size;
+    content_length_ -= size;
+    return size;
+  }
+
+  // Keep the block being read, so small reads do not decompress it again.
+  size_t index = static_cast<size_t>(pos_ / info_.block_size);
+  if (index != block_index_) {
+    block_index_ = index;
+    block_.resize(GetBlockSize(index));
+    if (!DecompressBlock(index, block_.data(), block_.size())) {
+      block_index_ = static_cast<size_t>(-1);
+      content_length_ = 0;
+      return 0;
+    }
   }
+  size_t skip = static_cast<size_t>(pos_ - index * info_.block_size);
+  size = std::min(size, block_.size() - skip);
+  memcpy(buf, block_.data() + skip, size);
+  pos_ += size;
+  content_length_ -= size;
+  return size;
+}
+
+bool ProtocolAsarJob::DecompressBlock(size_t index, uint8_t* buf,
+                                      size_t size) {
+  uint64_t pos = block_offsets_[index] + kBlockHeaderSize;
+  uint32_t header = block_headers_[index];
+  size_t stored = header & ~kBlockUncompressed;
+  // Read the block from mapped memory directly when possible.
+  const uint8_t* data;
+  if (!aes_.IsValid() && mapped_) {
+    data = mapped_ + pos;
+  } else {
+    compressed_block_.resize(stored);
+    if (ReadStored(pos, compressed_block_.data(), stored) != stored)
+      return false;
+    data = compressed_block_.data();
+  }
+  if (header & kBlockUncompressed) {
+    if (stored != size)
+      return false;
+    memcpy(buf, data, size);
+    return true;
+  }
+  return LZ4DecompressBlock(data, stored, buf, size) ==
+         static_cast<int>(size);
+}
 
-  // Put the remaining data of last read into buf, as if it was read this time.
-  if (remaining_ > 0) {
-    memcpy(buf, buffer_, remaining_);
-    nread += remaining_;
-  }
-
-  // Handle the data in alignment of 16 bytes.
-  uint8_t* in = static_cast<uint8_t*>(buf);
-  uint8_t* out = static_cast<uint8_t*>(buf);
-  remaining_ = nread;
-  while (remaining_ >= AES_BLOCKLEN) {
-    // Fill buffer with 16 bytes and move pointers forward.
-    memcpy(buffer_, in, AES_BLOCKLEN);
-    in += AES_BLOCKLEN;
-    remaining_ -= AES_BLOCKLEN;
-    // Write to output buffer with decrypted data.
-    aes_.CBCDecryptBuffer(buffer_, AES_BLOCKLEN);
-    memcpy(out, buffer_, AES_BLOCKLEN);
-    out += AES_BLOCKLEN;
-  }
-
-  // Determine the padding when all data has been read.
-  if (content_length_ == 0) {
-    int paddings = buffer_[AES_BLOCKLEN - 1];
-    if (nread < paddings + remaining_)
-      return 0;  // likely a corrupted padding value
-    // We should probably do some verification, but we don't really care when
-    // the encryption is corrupted.
-    nread -= paddings;
-  }
-
-  // Still have some data left, leave it to the next read.
-  DCHECK(remaining_ < AES_BLOCKLEN);
-  memcpy(buffer_, in, remaining_);
-
-  // Return the bytes we decrypted.
-  // FIXME(zcbenz): The stream would end when we can not get 16 bytes in one
-  // read, we should probably improve our API to fix this.
-  return nread - remaining_;
+size_t ProtocolAsarJob::GetBlockSize(size_t index) const {
+  uint64_t start = static_cast<uint64_t>(index) * info_.block_size;
+  return static_cast<size_t>(
+      std::min<uint64_t>(info_.block_size, size_ - start));
 }
 
 }  // namespace nu
@@ -6,14 +6,14 @@
 #define NATIVEUI_PROTOCOL_ASAR_JOB_H_
 
 #include <string>
+#include <vector>
 
+#include "nativeui/asar_archive.h"
 #include "nativeui/protocol_file_job.h"
 #include "nativeui/util/aes.h"
 
 namespace nu {
 
-class AES;
-
 class NATIVEUI_EXPORT ProtocolAsarJob : public ProtocolFileJob {
  public:
   ProtocolAsarJob(const base::FilePath& asar, const std::string& path);
@@ -25,13 +25,79 @@ class NATIVEUI_EXPORT ProtocolAsarJob : public ProtocolFileJob {
 
   // ProtocolJob:
   bool Start() override;
+  void Kill() override;
   size_t Read(void* buf, size_t buf_size) override;
+  bool GetContent(base::StringPiece* content) override;
+  bool Seek(int64_t offset) override;
+  bool GetETag(std::string* etag) override;
+
+  // Read |size| bytes at |pos| of the file inside archive, from the mapped
+  // memory when possible.
+  size_t ReadRaw(uint64_t pos, void* buf, size_t size);
+
+  // Read |size| bytes at |pos| of the stored data, which is decrypted for
+  // encrypted files.
+  size_t ReadStored(uint64_t pos, void* buf, size_t size);
+
+  // Compute the size of decrypted data, and decrypt small files at once.
+  bool StartDecryption();
+
+  // Decrypt the content starting from |pos|, which can be any position.
+  size_t ReadDecrypted(void* buf, size_t size);
+
+  // Decrypt |len| bytes of cipher text in |buf| that was read at |pos|, which
+  // must be aligned to blocks.
+  void DecryptBlocks(uint64_t pos, uint8_t* buf, size_t len);
+
+  // Find the compressed blocks, and decompress small files at once.
+  bool StartDecompression();
+
+  // Decompress the content starting from |pos|, which can be any position.
+  size_t ReadDecompressed(void* buf, size_t size);
+
+  // Decompress the block at |index| into |buf| of |size| bytes.
+  bool DecompressBlock(size_t index, uint8_t* buf, size_t size);
+
+  // Return the size of the block at |index| after decompression.
+  size_t GetBlockSize(size_t index) const;
+
+  AsarArchive::FileInfo info_;
+
+  // The archive whose mapping is acquired, and the content of the file inside
+  // the mapping.
+  scoped_refptr<AsarArchive> archive_;
+  const uint8_t* mapped_ = nullptr;
+
+  // The reading position, which is in the decrypted and decompressed content,
+  // the |content_length_| is the size left to read.
+  uint64_t pos_ = 0;
+  uint64_t size_ = 0;
+
+  // The size of stored data after decryption.
+  uint64_t stored_size_ = 0;
 
   AES aes_;
+  std::string iv_;
+
+  // The whole decrypted data of small files.
+  bool decrypted_in_memory_ = false;
+  std::string decrypted_;
+
+  // Used for decrypting blocks that do not fit in the reading buffer.
+  std::vector<uint8_t> scratch_;
+
+  // The position and header of each compressed block in the stored data.
+  std::vector<uint64_t> block_offsets_;
+  std::vector<uint32_t> block_headers_;
+
+  // The whole decompressed content of small files.
+  bool decompressed_in_memory_ = false;
+  std::string decompressed_;
 
-  // Buffer used to store remaining encrypted data.
-  uint8_t buffer_[AES_BLOCKLEN];
-  size_t remaining_ = 0;
+  // The last decompressed block of large files.
+  size_t block_index_ = static_cast<size_t>(-1);
+  std::vector<uint8_t> block_;
+  std::vector<uint8_t> compressed_block_;
 };
 
 }  // namespace nu
@@ -0,0 +1,216 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/protocol_asar_job.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/pickle.h"
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ProtocolAsarJobTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    path_ = dir_.GetPath().Append(FILE_PATH_LITERAL("test.asar"));
+  }
+
+  // Write an archive with a single "file" of |content|, the |fields| are
+  // appended to the file's node in header.
+  void WriteArchive(const std::string& content,
+                    const std::string& fields = "") {
+    base::Pickle header_pickle;
+    header_pickle.WriteString(base::StringPrintf(
+        "{\"files\":{\"file\":{\"size\":%d,\"offset\":\"0\"%s}}}",
+        static_cast<int>(content.size()), fields.c_str()));
+    base::Pickle size_pickle;
+    size_pickle.WriteUInt32(static_cast<uint32_t>(header_pickle.size()));
+    std::string data(static_cast<const char*>(size_pickle.data()),
+                     size_pickle.size());
+    data.append(static_cast<const char*>(header_pickle.data()),
+                header_pickle.size());
+    data += content;
+    int size = static_cast<int>(data.size());
+    ASSERT_EQ(base::WriteFile(path_, data.data(), size), size);
+  }
+
+  // Write |plain| encrypted with PKCS#7 padding.
+  void WriteEncryptedArchive(const std::string& plain,
+                             const std::string& fields = "") {
+    size_t paddings = AES_BLOCKLEN - plain.size() % AES_BLOCKLEN;
+    std::string data = plain + std::string(paddings, static_cast<char>(paddings));
+    nu::AES aes;
+    ASSERT_TRUE(aes.Init(key_, iv_));
+    aes.CBCEncryptBuffer(reinterpret_cast<uint8_t*>(&data[0]),
+                         static_cast<uint32_t>(data.size()));
+    WriteArchive(data, fields);
+  }
+
+  // Split |content| into LZ4 blocks of |block_size|, the even blocks are
+  // compressed as literals and the odd ones are stored uncompressed.
+  static std::string CompressContent(const std::string& content,
+                                     size_t block_size) {
+    std::string data;
+    for (size_t i = 0; i * block_size < content.size(); ++i) {
+      std::string block = content.substr(i * block_size, block_size);
+      uint32_t header;
+      if (i % 2 == 0) {
+        std::string compressed(1, '\xf0');
+        size_t length = block.size() - 15;
+        for (; length >= 255; length -= 255)
+          compressed.push_back('\xff');
+        compressed.push_back(static_cast<char>(length));
+        block = compressed + block;
+        header = static_cast<uint32_t>(block.size());
+      } else {
+        header = static_cast<uint32_t>(block.size()) | 0x80000000;
+      }
+      for (int j = 0; j < 4; ++j)
+        data.push_back(static_cast<char>(header >> (j * 8)));
+      data += block;
+    }
+    return data;
+  }
+
+  static std::string CompressionFields(const std::string& content,
+                                       size_t block_size) {
+    return base::StringPrintf(
+        ",\"compression\":{\"algorithm\":\"lz4\",\"size\":%d,"
+        "\"blockSize\":%d}",
+        static_cast<int>(content.size()), static_cast<int>(block_size));
+  }
+
+  scoped_refptr<nu::ProtocolJob> CreateJob(bool encrypted) {
+    scoped_refptr<nu::ProtocolAsarJob> job =
+        new nu::ProtocolAsarJob(path_, "file");
+    if (encrypted)
+      EXPECT_TRUE(job->SetDecipher(key_, iv_));
+    job->Plug([this](int size) { content_length_ = size; });
+    return job;
+  }
+
+  // Read all the content left in |job|.
+  std::string ReadAll(nu::ProtocolJob* job, size_t chunk) {
+    std::string result;
+    std::string buffer(chunk, 0);
+    size_t nread;
+    while ((nread = job->Read(&buffer[0], chunk)) > 0)
+      result.append(buffer.data(), nread);
+    return result;
+  }
+
+  // Return a string whose bytes are different from its neighbours.
+  static std::string CreateContent(size_t size) {
+    std::string content(size, 0);
+    for (size_t i = 0; i < size; ++i)
+      content[i] = static_cast<char>(i * 7 + i / 256);
+    return content;
+  }
+
+  base::ScopedTempDir dir_;
+  base::FilePath path_;
+  int content_length_ = -1;
+  std::string key_ = "0123456789abcdef";
+  std::string iv_ = "fedcba9876543210";
+};
+
+TEST_F(ProtocolAsarJobTest, Seek) {
+  std::string content = CreateContent(1000);
+  WriteArchive(content);
+  scoped_refptr<nu::ProtocolJob> job = CreateJob(false);
+  ASSERT_TRUE(job->Start());
+  EXPECT_EQ(content_length_, 1000);
+  EXPECT_FALSE(job->Seek(1001));
+  ASSERT_TRUE(job->Seek(999));
+  EXPECT_EQ(ReadAll(job.get(), 100), content.substr(999));
+  ASSERT_TRUE(job->Seek(123));
+  EXPECT_EQ(ReadAll(job.get(), 100), content.substr(123));
+}
+
+TEST_F(ProtocolAsarJobTest, Encrypted) {
+  std::string content = CreateContent(1000);
+  WriteEncryptedArchive(content);
+  scoped_refptr<nu::ProtocolJob> job = CreateJob(true);
+  ASSERT_TRUE(job->Start());
+  // The size of decrypted content is known before reading.
+  EXPECT_EQ(content_length_, 1000);
+  base::StringPiece in_memory;
+  ASSERT_TRUE(job->GetContent(&in_memory));
+  EXPECT_EQ(in_memory, content);
+  EXPECT_EQ(ReadAll(job.get(), 7), content);
+  ASSERT_TRUE(job->Seek(17));
+  EXPECT_EQ(ReadAll(job.get(), 33), content.substr(17));
+}
+
+TEST_F(ProtocolAsarJobTest, EncryptedLarge) {
+  // Large enough to be decrypted on multiple threads.
+  std::string content = CreateContent(4 * 1024 * 1024 + 5);
+  WriteEncryptedArchive(content);
+  scoped_refptr<nu::ProtocolJob> job = CreateJob(true);
+  ASSERT_TRUE(job->Start());
+  EXPECT_EQ(content_length_, static_cast<int>(content.size()));
+  ASSERT_TRUE(job->Seek(3 * 1024 * 1024 + 1));
+  EXPECT_EQ(ReadAll(job.get(), 4089), content.substr(3 * 1024 * 1024 + 1));
+}
+
+TEST_F(ProtocolAsarJobTest, ETag) {
+  WriteArchive("content");
+  scoped_refptr<nu::ProtocolJob> job = CreateJob(false);
+  ASSERT_TRUE(job->Start());
+  std::string etag;
+  ASSERT_TRUE(job->GetETag(&etag));
+  EXPECT_EQ(etag.front(), '"');
+  EXPECT_EQ(etag.back(), '"');
+  // The tag changes with the archive.
+  WriteArchive("changed");
+  base::Time time = base::Time::Now() + base::TimeDelta::FromHours(1);
+  ASSERT_TRUE(base::TouchFile(path_, time, time));
+  scoped_refptr<nu::ProtocolJob> changed = CreateJob(false);
+  ASSERT_TRUE(changed->Start());
+  std::string changed_etag;
+  ASSERT_TRUE(changed->GetETag(&changed_etag));
+  EXPECT_NE(etag, changed_etag);
+}
+
+TEST_F(ProtocolAsarJobTest, Compressed) {
+  std::string content = CreateContent(1000);
+  WriteArchive(CompressContent(content, 300), CompressionFields(content, 300));
+  scoped_refptr<nu::ProtocolJob> job = CreateJob(false);
+  ASSERT_TRUE(job->Start());
+  EXPECT_EQ(content_length_, 1000);
+  base::StringPiece in_memory;
+  ASSERT_TRUE(job->GetContent(&in_memory));
+  EXPECT_EQ(in_memory, content);
+  EXPECT_EQ(ReadAll(job.get(), 64), content);
+  ASSERT_TRUE(job->Seek(299));
+  EXPECT_EQ(ReadAll(job.get(), 64), content.substr(299));
+}
+
+TEST_F(ProtocolAsarJobTest, CompressedEncryptedLarge) {
+  // Large enough to be decompressed while reading.
+  std::string content = CreateContent(32 * 1024 * 1024 + 5);
+  size_t block_size = 64 * 1024;
+  WriteEncryptedArchive(CompressContent(content, block_size),
+                        CompressionFields(content, block_size));
+  scoped_refptr<nu::ProtocolJob> job = CreateJob(true);
+  ASSERT_TRUE(job->Start());
+  EXPECT_EQ(content_length_, static_cast<int>(content.size()));
+  base::StringPiece in_memory;
+  EXPECT_FALSE(job->GetContent(&in_memory));
+  size_t offset = 31 * 1024 * 1024 + 7;
+  ASSERT_TRUE(job->Seek(offset));
+  EXPECT_EQ(ReadAll(job.get(), 10000), content.substr(offset));
+}
+
+TEST_F(ProtocolAsarJobTest, CompressedCorrupted) {
+  std::string content = CreateContent(1000);
+  std::string data = CompressContent(content, 300);
+  WriteArchive(data.substr(0, data.size() - 1),
+               CompressionFields(content, 300));
+  scoped_refptr<nu::ProtocolJob> job = CreateJob(false);
+  EXPECT_FALSE(job->Start());
+}
@@ -0,0 +1,294 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/protocol_cache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/strings/string_util.h"
+
+namespace nu {
+
+namespace {
+
+base::LazyInstance<ProtocolCache>::Leaky g_protocol_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Serve a cached response.
+class ProtocolCachedJob : public ProtocolJob {
+ public:
+  explicit ProtocolCachedJob(scoped_refptr<ProtocolCache::Entry> entry)
+      : entry_(std::move(entry)) {
+    SetCacheControl(entry_->cache_control);
+  }
+
+  // ProtocolJob:
+  bool Start() override {
+    notify_content_length(static_cast<int>(entry_->content.size()));
+    return true;
+  }
+
+  bool GetMimeType(std::string* mime_type) override {
+    if (entry_->mime_type.empty())
+      return false;
+    *mime_type = entry_->mime_type;
+    return true;
+  }
+
+  size_t Read(void* buf, size_t buf_size) override {
+    size_t size = entry_->content.size();
+    if (pos_ == size || buf_size == 0)
+      return 0;
+    size_t nread = std::min(buf_size, size - pos_);
+    memcpy(buf, static_cast<char*>(entry_->content.content()) + pos_, nread);
+    pos_ += nread;
+    return nread;
+  }
+
+  bool GetContent(base::StringPiece* content) override {
+    *content = base::StringPiece(
+        static_cast<const char*>(entry_->content.content()),
+        entry_->content.size());
+    return true;
+  }
+
+  bool Seek(int64_t offset) override {
+    if (offset < 0 || offset > static_cast<int64_t>(entry_->content.size()))
+      return false;
+    pos_ = static_cast<size_t>(offset);
+    return true;
+  }
+
+  bool GetETag(std::string* etag) override {
+    if (entry_->etag.empty())
+      return false;
+    *etag = entry_->etag;
+    return true;
+  }
+
+ private:
+  ~ProtocolCachedJob() override {}
+
+  scoped_refptr<ProtocolCache::Entry> entry_;
+  size_t pos_ = 0;
+};
+
+// Forward to the job returned by handler, and store its response in cache
+// once the whole content is known.
+class ProtocolCachingJob : public ProtocolJob {
+ public:
+  ProtocolCachingJob(ProtocolCache* cache,
+                     const std::string& url,
+                     scoped_refptr<ProtocolJob> job)
+      : cache_(cache), url_(url), job_(std::move(job)) {}
+
+  // ProtocolJob:
+  bool Start() override {
+    job_->Plug([this](int size) {
+      SetCacheControl(job_->GetCacheControl());
+      if (size > 0 &&
+          static_cast<size_t>(size) <= ProtocolCache::kMaxEntrySize &&
+          ProtocolCache::IsCacheable(GetCacheControl())) {
+        // Content in memory can be stored directly, otherwise record the
+        // content while it is being read.
+        base::StringPiece content;
+        if (job_->GetContent(&content))
+          Store(content);
+        else
+          recording_ = true;
+      }
+      size_ = size;
+      notify_content_length(size);
+    });
+    return job_->Start();
+  }
+
+  void Kill() override {
+    recording_ = false;
+    job_->Kill();
+  }
+
+  bool GetMimeType(std::string* mime_type) override {
+    return job_->GetMimeType(mime_type);
+  }
+
+  size_t Read(void* buf, size_t buf_size) override {
+    size_t nread = job_->Read(buf, buf_size);
+    if (recording_) {
+      if (nread == 0) {
+        if (data_.size() == static_cast<size_t>(size_))
+          Store(data_);
+        recording_ = false;
+        data_.clear();
+      } else if (data_.size() + nread > static_cast<size_t>(size_)) {
+        recording_ = false;
+        data_.clear();
+      } else {
+        data_.append(static_cast<const char*>(buf), nread);
+      }
+    }
+    return nread;
+  }
+
+  bool MayBlock() const override {
+    return job_->MayBlock();
+  }
+
+  bool GetContent(base::StringPiece* content) override {
+    return job_->GetContent(content);
+  }
+
+  bool Seek(int64_t offset) override {
+    // Partial content is not recorded.
+    recording_ = false;
+    return job_->Seek(offset);
+  }
+
+  bool GetETag(std::string* etag) override {
+    return job_->GetETag(etag);
+  }
+
+ private:
+  ~ProtocolCachingJob() override {}
+
+  void Store(base::StringPiece content) {
+    void* copy = malloc(content.size());
+    memcpy(copy, content.data(), content.size());
+    scoped_refptr<ProtocolCache::Entry> entry = new ProtocolCache::Entry;
+    entry->content = Buffer::TakeOver(copy, content.size(), free);
+    job_->GetMimeType(&entry->mime_type);
+    job_->GetETag(&entry->etag);
+    entry->cache_control = GetCacheControl();
+    cache_->Put(url_, std::move(entry));
+  }
+
+  ProtocolCache* cache_;
+  std::string url_;
+  scoped_refptr<ProtocolJob> job_;
+
+  int size_ = -1;
+  bool recording_ = false;
+  std::string data_;
+};
+
+}  // namespace
+
+// static
+ProtocolCache* ProtocolCache::GetInstance() {
+  return g_protocol_cache.Pointer();
+}
+
+// static
+bool ProtocolCache::IsCacheable(const std::string& cache_control) {
+  if (cache_control.empty())
+    return false;
+  std::string value = base::ToLowerASCII(cache_control);
+  return value.find("no-store") == std::string::npos &&
+         value.find("no-cache") == std::string::npos;
+}
+
+ProtocolCache::ProtocolCache()
+    : cache_(base::MRUCache<std::string, scoped_refptr<Entry>>::NO_AUTO_EVICT) {
+}
+
+ProtocolCache::~ProtocolCache() {
+}
+
+ProtocolCache::Handler ProtocolCache::Wrap(const Handler& handler) {
+  return [this, handler](const std::string& url) -> ProtocolJob* {
+    scoped_refptr<Entry> entry = Get(url);
+    if (entry)
+      return new ProtocolCachedJob(std::move(entry));
+    ProtocolJob* job = handler(url);
+    if (!job)
+      return nullptr;
+    return new ProtocolCachingJob(this, url, job);
+  };
+}
+
+void ProtocolCache::SetBudget(size_t bytes) {
+  base::AutoLock auto_lock(lock_);
+  budget_ = bytes;
+  EvictTo(budget_);
+}
+
+size_t ProtocolCache::GetBudget() const {
+  base::AutoLock auto_lock(lock_);
+  return budget_;
+}
+
+size_t ProtocolCache::GetUsage() const {
+  base::AutoLock auto_lock(lock_);
+  return usage_;
+}
+
+void ProtocolCache::ClearScheme(const std::string& scheme) {
+  std::string prefix = base::ToLowerASCII(scheme) + ":";
+  base::AutoLock auto_lock(lock_);
+  for (auto it = cache_.begin(); it != cache_.end();) {
+    if (base::StartsWith(it->first, prefix,
+                         base::CompareCase::INSENSITIVE_ASCII)) {
+      usage_ -= it->second->content.size();
+      it = cache_.Erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ProtocolCache::OnMemoryPressure(bool critical) {
+  base::AutoLock auto_lock(lock_);
+  EvictTo(critical ? 0 : usage_ / 2);
+}
+
+void ProtocolCache::Clear() {
+  base::AutoLock auto_lock(lock_);
+  cache_.Clear();
+  usage_ = 0;
+}
+
+size_t ProtocolCache::size() const {
+  base::AutoLock auto_lock(lock_);
+  return cache_.size();
+}
+
+scoped_refptr<ProtocolCache::Entry> ProtocolCache::Get(
+    const std::string& url) {
+  base::AutoLock auto_lock(lock_);
+  auto it = cache_.Get(url);
+  if (it == cache_.end())
+    return nullptr;
+  return it->second;
+}
+
+void ProtocolCache::Put(const std::string& url, scoped_refptr<Entry> entry) {
+  size_t bytes = entry->content.size();
+  base::AutoLock auto_lock(lock_);
+  // Do not let one response flush the whole cache.
+  if (bytes > budget_)
+    return;
+  auto it = cache_.Peek(url);
+  if (it != cache_.end()) {
+    usage_ -= it->second->content.size();
+    cache_.Erase(it);
+  }
+  EvictTo(budget_ - bytes);
+  cache_.Put(url, std::move(entry));
+  usage_ += bytes;
+}
+
+void ProtocolCache::EvictTo(size_t bytes) {
+  while (usage_ > bytes && !cache_.empty()) {
+    auto it = cache_.rbegin();
+    usage_ -= it->second->content.size();
+    cache_.Erase(it);
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,96 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_PROTOCOL_CACHE_H_
+#define NATIVEUI_PROTOCOL_CACHE_H_
+
+#include <functional>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/buffer.h"
+#include "nativeui/protocol_job.h"
+
+namespace nu {
+
+// Keeps small responses of custom protocols in memory, so reloading pages
+// does not read and decrypt the same files again. Responses are keyed by URL,
+// and only cached when their Cache-Control header allows it, the least
+// recently used responses are evicted when the budget is exceeded.
+//
+// Jobs may store responses in worker threads, so this class is thread safe.
+class NATIVEUI_EXPORT ProtocolCache {
+ public:
+  using Handler = std::function<ProtocolJob*(const std::string&)>;
+
+  // Bytes of responses kept by default.
+  static const size_t kDefaultBudget = 16 * 1024 * 1024;
+
+  // Responses larger than this are never cached.
+  static const size_t kMaxEntrySize = 1024 * 1024;
+
+  // A cached response, which is immutable and shared by jobs serving it.
+  struct Entry : public base::RefCountedThreadSafe<Entry> {
+    Buffer content;
+    std::string mime_type;
+    std::string etag;
+    std::string cache_control;
+
+   private:
+    friend class base::RefCountedThreadSafe<Entry>;
+    ~Entry() {}
+  };
+
+  // Return the cache used by Browser::RegisterProtocol.
+  static ProtocolCache* GetInstance();
+
+  // Return whether responses with |cache_control| can be cached.
+  static bool IsCacheable(const std::string& cache_control);
+
+  ProtocolCache();
+  ~ProtocolCache();
+
+  // Return a handler that serves cached responses without calling |handler|,
+  // and caches the responses of jobs returned by |handler|. The cache must
+  // outlive the returned handler and the jobs it creates.
+  Handler Wrap(const Handler& handler);
+
+  // Set the number of bytes of responses to keep, responses are evicted
+  // immediately if the new budget is exceeded.
+  void SetBudget(size_t bytes);
+  size_t GetBudget() const;
+
+  // Return the bytes of responses in cache.
+  size_t GetUsage() const;
+
+  // Remove the responses whose URLs are under |scheme|.
+  void ClearScheme(const std::string& scheme);
+
+  // Evict responses when system is low on memory, half of the cache is
+  // released for moderate pressure and all for critical pressure.
+  void OnMemoryPressure(bool critical);
+
+  void Clear();
+  size_t size() const;
+
+  // Internal: Access to the cached responses.
+  scoped_refptr<Entry> Get(const std::string& url);
+  void Put(const std::string& url, scoped_refptr<Entry> entry);
+
+ private:
+  // Evict old responses to fit in |bytes|, |lock_| must be held.
+  void EvictTo(size_t bytes);
+
+  mutable base::Lock lock_;
+  base::MRUCache<std::string, scoped_refptr<Entry>> cache_;
+  size_t budget_ = kDefaultBudget;
+  size_t usage_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_PROTOCOL_CACHE_H_
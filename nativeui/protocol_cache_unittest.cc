@@ -0,0 +1,100 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/protocol_cache.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+// Start |job| and read all of its content.
+std::string ReadJob(nu::ProtocolJob* job) {
+  job->Plug([](int) {});
+  if (!job->Start())
+    return std::string();
+  std::string content;
+  char buf[4];
+  size_t nread;
+  while ((nread = job->Read(buf, sizeof(buf))) > 0)
+    content.append(buf, nread);
+  return content;
+}
+
+}  // namespace
+
+class ProtocolCacheTest : public testing::Test {
+ protected:
+  // Return a handler that counts how many jobs are created.
+  nu::ProtocolCache::Handler Handler(const std::string& cache_control) {
+    return cache_.Wrap([this, cache_control](const std::string& url) {
+      ++created_;
+      nu::ProtocolJob* job = new nu::ProtocolStringJob("text/javascript",
+                                                        "content of " + url);
+      job->SetCacheControl(cache_control);
+      return job;
+    });
+  }
+
+  nu::ProtocolCache cache_;
+  int created_ = 0;
+};
+
+TEST_F(ProtocolCacheTest, ServeCachedResponse) {
+  auto handler = Handler("max-age=3600");
+  scoped_refptr<nu::ProtocolJob> job = handler("app://a.js");
+  EXPECT_EQ(ReadJob(job.get()), "content of app://a.js");
+  EXPECT_EQ(cache_.size(), 1u);
+  job = handler("app://a.js");
+  EXPECT_EQ(ReadJob(job.get()), "content of app://a.js");
+  EXPECT_EQ(created_, 1);
+  std::string mime_type;
+  ASSERT_TRUE(job->GetMimeType(&mime_type));
+  EXPECT_EQ(mime_type, "text/javascript");
+  EXPECT_EQ(job->GetCacheControl(), "max-age=3600");
+}
+
+TEST_F(ProtocolCacheTest, RespectCacheControl) {
+  auto handler = Handler("no-store");
+  scoped_refptr<nu::ProtocolJob> job = handler("app://a.js");
+  ReadJob(job.get());
+  job = handler("app://a.js");
+  ReadJob(job.get());
+  EXPECT_EQ(created_, 2);
+  EXPECT_EQ(cache_.size(), 0u);
+  handler = Handler("");
+  job = handler("app://a.js");
+  ReadJob(job.get());
+  EXPECT_EQ(cache_.size(), 0u);
+}
+
+TEST_F(ProtocolCacheTest, EvictToBudget) {
+  auto handler = Handler("immutable");
+  scoped_refptr<nu::ProtocolJob> job = handler("app://a.js");
+  ReadJob(job.get());
+  job = handler("app://b.js");
+  ReadJob(job.get());
+  EXPECT_EQ(cache_.GetUsage(), 42u);
+  cache_.SetBudget(30);
+  EXPECT_EQ(cache_.GetUsage(), 21u);
+  job = handler("app://b.js");
+  ReadJob(job.get());
+  EXPECT_EQ(created_, 2);
+  job = handler("app://a.js");
+  ReadJob(job.get());
+  EXPECT_EQ(created_, 3);
+}
+
+TEST_F(ProtocolCacheTest, Clear) {
+  auto handler = Handler("immutable");
+  scoped_refptr<nu::ProtocolJob> job = handler("app://a.js");
+  ReadJob(job.get());
+  job = handler("res://a.js");
+  ReadJob(job.get());
+  cache_.ClearScheme("APP");
+  EXPECT_EQ(cache_.size(), 1u);
+  EXPECT_EQ(cache_.GetUsage(), 21u);
+  cache_.Clear();
+  EXPECT_EQ(cache_.size(), 0u);
+  EXPECT_EQ(cache_.GetUsage(), 0u);
+}
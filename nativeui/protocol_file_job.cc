@@ -5,8 +5,12 @@
 
 #include "nativeui/protocol_file_job.h"
 
+#include <inttypes.h>
+
 #include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "nativeui/trace_event.h"
 
 namespace nu {
 
@@ -178,6 +182,7 @@ bool ProtocolFileJob::GetMimeType(std::string* mime_type) {
 }
 
 size_t ProtocolFileJob::Read(void* buf, size_t buf_size) {
+  NU_TRACE_EVENT("protocol", "ProtocolFileJob::Read");
   if (content_length_ == 0)
     return 0;
   if (content_length_ < static_cast<int64_t>(buf_size))
@@ -193,4 +198,31 @@ size_t ProtocolFileJob::Read(void* buf, size_t buf_size) {
   }
 }
 
+bool ProtocolFileJob::MayBlock() const {
+  return true;
+}
+
+bool ProtocolFileJob::Seek(int64_t offset) {
+  int64_t length = file_.GetLength();
+  if (offset < 0 || offset > length ||
+      file_.Seek(base::File::FROM_BEGIN, offset) < 0)
+    return false;
+  content_length_ = length - offset;
+  return true;
+}
+
+bool ProtocolFileJob::GetETag(std::string* etag) {
+  // Files are identified by their sizes and modification times, which is
+  // what most HTTP servers do.
+  base::File::Info info;
+  if (!file_.IsValid() || !file_.GetInfo(&info))
+    return false;
+  *etag = base::StringPrintf(
+      "\"%" PRIx64 "-%" PRIx64 "\"",
+      static_cast<uint64_t>(
+          info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds()),
+      static_cast<uint64_t>(info.size));
+  return true;
+}
+
 }  // namespace nu
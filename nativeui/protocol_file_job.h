@@ -23,6 +23,9 @@ class NATIVEUI_EXPORT ProtocolFileJob : public ProtocolJob {
   void Kill() override;
   bool GetMimeType(std::string* mime_type) override;
   size_t Read(void* buf, size_t buf_size) override;
+  bool MayBlock() const override;
+  bool Seek(int64_t offset) override;
+  bool GetETag(std::string* etag) override;
 
  protected:
   ~ProtocolFileJob() override;
@@ -9,6 +9,10 @@
 #include <algorithm>
 #include <utility>
 
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "nativeui/trace_event.h"
+
 namespace nu {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -28,10 +32,62 @@ bool ProtocolJob::Start() {
 void ProtocolJob::Kill() {
 }
 
+bool ProtocolJob::MayBlock() const {
+  return false;
+}
+
+bool ProtocolJob::GetContent(base::StringPiece* content) {
+  return false;
+}
+
+bool ProtocolJob::Seek(int64_t offset) {
+  return false;
+}
+
+bool ProtocolJob::GetETag(std::string* etag) {
+  return false;
+}
+
+void ProtocolJob::SetCacheControl(const std::string& cache_control) {
+  cache_control_ = cache_control;
+}
+
 void ProtocolJob::Plug(std::function<void(int)> func) {
   notify_content_length = std::move(func);
 }
 
+// static
+bool ProtocolJob::ParseRange(base::StringPiece header, int64_t size,
+                             int64_t* first, int64_t* last) {
+  // Multiple ranges are not supported.
+  if (size <= 0 ||
+      !base::StartsWith(header, "bytes=", base::CompareCase::SENSITIVE) ||
+      header.find(',') != base::StringPiece::npos)
+    return false;
+  header.remove_prefix(6);
+  size_t dash = header.find('-');
+  if (dash == base::StringPiece::npos)
+    return false;
+  base::StringPiece first_str = header.substr(0, dash);
+  base::StringPiece last_str = header.substr(dash + 1);
+  if (first_str.empty()) {
+    int64_t suffix;
+    if (!base::StringToInt64(last_str, &suffix) || suffix <= 0)
+      return false;
+    *first = std::max<int64_t>(size - suffix, 0);
+    *last = size - 1;
+    return true;
+  }
+  if (!base::StringToInt64(first_str, first) || *first < 0 || *first >= size)
+    return false;
+  if (last_str.empty())
+    *last = size - 1;
+  else if (!base::StringToInt64(last_str, last) || *last < *first)
+    return false;
+  *last = std::min(*last, size - 1);
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // ProtocolStringJob implementation.
 
@@ -55,6 +111,7 @@ bool ProtocolStringJob::GetMimeType(std::string* mime_type) {
 }
 
 size_t ProtocolStringJob::Read(void* buf, size_t buf_size) {
+  NU_TRACE_EVENT("protocol", "ProtocolStringJob::Read");
   if (pos_ == content_.size() || buf_size == 0)
     return 0;
   size_t nread = std::min(buf_size, content_.size() - pos_);
@@ -63,4 +120,16 @@ size_t ProtocolStringJob::Read(void* buf, size_t buf_size) {
   return nread;
 }
 
+bool ProtocolStringJob::GetContent(base::StringPiece* content) {
+  *content = content_;
+  return true;
+}
+
+bool ProtocolStringJob::Seek(int64_t offset) {
+  if (offset < 0 || offset > static_cast<int64_t>(content_.size()))
+    return false;
+  pos_ = static_cast<size_t>(offset);
+  return true;
+}
+
 }  // namespace nu
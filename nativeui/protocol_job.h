@@ -10,12 +10,19 @@
 
 #include "base/debug/leak_tracker.h"
 #include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
 
 // A simple class used by Browser to serve custom protocol requests.
-class NATIVEUI_EXPORT ProtocolJob : public base::RefCounted<ProtocolJob> {
+//
+// Jobs are created in the main thread, while the other methods may be called
+// in other threads depending on the browser, but never at the same time for
+// one job. For jobs that may block, Start and Read are always called in
+// worker threads, and Kill is only called after reading has stopped.
+class NATIVEUI_EXPORT ProtocolJob
+    : public base::RefCountedThreadSafe<ProtocolJob> {
  public:
   // Subclasses should implement this.
   virtual bool Start();
@@ -23,11 +30,41 @@ class NATIVEUI_EXPORT ProtocolJob : public base::RefCounted<ProtocolJob> {
   virtual bool GetMimeType(std::string* mime_type) = 0;
   virtual size_t Read(void* buf, size_t buf_size) = 0;
 
+  // Return true if Start and Read may block, for example by reading disks,
+  // so browsers would call them in worker threads instead of the main thread.
+  // The default implementation returns false.
+  virtual bool MayBlock() const;
+
+  // Return the whole content when it is already in memory, so browsers can
+  // use it without reading. The memory stays valid until the job is freed.
+  // Only called after the job is started, and Read is not called if this
+  // returns true.
+  virtual bool GetContent(base::StringPiece* content);
+
+  // Move the reading position to |offset| of the content, so browsers can
+  // serve range requests. Only called after the job is started and before
+  // reading, returning false would serve the whole content.
+  virtual bool Seek(int64_t offset);
+
+  // Return the entity tag of the content, browsers would use the cached
+  // response instead of reading when it matches. Only called after the job
+  // is started, the default implementation returns false.
+  virtual bool GetETag(std::string* etag);
+
+  // Set the Cache-Control header of the response, which is empty by default.
+  void SetCacheControl(const std::string& cache_control);
+  const std::string& GetCacheControl() const { return cache_control_; }
+
   // Internal: Used by Browser implementations to plug adapters.
   void Plug(std::function<void(int)> start);
 
+  // Internal: Parse the Range header in the forms of "bytes=first-last",
+  // "bytes=first-" and "bytes=-suffix", the |last| is clamped to |size|.
+  static bool ParseRange(base::StringPiece header, int64_t size,
+                         int64_t* first, int64_t* last);
+
  protected:
-  friend class base::RefCounted<ProtocolJob>;
+  friend class base::RefCountedThreadSafe<ProtocolJob>;
 
   ProtocolJob();
   virtual ~ProtocolJob();
@@ -35,6 +72,9 @@ class NATIVEUI_EXPORT ProtocolJob : public base::RefCounted<ProtocolJob> {
   // Used by subclasses to notify the browser.
   std::function<void(int)> notify_content_length;
 
+ private:
+  std::string cache_control_;
+
   base::debug::LeakTracker<ProtocolJob> leak_tracker_;
 };
 
@@ -46,6 +86,8 @@ class NATIVEUI_EXPORT ProtocolStringJob : public ProtocolJob {
   bool Start() override;
   bool GetMimeType(std::string* mime_type) override;
   size_t Read(void* buf, size_t buf_size) override;
+  bool GetContent(base::StringPiece* content) override;
+  bool Seek(int64_t offset) override;
 
  protected:
   ~ProtocolStringJob() override;
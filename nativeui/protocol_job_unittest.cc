@@ -0,0 +1,49 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/protocol_file_job.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(ProtocolJobTest, ParseRange) {
+  int64_t first, last;
+  ASSERT_TRUE(nu::ProtocolJob::ParseRange("bytes=10-19", 100, &first, &last));
+  EXPECT_EQ(first, 10);
+  EXPECT_EQ(last, 19);
+  ASSERT_TRUE(nu::ProtocolJob::ParseRange("bytes=10-", 100, &first, &last));
+  EXPECT_EQ(first, 10);
+  EXPECT_EQ(last, 99);
+  ASSERT_TRUE(nu::ProtocolJob::ParseRange("bytes=-30", 100, &first, &last));
+  EXPECT_EQ(first, 70);
+  EXPECT_EQ(last, 99);
+  ASSERT_TRUE(nu::ProtocolJob::ParseRange("bytes=90-200", 100, &first, &last));
+  EXPECT_EQ(last, 99);
+  EXPECT_FALSE(nu::ProtocolJob::ParseRange("bytes=100-", 100, &first, &last));
+  EXPECT_FALSE(nu::ProtocolJob::ParseRange("bytes=20-10", 100, &first, &last));
+  EXPECT_FALSE(nu::ProtocolJob::ParseRange("bytes=0-1,5-", 100, &first,
+                                           &last));
+  EXPECT_FALSE(nu::ProtocolJob::ParseRange("items=0-1", 100, &first, &last));
+  EXPECT_FALSE(nu::ProtocolJob::ParseRange("bytes=0-", -1, &first, &last));
+}
+
+TEST(ProtocolJobTest, StringJobSeek) {
+  scoped_refptr<nu::ProtocolJob> job =
+      new nu::ProtocolStringJob("text/plain", "abcdef");
+  job->Plug([](int) {});
+  ASSERT_TRUE(job->Start());
+  EXPECT_FALSE(job->Seek(7));
+  ASSERT_TRUE(job->Seek(4));
+  char buf[8];
+  ASSERT_EQ(job->Read(buf, sizeof(buf)), 2u);
+  EXPECT_EQ(std::string(buf, 2), "ef");
+}
+
+TEST(ProtocolJobTest, MayBlock) {
+  scoped_refptr<nu::ProtocolJob> string_job =
+      new nu::ProtocolStringJob("text/plain", "abcdef");
+  EXPECT_FALSE(string_job->MayBlock());
+  scoped_refptr<nu::ProtocolJob> file_job =
+      new nu::ProtocolFileJob(base::FilePath());
+  EXPECT_TRUE(file_job->MayBlock());
+}
@@ -0,0 +1,70 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/render_thread.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/display_list.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/state.h"
+#include "nativeui/trace_event.h"
+#include "nativeui/util/worker_pool.h"
+
+namespace nu {
+
+namespace {
+
+// Lists are rendered one at a time in the order they are posted.
+base::LazyInstance<WorkerPool::Sequence>::Leaky g_render_sequence =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+struct RenderThread::Job {
+  // The references are only changed in the main thread.
+  scoped_refptr<DisplayList> list;
+  scoped_refptr<Canvas> canvas;
+  Callback callback;
+
+  // Called in the worker thread.
+  void Run() {
+    {
+      NU_TRACE_EVENT("paint", "RenderThread::Render");
+      list->Replay(canvas->GetPainter());
+      // Flush the pending drawings of this thread into the bitmap.
+      canvas->LockPixels();
+      canvas->UnlockPixels();
+    }
+    MessageLoop::PostTask([this]() { RenderThread::Finish(this); });
+  }
+};
+
+// static
+void RenderThread::Render(scoped_refptr<DisplayList> list,
+                          scoped_refptr<Canvas> canvas,
+                          Callback callback) {
+  DCHECK(list->IsSelfContained());
+  Job* job = new Job;
+  job->list = std::move(list);
+  job->canvas = std::move(canvas);
+  job->callback = std::move(callback);
+  g_render_sequence.Pointer()->PostTask([job]() { job->Run(); });
+}
+
+// static
+void RenderThread::Finish(Job* job) {
+  std::unique_ptr<Job> auto_delete(job);
+  // The state has been destroyed.
+  if (!State::GetCurrent())
+    return;
+  if (job->callback)
+    job->callback(std::move(job->canvas));
+}
+
+}  // namespace nu
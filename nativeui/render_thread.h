@@ -0,0 +1,48 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_RENDER_THREAD_H_
+#define NATIVEUI_RENDER_THREAD_H_
+
+#include <functional>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class Canvas;
+class DisplayList;
+
+// Rasterize display lists in background.
+//
+// The canvases are created in the main thread and passed back to it after
+// the lists are replayed on them, so the platform drawing APIs are the only
+// work done in the WorkerPool. Lists are rendered one at a time in the order
+// they are posted.
+class NATIVEUI_EXPORT RenderThread {
+ public:
+  // Called in the main thread with the canvas that has been drawn.
+  using Callback = std::function<void(scoped_refptr<Canvas>)>;
+
+  // Replay |list| on |canvas| in background. The |list| must be self
+  // contained and must not be changed until |callback| is called, and the
+  // |canvas| should not be used in the meantime.
+  static void Render(scoped_refptr<DisplayList> list,
+                     scoped_refptr<Canvas> canvas,
+                     Callback callback);
+
+ private:
+  struct Job;
+
+  // Pass the canvas to the callback in the main thread.
+  static void Finish(Job* job);
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(RenderThread);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_RENDER_THREAD_H_
@@ -0,0 +1,49 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class RenderThreadTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(RenderThreadTest, Render) {
+  scoped_refptr<nu::DisplayList> list = new nu::DisplayList;
+  list->GetPainter()->SetFillColor(nu::Color(255, 0, 0));
+  list->GetPainter()->FillRect(nu::RectF(0, 0, 10, 10));
+  ASSERT_TRUE(list->IsSelfContained());
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 10), 1.f);
+  scoped_refptr<nu::Canvas> result;
+  nu::RenderThread::Render(list, canvas,
+                           [&result](scoped_refptr<nu::Canvas> canvas) {
+    result = canvas;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(result, canvas);
+  nu::CanvasPixels pixels = canvas->LockPixels();
+  const uint8_t* data = static_cast<const uint8_t*>(pixels.buffer.content());
+  EXPECT_EQ(data[2], 255);
+  EXPECT_EQ(data[3], 255);
+  canvas->UnlockPixels();
+}
+
+TEST_F(RenderThreadTest, RenderInOrder) {
+  std::vector<int> order;
+  for (int i = 0; i < 3; ++i) {
+    scoped_refptr<nu::DisplayList> list = new nu::DisplayList;
+    list->GetPainter()->FillRect(nu::RectF(0, 0, 1, 1));
+    nu::RenderThread::Render(list, new nu::Canvas(nu::SizeF(1, 1), 1.f),
+                             [&order, i](scoped_refptr<nu::Canvas>) {
+      order.push_back(i);
+      if (order.size() == 3)
+        nu::MessageLoop::Quit();
+    });
+  }
+  nu::MessageLoop::Run();
+  EXPECT_EQ(order, std::vector<int>({0, 1, 2}));
+}
@@ -4,24 +4,67 @@
 
 #include "nativeui/scroll.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "nativeui/container.h"
 #include "nativeui/gfx/geometry/size_conversions.h"
+#include "nativeui/util/frame_clock.h"
+#include "nativeui/window.h"
 
 namespace nu {
 
+namespace {
+
+// How long scrolling must stop before on_scroll_end is emitted, in ms.
+const int kScrollEndDelay = 150;
+
+// The duration of SetScrollPositionAnimated, in ms.
+const double kScrollAnimationDuration = 200.;
+
+}  // namespace
+
 // static
 const char Scroll::kClassName[] = "Scroll";
 
 Scroll::Scroll() {
   PlatformInit();
   SetContentView(new Container);
+  // Scrolling may reveal suspended animations.
+  on_scroll.Connect([](Scroll*) {
+    FrameClock::GetCurrent()->UpdateVisibility();
+  });
 }
 
 Scroll::~Scroll() {
 }
 
+void Scroll::SetScrollPosition(float horizon, float vertical) {
+  StopAnimation();
+  PlatformSetScrollPosition(horizon, vertical);
+}
+
+void Scroll::SetScrollPositionAnimated(float horizon, float vertical) {
+  StopAnimation();
+  Window* window = GetWindow();
+  if (!window) {
+    PlatformSetScrollPosition(horizon, vertical);
+    return;
+  }
+  std::tie(animation_.from_x, animation_.from_y) = GetScrollPosition();
+  animation_.x = animation_.from_x;
+  animation_.y = animation_.from_y;
+  animation_.to_x = horizon;
+  animation_.to_y = vertical;
+  animation_.start_time = 0;
+  // Keep a reference so the view is alive when the frame comes.
+  scoped_refptr<Scroll> self(this);
+  animation_.frame_id = window->RequestFrame([self](double timestamp) {
+    self->OnAnimationFrame(timestamp);
+  });
+}
+
 void Scroll::SetContentView(scoped_refptr<View> view) {
   if (content_view_)
     content_view_->SetParent(nullptr);
@@ -42,4 +85,77 @@ const char* Scroll::GetClassName() const {
   return kClassName;
 }
 
+void Scroll::NotifyScroll() {
+  OnScrollPositionChange();
+  // Keep a reference so the view is alive when the timer fires.
+  scoped_refptr<Scroll> self(this);
+  if (scroll_end_timer_)
+    MessageLoop::ClearTimeout(scroll_end_timer_);
+  scroll_end_timer_ = MessageLoop::SetTimeout(kScrollEndDelay, [self]() {
+    self->scroll_end_timer_ = 0;
+    self->FlushScroll();
+    self->on_scroll_end.Emit(self.get());
+  });
+  if (scroll_frame_id_)
+    return;
+  Window* window = GetWindow();
+  if (!window) {
+    on_scroll.Emit(this);
+    return;
+  }
+  // Changes in the same frame are notified once.
+  scroll_frame_id_ = window->RequestFrame([self](double) {
+    self->scroll_frame_id_ = 0;
+    self->on_scroll.Emit(self.get());
+  });
+}
+
+void Scroll::OnScrollPositionChange() {
+}
+
+void Scroll::FlushScroll() {
+  if (!scroll_frame_id_)
+    return;
+  if (GetWindow())
+    GetWindow()->CancelFrame(scroll_frame_id_);
+  scroll_frame_id_ = 0;
+  on_scroll.Emit(this);
+}
+
+void Scroll::OnAnimationFrame(double timestamp) {
+  if (!animation_.frame_id)
+    return;
+  animation_.frame_id = 0;
+  float x, y;
+  std::tie(x, y) = GetScrollPosition();
+  // Users have scrolled by themselves.
+  if (std::abs(x - animation_.x) > 1 || std::abs(y - animation_.y) > 1)
+    return;
+  if (animation_.start_time == 0)
+    animation_.start_time = timestamp;
+  double progress = std::min(
+      1., (timestamp - animation_.start_time) / kScrollAnimationDuration);
+  // Ease out cubic.
+  float ratio = static_cast<float>(1 - std::pow(1 - progress, 3));
+  PlatformSetScrollPosition(
+      animation_.from_x + (animation_.to_x - animation_.from_x) * ratio,
+      animation_.from_y + (animation_.to_y - animation_.from_y) * ratio);
+  std::tie(animation_.x, animation_.y) = GetScrollPosition();
+  Window* window = GetWindow();
+  if (progress >= 1 || !window)
+    return;
+  scoped_refptr<Scroll> self(this);
+  animation_.frame_id = window->RequestFrame([self](double timestamp) {
+    self->OnAnimationFrame(timestamp);
+  });
+}
+
+void Scroll::StopAnimation() {
+  if (!animation_.frame_id)
+    return;
+  if (GetWindow())
+    GetWindow()->CancelFrame(animation_.frame_id);
+  animation_.frame_id = 0;
+}
+
 }  // namespace nu
@@ -7,6 +7,7 @@
 
 #include <tuple>
 
+#include "nativeui/message_loop.h"
 #include "nativeui/view.h"
 
 #if defined(OS_LINUX)
@@ -31,6 +32,12 @@ class NATIVEUI_EXPORT Scroll : public View {
   void SetContentSize(const SizeF& size);
   SizeF GetContentSize() const;
 
+  void SetScrollPosition(float horizon, float vertical);
+  // Scroll to the position smoothly on the frames of window.
+  void SetScrollPositionAnimated(float horizon, float vertical);
+  std::tuple<float, float> GetScrollPosition() const;
+  std::tuple<float, float> GetMaximumScrollPosition() const;
+
 #if !defined(OS_WIN)
   void SetOverlayScrollbar(bool overlay);
   bool IsOverlayScrollbar() const;
@@ -47,15 +54,46 @@ class NATIVEUI_EXPORT Scroll : public View {
   // View:
   const char* GetClassName() const override;
 
+  // Internal: Called by platform implementations when the scroll position
+  // changes.
+  void NotifyScroll();
+
+  // Events.
+  Signal<void(Scroll*)> on_scroll;
+  Signal<void(Scroll*)> on_scroll_end;
+
  protected:
   ~Scroll() override;
 
+  // Called immediately for every change of scroll position, while on_scroll
+  // is only emitted once per frame.
+  virtual void OnScrollPositionChange();
+
   // Following platform implementations should only be called by wrappers.
   void PlatformInit();
   void PlatformSetContentView(View* container);
+  void PlatformSetScrollPosition(float horizon, float vertical);
 
  private:
+  // Emit the on_scroll that is waiting for frame.
+  void FlushScroll();
+
+  void OnAnimationFrame(double timestamp);
+  void StopAnimation();
+
   scoped_refptr<View> content_view_;
+
+  int scroll_frame_id_ = 0;
+  MessageLoop::TimerId scroll_end_timer_ = 0;
+
+  // The smooth scrolling started by SetScrollPositionAnimated.
+  struct Animation {
+    int frame_id = 0;
+    double start_time = 0;
+    float from_x, from_y, to_x, to_y;
+    // The position set by last frame, used to detect scrolling by users.
+    float x, y;
+  } animation_;
 };
 
 }  // namespace nu
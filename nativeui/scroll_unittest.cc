@@ -0,0 +1,55 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ScrollTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    scroll_ = new nu::Scroll;
+    scroll_->SetContentSize(nu::SizeF(1000, 1000));
+    scroll_->on_scroll.Connect([this](nu::Scroll*) { ++scroll_count_; });
+    scroll_->on_scroll_end.Connect([this](nu::Scroll*) {
+      ++scroll_end_count_;
+      nu::MessageLoop::Quit();
+    });
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Scroll> scroll_;
+  int scroll_count_ = 0;
+  int scroll_end_count_ = 0;
+};
+
+TEST_F(ScrollTest, EmitWithoutWindow) {
+  scroll_->SetScrollPosition(0, 100);
+  EXPECT_EQ(scroll_count_, 1);
+  nu::MessageLoop::Run();
+  EXPECT_EQ(scroll_end_count_, 1);
+}
+
+TEST_F(ScrollTest, EmitOncePerFrame) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetContentSize(nu::SizeF(400, 400));
+  window->SetContentView(scroll_.get());
+  scroll_->SetScrollPosition(0, 100);
+  scroll_->SetScrollPosition(0, 200);
+  scroll_->SetScrollPosition(0, 300);
+  EXPECT_EQ(scroll_count_, 0);
+  nu::MessageLoop::Run();
+  EXPECT_EQ(scroll_count_, 1);
+  EXPECT_EQ(scroll_end_count_, 1);
+}
+
+TEST_F(ScrollTest, Animated) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetContentSize(nu::SizeF(400, 400));
+  window->SetContentView(scroll_.get());
+  window->Activate();
+  scroll_->SetScrollPositionAnimated(0, 300);
+  nu::MessageLoop::Run();
+  EXPECT_EQ(scroll_->GetScrollPosition(), std::make_tuple(0.f, 300.f));
+}
@@ -10,6 +10,8 @@
 #include <utility>
 #include <vector>
 
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
@@ -25,6 +27,8 @@ template<typename Sig> class SignalBase {
  public:
   using Slot = std::function<Sig>;
 
+  SignalBase() {}
+
   void SetDelegate(SignalDelegate* delegate, int identifier = 0) {
     delegate_ = delegate;
     identifier_ = identifier;
@@ -33,36 +37,209 @@ template<typename Sig> class SignalBase {
   int Connect(const Slot& slot) {
     if (delegate_)
       delegate_->OnConnect(identifier_);
-    slots_.push_back(std::make_pair(++next_id_, slot));
+    if (!list_)
+      list_ = new SlotList;
+    list_->Add(++next_id_, slot);
     return next_id_;
   }
 
   void Disconnect(int id) {
-    auto iter = std::lower_bound(slots_.begin(), slots_.end(),
-                                 id, TupleCompare);
-    if (iter != slots_.end() && std::get<0>(*iter) == id)
-      slots_.erase(iter);
+    if (list_)
+      list_->Remove(id);
   }
 
   void DisconnectAll() {
-    slots_.clear();
+    if (list_)
+      list_->RemoveAll();
   }
 
   bool IsEmpty() const {
-    return slots_.empty();
+    return !list_ || list_->IsEmpty();
   }
 
  protected:
-  // Use the first element of tuple as comparing key.
-  static bool TupleCompare(const std::pair<int, Slot>& element, int key) {
-    return element.first < key;
-  }
+  struct Entry {
+    int id = 0;
+    bool removed = false;
+    Slot slot;
+  };
 
-  int next_id_ = 0;
-  std::vector<std::pair<int, Slot>> slots_;
+  // The slots are not copied when emitting, instead changes made to the list
+  // during emission are deferred until the outermost emission ends:
+  // 1. new slots are kept in |pending| and are not run by current emission;
+  // 2. removed slots are only marked, so the running slot is never destroyed.
+  // The list is refcounted so it stays alive when a slot destroys the signal.
+  //
+  // Most signals have at most one slot, so the first slot is stored inline
+  // and only the following slots are stored in a vector.
+  class SlotList : public base::RefCounted<SlotList> {
+   public:
+    SlotList() {}
 
-  int identifier_ = 0;
+    void Add(int id, const Slot& slot) {
+      // Appending to the slots could move the slot being run.
+      if (emitting_ > 0)
+        pending_.push_back({id, false, slot});
+      else
+        Append({id, false, slot});
+    }
+
+    void Remove(int id) {
+      size_t index = Find(id);
+      if (index < count_) {
+        if (at(index).removed)
+          return;
+        if (emitting_ > 0) {
+          at(index).removed = true;
+          ++removed_count_;
+        } else {
+          Erase(index);
+        }
+        return;
+      }
+      auto iter = std::lower_bound(pending_.begin(), pending_.end(), id,
+                                   IdCompare);
+      if (iter != pending_.end() && iter->id == id)
+        pending_.erase(iter);
+    }
+
+    void RemoveAll() {
+      pending_.clear();
+      if (emitting_ == 0) {
+        Truncate(0);
+        return;
+      }
+      for (size_t i = 0; i < count_; ++i)
+        at(i).removed = true;
+      removed_count_ = count_;
+    }
+
+    bool IsEmpty() const {
+      return count_ == removed_count_ && pending_.empty();
+    }
+
+    void BeginEmit() {
+      ++emitting_;
+    }
+
+    void EndEmit() {
+      if (--emitting_ > 0)
+        return;
+      if (removed_count_ > 0) {
+        size_t j = 0;
+        for (size_t i = 0; i < count_; ++i) {
+          if (at(i).removed)
+            continue;
+          if (i != j)
+            at(j) = std::move(at(i));
+          ++j;
+        }
+        Truncate(j);
+        removed_count_ = 0;
+      }
+      if (!pending_.empty()) {
+        // Pending slots have larger IDs, so the list is still sorted.
+        for (Entry& entry : pending_)
+          Append(std::move(entry));
+        pending_.clear();
+      }
+    }
+
+    // Slots can only be added to |pending_| when emitting, so the size does
+    // not change in emission.
+    size_t size() const { return count_; }
+    Entry& at(size_t i) { return i == 0 ? first_ : rest_[i - 1]; }
+
+   private:
+    friend class base::RefCounted<SlotList>;
+
+    ~SlotList() {}
+
+    // Use the ID as comparing key.
+    static bool IdCompare(const Entry& element, int key) {
+      return element.id < key;
+    }
+
+    void Append(Entry entry) {
+      if (count_ == 0)
+        first_ = std::move(entry);
+      else
+        rest_.push_back(std::move(entry));
+      ++count_;
+    }
+
+    // Return |count_| if not found.
+    size_t Find(int id) const {
+      if (count_ == 0)
+        return count_;
+      if (first_.id == id)
+        return 0;
+      auto iter = std::lower_bound(rest_.begin(), rest_.end(), id, IdCompare);
+      if (iter != rest_.end() && iter->id == id)
+        return iter - rest_.begin() + 1;
+      return count_;
+    }
+
+    void Erase(size_t index) {
+      if (index == 0) {
+        if (rest_.empty()) {
+          first_ = Entry();
+        } else {
+          first_ = std::move(rest_.front());
+          rest_.erase(rest_.begin());
+        }
+      } else {
+        rest_.erase(rest_.begin() + (index - 1));
+      }
+      --count_;
+    }
+
+    // Keep the first |size| slots.
+    void Truncate(size_t size) {
+      if (size == 0) {
+        first_ = Entry();
+        rest_.clear();
+      } else {
+        rest_.resize(size - 1);
+      }
+      count_ = size;
+    }
+
+    Entry first_;
+    std::vector<Entry> rest_;
+    size_t count_ = 0;
+    std::vector<Entry> pending_;
+    size_t removed_count_ = 0;
+    int emitting_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(SlotList);
+  };
+
+  // Mark the list as being emitted in current scope.
+  class ScopedEmit {
+   public:
+    explicit ScopedEmit(SlotList* list) : list_(list) {
+      list_->BeginEmit();
+    }
+    ~ScopedEmit() {
+      list_->EndEmit();
+    }
+
+    SlotList* list() const { return list_.get(); }
+
+   private:
+    // Keep the list alive even if the signal is destroyed.
+    scoped_refptr<SlotList> list_;
+  };
+
+  // Ordered to avoid paddings, since every View has many signals.
+  scoped_refptr<SlotList> list_;
   SignalDelegate* delegate_ = nullptr;
+  int next_id_ = 0;
+  int identifier_ = 0;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SignalBase);
 };
 
 template<typename Sig> class Signal;
@@ -72,11 +249,14 @@ template<typename... Args>
 class Signal<void(Args...)> : public SignalBase<void(Args...)> {
  public:
   void Emit(Args... args) {
-    // Copy the list before iterating, since it is possible that user removes
-    // elements from the list when iterating.
-    auto slots = this->slots_;
-    for (auto& slot : slots)
-      slot.second(std::forward<Args>(args)...);
+    if (!this->list_)
+      return;
+    typename SignalBase<void(Args...)>::ScopedEmit scoped(this->list_.get());
+    auto* list = scoped.list();
+    for (size_t i = 0; i < list->size(); ++i) {
+      if (!list->at(i).removed)
+        list->at(i).slot(args...);
+    }
   }
 };
 
@@ -85,11 +265,12 @@ template<typename... Args>
 class Signal<bool(Args...)> : public SignalBase<bool(Args...)> {
  public:
   bool Emit(Args... args) {
-    // Copy the list before iterating, since it is possible that user removes
-    // elements from the list when iterating.
-    auto slots = this->slots_;
-    for (auto& slot : slots) {
-      if (slot.second(std::forward<Args>(args)...))
+    if (!this->list_)
+      return false;
+    typename SignalBase<bool(Args...)>::ScopedEmit scoped(this->list_.get());
+    auto* list = scoped.list();
+    for (size_t i = 0; i < list->size(); ++i) {
+      if (!list->at(i).removed && list->at(i).slot(args...))
         return true;
     }
     return false;
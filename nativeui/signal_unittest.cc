@@ -0,0 +1,99 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <memory>
+#include <vector>
+
+#include "nativeui/signal.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(SignalTest, Emit) {
+  nu::Signal<void(int)> signal;
+  int sum = 0;
+  signal.Connect([&sum](int value) { sum += value; });
+  signal.Connect([&sum](int value) { sum += value * 10; });
+  signal.Emit(1);
+  EXPECT_EQ(sum, 11);
+}
+
+TEST(SignalTest, EmitStopsWhenHandled) {
+  nu::Signal<bool(int)> signal;
+  int count = 0;
+  signal.Connect([&count](int) { ++count; return true; });
+  signal.Connect([&count](int) { ++count; return true; });
+  EXPECT_TRUE(signal.Emit(0));
+  EXPECT_EQ(count, 1);
+}
+
+TEST(SignalTest, DisconnectWhenEmitting) {
+  nu::Signal<void()> signal;
+  int count = 0;
+  int id1 = 0, id2 = 0;
+  id1 = signal.Connect([&]() {
+    ++count;
+    signal.Disconnect(id1);
+    signal.Disconnect(id2);
+  });
+  id2 = signal.Connect([&]() { ++count; });
+  signal.Emit();
+  EXPECT_EQ(count, 1);
+  EXPECT_TRUE(signal.IsEmpty());
+  signal.Emit();
+  EXPECT_EQ(count, 1);
+}
+
+TEST(SignalTest, ConnectWhenEmitting) {
+  nu::Signal<void()> signal;
+  int count = 0;
+  signal.Connect([&]() {
+    ++count;
+    signal.Connect([&]() { ++count; });
+  });
+  signal.Emit();
+  EXPECT_EQ(count, 1);
+  signal.Emit();
+  EXPECT_EQ(count, 3);
+}
+
+TEST(SignalTest, NestedEmit) {
+  nu::Signal<void(int)> signal;
+  int count = 0;
+  int id = signal.Connect([&](int depth) {
+    ++count;
+    if (depth == 0) {
+      signal.Emit(1);
+      signal.Disconnect(id);
+    }
+  });
+  signal.Emit(0);
+  EXPECT_EQ(count, 2);
+  EXPECT_TRUE(signal.IsEmpty());
+}
+
+TEST(SignalTest, DestroyWhenEmitting) {
+  auto signal = std::make_unique<nu::Signal<void()>>();
+  int count = 0;
+  signal->Connect([&]() { signal.reset(); ++count; });
+  signal->Connect([&]() { ++count; });
+  signal->Emit();
+  EXPECT_EQ(count, 2);
+}
+
+TEST(SignalTest, DisconnectKeepsOrder) {
+  nu::Signal<void()> signal;
+  std::vector<int> calls;
+  int id1 = signal.Connect([&]() { calls.push_back(1); });
+  signal.Connect([&]() { calls.push_back(2); });
+  int id3 = signal.Connect([&]() { calls.push_back(3); });
+  signal.Connect([&]() { calls.push_back(4); });
+  signal.Disconnect(id1);
+  signal.Disconnect(id3);
+  signal.Emit();
+  EXPECT_EQ(calls, std::vector<int>({2, 4}));
+  signal.DisconnectAll();
+  EXPECT_TRUE(signal.IsEmpty());
+  signal.Connect([&]() { calls.push_back(5); });
+  signal.Emit();
+  EXPECT_EQ(calls, std::vector<int>({2, 4, 5}));
+}
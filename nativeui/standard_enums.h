@@ -14,6 +14,12 @@ enum class ImageScale {
   UpOrDown,
 };
 
+enum class ImageQuality {
+  Low,
+  Medium,
+  High,
+};
+
 enum class Orientation {
   Horizontal,
   Vertical,
@@ -0,0 +1,117 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/startup_stats.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "base/stl_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+
+namespace nu {
+
+namespace {
+
+const size_t kPhaseCount = static_cast<size_t>(StartupPhase::Count);
+
+const char* kPhaseNames[] = {
+  "Lifetime",
+  "State",
+  "State::PlatformInit",
+  "GdiplusInit",
+  "COMInit",
+  "DefaultFont",
+  "FirstWindow",
+  "FirstLayout",
+  "FirstPaint",
+};
+
+static_assert(base::size(kPhaseNames) == kPhaseCount,
+              "Names must match StartupPhase");
+
+// Shared by all threads, and intentionally leaked.
+struct StartupRecords {
+  // Whether a scope has started recording the phase, the phases of startup
+  // happen in the scopes of hot paths like layout, so checking this must be
+  // cheap.
+  std::array<std::atomic<bool>, kPhaseCount> claimed = {};
+
+  base::Lock lock;
+  std::array<bool, kPhaseCount> recorded = {};
+  std::array<base::TimeTicks, kPhaseCount> starts;
+  std::array<base::TimeDelta, kPhaseCount> durations;
+};
+
+StartupRecords* GetStartupRecords() {
+  static StartupRecords* records = new StartupRecords;
+  return records;
+}
+
+}  // namespace
+
+StartupStats::StartupStats() {}
+
+StartupStats::StartupStats(const StartupStats& other) = default;
+
+StartupStats::~StartupStats() {}
+
+std::string StartupStats::ToString() const {
+  std::string result;
+  for (const Phase& phase : phases) {
+    base::StringAppendF(&result, "%-20s start %8.2fms  took %8.2fms\n",
+                        phase.name, phase.start.InMillisecondsF(),
+                        phase.duration.InMillisecondsF());
+  }
+  return result;
+}
+
+ScopedStartupPhase::ScopedStartupPhase(StartupPhase phase) : phase_(phase) {
+  std::atomic<bool>& claimed =
+      GetStartupRecords()->claimed[static_cast<size_t>(phase)];
+  // Only the first scope of each phase is recorded.
+  enabled_ = !claimed.load(std::memory_order_relaxed) &&
+             !claimed.exchange(true);
+  if (enabled_)
+    start_ = base::TimeTicks::Now();
+}
+
+ScopedStartupPhase::~ScopedStartupPhase() {
+  if (!enabled_)
+    return;
+  base::TimeDelta duration = base::TimeTicks::Now() - start_;
+  StartupRecords* records = GetStartupRecords();
+  base::AutoLock auto_lock(records->lock);
+  size_t i = static_cast<size_t>(phase_);
+  records->recorded[i] = true;
+  records->starts[i] = start_;
+  records->durations[i] = duration;
+}
+
+StartupStats GetStartupStats() {
+  StartupRecords* records = GetStartupRecords();
+  base::AutoLock auto_lock(records->lock);
+  StartupStats stats;
+  base::TimeTicks origin;
+  for (size_t i = 0; i < kPhaseCount; ++i) {
+    if (records->recorded[i] && (origin.is_null() ||
+                                 records->starts[i] < origin))
+      origin = records->starts[i];
+  }
+  for (size_t i = 0; i < kPhaseCount; ++i) {
+    if (records->recorded[i]) {
+      stats.phases.push_back({kPhaseNames[i], records->starts[i] - origin,
+                              records->durations[i]});
+    }
+  }
+  std::stable_sort(stats.phases.begin(), stats.phases.end(),
+                   [](const auto& a, const auto& b) {
+    return a.start < b.start;
+  });
+  return stats;
+}
+
+}  // namespace nu
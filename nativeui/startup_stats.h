@@ -0,0 +1,69 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_STARTUP_STATS_H_
+#define NATIVEUI_STARTUP_STATS_H_
+
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// The wall-clock time of the phases of startup.
+struct NATIVEUI_EXPORT StartupStats {
+  StartupStats();
+  StartupStats(const StartupStats& other);
+  ~StartupStats();
+
+  struct Phase {
+    const char* name;
+    // The time since the first phase started.
+    base::TimeDelta start;
+    base::TimeDelta duration;
+  };
+
+  // Recorded phases in the order they started.
+  std::vector<Phase> phases;
+
+  // Print the phases as a table, one phase per line.
+  std::string ToString() const;
+};
+
+// Internal: The phases of startup, each phase is only recorded for the first
+// time it happens in the process.
+enum class StartupPhase {
+  Lifetime,            // Lifetime constructor, initializes GTK on Linux.
+  State,               // State constructor.
+  StatePlatformInit,   // NSApplication, common controls, GDI+.
+  GdiplusInit,         // GDI+ on Windows.
+  COMInit,             // COM and OLE on Windows, initialized on demand.
+  DefaultFont,         // Creating the default font.
+  FirstWindow,         // Creating the first window.
+  FirstLayout,         // The first layout of containers.
+  FirstPaint,          // The first paint of windows.
+  Count,
+};
+
+// Internal: Record the time spent in the scope as |phase|, does nothing if the
+// phase has been recorded.
+class NATIVEUI_EXPORT ScopedStartupPhase {
+ public:
+  explicit ScopedStartupPhase(StartupPhase phase);
+  ~ScopedStartupPhase();
+
+ private:
+  StartupPhase phase_;
+  base::TimeTicks start_;
+  bool enabled_;
+};
+
+// Internal: Return the recorded phases.
+StartupStats GetStartupStats();
+
+}  // namespace nu
+
+#endif  // NATIVEUI_STARTUP_STATS_H_
@@ -6,21 +6,41 @@
 
 #include "base/lazy_instance.h"
 #include "base/threading/thread_local.h"
+#include "nativeui/asar_archive.h"
+#include "nativeui/container.h"
+#include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/font.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/image_cache.h"
+#include "nativeui/gfx/text_layout_cache.h"
+#include "nativeui/protocol_cache.h"
 #include "nativeui/protocol_job.h"
 #include "nativeui/screen.h"
+#include "nativeui/table_model.h"
+#include "nativeui/util/frame_clock.h"
+#include "third_party/yoga/YGNode.h"
 #include "third_party/yoga/Yoga.h"
 
+#if defined(BROWSER_SUPPORT)
+#include "nativeui/browser.h"
+#endif
+
 #if defined(OS_WIN)
 #include "base/scoped_native_library.h"
 #include "base/win/scoped_com_initializer.h"
 #include "nativeui/gfx/win/native_theme.h"
 #include "nativeui/win/util/class_registrar.h"
+#include "nativeui/win/util/composition_target.h"
+#include "nativeui/win/util/direct2d_holder.h"
 #include "nativeui/win/util/gdiplus_holder.h"
 #include "nativeui/win/util/scoped_ole_initializer.h"
 #include "nativeui/win/util/subwin_holder.h"
 #include "nativeui/win/util/timer_host.h"
 #include "nativeui/win/util/tray_host.h"
+#if defined(WEBVIEW2_SUPPORT)
+#include "nativeui/win/webview2/webview2_environment.h"
+#endif
 #elif defined(OS_LINUX)
 #include "nativeui/gfx/gtk/gtk_theme.h"
 #endif
@@ -31,6 +51,9 @@ namespace {
 
 State* g_main_state = nullptr;
 
+// Maximum number of yoga nodes kept in the free list.
+const size_t kMaxFreeYogaNodes = 1024;
+
 // A lazily created thread local storage for quick access to a thread's message
 // loop, if one exists. This should be safe and free of static constructors.
 base::LazyInstance<base::ThreadLocalPointer<State>>::Leaky lazy_tls_ptr =
@@ -48,19 +71,43 @@ State* State::GetMain() {
   return g_main_state;
 }
 
+// static
+StartupStats State::GetStartupStats() {
+  return nu::GetStartupStats();
+}
+
 State::State() : yoga_config_(YGConfigNew()) {
   DCHECK_EQ(GetCurrent(), nullptr) << "should only have one state per thread";
+  ScopedStartupPhase startup_phase(StartupPhase::State);
 
   if (!g_main_state)
     g_main_state = this;
   lazy_tls_ptr.Pointer()->Set(this);
-  PlatformInit();
+  {
+    ScopedStartupPhase platform_phase(StartupPhase::StatePlatformInit);
+    PlatformInit();
+  }
 
   for (int i = 0; i < static_cast<int>(Clipboard::Type::Count); ++i)
     clipboards_[i].reset(new Clipboard(static_cast<Clipboard::Type>(i)));
+
+  // Memory pressure is only watched in main thread.
+  if (g_main_state == this)
+    app_.PlatformInit();
 }
 
 State::~State() {
+  recycled_views_.clear();
+  if (g_main_state == this)
+    app_.PlatformDestroy();
+#if defined(BROWSER_SUPPORT)
+  prewarmed_browsers_.clear();
+#endif
+  pending_layouts_.clear();
+  for (YGNodeRef node : free_yoga_nodes_)
+    YGNodeFree(node);
+  for (const auto& it : yoga_configs_)
+    YGConfigFree(it.second);
   YGConfigFree(yoga_config_);
 
   if (g_main_state == this)
@@ -74,6 +121,162 @@ State::~State() {
   base::debug::LeakTracker<ProtocolJob>::CheckForLeaks();
 }
 
+void State::SetLayoutStatsEnabled(bool enabled) {
+  layout_stats_enabled_ = enabled;
+}
+
+void State::ResetLayoutStats() {
+  layout_stats_ = LayoutStats();
+}
+
+void State::SetMessageLoopStatsEnabled(bool enabled) {
+  message_loop_stats_enabled_ = enabled;
+}
+
+void State::ResetMessageLoopStats() {
+  message_loop_stats_ = MessageLoopStats();
+}
+
+void State::SetPaintStatsEnabled(bool enabled) {
+  paint_stats_enabled_ = enabled;
+}
+
+void State::ResetPaintStats() {
+  paint_stats_ = PaintStats();
+}
+
+MemoryReport State::GetMemoryReport() const {
+  MemoryReport report;
+  const auto& views = live_objects_[static_cast<size_t>(LiveObjectType::View)];
+  report.view_count = static_cast<int>(views.size());
+  for (const void* ptr : views)
+    report.views[static_cast<const View*>(ptr)->GetClassName()]++;
+  report.yoga_node_count = YGNodeGetInstanceCount();
+  report.free_yoga_node_count = static_cast<int>(free_yoga_nodes_.size());
+  for (const auto& it : recycled_views_)
+    report.recycled_view_count += static_cast<int>(it.second.size());
+
+  // Images and canvases are estimated as 4 bytes per pixel.
+  for (const void* ptr :
+       live_objects_[static_cast<size_t>(LiveObjectType::Image)]) {
+    auto* image = static_cast<const Image*>(ptr);
+    report.images.count++;
+    if (image->IsEmpty())
+      continue;
+    SizeF size = ScaleSize(image->GetSize(), image->GetScaleFactor());
+    report.images.bytes += static_cast<uint64_t>(size.width()) *
+                           static_cast<uint64_t>(size.height()) * 4;
+  }
+  for (const void* ptr :
+       live_objects_[static_cast<size_t>(LiveObjectType::Canvas)]) {
+    auto* canvas = static_cast<const Canvas*>(ptr);
+    SizeF size = ScaleSize(canvas->GetSize(), canvas->GetScaleFactor());
+    report.canvases.count++;
+    report.canvases.bytes += static_cast<uint64_t>(size.width()) *
+                             static_cast<uint64_t>(size.height()) * 4;
+  }
+  report.fonts.count = static_cast<int>(
+      live_objects_[static_cast<size_t>(LiveObjectType::Font)].size());
+  for (const void* ptr :
+       live_objects_[static_cast<size_t>(LiveObjectType::AttributedText)]) {
+    report.attributed_texts.count++;
+    report.attributed_texts.bytes +=
+        static_cast<const AttributedText*>(ptr)->GetText().size();
+  }
+  for (const void* ptr :
+       live_objects_[static_cast<size_t>(LiveObjectType::TableModel)]) {
+    auto* model = static_cast<const TableModel*>(ptr);
+    report.table_model_count++;
+    report.table_rows += model->GetRowCount();
+    report.table_cells += model->GetStoredCellCount();
+  }
+
+  ProtocolCache* cache = ProtocolCache::GetInstance();
+  report.protocol_cache_entries = static_cast<int>(cache->size());
+  report.protocol_cache_bytes = cache->GetUsage();
+  return report;
+}
+
+void State::TrimCaches(bool critical) {
+  if (image_cache_)
+    image_cache_->OnMemoryPressure(critical);
+  if (text_layout_cache_)
+    text_layout_cache_->OnMemoryPressure(critical);
+  ProtocolCache::GetInstance()->OnMemoryPressure(critical);
+  AsarArchive::ReleaseUnusedArchives();
+  // Yoga nodes in the free list are only kept for reuse.
+  if (critical) {
+    for (YGNodeRef node : free_yoga_nodes_)
+      YGNodeFree(node);
+    free_yoga_nodes_.clear();
+  }
+}
+
+void State::SetLongTaskThreshold(base::TimeDelta threshold) {
+  long_task_threshold_ = threshold;
+}
+
+void State::SetViewRecycleLimit(size_t limit) {
+  view_recycle_limit_ = limit;
+  for (auto& it : recycled_views_) {
+    if (it.second.size() > limit)
+      it.second.resize(limit);
+  }
+}
+
+scoped_refptr<View> State::ReuseView(const char* class_name) {
+  auto it = recycled_views_.find(class_name);
+  if (it == recycled_views_.end() || it->second.empty())
+    return nullptr;
+  scoped_refptr<View> view = std::move(it->second.back());
+  it->second.pop_back();
+  return view;
+}
+
+void State::RecycleView(scoped_refptr<View> view) {
+  if (view_recycle_limit_ == 0 || !view->HasOneRef())
+    return;
+  std::vector<scoped_refptr<View>>& pool =
+      recycled_views_[view->GetClassName()];
+  if (pool.size() >= view_recycle_limit_ || !view->ResetForReuse())
+    return;
+  pool.push_back(std::move(view));
+}
+
+YGConfigRef State::GetYogaConfig(float scale_factor) {
+  auto it = yoga_configs_.find(scale_factor);
+  if (it != yoga_configs_.end())
+    return it->second;
+  YGConfigRef config = YGConfigNew();
+  YGConfigCopy(config, yoga_config_);
+  YGConfigSetPointScaleFactor(config, scale_factor);
+  yoga_configs_[scale_factor] = config;
+  return config;
+}
+
+YGNodeRef State::NewYogaNode(YGConfigRef config) {
+  if (free_yoga_nodes_.empty())
+    return YGNodeNewWithConfig(config);
+  YGNodeRef node = free_yoga_nodes_.back();
+  free_yoga_nodes_.pop_back();
+  node->setConfig(config);
+  return node;
+}
+
+void State::FreeYogaNode(YGNodeRef node) {
+  if (free_yoga_nodes_.size() >= kMaxFreeYogaNodes) {
+    YGNodeFree(node);
+    return;
+  }
+  // A node can only be reset after being detached from the tree.
+  YGNodeRef parent = YGNodeGetParent(node);
+  if (parent)
+    YGNodeRemoveChild(parent, node);
+  YGNodeRemoveAllChildren(node);
+  YGNodeReset(node);
+  free_yoga_nodes_.push_back(node);
+}
+
 Clipboard* State::GetClipboard(Clipboard::Type type) {
   return clipboards_[static_cast<size_t>(type)].get();
 }
@@ -84,4 +287,29 @@ Screen* State::GetScreen() {
   return screen_.get();
 }
 
+TextLayoutCache* State::GetTextLayoutCache() {
+  if (!text_layout_cache_)
+    text_layout_cache_.reset(new TextLayoutCache);
+  return text_layout_cache_.get();
+}
+
+ImageCache* State::GetImageCache() {
+  if (!image_cache_)
+    image_cache_.reset(new ImageCache);
+  return image_cache_.get();
+}
+
+Cursor* State::GetCursor(Cursor::Type type) {
+  scoped_refptr<Cursor>& cursor = interned_cursors_[type];
+  if (!cursor)
+    cursor = new Cursor(type);
+  return cursor.get();
+}
+
+FrameClock* State::GetFrameClock() {
+  if (!frame_clock_)
+    frame_clock_.reset(new FrameClock);
+  return frame_clock_.get();
+}
+
 }  // namespace nu
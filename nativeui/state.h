@@ -6,12 +6,31 @@
 #define NATIVEUI_STATE_H_
 
 #include <array>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
 #include "nativeui/app.h"
+#include "nativeui/cursor.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/gfx/font.h"
+#include "nativeui/layout_stats.h"
+#include "nativeui/memory_report.h"
+#include "nativeui/message_loop_stats.h"
+#include "nativeui/paint_stats.h"
+#include "nativeui/startup_stats.h"
+
+#if defined(OS_WIN)
+#include "nativeui/win/util/window_message_stats.h"
+#endif
 
 typedef struct YGConfig *YGConfigRef;
+typedef struct YGNode *YGNodeRef;
 
 #if defined(OS_WIN)
 namespace base {
@@ -24,17 +43,25 @@ class ScopedCOMInitializer;
 
 namespace nu {
 
-class Font;
+class Browser;
+class Container;
+class FrameClock;
 class Screen;
+class ImageCache;
+class TextLayoutCache;
+class View;
 
 #if defined(OS_WIN)
 class ClassRegistrar;
+class CompositionDevice;
+class Direct2DHolder;
 class GdiplusHolder;
 class NativeTheme;
 class SubwinHolder;
 class ScopedOleInitializer;
 class TrayHost;
 class TimerHost;
+class WebView2Environment;
 #elif defined(OS_LINUX)
 class GtkTheme;
 #endif
@@ -52,12 +79,78 @@ class NATIVEUI_EXPORT State {
   // Return the instance of App.
   App* GetApp() { return &app_; }
 
+  // Record the statistics of layout, which is disabled by default.
+  void SetLayoutStatsEnabled(bool enabled);
+  bool IsLayoutStatsEnabled() const { return layout_stats_enabled_; }
+  const LayoutStats& GetLayoutStats() const { return layout_stats_; }
+  void ResetLayoutStats();
+
+  // Record the statistics of tasks run by the message loop, which is disabled
+  // by default. Only the state of main thread records the statistics.
+  void SetMessageLoopStatsEnabled(bool enabled);
+  bool IsMessageLoopStatsEnabled() const {
+    return message_loop_stats_enabled_;
+  }
+  const MessageLoopStats& GetMessageLoopStats() const {
+    return message_loop_stats_;
+  }
+  void ResetMessageLoopStats();
+
+  // Record the paints of windows, which is disabled by default.
+  void SetPaintStatsEnabled(bool enabled);
+  bool IsPaintStatsEnabled() const { return paint_stats_enabled_; }
+  const PaintStats& GetPaintStats() const { return paint_stats_; }
+  void ResetPaintStats();
+
+#if defined(OS_WIN)
+  // Record the time spent in handling window messages of each window class,
+  // which is disabled by default.
+  void SetWindowMessageStatsEnabled(bool enabled);
+  bool IsWindowMessageStatsEnabled() const {
+    return window_message_stats_enabled_;
+  }
+  const WindowMessageStats& GetWindowMessageStats() const {
+    return window_message_stats_;
+  }
+  void ResetWindowMessageStats();
+#endif
+
+  // Return the time spent in the phases of startup, which is shared by all
+  // threads.
+  static StartupStats GetStartupStats();
+
+  // Return the live objects and their estimated bytes of current thread.
+  MemoryReport GetMemoryReport() const;
+
+  // Tasks running longer than the threshold are reported as long tasks, the
+  // default is 50ms.
+  void SetLongTaskThreshold(base::TimeDelta threshold);
+  base::TimeDelta GetLongTaskThreshold() const { return long_task_threshold_; }
+
+  // Keep the views removed from containers in a pool, and reuse them when
+  // creating views of the same class, at most |limit| views are kept for each
+  // class. Only Container and Label are recycled, and the default limit is 0
+  // which disables recycling.
+  void SetViewRecycleLimit(size_t limit);
+  size_t GetViewRecycleLimit() const { return view_recycle_limit_; }
+
+  // Take a view of |class_name| from the pool, returns null if there is none.
+  scoped_refptr<View> ReuseView(const char* class_name);
+
+  // Internal: Put |view| into the pool if nothing else references it.
+  void RecycleView(scoped_refptr<View> view);
+
   // Internal classes.
 #if defined(OS_WIN)
   void InitializeCOM();
   bool InitWebView2Loader();
+#if defined(WEBVIEW2_SUPPORT)
+  WebView2Environment* GetWebView2Environment();
+#endif
   HWND GetSubwinHolder();
   ClassRegistrar* GetClassRegistrar();
+  Direct2DHolder* GetDirect2DHolder();
+  CompositionDevice* GetCompositionDevice();
   NativeTheme* GetNativeTheme();
   TrayHost* GetTrayHost();
   TimerHost* GetTimerHost();
@@ -72,15 +165,99 @@ class NATIVEUI_EXPORT State {
   // Internal: Return the screen object
   Screen* GetScreen();
 
+  // Internal: Return the cache of texts created from plain strings.
+  TextLayoutCache* GetTextLayoutCache();
+
+  // Internal: Return the cache of decoded images.
+  ImageCache* GetImageCache();
+
+  // Internal: Return the interned cursor of |type|.
+  Cursor* GetCursor(Cursor::Type type);
+
+  // Internal: Return the clock driving animations.
+  FrameClock* GetFrameClock();
+
+  // Internal: Fonts created by Font::Get, the fonts are not referenced and
+  // remove themselves on destruction.
+  std::map<Font::CacheKey, Font*>& interned_fonts() { return interned_fonts_; }
+
   // Internal: Return the default font.
   scoped_refptr<Font>& default_font() { return default_font_; }
 
+  // Internal: Colors parsed by Color::FromHexCached.
+  std::unordered_map<std::string, Color>& parsed_colors() {
+    return parsed_colors_;
+  }
+
   // Internal: Return the default yoga config.
   YGConfigRef yoga_config() const { return yoga_config_; }
 
+  // Internal: Return the yoga config shared by views under |scale_factor|.
+  YGConfigRef GetYogaConfig(float scale_factor);
+
+  // Internal: Take a yoga node from the free list, or create a new one.
+  YGNodeRef NewYogaNode(YGConfigRef config);
+
+  // Internal: Reset the yoga node and put it into the free list.
+  void FreeYogaNode(YGNodeRef node);
+
+  // Internal: Return the mutable layout statistics.
+  LayoutStats* layout_stats() { return &layout_stats_; }
+
+  // Internal: Return the mutable message loop statistics.
+  MessageLoopStats* message_loop_stats() { return &message_loop_stats_; }
+
+  // Internal: Return the mutable paint statistics.
+  PaintStats* paint_stats() { return &paint_stats_; }
+
+  // Internal: The timer of the paint in progress.
+  ScopedPaintTimer*& paint_timer() { return paint_timer_; }
+
+#if defined(OS_WIN)
+  // Internal: Return the mutable window message statistics.
+  WindowMessageStats* window_message_stats() { return &window_message_stats_; }
+
+  // Internal: The timer of the innermost window message being handled.
+  ScopedMessageTimer*& message_timer() { return message_timer_; }
+#endif
+
+  // Internal: The live objects of |type| created in current thread.
+  std::unordered_set<const void*>& live_objects(LiveObjectType type) {
+    return live_objects_[static_cast<size_t>(type)];
+  }
+
+  // Internal: The nested level of LayoutTransaction.
+  int& layout_transaction_depth() { return layout_transaction_depth_; }
+
+  // Internal: Containers whose layouts are deferred by LayoutTransaction.
+  std::vector<scoped_refptr<Container>>& pending_layouts() {
+    return pending_layouts_;
+  }
+
+  // Internal: Whether layouts are deferred to next tick of message loop.
+  bool& defer_layout() { return defer_layout_; }
+
+  // Internal: Whether a task has been posted to do deferred layouts.
+  bool& layout_flush_scheduled() { return layout_flush_scheduled_; }
+
+#if defined(BROWSER_SUPPORT)
+  // Internal: Browsers created by Browser::Prewarm and waiting to be taken.
+  std::vector<scoped_refptr<Browser>>& prewarmed_browsers() {
+    return prewarmed_browsers_;
+  }
+#endif
+
  private:
+  friend class App;
+
   void PlatformInit();
 
+  // Create the lazily initialized platform resources, called by App::Prewarm.
+  void PlatformPrewarm();
+
+  // Release memory kept by caches, called by App::NotifyMemoryPressure.
+  void TrimCaches(bool critical);
+
 #if defined(OS_WIN)
   std::unique_ptr<base::win::ScopedCOMInitializer> com_initializer_;
   std::unique_ptr<base::ScopedNativeLibrary> webview2_loader_;
@@ -88,9 +265,14 @@ class NATIVEUI_EXPORT State {
   std::unique_ptr<GdiplusHolder> gdiplus_holder_;
   std::unique_ptr<ClassRegistrar> class_registrar_;
   std::unique_ptr<SubwinHolder> subwin_holder_;
+  std::unique_ptr<Direct2DHolder> direct2d_holder_;
+  std::unique_ptr<CompositionDevice> composition_device_;
   std::unique_ptr<NativeTheme> native_theme_;
   std::unique_ptr<TrayHost> tray_host_;
   std::unique_ptr<TimerHost> timer_host_;
+#if defined(WEBVIEW2_SUPPORT)
+  std::unique_ptr<WebView2Environment> webview2_environment_;
+#endif
 
   // Next ID for custom WM_COMMAND items, the number came from:
   // https://msdn.microsoft.com/en-us/library/11861byt.aspx
@@ -107,11 +289,55 @@ class NATIVEUI_EXPORT State {
 
   std::unique_ptr<Screen> screen_;
   scoped_refptr<Font> default_font_;
+  std::map<Font::CacheKey, Font*> interned_fonts_;
+  std::unordered_map<std::string, Color> parsed_colors_;
+  std::unique_ptr<TextLayoutCache> text_layout_cache_;
+  std::unique_ptr<ImageCache> image_cache_;
+  std::map<Cursor::Type, scoped_refptr<Cursor>> interned_cursors_;
 
   // The app instance.
   App app_;
 
   YGConfigRef yoga_config_;
+  std::map<float, YGConfigRef> yoga_configs_;
+  std::vector<YGNodeRef> free_yoga_nodes_;
+
+  // Recycled views keyed by the class names.
+  size_t view_recycle_limit_ = 0;
+  std::map<const char*, std::vector<scoped_refptr<View>>> recycled_views_;
+
+  bool layout_stats_enabled_ = false;
+  LayoutStats layout_stats_;
+
+  // Read when posting tasks from other threads.
+  std::atomic<bool> message_loop_stats_enabled_{false};
+  MessageLoopStats message_loop_stats_;
+  base::TimeDelta long_task_threshold_ = base::TimeDelta::FromMilliseconds(50);
+
+  bool paint_stats_enabled_ = false;
+  PaintStats paint_stats_;
+  ScopedPaintTimer* paint_timer_ = nullptr;
+
+#if defined(OS_WIN)
+  bool window_message_stats_enabled_ = false;
+  WindowMessageStats window_message_stats_;
+  ScopedMessageTimer* message_timer_ = nullptr;
+#endif
+
+  std::array<std::unordered_set<const void*>,
+             static_cast<size_t>(LiveObjectType::Count)> live_objects_;
+
+  int layout_transaction_depth_ = 0;
+  std::vector<scoped_refptr<Container>> pending_layouts_;
+  bool defer_layout_ = false;
+  bool layout_flush_scheduled_ = false;
+
+#if defined(BROWSER_SUPPORT)
+  std::vector<scoped_refptr<Browser>> prewarmed_browsers_;
+#endif
+
+  // Destroyed first as it may hold a timer.
+  std::unique_ptr<FrameClock> frame_clock_;
 
   DISALLOW_COPY_AND_ASSIGN(State);
 };
@@ -0,0 +1,44 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/style_sheet.h"
+
+#include "nativeui/view.h"
+
+namespace nu {
+
+StyleSheet::StyleSheet() {}
+
+StyleSheet::~StyleSheet() {}
+
+void StyleSheet::SetProperty(const std::string& name,
+                             const std::string& value) {
+  std::string key(ParseStyleName(name));
+  if (key == "color") {
+    color_ = Color(value);
+  } else if (key == "backgroundcolor") {
+    background_color_ = Color(value);
+  } else {
+    YogaProperty property;
+    if (ParseYogaProperty(key, value, &property))
+      properties_.push_back(property);
+  }
+}
+
+void StyleSheet::SetProperty(const std::string& name, float value) {
+  YogaProperty property;
+  if (ParseYogaProperty(ParseStyleName(name), value, &property))
+    properties_.push_back(property);
+}
+
+void StyleSheet::ApplyTo(View* view) const {
+  if (color_)
+    view->SetColor(*color_);
+  if (background_color_)
+    view->SetBackgroundColor(*background_color_);
+  for (const YogaProperty& property : properties_)
+    ApplyYogaProperty(view->node(), property);
+}
+
+}  // namespace nu
@@ -0,0 +1,46 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_STYLE_SHEET_H_
+#define NATIVEUI_STYLE_SHEET_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/optional.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/util/yoga_util.h"
+
+namespace nu {
+
+class View;
+
+// A list of style properties that are parsed once, and can be applied to many
+// views without doing string lookups and conversions again.
+class NATIVEUI_EXPORT StyleSheet : public base::RefCounted<StyleSheet> {
+ public:
+  StyleSheet();
+
+  // Add style properties, invalid properties are ignored.
+  void SetProperty(const std::string& name, const std::string& value);
+  void SetProperty(const std::string& name, float value);
+
+  // Internal: Apply the styles to |view| without doing layout.
+  void ApplyTo(View* view) const;
+
+ protected:
+  virtual ~StyleSheet();
+
+ private:
+  friend class base::RefCounted<StyleSheet>;
+
+  std::vector<YogaProperty> properties_;
+  base::Optional<Color> color_;
+  base::Optional<Color> background_color_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_STYLE_SHEET_H_
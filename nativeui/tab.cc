@@ -4,8 +4,11 @@
 
 #include "nativeui/tab.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "nativeui/container.h"
+
 namespace nu {
 
 // static
@@ -34,11 +37,76 @@ void Tab::RemovePage(View* view) {
     return;
   PlatformRemovePage(it - pages_.begin(), view);
   (*it)->SetParent(nullptr);
+  factories_.erase(view);
+  loaded_pages_.remove(static_cast<Container*>(view));
   pages_.erase(it);
 }
 
+void Tab::AddLazyPage(const std::string& title, PageFactory factory) {
+  scoped_refptr<Container> page = new Container;
+  factories_[page.get()] = std::move(factory);
+  AddPage(title, page);
+  // The first page is selected by default.
+  if (GetSelectedPage() == page.get())
+    LoadPage(PageCount() - 1);
+}
+
+bool Tab::IsPageLoaded(int index) const {
+  View* page = PageAt(index);
+  if (!page)
+    return false;
+  if (factories_.find(page) == factories_.end())
+    return true;
+  return static_cast<Container*>(page)->ChildCount() > 0;
+}
+
+void Tab::SetMaxLoadedPages(int max) {
+  max_loaded_pages_ = std::max(0, max);
+  UnloadOldPages();
+}
+
+void Tab::NotifyPageSelected(int index) {
+  LoadPage(index);
+  on_selected_page_change.Emit(this);
+}
+
 const char* Tab::GetClassName() const {
   return kClassName;
 }
 
+void Tab::LoadPage(int index) {
+  auto it = factories_.find(PageAt(index));
+  if (it == factories_.end())
+    return;
+  auto* page = static_cast<Container*>(it->first);
+  loaded_pages_.remove(page);
+  loaded_pages_.push_front(page);
+  if (page->ChildCount() == 0) {
+    scoped_refptr<View> view = it->second();
+    if (view) {
+      view->SetStyle("flex", 1.f);
+      page->AddChildView(view.get());
+    }
+  }
+  UnloadOldPages();
+}
+
+void Tab::UnloadOldPages() {
+  if (max_loaded_pages_ == 0)
+    return;
+  while (loaded_pages_.size() > static_cast<size_t>(max_loaded_pages_)) {
+    Container* page = loaded_pages_.back();
+    loaded_pages_.pop_back();
+    // Never unload the page being shown.
+    if (page == GetSelectedPage()) {
+      loaded_pages_.push_front(page);
+      if (loaded_pages_.size() == 1)
+        break;
+      continue;
+    }
+    while (page->ChildCount() > 0)
+      page->RemoveChildView(page->ChildAt(0));
+  }
+}
+
 }  // namespace nu
@@ -5,15 +5,22 @@
 #ifndef NATIVEUI_TAB_H_
 #define NATIVEUI_TAB_H_
 
+#include <functional>
+#include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "nativeui/view.h"
 
 namespace nu {
 
+class Container;
+
 class NATIVEUI_EXPORT Tab : public View {
  public:
+  using PageFactory = std::function<scoped_refptr<View>()>;
+
   Tab();
 
   // View class name.
@@ -22,6 +29,21 @@ class NATIVEUI_EXPORT Tab : public View {
   void AddPage(const std::string& title, scoped_refptr<View> view);
   void RemovePage(View* view);
 
+  // Add a page whose view is only created by |factory| when the page is
+  // selected for the first time. The page itself is an empty Container that
+  // holds the created view.
+  void AddLazyPage(const std::string& title, PageFactory factory);
+
+  // Return whether the view of page has been created, normal pages are
+  // always loaded.
+  bool IsPageLoaded(int index) const;
+
+  // Destroy the views of least recently selected lazy pages when more than
+  // |max| lazy pages are loaded, they are created again when selected.
+  // 0 means never unloading.
+  void SetMaxLoadedPages(int max);
+  int GetMaxLoadedPages() const { return max_loaded_pages_; }
+
   int PageCount() const { return static_cast<int>(pages_.size()); }
   View* PageAt(int index) const {
     if (index < 0 || static_cast<size_t>(index) >= pages_.size())
@@ -37,6 +59,10 @@ class NATIVEUI_EXPORT Tab : public View {
   const char* GetClassName() const override;
   SizeF GetMinimumSize() const override;
 
+  // Internal: Called by platform implementations when the page at |index|
+  // is selected.
+  void NotifyPageSelected(int index);
+
   // Events.
   Signal<void(Tab*)> on_selected_page_change;
 
@@ -48,7 +74,17 @@ class NATIVEUI_EXPORT Tab : public View {
   void PlatformAddPage(const std::string& title, View* view);
   void PlatformRemovePage(int index, View* view);
 
+  // Create the view of lazy page and unload old pages.
+  void LoadPage(int index);
+  void UnloadOldPages();
+
   std::vector<scoped_refptr<View>> pages_;
+
+  // The factories of lazy pages.
+  std::unordered_map<View*, PageFactory> factories_;
+  // Loaded lazy pages, the most recently selected first.
+  std::list<Container*> loaded_pages_;
+  int max_loaded_pages_ = 0;
 };
 
 }  // namespace nu
@@ -62,3 +62,30 @@ TEST_F(TabTest, SelectPageShouldEmitEvent) {
   tab_->SelectPageAt(1);
   EXPECT_TRUE(emitted);
 }
+
+TEST_F(TabTest, LazyPage) {
+  int created = 0;
+  auto factory = [&created]() -> scoped_refptr<nu::View> {
+    ++created;
+    return new nu::Container;
+  };
+  tab_->AddLazyPage("Tab 1", factory);
+  tab_->AddLazyPage("Tab 2", factory);
+  tab_->AddLazyPage("Tab 3", factory);
+  EXPECT_EQ(created, 1);
+  EXPECT_TRUE(tab_->IsPageLoaded(0));
+  EXPECT_FALSE(tab_->IsPageLoaded(1));
+  tab_->SelectPageAt(1);
+  EXPECT_EQ(created, 2);
+  EXPECT_TRUE(tab_->IsPageLoaded(1));
+}
+
+TEST_F(TabTest, UnloadLazyPage) {
+  tab_->SetMaxLoadedPages(1);
+  auto factory = []() -> scoped_refptr<nu::View> { return new nu::Container; };
+  tab_->AddLazyPage("Tab 1", factory);
+  tab_->AddLazyPage("Tab 2", factory);
+  tab_->SelectPageAt(1);
+  EXPECT_FALSE(tab_->IsPageLoaded(0));
+  EXPECT_TRUE(tab_->IsPageLoaded(1));
+}
@@ -10,6 +10,13 @@
 
 namespace nu {
 
+namespace {
+
+// The minimum interval in milliseconds between on_visible_range_change.
+const int kVisibleRangeInterval = 50;
+
+}  // namespace
+
 // static
 const char Table::kClassName[] = "Table";
 
@@ -36,6 +43,7 @@ void Table::SetModel(scoped_refptr<TableModel> model) {
   model_ = std::move(model);
   if (model_)
     model_->Subscribe(this);
+  OnVisibleRangeMayChange();
 }
 
 TableModel* Table::GetModel() {
@@ -46,8 +54,36 @@ void Table::AddColumn(const std::string& title) {
   AddColumnWithOptions(title, ColumnOptions());
 }
 
+void Table::ScrollToRow(int row, ScrollAlign align) {
+  if (!model_ || row < 0 ||
+      static_cast<uint32_t>(row) >= model_->GetRowCount())
+    return;
+  PlatformScrollToRow(row, align);
+  OnVisibleRangeMayChange();
+}
+
 const char* Table::GetClassName() const {
   return kClassName;
 }
 
+void Table::OnVisibleRangeMayChange() {
+  if (visible_range_timer_ || on_visible_range_change.IsEmpty())
+    return;
+  // Keep a reference so the table is alive when the timer fires.
+  scoped_refptr<Table> self(this);
+  visible_range_timer_ = MessageLoop::SetTimeout(
+      kVisibleRangeInterval, [self]() {
+    self->visible_range_timer_ = 0;
+    self->FlushVisibleRange();
+  });
+}
+
+void Table::FlushVisibleRange() {
+  std::tuple<int, int> range = GetVisibleRowRange();
+  if (range == visible_range_)
+    return;
+  visible_range_ = range;
+  on_visible_range_change.Emit(this);
+}
+
 }  // namespace nu
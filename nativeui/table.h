@@ -6,6 +6,7 @@
 #define NATIVEUI_TABLE_H_
 
 #include <string>
+#include <tuple>
 
 #include "nativeui/view.h"
 
@@ -26,6 +27,14 @@ class NATIVEUI_EXPORT Table : public View {
     Custom,
   };
 
+  // Where to put the row when scrolling to it.
+  enum class ScrollAlign {
+    Nearest,  // scroll as little as possible to make the row visible
+    Start,
+    Center,
+    End,
+  };
+
   struct NATIVEUI_EXPORT ColumnOptions {
     ColumnOptions();
     ColumnOptions(const ColumnOptions& other);
@@ -58,25 +67,47 @@ class NATIVEUI_EXPORT Table : public View {
   void SelectRow(int row);
   int GetSelectedRow() const;
 
+  // Return the first visible row and the row after the last visible one,
+  // (-1, -1) is returned when there is no visible row.
+  std::tuple<int, int> GetVisibleRowRange() const;
+  void ScrollToRow(int row, ScrollAlign align);
+
   // View:
   const char* GetClassName() const override;
 
+  // Internal: Called when the visible rows may have changed, changes are
+  // coalesced so on_visible_range_change is not emitted for every scroll.
+  void OnVisibleRangeMayChange();
+
+  // Events.
+  Signal<void(Table*)> on_visible_range_change;
+
  protected:
   ~Table() override;
 
   NativeView PlatformCreate();
   void PlatformDestroy();
   void PlatformSetModel(TableModel* model);
+  void PlatformScrollToRow(int row, ScrollAlign align);
 
  private:
   friend class TableModel;
 
   // Called by TableModel.
-  void NotifyRowInsertion(uint32_t row);
-  void NotifyRowDeletion(uint32_t row);
+  void NotifyRowsInserted(uint32_t start, uint32_t count);
+  void NotifyRowsDeleted(uint32_t start, uint32_t count);
+  void NotifyRangeChanged(uint32_t start, uint32_t count);
   void NotifyValueChange(uint32_t column, uint32_t row);
+  void NotifyReset();
+
+  // Emit on_visible_range_change if the range has changed.
+  void FlushVisibleRange();
 
   scoped_refptr<TableModel> model_;
+
+  // The range notified in last on_visible_range_change.
+  std::tuple<int, int> visible_range_ = std::make_tuple(-1, -1);
+  MessageLoop::TimerId visible_range_timer_ = 0;
 };
 
 }  // namespace nu
@@ -0,0 +1,41 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/table_cell_cache.h"
+
+#include "nativeui/gfx/painter.h"
+
+namespace nu {
+
+TableCellCache::TableCellCache(const Table::ColumnOptions& options)
+    : options_(options), cells_(kMaxCells) {}
+
+TableCellCache::~TableCellCache() {}
+
+void TableCellCache::DrawCell(Painter* painter, uint32_t row,
+                              const RectF& rect, float scale_factor,
+                              const base::Value& value) {
+  if (!options_.on_draw || rect.IsEmpty())
+    return;
+  auto it = cells_.Get(row);
+  if (it == cells_.end() ||
+      it->second.value != value ||
+      it->second.size != rect.size() ||
+      it->second.scale_factor != scale_factor) {
+    Cell cell;
+    cell.value = value.Clone();
+    cell.size = rect.size();
+    cell.scale_factor = scale_factor;
+    cell.canvas = new Canvas(rect.size(), scale_factor);
+    options_.on_draw(cell.canvas->GetPainter(), RectF(rect.size()), value);
+    it = cells_.Put(row, std::move(cell));
+  }
+  painter->DrawCanvas(it->second.canvas.get(), rect);
+}
+
+void TableCellCache::Clear() {
+  cells_.Clear();
+}
+
+}  // namespace nu
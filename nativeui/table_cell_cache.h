@@ -0,0 +1,57 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TABLE_CELL_CACHE_H_
+#define NATIVEUI_TABLE_CELL_CACHE_H_
+
+#include "base/containers/mru_cache.h"
+#include "base/memory/ref_counted.h"
+#include "base/values.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/table.h"
+
+namespace nu {
+
+// Keeps the drawings of custom cells in one column of Table as bitmaps.
+//
+// The on_draw handler only depends on the value and size of cell, so a cell
+// is only drawn again when its value or size changes, and repainting for
+// scrolling, hovering and selection just copies the bitmaps.
+class NATIVEUI_EXPORT TableCellCache
+    : public base::RefCounted<TableCellCache> {
+ public:
+  // Enough to cover the visible rows of a column on large screens.
+  static const size_t kMaxCells = 256;
+
+  explicit TableCellCache(const Table::ColumnOptions& options);
+
+  // Draw the cell of |row| at |rect|, the on_draw handler is only called when
+  // there is no cached drawing of the |value|.
+  void DrawCell(Painter* painter, uint32_t row, const RectF& rect,
+                float scale_factor, const base::Value& value);
+
+  void Clear();
+  size_t size() const { return cells_.size(); }
+
+ private:
+  friend class base::RefCounted<TableCellCache>;
+
+  ~TableCellCache();
+
+  struct Cell {
+    base::Value value;
+    SizeF size;
+    float scale_factor;
+    scoped_refptr<Canvas> canvas;
+  };
+
+  Table::ColumnOptions options_;
+  base::MRUCache<uint32_t, Cell> cells_;
+
+  DISALLOW_COPY_AND_ASSIGN(TableCellCache);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TABLE_CELL_CACHE_H_
@@ -4,10 +4,14 @@
 
 #include "nativeui/table_model.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "base/logging.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/table.h"
+#include "nativeui/table_model_view.h"
 
 namespace nu {
 
@@ -18,19 +22,68 @@ TableModel::TableModel() {}
 
 TableModel::~TableModel() {}
 
+uint64_t TableModel::GetStoredCellCount() const {
+  return 0;
+}
+
 void TableModel::NotifyRowInsertion(uint32_t row) {
-  for (Table* table : tables_)
-    table->NotifyRowInsertion(row);
+  NotifyRowsInserted(row, 1);
 }
 
 void TableModel::NotifyRowDeletion(uint32_t row) {
-  for (Table* table : tables_)
-    table->NotifyRowDeletion(row);
+  NotifyRowsDeleted(row, 1);
 }
 
 void TableModel::NotifyValueChange(uint32_t column, uint32_t row) {
+  OnNotify();
   for (Table* table : tables_)
     table->NotifyValueChange(column, row);
+  for (TableModelView* view : views_)
+    view->OnSourceValueChange(column, row);
+}
+
+void TableModel::NotifyRowsInserted(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  OnNotify();
+  for (Table* table : tables_) {
+    table->NotifyRowsInserted(start, count);
+    table->OnVisibleRangeMayChange();
+  }
+  for (TableModelView* view : views_)
+    view->OnSourceRowsInserted(start, count);
+}
+
+void TableModel::NotifyRowsDeleted(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  OnNotify();
+  for (Table* table : tables_) {
+    table->NotifyRowsDeleted(start, count);
+    table->OnVisibleRangeMayChange();
+  }
+  for (TableModelView* view : views_)
+    view->OnSourceRowsDeleted(start, count);
+}
+
+void TableModel::NotifyRangeChanged(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  OnNotify();
+  for (Table* table : tables_)
+    table->NotifyRangeChanged(start, count);
+  for (TableModelView* view : views_)
+    view->OnSourceRangeChanged(start, count);
+}
+
+void TableModel::NotifyReset() {
+  OnNotify();
+  for (Table* table : tables_) {
+    table->NotifyReset();
+    table->OnVisibleRangeMayChange();
+  }
+  for (TableModelView* view : views_)
+    view->OnSourceReset();
 }
 
 void TableModel::Subscribe(Table* view) {
@@ -41,11 +94,26 @@ void TableModel::Unsubscribe(Table* view) {
   tables_.remove(view);
 }
 
+void TableModel::AddView(TableModelView* view) {
+  views_.push_back(view);
+}
+
+void TableModel::RemoveView(TableModelView* view) {
+  views_.remove(view);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // AbstractTableModel implementation.
 
+namespace {
+
+// Enough to cover the visible rows of a few tables on large screens.
+const size_t kMaxCachedPages = 8;
+
+}  // namespace
+
 AbstractTableModel::AbstractTableModel(bool index_starts_from_0)
-    : index_starts_from_0_(index_starts_from_0) {}
+    : index_starts_from_0_(index_starts_from_0), pages_(kMaxCachedPages) {}
 
 AbstractTableModel::~AbstractTableModel() {}
 
@@ -57,6 +125,13 @@ uint32_t AbstractTableModel::GetRowCount() const {
 
 const base::Value* AbstractTableModel::GetValue(
     uint32_t column, uint32_t row) const {
+  if (get_rows) {
+    const Page& page = GetPage(row / kRowsPerPage);
+    uint32_t index = row % kRowsPerPage;
+    if (index >= page.size() || column >= page[index].size())
+      return nullptr;
+    return &page[index][column];
+  }
   if (!get_value)
     return nullptr;
   if (!index_starts_from_0_) {
@@ -80,6 +155,174 @@ void AbstractTableModel::SetValue(uint32_t column, uint32_t row,
   }
   set_value(const_cast<AbstractTableModel*>(this),
             column, row, std::move(value));
+  // The cached row is no longer valid.
+  pages_.Clear();
+}
+
+void AbstractTableModel::OnNotify() {
+  pages_.Clear();
+}
+
+const AbstractTableModel::Page& AbstractTableModel::GetPage(
+    uint32_t page) const {
+  auto it = pages_.Get(page);
+  if (it != pages_.end())
+    return it->second;
+  uint32_t start = page * kRowsPerPage;
+  if (!index_starts_from_0_)
+    start += 1;
+  auto* self = const_cast<AbstractTableModel*>(this);
+  return pages_.Put(page, get_rows(self, start, kRowsPerPage))->second;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PagedTableModel implementation.
+
+PagedTableModel::PagedTableModel(uint32_t row_count,
+                                 uint32_t page_size,
+                                 bool index_starts_from_0)
+    : row_count_(row_count),
+      page_size_(std::max(page_size, 1u)),
+      index_starts_from_0_(index_starts_from_0),
+      max_cached_pages_(kDefaultMaxCachedPages),
+      pages_(base::MRUCache<uint32_t, std::vector<Row>>::NO_AUTO_EVICT),
+      weak_factory_(this) {}
+
+PagedTableModel::~PagedTableModel() {}
+
+void PagedTableModel::SetRowCount(uint32_t count) {
+  if (count == row_count_)
+    return;
+  uint32_t old_count = row_count_;
+  row_count_ = count;
+  // Drop pages out of range, and the last page which has changed size.
+  uint32_t last_page = std::min(old_count, count) / page_size_;
+  for (auto it = pages_.begin(); it != pages_.end();) {
+    if (it->first >= last_page)
+      it = pages_.Erase(it);
+    else
+      ++it;
+  }
+  for (auto it = loading_.begin(); it != loading_.end();) {
+    if (*it >= last_page)
+      it = loading_.erase(it);
+    else
+      ++it;
+  }
+  if (count > old_count)
+    NotifyRowsInserted(old_count, count - old_count);
+  else
+    NotifyRowsDeleted(count, old_count - count);
+}
+
+bool PagedTableModel::SetRows(uint32_t start, std::vector<Row> rows) {
+  if (!index_starts_from_0_)
+    start -= 1;
+  uint32_t page = start / page_size_;
+  if (start % page_size_ != 0 || loading_.erase(page) == 0)
+    return false;
+  uint32_t count = std::min(static_cast<uint32_t>(rows.size()),
+                            row_count_ - start);
+  pages_.Put(page, std::move(rows));
+  pages_.ShrinkToSize(max_cached_pages_);
+  NotifyRangeChanged(start, count);
+  return true;
+}
+
+void PagedTableModel::SetPlaceholder(base::Value value) {
+  placeholder_ = std::move(value);
+}
+
+void PagedTableModel::SetMaxCachedPages(size_t count) {
+  max_cached_pages_ = std::max(count, static_cast<size_t>(1));
+  pages_.ShrinkToSize(max_cached_pages_);
+}
+
+void PagedTableModel::Invalidate() {
+  pages_.Clear();
+  loading_.clear();
+  requested_.clear();
+  NotifyReset();
+}
+
+bool PagedTableModel::IsRowLoaded(uint32_t row) const {
+  return pages_.Peek(row / page_size_) != pages_.end();
+}
+
+uint32_t PagedTableModel::GetRowCount() const {
+  return row_count_;
+}
+
+const base::Value* PagedTableModel::GetValue(uint32_t column,
+                                             uint32_t row) const {
+  if (row >= row_count_)
+    return nullptr;
+  uint32_t page = row / page_size_;
+  auto it = pages_.Get(page);
+  if (it == pages_.end()) {
+    RequestPage(page);
+    return &placeholder_;
+  }
+  // Prefetch the pages around so scrolling does not show placeholders.
+  if (page > 0)
+    RequestPage(page - 1);
+  if (page + 1 < GetPageCount())
+    RequestPage(page + 1);
+  const std::vector<Row>& rows = it->second;
+  uint32_t index = row % page_size_;
+  if (index >= rows.size() || column >= rows[index].size())
+    return &placeholder_;
+  return &rows[index][column];
+}
+
+void PagedTableModel::SetValue(uint32_t column, uint32_t row,
+                               base::Value value) {
+  if (row >= row_count_)
+    return;
+  auto it = pages_.Peek(row / page_size_);
+  if (it == pages_.end())
+    return;
+  std::vector<Row>& rows = it->second;
+  uint32_t index = row % page_size_;
+  if (index >= rows.size() || column >= rows[index].size())
+    return;
+  rows[index][column] = std::move(value);
+  NotifyValueChange(column, row);
+}
+
+void PagedTableModel::RequestPage(uint32_t page) const {
+  if (pages_.Peek(page) != pages_.end() || !loading_.insert(page).second)
+    return;
+  requested_.push_back(page);
+  if (requested_.size() > 1)
+    return;
+  base::WeakPtr<PagedTableModel> weak_ptr =
+      const_cast<PagedTableModel*>(this)->weak_factory_.GetWeakPtr();
+  MessageLoop::PostTask([weak_ptr]() {
+    if (weak_ptr)
+      weak_ptr->LoadRequestedPages();
+  });
+}
+
+void PagedTableModel::LoadRequestedPages() {
+  std::vector<uint32_t> pages;
+  pages.swap(requested_);
+  for (uint32_t page : pages) {
+    // The page may have been dropped by Invalidate.
+    if (loading_.find(page) == loading_.end())
+      continue;
+    if (!load_rows) {
+      loading_.erase(page);
+      continue;
+    }
+    uint32_t start = page * page_size_;
+    uint32_t count = std::min(page_size_, row_count_ - start);
+    load_rows(this, index_starts_from_0_ ? start : start + 1, count);
+  }
+}
+
+uint32_t PagedTableModel::GetPageCount() const {
+  return (row_count_ + page_size_ - 1) / page_size_;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -107,6 +350,28 @@ void SimpleTableModel::RemoveRowAt(uint32_t row) {
   }
 }
 
+void SimpleTableModel::AddRows(std::vector<Row> rows) {
+  uint32_t start = static_cast<uint32_t>(rows_.size());
+  rows_.reserve(rows_.size() + rows.size());
+  for (Row& data : rows) {
+    if (data.size() >= columns_)
+      rows_.emplace_back(std::move(data));
+    else
+      LOG(ERROR) << "AddRows skipped a row whose length is less than column "
+                    "size.";
+  }
+  NotifyRowsInserted(start, static_cast<uint32_t>(rows_.size()) - start);
+}
+
+void SimpleTableModel::RemoveRowsAt(uint32_t start, uint32_t count) {
+  if (start < rows_.size() && count <= rows_.size() - start) {
+    rows_.erase(rows_.begin() + start, rows_.begin() + start + count);
+    NotifyRowsDeleted(start, count);
+  } else {
+    LOG(ERROR) << "RemoveRows failed because rows are not in model.";
+  }
+}
+
 uint32_t SimpleTableModel::GetRowCount() const {
   return static_cast<uint32_t>(rows_.size());
 }
@@ -126,4 +391,206 @@ void SimpleTableModel::SetValue(uint32_t column, uint32_t row,
   }
 }
 
+uint64_t SimpleTableModel::GetStoredCellCount() const {
+  return static_cast<uint64_t>(rows_.size()) * columns_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ColumnarTableModel implementation.
+
+ColumnarTableModel::ColumnarTableModel(std::vector<ColumnType> columns) {
+  columns_.reserve(columns.size());
+  for (ColumnType type : columns)
+    columns_.emplace_back(type);
+  // The empty string is used for mismatched values.
+  Intern(std::string());
+}
+
+ColumnarTableModel::~ColumnarTableModel() {}
+
+void ColumnarTableModel::AddRow(Row data) {
+  for (size_t i = 0; i < columns_.size(); ++i)
+    Append(&columns_[i], i < data.size() ? data[i] : base::Value());
+  NotifyRowsInserted(row_count_++, 1);
+}
+
+void ColumnarTableModel::AddRows(std::vector<Row> rows) {
+  Reserve(row_count_ + static_cast<uint32_t>(rows.size()));
+  // Fill column by column so each buffer is written sequentially.
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    for (const Row& data : rows)
+      Append(&columns_[i], i < data.size() ? data[i] : base::Value());
+  }
+  uint32_t start = row_count_;
+  row_count_ += static_cast<uint32_t>(rows.size());
+  NotifyRowsInserted(start, row_count_ - start);
+}
+
+void ColumnarTableModel::RemoveRowAt(uint32_t row) {
+  RemoveRowsAt(row, 1);
+}
+
+void ColumnarTableModel::RemoveRowsAt(uint32_t start, uint32_t count) {
+  if (start >= row_count_ || count > row_count_ - start) {
+    LOG(ERROR) << "RemoveRows failed because rows are not in model.";
+    return;
+  }
+  for (Column& column : columns_) {
+    switch (column.type) {
+      case ColumnType::Int64:
+      case ColumnType::Bool:
+        column.ints.erase(column.ints.begin() + start,
+                          column.ints.begin() + start + count);
+        break;
+      case ColumnType::Double:
+        column.doubles.erase(column.doubles.begin() + start,
+                             column.doubles.begin() + start + count);
+        break;
+      case ColumnType::String:
+        column.strings.erase(column.strings.begin() + start,
+                             column.strings.begin() + start + count);
+        break;
+    }
+  }
+  row_count_ -= count;
+  NotifyRowsDeleted(start, count);
+}
+
+void ColumnarTableModel::Reserve(uint32_t rows) {
+  for (Column& column : columns_) {
+    switch (column.type) {
+      case ColumnType::Int64:
+      case ColumnType::Bool:
+        column.ints.reserve(rows);
+        break;
+      case ColumnType::Double:
+        column.doubles.reserve(rows);
+        break;
+      case ColumnType::String:
+        column.strings.reserve(rows);
+        break;
+    }
+  }
+}
+
+int64_t ColumnarTableModel::GetInt64(uint32_t column, uint32_t row) const {
+  DCHECK(columns_[column].type == ColumnType::Int64);
+  return columns_[column].ints[row];
+}
+
+double ColumnarTableModel::GetDouble(uint32_t column, uint32_t row) const {
+  DCHECK(columns_[column].type == ColumnType::Double);
+  return columns_[column].doubles[row];
+}
+
+bool ColumnarTableModel::GetBool(uint32_t column, uint32_t row) const {
+  DCHECK(columns_[column].type == ColumnType::Bool);
+  return columns_[column].ints[row] != 0;
+}
+
+const std::string& ColumnarTableModel::GetString(uint32_t column,
+                                                 uint32_t row) const {
+  DCHECK(columns_[column].type == ColumnType::String);
+  return strings_[columns_[column].strings[row]].GetString();
+}
+
+uint32_t ColumnarTableModel::GetRowCount() const {
+  return row_count_;
+}
+
+const base::Value* ColumnarTableModel::GetValue(
+    uint32_t column, uint32_t row) const {
+  if (column >= columns_.size() || row >= row_count_)
+    return nullptr;
+  const Column& c = columns_[column];
+  switch (c.type) {
+    case ColumnType::Int64: {
+      // base::Value only stores 32bit integers.
+      int64_t value = c.ints[row];
+      if (value >= std::numeric_limits<int>::min() &&
+          value <= std::numeric_limits<int>::max())
+        copy_ = base::Value(static_cast<int>(value));
+      else
+        copy_ = base::Value(static_cast<double>(value));
+      return &copy_;
+    }
+    case ColumnType::Double:
+      copy_ = base::Value(c.doubles[row]);
+      return &copy_;
+    case ColumnType::Bool:
+      copy_ = base::Value(c.ints[row] != 0);
+      return &copy_;
+    case ColumnType::String:
+      return &strings_[c.strings[row]];
+  }
+  NOTREACHED();
+  return nullptr;
+}
+
+void ColumnarTableModel::SetValue(uint32_t column, uint32_t row,
+                                  base::Value value) {
+  if (column >= columns_.size() || row >= row_count_)
+    return;
+  Store(&columns_[column], row, value);
+  NotifyValueChange(column, row);
+}
+
+uint64_t ColumnarTableModel::GetStoredCellCount() const {
+  return static_cast<uint64_t>(row_count_) * columns_.size();
+}
+
+void ColumnarTableModel::Append(Column* column, const base::Value& value) {
+  uint32_t row = 0;
+  switch (column->type) {
+    case ColumnType::Int64:
+    case ColumnType::Bool:
+      row = static_cast<uint32_t>(column->ints.size());
+      column->ints.push_back(0);
+      break;
+    case ColumnType::Double:
+      row = static_cast<uint32_t>(column->doubles.size());
+      column->doubles.push_back(0);
+      break;
+    case ColumnType::String:
+      row = static_cast<uint32_t>(column->strings.size());
+      column->strings.push_back(0);
+      break;
+  }
+  Store(column, row, value);
+}
+
+void ColumnarTableModel::Store(Column* column, uint32_t row,
+                               const base::Value& value) {
+  switch (column->type) {
+    case ColumnType::Int64:
+      if (value.is_int())
+        column->ints[row] = value.GetInt();
+      else if (value.is_double())
+        column->ints[row] = static_cast<int64_t>(value.GetDouble());
+      else
+        column->ints[row] = 0;
+      break;
+    case ColumnType::Double:
+      column->doubles[row] = value.is_int() || value.is_double() ?
+          value.GetDouble() : 0;
+      break;
+    case ColumnType::Bool:
+      column->ints[row] = value.is_bool() && value.GetBool();
+      break;
+    case ColumnType::String:
+      column->strings[row] = value.is_string() ? Intern(value.GetString()) : 0;
+      break;
+  }
+}
+
+uint32_t ColumnarTableModel::Intern(const std::string& str) {
+  auto it = string_indices_.find(str);
+  if (it != string_indices_.end())
+    return it->second;
+  uint32_t index = static_cast<uint32_t>(strings_.size());
+  strings_.emplace_back(str);
+  string_indices_.emplace(str, index);
+  return index;
+}
+
 }  // namespace nu
@@ -7,15 +7,22 @@
 
 #include <functional>
 #include <list>
+#include <set>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/values.h"
+#include "nativeui/memory_report.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
 
 class Table;
+class TableModelView;
 
 // Users should sublcass TableModel to provide their own implementation.
 class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
@@ -31,24 +38,49 @@ class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
   // Change the value.
   virtual void SetValue(uint32_t column, uint32_t row, base::Value value) = 0;
 
+  // Return the number of cells stored by the model itself, which is used by
+  // memory reports. Models reading data from elsewhere return 0.
+  virtual uint64_t GetStoredCellCount() const;
+
   // Called by sublcass to notify when there rows inserted.
   void NotifyRowInsertion(uint32_t row);
   void NotifyRowDeletion(uint32_t row);
   void NotifyValueChange(uint32_t column, uint32_t row);
 
+  // Notify changes of |count| rows starting from |start| at once, which is
+  // much faster than notifying each row.
+  void NotifyRowsInserted(uint32_t start, uint32_t count);
+  void NotifyRowsDeleted(uint32_t start, uint32_t count);
+  void NotifyRangeChanged(uint32_t start, uint32_t count);
+
+  // Notify that all rows have changed, and the tables should reload.
+  void NotifyReset();
+
  protected:
   TableModel();
   virtual ~TableModel();
 
+  // Called before the tables are notified of changes.
+  virtual void OnNotify() {}
+
  private:
   friend class base::RefCounted<TableModel>;
   friend class Table;
+  friend class TableModelView;
 
   // Called by table.
   void Subscribe(Table* view);
   void Unsubscribe(Table* view);
 
+  // Called by TableModelView.
+  void AddView(TableModelView* view);
+  void RemoveView(TableModelView* view);
+
   std::list<Table*> tables_;
+  std::list<TableModelView*> views_;
+
+  // Counts the model in memory reports.
+  LiveObjectTracker live_object_{LiveObjectType::TableModel, this};
 };
 
 // Used by language bindings.
@@ -68,12 +100,110 @@ class NATIVEUI_EXPORT AbstractTableModel : public TableModel {
   std::function<void(AbstractTableModel*,
                      uint32_t, uint32_t, base::Value)> set_value;
 
+  // Optional, return |count| rows starting from |start|. When set, rows are
+  // fetched by pages and cached, and get_value is not used.
+  std::function<std::vector<std::vector<base::Value>>(
+      AbstractTableModel*, uint32_t, uint32_t)> get_rows;
+
+  // Number of rows fetched by each get_rows call.
+  static const uint32_t kRowsPerPage = 64;
+
+  // Return the number of cached pages.
+  uint32_t GetCachedPageCount() const {
+    return static_cast<uint32_t>(pages_.size());
+  }
+
  protected:
   ~AbstractTableModel() override;
 
+  // TableModel:
+  void OnNotify() override;
+
  private:
+  using Page = std::vector<std::vector<base::Value>>;
+
+  // Return the cached page of |page|, fetch it if not cached.
+  const Page& GetPage(uint32_t page) const;
+
   bool index_starts_from_0_;
   base::Value copy_;
+
+  // The recently fetched pages, enough to cover the visible rows of tables.
+  mutable base::MRUCache<uint32_t, Page> pages_;
+};
+
+// A TableModel that loads rows by pages from a data source asynchronously.
+//
+// When a row that has not been loaded is read, the placeholder is returned
+// and the page of the row is requested with the load_rows delegate, which
+// should call SetRows when the data is ready. The pages next to the requested
+// ones are prefetched, and only a limited number of recently used pages are
+// kept in memory.
+class NATIVEUI_EXPORT PagedTableModel : public TableModel {
+ public:
+  using Row = std::vector<base::Value>;
+
+  static const uint32_t kDefaultPageSize = 100;
+  static const size_t kDefaultMaxCachedPages = 20;
+
+  explicit PagedTableModel(uint32_t row_count,
+                           uint32_t page_size = kDefaultPageSize,
+                           bool index_starts_from_0 = true);
+
+  // Change the number of rows, the cached pages after the end are dropped.
+  void SetRowCount(uint32_t count);
+
+  // Provide the rows requested by load_rows, the |start| must be the one
+  // passed to load_rows. Return false if the rows are not requested, for
+  // example when the model has been invalidated after the request.
+  bool SetRows(uint32_t start, std::vector<Row> rows);
+
+  // Set the value returned for rows that are not loaded.
+  void SetPlaceholder(base::Value value);
+
+  // Set the number of pages kept in memory, it should be large enough to
+  // cover the visible rows of the tables.
+  void SetMaxCachedPages(size_t count);
+
+  // Drop all loaded pages, and load the visible rows again.
+  void Invalidate();
+
+  bool IsRowLoaded(uint32_t row) const;
+  uint32_t GetPageSize() const { return page_size_; }
+  size_t GetCachedPageCount() const { return pages_.size(); }
+  size_t GetLoadingPageCount() const { return loading_.size(); }
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  const base::Value* GetValue(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+  // Start loading |count| rows starting from |start|.
+  std::function<void(PagedTableModel*, uint32_t, uint32_t)> load_rows;
+
+ protected:
+  ~PagedTableModel() override;
+
+ private:
+  // Request loading |page|, the load_rows delegate is called later so the
+  // painting of tables is not blocked by script.
+  void RequestPage(uint32_t page) const;
+  void LoadRequestedPages();
+
+  uint32_t GetPageCount() const;
+
+  uint32_t row_count_;
+  const uint32_t page_size_;
+  bool index_starts_from_0_;
+  base::Value placeholder_;
+
+  // Pages are loaded on demand when reading values.
+  size_t max_cached_pages_;
+  mutable base::MRUCache<uint32_t, std::vector<Row>> pages_;
+  mutable std::set<uint32_t> loading_;
+  mutable std::vector<uint32_t> requested_;
+
+  base::WeakPtrFactory<PagedTableModel> weak_factory_;
 };
 
 // A simple implementation of TableModel that manages the data.
@@ -86,10 +216,15 @@ class NATIVEUI_EXPORT SimpleTableModel : public TableModel {
   void AddRow(Row data);
   void RemoveRowAt(uint32_t row);
 
+  // Add or remove many rows with one notification.
+  void AddRows(std::vector<Row> rows);
+  void RemoveRowsAt(uint32_t start, uint32_t count);
+
   // TableModel:
   uint32_t GetRowCount() const override;
   const base::Value* GetValue(uint32_t column, uint32_t row) const override;
   void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+  uint64_t GetStoredCellCount() const override;
 
  protected:
   ~SimpleTableModel() override;
@@ -99,6 +234,91 @@ class NATIVEUI_EXPORT SimpleTableModel : public TableModel {
   std::vector<Row> rows_;
 };
 
+// A TableModel that stores each column in a typed buffer.
+//
+// Compared to SimpleTableModel, numbers and booleans take only their native
+// sizes, and strings are interned so equal strings share one copy. It is
+// suitable for large tables with mostly repeated values.
+class NATIVEUI_EXPORT ColumnarTableModel : public TableModel {
+ public:
+  using Row = std::vector<base::Value>;
+
+  enum class ColumnType {
+    Int64,
+    Double,
+    Bool,
+    String,
+  };
+
+  explicit ColumnarTableModel(std::vector<ColumnType> columns);
+
+  // Values that do not match the column types are stored as 0, false or
+  // empty string.
+  void AddRow(Row data);
+  void AddRows(std::vector<Row> rows);
+  void RemoveRowAt(uint32_t row);
+  void RemoveRowsAt(uint32_t start, uint32_t count);
+
+  // Preallocate the buffers for |rows| rows.
+  void Reserve(uint32_t rows);
+
+  uint32_t GetColumnCount() const {
+    return static_cast<uint32_t>(columns_.size());
+  }
+  ColumnType GetColumnType(uint32_t column) const {
+    return columns_[column].type;
+  }
+
+  // Read the typed values without converting to base::Value, the |column|
+  // must be of the type.
+  int64_t GetInt64(uint32_t column, uint32_t row) const;
+  double GetDouble(uint32_t column, uint32_t row) const;
+  bool GetBool(uint32_t column, uint32_t row) const;
+  const std::string& GetString(uint32_t column, uint32_t row) const;
+
+  // Return the number of unique strings stored.
+  uint32_t GetStringCount() const {
+    return static_cast<uint32_t>(strings_.size());
+  }
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  const base::Value* GetValue(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+  uint64_t GetStoredCellCount() const override;
+
+ protected:
+  ~ColumnarTableModel() override;
+
+ private:
+  struct Column {
+    explicit Column(ColumnType type) : type(type) {}
+
+    ColumnType type;
+    // Only the buffer of |type| is used, booleans are stored in |ints|.
+    std::vector<int64_t> ints;
+    std::vector<double> doubles;
+    std::vector<uint32_t> strings;
+  };
+
+  // Append the |value| converted to the type of |column|.
+  void Append(Column* column, const base::Value& value);
+  void Store(Column* column, uint32_t row, const base::Value& value);
+
+  // Return the index of |str| in the string storage, add it if not exist.
+  uint32_t Intern(const std::string& str);
+
+  std::vector<Column> columns_;
+  uint32_t row_count_ = 0;
+
+  // The string values are kept as base::Value so GetValue does not copy.
+  std::vector<base::Value> strings_;
+  std::unordered_map<std::string, uint32_t> string_indices_;
+
+  // Temporary storage of the number returned by GetValue.
+  mutable base::Value copy_;
+};
+
 }  // namespace nu
 
 #endif  // NATIVEUI_TABLE_MODEL_H_
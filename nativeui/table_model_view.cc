@@ -0,0 +1,451 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/table_model_view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "base/strings/string_util.h"
+#include "base/threading/platform_thread.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/util/worker_pool.h"
+
+namespace nu {
+
+namespace {
+
+// Changes of more rows are handled by rebuilding the view.
+const uint32_t kMaxIncrementalRows = 1000;
+
+// Sorting is split into threads for large tables.
+const int kMaxSortThreads = 4;
+const size_t kMinRowsPerThread = 64 * 1024;
+
+double ToNumber(const base::Value* value) {
+  if (!value)
+    return 0;
+  if (value->is_bool())
+    return value->GetBool() ? 1 : 0;
+  if (!value->is_int() && !value->is_double())
+    return 0;
+  double number = value->GetDouble();
+  // NaN would break the strict weak ordering of sorting.
+  return std::isnan(number) ? -std::numeric_limits<double>::infinity()
+                            : number;
+}
+
+const std::string& ToString(const base::Value* value) {
+  if (!value || !value->is_string())
+    return base::EmptyString();
+  return value->GetString();
+}
+
+// The values of sorted column copied from source, so they can be compared in
+// worker threads.
+struct SortKeys {
+  bool by_string = false;
+  bool ascending = true;
+  // Indexed by source rows.
+  std::vector<double> numbers;
+  std::vector<std::string> strings;
+
+  bool Less(uint32_t a, uint32_t b) const {
+    if (by_string) {
+      int result = strings[a].compare(strings[b]);
+      if (result != 0)
+        return ascending ? result < 0 : result > 0;
+    } else if (numbers[a] != numbers[b]) {
+      return ascending ? numbers[a] < numbers[b] : numbers[a] > numbers[b];
+    }
+    // Keep the order of source for equal values.
+    return a < b;
+  }
+};
+
+bool IsStringColumn(TableModel* source, uint32_t column) {
+  if (source->GetRowCount() == 0)
+    return false;
+  const base::Value* value = source->GetValue(column, 0);
+  return value && value->is_string();
+}
+
+SortKeys TakeSortKeys(TableModel* source, uint32_t column, bool ascending) {
+  SortKeys keys;
+  keys.by_string = IsStringColumn(source, column);
+  keys.ascending = ascending;
+  uint32_t count = source->GetRowCount();
+  if (keys.by_string) {
+    keys.strings.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+      keys.strings.push_back(ToString(source->GetValue(column, i)));
+  } else {
+    keys.numbers.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+      keys.numbers.push_back(ToNumber(source->GetValue(column, i)));
+  }
+  return keys;
+}
+
+// Sort a chunk of rows in a joinable thread.
+class SortThread : public base::PlatformThread::Delegate {
+ public:
+  SortThread(uint32_t* begin, uint32_t* end, const SortKeys* keys)
+      : begin_(begin), end_(end), keys_(keys) {}
+
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override {
+    const SortKeys* keys = keys_;
+    std::sort(begin_, end_,
+              [keys](uint32_t a, uint32_t b) { return keys->Less(a, b); });
+  }
+
+ private:
+  uint32_t* begin_;
+  uint32_t* end_;
+  const SortKeys* keys_;
+};
+
+// Sort chunks of rows in parallel and then merge them.
+void ParallelSort(std::vector<uint32_t>* rows, const SortKeys& keys) {
+  auto less = [&keys](uint32_t a, uint32_t b) { return keys.Less(a, b); };
+  size_t chunks = std::min(static_cast<size_t>(kMaxSortThreads),
+                           rows->size() / kMinRowsPerThread);
+  if (chunks < 2) {
+    std::sort(rows->begin(), rows->end(), less);
+    return;
+  }
+  std::vector<size_t> bounds;
+  for (size_t i = 0; i <= chunks; ++i)
+    bounds.push_back(rows->size() * i / chunks);
+  uint32_t* data = rows->data();
+  std::vector<std::unique_ptr<SortThread>> threads;
+  std::vector<base::PlatformThreadHandle> handles;
+  for (size_t i = 1; i < chunks; ++i) {
+    threads.emplace_back(new SortThread(data + bounds[i],
+                                        data + bounds[i + 1], &keys));
+    base::PlatformThreadHandle handle;
+    if (base::PlatformThread::Create(0, threads.back().get(), &handle))
+      handles.push_back(handle);
+    else
+      threads.back()->ThreadMain();
+  }
+  std::sort(data, data + bounds[1], less);
+  for (base::PlatformThreadHandle handle : handles)
+    base::PlatformThread::Join(handle);
+  for (size_t width = 1; width < chunks; width *= 2) {
+    for (size_t i = 0; i + width < chunks; i += 2 * width) {
+      std::inplace_merge(data + bounds[i],
+                         data + bounds[i + width],
+                         data + bounds[std::min(i + 2 * width, chunks)],
+                         less);
+    }
+  }
+}
+
+}  // namespace
+
+TableModelView::TableModelView(scoped_refptr<TableModel> source)
+    : source_(std::move(source)), weak_factory_(this) {
+  source_->AddView(this);
+  Rebuild();
+}
+
+TableModelView::~TableModelView() {
+  source_->RemoveView(this);
+}
+
+void TableModelView::SetFilter(Filter filter) {
+  filter_ = std::move(filter);
+  Rebuild();
+}
+
+void TableModelView::Sort(uint32_t column, bool ascending) {
+  sort_column_ = static_cast<int>(column);
+  ascending_ = ascending;
+  SortKeys keys = TakeSortKeys(source_.get(), column, ascending);
+  sort_by_string_ = keys.by_string;
+  ParallelSort(&rows_, keys);
+  ++generation_;
+  positions_valid_ = false;
+  NotifyReset();
+}
+
+void TableModelView::SortAsync(uint32_t column, bool ascending,
+                               std::function<void()> callback) {
+  sort_column_ = static_cast<int>(column);
+  ascending_ = ascending;
+  // The callback is kept in view as it can only be destroyed in main thread.
+  sort_callback_ = std::move(callback);
+  auto keys = std::make_shared<SortKeys>(
+      TakeSortKeys(source_.get(), column, ascending));
+  sort_by_string_ = keys->by_string;
+  auto rows = std::make_shared<std::vector<uint32_t>>(rows_);
+  uint32_t generation = generation_;
+  base::WeakPtr<TableModelView> weak_ptr = weak_factory_.GetWeakPtr();
+  WorkerPool::PostTask([=]() {
+    ParallelSort(rows.get(), *keys);
+    MessageLoop::PostTask([=]() {
+      if (!weak_ptr)
+        return;
+      // Another sorting has been requested.
+      if (weak_ptr->sort_column_ != static_cast<int>(column) ||
+          weak_ptr->ascending_ != ascending)
+        return;
+      std::function<void()> done = std::move(weak_ptr->sort_callback_);
+      // The rows have changed during sorting, sort again.
+      if (weak_ptr->generation_ != generation) {
+        weak_ptr->SortAsync(column, ascending, std::move(done));
+        return;
+      }
+      weak_ptr->rows_ = std::move(*rows);
+      ++weak_ptr->generation_;
+      weak_ptr->positions_valid_ = false;
+      weak_ptr->NotifyReset();
+      if (done)
+        done();
+    });
+  });
+}
+
+void TableModelView::ClearSort() {
+  sort_column_ = -1;
+  Rebuild();
+}
+
+uint32_t TableModelView::MapToSource(uint32_t row) const {
+  return row < rows_.size() ? rows_[row] : row;
+}
+
+int TableModelView::MapFromSource(uint32_t row) const {
+  // Without sorting the rows are in the order of source.
+  if (sort_column_ < 0) {
+    auto it = std::lower_bound(rows_.begin(), rows_.end(), row);
+    if (it == rows_.end() || *it != row)
+      return -1;
+    return static_cast<int>(it - rows_.begin());
+  }
+  if (!positions_valid_) {
+    positions_.assign(source_->GetRowCount(), -1);
+    for (size_t i = 0; i < rows_.size(); ++i)
+      positions_[rows_[i]] = static_cast<int>(i);
+    positions_valid_ = true;
+  }
+  return row < positions_.size() ? positions_[row] : -1;
+}
+
+uint32_t TableModelView::GetRowCount() const {
+  return static_cast<uint32_t>(rows_.size());
+}
+
+const base::Value* TableModelView::GetValue(uint32_t column,
+                                            uint32_t row) const {
+  if (row >= rows_.size())
+    return nullptr;
+  return source_->GetValue(column, rows_[row]);
+}
+
+void TableModelView::SetValue(uint32_t column, uint32_t row,
+                              base::Value value) {
+  // The source model notifies the change, which then updates the view.
+  if (row < rows_.size())
+    source_->SetValue(column, rows_[row], std::move(value));
+}
+
+void TableModelView::OnSourceRowsInserted(uint32_t start, uint32_t count) {
+  ++generation_;
+  positions_valid_ = false;
+  for (uint32_t& row : rows_) {
+    if (row >= start)
+      row += count;
+  }
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  if (sort_column_ >= 0) {
+    for (uint32_t row = start; row < start + count; ++row) {
+      if (Accepts(row))
+        InsertRow(row);
+    }
+    return;
+  }
+  // Without sorting the new rows are next to each other in view.
+  std::vector<uint32_t> inserted;
+  for (uint32_t row = start; row < start + count; ++row) {
+    if (Accepts(row))
+      inserted.push_back(row);
+  }
+  auto it = std::lower_bound(rows_.begin(), rows_.end(), start);
+  uint32_t position = static_cast<uint32_t>(it - rows_.begin());
+  rows_.insert(it, inserted.begin(), inserted.end());
+  NotifyRowsInserted(position, static_cast<uint32_t>(inserted.size()));
+}
+
+void TableModelView::OnSourceRowsDeleted(uint32_t start, uint32_t count) {
+  ++generation_;
+  positions_valid_ = false;
+  uint32_t end = start + count;
+  if (sort_column_ < 0) {
+    auto first = std::lower_bound(rows_.begin(), rows_.end(), start);
+    auto last = std::lower_bound(first, rows_.end(), end);
+    uint32_t position = static_cast<uint32_t>(first - rows_.begin());
+    uint32_t removed = static_cast<uint32_t>(last - first);
+    for (auto it = rows_.erase(first, last); it != rows_.end(); ++it)
+      *it -= count;
+    NotifyRowsDeleted(position, removed);
+    return;
+  }
+  if (count > kMaxIncrementalRows) {
+    auto it = std::remove_if(rows_.begin(), rows_.end(), [=](uint32_t row) {
+      return row >= start && row < end;
+    });
+    rows_.erase(it, rows_.end());
+    for (uint32_t& row : rows_) {
+      if (row >= end)
+        row -= count;
+    }
+    NotifyReset();
+    return;
+  }
+  std::vector<uint32_t> removed;
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    if (rows_[i] >= end)
+      rows_[i] -= count;
+    else if (rows_[i] >= start)
+      removed.push_back(static_cast<uint32_t>(i));
+  }
+  // Remove from back so the positions of remaining rows are not affected.
+  for (auto it = removed.rbegin(); it != removed.rend(); ++it) {
+    rows_.erase(rows_.begin() + *it);
+    NotifyRowDeletion(*it);
+  }
+}
+
+void TableModelView::OnSourceRangeChanged(uint32_t start, uint32_t count) {
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  for (uint32_t row = start; row < start + count; ++row)
+    UpdateRow(row, -1);
+}
+
+void TableModelView::OnSourceValueChange(uint32_t column, uint32_t row) {
+  UpdateRow(row, static_cast<int>(column));
+}
+
+void TableModelView::OnSourceReset() {
+  Rebuild();
+}
+
+void TableModelView::Rebuild() {
+  ++generation_;
+  positions_valid_ = false;
+  rows_.clear();
+  uint32_t count = source_->GetRowCount();
+  rows_.reserve(count);
+  for (uint32_t row = 0; row < count; ++row) {
+    if (Accepts(row))
+      rows_.push_back(row);
+  }
+  if (sort_column_ >= 0) {
+    SortKeys keys = TakeSortKeys(source_.get(), sort_column_, ascending_);
+    sort_by_string_ = keys.by_string;
+    ParallelSort(&rows_, keys);
+  }
+  NotifyReset();
+}
+
+bool TableModelView::Accepts(uint32_t row) const {
+  return !filter_ || filter_(source_.get(), row);
+}
+
+bool TableModelView::Less(uint32_t a, uint32_t b) const {
+  // The returned value of GetValue is temporary, so read one key at a time.
+  if (sort_by_string_) {
+    std::string key = ToString(source_->GetValue(sort_column_, a));
+    int result = key.compare(ToString(source_->GetValue(sort_column_, b)));
+    if (result != 0)
+      return ascending_ ? result < 0 : result > 0;
+  } else {
+    double key_a = ToNumber(source_->GetValue(sort_column_, a));
+    double key_b = ToNumber(source_->GetValue(sort_column_, b));
+    if (key_a != key_b)
+      return ascending_ ? key_a < key_b : key_a > key_b;
+  }
+  return a < b;
+}
+
+size_t TableModelView::FindInsertPosition(uint32_t row) const {
+  if (sort_column_ < 0)
+    return std::lower_bound(rows_.begin(), rows_.end(), row) - rows_.begin();
+  return std::upper_bound(rows_.begin(), rows_.end(), row,
+                          [this](uint32_t a, uint32_t b) {
+                            return Less(a, b);
+                          }) - rows_.begin();
+}
+
+void TableModelView::InsertRow(uint32_t row) {
+  size_t position = FindInsertPosition(row);
+  rows_.insert(rows_.begin() + position, row);
+  UpdatePositions(position, rows_.size());
+  NotifyRowInsertion(static_cast<uint32_t>(position));
+}
+
+void TableModelView::UpdatePositions(size_t begin, size_t end) {
+  if (!positions_valid_)
+    return;
+  for (size_t i = begin; i < end; ++i)
+    positions_[rows_[i]] = static_cast<int>(i);
+}
+
+void TableModelView::UpdateRow(uint32_t row, int column) {
+  int position = MapFromSource(row);
+  bool accepted = Accepts(row);
+  if (position < 0) {
+    if (accepted) {
+      ++generation_;
+      InsertRow(row);
+    }
+    return;
+  }
+  bool moved = false;
+  if (accepted && sort_column_ >= 0 &&
+      (column < 0 || column == sort_column_)) {
+    size_t i = static_cast<size_t>(position);
+    moved = (i > 0 && !Less(rows_[i - 1], row)) ||
+            (i + 1 < rows_.size() && !Less(row, rows_[i + 1]));
+  }
+  if (!accepted) {
+    ++generation_;
+    rows_.erase(rows_.begin() + position);
+    if (positions_valid_)
+      positions_[row] = -1;
+    UpdatePositions(position, rows_.size());
+    NotifyRowDeletion(static_cast<uint32_t>(position));
+    return;
+  }
+  if (moved) {
+    ++generation_;
+    size_t from = static_cast<size_t>(position);
+    rows_.erase(rows_.begin() + from);
+    NotifyRowDeletion(static_cast<uint32_t>(from));
+    size_t to = FindInsertPosition(row);
+    rows_.insert(rows_.begin() + to, row);
+    // Only the rows between the old and new positions are shifted.
+    UpdatePositions(std::min(from, to), std::max(from, to) + 1);
+    NotifyRowInsertion(static_cast<uint32_t>(to));
+    return;
+  }
+  if (column < 0)
+    NotifyRangeChanged(static_cast<uint32_t>(position), 1);
+  else
+    NotifyValueChange(static_cast<uint32_t>(column), position);
+}
+
+}  // namespace nu
@@ -0,0 +1,127 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TABLE_MODEL_VIEW_H_
+#define NATIVEUI_TABLE_MODEL_VIEW_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/memory/weak_ptr.h"
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+// Presents a sorted and filtered view of another TableModel.
+//
+// The view only keeps a permutation of the source rows, the values are always
+// read from the source model, and changes of the source model are translated
+// to the rows of the view.
+class NATIVEUI_EXPORT TableModelView : public TableModel {
+ public:
+  // Return true if the |row| of |source| should be shown.
+  using Filter = std::function<bool(TableModel* source, uint32_t row)>;
+
+  explicit TableModelView(scoped_refptr<TableModel> source);
+
+  TableModel* GetSource() const { return source_.get(); }
+
+  // Only show rows that pass the |filter|, pass an empty function to show all
+  // rows.
+  void SetFilter(Filter filter);
+
+  // Sort rows by the values of |column|.
+  //
+  // The column is compared as numbers if the values of first row is a number
+  // or boolean, and as strings otherwise.
+  void Sort(uint32_t column, bool ascending);
+
+  // Like Sort but the rows are sorted in worker threads, the view is updated
+  // and |callback| is called in the main thread when done.
+  void SortAsync(uint32_t column, bool ascending,
+                 std::function<void()> callback);
+
+  // Restore the order of source model.
+  void ClearSort();
+
+  // Return the sorted column, or -1 if not sorted.
+  int GetSortColumn() const { return sort_column_; }
+  bool IsSortAscending() const { return ascending_; }
+
+  // Convert between the rows of view and source model, MapFromSource returns
+  // -1 if the source row is filtered out.
+  uint32_t MapToSource(uint32_t row) const;
+  int MapFromSource(uint32_t row) const;
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  const base::Value* GetValue(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+ protected:
+  ~TableModelView() override;
+
+ private:
+  friend class TableModel;
+
+  // Called by the source model.
+  void OnSourceRowsInserted(uint32_t start, uint32_t count);
+  void OnSourceRowsDeleted(uint32_t start, uint32_t count);
+  void OnSourceRangeChanged(uint32_t start, uint32_t count);
+  void OnSourceValueChange(uint32_t column, uint32_t row);
+  void OnSourceReset();
+
+  // Rebuild the rows from source and notify tables to reload.
+  void Rebuild();
+
+  // Return whether source |row| passes the filter.
+  bool Accepts(uint32_t row) const;
+
+  // Compare the source rows |a| and |b| with current sort order, this reads
+  // the values from source so it can only be called in main thread.
+  bool Less(uint32_t a, uint32_t b) const;
+
+  // Return the position in rows_ where source |row| should be inserted.
+  size_t FindInsertPosition(uint32_t row) const;
+
+  // Put the source |row| into view at the right position.
+  void InsertRow(uint32_t row);
+
+  // Update the inverse index for the rows_ in [begin, end).
+  void UpdatePositions(size_t begin, size_t end);
+
+  // Update the position and visibility of source |row| after its value of
+  // |column| changed, -1 means all columns.
+  void UpdateRow(uint32_t row, int column);
+
+  scoped_refptr<TableModel> source_;
+  Filter filter_;
+
+  int sort_column_ = -1;
+  bool ascending_ = true;
+  bool sort_by_string_ = false;
+
+  // The callback of pending SortAsync.
+  std::function<void()> sort_callback_;
+
+  // Increased whenever rows_ changes, used for dropping outdated results of
+  // SortAsync.
+  uint32_t generation_ = 0;
+
+  // The source rows in view order.
+  std::vector<uint32_t> rows_;
+
+  // The inverse index of rows_ for sorted views, which maps source rows to
+  // view positions and -1 for filtered rows. It is rebuilt lazily after the
+  // rows_ are replaced, and patched by the edits of single rows.
+  mutable std::vector<int> positions_;
+  mutable bool positions_valid_ = false;
+
+  base::WeakPtrFactory<TableModelView> weak_factory_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TABLE_MODEL_VIEW_H_
@@ -0,0 +1,152 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "nativeui/nativeui.h"
+#include "nativeui/test/perf_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const uint32_t kRowCounts[] = {10000, 100000, 1000000};
+const uint32_t kColumns = 3;
+
+// Number of rows read for each simulated repaint.
+const uint32_t kRowsPerPage = 50;
+
+std::string GetName(const char* test, uint32_t rows) {
+  return base::StringPrintf("%s/%u", test, rows);
+}
+
+std::vector<nu::SimpleTableModel::Row> CreateRows(uint32_t count) {
+  std::vector<nu::SimpleTableModel::Row> rows(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    rows[i].emplace_back(base::NumberToString(i));
+    rows[i].emplace_back("some text in the middle column");
+    rows[i].emplace_back(static_cast<int>(i));
+  }
+  return rows;
+}
+
+scoped_refptr<nu::SimpleTableModel> CreateSimpleModel(uint32_t count) {
+  scoped_refptr<nu::SimpleTableModel> model =
+      new nu::SimpleTableModel(kColumns);
+  model->AddRows(CreateRows(count));
+  return model;
+}
+
+scoped_refptr<nu::AbstractTableModel> CreateAbstractModel(uint32_t count) {
+  scoped_refptr<nu::AbstractTableModel> model = new nu::AbstractTableModel;
+  model->get_row_count = [count](nu::AbstractTableModel*) { return count; };
+  model->get_value = [](nu::AbstractTableModel*, uint32_t column,
+                        uint32_t row) {
+    if (column == 0)
+      return base::Value(base::NumberToString(row));
+    return base::Value("some text in the middle column");
+  };
+  return model;
+}
+
+// Read the cells of one page of rows like a table does when repainting.
+void ReadPage(nu::TableModel* model, uint32_t start) {
+  uint32_t end = std::min(start + kRowsPerPage, model->GetRowCount());
+  for (uint32_t row = start; row < end; ++row) {
+    for (uint32_t column = 0; column < kColumns; ++column)
+      model->GetValue(column, row);
+  }
+}
+
+}  // namespace
+
+class TablePerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentSize(nu::SizeF(400, 400));
+    table_ = new nu::Table;
+    for (uint32_t i = 0; i < kColumns; ++i)
+      table_->AddColumn(base::NumberToString(i));
+    window_->SetContentView(table_);
+    window_->SetVisible(true);
+  }
+
+  void TearDown() override {
+    window_->Close();
+  }
+
+  // Show |model| in table and wait until the message loop becomes idle,
+  // which includes the first paint of the rows.
+  void ShowModel(nu::TableModel* model) {
+    table_->SetModel(model);
+    nu::MessageLoop::PostIdleTask([](double) { nu::MessageLoop::Quit(); });
+    nu::MessageLoop::Run();
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::Table> table_;
+};
+
+TEST_F(TablePerfTest, CreateModel) {
+  for (uint32_t count : kRowCounts) {
+    nu::RunPerfTest(GetName("SimpleTableModelAddRows", count), 1, [&](int) {
+      CreateSimpleModel(count);
+    });
+  }
+}
+
+TEST_F(TablePerfTest, FirstPaint) {
+  for (uint32_t count : kRowCounts) {
+    scoped_refptr<nu::SimpleTableModel> simple = CreateSimpleModel(count);
+    nu::RunPerfTest(GetName("SimpleTableModelFirstPaint", count), 1,
+                    [&](int) { ShowModel(simple.get()); });
+    table_->SetModel(nullptr);
+    scoped_refptr<nu::AbstractTableModel> abstract =
+        CreateAbstractModel(count);
+    nu::RunPerfTest(GetName("AbstractTableModelFirstPaint", count), 1,
+                    [&](int) { ShowModel(abstract.get()); });
+    table_->SetModel(nullptr);
+  }
+}
+
+TEST_F(TablePerfTest, NotifyRowInsertion) {
+  for (uint32_t count : kRowCounts) {
+    scoped_refptr<nu::SimpleTableModel> model = CreateSimpleModel(count);
+    ShowModel(model.get());
+    // Each AddRow notifies the table of one inserted row.
+    std::vector<nu::SimpleTableModel::Row> rows = CreateRows(1000);
+    nu::RunPerfTest(GetName("SimpleTableModelAddRow", count), 1000,
+                    [&](int i) { model->AddRow(std::move(rows[i])); });
+    table_->SetModel(nullptr);
+  }
+}
+
+TEST_F(TablePerfTest, ScrollRepaint) {
+  for (uint32_t count : kRowCounts) {
+    scoped_refptr<nu::SimpleTableModel> simple = CreateSimpleModel(count);
+    scoped_refptr<nu::AbstractTableModel> abstract =
+        CreateAbstractModel(count);
+    // The model side of repainting a page after scrolling.
+    uint32_t step = count / 100;
+    nu::RunPerfTest(GetName("SimpleTableModelReadPage", count), 100,
+                    [&](int i) { ReadPage(simple.get(), i * step); });
+    nu::RunPerfTest(GetName("AbstractTableModelReadPage", count), 100,
+                    [&](int i) { ReadPage(abstract.get(), i * step); });
+    // Scrolling the native table and waiting for it to repaint.
+    ShowModel(simple.get());
+    nu::RunPerfTest(GetName("TableScrollToRow", count), 100, [&](int i) {
+      table_->ScrollToRow(i * step, nu::Table::ScrollAlign::Start);
+      nu::MessageLoop::PostIdleTask([](double) { nu::MessageLoop::Quit(); });
+      nu::MessageLoop::Run();
+    });
+    table_->SetModel(nullptr);
+  }
+}
@@ -2,8 +2,12 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <algorithm>
+#include <tuple>
+
 #include "base/strings/stringprintf.h"
 #include "nativeui/nativeui.h"
+#include "nativeui/table_cell_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 class TableTest : public testing::Test {
@@ -50,6 +54,19 @@ class TestTableModel : public nu::TableModel {
   mutable base::Value value_;
 };
 
+TEST_F(TableTest, VisibleRowRange) {
+  EXPECT_EQ(table_->GetVisibleRowRange(), std::make_tuple(-1, -1));
+  table_->AddColumn("A");
+  table_->SetModel(new TestTableModel);
+  // Scrolling to rows out of range is ignored.
+  table_->ScrollToRow(-1, nu::Table::ScrollAlign::Start);
+  table_->ScrollToRow(10000, nu::Table::ScrollAlign::End);
+  table_->ScrollToRow(5000, nu::Table::ScrollAlign::Center);
+  int start, end;
+  std::tie(start, end) = table_->GetVisibleRowRange();
+  EXPECT_LE(start, end);
+}
+
 TEST_F(TableTest, SelectSingleRow) {
   table_->SetModel(new TestTableModel);
   table_->SelectRow(9999);
@@ -57,3 +74,205 @@ TEST_F(TableTest, SelectSingleRow) {
   table_->SelectRow(100001);
   EXPECT_EQ(table_->GetSelectedRow(), 9999);
 }
+
+TEST_F(TableTest, AddAndRemoveRows) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  table_->AddColumn("A");
+  table_->SetModel(model.get());
+  std::vector<nu::SimpleTableModel::Row> rows;
+  for (int i = 0; i < 5000; ++i) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(base::StringPrintf("%d", i));
+    rows.push_back(std::move(row));
+  }
+  model->AddRows(std::move(rows));
+  EXPECT_EQ(model->GetRowCount(), 5000u);
+  table_->SelectRow(4999);
+  EXPECT_EQ(table_->GetSelectedRow(), 4999);
+  model->RemoveRowsAt(10, 4000);
+  EXPECT_EQ(model->GetRowCount(), 1000u);
+  EXPECT_EQ(model->GetValue(0, 10)->GetString(), "4010");
+  // Out of range.
+  model->RemoveRowsAt(500, 501);
+  EXPECT_EQ(model->GetRowCount(), 1000u);
+}
+
+TEST_F(TableTest, ColumnarTableModel) {
+  using ColumnType = nu::ColumnarTableModel::ColumnType;
+  scoped_refptr<nu::ColumnarTableModel> model = new nu::ColumnarTableModel(
+      {ColumnType::Int64, ColumnType::Double, ColumnType::Bool,
+       ColumnType::String});
+  table_->AddColumn("A");
+  table_->SetModel(model.get());
+  std::vector<nu::ColumnarTableModel::Row> rows;
+  for (int i = 0; i < 1000; ++i) {
+    nu::ColumnarTableModel::Row row;
+    row.emplace_back(i);
+    row.emplace_back(i / 2.);
+    row.emplace_back(i % 2 == 0);
+    row.emplace_back(i % 3 == 0 ? "fizz" : "buzz");
+    rows.push_back(std::move(row));
+  }
+  model->AddRows(std::move(rows));
+  EXPECT_EQ(model->GetRowCount(), 1000u);
+  EXPECT_EQ(model->GetInt64(0, 999), 999);
+  EXPECT_EQ(model->GetDouble(1, 3), 1.5);
+  EXPECT_TRUE(model->GetBool(2, 4));
+  EXPECT_EQ(model->GetString(3, 3), "fizz");
+  EXPECT_EQ(model->GetValue(0, 10)->GetInt(), 10);
+  EXPECT_EQ(model->GetValue(3, 10)->GetString(), "buzz");
+  // Strings are interned, including the empty one.
+  EXPECT_EQ(model->GetStringCount(), 3u);
+  // Mismatched values are stored as default.
+  model->SetValue(3, 10, base::Value(1));
+  EXPECT_EQ(model->GetString(3, 10), "");
+  model->SetValue(0, 10, base::Value(2.5));
+  EXPECT_EQ(model->GetInt64(0, 10), 2);
+  model->RemoveRowsAt(0, 500);
+  EXPECT_EQ(model->GetRowCount(), 500u);
+  EXPECT_EQ(model->GetInt64(0, 0), 500);
+  EXPECT_EQ(model->GetString(3, 1), "fizz");
+}
+
+TEST_F(TableTest, AbstractTableModelGetRows) {
+  scoped_refptr<nu::AbstractTableModel> model = new nu::AbstractTableModel;
+  int calls = 0;
+  model->get_row_count = [](nu::AbstractTableModel*) { return 1000u; };
+  model->get_rows = [&calls](nu::AbstractTableModel*,
+                             uint32_t start, uint32_t count) {
+    ++calls;
+    std::vector<std::vector<base::Value>> rows;
+    for (uint32_t i = start; i < std::min(start + count, 1000u); ++i) {
+      std::vector<base::Value> row;
+      row.emplace_back(static_cast<int>(i));
+      rows.push_back(std::move(row));
+    }
+    return rows;
+  };
+  for (uint32_t i = 0; i < nu::AbstractTableModel::kRowsPerPage; ++i)
+    EXPECT_EQ(model->GetValue(0, i)->GetInt(), static_cast<int>(i));
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(model->GetValue(0, 999)->GetInt(), 999);
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(model->GetValue(1, 999), nullptr);
+  EXPECT_EQ(model->GetCachedPageCount(), 2u);
+  model->NotifyValueChange(0, 0);
+  EXPECT_EQ(model->GetCachedPageCount(), 0u);
+}
+
+TEST_F(TableTest, TableModelView) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  for (int i : {5, 2, 8, 1, 9}) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(i);
+    model->AddRow(std::move(row));
+  }
+  scoped_refptr<nu::TableModelView> view = new nu::TableModelView(model);
+  table_->AddColumn("A");
+  table_->SetModel(view.get());
+  view->Sort(0, true);
+  EXPECT_EQ(view->GetValue(0, 0)->GetInt(), 1);
+  EXPECT_EQ(view->GetValue(0, 4)->GetInt(), 9);
+  EXPECT_EQ(view->MapToSource(0), 3u);
+  // Only odd numbers.
+  view->SetFilter([](nu::TableModel* source, uint32_t row) {
+    return source->GetValue(0, row)->GetInt() % 2 == 1;
+  });
+  EXPECT_EQ(view->GetRowCount(), 3u);
+  EXPECT_EQ(view->MapFromSource(1), -1);
+  // Changes of source are put to the right places.
+  nu::SimpleTableModel::Row row;
+  row.emplace_back(3);
+  model->AddRow(std::move(row));
+  EXPECT_EQ(view->GetRowCount(), 4u);
+  EXPECT_EQ(view->GetValue(0, 1)->GetInt(), 3);
+  model->SetValue(0, 5, base::Value(11));
+  EXPECT_EQ(view->GetValue(0, 3)->GetInt(), 11);
+  model->RemoveRowAt(0);
+  EXPECT_EQ(view->GetRowCount(), 3u);
+  EXPECT_EQ(view->GetValue(0, 1)->GetInt(), 9);
+  view->ClearSort();
+  EXPECT_EQ(view->GetValue(0, 0)->GetInt(), 1);
+  EXPECT_EQ(view->GetValue(0, 2)->GetInt(), 11);
+}
+
+TEST_F(TableTest, TableModelViewMapFromSource) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  for (int i = 0; i < 100; ++i) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back((i * 37) % 100);
+    model->AddRow(std::move(row));
+  }
+  scoped_refptr<nu::TableModelView> view = new nu::TableModelView(model);
+  view->Sort(0, true);
+  // Move rows around so the inverse index is patched.
+  model->SetValue(0, 10, base::Value(-1));
+  model->SetValue(0, 20, base::Value(1000));
+  model->SetValue(0, 30, base::Value(50));
+  EXPECT_EQ(view->MapFromSource(10), 0);
+  EXPECT_EQ(view->MapFromSource(20), 99);
+  for (uint32_t i = 0; i < view->GetRowCount(); ++i)
+    EXPECT_EQ(view->MapFromSource(view->MapToSource(i)), static_cast<int>(i));
+}
+
+TEST_F(TableTest, CellCache) {
+  int draw_count = 0;
+  nu::Table::ColumnOptions options;
+  options.type = nu::Table::ColumnType::Custom;
+  options.on_draw = [&](nu::Painter*, const nu::RectF&, const base::Value&) {
+    ++draw_count;
+  };
+  scoped_refptr<nu::TableCellCache> cache = new nu::TableCellCache(options);
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(100, 100), 1.f);
+  nu::Painter* painter = canvas->GetPainter();
+  nu::RectF rect(0, 0, 100, 20);
+  cache->DrawCell(painter, 0, rect, 1.f, base::Value("a"));
+  cache->DrawCell(painter, 0, rect, 1.f, base::Value("a"));
+  EXPECT_EQ(draw_count, 1);
+  // Draw again when value or size changes.
+  cache->DrawCell(painter, 0, rect, 1.f, base::Value("b"));
+  EXPECT_EQ(draw_count, 2);
+  cache->DrawCell(painter, 0, nu::RectF(0, 0, 50, 20), 1.f, base::Value("b"));
+  EXPECT_EQ(draw_count, 3);
+  cache->DrawCell(painter, 1, rect, 1.f, base::Value("b"));
+  EXPECT_EQ(draw_count, 4);
+  EXPECT_EQ(cache->size(), 2u);
+  cache->Clear();
+  EXPECT_EQ(cache->size(), 0u);
+}
+
+TEST_F(TableTest, PagedTableModel) {
+  scoped_refptr<nu::PagedTableModel> model = new nu::PagedTableModel(250, 100);
+  model->SetPlaceholder(base::Value("loading"));
+  std::vector<uint32_t> requests;
+  model->load_rows = [&](nu::PagedTableModel* self,
+                         uint32_t start, uint32_t count) {
+    requests.push_back(start);
+    std::vector<nu::PagedTableModel::Row> rows;
+    for (uint32_t i = start; i < start + count; ++i) {
+      nu::PagedTableModel::Row row;
+      row.emplace_back(static_cast<int>(i));
+      rows.push_back(std::move(row));
+    }
+    EXPECT_TRUE(self->SetRows(start, std::move(rows)));
+    nu::MessageLoop::Quit();
+  };
+  // Reading an unloaded row does not block.
+  EXPECT_EQ(model->GetValue(0, 150)->GetString(), "loading");
+  EXPECT_EQ(model->GetLoadingPageCount(), 1u);
+  nu::MessageLoop::Run();
+  ASSERT_EQ(requests.size(), 1u);
+  EXPECT_EQ(requests[0], 100u);
+  EXPECT_EQ(model->GetValue(0, 150)->GetInt(), 150);
+  // Pages around are prefetched.
+  EXPECT_EQ(model->GetLoadingPageCount(), 2u);
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(model->IsRowLoaded(0));
+  EXPECT_TRUE(model->IsRowLoaded(249));
+  // Only recent pages are kept.
+  model->SetMaxCachedPages(1);
+  EXPECT_EQ(model->GetCachedPageCount(), 1u);
+  model->Invalidate();
+  EXPECT_EQ(model->GetCachedPageCount(), 0u);
+  EXPECT_FALSE(model->SetRows(0, {}));
+}
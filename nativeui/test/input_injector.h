@@ -0,0 +1,29 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TEST_INPUT_INJECTOR_H_
+#define NATIVEUI_TEST_INPUT_INJECTOR_H_
+
+#include "nativeui/events/keyboard_codes.h"
+
+namespace nu {
+
+class View;
+
+// Inject synthetic input through the input queue of the system, so the events
+// go through the same path as the ones from real devices. The window of the
+// view must be shown and focused.
+//
+// Each function returns false if the input can not be injected, for example
+// when running under Wayland.
+
+// Click at the center of |view|.
+bool InjectClick(View* view);
+
+// Press and release a key, only letters are supported.
+bool InjectKeyPress(KeyboardCode key);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TEST_INPUT_INJECTOR_H_
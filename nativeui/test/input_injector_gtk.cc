@@ -0,0 +1,66 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/input_injector.h"
+
+#include <X11/extensions/XTest.h>
+#include <X11/keysym.h>
+#include <gdk/gdkx.h>
+#include <gtk/gtk.h>
+
+#include "nativeui/view.h"
+
+namespace nu {
+
+namespace {
+
+// Return the X display, or nullptr when not running under X11.
+Display* GetXDisplay() {
+  GdkDisplay* display = gdk_display_get_default();
+  if (!display || !GDK_IS_X11_DISPLAY(display))
+    return nullptr;
+  return GDK_DISPLAY_XDISPLAY(display);
+}
+
+}  // namespace
+
+bool InjectClick(View* view) {
+  Display* xdisplay = GetXDisplay();
+  GtkWidget* widget = view->GetNative();
+  GtkWidget* toplevel = gtk_widget_get_toplevel(widget);
+  if (!xdisplay || !gtk_widget_get_realized(toplevel))
+    return false;
+  int x, y;
+  if (!gtk_widget_translate_coordinates(
+          widget, toplevel,
+          gtk_widget_get_allocated_width(widget) / 2,
+          gtk_widget_get_allocated_height(widget) / 2,
+          &x, &y))
+    return false;
+  int origin_x, origin_y;
+  gdk_window_get_origin(gtk_widget_get_window(toplevel), &origin_x, &origin_y);
+  // XTest works in device pixels.
+  int scale = gtk_widget_get_scale_factor(toplevel);
+  XTestFakeMotionEvent(xdisplay, -1, (origin_x + x) * scale,
+                       (origin_y + y) * scale, CurrentTime);
+  XTestFakeButtonEvent(xdisplay, 1, True, CurrentTime);
+  XTestFakeButtonEvent(xdisplay, 1, False, CurrentTime);
+  XFlush(xdisplay);
+  return true;
+}
+
+bool InjectKeyPress(KeyboardCode key) {
+  Display* xdisplay = GetXDisplay();
+  if (!xdisplay || key < VKEY_A || key > VKEY_Z)
+    return false;
+  KeyCode code = XKeysymToKeycode(xdisplay, XK_a + (key - VKEY_A));
+  if (code == 0)
+    return false;
+  XTestFakeKeyEvent(xdisplay, code, True, CurrentTime);
+  XTestFakeKeyEvent(xdisplay, code, False, CurrentTime);
+  XFlush(xdisplay);
+  return true;
+}
+
+}  // namespace nu
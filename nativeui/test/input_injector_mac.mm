@@ -0,0 +1,62 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/input_injector.h"
+
+#import <Cocoa/Cocoa.h>
+
+#include "base/mac/scoped_cftyperef.h"
+#include "nativeui/events/mac/keyboard_code_conversion_mac.h"
+#include "nativeui/view.h"
+
+namespace nu {
+
+namespace {
+
+bool PostMouseEvent(CGEventType type, CGPoint point) {
+  base::ScopedCFTypeRef<CGEventRef> event(CGEventCreateMouseEvent(
+      nullptr, type, point, kCGMouseButtonLeft));
+  if (!event)
+    return false;
+  CGEventPost(kCGHIDEventTap, event);
+  return true;
+}
+
+bool PostKeyEvent(CGKeyCode code, bool down) {
+  base::ScopedCFTypeRef<CGEventRef> event(
+      CGEventCreateKeyboardEvent(nullptr, code, down));
+  if (!event)
+    return false;
+  CGEventPost(kCGHIDEventTap, event);
+  return true;
+}
+
+}  // namespace
+
+bool InjectClick(View* view) {
+  NSView* native = view->GetNative();
+  if (![native window])
+    return false;
+  NSRect rect = [native convertRect:[native bounds] toView:nil];
+  rect = [[native window] convertRectToScreen:rect];
+  // Quartz events use flipped coordinates of the primary screen.
+  NSRect primary = [[[NSScreen screens] firstObject] frame];
+  CGPoint point = CGPointMake(NSMidX(rect), NSMaxY(primary) - NSMidY(rect));
+  return PostMouseEvent(kCGEventMouseMoved, point) &&
+         PostMouseEvent(kCGEventLeftMouseDown, point) &&
+         PostMouseEvent(kCGEventLeftMouseUp, point);
+}
+
+bool InjectKeyPress(KeyboardCode key) {
+  if (key < VKEY_A || key > VKEY_Z)
+    return false;
+  unichar character, shifted_character;
+  int code = MacKeyCodeForWindowsKeyCode(key, 0, &shifted_character,
+                                         &character);
+  if (code < 0)
+    return false;
+  return PostKeyEvent(code, true) && PostKeyEvent(code, false);
+}
+
+}  // namespace nu
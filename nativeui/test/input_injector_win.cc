@@ -0,0 +1,46 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/input_injector.h"
+
+#include <windows.h>
+
+#include "nativeui/view.h"
+#include "nativeui/win/view_win.h"
+#include "nativeui/win/window_win.h"
+
+namespace nu {
+
+bool InjectClick(View* view) {
+  if (!view->GetNative()->window())
+    return false;
+  // The bounds of views are relative to the client area of window.
+  Rect bounds(view->GetNative()->size_allocation());
+  POINT point = { bounds.CenterPoint().x(), bounds.CenterPoint().y() };
+  ::ClientToScreen(view->GetNative()->window()->hwnd(), &point);
+  // Absolute coordinates are normalized to 0-65535 of the primary screen.
+  INPUT inputs[3] = {};
+  for (INPUT& input : inputs)
+    input.type = INPUT_MOUSE;
+  inputs[0].mi.dx = point.x * 65535 / (::GetSystemMetrics(SM_CXSCREEN) - 1);
+  inputs[0].mi.dy = point.y * 65535 / (::GetSystemMetrics(SM_CYSCREEN) - 1);
+  inputs[0].mi.dwFlags = MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE;
+  inputs[1].mi.dwFlags = MOUSEEVENTF_LEFTDOWN;
+  inputs[2].mi.dwFlags = MOUSEEVENTF_LEFTUP;
+  return ::SendInput(3, inputs, sizeof(INPUT)) == 3;
+}
+
+bool InjectKeyPress(KeyboardCode key) {
+  if (key < VKEY_A || key > VKEY_Z)
+    return false;
+  INPUT inputs[2] = {};
+  for (INPUT& input : inputs) {
+    input.type = INPUT_KEYBOARD;
+    input.ki.wVk = static_cast<WORD>(key);
+  }
+  inputs[1].ki.dwFlags = KEYEVENTF_KEYUP;
+  return ::SendInput(2, inputs, sizeof(INPUT)) == 2;
+}
+
+}  // namespace nu
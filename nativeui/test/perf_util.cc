@@ -0,0 +1,68 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/test/perf_util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "base/strings/stringprintf.h"
+
+namespace nu {
+
+namespace {
+
+void PrintResult(const std::string& line) {
+  fputs(line.c_str(), stdout);
+
+  const char* output = getenv("NATIVEUI_PERF_OUTPUT");
+  if (output) {
+    FILE* file = fopen(output, "a");
+    if (file) {
+      fputs(line.c_str(), file);
+      fclose(file);
+    }
+  }
+}
+
+// Nearest-rank percentile of sorted |samples|.
+double GetPercentile(const std::vector<base::TimeDelta>& samples, int p) {
+  if (samples.empty())
+    return 0;
+  size_t rank = (samples.size() * p + 99) / 100;
+  return samples[std::max<size_t>(rank, 1) - 1].InMillisecondsF();
+}
+
+}  // namespace
+
+void RunPerfTest(const std::string& name,
+                 int iterations,
+                 const std::function<void(int)>& task) {
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < iterations; ++i)
+    task(i);
+  base::TimeDelta total = base::TimeTicks::Now() - start;
+
+  std::string line = base::StringPrintf(
+      "{\"test\":\"%s\",\"iterations\":%d,\"total_ms\":%.3f,"
+      "\"mean_us\":%.3f}\n",
+      name.c_str(), iterations, total.InMillisecondsF(),
+      total.InMicrosecondsF() / iterations);
+  PrintResult(line);
+}
+
+void ReportPercentiles(const std::string& name,
+                       std::vector<base::TimeDelta> samples) {
+  std::sort(samples.begin(), samples.end());
+  PrintResult(base::StringPrintf(
+      "{\"test\":\"%s\",\"samples\":%d,\"p50_ms\":%.3f,\"p99_ms\":%.3f,"
+      "\"max_ms\":%.3f}\n",
+      name.c_str(), static_cast<int>(samples.size()),
+      GetPercentile(samples, 50), GetPercentile(samples, 99),
+      GetPercentile(samples, 100)));
+}
+
+}  // namespace nu
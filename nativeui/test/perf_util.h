@@ -0,0 +1,34 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TEST_PERF_UTIL_H_
+#define NATIVEUI_TEST_PERF_UTIL_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+
+namespace nu {
+
+// Run |task| for |iterations| times and print the result as one line of JSON:
+// {"test":"<name>","iterations":<n>,"total_ms":<t>,"mean_us":<m>}
+//
+// When the NATIVEUI_PERF_OUTPUT environment variable is set, the results are
+// also appended to the file it points to.
+void RunPerfTest(const std::string& name,
+                 int iterations,
+                 const std::function<void(int)>& task);
+
+// Print the percentiles of |samples| as one line of JSON:
+// {"test":"<name>","samples":<n>,"p50_ms":<p50>,"p99_ms":<p99>,"max_ms":<m>}
+//
+// The results are also appended to NATIVEUI_PERF_OUTPUT like RunPerfTest.
+void ReportPercentiles(const std::string& name,
+                       std::vector<base::TimeDelta> samples);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TEST_PERF_UTIL_H_
@@ -4,13 +4,65 @@
 
 #include "nativeui/text_edit.h"
 
+#include <algorithm>
+
+#include "nativeui/window.h"
+
 namespace nu {
 
 // static
 const char TextEdit::kClassName[] = "TextEdit";
 
+TextEdit::RangeAttributes::RangeAttributes() = default;
+
+TextEdit::RangeAttributes::RangeAttributes(const RangeAttributes&) = default;
+
+TextEdit::RangeAttributes::~RangeAttributes() = default;
+
 const char* TextEdit::GetClassName() const {
   return kClassName;
 }
 
+void TextEdit::AppendText(const std::string& text) {
+  pending_append_ += text;
+  if (append_frame_id_)
+    return;
+  Window* window = GetWindow();
+  if (!window) {
+    FlushAppend();
+    return;
+  }
+  // Keep a reference so the view is alive when the frame comes.
+  scoped_refptr<TextEdit> self(this);
+  append_frame_id_ = window->RequestFrame([self](double) {
+    self->append_frame_id_ = 0;
+    self->FlushAppend();
+  });
+}
+
+void TextEdit::SetMaxLines(int max) {
+  max_lines_ = std::max(0, max);
+}
+
+void TextEdit::SetAutoScroll(bool auto_scroll) {
+  auto_scroll_ = auto_scroll;
+}
+
+void TextEdit::FlushAppend() {
+  if (pending_append_.empty())
+    return;
+  // Check before inserting, as the end moves away after appending.
+  bool scroll = auto_scroll_ && PlatformIsScrolledToEnd();
+  std::string text;
+  text.swap(pending_append_);
+  PlatformAppendText(text);
+  if (max_lines_ > 0) {
+    int extra = PlatformGetLineCount() - max_lines_;
+    if (extra > 0)
+      PlatformDeleteLines(extra);
+  }
+  if (scroll)
+    PlatformScrollToEnd();
+}
+
 }  // namespace nu
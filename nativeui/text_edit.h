@@ -7,13 +7,30 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
 
+#include "base/optional.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/gfx/font.h"
 #include "nativeui/scroll.h"
 
 namespace nu {
 
 class NATIVEUI_EXPORT TextEdit : public View {
  public:
+  // The style of characters in [start, end), only the attributes that are set
+  // are changed.
+  struct NATIVEUI_EXPORT RangeAttributes {
+    RangeAttributes();
+    RangeAttributes(const RangeAttributes&);
+    ~RangeAttributes();
+
+    int start = 0;
+    int end = 0;
+    scoped_refptr<Font> font;
+    base::Optional<Color> color;
+  };
+
   TextEdit();
 
   // View class name.
@@ -43,6 +60,27 @@ class NATIVEUI_EXPORT TextEdit : public View {
   void Delete();
   void DeleteRange(int start, int end);
 
+  // Append |text| to the end without moving the selection. Appends in the
+  // same frame are inserted at once, and are not recorded for undo.
+  void AppendText(const std::string& text);
+
+  // Remove lines from the beginning when appending more than |max| lines,
+  // 0 means no limit.
+  void SetMaxLines(int max);
+  int GetMaxLines() const { return max_lines_; }
+
+  // Keep the end visible when appending, if it was visible before.
+  void SetAutoScroll(bool auto_scroll);
+  bool IsAutoScroll() const { return auto_scroll_; }
+
+  // Style many ranges of text in one pass, which is much cheaper than styling
+  // them one by one. The styles are not recorded for undo.
+  void SetAttributesForRanges(const std::vector<RangeAttributes>& ranges);
+
+  // Restore the text between |start| and |end| to the view's font and color,
+  // passing -1 as |end| means the rest of the text.
+  void ClearAttributesInRange(int start, int end);
+
 #if !defined(OS_WIN)
   void SetOverlayScrollbar(bool overlay);
 #endif
@@ -52,12 +90,33 @@ class NATIVEUI_EXPORT TextEdit : public View {
 
   // Events.
   Signal<void(TextEdit*)> on_text_change;
+  // Emitted after |removed| characters starting from |start| have been
+  // replaced with the |inserted| text, so the changes of large documents
+  // can be processed without reading the whole text.
+  Signal<void(TextEdit*, int, int, const std::string&)> on_text_range_change;
 
   // Delegate methods.
   std::function<bool(TextEdit*)> should_insert_new_line;
 
  protected:
   ~TextEdit() override;
+
+  // Insert the text to the end without changing selection or scrolling.
+  void PlatformAppendText(const std::string& text);
+  int PlatformGetLineCount() const;
+  // Remove the first |count| lines.
+  void PlatformDeleteLines(int count);
+  bool PlatformIsScrolledToEnd() const;
+  void PlatformScrollToEnd();
+
+ private:
+  // Insert the appended text in one batch.
+  void FlushAppend();
+
+  std::string pending_append_;
+  int append_frame_id_ = 0;
+  int max_lines_ = 0;
+  bool auto_scroll_ = false;
 };
 
 }  // namespace nu
@@ -96,3 +96,47 @@ TEST_F(TextEditTest, Undo) {
   EXPECT_EQ(edit_->CanUndo(), true);
   EXPECT_EQ(edit_->CanRedo(), false);
 }
+
+TEST_F(TextEditTest, TextRangeChange) {
+  edit_->SetText("abcde");
+  std::vector<std::tuple<int, int, std::string>> changes;
+  edit_->on_text_range_change.Connect(
+      [&](nu::TextEdit*, int start, int removed, const std::string& inserted) {
+    changes.emplace_back(start, removed, inserted);
+  });
+  edit_->InsertTextAt("xy", 2);
+  ASSERT_FALSE(changes.empty());
+  EXPECT_EQ(changes.back(), std::make_tuple(2, 0, std::string("xy")));
+  edit_->DeleteRange(1, 4);
+  EXPECT_EQ(changes.back(), std::make_tuple(1, 3, std::string()));
+  EXPECT_EQ(edit_->GetText(), "ade");
+}
+
+TEST_F(TextEditTest, AppendText) {
+  edit_->SetText("a");
+  edit_->SelectRange(0, 1);
+  edit_->SetMaxLines(2);
+  edit_->AppendText("\nb\nc");
+  // Without window the text is appended immediately.
+  std::string text = edit_->GetText();
+  ASSERT_FALSE(text.empty());
+  EXPECT_EQ(text.front(), 'b');
+  EXPECT_EQ(text.back(), 'c');
+  EXPECT_EQ(edit_->CanUndo(), false);
+}
+
+TEST_F(TextEditTest, SetAttributesForRanges) {
+  edit_->SetText("int main");
+  edit_->SelectRange(1, 2);
+  std::vector<nu::TextEdit::RangeAttributes> ranges(2);
+  ranges[0].end = 3;
+  ranges[0].color = nu::Color(0xFF, 0, 0);
+  ranges[1].start = 4;
+  ranges[1].end = 8;
+  ranges[1].font = nu::Font::Default();
+  edit_->SetAttributesForRanges(ranges);
+  edit_->ClearAttributesInRange(0, -1);
+  // Styling changes neither text nor selection.
+  EXPECT_EQ(edit_->GetText(), "int main");
+  EXPECT_EQ(edit_->GetSelectionRange(), std::make_tuple(1, 2));
+}
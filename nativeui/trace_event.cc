@@ -0,0 +1,251 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/trace_event.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/json/json_writer.h"
+#include "base/no_destructor.h"
+#include "base/process/process_handle.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/thread_local_storage.h"
+#include "base/values.h"
+
+namespace nu {
+
+namespace {
+
+// Create an event of the Trace Event Format.
+base::Value CreateLogEvent(const char* name, const char* phase, int tid) {
+  base::Value event(base::Value::Type::DICTIONARY);
+  event.SetKey("name", base::Value(name));
+  event.SetKey("ph", base::Value(phase));
+  event.SetKey("pid", base::Value(static_cast<int>(base::GetCurrentProcId())));
+  event.SetKey("tid", base::Value(tid));
+  return event;
+}
+
+}  // namespace
+
+struct TraceLog::ThreadBuffer {
+  struct Event {
+    const char* category;
+    const char* name;
+    base::TimeTicks start;
+    base::TimeDelta duration;
+    char arg[kMaxArgLength + 1];
+  };
+
+  int tid = 0;
+  std::string thread_name;
+
+  // Only written by the owner thread, the events before |next| are complete.
+  std::atomic<uint64_t> next{0};
+  // Events before |cleared| are discarded, guarded by the lock of TraceLog.
+  uint64_t cleared = 0;
+
+  std::array<Event, kBufferSize> events;
+};
+
+// static
+const size_t TraceLog::kBufferSize;
+// static
+const size_t TraceLog::kMaxArgLength;
+// static
+const size_t TraceLog::kMaxCategories;
+// static
+const size_t TraceLog::kMaxExitedBuffers;
+
+// static
+TraceLog* TraceLog::GetInstance() {
+  static base::NoDestructor<TraceLog> instance;
+  return instance.get();
+}
+
+TraceLog::TraceLog() {}
+
+TraceLog::~TraceLog() {}
+
+void TraceLog::Start(const std::string& categories) {
+  base::AutoLock auto_lock(lock_);
+  recording_ = true;
+  enabled_categories_ = base::SplitString(
+      categories, ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  for (size_t i = 0; i < category_count_; ++i)
+    categories_[i].enabled = IsCategoryEnabled(categories_[i].name);
+}
+
+void TraceLog::Stop() {
+  base::AutoLock auto_lock(lock_);
+  recording_ = false;
+  enabled_categories_.clear();
+  for (size_t i = 0; i < category_count_; ++i)
+    categories_[i].enabled = false;
+}
+
+bool TraceLog::IsRecording() const {
+  base::AutoLock auto_lock(lock_);
+  return recording_;
+}
+
+void TraceLog::Clear() {
+  base::AutoLock auto_lock(lock_);
+  for (const auto& buffer : buffers_)
+    buffer->cleared = buffer->next.load(std::memory_order_acquire);
+}
+
+std::string TraceLog::ToTraceJSON() {
+  base::Value::ListStorage events;
+  base::AutoLock auto_lock(lock_);
+  for (const auto& buffer : buffers_) {
+    uint64_t end = buffer->next.load(std::memory_order_acquire);
+    uint64_t begin = std::max<uint64_t>(buffer->cleared,
+                              end > kBufferSize ? end - kBufferSize : 0);
+    if (begin == end)
+      continue;
+    std::vector<ThreadBuffer::Event> copied;
+    copied.reserve(end - begin);
+    for (uint64_t i = begin; i < end; ++i)
+      copied.push_back(buffer->events[i % kBufferSize]);
+    // The owner thread may have overwritten the oldest events while copying.
+    uint64_t now = buffer->next.load(std::memory_order_acquire);
+    size_t dropped = 0;
+    if (now > kBufferSize && now - kBufferSize > begin)
+      dropped = std::min<uint64_t>(now - kBufferSize - begin, copied.size());
+
+    base::Value metadata = CreateLogEvent("thread_name", "M", buffer->tid);
+    base::Value args(base::Value::Type::DICTIONARY);
+    args.SetKey("name", base::Value(buffer->thread_name));
+    metadata.SetKey("args", std::move(args));
+    events.push_back(std::move(metadata));
+
+    for (size_t i = dropped; i < copied.size(); ++i) {
+      const ThreadBuffer::Event& e = copied[i];
+      base::Value event = CreateLogEvent(e.name, "X", buffer->tid);
+      event.SetKey("cat", base::Value(e.category));
+      event.SetKey("ts", base::Value(
+          (e.start - base::TimeTicks()).InMicrosecondsF()));
+      event.SetKey("dur", base::Value(e.duration.InMicrosecondsF()));
+      if (e.arg[0] != '\0') {
+        base::Value event_args(base::Value::Type::DICTIONARY);
+        event_args.SetKey("arg", base::Value(e.arg));
+        event.SetKey("args", std::move(event_args));
+      }
+      events.push_back(std::move(event));
+    }
+  }
+
+  base::Value trace(base::Value::Type::DICTIONARY);
+  trace.SetKey("traceEvents", base::Value(std::move(events)));
+  trace.SetKey("displayTimeUnit", base::Value("ms"));
+  std::string json;
+  base::JSONWriter::Write(trace, &json);
+  return json;
+}
+
+const std::atomic<bool>* TraceLog::GetCategoryFlag(const char* category) {
+  base::AutoLock auto_lock(lock_);
+  for (size_t i = 0; i < category_count_; ++i) {
+    if (strcmp(categories_[i].name, category) == 0)
+      return &categories_[i].enabled;
+  }
+  if (category_count_ >= kMaxCategories)
+    return &disabled_flag_;
+  Category& added = categories_[category_count_++];
+  added.name = category;
+  added.enabled = IsCategoryEnabled(category);
+  return &added.enabled;
+}
+
+void TraceLog::AddEvent(const char* category,
+                        const char* name,
+                        base::TimeTicks start,
+                        base::TimeDelta duration,
+                        base::StringPiece arg) {
+  ThreadBuffer* buffer = GetThreadBuffer();
+  uint64_t index = buffer->next.load(std::memory_order_relaxed);
+  ThreadBuffer::Event& event = buffer->events[index % kBufferSize];
+  event.category = category;
+  event.name = name;
+  event.start = start;
+  event.duration = duration;
+  size_t length = std::min(arg.size(), kMaxArgLength);
+  if (length > 0)
+    memcpy(event.arg, arg.data(), length);
+  event.arg[length] = '\0';
+  buffer->next.store(index + 1, std::memory_order_release);
+}
+
+bool TraceLog::IsCategoryEnabled(const char* category) const {
+  if (!recording_)
+    return false;
+  for (const std::string& enabled : enabled_categories_) {
+    if (enabled == "*" || enabled == category)
+      return true;
+  }
+  return false;
+}
+
+TraceLog::ThreadBuffer* TraceLog::GetThreadBuffer() {
+  // The slot notifies when threads exit, so their buffers can be reused.
+  static base::NoDestructor<base::ThreadLocalStorage::Slot> tls_buffer(
+      &TraceLog::OnThreadExit);
+  auto* buffer = static_cast<ThreadBuffer*>(tls_buffer->Get());
+  if (buffer)
+    return buffer;
+  int tid = static_cast<int>(base::PlatformThread::CurrentId());
+  std::string thread_name = base::PlatformThread::GetName();
+  if (thread_name.empty())
+    thread_name = base::StringPrintf("Thread %d", tid);
+  base::AutoLock auto_lock(lock_);
+  buffer = TakeExitedBuffer(thread_name);
+  if (!buffer) {
+    buffer = new ThreadBuffer;
+    buffers_.emplace_back(buffer);
+  }
+  buffer->tid = tid;
+  buffer->thread_name = std::move(thread_name);
+  tls_buffer->Set(buffer);
+  return buffer;
+}
+
+TraceLog::ThreadBuffer* TraceLog::TakeExitedBuffer(
+    const std::string& thread_name) {
+  // A worker re-created for new jobs continues the events of the last one.
+  auto it = std::find_if(exited_buffers_.begin(), exited_buffers_.end(),
+                         [&thread_name](ThreadBuffer* buffer) {
+    return buffer->thread_name == thread_name;
+  });
+  if (it != exited_buffers_.end()) {
+    ThreadBuffer* buffer = *it;
+    exited_buffers_.erase(it);
+    return buffer;
+  }
+  if (exited_buffers_.size() < kMaxExitedBuffers)
+    return nullptr;
+  // Drop the events of the thread that exited first.
+  ThreadBuffer* buffer = exited_buffers_.front();
+  exited_buffers_.pop_front();
+  buffer->cleared = buffer->next.load(std::memory_order_relaxed);
+  return buffer;
+}
+
+// static
+void TraceLog::OnThreadExit(void* buffer) {
+  TraceLog* self = GetInstance();
+  base::AutoLock auto_lock(self->lock_);
+  self->exited_buffers_.push_back(static_cast<ThreadBuffer*>(buffer));
+}
+
+void ScopedTraceEvent::End() {
+  TraceLog::GetInstance()->AddEvent(category_, name_, start_,
+                                    base::TimeTicks::Now() - start_, arg_);
+}
+
+}  // namespace nu
@@ -0,0 +1,184 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TRACE_EVENT_H_
+#define NATIVEUI_TRACE_EVENT_H_
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "nativeui/nativeui_export.h"
+
+namespace base {
+template <typename T> class NoDestructor;
+}
+
+// Record the time spent in current scope as one event named |name| under
+// |category|, both must be string literals. When the category is not being
+// recorded the cost is one relaxed atomic load.
+#define NU_TRACE_EVENT(category, name) \
+    NU_TRACE_EVENT_WITH_ARG(category, name, base::StringPiece())
+
+// Same with NU_TRACE_EVENT but also records |arg| with the event, which must
+// outlive current scope and is truncated to TraceLog::kMaxArgLength.
+#define NU_TRACE_EVENT_WITH_ARG(category, name, arg) \
+    static const std::atomic<bool>* NU_TRACE_UID(nu_trace_flag_) = \
+        nu::TraceLog::GetInstance()->GetCategoryFlag(category); \
+    nu::ScopedTraceEvent NU_TRACE_UID(nu_trace_event_)( \
+        NU_TRACE_UID(nu_trace_flag_), category, name, arg)
+
+#define NU_TRACE_UID(prefix) NU_TRACE_CONCAT(prefix, __LINE__)
+#define NU_TRACE_CONCAT(a, b) NU_TRACE_CONCAT_INTERNAL(a, b)
+#define NU_TRACE_CONCAT_INTERNAL(a, b) a##b
+
+namespace nu {
+
+// Records trace events of all threads in the Trace Event Format, which can
+// be loaded in chrome://tracing and Perfetto.
+//
+// Each thread writes events to its own ring buffer without locking, and only
+// the most recent kBufferSize events of each thread are kept.
+class NATIVEUI_EXPORT TraceLog {
+ public:
+  // Number of events kept for each thread.
+  static const size_t kBufferSize = 4096;
+
+  // Max length of the argument recorded with an event.
+  static const size_t kMaxArgLength = 31;
+
+  // Max number of categories, events of the categories registered after the
+  // limit are never recorded.
+  static const size_t kMaxCategories = 64;
+
+  // Max number of buffers kept for exited threads. New threads reuse the
+  // buffer of an exited thread with the same name, or the oldest one when
+  // the limit is reached.
+  static const size_t kMaxExitedBuffers = 8;
+
+  static TraceLog* GetInstance();
+
+  // Start recording events of |categories|, which is a comma separated list
+  // of category names, "*" records all categories.
+  void Start(const std::string& categories);
+  void Stop();
+  bool IsRecording() const;
+
+  // Discard recorded events.
+  void Clear();
+
+  // Export recorded events of all threads, each thread is shown with its
+  // name. Events being overwritten while exporting are dropped.
+  std::string ToTraceJSON();
+
+  // Internal: Return the flag telling whether |category| is being recorded,
+  // the returned pointer is valid forever.
+  const std::atomic<bool>* GetCategoryFlag(const char* category);
+
+  // Internal: Append an event to the buffer of current thread.
+  void AddEvent(const char* category,
+                const char* name,
+                base::TimeTicks start,
+                base::TimeDelta duration,
+                base::StringPiece arg);
+
+ private:
+  friend class base::NoDestructor<TraceLog>;
+
+  struct Category {
+    const char* name = nullptr;
+    std::atomic<bool> enabled{false};
+  };
+
+  struct ThreadBuffer;
+
+  TraceLog();
+  ~TraceLog();
+
+  // Return whether the |category| matches the categories being recorded.
+  bool IsCategoryEnabled(const char* category) const;
+
+  // Return the buffer of current thread, create one if not exist.
+  ThreadBuffer* GetThreadBuffer();
+
+  // Take a buffer of exited threads for the thread named |thread_name|.
+  ThreadBuffer* TakeExitedBuffer(const std::string& thread_name);
+
+  // Called when a thread with buffer exits.
+  static void OnThreadExit(void* buffer);
+
+  mutable base::Lock lock_;
+
+  bool recording_ = false;
+  std::vector<std::string> enabled_categories_;
+
+  std::array<Category, kMaxCategories> categories_;
+  size_t category_count_ = 0;
+
+  // Returned for categories registered after the limit.
+  std::atomic<bool> disabled_flag_{false};
+
+  // The buffers are kept after their threads exit, so events recorded in
+  // workers can still be exported.
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+  // Buffers of exited threads in the order of exiting, which are reused by
+  // new threads so workers created for each job do not grow the memory.
+  std::deque<ThreadBuffer*> exited_buffers_;
+};
+
+// Internal: Record the time spent in the scope as one trace event.
+class NATIVEUI_EXPORT ScopedTraceEvent {
+ public:
+  ScopedTraceEvent(const std::atomic<bool>* flag,
+                   const char* category,
+                   const char* name,
+                   base::StringPiece arg = base::StringPiece())
+      : category_(category),
+        name_(name),
+        arg_(arg),
+        enabled_(flag->load(std::memory_order_relaxed)) {
+    if (enabled_)
+      start_ = base::TimeTicks::Now();
+  }
+
+  ~ScopedTraceEvent() {
+    if (enabled_)
+      End();
+  }
+
+ private:
+  void End();
+
+  const char* category_;
+  const char* name_;
+  base::StringPiece arg_;
+  base::TimeTicks start_;
+  bool enabled_;
+};
+
+// Internal: Wrap |slot| so each call to it is recorded as one trace event.
+template<typename R, typename... Args>
+std::function<R(Args...)> TraceSlot(const char* category,
+                                    const char* name,
+                                    std::function<R(Args...)> slot) {
+  const std::atomic<bool>* flag =
+      TraceLog::GetInstance()->GetCategoryFlag(category);
+  return [flag, category, name, slot](Args... args) -> R {
+    ScopedTraceEvent event(flag, category, name);
+    return slot(std::forward<Args>(args)...);
+  };
+}
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TRACE_EVENT_H_
@@ -0,0 +1,135 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <thread>
+
+#include "base/json/json_reader.h"
+#include "base/threading/platform_thread.h"
+#include "base/values.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class TraceEventTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    trace_log_->Clear();
+  }
+
+  void TearDown() override {
+    trace_log_->Stop();
+  }
+
+  // Return the complete events in exported trace.
+  std::vector<base::Value> GetEvents() {
+    base::Optional<base::Value> trace =
+        base::JSONReader::Read(trace_log_->ToTraceJSON());
+    std::vector<base::Value> events;
+    for (base::Value& event : trace->FindKey("traceEvents")->GetList()) {
+      if (event.FindKey("ph")->GetString() == "X")
+        events.push_back(std::move(event));
+    }
+    return events;
+  }
+
+  nu::TraceLog* trace_log_ = nu::TraceLog::GetInstance();
+};
+
+TEST_F(TraceEventTest, Disabled) {
+  {
+    NU_TRACE_EVENT("test", "Disabled");
+  }
+  EXPECT_TRUE(GetEvents().empty());
+}
+
+TEST_F(TraceEventTest, RecordEnabledCategories) {
+  trace_log_->Start("test, other");
+  std::string arg = "arg";
+  {
+    NU_TRACE_EVENT("test", "Outer");
+    NU_TRACE_EVENT("ignored", "Ignored");
+    NU_TRACE_EVENT_WITH_ARG("test", "Inner", arg);
+  }
+  trace_log_->Stop();
+  {
+    NU_TRACE_EVENT("test", "Stopped");
+  }
+  std::vector<base::Value> events = GetEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].FindKey("name")->GetString(), "Inner");
+  EXPECT_EQ(events[0].FindPath({"args", "arg"})->GetString(), "arg");
+  EXPECT_EQ(events[1].FindKey("name")->GetString(), "Outer");
+  EXPECT_EQ(events[1].FindKey("cat")->GetString(), "test");
+  EXPECT_GE(events[1].FindKey("dur")->GetDouble(),
+            events[0].FindKey("dur")->GetDouble());
+}
+
+TEST_F(TraceEventTest, KeepRecentEvents) {
+  trace_log_->Start("*");
+  for (size_t i = 0; i < nu::TraceLog::kBufferSize + 10; ++i) {
+    NU_TRACE_EVENT("test", "Loop");
+  }
+  EXPECT_EQ(GetEvents().size(), nu::TraceLog::kBufferSize);
+  trace_log_->Clear();
+  EXPECT_TRUE(GetEvents().empty());
+}
+
+TEST_F(TraceEventTest, RecordOtherThreads) {
+  trace_log_->Start("test");
+  std::thread thread([]() {
+    NU_TRACE_EVENT("test", "Thread");
+  });
+  thread.join();
+  {
+    NU_TRACE_EVENT("test", "Main");
+  }
+  std::vector<base::Value> events = GetEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_NE(events[0].FindKey("tid")->GetInt(),
+            events[1].FindKey("tid")->GetInt());
+}
+
+TEST_F(TraceEventTest, TraceSlot) {
+  trace_log_->Start("test");
+  int value = 0;
+  std::function<int(int)> slot = [&](int i) { return value = i; };
+  slot = nu::TraceSlot("test", "Slot", std::move(slot));
+  EXPECT_EQ(slot(42), 42);
+  EXPECT_EQ(value, 42);
+  std::vector<base::Value> events = GetEvents();
+  ASSERT_EQ(events.size(), 1u);
+  EXPECT_EQ(events[0].FindKey("name")->GetString(), "Slot");
+}
+
+TEST_F(TraceEventTest, ReuseBuffersOfExitedThreads) {
+  trace_log_->Start("test");
+  // Workers with the same name share one buffer.
+  for (int i = 0; i < 2; ++i) {
+    std::thread thread([]() {
+      base::PlatformThread::SetName("TraceWorker");
+      NU_TRACE_EVENT("test", "Worker");
+    });
+    thread.join();
+  }
+  std::vector<base::Value> events = GetEvents();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].FindKey("tid")->GetInt(),
+            events[1].FindKey("tid")->GetInt());
+  trace_log_->Clear();
+  // Only a limited number of buffers are kept for exited threads.
+  for (size_t i = 0; i < nu::TraceLog::kMaxExitedBuffers * 2; ++i) {
+    std::thread thread([]() {
+      NU_TRACE_EVENT("test", "Thread");
+    });
+    thread.join();
+  }
+  base::Optional<base::Value> trace =
+      base::JSONReader::Read(trace_log_->ToTraceJSON());
+  size_t threads = 0;
+  for (const base::Value& event : trace->FindKey("traceEvents")->GetList()) {
+    if (event.FindKey("ph")->GetString() == "M")
+      ++threads;
+  }
+  EXPECT_LE(threads, nu::TraceLog::kMaxExitedBuffers);
+  EXPECT_GE(GetEvents().size(), nu::TraceLog::kMaxExitedBuffers);
+}
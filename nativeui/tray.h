@@ -14,6 +14,7 @@
 
 namespace nu {
 
+class Canvas;
 class Image;
 class Menu;
 class RectF;
@@ -35,6 +36,7 @@ class NATIVEUI_EXPORT Tray : public base::RefCounted<Tray> {
   void SetTitle(const std::string& title);
 #endif
   void SetImage(scoped_refptr<Image> icon);
+  void SetImageFromCanvas(scoped_refptr<Canvas> canvas);
 #if defined(OS_MAC)
   void SetPressedImage(scoped_refptr<Image> icon);
 #endif
@@ -65,6 +67,11 @@ class NATIVEUI_EXPORT Tray : public base::RefCounted<Tray> {
   int icon_change_count_ = 0;
 #endif
 
+#if defined(OS_MAC)
+  // The canvas shown as icon, which is redrawn when set again.
+  scoped_refptr<Canvas> canvas_;
+#endif
+
   scoped_refptr<Menu> menu_;
 
   NativeTray tray_ = nullptr;
@@ -0,0 +1,207 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree_model.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/logging.h"
+#include "nativeui/tree_view.h"
+
+namespace nu {
+
+///////////////////////////////////////////////////////////////////////////////
+// TreeModel implementation.
+
+// static
+const uint32_t TreeModel::kRootNode;
+
+TreeModel::TreeModel() {}
+
+TreeModel::~TreeModel() {}
+
+bool TreeModel::HasChildren(uint32_t node) const {
+  return GetChildCount(node) > 0;
+}
+
+void TreeModel::NotifyChildrenInserted(uint32_t parent,
+                                       uint32_t start,
+                                       uint32_t count) {
+  if (count == 0)
+    return;
+  for (TreeView* view : views_)
+    view->NotifyChildrenInserted(parent, start, count);
+}
+
+void TreeModel::NotifyChildrenDeleted(uint32_t parent,
+                                      uint32_t start,
+                                      uint32_t count) {
+  if (count == 0)
+    return;
+  for (TreeView* view : views_)
+    view->NotifyChildrenDeleted(parent, start, count);
+}
+
+void TreeModel::NotifyNodeChanged(uint32_t node) {
+  for (TreeView* view : views_)
+    view->NotifyNodeChanged(node);
+}
+
+void TreeModel::NotifyChildrenReset(uint32_t parent) {
+  for (TreeView* view : views_)
+    view->NotifyChildrenReset(parent);
+}
+
+void TreeModel::Subscribe(TreeView* view) {
+  views_.push_back(view);
+}
+
+void TreeModel::Unsubscribe(TreeView* view) {
+  views_.remove(view);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// AbstractTreeModel implementation.
+
+AbstractTreeModel::AbstractTreeModel(bool index_starts_from_0)
+    : index_starts_from_0_(index_starts_from_0) {}
+
+AbstractTreeModel::~AbstractTreeModel() {}
+
+uint32_t AbstractTreeModel::GetChildCount(uint32_t parent) const {
+  if (!get_child_count)
+    return 0;
+  return get_child_count(const_cast<AbstractTreeModel*>(this), parent);
+}
+
+uint32_t AbstractTreeModel::GetChild(uint32_t parent, uint32_t index) const {
+  if (!get_child)
+    return kRootNode;
+  if (!index_starts_from_0_)
+    index += 1;
+  return get_child(const_cast<AbstractTreeModel*>(this), parent, index);
+}
+
+bool AbstractTreeModel::HasChildren(uint32_t node) const {
+  if (!has_children)
+    return TreeModel::HasChildren(node);
+  return has_children(const_cast<AbstractTreeModel*>(this), node);
+}
+
+const base::Value* AbstractTreeModel::GetValue(uint32_t node,
+                                               uint32_t column) const {
+  if (!get_value)
+    return nullptr;
+  if (!index_starts_from_0_)
+    column += 1;
+  // We can not get a reference from scripting languages, so we just store a
+  // temporary copy and return a reference to the copy.
+  auto* self = const_cast<AbstractTreeModel*>(this);
+  self->copy_ = get_value(self, node, column);
+  return &copy_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SimpleTreeModel implementation.
+
+SimpleTreeModel::SimpleTreeModel() {
+  nodes_[kRootNode];
+}
+
+SimpleTreeModel::~SimpleTreeModel() {}
+
+uint32_t SimpleTreeModel::AddNode(uint32_t parent, Row data) {
+  std::vector<Row> rows;
+  rows.push_back(std::move(data));
+  std::vector<uint32_t> ids = AddNodes(parent, std::move(rows));
+  return ids.empty() ? kRootNode : ids[0];
+}
+
+std::vector<uint32_t> SimpleTreeModel::AddNodes(uint32_t parent,
+                                                std::vector<Row> rows) {
+  std::vector<uint32_t> ids;
+  auto it = nodes_.find(parent);
+  if (it == nodes_.end()) {
+    LOG(ERROR) << "AddNodes failed because parent is not in model.";
+    return ids;
+  }
+  ids.reserve(rows.size());
+  for (Row& row : rows) {
+    uint32_t id = next_id_++;
+    Node& node = nodes_[id];
+    node.parent = parent;
+    node.data = std::move(row);
+    ids.push_back(id);
+  }
+  // Looking up again as inserting may invalidate the iterator.
+  std::vector<uint32_t>& children = nodes_[parent].children;
+  uint32_t start = static_cast<uint32_t>(children.size());
+  children.insert(children.end(), ids.begin(), ids.end());
+  NotifyChildrenInserted(parent, start, static_cast<uint32_t>(ids.size()));
+  return ids;
+}
+
+void SimpleTreeModel::RemoveNode(uint32_t node) {
+  auto it = nodes_.find(node);
+  if (node == kRootNode || it == nodes_.end()) {
+    LOG(ERROR) << "RemoveNode failed because node is not in model.";
+    return;
+  }
+  uint32_t parent = it->second.parent;
+  std::vector<uint32_t>& children = nodes_[parent].children;
+  auto child = std::find(children.begin(), children.end(), node);
+  uint32_t index = static_cast<uint32_t>(child - children.begin());
+  children.erase(child);
+  EraseNode(node);
+  NotifyChildrenDeleted(parent, index, 1);
+}
+
+void SimpleTreeModel::SetValue(uint32_t node, uint32_t column,
+                               base::Value value) {
+  auto it = nodes_.find(node);
+  if (it == nodes_.end() || column >= it->second.data.size())
+    return;
+  it->second.data[column] = std::move(value);
+  NotifyNodeChanged(node);
+}
+
+uint32_t SimpleTreeModel::GetParent(uint32_t node) const {
+  auto it = nodes_.find(node);
+  return it == nodes_.end() ? kRootNode : it->second.parent;
+}
+
+uint32_t SimpleTreeModel::GetChildCount(uint32_t parent) const {
+  auto it = nodes_.find(parent);
+  if (it == nodes_.end())
+    return 0;
+  return static_cast<uint32_t>(it->second.children.size());
+}
+
+uint32_t SimpleTreeModel::GetChild(uint32_t parent, uint32_t index) const {
+  auto it = nodes_.find(parent);
+  if (it == nodes_.end() || index >= it->second.children.size())
+    return kRootNode;
+  return it->second.children[index];
+}
+
+const base::Value* SimpleTreeModel::GetValue(uint32_t node,
+                                             uint32_t column) const {
+  auto it = nodes_.find(node);
+  if (it == nodes_.end() || column >= it->second.data.size())
+    return nullptr;
+  return &it->second.data[column];
+}
+
+void SimpleTreeModel::EraseNode(uint32_t node) {
+  auto it = nodes_.find(node);
+  if (it == nodes_.end())
+    return;
+  std::vector<uint32_t> children = std::move(it->second.children);
+  nodes_.erase(it);
+  for (uint32_t child : children)
+    EraseNode(child);
+}
+
+}  // namespace nu
@@ -0,0 +1,146 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TREE_MODEL_H_
+#define NATIVEUI_TREE_MODEL_H_
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/values.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class TreeView;
+
+// Provides hierarchical data to TreeView.
+//
+// Nodes are identified by IDs chosen by the model, the root node which is not
+// shown has the ID of kRootNode. The children of a node are only requested
+// when the node is expanded, so a model can load them lazily.
+class NATIVEUI_EXPORT TreeModel : public base::RefCounted<TreeModel> {
+ public:
+  static const uint32_t kRootNode = 0;
+
+  // Return how many children |parent| has.
+  virtual uint32_t GetChildCount(uint32_t parent) const = 0;
+
+  // Return the ID of the child at |index| of |parent|.
+  virtual uint32_t GetChild(uint32_t parent, uint32_t index) const = 0;
+
+  // Return whether |node| can be expanded, this is used for showing the
+  // expanders without loading the children.
+  virtual bool HasChildren(uint32_t node) const;
+
+  // Return the data of |column| of |node|.
+  // Caller should not store the return value, as it is a temporary reference
+  // that may immediately get destroyed after exiting current stack.
+  virtual const base::Value* GetValue(uint32_t node, uint32_t column) const = 0;
+
+  // Called by subclass to notify changes, |count| children starting from
+  // |start| of |parent| are notified at once.
+  void NotifyChildrenInserted(uint32_t parent, uint32_t start, uint32_t count);
+  void NotifyChildrenDeleted(uint32_t parent, uint32_t start, uint32_t count);
+  void NotifyNodeChanged(uint32_t node);
+
+  // Notify that all descendants of |parent| have changed.
+  void NotifyChildrenReset(uint32_t parent);
+
+ protected:
+  TreeModel();
+  virtual ~TreeModel();
+
+ private:
+  friend class base::RefCounted<TreeModel>;
+  friend class TreeView;
+
+  // Called by tree view.
+  void Subscribe(TreeView* view);
+  void Unsubscribe(TreeView* view);
+
+  std::list<TreeView*> views_;
+};
+
+// Used by language bindings.
+class NATIVEUI_EXPORT AbstractTreeModel : public TreeModel {
+ public:
+  explicit AbstractTreeModel(bool index_starts_from_0 = true);
+
+  // TreeModel:
+  uint32_t GetChildCount(uint32_t parent) const override;
+  uint32_t GetChild(uint32_t parent, uint32_t index) const override;
+  bool HasChildren(uint32_t node) const override;
+  const base::Value* GetValue(uint32_t node, uint32_t column) const override;
+
+  // Delegate methods, has_children is optional.
+  std::function<uint32_t(AbstractTreeModel*, uint32_t)> get_child_count;
+  std::function<uint32_t(AbstractTreeModel*, uint32_t, uint32_t)> get_child;
+  std::function<bool(AbstractTreeModel*, uint32_t)> has_children;
+  std::function<base::Value(AbstractTreeModel*,
+                            uint32_t, uint32_t)> get_value;
+
+ protected:
+  ~AbstractTreeModel() override;
+
+ private:
+  bool index_starts_from_0_;
+  base::Value copy_;
+};
+
+// A simple implementation of TreeModel that manages the data.
+class NATIVEUI_EXPORT SimpleTreeModel : public TreeModel {
+ public:
+  using Row = std::vector<base::Value>;
+
+  SimpleTreeModel();
+
+  // Append a node to |parent| and return its ID.
+  uint32_t AddNode(uint32_t parent, Row data);
+
+  // Append many nodes to |parent| with one notification, return their IDs.
+  std::vector<uint32_t> AddNodes(uint32_t parent, std::vector<Row> rows);
+
+  // Remove |node| and all its descendants.
+  void RemoveNode(uint32_t node);
+
+  // Change the value of |column| of |node|.
+  void SetValue(uint32_t node, uint32_t column, base::Value value);
+
+  // Return the parent of |node|.
+  uint32_t GetParent(uint32_t node) const;
+
+  // Return the number of nodes, the root excluded.
+  uint32_t GetNodeCount() const {
+    return static_cast<uint32_t>(nodes_.size() - 1);
+  }
+
+  // TreeModel:
+  uint32_t GetChildCount(uint32_t parent) const override;
+  uint32_t GetChild(uint32_t parent, uint32_t index) const override;
+  const base::Value* GetValue(uint32_t node, uint32_t column) const override;
+
+ protected:
+  ~SimpleTreeModel() override;
+
+ private:
+  struct Node {
+    uint32_t parent = kRootNode;
+    Row data;
+    std::vector<uint32_t> children;
+  };
+
+  // Remove |node| and its descendants from storage.
+  void EraseNode(uint32_t node);
+
+  uint32_t next_id_ = kRootNode + 1;
+  std::unordered_map<uint32_t, Node> nodes_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TREE_MODEL_H_
@@ -0,0 +1,205 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree_view.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace nu {
+
+// static
+const char TreeView::kClassName[] = "TreeView";
+
+TreeView::Node::Node(uint32_t id, Node* parent) : id(id), parent(parent) {}
+
+TreeView::Node::~Node() {}
+
+TreeView::TreeView() : root_(TreeModel::kRootNode, nullptr) {
+  root_.expanded = true;
+  TakeOverView(PlatformCreate());
+}
+
+TreeView::~TreeView() {
+  PlatformDestroy();
+  if (model_)
+    model_->Unsubscribe(this);
+}
+
+void TreeView::SetModel(scoped_refptr<TreeModel> model) {
+  if (model_)
+    model_->Unsubscribe(this);
+  // The old nodes must outlive the native widget's references to them.
+  Nodes removed = std::move(root_.children);
+  root_.children.clear();
+  root_.loaded = false;
+  nodes_.clear();
+  model_ = std::move(model);
+  // The children of root are always needed for showing the tree.
+  GetChildren(&root_);
+  PlatformSetModel(model_.get());
+  if (model_)
+    model_->Subscribe(this);
+}
+
+TreeModel* TreeView::GetModel() {
+  return model_.get();
+}
+
+void TreeView::ExpandNode(uint32_t id) {
+  Node* node = FindNode(id);
+  if (node && node != &root_)
+    PlatformExpandNode(node, true);
+}
+
+void TreeView::CollapseNode(uint32_t id) {
+  Node* node = FindNode(id);
+  if (node && node != &root_)
+    PlatformExpandNode(node, false);
+}
+
+bool TreeView::IsNodeExpanded(uint32_t id) const {
+  Node* node = FindNode(id);
+  return node && node->expanded;
+}
+
+void TreeView::SelectNode(uint32_t id) {
+  Node* node = FindNode(id);
+  if (node && node != &root_)
+    PlatformSelectNode(node);
+}
+
+uint32_t TreeView::GetSelectedNode() const {
+  Node* node = PlatformGetSelectedNode();
+  return node ? node->id : TreeModel::kRootNode;
+}
+
+const char* TreeView::GetClassName() const {
+  return kClassName;
+}
+
+TreeView::Node* TreeView::FindNode(uint32_t id) const {
+  if (id == TreeModel::kRootNode)
+    return const_cast<Node*>(&root_);
+  auto it = nodes_.find(id);
+  return it == nodes_.end() ? nullptr : it->second;
+}
+
+const TreeView::Nodes& TreeView::GetChildren(Node* node) {
+  if (node->loaded || !model_)
+    return node->children;
+  node->loaded = true;
+  uint32_t count = model_->GetChildCount(node->id);
+  node->children.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t id = model_->GetChild(node->id, i);
+    node->children.emplace_back(new Node(id, node));
+    node->children.back()->index = i;
+    nodes_[id] = node->children.back().get();
+  }
+  return node->children;
+}
+
+bool TreeView::HasChildren(Node* node) const {
+  if (node->loaded)
+    return !node->children.empty();
+  return model_ && model_->HasChildren(node->id);
+}
+
+void TreeView::OnNodeExpand(Node* node) {
+  if (node->expanded)
+    return;
+  node->expanded = true;
+  on_node_expand.Emit(this, node->id);
+}
+
+void TreeView::OnNodeCollapse(Node* node) {
+  if (!node->expanded)
+    return;
+  node->expanded = false;
+  on_node_collapse.Emit(this, node->id);
+}
+
+void TreeView::NotifyChildrenInserted(uint32_t parent_id,
+                                      uint32_t start,
+                                      uint32_t count) {
+  Node* parent = FindNode(parent_id);
+  if (!parent)
+    return;
+  // The children will be read when the node is expanded, only the expander
+  // needs updating.
+  if (!parent->loaded) {
+    PlatformNodeChanged(parent);
+    return;
+  }
+  start = std::min(start, static_cast<uint32_t>(parent->children.size()));
+  Nodes added;
+  added.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t id = model_->GetChild(parent_id, start + i);
+    added.emplace_back(new Node(id, parent));
+    nodes_[id] = added.back().get();
+  }
+  parent->children.insert(parent->children.begin() + start,
+                          std::make_move_iterator(added.begin()),
+                          std::make_move_iterator(added.end()));
+  UpdateIndexes(parent, start);
+  PlatformChildrenInserted(parent, start, count);
+}
+
+void TreeView::NotifyChildrenDeleted(uint32_t parent_id,
+                                     uint32_t start,
+                                     uint32_t count) {
+  Node* parent = FindNode(parent_id);
+  if (!parent)
+    return;
+  if (!parent->loaded) {
+    PlatformNodeChanged(parent);
+    return;
+  }
+  uint32_t size = static_cast<uint32_t>(parent->children.size());
+  start = std::min(start, size);
+  count = std::min(count, size - start);
+  auto first = parent->children.begin() + start;
+  Nodes removed(std::make_move_iterator(first),
+                std::make_move_iterator(first + count));
+  parent->children.erase(first, first + count);
+  for (const auto& node : removed)
+    ForgetNode(node.get());
+  UpdateIndexes(parent, start);
+  if (parent->children.empty() && parent != &root_)
+    parent->expanded = false;
+  PlatformChildrenDeleted(parent, start, removed);
+}
+
+void TreeView::NotifyNodeChanged(uint32_t id) {
+  Node* node = FindNode(id);
+  if (node)
+    PlatformNodeChanged(node);
+}
+
+void TreeView::NotifyChildrenReset(uint32_t parent_id) {
+  Node* parent = FindNode(parent_id);
+  if (!parent)
+    return;
+  Nodes removed = std::move(parent->children);
+  parent->children.clear();
+  parent->loaded = false;
+  for (const auto& node : removed)
+    ForgetNode(node.get());
+  PlatformChildrenReset(parent, removed);
+}
+
+void TreeView::UpdateIndexes(Node* node, uint32_t start) {
+  for (size_t i = start; i < node->children.size(); ++i)
+    node->children[i]->index = static_cast<uint32_t>(i);
+}
+
+void TreeView::ForgetNode(Node* node) {
+  nodes_.erase(node->id);
+  for (const auto& child : node->children)
+    ForgetNode(child.get());
+}
+
+}  // namespace nu
@@ -0,0 +1,125 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TREE_VIEW_H_
+#define NATIVEUI_TREE_VIEW_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nativeui/tree_model.h"
+#include "nativeui/view.h"
+
+namespace nu {
+
+// Shows the data of TreeModel as an outline.
+//
+// The children of a node are only read from the model when the node is
+// expanded, and are kept until the model notifies changes of them.
+class NATIVEUI_EXPORT TreeView : public View {
+ public:
+  // The mirror of a node that has been read from the model.
+  struct Node {
+    Node(uint32_t id, Node* parent);
+    ~Node();
+
+    uint32_t id;
+    Node* parent;
+    // The position in parent.
+    uint32_t index = 0;
+    // Whether the children have been read from the model.
+    bool loaded = false;
+    bool expanded = false;
+    std::vector<std::unique_ptr<Node>> children;
+  };
+
+  using Nodes = std::vector<std::unique_ptr<Node>>;
+
+  TreeView();
+
+  // View class name.
+  static const char kClassName[];
+
+  void SetModel(scoped_refptr<TreeModel> model);
+  TreeModel* GetModel();
+  void AddColumn(const std::string& title);
+  int GetColumnCount() const;
+  void SetColumnsVisible(bool visible);
+  bool IsColumnsVisible() const;
+
+  // The node must have been shown, i.e. all its ancestors are expanded.
+  void ExpandNode(uint32_t node);
+  void CollapseNode(uint32_t node);
+  bool IsNodeExpanded(uint32_t node) const;
+  void SelectNode(uint32_t node);
+  uint32_t GetSelectedNode() const;
+
+  // View:
+  const char* GetClassName() const override;
+
+  // Internal: Return the mirror of node |id|, or null if it is not loaded.
+  Node* FindNode(uint32_t id) const;
+  Node* GetRoot() { return &root_; }
+
+  // Internal: Return the children of |node|, read them from model if they
+  // have not been loaded.
+  const Nodes& GetChildren(Node* node);
+
+  // Internal: Return whether |node| can be expanded.
+  bool HasChildren(Node* node) const;
+
+  // Internal: Called by platform implementations when a node is toggled, the
+  // expanding is notified before reading children so the model can fill them.
+  void OnNodeExpand(Node* node);
+  void OnNodeCollapse(Node* node);
+
+  // Events.
+  Signal<void(TreeView*, uint32_t)> on_node_expand;
+  Signal<void(TreeView*, uint32_t)> on_node_collapse;
+  Signal<void(TreeView*)> on_selection_change;
+
+ protected:
+  ~TreeView() override;
+
+  NativeView PlatformCreate();
+  void PlatformDestroy();
+  void PlatformSetModel(TreeModel* model);
+  void PlatformExpandNode(Node* node, bool expand);
+  void PlatformSelectNode(Node* node);
+  Node* PlatformGetSelectedNode() const;
+
+  // Called after the mirror has been updated, the |removed| nodes are still
+  // alive when called.
+  void PlatformChildrenInserted(Node* parent, uint32_t start, uint32_t count);
+  void PlatformChildrenDeleted(Node* parent, uint32_t start,
+                               const Nodes& removed);
+  void PlatformNodeChanged(Node* node);
+  void PlatformChildrenReset(Node* parent, const Nodes& removed);
+
+ private:
+  friend class TreeModel;
+
+  // Called by TreeModel.
+  void NotifyChildrenInserted(uint32_t parent, uint32_t start, uint32_t count);
+  void NotifyChildrenDeleted(uint32_t parent, uint32_t start, uint32_t count);
+  void NotifyNodeChanged(uint32_t node);
+  void NotifyChildrenReset(uint32_t parent);
+
+  // Update the positions of children of |node|.
+  void UpdateIndexes(Node* node, uint32_t start);
+
+  // Remove |node| and its descendants from the ID map.
+  void ForgetNode(Node* node);
+
+  scoped_refptr<TreeModel> model_;
+
+  Node root_;
+  std::unordered_map<uint32_t, Node*> nodes_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TREE_VIEW_H_
@@ -0,0 +1,102 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class TreeViewTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    tree_ = new nu::TreeView();
+    tree_->AddColumn("Name");
+  }
+
+  std::vector<nu::SimpleTreeModel::Row> MakeRows(int count) {
+    std::vector<nu::SimpleTreeModel::Row> rows(count);
+    for (int i = 0; i < count; ++i)
+      rows[i].emplace_back(base::Value(std::to_string(i)));
+    return rows;
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::TreeView> tree_;
+};
+
+TEST_F(TreeViewTest, SimpleTreeModel) {
+  scoped_refptr<nu::SimpleTreeModel> model(new nu::SimpleTreeModel);
+  std::vector<uint32_t> ids = model->AddNodes(nu::TreeModel::kRootNode,
+                                              MakeRows(3));
+  ASSERT_EQ(ids.size(), 3u);
+  uint32_t child = model->AddNode(ids[1], MakeRows(1)[0]);
+  model->AddNodes(child, MakeRows(2));
+  EXPECT_EQ(model->GetNodeCount(), 6u);
+  EXPECT_EQ(model->GetChildCount(nu::TreeModel::kRootNode), 3u);
+  EXPECT_EQ(model->GetChild(ids[1], 0), child);
+  EXPECT_EQ(model->GetParent(child), ids[1]);
+  EXPECT_TRUE(model->HasChildren(ids[1]));
+  EXPECT_FALSE(model->HasChildren(ids[0]));
+  EXPECT_EQ(model->GetValue(ids[2], 0)->GetString(), "2");
+  model->SetValue(ids[2], 0, base::Value("b"));
+  EXPECT_EQ(model->GetValue(ids[2], 0)->GetString(), "b");
+  EXPECT_EQ(model->GetValue(ids[2], 1), nullptr);
+  // Removing a node removes its descendants.
+  model->RemoveNode(ids[1]);
+  EXPECT_EQ(model->GetNodeCount(), 2u);
+  EXPECT_EQ(model->GetChild(nu::TreeModel::kRootNode, 1), ids[2]);
+}
+
+TEST_F(TreeViewTest, LazyExpand) {
+  scoped_refptr<nu::AbstractTreeModel> model(new nu::AbstractTreeModel);
+  std::vector<uint32_t> requested;
+  model->get_child_count = [&](nu::AbstractTreeModel*, uint32_t parent) {
+    requested.push_back(parent);
+    return parent < 100 ? 3u : 0u;
+  };
+  model->get_child = [](nu::AbstractTreeModel*, uint32_t parent,
+                        uint32_t index) {
+    return (parent + 1) * 10 + index;
+  };
+  model->has_children = [](nu::AbstractTreeModel*, uint32_t node) {
+    return node < 100;
+  };
+  tree_->SetModel(model);
+  // Only the children of root are needed for showing the tree.
+  for (uint32_t node : requested)
+    EXPECT_EQ(node, nu::TreeModel::kRootNode);
+  // Nodes that have never been shown can not be expanded.
+  tree_->ExpandNode(110);
+  EXPECT_FALSE(tree_->IsNodeExpanded(110));
+  uint32_t expanded = 0;
+  tree_->on_node_expand.Connect([&](nu::TreeView*, uint32_t node) {
+    expanded = node;
+  });
+  tree_->ExpandNode(11);
+  EXPECT_EQ(expanded, 11u);
+  EXPECT_TRUE(tree_->IsNodeExpanded(11));
+  EXPECT_EQ(requested.back(), 11u);
+  tree_->CollapseNode(11);
+  EXPECT_FALSE(tree_->IsNodeExpanded(11));
+}
+
+TEST_F(TreeViewTest, BatchNotifications) {
+  scoped_refptr<nu::SimpleTreeModel> model(new nu::SimpleTreeModel);
+  uint32_t parent = model->AddNode(nu::TreeModel::kRootNode, MakeRows(1)[0]);
+  tree_->SetModel(model);
+  model->AddNode(parent, MakeRows(1)[0]);
+  tree_->ExpandNode(parent);
+  EXPECT_TRUE(tree_->IsNodeExpanded(parent));
+  EXPECT_EQ(model->GetChildCount(parent), 1u);
+  std::vector<uint32_t> ids = model->AddNodes(parent, MakeRows(2000));
+  tree_->SelectNode(ids[1500]);
+  EXPECT_EQ(tree_->GetSelectedNode(), ids[1500]);
+  model->RemoveNode(ids[1500]);
+  EXPECT_EQ(tree_->GetSelectedNode(), nu::TreeModel::kRootNode);
+  model->NotifyChildrenReset(nu::TreeModel::kRootNode);
+  EXPECT_FALSE(tree_->IsNodeExpanded(parent));
+}
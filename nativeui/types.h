@@ -34,11 +34,13 @@ typedef struct _PangoFontDescription PangoFontDescription;
 typedef struct _PangoLayout PangoLayout;
 typedef struct _cairo_surface cairo_surface_t;
 typedef struct _cairo cairo_t;
+typedef struct cairo_path cairo_path_t;
 typedef union _GdkEvent GdkEvent;
 #endif
 
 #if defined(OS_MACOSX)
 typedef struct CGContext* CGContextRef;
+typedef struct CGPath* CGMutablePathRef;
 #ifdef __OBJC__
 @class NSMutableAttributedString;
 @class NSAlert;
@@ -80,6 +82,8 @@ class NSWindow;
 
 #if defined(OS_WIN)
 namespace Gdiplus {
+class Bitmap;
+class CachedBitmap;
 class Font;
 class Graphics;
 class Image;
@@ -96,6 +100,7 @@ class TrayImpl;
 class ViewImpl;
 class WindowImpl;
 struct AttributedTextImpl;
+struct PathImpl;
 struct Win32Message;
 struct MenuItemData;
 struct MessageBoxImpl;
@@ -113,6 +118,7 @@ using NativeWindow = NSWindow*;
 using NativeBitmap = CGContextRef;
 using NativeDisplay = NSScreen*;
 using NativeImage = NSImage*;
+using NativePath = CGMutablePathRef;
 using nativeGraphicsContext = NSGraphicsContext*;
 using NativeFont = NSFont*;
 using NativeMenu = NSMenu*;
@@ -131,6 +137,7 @@ using NativeView = GtkWidget*;
 using NativeWindow = GtkWindow*;
 using NativeBitmap = cairo_surface_t*;
 using NativeImage = GdkPixbufAnimation*;
+using NativePath = cairo_path_t*;
 using nativeGraphicsContext = cairo_t*;
 using NativeFont = PangoFontDescription*;
 using NativeMenu = GtkMenuShell*;
@@ -152,6 +159,7 @@ using nativeGraphicsContext = Gdiplus::Graphics*;
 using NativeImage = Gdiplus::Image*;
 using NativeMenu = HMENU;
 using NativeMenuItem = MenuItemData*;
+using NativePath = PathImpl*;
 using NativeTray = TrayImpl*;
 #elif defined(OS_IOS)
 using NativeView = UIView*;
@@ -32,6 +32,8 @@
 
 #include <string.h>
 
+#include "nativeui/util/aes_accelerated.h"
+
 // The number of columns comprising a state in AES.
 // This is a constant in AES. Value=4.
 #define Nb 4
@@ -368,10 +370,17 @@ bool AES::Init(const std::string& key, const std::string& iv) {
     return false;
   KeyExpansion(round_key_, (uint8_t*)(key.data()));
   memcpy(iv_, (uint8_t*)(iv.data()), AES_BLOCKLEN);
+  accelerated_ = IsAESAccelerated();
+  if (accelerated_)
+    AESPrepareDecryptKey(round_key_, decrypt_key_);
   is_valid_ = true;
   return true;
 }
 
+void AES::SetIV(const uint8_t* iv) {
+  memcpy(iv_, iv, AES_BLOCKLEN);
+}
+
 void AES::CBCEncryptBuffer(uint8_t* buf, uint32_t len) {
   uint8_t* iv = iv_;
   for (uint32_t i = 0; i < len; i += AES_BLOCKLEN) {
@@ -385,6 +394,10 @@ void AES::CBCEncryptBuffer(uint8_t* buf, uint32_t len) {
 }
 
 void AES::CBCDecryptBuffer(uint8_t* buf, uint32_t len) {
+  if (accelerated_) {
+    AESCBCDecrypt(decrypt_key_, iv_, buf, len);
+    return;
+  }
   uint8_t storeNextIv[AES_BLOCKLEN];
   for (uint32_t i = 0; i < len; i += AES_BLOCKLEN) {
     memcpy(storeNextIv, buf, AES_BLOCKLEN);
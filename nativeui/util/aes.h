@@ -29,12 +29,20 @@ class AES {
   bool Init(const std::string& key, const std::string& iv);
   bool IsValid() const { return is_valid_; }
 
+  // Restart the chain from |iv|, which in CBC mode is the cipher block before
+  // the data to decrypt.
+  void SetIV(const uint8_t* iv);
+
   void CBCEncryptBuffer(uint8_t* buf, uint32_t len);
   void CBCDecryptBuffer(uint8_t* buf, uint32_t len);
 
  private:
   bool is_valid_ = false;
 
+  // Whether to decrypt with CPU instructions, which use |decrypt_key_|.
+  bool accelerated_ = false;
+  uint8_t decrypt_key_[AES_KEYEXPSIZE];
+
   uint8_t round_key_[AES_KEYEXPSIZE];
   uint8_t iv_[AES_BLOCKLEN];
 };
@@ -0,0 +1,214 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/aes_accelerated.h"
+
+#include "base/logging.h"
+#include "build/build_config.h"
+#include "nativeui/util/aes.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <wmmintrin.h>
+#include "base/cpu.h"
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#define ARM_CRYPTO 1
+#endif
+
+#if defined(ARCH_CPU_X86_FAMILY) || defined(ARM_CRYPTO)
+#define HAS_AES_INSTRUCTIONS 1
+#endif
+
+namespace nu {
+
+#if defined(HAS_AES_INSTRUCTIONS)
+
+namespace {
+
+static_assert(AES_KEYLEN == 16, "Only AES128 is accelerated");
+
+// Number of rounds of AES128.
+const int kRounds = 10;
+
+// Number of blocks decrypted together, CBC decryption does not depend on
+// previous results so the instructions can be pipelined.
+const size_t kParallelBlocks = 4;
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+// Allow using the instructions without compiling the whole file with them.
+#if defined(__clang__) || defined(__GNUC__)
+#define AES_TARGET __attribute__((target("aes,sse2")))
+#else
+#define AES_TARGET
+#endif
+
+AES_TARGET inline __m128i Load(const uint8_t* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+AES_TARGET inline void Store(uint8_t* p, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+AES_TARGET void PrepareDecryptKeyImpl(const uint8_t* round_key,
+                                      uint8_t* decrypt_key) {
+  // The equivalent inverse cipher uses keys in reverse order, with
+  // InvMixColumns applied to the middle ones.
+  Store(decrypt_key, Load(round_key + kRounds * AES_BLOCKLEN));
+  for (int i = 1; i < kRounds; ++i) {
+    Store(decrypt_key + i * AES_BLOCKLEN,
+          _mm_aesimc_si128(Load(round_key + (kRounds - i) * AES_BLOCKLEN)));
+  }
+  Store(decrypt_key + kRounds * AES_BLOCKLEN, Load(round_key));
+}
+
+AES_TARGET inline __m128i DecryptBlock(const __m128i* keys, __m128i block) {
+  block = _mm_xor_si128(block, keys[0]);
+  for (int r = 1; r < kRounds; ++r)
+    block = _mm_aesdec_si128(block, keys[r]);
+  return _mm_aesdeclast_si128(block, keys[kRounds]);
+}
+
+AES_TARGET void CBCDecryptImpl(const uint8_t* decrypt_key,
+                               uint8_t* iv,
+                               uint8_t* buf,
+                               size_t len) {
+  __m128i keys[kRounds + 1];
+  for (int i = 0; i <= kRounds; ++i)
+    keys[i] = Load(decrypt_key + i * AES_BLOCKLEN);
+  __m128i prev = Load(iv);
+  size_t i = 0;
+  for (; i + kParallelBlocks * AES_BLOCKLEN <= len;
+       i += kParallelBlocks * AES_BLOCKLEN) {
+    __m128i c0 = Load(buf + i);
+    __m128i c1 = Load(buf + i + 16);
+    __m128i c2 = Load(buf + i + 32);
+    __m128i c3 = Load(buf + i + 48);
+    __m128i x0 = _mm_xor_si128(c0, keys[0]);
+    __m128i x1 = _mm_xor_si128(c1, keys[0]);
+    __m128i x2 = _mm_xor_si128(c2, keys[0]);
+    __m128i x3 = _mm_xor_si128(c3, keys[0]);
+    for (int r = 1; r < kRounds; ++r) {
+      x0 = _mm_aesdec_si128(x0, keys[r]);
+      x1 = _mm_aesdec_si128(x1, keys[r]);
+      x2 = _mm_aesdec_si128(x2, keys[r]);
+      x3 = _mm_aesdec_si128(x3, keys[r]);
+    }
+    x0 = _mm_aesdeclast_si128(x0, keys[kRounds]);
+    x1 = _mm_aesdeclast_si128(x1, keys[kRounds]);
+    x2 = _mm_aesdeclast_si128(x2, keys[kRounds]);
+    x3 = _mm_aesdeclast_si128(x3, keys[kRounds]);
+    Store(buf + i, _mm_xor_si128(x0, prev));
+    Store(buf + i + 16, _mm_xor_si128(x1, c0));
+    Store(buf + i + 32, _mm_xor_si128(x2, c1));
+    Store(buf + i + 48, _mm_xor_si128(x3, c2));
+    prev = c3;
+  }
+  for (; i < len; i += AES_BLOCKLEN) {
+    __m128i c = Load(buf + i);
+    Store(buf + i, _mm_xor_si128(DecryptBlock(keys, c), prev));
+    prev = c;
+  }
+  Store(iv, prev);
+}
+
+#elif defined(ARM_CRYPTO)
+
+void PrepareDecryptKeyImpl(const uint8_t* round_key, uint8_t* decrypt_key) {
+  vst1q_u8(decrypt_key, vld1q_u8(round_key + kRounds * AES_BLOCKLEN));
+  for (int i = 1; i < kRounds; ++i) {
+    vst1q_u8(decrypt_key + i * AES_BLOCKLEN,
+             vaesimcq_u8(vld1q_u8(round_key + (kRounds - i) * AES_BLOCKLEN)));
+  }
+  vst1q_u8(decrypt_key + kRounds * AES_BLOCKLEN, vld1q_u8(round_key));
+}
+
+// AESD does AddRoundKey before the inverse substitution, so the rounds are
+// shifted comparing to x86 and the last key is added separately.
+inline uint8x16_t DecryptBlock(const uint8x16_t* keys, uint8x16_t block) {
+  for (int r = 0; r < kRounds - 1; ++r)
+    block = vaesimcq_u8(vaesdq_u8(block, keys[r]));
+  block = vaesdq_u8(block, keys[kRounds - 1]);
+  return veorq_u8(block, keys[kRounds]);
+}
+
+void CBCDecryptImpl(const uint8_t* decrypt_key,
+                    uint8_t* iv,
+                    uint8_t* buf,
+                    size_t len) {
+  uint8x16_t keys[kRounds + 1];
+  for (int i = 0; i <= kRounds; ++i)
+    keys[i] = vld1q_u8(decrypt_key + i * AES_BLOCKLEN);
+  uint8x16_t prev = vld1q_u8(iv);
+  size_t i = 0;
+  for (; i + kParallelBlocks * AES_BLOCKLEN <= len;
+       i += kParallelBlocks * AES_BLOCKLEN) {
+    uint8x16_t c0 = vld1q_u8(buf + i);
+    uint8x16_t c1 = vld1q_u8(buf + i + 16);
+    uint8x16_t c2 = vld1q_u8(buf + i + 32);
+    uint8x16_t c3 = vld1q_u8(buf + i + 48);
+    uint8x16_t x0 = c0, x1 = c1, x2 = c2, x3 = c3;
+    for (int r = 0; r < kRounds - 1; ++r) {
+      x0 = vaesimcq_u8(vaesdq_u8(x0, keys[r]));
+      x1 = vaesimcq_u8(vaesdq_u8(x1, keys[r]));
+      x2 = vaesimcq_u8(vaesdq_u8(x2, keys[r]));
+      x3 = vaesimcq_u8(vaesdq_u8(x3, keys[r]));
+    }
+    x0 = veorq_u8(vaesdq_u8(x0, keys[kRounds - 1]), keys[kRounds]);
+    x1 = veorq_u8(vaesdq_u8(x1, keys[kRounds - 1]), keys[kRounds]);
+    x2 = veorq_u8(vaesdq_u8(x2, keys[kRounds - 1]), keys[kRounds]);
+    x3 = veorq_u8(vaesdq_u8(x3, keys[kRounds - 1]), keys[kRounds]);
+    vst1q_u8(buf + i, veorq_u8(x0, prev));
+    vst1q_u8(buf + i + 16, veorq_u8(x1, c0));
+    vst1q_u8(buf + i + 32, veorq_u8(x2, c1));
+    vst1q_u8(buf + i + 48, veorq_u8(x3, c2));
+    prev = c3;
+  }
+  for (; i < len; i += AES_BLOCKLEN) {
+    uint8x16_t c = vld1q_u8(buf + i);
+    vst1q_u8(buf + i, veorq_u8(DecryptBlock(keys, c), prev));
+    prev = c;
+  }
+  vst1q_u8(iv, prev);
+}
+
+#endif
+
+}  // namespace
+
+#endif  // defined(HAS_AES_INSTRUCTIONS)
+
+bool IsAESAccelerated() {
+#if defined(ARCH_CPU_X86_FAMILY)
+  static bool has_aesni = base::CPU().has_aesni();
+  return has_aesni;
+#elif defined(ARM_CRYPTO)
+  // Only compiled in when the target always has the extensions.
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AESPrepareDecryptKey(const uint8_t* round_key, uint8_t* decrypt_key) {
+#if defined(HAS_AES_INSTRUCTIONS)
+  PrepareDecryptKeyImpl(round_key, decrypt_key);
+#else
+  NOTREACHED();
+#endif
+}
+
+void AESCBCDecrypt(const uint8_t* decrypt_key,
+                   uint8_t* iv,
+                   uint8_t* buf,
+                   size_t len) {
+#if defined(HAS_AES_INSTRUCTIONS)
+  CBCDecryptImpl(decrypt_key, iv, buf, len);
+#else
+  NOTREACHED();
+#endif
+}
+
+}  // namespace nu
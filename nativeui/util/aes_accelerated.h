@@ -0,0 +1,30 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_AES_ACCELERATED_H_
+#define NATIVEUI_UTIL_AES_ACCELERATED_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace nu {
+
+// Whether the CPU has instructions for AES, i.e. AES-NI on x86 and the Crypto
+// Extensions on ARMv8.
+bool IsAESAccelerated();
+
+// Compute the round keys used by the decryption instructions, from the
+// |round_key| of KeyExpansion.
+void AESPrepareDecryptKey(const uint8_t* round_key, uint8_t* decrypt_key);
+
+// Decrypt |len| bytes of |buf| in CBC mode with the instructions, where |len|
+// must be multiple of block size. The |iv| is updated for next call.
+void AESCBCDecrypt(const uint8_t* decrypt_key,
+                   uint8_t* iv,
+                   uint8_t* buf,
+                   size_t len);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_AES_ACCELERATED_H_
@@ -0,0 +1,72 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/aes.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::string FromHex(const char* hex) {
+  std::string bytes;
+  EXPECT_TRUE(base::HexStringToString(hex, &bytes));
+  return bytes;
+}
+
+// Test vectors of CBC-AES128 from NIST SP 800-38A.
+const char kKey[] = "2b7e151628aed2a6abf7158809cf4f3c";
+const char kIV[] = "000102030405060708090a0b0c0d0e0f";
+const char kPlainText[] =
+    "6bc1bee22e409f96e93d7e117393172a"
+    "ae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52ef"
+    "f69f2445df4f9b17ad2b417be66c3710";
+const char kCipherText[] =
+    "7649abac8119b246cee98e9b12e9197d"
+    "5086cb9b507219ee95db113a917678b2"
+    "73bed6b8e3c1743b7116e69e22229516"
+    "3ff1caa1681fac09120eca307586e1a7";
+
+}  // namespace
+
+TEST(AESTest, CBCEncrypt) {
+  nu::AES aes;
+  ASSERT_TRUE(aes.Init(FromHex(kKey), FromHex(kIV)));
+  std::string data = FromHex(kPlainText);
+  aes.CBCEncryptBuffer(reinterpret_cast<uint8_t*>(&data[0]),
+                       static_cast<uint32_t>(data.size()));
+  EXPECT_EQ(data, FromHex(kCipherText));
+}
+
+TEST(AESTest, CBCDecrypt) {
+  nu::AES aes;
+  ASSERT_TRUE(aes.Init(FromHex(kKey), FromHex(kIV)));
+  std::string data = FromHex(kCipherText);
+  aes.CBCDecryptBuffer(reinterpret_cast<uint8_t*>(&data[0]),
+                       static_cast<uint32_t>(data.size()));
+  EXPECT_EQ(data, FromHex(kPlainText));
+}
+
+TEST(AESTest, CBCDecryptInChunks) {
+  // Encrypt many blocks and decrypt them in chunks of different sizes, which
+  // uses both the multi-block and single-block paths.
+  std::string plain;
+  for (int i = 0; i < 21 * AES_BLOCKLEN; ++i)
+    plain.push_back(static_cast<char>(i * 7));
+  std::string data = plain;
+  nu::AES encryptor;
+  ASSERT_TRUE(encryptor.Init(FromHex(kKey), FromHex(kIV)));
+  encryptor.CBCEncryptBuffer(reinterpret_cast<uint8_t*>(&data[0]),
+                             static_cast<uint32_t>(data.size()));
+  nu::AES decryptor;
+  ASSERT_TRUE(decryptor.Init(FromHex(kKey), FromHex(kIV)));
+  uint8_t* buf = reinterpret_cast<uint8_t*>(&data[0]);
+  decryptor.CBCDecryptBuffer(buf, 1 * AES_BLOCKLEN);
+  decryptor.CBCDecryptBuffer(buf + 1 * AES_BLOCKLEN, 9 * AES_BLOCKLEN);
+  decryptor.CBCDecryptBuffer(buf + 10 * AES_BLOCKLEN, 11 * AES_BLOCKLEN);
+  EXPECT_EQ(data, plain);
+}
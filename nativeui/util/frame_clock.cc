@@ -0,0 +1,172 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/frame_clock.h"
+
+#include <algorithm>
+
+#include "nativeui/gfx/image.h"
+#include "nativeui/gif_player.h"
+#include "nativeui/state.h"
+
+namespace nu {
+
+namespace {
+
+// Browsers treat delays shorter than 10ms as the default, which avoids busy
+// loops for broken images.
+const int kMinFrameDelay = 10;
+
+// Views can be revealed without notifications, like being moved into the
+// parent's bounds by layout, so suspended animations are checked slowly.
+const int kSuspendedCheckInterval = 1000;
+
+}  // namespace
+
+// static
+FrameClock* FrameClock::GetCurrent() {
+  return State::GetCurrent()->GetFrameClock();
+}
+
+FrameClock::FrameClock() {}
+
+FrameClock::~FrameClock() {
+  if (timer_ != 0)
+    MessageLoop::ClearTimeout(timer_);
+}
+
+void FrameClock::AddPlayer(GifPlayer* player) {
+  Image* image = player->GetImage();
+  if (!image || !image->IsAnimated())
+    return;
+  auto it = animations_.find(image);
+  if (it == animations_.end()) {
+    Animation& animation = animations_[image];
+    animation.image = image;
+    animation.players.push_back(player);
+    Advance(&animation, base::TimeTicks::Now());
+  } else {
+    auto& players = it->second.players;
+    if (std::find(players.begin(), players.end(), player) != players.end())
+      return;
+    players.push_back(player);
+    // Show the frame shared by other players.
+    player->SchedulePaint();
+    if (it->second.suspended && player->IsOnScreen()) {
+      it->second.suspended = false;
+      Advance(&it->second, base::TimeTicks::Now());
+    }
+  }
+  Schedule();
+}
+
+void FrameClock::RemovePlayer(GifPlayer* player) {
+  for (auto it = animations_.begin(); it != animations_.end(); ++it) {
+    auto& players = it->second.players;
+    auto pit = std::find(players.begin(), players.end(), player);
+    if (pit == players.end())
+      continue;
+    players.erase(pit);
+    if (players.empty())
+      animations_.erase(it);
+    break;
+  }
+  Schedule();
+}
+
+int FrameClock::GetPlayerCount() const {
+  size_t count = 0;
+  for (const auto& it : animations_)
+    count += it.second.players.size();
+  return static_cast<int>(count);
+}
+
+int FrameClock::GetSuspendedCount() const {
+  return static_cast<int>(std::count_if(
+      animations_.begin(), animations_.end(),
+      [](const auto& it) { return it.second.suspended; }));
+}
+
+void FrameClock::UpdateVisibility() {
+  base::TimeTicks now = base::TimeTicks::Now();
+  for (auto& it : animations_) {
+    if (it.second.suspended && IsOnScreen(it.second)) {
+      it.second.suspended = false;
+      Advance(&it.second, now);
+    }
+  }
+  Schedule();
+}
+
+// static
+bool FrameClock::IsOnScreen(const Animation& animation) {
+  return std::any_of(animation.players.begin(), animation.players.end(),
+                     [](GifPlayer* player) { return player->IsOnScreen(); });
+}
+
+void FrameClock::Advance(Animation* animation, base::TimeTicks now) {
+  int delay = animation->image->AdvanceFrame();
+  for (GifPlayer* player : animation->players)
+    player->SchedulePaint();
+  // A negative delay means the last frame should be shown forever.
+  if (delay < 0) {
+    animation->next_frame = base::TimeTicks::Max();
+    return;
+  }
+  base::TimeDelta interval = base::TimeDelta::FromMilliseconds(
+      std::max(delay, kMinFrameDelay));
+  // Count from the time the frame was due so the animation does not drift,
+  // unless we have fallen behind.
+  base::TimeTicks next = animation->next_frame + interval;
+  animation->next_frame = next > now ? next : now + interval;
+}
+
+void FrameClock::Schedule() {
+  base::TimeTicks due = base::TimeTicks::Max();
+  for (const auto& it : animations_) {
+    if (it.second.suspended) {
+      // Do not postpone the pending check when rescheduling.
+      base::TimeTicks check = timer_ != 0 ? timer_due_ :
+          base::TimeTicks::Now() +
+          base::TimeDelta::FromMilliseconds(kSuspendedCheckInterval);
+      due = std::min(due, check);
+    } else {
+      due = std::min(due, it.second.next_frame);
+    }
+  }
+  if (timer_ != 0) {
+    if (due == timer_due_)
+      return;
+    MessageLoop::ClearTimeout(timer_);
+    timer_ = 0;
+  }
+  if (due.is_max())
+    return;
+  timer_due_ = due;
+  int64_t ms = (due - base::TimeTicks::Now()).InMillisecondsRoundedUp();
+  timer_ = MessageLoop::SetTimeout(std::max<int64_t>(ms, 0),
+                                   std::bind(&FrameClock::OnTimer, this));
+}
+
+void FrameClock::OnTimer() {
+  timer_ = 0;
+  base::TimeTicks now = base::TimeTicks::Now();
+  for (auto& it : animations_) {
+    Animation& animation = it.second;
+    if (animation.suspended) {
+      animation.suspended = !IsOnScreen(animation);
+      if (!animation.suspended)
+        Advance(&animation, now);
+    } else if (animation.next_frame <= now) {
+      // Stop drawing frames that nobody can see.
+      if (IsOnScreen(animation))
+        Advance(&animation, now);
+      else
+        animation.suspended = true;
+    }
+  }
+  Schedule();
+}
+
+}  // namespace nu
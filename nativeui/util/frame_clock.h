@@ -0,0 +1,82 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_FRAME_CLOCK_H_
+#define NATIVEUI_UTIL_FRAME_CLOCK_H_
+
+#include <map>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+class GifPlayer;
+class Image;
+
+// Drives the animations of all GifPlayers with one timer.
+//
+// Players showing the same Image share one animation, so each frame is only
+// advanced and decoded once no matter how many players show it, and players
+// repaint together in the same tick.
+//
+// Animations whose players are all off screen are suspended, and resumed
+// when windows are restored, views are shown, or contents are scrolled.
+//
+// This class is managed by State.
+class NATIVEUI_EXPORT FrameClock {
+ public:
+  static FrameClock* GetCurrent();
+
+  FrameClock();
+  ~FrameClock();
+
+  // Start playing the image of |player|, does nothing if already added.
+  void AddPlayer(GifPlayer* player);
+  void RemovePlayer(GifPlayer* player);
+
+  // Return the number of images being played.
+  int GetAnimationCount() const { return static_cast<int>(animations_.size()); }
+
+  // Return the number of players being driven.
+  int GetPlayerCount() const;
+
+  // Return the number of animations suspended for being off screen.
+  int GetSuspendedCount() const;
+
+  // Resume the suspended animations that have players on screen, called when
+  // the visibility of views may have changed.
+  void UpdateVisibility();
+
+ private:
+  struct Animation {
+    scoped_refptr<Image> image;
+    std::vector<GifPlayer*> players;
+    base::TimeTicks next_frame;
+    bool suspended = false;
+  };
+
+  // Show next frame of |animation| and repaint its players.
+  void Advance(Animation* animation, base::TimeTicks now);
+
+  // Whether any player of |animation| can be seen.
+  static bool IsOnScreen(const Animation& animation);
+
+  // Start the timer for the earliest frame.
+  void Schedule();
+  void OnTimer();
+
+  std::map<Image*, Animation> animations_;
+
+  MessageLoop::TimerId timer_ = 0;
+  base::TimeTicks timer_due_;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameClock);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_FRAME_CLOCK_H_
@@ -0,0 +1,77 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/lz4.h"
+
+#include <string.h>
+
+namespace nu {
+
+namespace {
+
+// The minimum length of a match.
+const size_t kMinMatch = 4;
+
+// Read the extra bytes of a length whose 4 bits in token are all set.
+bool ReadLength(const uint8_t** ip, const uint8_t* iend, size_t* length) {
+  uint8_t byte;
+  do {
+    if (*ip >= iend)
+      return false;
+    byte = *(*ip)++;
+    *length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+}  // namespace
+
+int LZ4DecompressBlock(const uint8_t* src, size_t src_size,
+                       uint8_t* dst, size_t dst_size) {
+  const uint8_t* ip = src;
+  const uint8_t* iend = src + src_size;
+  uint8_t* op = dst;
+  uint8_t* oend = dst + dst_size;
+  while (ip < iend) {
+    // Each sequence is | token | literals | offset | match length |.
+    uint8_t token = *ip++;
+    size_t literals = token >> 4;
+    if (literals == 15 && !ReadLength(&ip, iend, &literals))
+      return -1;
+    if (literals > static_cast<size_t>(iend - ip) ||
+        literals > static_cast<size_t>(oend - op))
+      return -1;
+    memcpy(op, ip, literals);
+    ip += literals;
+    op += literals;
+    // The last sequence only has literals.
+    if (ip == iend)
+      break;
+    if (iend - ip < 2)
+      return -1;
+    size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst))
+      return -1;
+    size_t match = token & 15;
+    if (match == 15 && !ReadLength(&ip, iend, &match))
+      return -1;
+    match += kMinMatch;
+    if (match > static_cast<size_t>(oend - op))
+      return -1;
+    // The match can overlap with the output when offset is less than length,
+    // which repeats the last |offset| bytes.
+    const uint8_t* from = op - offset;
+    if (offset >= match) {
+      memcpy(op, from, match);
+      op += match;
+    } else {
+      for (size_t i = 0; i < match; ++i)
+        *op++ = *from++;
+    }
+  }
+  return static_cast<int>(op - dst);
+}
+
+}  // namespace nu
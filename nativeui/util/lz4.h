@@ -0,0 +1,22 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_LZ4_H_
+#define NATIVEUI_UTIL_LZ4_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace nu {
+
+// Decompress a block of the LZ4 block format into |dst|, which can hold
+// |dst_size| bytes, return the size of decompressed data or -1 on error.
+//
+// Corrupted input never reads or writes out of bounds.
+int LZ4DecompressBlock(const uint8_t* src, size_t src_size,
+                       uint8_t* dst, size_t dst_size);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_LZ4_H_
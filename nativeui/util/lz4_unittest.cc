@@ -0,0 +1,57 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/lz4.h"
+
+#include <string>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+int Decompress(const std::string& block, std::string* out, size_t size) {
+  out->resize(size);
+  int result = nu::LZ4DecompressBlock(
+      reinterpret_cast<const uint8_t*>(block.data()), block.size(),
+      reinterpret_cast<uint8_t*>(&(*out)[0]), size);
+  if (result >= 0)
+    out->resize(result);
+  return result;
+}
+
+}  // namespace
+
+TEST(LZ4Test, Literals) {
+  std::string block("\x30" "abc", 4);
+  std::string out;
+  ASSERT_EQ(Decompress(block, &out, 16), 3);
+  EXPECT_EQ(out, "abc");
+  // Literals longer than 14 bytes have extra length bytes.
+  std::string literals(300, 'x');
+  block = std::string("\xf0\xff\x1e", 3) + literals;
+  ASSERT_EQ(Decompress(block, &out, 300), 300);
+  EXPECT_EQ(out, literals);
+}
+
+TEST(LZ4Test, Matches) {
+  // "abc" followed by a match of 6 bytes at offset 3, then "d".
+  std::string block("\x32" "abc" "\x03\x00" "\x10" "d", 8);
+  std::string out;
+  ASSERT_EQ(Decompress(block, &out, 16), 10);
+  EXPECT_EQ(out, "abcabcabcd");
+  // Overlapping match repeating one byte.
+  block = std::string("\x1f" "a" "\x01\x00" "\x05" "\x10" "b", 7);
+  ASSERT_EQ(Decompress(block, &out, 32), 26);
+  EXPECT_EQ(out, std::string(25, 'a') + "b");
+}
+
+TEST(LZ4Test, Corrupted) {
+  std::string out;
+  // Offset before the start of output.
+  EXPECT_EQ(Decompress(std::string("\x12" "a" "\x02\x00", 4), &out, 16), -1);
+  // Output larger than the buffer.
+  EXPECT_EQ(Decompress(std::string("\x32" "abc" "\x03\x00", 6), &out, 5), -1);
+  // Literals past the input.
+  EXPECT_EQ(Decompress(std::string("\x50" "ab", 3), &out, 16), -1);
+}
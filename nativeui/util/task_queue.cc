@@ -0,0 +1,79 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/task_queue.h"
+
+#include <utility>
+
+#include "nativeui/trace_event.h"
+
+namespace nu {
+
+TaskQueue::TaskQueue() : head_(&stub_), tail_(&stub_) {}
+
+TaskQueue::~TaskQueue() {
+  while (Node* node = Pop())
+    delete node;
+}
+
+bool TaskQueue::Push(Task task) {
+  Node* node = new Node;
+  node->task = std::move(task);
+  Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+  size_.fetch_add(1, std::memory_order_release);
+  // Must come after the node is linked, so a Drain() that has missed it would
+  // always be followed by another one.
+  return !scheduled_.exchange(true, std::memory_order_seq_cst);
+}
+
+void TaskQueue::Drain() {
+  scheduled_.store(false, std::memory_order_seq_cst);
+  // Only run the batch present at entry, later tasks have asked for a new
+  // wakeup since |scheduled_| is cleared.
+  for (int count = size_.load(std::memory_order_acquire); count > 0; --count) {
+    Node* node = Pop();
+    if (!node)
+      break;
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    Task task = std::move(node->task);
+    delete node;
+    NU_TRACE_EVENT("loop", "MessageLoop::RunTask");
+    task();
+  }
+}
+
+void TaskQueue::CancelWakeup() {
+  scheduled_.store(false, std::memory_order_seq_cst);
+}
+
+TaskQueue::Node* TaskQueue::Pop() {
+  Node* tail = tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (!next)
+      return nullptr;
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  if (tail != head_.load(std::memory_order_acquire))
+    return nullptr;
+  // Put the stub back so the last node can be removed.
+  stub_.next.store(nullptr, std::memory_order_relaxed);
+  Node* prev = head_.exchange(&stub_, std::memory_order_acq_rel);
+  prev->next.store(&stub_, std::memory_order_release);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next) {
+    tail_ = next;
+    return tail;
+  }
+  return nullptr;
+}
+
+}  // namespace nu
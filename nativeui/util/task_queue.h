@@ -0,0 +1,66 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TASK_QUEUE_H_
+#define NATIVEUI_UTIL_TASK_QUEUE_H_
+
+#include <atomic>
+#include <functional>
+
+#include "base/macros.h"
+
+namespace nu {
+
+// A lock-free queue of tasks with multiple producers and one consumer.
+//
+// Producers push tasks from any thread, and only the first push after a drain
+// asks for waking up the consumer, so a batch of tasks costs one wakeup.
+class TaskQueue {
+ public:
+  using Task = std::function<void()>;
+
+  TaskQueue();
+  ~TaskQueue();
+
+  // Add |task| to the queue, returns true if the consumer should be woken up
+  // to call Drain().
+  bool Push(Task task);
+
+  // Run the tasks that are in the queue when it is called, must be called
+  // from the consumer thread. Tasks pushed while draining ask for another
+  // wakeup instead, so a task reposting itself can not starve the consumer.
+  void Drain();
+
+  // Called when waking up the consumer has failed, so the next Push asks for
+  // the wakeup again.
+  void CancelWakeup();
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    Task task;
+  };
+
+  // Pop the oldest node, returns null when the queue is empty or a push is
+  // still in progress.
+  Node* Pop();
+
+  // Producers append to |head_|, the consumer removes from |tail_|, and there
+  // is always a stub node in the queue.
+  std::atomic<Node*> head_;
+  Node* tail_;
+  Node stub_;
+
+  // Number of tasks pushed and not yet popped.
+  std::atomic<int> size_{0};
+
+  // Whether a Drain() call has been requested.
+  std::atomic<bool> scheduled_{false};
+
+  DISALLOW_COPY_AND_ASSIGN(TaskQueue);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TASK_QUEUE_H_
@@ -0,0 +1,130 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/timer_wheel.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace nu {
+
+TimerWheel::TimerWheel() {}
+
+TimerWheel::~TimerWheel() {}
+
+TimerWheel::TimerId TimerWheel::Add(int64_t tick, Task task) {
+  if (++next_id_ == 0)
+    ++next_id_;
+  Insert({next_id_, tick, std::move(task)});
+  return next_id_;
+}
+
+void TimerWheel::Cancel(TimerId id) {
+  auto it = locations_.find(id);
+  if (it == locations_.end())
+    return;
+  counts_[it->second.level]--;
+  it->second.slot->erase(it->second.it);
+  locations_.erase(it);
+}
+
+std::vector<std::pair<TimerWheel::TimerId, TimerWheel::Task>>
+TimerWheel::Advance(int64_t tick) {
+  std::vector<std::pair<TimerId, Task>> expired;
+  while (true) {
+    // Timers in current slot of the lowest level have all expired.
+    Slot& slot = slots_[0][current_tick_ & (kSlots - 1)];
+    for (Timer& timer : slot) {
+      expired.emplace_back(timer.id, std::move(timer.task));
+      locations_.erase(timer.id);
+    }
+    counts_[0] -= slot.size();
+    slot.clear();
+
+    if (current_tick_ >= tick)
+      break;
+    if (locations_.empty()) {
+      current_tick_ = tick;
+      break;
+    }
+    // Go to next tick, or skip to the next slot of upper level if there is
+    // nothing in the lowest level.
+    int64_t next = current_tick_ + 1;
+    if (counts_[0] == 0)
+      next = std::min(tick, (current_tick_ | (kSlots - 1)) + 1);
+    current_tick_ = next;
+    int level = 0;
+    while (level + 1 < kLevels &&
+           (current_tick_ & ((int64_t(1) << (kSlotBits * (level + 1))) - 1))
+               == 0)
+      ++level;
+    for (; level > 0; --level)
+      Cascade(level);
+  }
+  return expired;
+}
+
+int64_t TimerWheel::GetNextWakeup() const {
+  if (locations_.empty())
+    return -1;
+  int64_t wakeup = std::numeric_limits<int64_t>::max();
+  if (counts_[0] > 0) {
+    for (int i = 0; i < kSlots; ++i) {
+      if (!slots_[0][(current_tick_ + i) & (kSlots - 1)].empty()) {
+        wakeup = current_tick_ + i;
+        break;
+      }
+    }
+  }
+  // Timers in upper levels expire after their slots are reached.
+  for (int level = 1; level < kLevels; ++level) {
+    if (counts_[level] == 0)
+      continue;
+    int shift = kSlotBits * level;
+    for (int i = 1; i <= kSlots; ++i) {
+      int64_t block = (current_tick_ >> shift) + i;
+      if (!slots_[level][block & (kSlots - 1)].empty()) {
+        wakeup = std::min(wakeup, block << shift);
+        break;
+      }
+    }
+  }
+  return wakeup;
+}
+
+void TimerWheel::Insert(Timer timer) {
+  int64_t tick = std::max(timer.expiration, current_tick_);
+  int64_t delta = tick - current_tick_;
+  int level = 0;
+  while (level < kLevels &&
+         delta >= (int64_t(1) << (kSlotBits * (level + 1))))
+    ++level;
+  int index;
+  if (level < kLevels) {
+    index = (tick >> (kSlotBits * level)) & (kSlots - 1);
+  } else {
+    // Too far away, park it in the furthest slot and insert it again when
+    // the slot is reached.
+    level = kLevels - 1;
+    index = ((current_tick_ >> (kSlotBits * level)) + kSlots - 1) &
+            (kSlots - 1);
+  }
+  Slot* slot = &slots_[level][index];
+  TimerId id = timer.id;
+  slot->push_back(std::move(timer));
+  counts_[level]++;
+  locations_[id] = {level, slot, std::prev(slot->end())};
+}
+
+void TimerWheel::Cascade(int level) {
+  int index = (current_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+  Slot timers;
+  timers.swap(slots_[level][index]);
+  counts_[level] -= timers.size();
+  for (Timer& timer : timers)
+    Insert(std::move(timer));
+}
+
+}  // namespace nu
@@ -0,0 +1,89 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TIMER_WHEEL_H_
+#define NATIVEUI_UTIL_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace nu {
+
+// A hierarchical timer wheel with 1ms ticks.
+//
+// Adding and cancelling timers are O(1), and advancing the time only touches
+// the slots that are passed, so it scales to many concurrent timers. Timers
+// are kept in 4 levels of 64 slots, each level covering 64 times the range of
+// the level below it, and are moved down when their slots are reached.
+//
+// This class is not thread-safe.
+class TimerWheel {
+ public:
+  using Task = std::function<void()>;
+  using TimerId = uint32_t;
+
+  TimerWheel();
+  ~TimerWheel();
+
+  // Add a timer that expires at |tick|, the returned ID is never 0.
+  TimerId Add(int64_t tick, Task task);
+
+  // Remove a timer, does nothing if it has expired or been cancelled.
+  void Cancel(TimerId id);
+
+  // Move the time to |tick|, and return the expired timers in the order of
+  // expiration.
+  std::vector<std::pair<TimerId, Task>> Advance(int64_t tick);
+
+  // Return a tick at which Advance should be called next, which is never later
+  // than the earliest expiration, or -1 if there is no timer.
+  int64_t GetNextWakeup() const;
+
+  int64_t current_tick() const { return current_tick_; }
+  size_t size() const { return locations_.size(); }
+
+ private:
+  static const int kLevels = 4;
+  static const int kSlotBits = 6;
+  static const int kSlots = 1 << kSlotBits;
+
+  struct Timer {
+    TimerId id;
+    int64_t expiration;
+    Task task;
+  };
+  using Slot = std::list<Timer>;
+
+  struct Location {
+    int level;
+    Slot* slot;
+    Slot::iterator it;
+  };
+
+  // Put |timer| into the slot matching its expiration.
+  void Insert(Timer timer);
+
+  // Move the timers of the slot reaching |current_tick_| at |level| down.
+  void Cascade(int level);
+
+  Slot slots_[kLevels][kSlots];
+  size_t counts_[kLevels] = {0};
+  std::unordered_map<TimerId, Location> locations_;
+  int64_t current_tick_ = 0;
+  TimerId next_id_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TIMER_WHEEL_H_
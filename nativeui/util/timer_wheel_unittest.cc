@@ -0,0 +1,68 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/timer_wheel.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+std::vector<nu::TimerWheel::TimerId> Expire(nu::TimerWheel* wheel,
+                                            int64_t tick) {
+  std::vector<nu::TimerWheel::TimerId> ids;
+  for (const auto& it : wheel->Advance(tick))
+    ids.push_back(it.first);
+  return ids;
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, ExpireInOrder) {
+  nu::TimerWheel wheel;
+  auto a = wheel.Add(100, nullptr);
+  auto b = wheel.Add(5, nullptr);
+  auto c = wheel.Add(5000, nullptr);
+  EXPECT_TRUE(Expire(&wheel, 4).empty());
+  EXPECT_EQ(Expire(&wheel, 100), std::vector<nu::TimerWheel::TimerId>({b, a}));
+  EXPECT_TRUE(Expire(&wheel, 4999).empty());
+  EXPECT_EQ(Expire(&wheel, 5000), std::vector<nu::TimerWheel::TimerId>({c}));
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheelTest, Cancel) {
+  nu::TimerWheel wheel;
+  auto a = wheel.Add(10, nullptr);
+  auto b = wheel.Add(10, nullptr);
+  wheel.Cancel(a);
+  wheel.Cancel(a);
+  EXPECT_EQ(Expire(&wheel, 10), std::vector<nu::TimerWheel::TimerId>({b}));
+}
+
+TEST(TimerWheelTest, FarAway) {
+  nu::TimerWheel wheel;
+  // Beyond the range of all levels.
+  int64_t far = int64_t(1) << 30;
+  auto a = wheel.Add(far, nullptr);
+  EXPECT_LE(wheel.GetNextWakeup(), far);
+  EXPECT_TRUE(Expire(&wheel, far - 1).empty());
+  EXPECT_EQ(Expire(&wheel, far), std::vector<nu::TimerWheel::TimerId>({a}));
+}
+
+TEST(TimerWheelTest, NextWakeup) {
+  nu::TimerWheel wheel;
+  EXPECT_EQ(wheel.GetNextWakeup(), -1);
+  wheel.Add(70, nullptr);
+  int64_t wakeup = wheel.GetNextWakeup();
+  EXPECT_LE(wakeup, 70);
+  wheel.Add(3, nullptr);
+  EXPECT_EQ(wheel.GetNextWakeup(), 3);
+  // Timers already expired are returned in next advance.
+  Expire(&wheel, 50);
+  wheel.Add(10, nullptr);
+  EXPECT_EQ(wheel.GetNextWakeup(), 50);
+  EXPECT_EQ(Expire(&wheel, 50).size(), 1u);
+}
@@ -0,0 +1,122 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/worker_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/sys_info.h"
+#include "base/threading/platform_thread.h"
+
+namespace nu {
+
+namespace {
+
+// Idle threads wait for new tasks instead of exiting, since most background
+// work comes in bursts.
+class Pool : public base::PlatformThread::Delegate {
+ public:
+  Pool()
+      : max_threads_(static_cast<size_t>(
+            std::max(4, base::SysInfo::NumberOfProcessors()))),
+        wake_up_(&lock_) {}
+
+  void PostTask(WorkerPool::Task task) {
+    {
+      base::AutoLock auto_lock(lock_);
+      tasks_.push_back(std::move(task));
+      if (tasks_.size() <= idle_threads_ || threads_ >= max_threads_) {
+        wake_up_.Signal();
+        return;
+      }
+      if (base::PlatformThread::CreateNonJoinable(0, this)) {
+        ++threads_;
+        ++idle_threads_;
+        return;
+      }
+      if (threads_ > 0) {
+        wake_up_.Signal();
+        return;
+      }
+      // Without any worker the task must be run by someone.
+      task = std::move(tasks_.back());
+      tasks_.pop_back();
+    }
+    LOG(ERROR) << "Failed to create worker thread.";
+    task();
+  }
+
+  // base::PlatformThread::Delegate:
+  void ThreadMain() override {
+    base::PlatformThread::SetName("Worker");
+    base::AutoLock auto_lock(lock_);
+    while (true) {
+      while (tasks_.empty())
+        wake_up_.Wait();
+      WorkerPool::Task task = std::move(tasks_.front());
+      tasks_.pop_front();
+      --idle_threads_;
+      {
+        base::AutoUnlock auto_unlock(lock_);
+        task();
+      }
+      ++idle_threads_;
+    }
+  }
+
+ private:
+  const size_t max_threads_;
+
+  base::Lock lock_;
+  base::ConditionVariable wake_up_;
+  size_t threads_ = 0;
+  size_t idle_threads_ = 0;
+  std::deque<WorkerPool::Task> tasks_;
+};
+
+base::LazyInstance<Pool>::Leaky g_pool = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+void WorkerPool::PostTask(Task task) {
+  g_pool.Pointer()->PostTask(std::move(task));
+}
+
+WorkerPool::Sequence::Sequence() {}
+
+WorkerPool::Sequence::~Sequence() {}
+
+void WorkerPool::Sequence::PostTask(Task task) {
+  {
+    base::AutoLock auto_lock(lock_);
+    tasks_.push_back(std::move(task));
+    if (running_)
+      return;
+    running_ = true;
+  }
+  WorkerPool::PostTask([this]() { RunTasks(); });
+}
+
+void WorkerPool::Sequence::RunTasks() {
+  while (true) {
+    Task task;
+    {
+      base::AutoLock auto_lock(lock_);
+      if (tasks_.empty()) {
+        running_ = false;
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace nu
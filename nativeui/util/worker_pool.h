@@ -0,0 +1,58 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_WORKER_POOL_H_
+#define NATIVEUI_UTIL_WORKER_POOL_H_
+
+#include <deque>
+#include <functional>
+
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// The threads shared by all background work of the process, like decoding
+// images, loading fonts, computing layouts and reading files.
+//
+// Threads are created on demand when all existing threads are busy, up to a
+// fixed limit, and they live until the process exits. Tasks can be posted
+// from any thread, and must not wait for other tasks in the pool.
+class NATIVEUI_EXPORT WorkerPool {
+ public:
+  using Task = std::function<void()>;
+
+  // Run |task| in one of the worker threads. The task is run in the calling
+  // thread if no thread can be created.
+  static void PostTask(Task task);
+
+  // Runs the tasks posted to it one at a time in the order they are posted,
+  // though not necessarily in the same thread.
+  class NATIVEUI_EXPORT Sequence {
+   public:
+    Sequence();
+    ~Sequence();
+
+    // Can be called from any thread. The sequence is still used after its last
+    // task is run, so it is usually a global that is never destroyed.
+    void PostTask(Task task);
+
+   private:
+    void RunTasks();
+
+    base::Lock lock_;
+    std::deque<Task> tasks_;
+    bool running_ = false;
+
+    DISALLOW_COPY_AND_ASSIGN(Sequence);
+  };
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(WorkerPool);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_WORKER_POOL_H_
@@ -0,0 +1,59 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/worker_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "base/threading/platform_thread.h"
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class WorkerPoolTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(WorkerPoolTest, PostTask) {
+  const int kTasks = 100;
+  std::atomic<int> done(0);
+  base::PlatformThreadId main_thread = base::PlatformThread::CurrentId();
+  std::atomic<bool> in_main_thread(false);
+  for (int i = 0; i < kTasks; ++i) {
+    nu::WorkerPool::PostTask([&]() {
+      if (base::PlatformThread::CurrentId() == main_thread)
+        in_main_thread = true;
+      if (++done == kTasks)
+        nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+    });
+  }
+  nu::MessageLoop::Run();
+  EXPECT_EQ(done, kTasks);
+  EXPECT_FALSE(in_main_thread);
+}
+
+TEST_F(WorkerPoolTest, Sequence) {
+  // The sequence may still be finishing in worker after the last task.
+  static nu::WorkerPool::Sequence sequence;
+  std::vector<int> order;
+  std::atomic<int> running(0);
+  std::atomic<bool> overlapped(false);
+  for (int i = 0; i < 20; ++i) {
+    sequence.PostTask([&, i]() {
+      if (++running > 1)
+        overlapped = true;
+      order.push_back(i);
+      --running;
+      if (i == 19)
+        nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+    });
+  }
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(overlapped);
+  ASSERT_EQ(order.size(), 20u);
+  for (int i = 0; i < 20; ++i)
+    EXPECT_EQ(order[i], i);
+}
@@ -273,10 +273,10 @@ T* Find(T (&setters)[n], const std::string& name) {
   return &(*iter);
 }
 
-// Set style for int properties.
-bool SetIntStyle(YGNodeRef node,
-                 const std::string& name,
-                 const std::string& value) {
+// Parse int properties.
+bool ParseIntStyle(const std::string& name,
+                   const std::string& value,
+                   YogaProperty* out) {
   auto* tup = Find(int_setters, name);
   if (!tup)
     return false;
@@ -285,72 +285,85 @@ bool SetIntStyle(YGNodeRef node,
     LOG(WARNING) << "Invalid value " << value << " for property " << name;
     return false;
   }
-  std::get<2>(*tup)(node, converted);
+  out->type = YogaProperty::Type::Int;
+  out->setter = reinterpret_cast<YogaProperty::Setter>(std::get<2>(*tup));
+  out->value.int_value = converted;
   return true;
 }
 
-// Set style for float properties.
-bool SetFloatStyle(YGNodeRef node, const std::string& name, float value) {
+// Parse float properties.
+bool ParseFloatStyle(const std::string& name, float value, YogaProperty* out) {
   auto* tup = Find(float_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node, value);
+  out->type = YogaProperty::Type::Float;
+  out->setter = reinterpret_cast<YogaProperty::Setter>(std::get<1>(*tup));
+  out->value.float_value = value;
   return true;
 }
 
-// Set "auto" property for styles.
-bool SetAutoStyle(YGNodeRef node, const std::string& name) {
+// Parse "auto" property for styles.
+bool ParseAutoStyle(const std::string& name, YogaProperty* out) {
   auto* tup = Find(auto_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node);
+  out->type = YogaProperty::Type::Auto;
+  out->setter = reinterpret_cast<YogaProperty::Setter>(std::get<1>(*tup));
   return true;
 }
 
 // Dispatch to float for auto depending on the value.
-bool SetUnitStyle(YGNodeRef node,
-                  const std::string& name,
-                  const std::string& value) {
+bool ParseUnitStyle(const std::string& name,
+                    const std::string& value,
+                    YogaProperty* out) {
   if (value == "auto")
-    return SetAutoStyle(node, name);
+    return ParseAutoStyle(name, out);
   else
-    return SetFloatStyle(node, name, PixelValue(value));
+    return ParseFloatStyle(name, PixelValue(value), out);
 }
 
-// Set style for percent properties.
-bool SetPercentStyle(YGNodeRef node,
-                     const std::string& name,
-                     const std::string& value) {
+// Parse percent properties.
+bool ParsePercentStyle(const std::string& name,
+                       const std::string& value,
+                       YogaProperty* out) {
   auto* tup = Find(percent_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node, PercentValue(value));
+  out->type = YogaProperty::Type::Float;
+  out->setter = reinterpret_cast<YogaProperty::Setter>(std::get<1>(*tup));
+  out->value.float_value = PercentValue(value);
   return true;
 }
 
-// Set style for edge properties.
-bool SetEdgeStyle(YGNodeRef node, const std::string& name, float value) {
+// Parse edge properties.
+bool ParseEdgeStyle(const std::string& name, float value, YogaProperty* out) {
   auto* tup = Find(edge_setters, name);
   if (!tup)
     return false;
-  std::get<2>(*tup)(node, std::get<1>(*tup), value);
+  out->type = YogaProperty::Type::Edge;
+  out->setter = reinterpret_cast<YogaProperty::Setter>(std::get<2>(*tup));
+  out->edge = static_cast<int>(std::get<1>(*tup));
+  out->value.float_value = value;
   return true;
 }
 
-bool SetEdgeStyle(YGNodeRef node,
-                  const std::string& name,
-                  const std::string& value) {
-  return SetEdgeStyle(node, name, PixelValue(value));
+bool ParseEdgeStyle(const std::string& name,
+                    const std::string& value,
+                    YogaProperty* out) {
+  return ParseEdgeStyle(name, PixelValue(value), out);
 }
 
-// Set style for edge percent properties.
-bool SetEdgePercentStyle(YGNodeRef node,
-                         const std::string& name,
-                         const std::string& value) {
+// Parse edge percent properties.
+bool ParseEdgePercentStyle(const std::string& name,
+                           const std::string& value,
+                           YogaProperty* out) {
   auto* tup = Find(edge_percent_setters, name);
   if (!tup)
     return false;
-  std::get<2>(*tup)(node, std::get<1>(*tup), PercentValue(value));
+  out->type = YogaProperty::Type::Edge;
+  out->setter = reinterpret_cast<YogaProperty::Setter>(std::get<2>(*tup));
+  out->edge = static_cast<int>(std::get<1>(*tup));
+  out->value.float_value = PercentValue(value);
   return true;
 }
 
@@ -363,14 +376,26 @@ bool IsPercentValue(const std::string& value) {
 
 }  // namespace
 
-void SetYogaProperty(YGNodeRef node, const std::string& name, float value) {
-  SetFloatStyle(node, name, value) ||
-  SetEdgeStyle(node, name, value);
+std::string ParseStyleName(const std::string& name) {
+  std::string parsed;
+  parsed.reserve(name.size());
+  for (char c : name) {
+    if (base::IsAsciiAlpha(c))
+      parsed.push_back(base::ToLowerASCII(c));
+  }
+  return parsed;
 }
 
-void SetYogaProperty(YGNodeRef node,
-                     const std::string& name,
-                     const std::string& value) {
+bool ParseYogaProperty(const std::string& name,
+                       float value,
+                       YogaProperty* out) {
+  return ParseFloatStyle(name, value, out) ||
+         ParseEdgeStyle(name, value, out);
+}
+
+bool ParseYogaProperty(const std::string& name,
+                       const std::string& value,
+                       YogaProperty* out) {
   DCHECK(IsSorted(int_setters) &&
          IsSorted(float_setters) &&
          IsSorted(auto_setters) &&
@@ -378,13 +403,52 @@ void SetYogaProperty(YGNodeRef node,
          IsSorted(edge_setters) &&
          IsSorted(edge_percent_setters)) << "Property setters must be sorted";
   if (IsPercentValue(value)) {
-    SetPercentStyle(node, name, value) ||
-    SetEdgePercentStyle(node, name, value);
+    return ParsePercentStyle(name, value, out) ||
+           ParseEdgePercentStyle(name, value, out);
   } else {
-    SetIntStyle(node, name, value) ||
-    SetUnitStyle(node, name, value) ||
-    SetEdgeStyle(node, name, value);
+    return ParseIntStyle(name, value, out) ||
+           ParseUnitStyle(name, value, out) ||
+           ParseEdgeStyle(name, value, out);
+  }
+}
+
+void ApplyYogaProperty(YGNodeRef node, const YogaProperty& property) {
+  switch (property.type) {
+    case YogaProperty::Type::Int:
+      reinterpret_cast<IntSetter>(property.setter)(
+          node, property.value.int_value);
+      break;
+    case YogaProperty::Type::Float:
+      reinterpret_cast<FloatSetter>(property.setter)(
+          node, property.value.float_value);
+      break;
+    case YogaProperty::Type::Auto:
+      reinterpret_cast<AutoSetter>(property.setter)(node);
+      break;
+    case YogaProperty::Type::Edge:
+      reinterpret_cast<EdgeSetter>(property.setter)(
+          node, static_cast<YGEdge>(property.edge), property.value.float_value);
+      break;
   }
 }
 
+RectF GetYGNodeBounds(YGNodeRef node) {
+  return RectF(YGNodeLayoutGetLeft(node), YGNodeLayoutGetTop(node),
+               YGNodeLayoutGetWidth(node), YGNodeLayoutGetHeight(node));
+}
+
+void SetYogaProperty(YGNodeRef node, const std::string& name, float value) {
+  YogaProperty property;
+  if (ParseYogaProperty(name, value, &property))
+    ApplyYogaProperty(node, property);
+}
+
+void SetYogaProperty(YGNodeRef node,
+                     const std::string& name,
+                     const std::string& value) {
+  YogaProperty property;
+  if (ParseYogaProperty(name, value, &property))
+    ApplyYogaProperty(node, property);
+}
+
 }  // namespace nu
@@ -5,12 +5,59 @@
 #ifndef NATIVEUI_UTIL_YOGA_UTIL_H_
 #define NATIVEUI_UTIL_YOGA_UTIL_H_
 
+#include <cmath>
 #include <string>
 
+#include "nativeui/gfx/geometry/rect_f.h"
+
 typedef struct YGNode *YGNodeRef;
 
 namespace nu {
 
+// A parsed yoga property, applying it to a node does not need to look up the
+// property name or convert the value again.
+struct YogaProperty {
+  using Setter = void(*)();
+
+  enum class Type {
+    Int,
+    Float,
+    Auto,
+    Edge,
+  };
+
+  Type type = Type::Float;
+  Setter setter = nullptr;
+  int edge = 0;
+  union {
+    int int_value;
+    float float_value;
+  } value = {0};
+};
+
+// Convert the property name and value to YogaProperty, return false if the
+// property is unknown or the value is invalid.
+bool ParseYogaProperty(const std::string& name,
+                       float value,
+                       YogaProperty* out);
+bool ParseYogaProperty(const std::string& name,
+                       const std::string& value,
+                       YogaProperty* out);
+
+// Convert case to lower and remove non-ASCII characters.
+std::string ParseStyleName(const std::string& name);
+
+// Apply the parsed property to node.
+void ApplyYogaProperty(YGNodeRef node, const YogaProperty& property);
+
+// Get bounds from the computed layout of node.
+RectF GetYGNodeBounds(YGNodeRef node);
+
+// Compare dimensions passed by yoga, which uses NaN for undefined dimensions.
+inline bool IsSameDimension(float a, float b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
 void SetYogaProperty(YGNodeRef node, const std::string& key, float value);
 void SetYogaProperty(YGNodeRef node,
                      const std::string& key,
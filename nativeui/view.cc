@@ -4,15 +4,21 @@
 
 #include "nativeui/view.h"
 
+#include <tuple>
 #include <utility>
 
-#include "base/strings/string_util.h"
 #include "nativeui/container.h"
 #include "nativeui/cursor.h"
+#include "nativeui/event_recorder.h"
+#include "nativeui/events/event.h"
 #include "nativeui/gfx/font.h"
+#include "nativeui/scroll.h"
 #include "nativeui/state.h"
+#include "nativeui/style_sheet.h"
+#include "nativeui/util/frame_clock.h"
 #include "nativeui/util/yoga_util.h"
 #include "nativeui/window.h"
+#include "third_party/yoga/YGNode.h"
 #include "third_party/yoga/Yoga.h"
 
 // This header required DEBUG to be defined.
@@ -28,16 +34,11 @@ namespace nu {
 
 namespace {
 
-// Convert case to lower and remove non-ASCII characters.
-std::string ParseName(const std::string& name) {
-  std::string parsed;
-  parsed.reserve(name.size());
-  for (char c : name) {
-    if (base::IsAsciiAlpha(c))
-      parsed.push_back(base::ToLowerASCII(c));
-  }
-  return parsed;
-}
+// Interval between merged mouse move events, which is about one frame.
+const int kMouseMoveInterval = 16;
+
+// Maximum number of positions recorded in merged mouse move event.
+const size_t kMaxCoalescedPositions = 64;
 
 }  // namespace
 
@@ -46,18 +47,21 @@ const char View::kClassName[] = "View";
 
 View::View() : view_(nullptr) {
   // Create node with the default yoga config.
-  yoga_config_ = YGConfigNew();
-  YGConfigCopy(yoga_config_, State::GetCurrent()->yoga_config());
-  node_ = YGNodeNewWithConfig(yoga_config_);
+  State* state = State::GetCurrent();
+  yoga_config_ = state->yoga_config();
+  node_ = state->NewYogaNode(yoga_config_);
   YGNodeSetContext(node_, this);
 }
 
 View::~View() {
   PlatformDestroy();
 
-  // Free yoga config and node.
-  YGNodeFree(node_);
-  YGConfigFree(yoga_config_);
+  // Recycle the yoga node, the config is owned by State or Window.
+  State* state = State::GetCurrent();
+  if (state)
+    state->FreeYogaNode(node_);
+  else
+    YGNodeFree(node_);
 }
 
 const char* View::GetClassName() const {
@@ -70,6 +74,119 @@ void View::SetVisible(bool visible) {
   PlatformSetVisible(visible);
   YGNodeStyleSetDisplay(node_, visible ? YGDisplayFlex : YGDisplayNone);
   Layout();
+  // Showing a parent may reveal suspended animations.
+  if (visible)
+    FrameClock::GetCurrent()->UpdateVisibility();
+}
+
+bool View::IsOnScreen() const {
+  if (!window_ || window_->IsOccluded() || !IsTreeVisible())
+    return false;
+  // Clip the bounds by every parent, in the coordinates of the parent.
+  RectF rect(GetBounds().size());
+  const View* view = this;
+  while (View* parent = view->GetParent()) {
+    if (parent->GetClassName() == Scroll::kClassName) {
+      // The viewport is the visible part of content view.
+      float x, y;
+      std::tie(x, y) = static_cast<Scroll*>(parent)->GetScrollPosition();
+      rect.Intersect(RectF(PointF(x, y), parent->GetBounds().size()));
+      rect.Offset(-x, -y);
+    } else {
+      rect.Offset(view->GetBounds().OffsetFromOrigin());
+      rect.Intersect(RectF(parent->GetBounds().size()));
+    }
+    if (rect.IsEmpty())
+      return false;
+    view = parent;
+  }
+  return true;
+}
+
+void View::SetCoalesceMouseMove(bool coalesce) {
+  coalesce_mouse_move_ = coalesce;
+  if (!coalesce)
+    FlushMouseMove();
+}
+
+void View::SetLayerBacked(bool backed) {
+  if (layer_backed_ == backed)
+    return;
+  layer_backed_ = backed;
+  PlatformSetLayerBacked(backed);
+}
+
+bool View::EmitMouseEvent(const MouseEvent& event) {
+  switch (event.type) {
+    case EventType::MouseMove:
+      EmitMouseMove(event);
+      return true;
+    case EventType::MouseDown:
+      RecordEvent(event);
+      return on_mouse_down.Emit(this, event);
+    case EventType::MouseUp:
+      RecordEvent(event);
+      return on_mouse_up.Emit(this, event);
+    case EventType::MouseEnter:
+      RecordEvent(event);
+      on_mouse_enter.Emit(this, event);
+      return true;
+    case EventType::MouseLeave:
+      RecordEvent(event);
+      on_mouse_leave.Emit(this, event);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool View::EmitKeyEvent(const KeyEvent& event) {
+  RecordEvent(event);
+  if (event.type == EventType::KeyDown)
+    return on_key_down.Emit(this, event);
+  if (event.type == EventType::KeyUp)
+    return on_key_up.Emit(this, event);
+  return false;
+}
+
+void View::EmitMouseMove(const MouseEvent& event) {
+  // Record the events before coalescing, so they are coalesced in the same
+  // way when replaying.
+  RecordEvent(event);
+  if (!coalesce_mouse_move_) {
+    on_mouse_move.Emit(this, event);
+    return;
+  }
+  std::vector<PointF> positions;
+  if (pending_mouse_move_) {
+    positions = std::move(pending_mouse_move_->coalesced_positions);
+    if (positions.size() < kMaxCoalescedPositions)
+      positions.push_back(pending_mouse_move_->position_in_view);
+  } else {
+    // Keep a reference so the view is alive when the timer fires.
+    scoped_refptr<View> self(this);
+    mouse_move_timer_ = MessageLoop::SetTimeout(
+        kMouseMoveInterval, [self]() {
+      self->mouse_move_timer_ = 0;
+      self->FlushMouseMove();
+    });
+  }
+  pending_mouse_move_.reset(new MouseEvent(event));
+  pending_mouse_move_->coalesced_positions = std::move(positions);
+  // The native event is only valid when dispatching.
+  pending_mouse_move_->native_event = nullptr;
+}
+
+void View::FlushMouseMove() {
+  if (!pending_mouse_move_)
+    return;
+  scoped_refptr<View> self(this);
+  if (mouse_move_timer_) {
+    MessageLoop::ClearTimeout(mouse_move_timer_);
+    mouse_move_timer_ = 0;
+  }
+  std::unique_ptr<MouseEvent> event = std::move(pending_mouse_move_);
+  on_mouse_move.Emit(this, *event);
 }
 
 void View::Layout() {
@@ -93,6 +210,7 @@ void View::SetCursor(scoped_refptr<Cursor> cursor) {
 void View::SetFont(scoped_refptr<Font> font) {
   if (font_ == font)
     return;
+  properties_changed_ = true;
   PlatformSetFont(font.get());
   font_ = std::move(font);
   UpdateDefaultStyle();
@@ -106,7 +224,7 @@ void View::UpdateDefaultStyle() {
 }
 
 void View::SetStyleProperty(const std::string& name, const std::string& value) {
-  std::string key(ParseName(name));
+  std::string key(ParseStyleName(name));
   if (key == "color")
     SetColor(Color(value));
   else if (key == "backgroundcolor")
@@ -116,7 +234,12 @@ void View::SetStyleProperty(const std::string& name, const std::string& value) {
 }
 
 void View::SetStyleProperty(const std::string& name, float value) {
-  SetYogaProperty(node_, ParseName(name), value);
+  SetYogaProperty(node_, ParseStyleName(name), value);
+}
+
+void View::ApplyStyle(const StyleSheet* sheet) {
+  sheet->ApplyTo(this);
+  Layout();
 }
 
 std::string View::GetComputedLayout() const {
@@ -135,7 +258,7 @@ SizeF View::GetMinimumSize() const {
 void View::SetParent(View* parent) {
   if (parent) {
     window_ = parent->window_;
-    YGConfigCopy(yoga_config_, parent->yoga_config_);
+    SetYogaConfig(parent->yoga_config_);
   } else {
     window_ = nullptr;
   }
@@ -145,19 +268,87 @@ void View::SetParent(View* parent) {
 void View::BecomeContentView(Window* window) {
   if (window) {
     window_ = window;
-    YGConfigCopy(yoga_config_, window->GetYogaConfig());
+    SetYogaConfig(window->GetYogaConfig());
   } else {
     window_ = nullptr;
   }
   parent_ = nullptr;
 }
 
+void View::SetYogaConfig(YGConfigRef config) {
+  yoga_config_ = config;
+  node_->setConfig(config);
+}
+
 bool View::IsContainer() const {
   return false;
 }
 
+bool View::ResetForReuse() {
+  return false;
+}
+
+bool View::ResetViewStates() {
+  if (properties_changed_)
+    return false;
+  on_mouse_down.DisconnectAll();
+  on_mouse_up.DisconnectAll();
+  on_mouse_move.DisconnectAll();
+  on_mouse_enter.DisconnectAll();
+  on_mouse_leave.DisconnectAll();
+  on_key_down.DisconnectAll();
+  on_key_up.DisconnectAll();
+  on_drag_leave.DisconnectAll();
+  on_size_changed.DisconnectAll();
+  on_capture_lost.DisconnectAll();
+  handle_drag_enter = nullptr;
+  handle_drag_update = nullptr;
+  handle_drop = nullptr;
+
+  SetVisible(true);
+  SetEnabled(true);
+  SetCursor(nullptr);
+  SetCoalesceMouseMove(false);
+  SetLayerBacked(false);
+
+  // Copy styles from a fresh node to restore the default values.
+  State* state = State::GetCurrent();
+  YGNodeRef default_node = state->NewYogaNode(yoga_config_);
+  YGNodeCopyStyle(node_, default_node);
+  state->FreeYogaNode(default_node);
+  UpdateDefaultStyle();
+  return true;
+}
+
+void View::OnLiveResizeEnd() {
+}
+
 void View::OnSizeChanged() {
+  // The size of content view changes with the window.
+  if (!parent_ && window_ && window_->event_recorder())
+    window_->event_recorder()->RecordResize(GetBounds().size());
   on_size_changed.Emit(this);
 }
 
+EventRecorder* View::GetEventRecorder() const {
+  if (!EventRecorder::IsAnyRecording())
+    return nullptr;
+  const View* view = this;
+  while (view->parent_)
+    view = view->parent_;
+  return view->window_ ? view->window_->event_recorder() : nullptr;
+}
+
+void View::RecordEvent(const MouseEvent& event) {
+  EventRecorder* recorder = GetEventRecorder();
+  if (recorder)
+    recorder->RecordMouseEvent(this, event);
+}
+
+void View::RecordEvent(const KeyEvent& event) {
+  EventRecorder* recorder = GetEventRecorder();
+  if (recorder)
+    recorder->RecordKeyEvent(this, event);
+}
+
 }  // namespace nu
@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_VIEW_H_
 #define NATIVEUI_VIEW_H_
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -15,6 +16,8 @@
 #include "nativeui/gfx/color.h"
 #include "nativeui/gfx/geometry/rect_f.h"
 #include "nativeui/gfx/geometry/size_f.h"
+#include "nativeui/memory_report.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/signal.h"
 
 typedef struct YGNode *YGNodeRef;
@@ -22,8 +25,11 @@ typedef struct YGConfig *YGConfigRef;
 
 namespace nu {
 
+class Canvas;
 class Cursor;
+class EventRecorder;
 class Font;
+class StyleSheet;
 class Window;
 struct MouseEvent;
 struct KeyEvent;
@@ -71,6 +77,11 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // TODO(zcbenz): Find a better name before making it public.
   bool IsTreeVisible() const;
 
+  // Whether any part of the view can be seen, which requires the view and its
+  // parents to be visible, the window not occluded, and the view not clipped
+  // away by its parents or scrolled out of the viewport.
+  bool IsOnScreen() const;
+
   // Enable/disable the view.
   void SetEnabled(bool enable);
   bool IsEnabled() const;
@@ -92,6 +103,10 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   void SetMouseDownCanMoveWindow(bool yes);
   bool IsMouseDownCanMoveWindow() const;
 
+  // Merge the mouse move events and emit at most one per frame.
+  void SetCoalesceMouseMove(bool coalesce);
+  bool IsCoalesceMouseMove() const { return coalesce_mouse_move_; }
+
   // Drag and drop.
   int DoDrag(std::vector<Clipboard::Data> data, int operations);
   int DoDragWithOptions(std::vector<Clipboard::Data> data,
@@ -131,15 +146,32 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   void SetStyle() {
   }
 
+  // Apply the pre-parsed styles and re-compute the layout.
+  void ApplyStyle(const StyleSheet* sheet);
+
   // Return the string representation of yoga style.
   std::string GetComputedLayout() const;
 
   // Return the minimum size of view.
   virtual SizeF GetMinimumSize() const;
 
+  // Draw the view and its children into |rect| of |canvas|, the contents are
+  // scaled to fill |rect|.
+  void RenderToCanvas(Canvas* canvas, const RectF& rect);
+
+  // Cache the contents of the view and its children in a layer, so moving or
+  // scrolling the view only composites the cache instead of repainting.
+  void SetLayerBacked(bool backed);
+  bool IsLayerBacked() const { return layer_backed_; }
+
 #if defined(OS_MACOSX)
   void SetWantsLayer(bool wants);
   bool WantsLayer() const;
+
+  // Let CoreAnimation rasterize the drawings of the view's layer in the
+  // background, the layer is created if it does not exist.
+  void SetDrawsAsynchronously(bool async);
+  bool DrawsAsynchronously() const;
 #endif
 
   // Get parent.
@@ -158,9 +190,29 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // Internal: Whether this class inherits from Container.
   virtual bool IsContainer() const;
 
+  // Internal: Restore the states set by constructor so the view can be reused
+  // by the recycling pool, returns false if the view can not be reused.
+  virtual bool ResetForReuse();
+
   // Internal: Notify that view's size has changed.
   virtual void OnSizeChanged();
 
+  // Internal: Notify that the live resize of window has ended, views that
+  // approximated their sizes should be measured again.
+  virtual void OnLiveResizeEnd();
+
+  // Internal: Emit the signal of |event|, and record the event when the window
+  // is being recorded. Returns whether the event is handled.
+  bool EmitMouseEvent(const MouseEvent& event);
+  bool EmitKeyEvent(const KeyEvent& event);
+
+  // Internal: Emit on_mouse_move, or merge the event when coalescing.
+  void EmitMouseMove(const MouseEvent& event);
+
+  // Internal: Emit the merged mouse move event immediately, called before
+  // dispatching other mouse events to keep the order of events.
+  void FlushMouseMove();
+
   // Internal: Get the CSS node of the view.
   YGNodeRef node() const { return node_; }
 
@@ -194,6 +246,11 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // Update the default style.
   void UpdateDefaultStyle();
 
+  // Reset the styles, visibility and event handlers shared by all views.
+  // Returns false if properties that can not be restored to the defaults,
+  // like colors and fonts, have been set, and the view should not be reused.
+  bool ResetViewStates();
+
   // Called by subclasses to take the ownership of |view|.
   void TakeOverView(NativeView view);
 
@@ -202,10 +259,19 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   void PlatformSetVisible(bool visible);
   void PlatformSetCursor(Cursor* cursor);
   void PlatformSetFont(Font* font);
+  void PlatformSetLayerBacked(bool backed);
 
  private:
   friend class base::RefCounted<View>;
 
+  // Switch to another shared yoga config.
+  void SetYogaConfig(YGConfigRef config);
+
+  // Return the recorder of the window that the view is in.
+  EventRecorder* GetEventRecorder() const;
+  void RecordEvent(const MouseEvent& event);
+  void RecordEvent(const KeyEvent& event);
+
   // Relationships.
   View* parent_ = nullptr;
   Window* window_ = nullptr;
@@ -213,7 +279,7 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
   // The native implementation.
   NativeView view_;
 
-  // The config of its yoga node.
+  // The config of its yoga node, which is shared with other views.
   YGConfigRef yoga_config_;
 
   // The font used for the view.
@@ -224,6 +290,20 @@ class NATIVEUI_EXPORT View : public base::RefCounted<View> {
 
   // The node recording CSS styles.
   YGNodeRef node_;
+
+  // Whether the contents are cached in a layer.
+  bool layer_backed_ = false;
+
+  // Whether properties that ResetViewStates can not restore have been set.
+  bool properties_changed_ = false;
+
+  // The merged mouse move event waiting to be emitted.
+  bool coalesce_mouse_move_ = false;
+  std::unique_ptr<MouseEvent> pending_mouse_move_;
+  MessageLoop::TimerId mouse_move_timer_ = 0;
+
+  // Counts the view in memory reports.
+  LiveObjectTracker live_object_{LiveObjectType::View, this};
 };
 
 }  // namespace nu
@@ -0,0 +1,99 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/view_template.h"
+
+#include <cstring>
+
+#include "nativeui/container.h"
+#include "nativeui/label.h"
+#include "nativeui/layout_transaction.h"
+#include "nativeui/state.h"
+#include "third_party/yoga/Yoga.h"
+
+namespace nu {
+
+// static
+scoped_refptr<ViewTemplate> ViewTemplate::Create(View* view) {
+  scoped_refptr<ViewTemplate> view_template(new ViewTemplate);
+  if (!view_template->Record(view))
+    return nullptr;
+  return view_template;
+}
+
+ViewTemplate::ViewTemplate() {}
+
+ViewTemplate::~ViewTemplate() {
+  for (const Node& node : nodes_)
+    YGNodeFree(node.style);
+}
+
+scoped_refptr<View> ViewTemplate::Instantiate() const {
+  // Adding children would otherwise do a layout for each child.
+  LayoutTransaction transaction;
+  size_t index = 0;
+  return Create(&index);
+}
+
+bool ViewTemplate::Record(View* view) {
+  // Only views that can be fully restored from their getters are supported.
+  Node node;
+  const char* class_name = view->GetClassName();
+  if (std::strcmp(class_name, Container::kClassName) == 0)
+    node.kind = Kind::Container;
+  else if (std::strcmp(class_name, Label::kClassName) == 0)
+    node.kind = Kind::Label;
+  else
+    return false;
+  node.style = YGNodeNew();
+  YGNodeCopyStyle(node.style, view->node());
+  node.visible = view->IsVisible();
+  node.enabled = view->IsEnabled();
+  node.child_count = 0;
+  if (node.kind == Kind::Label)
+    node.text = static_cast<Label*>(view)->GetText();
+  size_t index = nodes_.size();
+  nodes_.push_back(std::move(node));
+
+  if (nodes_[index].kind == Kind::Container) {
+    Container* container = static_cast<Container*>(view);
+    nodes_[index].child_count = container->ChildCount();
+    for (int i = 0; i < container->ChildCount(); ++i) {
+      if (!Record(container->ChildAt(i)))
+        return false;
+    }
+  }
+  return true;
+}
+
+scoped_refptr<View> ViewTemplate::Create(size_t* index) const {
+  const Node& node = nodes_[(*index)++];
+  State* state = State::GetCurrent();
+  scoped_refptr<View> view;
+  if (node.kind == Kind::Container) {
+    view = state->ReuseView(Container::kClassName);
+    if (!view)
+      view = new Container;
+  } else {
+    view = state->ReuseView(Label::kClassName);
+    if (view)
+      static_cast<Label*>(view.get())->SetText(node.text);
+    else
+      view = new Label(node.text);
+  }
+  YGNodeCopyStyle(view->node(), node.style);
+  if (!node.visible)
+    view->SetVisible(false);
+  if (!node.enabled)
+    view->SetEnabled(false);
+
+  if (node.kind == Kind::Container) {
+    Container* container = static_cast<Container*>(view.get());
+    for (int i = 0; i < node.child_count; ++i)
+      container->AddChildView(Create(index));
+  }
+  return view;
+}
+
+}  // namespace nu
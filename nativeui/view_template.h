@@ -0,0 +1,65 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_VIEW_TEMPLATE_H_
+#define NATIVEUI_VIEW_TEMPLATE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/nativeui_export.h"
+
+typedef struct YGNode *YGNodeRef;
+
+namespace nu {
+
+class View;
+
+// The structure and styles of a view tree recorded once, which can be used to
+// create many copies of the tree, for example items of a list.
+class NATIVEUI_EXPORT ViewTemplate : public base::RefCounted<ViewTemplate> {
+ public:
+  // Record the tree of |view|, returns nullptr if there is view that can not
+  // be recorded in the tree.
+  static scoped_refptr<ViewTemplate> Create(View* view);
+
+  // Create a copy of the recorded tree.
+  scoped_refptr<View> Instantiate() const;
+
+  // Return how many views are in the tree.
+  int GetViewCount() const { return static_cast<int>(nodes_.size()); }
+
+ protected:
+  ViewTemplate();
+  virtual ~ViewTemplate();
+
+ private:
+  friend class base::RefCounted<ViewTemplate>;
+
+  enum class Kind {
+    Container,
+    Label,
+  };
+
+  // A recorded view, children are stored right after their parent.
+  struct Node {
+    Kind kind;
+    // A detached yoga node holding the copied styles.
+    YGNodeRef style;
+    bool visible;
+    bool enabled;
+    int child_count;
+    std::string text;
+  };
+
+  bool Record(View* view);
+  scoped_refptr<View> Create(size_t* index) const;
+
+  std::vector<Node> nodes_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_VIEW_TEMPLATE_H_
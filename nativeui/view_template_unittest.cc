@@ -0,0 +1,61 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ViewTemplateTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    container_ = new nu::Container;
+    container_->SetStyle("flexdirection", "row", "padding", 5);
+    scoped_refptr<nu::Label> label = new nu::Label("item");
+    label->SetStyle("width", 50);
+    container_->AddChildView(label.get());
+    scoped_refptr<nu::Container> child = new nu::Container;
+    child->SetStyle("flex", 1);
+    child->SetVisible(false);
+    child->AddChildView(new nu::Label("nested"));
+    container_->AddChildView(child.get());
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Container> container_;
+};
+
+TEST_F(ViewTemplateTest, Instantiate) {
+  scoped_refptr<nu::ViewTemplate> view_template =
+      nu::ViewTemplate::Create(container_.get());
+  ASSERT_TRUE(view_template);
+  EXPECT_EQ(view_template->GetViewCount(), 4);
+  scoped_refptr<nu::View> view = view_template->Instantiate();
+  ASSERT_STREQ(view->GetClassName(), nu::Container::kClassName);
+  auto* container = static_cast<nu::Container*>(view.get());
+  ASSERT_EQ(container->ChildCount(), 2);
+  auto* label = static_cast<nu::Label*>(container->ChildAt(0));
+  EXPECT_EQ(label->GetText(), "item");
+  auto* child = static_cast<nu::Container*>(container->ChildAt(1));
+  EXPECT_FALSE(child->IsVisible());
+  ASSERT_EQ(child->ChildCount(), 1);
+  EXPECT_EQ(static_cast<nu::Label*>(child->ChildAt(0))->GetText(), "nested");
+}
+
+TEST_F(ViewTemplateTest, CopyStyles) {
+  scoped_refptr<nu::ViewTemplate> view_template =
+      nu::ViewTemplate::Create(container_.get());
+  ASSERT_TRUE(view_template);
+  scoped_refptr<nu::View> view = view_template->Instantiate();
+  view->SetBounds(nu::RectF(0, 0, 200, 100));
+  container_->SetBounds(nu::RectF(0, 0, 200, 100));
+  auto* container = static_cast<nu::Container*>(view.get());
+  EXPECT_EQ(container->ChildAt(0)->GetBounds(),
+            container_->ChildAt(0)->GetBounds());
+  EXPECT_EQ(container->ChildAt(0)->GetBounds().width(), 50);
+}
+
+TEST_F(ViewTemplateTest, UnsupportedView) {
+  container_->AddChildView(new nu::Button("button"));
+  EXPECT_FALSE(nu::ViewTemplate::Create(container_.get()));
+}
@@ -40,6 +40,16 @@ TEST_F(ViewTest, SetVisible) {
   EXPECT_EQ(view_->IsVisible(), false);
 }
 
+TEST_F(ViewTest, IsOnScreen) {
+  EXPECT_FALSE(view_->IsOnScreen());
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetContentView(view_.get());
+  window->SetContentSize(nu::SizeF(200, 200));
+  // The window has not been shown.
+  EXPECT_TRUE(window->IsOccluded());
+  EXPECT_FALSE(view_->IsOnScreen());
+}
+
 TEST_F(ViewTest, HiddenViewSkipsLayout) {
   scoped_refptr<nu::Container> container(new nu::Container);
   container->AddChildView(view_.get());
@@ -59,3 +69,72 @@ TEST_F(ViewTest, OnSizeChanged) {
   window->SetContentSize(nu::SizeF(100, 100));
   EXPECT_TRUE(changed);
 }
+
+TEST_F(ViewTest, ApplyStyle) {
+  scoped_refptr<nu::StyleSheet> sheet(new nu::StyleSheet);
+  sheet->SetProperty("width", 100);
+  sheet->SetProperty("height", "50%");
+  sheet->SetProperty("margin-left", "10px");
+  sheet->SetProperty("unknown", "value");
+  scoped_refptr<nu::Container> container(new nu::Container);
+  container->SetBounds(nu::RectF(0, 0, 400, 400));
+  container->AddChildView(view_.get());
+  view_->ApplyStyle(sheet.get());
+  EXPECT_EQ(view_->GetBounds(), nu::RectF(10, 0, 100, 200));
+}
+
+TEST_F(ViewTest, ReuseYogaNode) {
+  scoped_refptr<nu::Container> container(new nu::Container);
+  container->AddChildView(view_.get());
+  view_->SetStyle("width", 100.f);
+  YGNodeRef node = view_->node();
+  container->RemoveChildView(view_.get());
+  view_ = nullptr;
+  // The node is reused with styles reset.
+  scoped_refptr<nu::View> view = new nu::Container;
+  EXPECT_EQ(view->node(), node);
+  scoped_refptr<nu::View> fresh = new nu::Container;
+  EXPECT_EQ(view->GetComputedLayout(), fresh->GetComputedLayout());
+  // Views of the same scale factor share the config.
+  EXPECT_EQ(state_.GetYogaConfig(2.f), state_.GetYogaConfig(2.f));
+}
+
+TEST_F(ViewTest, RenderToCanvas) {
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetContentView(view_.get());
+  window->SetContentSize(nu::SizeF(20, 20));
+  view_->SetBackgroundColor(nu::Color(255, 0, 0));
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 10), 1.f);
+  view_->RenderToCanvas(canvas.get(), nu::RectF(0, 0, 10, 10));
+  // The view is scaled to fill the canvas.
+  nu::CanvasPixels pixels = canvas->LockPixels();
+  const uint8_t* data = static_cast<const uint8_t*>(pixels.buffer.content());
+  const uint8_t* center = data + 5 * pixels.stride + 5 * 4;
+  EXPECT_EQ(center[2], 255);
+  EXPECT_EQ(center[3], 255);
+  canvas->UnlockPixels();
+}
+
+TEST_F(ViewTest, MemoryReport) {
+  nu::MemoryReport report = state_.GetMemoryReport();
+  EXPECT_EQ(report.view_count, 1);
+  EXPECT_EQ(report.views["Label"], 1);
+  EXPECT_GE(report.yoga_node_count, 1);
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(10, 20), 2.f);
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(3);
+  nu::SimpleTableModel::Row row;
+  for (int i = 0; i < 3; ++i)
+    row.push_back(base::Value(i));
+  model->AddRow(std::move(row));
+  report = state_.GetMemoryReport();
+  EXPECT_EQ(report.canvases.count, 1);
+  EXPECT_EQ(report.canvases.bytes, 20u * 40u * 4u);
+  EXPECT_EQ(report.table_model_count, 1);
+  EXPECT_EQ(report.table_rows, 1u);
+  EXPECT_EQ(report.table_cells, 3u);
+  view_ = nullptr;
+  canvas = nullptr;
+  report = state_.GetMemoryReport();
+  EXPECT_EQ(report.view_count, 0);
+  EXPECT_EQ(report.canvases.count, 0);
+}
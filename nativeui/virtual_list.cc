@@ -0,0 +1,260 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/virtual_list.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/auto_reset.h"
+#include "base/logging.h"
+#include "nativeui/container.h"
+#include "nativeui/layout_transaction.h"
+
+namespace nu {
+
+// static
+const char VirtualList::kClassName[] = "VirtualList";
+
+VirtualList::VirtualList() : content_(new Container) {
+  SetScrollbarPolicy(Policy::Never, Policy::Automatic);
+  SetContentView(content_);
+}
+
+VirtualList::~VirtualList() {
+}
+
+void VirtualList::SetItemCount(int count) {
+  LayoutTransaction transaction;
+  RecycleAllItems();
+  item_count_ = std::max(0, count);
+  heights_.clear();
+  offsets_.clear();
+  offsets_valid_ = 0;
+  UpdateVisibleItems();
+}
+
+void VirtualList::SetEstimatedItemHeight(float height) {
+  if (height <= 0) {
+    LOG(ERROR) << "The estimated item height must be positive.";
+    return;
+  }
+  estimated_item_height_ = height;
+  offsets_valid_ = 0;
+  UpdateVisibleItems();
+}
+
+void VirtualList::SetOverscan(int count) {
+  overscan_ = std::max(0, count);
+  UpdateVisibleItems();
+}
+
+void VirtualList::ReloadData() {
+  SetItemCount(item_count_);
+}
+
+void VirtualList::ReloadItem(int index) {
+  if (index < 0 || index >= item_count_)
+    return;
+  if (static_cast<int>(heights_.size()) == item_count_) {
+    heights_[index] = -1.f;
+    offsets_valid_ = std::min(offsets_valid_, index);
+  }
+  auto it = active_items_.find(index);
+  if (it != active_items_.end() && bind_item)
+    bind_item(this, it->second.get(), index);
+  UpdateVisibleItems();
+}
+
+void VirtualList::ScrollToItem(int index) {
+  if (index < 0 || index >= item_count_)
+    return;
+  float max_y = std::get<1>(GetMaximumScrollPosition());
+  SetScrollPosition(0, std::min(GetItemOffset(index), max_y));
+  UpdateVisibleItems();
+}
+
+std::tuple<int, int> VirtualList::GetVisibleRange() const {
+  if (active_items_.empty())
+    return std::make_tuple(0, 0);
+  return std::make_tuple(active_items_.begin()->first,
+                         active_items_.rbegin()->first + 1);
+}
+
+View* VirtualList::GetItemView(int index) const {
+  auto it = active_items_.find(index);
+  return it == active_items_.end() ? nullptr : it->second.get();
+}
+
+void VirtualList::OnScrollPositionChange() {
+  // Update before the frame is drawn, so no blank area would be shown.
+  UpdateVisibleItems();
+}
+
+const char* VirtualList::GetClassName() const {
+  return kClassName;
+}
+
+void VirtualList::OnSizeChanged() {
+  Scroll::OnSizeChanged();
+  UpdateVisibleItems();
+}
+
+float VirtualList::GetItemHeight(int index) const {
+  if (!measure_item || static_cast<int>(heights_.size()) != item_count_ ||
+      heights_[index] < 0)
+    return estimated_item_height_;
+  return heights_[index];
+}
+
+float VirtualList::GetItemOffset(int index) {
+  // Items have the same height when there is no measure delegate, which
+  // allows computing the offsets without keeping per-item data.
+  if (!measure_item)
+    return index * estimated_item_height_;
+  UpdateOffsets();
+  return offsets_[index];
+}
+
+int VirtualList::GetItemAt(float y) {
+  if (item_count_ == 0)
+    return 0;
+  int index;
+  if (!measure_item) {
+    index = static_cast<int>(y / estimated_item_height_);
+  } else {
+    UpdateOffsets();
+    auto it = std::upper_bound(offsets_.begin(),
+                               offsets_.begin() + item_count_, y);
+    index = static_cast<int>(it - offsets_.begin()) - 1;
+  }
+  return std::max(0, std::min(index, item_count_ - 1));
+}
+
+float VirtualList::MeasureItem(int index) {
+  // The offsets are only invalidated here, and recomputed once when they are
+  // read, so measuring a batch of items does not walk all items each time.
+  EnsureItemData();
+  if (heights_[index] < 0) {
+    float height = std::max(0.f, measure_item(this, index));
+    heights_[index] = height;
+    if (height != estimated_item_height_)
+      offsets_valid_ = std::min(offsets_valid_, index);
+  }
+  return heights_[index];
+}
+
+void VirtualList::EnsureItemData() {
+  if (static_cast<int>(heights_.size()) != item_count_) {
+    heights_.assign(item_count_, -1.f);
+    offsets_.assign(item_count_ + 1, 0.f);
+    offsets_valid_ = 0;
+  }
+}
+
+void VirtualList::UpdateOffsets() {
+  EnsureItemData();
+  for (int i = offsets_valid_; i < item_count_; ++i)
+    offsets_[i + 1] = offsets_[i] + GetItemHeight(i);
+  offsets_valid_ = item_count_;
+}
+
+std::tuple<int, int> VirtualList::ComputeVisibleRange() {
+  if (item_count_ == 0)
+    return std::make_tuple(0, 0);
+  float top = std::get<1>(GetScrollPosition());
+  float bottom = top + GetBounds().height();
+  int first = GetItemAt(top);
+  int last = first;
+  // Heights of items may change after being measured, so walk the items
+  // instead of looking up the bottom directly.
+  for (float y = GetItemOffset(first); last < item_count_ && y < bottom;
+       ++last)
+    y += measure_item ? MeasureItem(last) : estimated_item_height_;
+  first = std::max(0, first - overscan_);
+  last = std::min(item_count_, last + overscan_);
+  if (measure_item) {
+    for (int i = first; i < last; ++i)
+      MeasureItem(i);
+  }
+  return std::make_tuple(first, last);
+}
+
+void VirtualList::UpdateVisibleItems() {
+  if (updating_ || !create_item)
+    return;
+  base::AutoReset<bool> auto_reset(&updating_, true);
+  LayoutTransaction transaction;
+
+  int first, last;
+  std::tie(first, last) = ComputeVisibleRange();
+  for (auto it = active_items_.begin(); it != active_items_.end();) {
+    if (it->first < first || it->first >= last)
+      RecycleItem(it++);
+    else
+      ++it;
+  }
+
+  for (int i = first; i < last; ++i) {
+    if (active_items_.find(i) != active_items_.end())
+      continue;
+    scoped_refptr<View> view;
+    if (pool_.empty()) {
+      view = create_item(this);
+      if (!view) {
+        LOG(ERROR) << "The create_item delegate must return a view.";
+        break;
+      }
+      view->SetStyleProperty("position", "absolute");
+      view->SetStyleProperty("left", 0.f);
+      view->SetStyleProperty("right", 0.f);
+      content_->AddChildView(view);
+    } else {
+      view = std::move(pool_.back());
+      pool_.pop_back();
+      view->SetVisible(true);
+    }
+    if (bind_item)
+      bind_item(this, view.get(), i);
+    active_items_[i] = std::move(view);
+  }
+
+  for (const auto& it : active_items_)
+    PlaceItem(it.first, it.second.get());
+  float total_height = measure_item ? GetItemOffset(item_count_)
+                                    : item_count_ * estimated_item_height_;
+  SizeF content_size(GetBounds().width(), total_height);
+  if (content_size != GetContentSize()) {
+    // Some platforms reset the scroll position when content size changes.
+    float x, y;
+    std::tie(x, y) = GetScrollPosition();
+    SetContentSize(content_size);
+    y = std::min(y, std::get<1>(GetMaximumScrollPosition()));
+    if (GetScrollPosition() != std::make_tuple(x, y))
+      SetScrollPosition(x, y);
+  }
+  content_->Layout();
+}
+
+void VirtualList::RecycleAllItems() {
+  while (!active_items_.empty())
+    RecycleItem(active_items_.begin());
+}
+
+void VirtualList::RecycleItem(
+    std::map<int, scoped_refptr<View>>::iterator it) {
+  View* view = it->second.get();
+  if (recycle_item)
+    recycle_item(this, view, it->first);
+  view->SetVisible(false);
+  pool_.push_back(std::move(it->second));
+  active_items_.erase(it);
+}
+
+void VirtualList::PlaceItem(int index, View* view) {
+  view->SetStyleProperty("top", GetItemOffset(index));
+  view->SetStyleProperty("height", GetItemHeight(index));
+}
+
+}  // namespace nu
@@ -0,0 +1,128 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_VIRTUAL_LIST_H_
+#define NATIVEUI_VIRTUAL_LIST_H_
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "nativeui/scroll.h"
+
+namespace nu {
+
+class Container;
+
+// A vertical list that only creates views for the visible items.
+//
+// The views are requested from the |create_item| delegate, and are reused for
+// other items after they are scrolled out of the visible area.
+class NATIVEUI_EXPORT VirtualList : public Scroll {
+ public:
+  VirtualList();
+
+  // View class name.
+  static const char kClassName[];
+
+  // Change the number of items, all items are rebound.
+  void SetItemCount(int count);
+  int GetItemCount() const { return item_count_; }
+
+  // The height used for items that have not been measured.
+  void SetEstimatedItemHeight(float height);
+  float GetEstimatedItemHeight() const { return estimated_item_height_; }
+
+  // Number of extra items kept alive above and below the visible area.
+  void SetOverscan(int count);
+  int GetOverscan() const { return overscan_; }
+
+  // Rebind and remeasure the items.
+  void ReloadData();
+  void ReloadItem(int index);
+
+  void ScrollToItem(int index);
+
+  // Return the range of items that have views, in the form of [first, last).
+  std::tuple<int, int> GetVisibleRange() const;
+
+  // Return the view bound to item, or null if the item has no view.
+  View* GetItemView(int index) const;
+
+  // View:
+  const char* GetClassName() const override;
+  void OnSizeChanged() override;
+
+  // Delegates.
+  std::function<scoped_refptr<View>(VirtualList*)> create_item;
+  std::function<void(VirtualList*, View*, int)> bind_item;
+  std::function<void(VirtualList*, View*, int)> recycle_item;
+  std::function<float(VirtualList*, int)> measure_item;
+
+ protected:
+  ~VirtualList() override;
+
+  // Scroll:
+  void OnScrollPositionChange() override;
+
+ private:
+  // Return the height of item, unmeasured items use the estimated height.
+  float GetItemHeight(int index) const;
+
+  // Return the top of item.
+  float GetItemOffset(int index);
+
+  // Return the item at vertical position |y|.
+  int GetItemAt(float y);
+
+  // Return the height of item, measure it if not done yet.
+  float MeasureItem(int index);
+
+  // Allocate the per-item data if the item count has changed.
+  void EnsureItemData();
+
+  // Recompute the offsets of items after |offsets_valid_|.
+  void UpdateOffsets();
+
+  // Compute the range of items that should have views, overscan included.
+  std::tuple<int, int> ComputeVisibleRange();
+
+  // Bind views to visible items and recycle the others.
+  void UpdateVisibleItems();
+
+  // Move all views to the pool.
+  void RecycleAllItems();
+
+  // Move the view of item to the pool.
+  void RecycleItem(std::map<int, scoped_refptr<View>>::iterator it);
+
+  // Update the position of item's view.
+  void PlaceItem(int index, View* view);
+
+  scoped_refptr<Container> content_;
+
+  int item_count_ = 0;
+  float estimated_item_height_ = 30.f;
+  int overscan_ = 5;
+
+  // Per-item data, only used when |measure_item| is set.
+  // Heights of items, negative values mean not measured yet.
+  std::vector<float> heights_;
+  // offsets_[i] is the top of item i, offsets_[item_count_] is the total
+  // height. Only offsets_[0, offsets_valid_] are up to date.
+  std::vector<float> offsets_;
+  int offsets_valid_ = 0;
+
+  // Items that have views currently.
+  std::map<int, scoped_refptr<View>> active_items_;
+  // Hidden views waiting to be reused.
+  std::vector<scoped_refptr<View>> pool_;
+
+  // Guard against reentrance caused by changing content size.
+  bool updating_ = false;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_VIRTUAL_LIST_H_
@@ -0,0 +1,86 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class VirtualListTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    window_ = new nu::Window(nu::Window::Options());
+    window_->SetContentSize(nu::SizeF(400, 400));
+    list_ = new nu::VirtualList;
+    list_->SetEstimatedItemHeight(40);
+    list_->SetOverscan(2);
+    list_->create_item = [this](nu::VirtualList*) {
+      ++create_count_;
+      return new nu::Label;
+    };
+    list_->bind_item = [this](nu::VirtualList*, nu::View*, int) {
+      ++bind_count_;
+    };
+    list_->recycle_item = [this](nu::VirtualList*, nu::View*, int) {
+      ++recycle_count_;
+    };
+    window_->SetContentView(list_.get());
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+  scoped_refptr<nu::Window> window_;
+  scoped_refptr<nu::VirtualList> list_;
+  int create_count_ = 0;
+  int bind_count_ = 0;
+  int recycle_count_ = 0;
+};
+
+TEST_F(VirtualListTest, OnlyCreateVisibleItems) {
+  list_->SetItemCount(100000);
+  int first, last;
+  std::tie(first, last) = list_->GetVisibleRange();
+  EXPECT_EQ(first, 0);
+  EXPECT_LE(last, 400 / 40 + 2 + 1);
+  EXPECT_EQ(create_count_, last);
+  EXPECT_EQ(bind_count_, last);
+  EXPECT_EQ(list_->GetContentSize().height(), 100000 * 40);
+  nu::View* view = list_->GetItemView(0);
+  ASSERT_NE(view, nullptr);
+  EXPECT_EQ(view->GetParent(), list_->GetContentView());
+  EXPECT_EQ(list_->GetItemView(last), nullptr);
+}
+
+TEST_F(VirtualListTest, ReuseViews) {
+  list_->SetItemCount(100000);
+  int created = create_count_;
+  list_->SetItemCount(3);
+  EXPECT_EQ(recycle_count_, created);
+  EXPECT_EQ(list_->GetVisibleRange(), std::make_tuple(0, 3));
+  list_->SetItemCount(100000);
+  EXPECT_EQ(create_count_, created);
+}
+
+TEST_F(VirtualListTest, MeasureItem) {
+  list_->measure_item = [](nu::VirtualList*, int index) {
+    return index % 2 == 0 ? 20.f : 60.f;
+  };
+  list_->SetItemCount(10);
+  EXPECT_EQ(list_->GetContentSize().height(), 5 * 20 + 5 * 60);
+  nu::View* view = list_->GetItemView(3);
+  ASSERT_NE(view, nullptr);
+  EXPECT_EQ(view->GetBounds().y(), 20 + 60 + 20);
+  EXPECT_EQ(view->GetBounds().height(), 60);
+}
+
+TEST_F(VirtualListTest, KeepScrollPosition) {
+  list_->measure_item = [](nu::VirtualList*, int index) {
+    return index % 2 == 0 ? 20.f : 60.f;
+  };
+  list_->SetItemCount(100000);
+  list_->SetScrollPosition(0, 4000);
+  // Scrolling measures new items and changes the content height.
+  EXPECT_EQ(std::get<1>(list_->GetScrollPosition()), 4000);
+  EXPECT_NE(list_->GetItemView(100), nullptr);
+  list_->ReloadItem(100);
+  EXPECT_EQ(std::get<1>(list_->GetScrollPosition()), 4000);
+}
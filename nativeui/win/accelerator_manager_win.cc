@@ -10,6 +10,24 @@
 
 namespace nu {
 
+namespace {
+
+// The table starts with this many slots, and doubles when half full.
+const size_t kInitialSlots = 16;
+
+inline uint32_t PackKey(const Accelerator& accelerator) {
+  return (static_cast<uint32_t>(accelerator.GetKeyCode()) << 16) |
+         (static_cast<uint32_t>(accelerator.GetModifiers()) & 0xFFFF);
+}
+
+inline size_t HashKey(uint32_t key, size_t mask) {
+  // The low bits only hold modifiers, mix the key code into them.
+  uint32_t hash = key * 0x9E3779B1u;
+  return (hash ^ (hash >> 16)) & mask;
+}
+
+}  // namespace
+
 AcceleratorManager::AcceleratorManager() {
 }
 
@@ -18,7 +36,14 @@ AcceleratorManager::~AcceleratorManager() {
 
 void AcceleratorManager::RegisterAccelerator(MenuItem* item,
                                              const Accelerator& accelerator) {
-  accelerators_[accelerator] = item->GetNative()->id;
+  if ((count_ + 1) * 2 > slots_.size())
+    Grow();
+  uint32_t key = PackKey(accelerator);
+  Slot& slot = slots_[FindSlot(key, nullptr)];
+  if (slot.id == -1)
+    ++count_;
+  slot.key = key;
+  slot.id = item->GetNative()->id;
   item->GetNative()->accelerator =
       base::ASCIIToUTF16(accelerator.GetShortcutText());
   // Refresh.
@@ -27,17 +52,55 @@ void AcceleratorManager::RegisterAccelerator(MenuItem* item,
 
 void AcceleratorManager::RemoveAccelerator(MenuItem* item,
                                            const Accelerator& accelerator) {
-  accelerators_.erase(accelerator);
+  if (count_ > 0) {
+    size_t mask = slots_.size() - 1;
+    size_t i = FindSlot(PackKey(accelerator), nullptr);
+    if (slots_[i].id != -1) {
+      --count_;
+      // Shift following entries back so lookups do not stop at the hole.
+      for (size_t j = (i + 1) & mask; slots_[j].id != -1; j = (j + 1) & mask) {
+        size_t home = HashKey(slots_[j].key, mask);
+        // Move the entry if its home is not between the hole and itself.
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+          slots_[i] = slots_[j];
+          i = j;
+        }
+      }
+      slots_[i] = Slot();
+    }
+  }
   item->GetNative()->accelerator.clear();
   // Refresh.
   item->SetLabel(item->GetNative()->label);
 }
 
 int AcceleratorManager::Process(const Accelerator& accelerator) {
-  AcceleratorMap::iterator iter = accelerators_.find(accelerator);
-  if (iter != accelerators_.end())
-    return iter->second;
-  return -1;
+  ++lookup_stats_.lookups;
+  if (count_ == 0)
+    return -1;
+  return slots_[FindSlot(PackKey(accelerator), &lookup_stats_.probes)].id;
+}
+
+size_t AcceleratorManager::FindSlot(uint32_t key, int* probes) const {
+  size_t mask = slots_.size() - 1;
+  size_t i = HashKey(key, mask);
+  while (true) {
+    if (probes)
+      ++*probes;
+    if (slots_[i].id == -1 || slots_[i].key == key)
+      return i;
+    i = (i + 1) & mask;
+  }
+}
+
+void AcceleratorManager::Grow() {
+  std::vector<Slot> old_slots;
+  old_slots.swap(slots_);
+  slots_.resize(old_slots.empty() ? kInitialSlots : old_slots.size() * 2);
+  for (const Slot& slot : old_slots) {
+    if (slot.id != -1)
+      slots_[FindSlot(slot.key, nullptr)] = slot;
+  }
 }
 
 }  // namespace nu
@@ -0,0 +1,45 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/app.h"
+
+namespace nu {
+
+namespace {
+
+// The low memory state can only be polled, check it in this interval.
+const int kLowMemoryPollInterval = 5000;
+
+}  // namespace
+
+void App::PlatformInit() {
+  low_memory_notification_ =
+      ::CreateMemoryResourceNotification(LowMemoryResourceNotification);
+  if (low_memory_notification_)
+    PollLowMemory();
+}
+
+void App::PlatformDestroy() {
+  if (!low_memory_notification_)
+    return;
+  MessageLoop::ClearTimeout(low_memory_timer_);
+  ::CloseHandle(low_memory_notification_);
+  low_memory_notification_ = nullptr;
+}
+
+void App::PollLowMemory() {
+  BOOL is_low = FALSE;
+  if (::QueryMemoryResourceNotification(low_memory_notification_, &is_low)) {
+    // Only notify when entering the low memory state, Windows does not tell
+    // the levels of pressure so it is always reported as moderate.
+    if (is_low && !is_low_memory_)
+      NotifyMemoryPressure(false);
+    is_low_memory_ = is_low;
+  }
+  low_memory_timer_ = MessageLoop::SetTimeout(kLowMemoryPollInterval, [this]() {
+    PollLowMemory();
+  });
+}
+
+}  // namespace nu
@@ -5,17 +5,31 @@
 #include "nativeui/win/browser/browser_protocol.h"
 
 #include <shlwapi.h>
+#include <string.h>
 
+#include <algorithm>
 #include <string>
+#include <utility>
 
-#include "base/logging.h"
 #include "base/strings/utf_string_conversions.h"
+#include "nativeui/util/worker_pool.h"
 
 namespace nu {
 
+namespace {
+
+// The size of each read in worker thread.
+const size_t kReadBufferSize = 64 * 1024;
+
+// The worker stops reading when this much data is waiting to be consumed.
+const size_t kMaxPendingSize = 1024 * 1024;
+
+}  // namespace
+
 BrowserProtocol::BrowserProtocol(const Browser::ProtocolHandler& handler)
     : ref_(0),
-      handler_(handler) {
+      handler_(handler),
+      data_consumed_(&lock_) {
 }
 
 BrowserProtocol::~BrowserProtocol() {
@@ -59,32 +73,81 @@ IFACEMETHODIMP BrowserProtocol::Start(LPCWSTR szUrl,
 
   // Start the job.
   sink_ = pIProtSink;
+  std::string mime_type;
+  if (protocol_job_->GetMimeType(&mime_type)) {
+    sink_->ReportProgress(BINDSTATUS_VERIFIEDMIMETYPEAVAILABLE,
+                          base::UTF8ToUTF16(mime_type).c_str());
+  }
+
+  // Jobs that may block are read in a worker thread, so the UI thread only
+  // copies the data that has been read.
+  if (protocol_job_->MayBlock()) {
+    read_in_worker_ = true;
+    worker_running_ = true;
+    protocol_job_->Plug([this](int size) {
+      base::AutoLock auto_lock(lock_);
+      size_ = size;
+    });
+    // Keep the protocol alive until the worker is done.
+    AddRef();
+    scoped_refptr<ProtocolJob> protocol_job = protocol_job_;
+    Microsoft::WRL::ComPtr<IInternetProtocolSink> sink = sink_;
+    WorkerPool::PostTask([this, protocol_job, sink]() mutable {
+      ReadInWorker(std::move(protocol_job), std::move(sink));
+      Release();
+    });
+    return S_OK;
+  }
+
   protocol_job_->Plug([this](int size) {
     sink_->ReportData(BSCF_FIRSTDATANOTIFICATION |
                       BSCF_LASTDATANOTIFICATION |
                       BSCF_DATAFULLYAVAILABLE,
                       0, size);
   });
-  std::string mime_type;
-  if (protocol_job_->GetMimeType(&mime_type)) {
-    sink_->ReportProgress(BINDSTATUS_VERIFIEDMIMETYPEAVAILABLE,
-                          base::UTF8ToUTF16(mime_type).c_str());
-  }
   return protocol_job_->Start() ? S_OK : E_FAIL;
 }
 
 IFACEMETHODIMP BrowserProtocol::Continue(PROTOCOLDATA *pStateInfo) {
-  return E_NOTIMPL;
+  // Report the data read in worker thread.
+  if (!read_in_worker_ || !sink_)
+    return S_OK;
+  uint64_t progress;
+  int size;
+  bool failed, finished;
+  {
+    base::AutoLock auto_lock(lock_);
+    progress = progress_;
+    size = size_;
+    failed = failed_;
+    finished = finished_;
+  }
+  if (failed) {
+    sink_->ReportResult(E_FAIL, 0, NULL);
+    return S_OK;
+  }
+  DWORD flags = first_report_ ? BSCF_FIRSTDATANOTIFICATION
+                              : BSCF_INTERMEDIATEDATANOTIFICATION;
+  if (finished)
+    flags |= BSCF_LASTDATANOTIFICATION | BSCF_DATAFULLYAVAILABLE;
+  first_report_ = false;
+  sink_->ReportData(flags, static_cast<ULONG>(progress),
+                    static_cast<ULONG>(std::max(size, 0)));
+  return S_OK;
 }
 
 IFACEMETHODIMP BrowserProtocol::Abort(HRESULT hrReason, DWORD dwOptions) {
-  protocol_job_->Kill();
+  // A running worker kills the job by itself after reading has stopped.
+  if (!read_in_worker_ || !StopWorker())
+    protocol_job_->Kill();
   protocol_job_ = nullptr;
   sink_.Reset();
   return E_NOTIMPL;
 }
 
 IFACEMETHODIMP BrowserProtocol::Terminate(DWORD dwOptions) {
+  if (read_in_worker_)
+    StopWorker();
   protocol_job_ = nullptr;
   sink_.Reset();
   return E_NOTIMPL;
@@ -99,6 +162,25 @@ IFACEMETHODIMP BrowserProtocol::Resume() {
 }
 
 IFACEMETHODIMP BrowserProtocol::Read(void *pv, ULONG cb, ULONG *pcbRead) {
+  if (read_in_worker_) {
+    {
+      base::AutoLock auto_lock(lock_);
+      size_t available = pending_.size() - pending_pos_;
+      if (available > 0) {
+        size_t nread = std::min(static_cast<size_t>(cb), available);
+        memcpy(pv, pending_.data() + pending_pos_, nread);
+        pending_pos_ += nread;
+        data_consumed_.Signal();
+        *pcbRead = static_cast<ULONG>(nread);
+        return S_OK;
+      }
+      // More data will be reported by Continue.
+      if (!finished_)
+        return E_PENDING;
+    }
+    sink_->ReportResult(S_OK, 0, NULL);
+    return S_FALSE;
+  }
   size_t nread = protocol_job_->Read(pv, cb);
   if (nread == 0) {
     sink_->ReportResult(S_OK, 0, NULL);
@@ -122,6 +204,53 @@ IFACEMETHODIMP BrowserProtocol::UnlockRequest() {
   return E_NOTIMPL;
 }
 
+void BrowserProtocol::ReadInWorker(
+    scoped_refptr<ProtocolJob> protocol_job,
+    Microsoft::WRL::ComPtr<IInternetProtocolSink> sink) {
+  bool started = protocol_job->Start();
+  std::string buffer(kReadBufferSize, '\0');
+  while (started) {
+    {
+      base::AutoLock auto_lock(lock_);
+      while (!stopped_ && pending_.size() - pending_pos_ >= kMaxPendingSize)
+        data_consumed_.Wait();
+      if (stopped_)
+        break;
+    }
+    size_t nread = protocol_job->Read(&buffer[0], buffer.size());
+    if (nread == 0)
+      break;
+    {
+      base::AutoLock auto_lock(lock_);
+      pending_.erase(0, pending_pos_);
+      pending_pos_ = 0;
+      pending_.append(buffer.data(), nread);
+      progress_ += nread;
+    }
+    sink->Switch(&protocol_data_);
+  }
+
+  bool stopped;
+  {
+    base::AutoLock auto_lock(lock_);
+    failed_ = !started;
+    finished_ = true;
+    worker_running_ = false;
+    stopped = stopped_;
+  }
+  if (stopped)
+    protocol_job->Kill();
+  else
+    sink->Switch(&protocol_data_);
+}
+
+bool BrowserProtocol::StopWorker() {
+  base::AutoLock auto_lock(lock_);
+  stopped_ = true;
+  data_consumed_.Signal();
+  return worker_running_;
+}
+
 IFACEMETHODIMP BrowserProtocol::ParseUrl(LPCWSTR pwzUrl,
                                          PARSEACTION ParseAction,
                                          DWORD dwParseFlags,
@@ -9,6 +9,10 @@
 #include <urlmon.h>
 #include <wrl.h>
 
+#include <string>
+
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
 #include "nativeui/browser.h"
 #include "nativeui/protocol_job.h"
 
@@ -70,6 +74,13 @@ class BrowserProtocol : public IInternetProtocol,
                            DWORD dwReserved);
 
  private:
+  // Start and read the job in a worker thread, for jobs that may block.
+  void ReadInWorker(scoped_refptr<ProtocolJob> protocol_job,
+                    Microsoft::WRL::ComPtr<IInternetProtocolSink> sink);
+
+  // Stop the worker when the request ends, return whether it is still running.
+  bool StopWorker();
+
   ULONG ref_;
 
   // Managed by BrowserProtocolFactory.
@@ -78,6 +89,22 @@ class BrowserProtocol : public IInternetProtocol,
   Microsoft::WRL::ComPtr<IInternetProtocolSink> sink_;
   scoped_refptr<ProtocolJob> protocol_job_;
 
+  // Used for passing the data read in worker thread, data are reported in the
+  // apartment thread via IInternetProtocolSink::Switch.
+  bool read_in_worker_ = false;
+  bool first_report_ = true;
+  PROTOCOLDATA protocol_data_ = {};
+  base::Lock lock_;
+  base::ConditionVariable data_consumed_;
+  std::string pending_;
+  size_t pending_pos_ = 0;
+  uint64_t progress_ = 0;
+  int size_ = -1;
+  bool failed_ = false;
+  bool finished_ = false;
+  bool stopped_ = false;
+  bool worker_running_ = false;
+
   DISALLOW_COPY_AND_ASSIGN(BrowserProtocol);
 };
 
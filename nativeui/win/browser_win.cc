@@ -9,6 +9,7 @@
 #include <string>
 #include <utility>
 
+#include "base/json/json_writer.h"
 #include "base/strings/utf_string_conversions.h"
 #include "nativeui/events/win/event_win.h"
 #include "nativeui/state.h"
@@ -238,6 +239,30 @@ void Browser::ExecuteJavaScript(const std::string& code,
   browser->ExecuteJavaScript(base::UTF8ToUTF16(code), callback);
 }
 
+void Browser::PlatformExecuteJavaScriptRaw(
+    const std::string& code,
+    const RawExecutionCallback& callback) {
+#if defined(WEBVIEW2_SUPPORT)
+  // WebView2 always returns the result in JSON.
+  if (IsWebView2()) {
+    auto* browser = static_cast<BrowserImplWebview2*>(
+        static_cast<BrowserHolder*>(GetNative())->impl());
+    browser->ExecuteJavaScriptRaw(base::UTF8ToUTF16(code), callback);
+    return;
+  }
+#endif
+  // IE passes the result through JSON already, serialize the value back.
+  ExecuteJavaScript(code, [callback](bool success, base::Value result) {
+    std::string json;
+    if (!success)
+      callback(false, std::string());
+    else if (base::JSONWriter::Write(result, &json))
+      callback(true, std::move(json));
+    else
+      callback(true, "null");
+  });
+}
+
 void Browser::GoBack() {
   auto* browser = static_cast<BrowserHolder*>(GetNative())->impl();
   browser->GoBack();
@@ -279,8 +304,8 @@ void Browser::PlatformUpdateBindings() {
 }
 
 // static
-bool Browser::RegisterProtocol(const std::string& scheme,
-                               const ProtocolHandler& handler) {
+bool Browser::PlatformRegisterProtocol(const std::string& scheme,
+                                       const ProtocolHandler& handler) {
 #if defined(WEBVIEW2_SUPPORT)
   BrowserImplWebview2::RegisterProtocol(base::UTF8ToUTF16(scheme), handler);
 #endif
@@ -288,7 +313,7 @@ bool Browser::RegisterProtocol(const std::string& scheme,
 }
 
 // static
-void Browser::UnregisterProtocol(const std::string& scheme) {
+void Browser::PlatformUnregisterProtocol(const std::string& scheme) {
 #if defined(WEBVIEW2_SUPPORT)
   BrowserImplWebview2::UnregisterProtocol(base::UTF8ToUTF16(scheme));
 #endif
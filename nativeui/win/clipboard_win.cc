@@ -3,11 +3,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE.chromium file.
 
-#include "nativeui/clipboard.h"
+#include "nativeui/win/clipboard_win.h"
 
 #include <algorithm>
 
 #include "base/strings/utf_string_conversions.h"
+#include "nativeui/clipboard.h"
 #include "nativeui/gfx/win/gdiplus.h"
 #include "nativeui/win/drag_drop/clipboard_util.h"
 #include "nativeui/win/util/win32_window.h"
@@ -109,34 +110,7 @@ class ClipboardWindow : public Win32Window {
                             UINT message,
                             WPARAM w_param,
                             LPARAM l_param,
-                            LRESULT* result) override {
-    switch (message) {
-    case WM_RENDERFORMAT:
-      // This message comes when SetClipboardData was sent a null data handle
-      // and now it's come time to put the data on the clipboard.
-      // We always set data, so there isn't a need to actually do anything here.
-      break;
-    case WM_RENDERALLFORMATS:
-      // This message comes when SetClipboardData was sent a null data handle
-      // and now this application is about to quit, so it must put data on
-      // the clipboard before it exits.
-      // We always set data, so there isn't a need to actually do anything here.
-      break;
-    case WM_CLIPBOARDUPDATE:
-      delegate_->on_change.Emit(delegate_);
-      break;
-    case WM_DRAWCLIPBOARD:
-      break;
-    case WM_DESTROY:
-      break;
-    case WM_CHANGECBCHAIN:
-      break;
-    default:
-      return false;
-    }
-    *result = 0;
-    return true;
-  }
+                            LRESULT* result) override;
 
   Clipboard* delegate_;
 };
@@ -179,7 +153,11 @@ class ClipboardImpl {
   using Data = Clipboard::Data;
 
   explicit ClipboardImpl(Clipboard* delegate) : clipboard_owner_(delegate) {}
-  ~ClipboardImpl() {}
+  ~ClipboardImpl() {
+    // Put the promised data on clipboard before the provider goes away.
+    RenderAllFormats();
+    provider_ = nullptr;
+  }
 
   bool IsDataAvailable(Data::Type type) const {
     int cf_type = ToCFType(type);
@@ -223,42 +201,105 @@ class ClipboardImpl {
     return Data();
   }
 
+  int64_t GetDataSize(Data::Type type) const {
+    FORMATETC format = {0};
+    if (!GetStreamFormatEtc(type, &format))
+      return -1;
+    ScopedClipboard clipboard;
+    if (!clipboard.Acquire(clipboard_owner_.hwnd()))
+      return -1;
+    HANDLE data = ::GetClipboardData(format.cfFormat);
+    if (!data)
+      return -1;
+    return static_cast<int64_t>(::GlobalSize(data));
+  }
+
+  bool ReadData(Data::Type type, const Clipboard::DataReader& reader) const {
+    FORMATETC format = {0};
+    if (!GetStreamFormatEtc(type, &format))
+      return false;
+    ScopedClipboard clipboard;
+    if (!clipboard.Acquire(clipboard_owner_.hwnd()))
+      return false;
+    HANDLE data = ::GetClipboardData(format.cfFormat);
+    if (!data)
+      return false;
+    // The handle is owned by clipboard, do not release it.
+    STGMEDIUM medium = {0};
+    medium.tymed = TYMED_HGLOBAL;
+    medium.hGlobal = data;
+    return ReadStgMedium(type, medium, reader);
+  }
+
   void SetData(std::vector<Data> objects) {
     ScopedClipboard clipboard;
     if (!clipboard.Acquire(clipboard_owner_.hwnd()))
       return;
 
     ::EmptyClipboard();
+    provider_ = nullptr;
 
-    for (Data& data : objects) {
-      switch (data.type()) {
-        case Data::Type::Text:
-          WriteToClipboard(CF_UNICODETEXT,
-                           CreateGlobalData(base::UTF8ToUTF16(data.str())));
-          break;
-        case Data::Type::HTML:
-          WriteToClipboard(GetHTMLFormat(),
-                           CreateGlobalData(HtmlToCFHtml(data.str(), "")));
-          break;
-        case Data::Type::Image:
-          WriteToClipboard(CF_BITMAP, GetBitmapFromImage(data.image()));
-          break;
-        case Data::Type::FilePaths: {
-          STGMEDIUM* storage = GetStorageForFileNames(data.file_paths());
-          if (storage) {
-            WriteToClipboard(CF_HDROP, storage->hGlobal);
-            delete storage;
-          }
-          break;
-        }
-        case Data::Type::None:
-          break;
-        default:
-          NOTREACHED() << "Invalid type: " << static_cast<int>(data.type());
+    for (const Data& data : objects)
+      WriteData(data);
+  }
+
+  void SetDataProvider(const std::vector<Data::Type>& types,
+                       const Clipboard::DataProvider& provider) {
+    ScopedClipboard clipboard;
+    if (!clipboard.Acquire(clipboard_owner_.hwnd()))
+      return;
+
+    // Note that this sends WM_DESTROYCLIPBOARD to the previous owner, which
+    // may be ourselves.
+    ::EmptyClipboard();
+    provider_ = provider;
+    provided_types_ = types;
+
+    // Null handles promise the data, which is created on WM_RENDERFORMAT.
+    for (Data::Type type : types) {
+      if (type != Data::Type::None)
+        ::SetClipboardData(GetWriteFormat(type), nullptr);
+    }
+  }
+
+  // Create the promised data in |format|, the clipboard has been opened by
+  // the app asking for data.
+  void RenderFormat(UINT format) {
+    if (!provider_)
+      return;
+    for (Data::Type type : provided_types_) {
+      if (type != Data::Type::None && GetWriteFormat(type) == format) {
+        Data data = provider_(type);
+        if (data.type() == type)
+          WriteData(data);
+        return;
       }
     }
   }
 
+  // Create all the promised data before the clipboard owner is destroyed.
+  void RenderAllFormats() {
+    if (!provider_)
+      return;
+    ScopedClipboard clipboard;
+    if (!clipboard.Acquire(clipboard_owner_.hwnd()))
+      return;
+    // Another app may have taken the clipboard in the meantime.
+    if (::GetClipboardOwner() != clipboard_owner_.hwnd())
+      return;
+    for (Data::Type type : provided_types_) {
+      if (type != Data::Type::None)
+        RenderFormat(GetWriteFormat(type));
+    }
+    provider_ = nullptr;
+  }
+
+  // The clipboard has been emptied and we are no longer its owner.
+  void OnClipboardDestroyed() {
+    provider_ = nullptr;
+    provided_types_.clear();
+  }
+
   void StartWatching() {
     ::AddClipboardFormatListener(clipboard_owner_.hwnd());
   }
@@ -268,6 +309,43 @@ class ClipboardImpl {
   }
 
  private:
+  // Images are written as CF_BITMAP, from which system converts to other
+  // bitmap formats.
+  static UINT GetWriteFormat(Data::Type type) {
+    if (type == Data::Type::Image)
+      return CF_BITMAP;
+    return static_cast<UINT>(ToCFType(type));
+  }
+
+  // Write |data| to the opened clipboard.
+  void WriteData(const Data& data) {
+    switch (data.type()) {
+      case Data::Type::Text:
+        WriteToClipboard(CF_UNICODETEXT,
+                         CreateGlobalData(base::UTF8ToUTF16(data.str())));
+        break;
+      case Data::Type::HTML:
+        WriteToClipboard(GetHTMLFormat(),
+                         CreateGlobalData(HtmlToCFHtml(data.str(), "")));
+        break;
+      case Data::Type::Image:
+        WriteToClipboard(CF_BITMAP, GetBitmapFromImage(data.image()));
+        break;
+      case Data::Type::FilePaths: {
+        STGMEDIUM* storage = GetStorageForFileNames(data.file_paths());
+        if (storage) {
+          WriteToClipboard(CF_HDROP, storage->hGlobal);
+          delete storage;
+        }
+        break;
+      }
+      case Data::Type::None:
+        break;
+      default:
+        NOTREACHED() << "Invalid type: " << static_cast<int>(data.type());
+    }
+  }
+
   // Safely write to system clipboard. Free |handle| on failure.
   void WriteToClipboard(UINT format, HANDLE handle) {
     if (handle && !::SetClipboardData(format, handle)) {
@@ -349,11 +427,56 @@ class ClipboardImpl {
     return true;
   }
 
+  // The promised data that has not been put on clipboard, declared before
+  // |clipboard_owner_| as destroying the window may ask for rendering.
+  Clipboard::DataProvider provider_;
+  std::vector<Data::Type> provided_types_;
+
   ClipboardWindow clipboard_owner_;
 
   DISALLOW_COPY_AND_ASSIGN(ClipboardImpl);
 };
 
+bool ClipboardWindow::ProcessWindowMessage(HWND window,
+                                           UINT message,
+                                           WPARAM w_param,
+                                           LPARAM l_param,
+                                           LRESULT* result) {
+  switch (message) {
+  case WM_RENDERFORMAT:
+    // This message comes when SetClipboardData was sent a null data handle
+    // and now it's come time to put the data on the clipboard.
+    delegate_->GetNative()->RenderFormat(static_cast<UINT>(w_param));
+    break;
+  case WM_RENDERALLFORMATS:
+    // This message comes when SetClipboardData was sent a null data handle
+    // and now this application is about to quit, so it must put data on
+    // the clipboard before it exits.
+    delegate_->GetNative()->RenderAllFormats();
+    break;
+  case WM_DESTROYCLIPBOARD:
+    delegate_->GetNative()->OnClipboardDestroyed();
+    break;
+  case WM_CLIPBOARDUPDATE:
+    delegate_->on_change.Emit(delegate_);
+    break;
+  case WM_DRAWCLIPBOARD:
+    break;
+  case WM_DESTROY:
+    break;
+  case WM_CHANGECBCHAIN:
+    break;
+  default:
+    return false;
+  }
+  *result = 0;
+  return true;
+}
+
+void RenderAllClipboardFormats(Clipboard* clipboard) {
+  clipboard->GetNative()->RenderAllFormats();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Public Clipboard API implementation.
 
@@ -365,10 +488,16 @@ void Clipboard::PlatformDestroy() {
   delete clipboard_;
 }
 
-bool Clipboard::IsDataAvailable(Data::Type type) const {
+bool Clipboard::PlatformIsDataAvailable(Data::Type type) const {
   return clipboard_->IsDataAvailable(type);
 }
 
+int64_t Clipboard::PlatformGetChangeCount() const {
+  // Zero is returned when the clipboard can not be accessed.
+  DWORD sequence_number = ::GetClipboardSequenceNumber();
+  return sequence_number == 0 ? -1 : sequence_number;
+}
+
 Clipboard::Data Clipboard::GetData(Data::Type type) const {
   return clipboard_->GetData(type);
 }
@@ -377,6 +506,19 @@ void Clipboard::SetData(std::vector<Data> objects) {
   clipboard_->SetData(std::move(objects));
 }
 
+int64_t Clipboard::GetDataSize(Data::Type type) const {
+  return clipboard_->GetDataSize(type);
+}
+
+bool Clipboard::ReadData(Data::Type type, const DataReader& reader) const {
+  return clipboard_->ReadData(type, reader);
+}
+
+void Clipboard::SetDataProvider(const std::vector<Data::Type>& types,
+                                const DataProvider& provider) {
+  clipboard_->SetDataProvider(types, provider);
+}
+
 void Clipboard::PlatformStartWatching() {
   clipboard_->StartWatching();
 }
@@ -0,0 +1,18 @@
+// Copyright 2019 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_WIN_CLIPBOARD_WIN_H_
+#define NATIVEUI_WIN_CLIPBOARD_WIN_H_
+
+namespace nu {
+
+class Clipboard;
+
+// Put the data promised by |clipboard| on the system clipboard, the same as
+// what is done for WM_RENDERALLFORMATS.
+void RenderAllClipboardFormats(Clipboard* clipboard);
+
+}  // namespace nu
+
+#endif  // NATIVEUI_WIN_CLIPBOARD_WIN_H_
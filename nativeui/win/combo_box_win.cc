@@ -26,12 +26,14 @@ class ComboBoxImpl : public PickerImpl {
     }
   }
 
+  void set_setting_items(bool b) { is_setting_items_ = b; }
+
  protected:
   // PickerImpl:
   void OnCommand(UINT code, int command) override {
     ComboBox* combobox = static_cast<ComboBox*>(delegate());
-    if (code == CBN_EDITCHANGE)
-      combobox->on_text_change.Emit(combobox);
+    if (code == CBN_EDITCHANGE && !is_setting_items_)
+      combobox->NotifyTextChange();
     PickerImpl::OnCommand(code, command);
   }
 
@@ -50,6 +52,7 @@ class ComboBoxImpl : public PickerImpl {
   }
 
   WNDPROC proc_;
+  bool is_setting_items_ = false;
 };
 
 }  // namespace
@@ -78,4 +81,24 @@ void ComboBox::AddItem(const std::string& text) {
                 reinterpret_cast<LPARAM>(text16.c_str()));
 }
 
+void ComboBox::SetItems(const std::vector<std::string>& items) {
+  auto* combobox = static_cast<ComboBoxImpl*>(GetNative());
+  std::vector<base::string16> items16;
+  items16.reserve(items.size());
+  size_t size = 0;
+  for (const std::string& item : items) {
+    items16.emplace_back(base::UTF8ToUTF16(item));
+    size += (items16.back().size() + 1) * sizeof(wchar_t);
+  }
+  // Resetting the content clears the text, which is restored silently.
+  base::string16 text = GetWindowString(combobox->hwnd());
+  DWORD selection = ::SendMessage(combobox->hwnd(), CB_GETEDITSEL, 0, 0L);
+  combobox->set_setting_items(true);
+  combobox->SetItems(items16, size);
+  ::SetWindowTextW(combobox->hwnd(), text.c_str());
+  ::SendMessage(combobox->hwnd(), CB_SETEDITSEL, 0,
+                MAKELPARAM(LOWORD(selection), HIWORD(selection)));
+  combobox->set_setting_items(false);
+}
+
 }  // namespace nu
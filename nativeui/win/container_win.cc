@@ -4,19 +4,47 @@
 
 #include "nativeui/win/container_win.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "base/auto_reset.h"
 #include "base/stl_util.h"
 #include "nativeui/events/win/event_win.h"
+#include "nativeui/gfx/win/painter_d2d.h"
 #include "nativeui/gfx/win/painter_win.h"
+#include "nativeui/paint_stats.h"
+#include "nativeui/win/window_win.h"
 
 namespace nu {
 
+namespace {
+
+// Containers with fewer children are searched linearly.
+const size_t kMinChildrenForGrid = 64;
+
+// Only the topmost opaque children are checked when culling.
+const size_t kMaxOccluders = 8;
+
+}  // namespace
+
 ContainerImpl::ContainerImpl(View* delegate, Adapter* adapter, ControlType type)
     : ViewImpl(type, delegate), adapter_(adapter) {}
 
 void ContainerImpl::SizeAllocate(const Rect& size_allocation) {
+  // Children are moved together with the layer.
+  base::AutoReset<bool> auto_reset(&layer_moving_,
+                                   IsMovingLayer(size_allocation));
   ViewImpl::SizeAllocate(size_allocation);
-  if (!size_allocation.size().IsEmpty())
-    adapter_->Layout();
+  if (size_allocation.size().IsEmpty())
+    return;
+  // Move the sub windows of all descendants in one batch.
+  WindowImpl* win = window();
+  if (win)
+    win->BeginChildMoves();
+  adapter_->Layout();
+  if (win)
+    win->EndChildMoves();
 }
 
 UINT ContainerImpl::HitTest(const Point& point) const {
@@ -38,10 +66,8 @@ void ContainerImpl::BecomeContentView(WindowImpl* parent) {
 
 void ContainerImpl::VisibilityChanged() {
   ViewImpl::VisibilityChanged();
-  adapter_->ForEach([=](ViewImpl* child) {
+  for (ViewImpl* child : adapter_->GetChildren())
     child->VisibilityChanged();
-    return true;
-  });
 }
 
 void ContainerImpl::Draw(PainterWin* painter, const Rect& dirty) {
@@ -49,17 +75,49 @@ void ContainerImpl::Draw(PainterWin* painter, const Rect& dirty) {
     return;
   ViewImpl::Draw(painter, dirty);
   adapter_->OnDraw(painter, dirty);
-  adapter_->ForEach([&](ViewImpl* child) {
-    DrawChild(child, painter, dirty);
-    return true;
-  });
+
+  // Children are painted in order, so walk backwards and skip the children
+  // that are covered by opaque siblings painted after them.
+  const std::vector<ViewImpl*>& children = adapter_->GetChildren();
+  Vector2d offset = size_allocation().OffsetFromOrigin();
+  Rect window_dirty = dirty + offset;
+  Rect occluders[kMaxOccluders];
+  size_t occluders_count = 0;
+  child_dirty_rects_.assign(children.size(), Rect());
+  for (size_t i = children.size(); i-- > 0;) {
+    ViewImpl* child = children[i];
+    // Check the bounds first, which is cheaper than computing clipped rect.
+    if (!child->is_visible() ||
+        !child->size_allocation().Intersects(window_dirty))
+      continue;
+    Rect rect = child->GetClippedRect();
+    rect.Intersect(window_dirty);
+    if (rect.IsEmpty() ||
+        std::any_of(occluders, occluders + occluders_count,
+                    [&rect](const Rect& r) { return r.Contains(rect); }))
+      continue;
+    if (occluders_count < kMaxOccluders && child->IsOpaque())
+      occluders[occluders_count++] = rect;
+    child_dirty_rects_[i] = rect - offset;
+  }
+
+  for (size_t i = 0; i < children.size(); ++i) {
+    if (!child_dirty_rects_[i].IsEmpty())
+      PaintChild(children[i], painter, child_dirty_rects_[i]);
+  }
 }
 
-void ContainerImpl::OnDPIChanged() {
-  adapter_->ForEach([=](ViewImpl* child) {
-    child->OnDPIChanged();
-    return true;
-  });
+void ContainerImpl::OnChildChanged() {
+  child_grid_dirty_ = true;
+}
+
+void ContainerImpl::UpdateScaleFactor(float scale_factor) {
+  for (ViewImpl* child : adapter_->GetChildren())
+    child->UpdateScaleFactor(scale_factor);
+  OnChildChanged();
+  // Children are updated first so they are ready when this view re-measures
+  // itself in OnDPIChanged.
+  ViewImpl::UpdateScaleFactor(scale_factor);
 }
 
 void ContainerImpl::OnMouseMove(NativeEvent event) {
@@ -69,7 +127,7 @@ void ContainerImpl::OnMouseMove(NativeEvent event) {
 
   // Emit mouse enter/leave events
   if (hover_view_ != hover_view) {
-    if (hover_view_ && adapter_->HasChild(hover_view_))
+    if (hover_view_ && IsChild(hover_view_))
       hover_view_->OnMouseLeave(event);
     hover_view_ = hover_view;
     if (hover_view_)
@@ -84,7 +142,7 @@ void ContainerImpl::OnMouseMove(NativeEvent event) {
 
 void ContainerImpl::OnMouseLeave(NativeEvent event) {
   if (hover_view_) {
-    if (adapter_->HasChild(hover_view_))
+    if (IsChild(hover_view_))
       hover_view_->OnMouseLeave(event);
     hover_view_ = nullptr;
   }
@@ -120,7 +178,7 @@ int ContainerImpl::OnDragUpdate(IDataObject* data,
 
   // Emit drag enter/leave events
   if (dragging_dest_ != dragging_dest) {
-    if (dragging_dest_ && adapter_->HasChild(dragging_dest_))
+    if (dragging_dest_ && IsChild(dragging_dest_))
       dragging_dest_->OnDragLeave(data);
     dragging_dest_ = dragging_dest;
     if (dragging_dest_) {
@@ -141,7 +199,7 @@ int ContainerImpl::OnDragUpdate(IDataObject* data,
 
 void ContainerImpl::OnDragLeave(IDataObject* data) {
   if (dragging_dest_) {
-    if (adapter_->HasChild(dragging_dest_))
+    if (IsChild(dragging_dest_))
       dragging_dest_->OnDragLeave(data);
     dragging_dest_ = nullptr;
   }
@@ -172,37 +230,101 @@ void ContainerImpl::DrawChild(ViewImpl* child, PainterWin* painter,
   child_dirty.Intersect(dirty);
   if (child_dirty.IsEmpty())
     return;
+  PaintChild(child, painter, child_dirty);
+}
 
+void ContainerImpl::PaintChild(ViewImpl* child, PainterWin* painter,
+                               const Rect& child_dirty) {
   // Move the painting origin for child.
   Vector2d child_origin = child->size_allocation().OffsetFromOrigin() -
                           size_allocation().OffsetFromOrigin();
   painter->SaveWithSize(child->size_allocation().size());
   painter->TranslatePixel(child_origin);
   painter->ClipRectPixel(Rect(child->size_allocation().size()));
-  child->Draw(painter, child_dirty - child_origin);
+  if (child->delegate())
+    ScopedPaintTimer::CountView(child->delegate());
+  if (child->is_layer_backed())
+    child->DrawLayer(painter, child_dirty - child_origin);
+  else
+    child->Draw(painter, child_dirty - child_origin);
   painter->Restore();
 }
 
 void ContainerImpl::RefreshParentTree() {
-  adapter_->ForEach([this](ViewImpl* child) {
+  for (ViewImpl* child : adapter_->GetChildren())
     child->SetParent(this);
-    return true;
-  });
 }
 
 ViewImpl* ContainerImpl::FindChildFromPoint(const Point& point) const {
-  ViewImpl* result = nullptr;
-  adapter_->ForEach([&](ViewImpl* child) {
-    if (!child->is_visible())
-      return true;
-    Rect child_rect = child->GetClippedRect();
-    if (child_rect.Contains(point)) {
-      result = child;
-      return false;
+  if (child_grid_dirty_)
+    BuildChildGrid();
+  if (!grid_cells_.empty()) {
+    // Children are clipped by the container, so the point must be inside.
+    Point relative = point - size_allocation().OffsetFromOrigin();
+    if (!Rect(size_allocation().size()).Contains(relative))
+      return nullptr;
+    int column = relative.x() / grid_cell_size_.width();
+    int row = relative.y() / grid_cell_size_.height();
+    for (ViewImpl* child : grid_cells_[row * grid_columns_ + column]) {
+      if (child->is_visible() && child->GetClippedRect().Contains(point))
+        return child;
     }
-    return true;
-  });
-  return result;
+    return nullptr;
+  }
+
+  for (ViewImpl* child : adapter_->GetChildren()) {
+    if (child->is_visible() && child->GetClippedRect().Contains(point))
+      return child;
+  }
+  return nullptr;
+}
+
+bool ContainerImpl::IsChild(ViewImpl* child) const {
+  if (child_grid_dirty_)
+    BuildChildGrid();
+  if (!grid_cells_.empty())
+    return std::binary_search(grid_children_.begin(), grid_children_.end(),
+                              child);
+  return adapter_->HasChild(child);
+}
+
+void ContainerImpl::BuildChildGrid() const {
+  child_grid_dirty_ = false;
+  grid_cells_.clear();
+  grid_children_.clear();
+  std::vector<ViewImpl*> children = adapter_->GetChildren();
+  Size size = size_allocation().size();
+  if (children.size() < kMinChildrenForGrid || size.IsEmpty())
+    return;
+
+  // Aim for a few children in each cell.
+  double cells = children.size() / 4;
+  int cell_length = std::max(1, static_cast<int>(std::sqrt(
+      static_cast<double>(size.width()) * size.height() / cells)));
+  grid_cell_size_ = Size(cell_length, cell_length);
+  grid_columns_ = (size.width() + cell_length - 1) / cell_length;
+  int rows = (size.height() + cell_length - 1) / cell_length;
+  grid_cells_.resize(grid_columns_ * rows);
+
+  // Children are added in order, so the first match in a cell is the same
+  // with the linear search.
+  Vector2d origin = size_allocation().OffsetFromOrigin();
+  for (ViewImpl* child : children) {
+    Rect rect = child->size_allocation() - origin;
+    rect.Intersect(Rect(size));
+    if (rect.IsEmpty())
+      continue;
+    int first_column = rect.x() / cell_length;
+    int last_column = (rect.right() - 1) / cell_length;
+    int first_row = rect.y() / cell_length;
+    int last_row = (rect.bottom() - 1) / cell_length;
+    for (int row = first_row; row <= last_row; ++row) {
+      for (int column = first_column; column <= last_column; ++column)
+        grid_cells_[row * grid_columns_ + column].push_back(child);
+    }
+  }
+  grid_children_ = std::move(children);
+  std::sort(grid_children_.begin(), grid_children_.end());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -216,44 +338,74 @@ class ContainerAdapter : public ContainerImpl,
   explicit ContainerAdapter(Container* container)
       : ContainerImpl(container, this), container_(container) {}
 
+  void ChildrenChanged() {
+    children_dirty_ = true;
+  }
+
   // ContainerImpl::Adapter:
   void Layout() override {
     container_->SetChildBoundsFromCSS();
   }
 
-  void ForEach(const std::function<bool(ViewImpl*)>& callback,
-               bool reverse) override {
-    if (container_->ChildCount() == 0)
-      return;
-    for (int i = reverse ? container_->ChildCount() - 1 : 0;
-         reverse ? (i >= 0) : (i < container_->ChildCount());
-         reverse ? --i : ++i) {
-      if (!callback(container_->ChildAt(i)->GetNative()))
-        break;
+  const std::vector<ViewImpl*>& GetChildren() override {
+    if (children_dirty_) {
+      children_dirty_ = false;
+      children_.clear();
+      children_.reserve(container_->ChildCount());
+      for (int i = 0; i < container_->ChildCount(); ++i)
+        children_.push_back(container_->ChildAt(i)->GetNative());
     }
+    return children_;
   }
 
   bool HasChild(ViewImpl* child) override {
-    for (int i = 0; i < container_->ChildCount(); ++i) {
-      if (child == container_->ChildAt(i)->GetNative())
-        return true;
-    }
-    return false;
+    const std::vector<ViewImpl*>& children = GetChildren();
+    return std::find(children.begin(), children.end(), child) !=
+           children.end();
   }
 
   void OnDraw(PainterWin* painter, const Rect& dirty) override {
-    if (container_->on_draw.IsEmpty())
+    if (!container_->HasCustomDraw())
+      return;
+    if (window() && window()->direct2d()) {
+      DrawWithDirect2D(painter, dirty);
       return;
+    }
     painter->Save();
     painter->ClipRectPixel(Rect(size_allocation().size()));
     float scale_factor = container_->GetNative()->scale_factor();
-    container_->on_draw.Emit(container_, static_cast<Painter*>(painter),
-                             ScaleRect(RectF(dirty), 1.0f / scale_factor));
+    container_->DrawCustomContent(painter,
+                                  ScaleRect(RectF(dirty), 1.0f / scale_factor));
     painter->Restore();
   }
 
  private:
+  // Bind a Direct2D painter to the visible part of the container.
+  void DrawWithDirect2D(PainterWin* painter, const Rect& dirty) {
+    Rect rect(size_allocation().size());
+    rect.Intersect(dirty);
+    rect.Intersect(painter->GetClipBoundsPixel());
+    if (rect.IsEmpty())
+      return;
+    float scale_factor = container_->GetNative()->scale_factor();
+    Rect target_rect = rect + painter->GetTranslationPixel();
+    HDC hdc = painter->GetRawHDC();
+    {
+      PainterD2D d2d(hdc, target_rect, scale_factor, true);
+      // Keep the coordinates relative to the container.
+      d2d.Translate(ScaleVector2d(-rect.OffsetFromOrigin(),
+                                  1.0f / scale_factor));
+      container_->DrawCustomContent(
+          &d2d, ScaleRect(RectF(dirty), 1.0f / scale_factor));
+    }
+    painter->ReleaseRawHDC(hdc);
+  }
+
   Container* container_;
+
+  // The natives of children, rebuilt after children are added or removed.
+  bool children_dirty_ = true;
+  std::vector<ViewImpl*> children_;
 };
 
 }  // namespace
@@ -269,10 +421,12 @@ void Container::PlatformDestroy() {
 }
 
 void Container::PlatformAddChildView(View* child) {
+  static_cast<ContainerAdapter*>(GetNative())->ChildrenChanged();
   child->GetNative()->SetParent(GetNative());
 }
 
 void Container::PlatformRemoveChildView(View* child) {
+  static_cast<ContainerAdapter*>(GetNative())->ChildrenChanged();
   child->GetNative()->SetParent(nullptr);
 }
 
@@ -5,7 +5,6 @@
 #ifndef NATIVEUI_WIN_CONTAINER_WIN_H_
 #define NATIVEUI_WIN_CONTAINER_WIN_H_
 
-#include <functional>
 #include <vector>
 
 #include "nativeui/container.h"
@@ -21,8 +20,10 @@ class ContainerImpl : public ViewImpl {
     virtual ~Adapter() = default;
 
     virtual void Layout() = 0;
-    virtual void ForEach(const std::function<bool(ViewImpl*)>& callback,
-                         bool reverse = false) = 0;
+    // Return the children in painting order, which are stored contiguously
+    // so traversals do not go through callbacks. The vector is only valid
+    // until children are changed.
+    virtual const std::vector<ViewImpl*>& GetChildren() = 0;
     virtual bool HasChild(ViewImpl* child) = 0;
     virtual void OnDraw(PainterWin* painter, const Rect& dirty) {}
   };
@@ -37,7 +38,8 @@ class ContainerImpl : public ViewImpl {
   void BecomeContentView(WindowImpl* parent) override;
   void VisibilityChanged() override;
   void Draw(PainterWin* painter, const Rect& dirty) override;
-  void OnDPIChanged() override;
+  void OnChildChanged() override;
+  void UpdateScaleFactor(float scale_factor) override;
   void OnMouseMove(NativeEvent event) override;
   void OnMouseLeave(NativeEvent event) override;
   bool OnMouseWheel(NativeEvent event) override;
@@ -53,11 +55,32 @@ class ContainerImpl : public ViewImpl {
   void DrawChild(ViewImpl* child, PainterWin* painter, const Rect& dirty);
 
  private:
+  // Paint |child| in its |child_dirty| rect, relative to the container.
+  void PaintChild(ViewImpl* child, PainterWin* painter,
+                  const Rect& child_dirty);
+
   void RefreshParentTree();
   ViewImpl* FindChildFromPoint(const Point& point) const;
+  bool IsChild(ViewImpl* child) const;
+  void BuildChildGrid() const;
 
   Adapter* adapter_;
 
+  // The dirty rects of children computed in Draw, empty for the children
+  // that are clipped away or covered by opaque siblings.
+  std::vector<Rect> child_dirty_rects_;
+
+  // Children of large containers are put into the cells of a grid by their
+  // bounds relative to the container, so finding the child under mouse only
+  // checks the children in one cell. The grid is rebuilt lazily after any
+  // child is moved, added or removed.
+  mutable bool child_grid_dirty_ = true;
+  mutable Size grid_cell_size_;
+  mutable int grid_columns_ = 0;
+  mutable std::vector<std::vector<ViewImpl*>> grid_cells_;
+  // Sorted addresses of children when the grid is used.
+  mutable std::vector<ViewImpl*> grid_children_;
+
   // The View in which mouse hovers.
   ViewImpl* hover_view_ = nullptr;
 
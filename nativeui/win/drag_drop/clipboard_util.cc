@@ -10,9 +10,12 @@
 #include <shlobj.h>
 #include <shobjidl.h>
 
+#include <algorithm>
+
 #include "base/files/file_path.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
 #include "base/win/scoped_hglobal.h"
 #include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/painter.h"
@@ -21,6 +24,159 @@
 
 namespace nu {
 
+namespace {
+
+// Read bytes from a STGMEDIUM sequentially.
+class StgMediumReader {
+ public:
+  explicit StgMediumReader(const STGMEDIUM& medium) : medium_(medium) {
+    if (medium_.tymed == TYMED_HGLOBAL) {
+      data_ = static_cast<const char*>(::GlobalLock(medium_.hGlobal));
+      if (data_)
+        size_ = ::GlobalSize(medium_.hGlobal);
+    } else if (medium_.tymed == TYMED_ISTREAM && medium_.pstm) {
+      LARGE_INTEGER zero = {0};
+      medium_.pstm->Seek(zero, STREAM_SEEK_SET, nullptr);
+    }
+  }
+
+  ~StgMediumReader() {
+    if (data_)
+      ::GlobalUnlock(medium_.hGlobal);
+  }
+
+  // Fill |buf| with at most |size| bytes, return 0 at the end of data.
+  size_t Read(char* buf, size_t size) {
+    if (data_) {
+      size_t nread = std::min(size, size_ - pos_);
+      memcpy(buf, data_ + pos_, nread);
+      pos_ += nread;
+      return nread;
+    }
+    if (medium_.tymed != TYMED_ISTREAM || !medium_.pstm)
+      return 0;
+    // Streams may return less data than requested before the end.
+    size_t total = 0;
+    while (total < size) {
+      ULONG nread = 0;
+      HRESULT hr = medium_.pstm->Read(buf + total,
+                                      static_cast<ULONG>(size - total),
+                                      &nread);
+      if (FAILED(hr) || nread == 0)
+        break;
+      total += nread;
+    }
+    return total;
+  }
+
+ private:
+  const STGMEDIUM& medium_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+};
+
+// Convert UTF-16 text to UTF-8 chunk by chunk.
+bool ReadText(StgMediumReader* medium, const Clipboard::DataReader& reader) {
+  std::vector<char> buf(Clipboard::kDataChunkSize);
+  size_t kept = 0;
+  while (true) {
+    size_t nread = medium->Read(buf.data() + kept, buf.size() - kept);
+    size_t total = kept + nread;
+    const base::char16* text = reinterpret_cast<base::char16*>(buf.data());
+    size_t units = total / sizeof(base::char16);
+    // Text on clipboard ends with null character.
+    size_t length = std::find(text, text + units, 0) - text;
+    bool end = nread == 0 || length < units;
+    // Do not split surrogate pairs between chunks.
+    if (!end && length > 0 && (text[length - 1] & 0xFC00) == 0xD800)
+      --length;
+    std::string utf8 = base::UTF16ToUTF8(base::StringPiece16(text, length));
+    if (!utf8.empty() && !reader(utf8.data(), utf8.size()))
+      return false;
+    if (end)
+      return true;
+    kept = total - length * sizeof(base::char16);
+    memmove(buf.data(), buf.data() + length * sizeof(base::char16), kept);
+  }
+}
+
+// Read the fragment of CF_HTML, whose range is written in the header.
+bool ReadHTML(StgMediumReader* medium, const Clipboard::DataReader& reader) {
+  std::vector<char> buf(Clipboard::kDataChunkSize);
+  size_t nread = medium->Read(buf.data(), buf.size());
+  std::string header(buf.data(), nread);
+  static constexpr char kStartFragmentStr[] = "StartFragment:";
+  static constexpr char kEndFragmentStr[] = "EndFragment:";
+  size_t start_pos = header.find(kStartFragmentStr);
+  size_t end_pos = header.find(kEndFragmentStr);
+  if (start_pos == std::string::npos || end_pos == std::string::npos)
+    return false;
+  size_t start = static_cast<size_t>(
+      atoi(header.c_str() + start_pos + strlen(kStartFragmentStr)));
+  size_t end = static_cast<size_t>(
+      atoi(header.c_str() + end_pos + strlen(kEndFragmentStr)));
+  if (start >= end)
+    return false;
+  size_t offset = 0;
+  while (nread > 0 && offset < end) {
+    size_t from = std::max(start, offset);
+    size_t to = std::min(end, offset + nread);
+    if (from < to && !reader(buf.data() + from - offset, to - from))
+      return false;
+    offset += nread;
+    nread = medium->Read(buf.data(), buf.size());
+  }
+  return true;
+}
+
+// Return the number of entries in the color table of DIB.
+int GetDIBColorTableLength(const BITMAPINFOHEADER& header) {
+  switch (header.biBitCount) {
+    case 1:
+    case 4:
+    case 8:
+      return header.biClrUsed ? header.biClrUsed : 1 << header.biBitCount;
+    case 16:
+    case 32:
+      // The masks follow BITMAPINFOHEADER, and are part of newer headers.
+      if (header.biCompression == BI_BITFIELDS &&
+          header.biSize == sizeof(BITMAPINFOHEADER))
+        return 3;
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+// Prepend a file header to CF_DIB, so it is read as a BMP file.
+bool ReadImage(StgMediumReader* medium,
+               int64_t size,
+               const Clipboard::DataReader& reader) {
+  std::vector<char> buf(Clipboard::kDataChunkSize);
+  size_t nread = medium->Read(buf.data(), buf.size());
+  if (nread < sizeof(BITMAPINFOHEADER))
+    return false;
+  const BITMAPINFOHEADER& header =
+      *reinterpret_cast<BITMAPINFOHEADER*>(buf.data());
+  BITMAPFILEHEADER file_header = {0};
+  file_header.bfType = 0x4D42;  // "BM"
+  if (size > 0)
+    file_header.bfSize = static_cast<DWORD>(sizeof(file_header) + size);
+  file_header.bfOffBits = static_cast<DWORD>(
+      sizeof(file_header) + header.biSize +
+      GetDIBColorTableLength(header) * sizeof(RGBQUAD));
+  if (!reader(reinterpret_cast<char*>(&file_header), sizeof(file_header)))
+    return false;
+  do {
+    if (!reader(buf.data(), nread))
+      return false;
+  } while ((nread = medium->Read(buf.data(), buf.size())) > 0);
+  return true;
+}
+
+}  // namespace
+
 int ToCFType(Clipboard::Data::Type type) {
   switch (type) {
     case Clipboard::Data::Type::Text:
@@ -59,6 +215,53 @@ bool GetFormatEtc(Clipboard::Data::Type type, FORMATETC* format) {
   return true;
 }
 
+bool GetStreamFormatEtc(Clipboard::Data::Type type, FORMATETC* format) {
+  switch (type) {
+    case Clipboard::Data::Type::Text:
+      format->cfFormat = CF_UNICODETEXT;
+      break;
+    case Clipboard::Data::Type::HTML:
+      format->cfFormat = static_cast<CLIPFORMAT>(GetHTMLFormat());
+      break;
+    case Clipboard::Data::Type::Image:
+      format->cfFormat = CF_DIB;
+      break;
+    default:
+      return false;
+  }
+  format->dwAspect = DVASPECT_CONTENT;
+  format->lindex = -1;
+  format->tymed = TYMED_HGLOBAL | TYMED_ISTREAM;
+  return true;
+}
+
+int64_t GetStgMediumSize(const STGMEDIUM& medium) {
+  if (medium.tymed == TYMED_HGLOBAL && medium.hGlobal)
+    return static_cast<int64_t>(::GlobalSize(medium.hGlobal));
+  if (medium.tymed == TYMED_ISTREAM && medium.pstm) {
+    STATSTG stat = {0};
+    if (SUCCEEDED(medium.pstm->Stat(&stat, STATFLAG_NONAME)))
+      return static_cast<int64_t>(stat.cbSize.QuadPart);
+  }
+  return -1;
+}
+
+bool ReadStgMedium(Clipboard::Data::Type type,
+                   const STGMEDIUM& medium,
+                   const Clipboard::DataReader& reader) {
+  StgMediumReader medium_reader(medium);
+  switch (type) {
+    case Clipboard::Data::Type::Text:
+      return ReadText(&medium_reader, reader);
+    case Clipboard::Data::Type::HTML:
+      return ReadHTML(&medium_reader, reader);
+    case Clipboard::Data::Type::Image:
+      return ReadImage(&medium_reader, GetStgMediumSize(medium), reader);
+    default:
+      return false;
+  }
+}
+
 void GetFilePathsFromHDrop(HDROP drop, std::vector<base::FilePath>* result) {
   const int kMaxFilenameLen = 4096;
   const unsigned num_files = ::DragQueryFileW(drop, 0xffffffff, 0, 0);
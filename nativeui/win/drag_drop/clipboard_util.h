@@ -26,6 +26,18 @@ UINT GetHTMLFormat();
 // Fill the format according to type.
 bool GetFormatEtc(Clipboard::Data::Type type, FORMATETC* format);
 
+// Fill the format used for reading undecoded data of type, which accepts both
+// global memory and streams.
+bool GetStreamFormatEtc(Clipboard::Data::Type type, FORMATETC* format);
+
+// Return the size of data in |medium|, or -1 if it is unknown.
+int64_t GetStgMediumSize(const STGMEDIUM& medium);
+
+// Read the data of |type| in |medium| in chunks, as Clipboard::ReadData.
+bool ReadStgMedium(Clipboard::Data::Type type,
+                   const STGMEDIUM& medium,
+                   const Clipboard::DataReader& reader);
+
 // Read filenames from HDROP.
 void GetFilePathsFromHDrop(HDROP drop, std::vector<base::FilePath>* result);
 
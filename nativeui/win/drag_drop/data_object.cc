@@ -5,6 +5,8 @@
 
 #include "nativeui/win/drag_drop/data_object.h"
 
+#include <shlwapi.h>
+
 #include <algorithm>
 #include <iterator>
 #include <string>
@@ -40,6 +42,41 @@ STGMEDIUM* GetStorageForString(const std::basic_string<T>& data) {
       (data.size() + 1) * sizeof(typename std::basic_string<T>::value_type));
 }
 
+// Describe the promised files with their names.
+STGMEDIUM* GetStorageForFileDescriptors(
+    const std::vector<FilePromise>& file_promises) {
+  size_t bytes = sizeof(FILEGROUPDESCRIPTORW) +
+                 (file_promises.size() - 1) * sizeof(FILEDESCRIPTORW);
+  HANDLE handle = GlobalAlloc(GPTR, bytes);
+  if (handle) {
+    base::win::ScopedHGlobal<FILEGROUPDESCRIPTORW*> group(handle);
+    group->cItems = static_cast<UINT>(file_promises.size());
+    for (size_t i = 0; i < file_promises.size(); ++i) {
+      FILEDESCRIPTORW& descriptor = group->fgd[i];
+      descriptor.dwFlags = FD_PROGRESSUI;
+      wcsncpy_s(descriptor.cFileName, MAX_PATH,
+                file_promises[i].file_name.BaseName().value().c_str(),
+                _TRUNCATE);
+    }
+  }
+
+  STGMEDIUM* storage = new STGMEDIUM;
+  storage->hGlobal = handle;
+  storage->tymed = TYMED_HGLOBAL;
+  storage->pUnkForRelease = NULL;
+  return storage;
+}
+
+UINT GetFileDescriptorFormat() {
+  static UINT format = ::RegisterClipboardFormat(CFSTR_FILEDESCRIPTORW);
+  return format;
+}
+
+UINT GetFileContentsFormat() {
+  static UINT format = ::RegisterClipboardFormat(CFSTR_FILECONTENTS);
+  return format;
+}
+
 STGMEDIUM* GetStorageForImage(Image* image) {
   STGMEDIUM* storage = new STGMEDIUM;
   storage->hBitmap = GetBitmapFromImage(image);
@@ -294,7 +331,7 @@ StoredDataInfo::StoredDataInfo(StoredDataInfo&& other) : owns_medium(false) {
 }
 
 StoredDataInfo::~StoredDataInfo() {
-  if (owns_medium) {
+  if (owns_medium && medium) {
     ReleaseStgMedium(medium);
     delete medium;
   }
@@ -313,7 +350,10 @@ StoredDataInfo& StoredDataInfo::operator=(StoredDataInfo&& other) {
 ///////////////////////////////////////////////////////////////////////////////
 // DataObject implementation:
 
-DataObject::DataObject(std::vector<Clipboard::Data> objects) {
+DataObject::DataObject(std::vector<Clipboard::Data> objects,
+                       std::vector<FilePromise> file_promises)
+    : file_promises_(std::move(file_promises)),
+      written_(file_promises_.size(), false) {
   using Data = Clipboard::Data;
 
   for (auto& data : objects) {
@@ -346,6 +386,24 @@ DataObject::DataObject(std::vector<Clipboard::Data> objects) {
         NOTREACHED() << "Invalid type: " << static_cast<int>(data.type());
     }
   }
+
+  if (!file_promises_.empty()) {
+    FORMATETC format = {0};
+    format.cfFormat = static_cast<CLIPFORMAT>(GetFileDescriptorFormat());
+    format.dwAspect = DVASPECT_CONTENT;
+    format.lindex = -1;
+    format.tymed = TYMED_HGLOBAL;
+    contents_.emplace_back(format,
+                           GetStorageForFileDescriptors(file_promises_));
+    // The contents are created on request.
+    for (size_t i = 0; i < file_promises_.size(); ++i) {
+      format.cfFormat = static_cast<CLIPFORMAT>(GetFileContentsFormat());
+      format.lindex = static_cast<LONG>(i);
+      format.tymed = TYMED_ISTREAM;
+      contents_.emplace_back(format, nullptr);
+    }
+    async_mode_ = true;
+  }
 }
 
 DataObject::~DataObject() {}
@@ -366,10 +424,46 @@ void DataObject::RemoveData(const FORMATETC& format) {
   }
 }
 
+HRESULT DataObject::GetFileContents(LONG index, STGMEDIUM* medium) {
+  if (index < 0 || index >= static_cast<LONG>(file_promises_.size()))
+    return DV_E_LINDEX;
+
+  base::FilePath path;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (!temp_dir_.IsValid() && !temp_dir_.CreateUniqueTempDir())
+      return E_FAIL;
+    const FilePromise& promise = file_promises_[index];
+    path = temp_dir_.GetPath().Append(promise.file_name.BaseName());
+    // Targets may ask for the same file more than once.
+    if (!written_[index]) {
+      if (!promise.writer || !promise.writer(path))
+        return E_FAIL;
+      written_[index] = true;
+    }
+  }
+
+  IStream* stream = nullptr;
+  HRESULT hr = SHCreateStreamOnFileEx(path.value().c_str(),
+                                      STGM_READ | STGM_SHARE_DENY_WRITE,
+                                      FILE_ATTRIBUTE_NORMAL, FALSE, nullptr,
+                                      &stream);
+  if (FAILED(hr))
+    return hr;
+  medium->tymed = TYMED_ISTREAM;
+  medium->pstm = stream;
+  medium->pUnkForRelease = nullptr;
+  return S_OK;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // DataObject, IDataObject implementation:
 
 HRESULT DataObject::GetData(FORMATETC* format_etc, STGMEDIUM* medium) {
+  if (format_etc->cfFormat == GetFileContentsFormat() &&
+      (format_etc->tymed & TYMED_ISTREAM))
+    return GetFileContents(format_etc->lindex, medium);
+
   for (const StoredDataInfo& content : contents_) {
     if (content.format_etc.cfFormat == format_etc->cfFormat &&
         content.format_etc.lindex == format_etc->lindex &&
@@ -445,6 +539,40 @@ HRESULT DataObject::EnumDAdvise(IEnumSTATDATA** enumerator) {
   return OLE_E_ADVISENOTSUPPORTED;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// DataObject, IDataObjectAsyncCapability implementation:
+
+HRESULT DataObject::SetAsyncMode(BOOL do_op_async) {
+  async_mode_ = !!do_op_async;
+  return S_OK;
+}
+
+HRESULT DataObject::GetAsyncMode(BOOL* is_op_async) {
+  if (!is_op_async)
+    return E_POINTER;
+  *is_op_async = async_mode_;
+  return S_OK;
+}
+
+HRESULT DataObject::StartOperation(IBindCtx* reserved) {
+  in_operation_ = true;
+  return S_OK;
+}
+
+HRESULT DataObject::InOperation(BOOL* in_async_op) {
+  if (!in_async_op)
+    return E_POINTER;
+  *in_async_op = in_operation_;
+  return S_OK;
+}
+
+HRESULT DataObject::EndOperation(HRESULT result,
+                                 IBindCtx* reserved,
+                                 DWORD effects) {
+  in_operation_ = false;
+  return S_OK;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // DataObject, IUnknown implementation:
 
@@ -453,6 +581,8 @@ HRESULT DataObject::QueryInterface(const IID& iid, void** object) {
     return E_POINTER;
   if (IsEqualIID(iid, IID_IDataObject) || IsEqualIID(iid, IID_IUnknown)) {
     *object = static_cast<IDataObject*>(this);
+  } else if (IsEqualIID(iid, __uuidof(IDataObjectAsyncCapability))) {
+    *object = static_cast<IDataObjectAsyncCapability*>(this);
   } else {
     *object = NULL;
     return E_NOINTERFACE;
@@ -461,16 +591,17 @@ HRESULT DataObject::QueryInterface(const IID& iid, void** object) {
   return S_OK;
 }
 
+// The promised files may be read in worker threads, so the reference count
+// is changed atomically.
 ULONG DataObject::AddRef() {
-  return ++ref_count_;
+  return InterlockedIncrement(&ref_count_);
 }
 
 ULONG DataObject::Release() {
-  if (--ref_count_ == 0) {
+  ULONG ref_count = InterlockedDecrement(&ref_count_);
+  if (ref_count == 0)
     delete this;
-    return 0U;
-  }
-  return ref_count_;
+  return ref_count;
 }
 
 }  // namespace nu
@@ -11,7 +11,10 @@
 
 #include <vector>
 
+#include "base/files/scoped_temp_dir.h"
+#include "base/synchronization/lock.h"
 #include "nativeui/clipboard.h"
+#include "nativeui/dragging_info.h"
 
 namespace nu {
 
@@ -29,9 +32,14 @@ struct StoredDataInfo {
 };
 
 // Provide data to drag and drop.
-class DataObject : public IDataObject {
+//
+// Promised files are provided as CFSTR_FILEDESCRIPTOR and CFSTR_FILECONTENTS,
+// and the async capability lets drop targets like Explorer read them in a
+// worker thread, so the files are only written after dropping.
+class DataObject : public IDataObject, public IDataObjectAsyncCapability {
  public:
-  explicit DataObject(std::vector<Clipboard::Data> objects);
+  DataObject(std::vector<Clipboard::Data> objects,
+             std::vector<FilePromise> file_promises);
 
   // IDataObject:
   HRESULT __stdcall GetData(FORMATETC* format_etc, STGMEDIUM* medium) override;
@@ -52,6 +60,15 @@ class DataObject : public IDataObject {
   HRESULT __stdcall DUnadvise(DWORD connection) override;
   HRESULT __stdcall EnumDAdvise(IEnumSTATDATA** enumerator) override;
 
+  // IDataObjectAsyncCapability:
+  HRESULT __stdcall SetAsyncMode(BOOL do_op_async) override;
+  HRESULT __stdcall GetAsyncMode(BOOL* is_op_async) override;
+  HRESULT __stdcall StartOperation(IBindCtx* reserved) override;
+  HRESULT __stdcall InOperation(BOOL* in_async_op) override;
+  HRESULT __stdcall EndOperation(HRESULT result,
+                                 IBindCtx* reserved,
+                                 DWORD effects) override;
+
   // IUnknown:
   HRESULT __stdcall QueryInterface(const IID& iid, void** object) override;
   ULONG __stdcall AddRef() override;
@@ -65,8 +82,21 @@ class DataObject : public IDataObject {
   // Removes from contents_ the first data that matches |format|.
   void RemoveData(const FORMATETC& format);
 
+  // Write the promised file at |index| and return a stream reading it.
+  HRESULT GetFileContents(LONG index, STGMEDIUM* medium);
+
   std::vector<StoredDataInfo> contents_;
 
+  // The promised files are written into |temp_dir_| once, which may happen
+  // in worker threads.
+  base::Lock lock_;
+  std::vector<FilePromise> file_promises_;
+  std::vector<bool> written_;
+  base::ScopedTempDir temp_dir_;
+
+  bool async_mode_ = false;
+  bool in_operation_ = false;
+
   LONG ref_count_ = 0;
 };
 
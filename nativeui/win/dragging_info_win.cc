@@ -74,4 +74,33 @@ Clipboard::Data DraggingInfoWin::GetData(Data::Type type) const {
   return ret;
 }
 
+int64_t DraggingInfoWin::GetDataSize(Data::Type type) const {
+  FORMATETC format = {0};
+  if (!GetStreamFormatEtc(type, &format))
+    return -1;
+
+  STGMEDIUM medium;
+  if (FAILED(data_->GetData(&format, &medium)))
+    return -1;
+
+  int64_t size = GetStgMediumSize(medium);
+  ReleaseStgMedium(&medium);
+  return size;
+}
+
+bool DraggingInfoWin::ReadData(Data::Type type,
+                               const Clipboard::DataReader& reader) const {
+  FORMATETC format = {0};
+  if (!GetStreamFormatEtc(type, &format))
+    return false;
+
+  STGMEDIUM medium;
+  if (FAILED(data_->GetData(&format, &medium)))
+    return false;
+
+  bool ret = ReadStgMedium(type, medium, reader);
+  ReleaseStgMedium(&medium);
+  return ret;
+}
+
 }  // namespace nu
@@ -19,6 +19,9 @@ class NATIVEUI_EXPORT DraggingInfoWin : public DraggingInfo {
   // DraggingInfo:
   bool IsDataAvailable(Data::Type type) const override;
   Data GetData(Data::Type type) const override;
+  int64_t GetDataSize(Data::Type type) const override;
+  bool ReadData(Data::Type type,
+                const Clipboard::DataReader& reader) const override;
 
  private:
   IDataObject* data_;
@@ -6,6 +6,8 @@
 
 #include <richedit.h>
 
+#include <algorithm>
+
 #include "base/strings/utf_string_conversions.h"
 #include "nativeui/text_edit.h"
 #include "nativeui/win/util/hwnd_util.h"
@@ -30,6 +32,8 @@ void EditView::SetText(const std::string& text) {
   base::string16 text16 = base::UTF8ToUTF16(text);
   ::SetWindowTextW(hwnd(), text16.c_str());
   is_editing_ = false;
+  pending_start_ = -1;
+  length_ = GetTextLength();
   // Scroll to end after setting text, this follows the behavior on other
   // platforms.
   ::SendMessage(hwnd(), EM_SETSEL, text16.size(), text16.size());
@@ -56,6 +60,7 @@ bool EditView::CanUndo() const {
 }
 
 void EditView::Cut() {
+  RecordSelection();
   ::SendMessage(hwnd(), WM_CUT, 0, 0L);
 }
 
@@ -64,13 +69,65 @@ void EditView::Copy() {
 }
 
 void EditView::Paste() {
-  ::SendMessage(hwnd(), WM_PASTE, 0, 0L);
+  RecordSelection();
+  // Only paste text even in rich text mode.
+  ::SendMessage(hwnd(), EM_PASTESPECIAL, CF_UNICODETEXT, 0L);
 }
 
 void EditView::SelectAll() {
   ::SendMessage(hwnd(), EM_SETSEL, 0, -1);
 }
 
+std::string EditView::GetTextInRange(int start, int end) const {
+  if (end <= start)
+    return std::string();
+  base::string16 text(end - start + 1, L'\0');
+  TEXTRANGEW range = {{start, end}, &text[0]};
+  LRESULT length = ::SendMessageW(hwnd(), EM_GETTEXTRANGE, 0,
+                                  reinterpret_cast<LPARAM>(&range));
+  text.resize(length);
+  return base::UTF16ToUTF8(text);
+}
+
+void EditView::RecordSelection() {
+  int start, end;
+  ::SendMessage(hwnd(), EM_GETSEL, reinterpret_cast<WPARAM>(&start),
+                                   reinterpret_cast<LPARAM>(&end));
+  pending_start_ = start;
+  pending_removed_ = end - start;
+}
+
+void EditView::GetChangedRange(int* start, int* removed,
+                               std::string* inserted) {
+  int length = GetTextLength();
+  int inserted_length = length;
+  *start = 0;
+  *removed = length_;
+  if (pending_start_ >= 0) {
+    *start = pending_start_;
+    *removed = pending_removed_;
+    inserted_length = length - (length_ - pending_removed_);
+    if (inserted_length < 0) {
+      // Deleting with empty selection, the caret is at the start.
+      int caret;
+      ::SendMessage(hwnd(), EM_GETSEL, reinterpret_cast<WPARAM>(&caret), 0);
+      *start = std::min(*start, caret);
+      *removed = length_ - length;
+      inserted_length = 0;
+    }
+  }
+  pending_start_ = -1;
+  length_ = length;
+  if (inserted)
+    *inserted = GetTextInRange(*start, *start + inserted_length);
+}
+
+int EditView::GetTextLength() const {
+  GETTEXTLENGTHEX gtl = {GTL_NUMCHARS | GTL_PRECISE, 1200};
+  return static_cast<int>(::SendMessage(
+      hwnd(), EM_GETTEXTLENGTHEX, reinterpret_cast<WPARAM>(&gtl), 0));
+}
+
 void EditView::LoadRichEdit() {
   ::LoadLibraryW(L"msftedit.dll");
 }
@@ -30,12 +30,33 @@ class EditView : public SubwinView {
   void Paste();
   void SelectAll();
 
+  // Read only the characters in range.
+  std::string GetTextInRange(int start, int end) const;
+
+  // Rich edit does not report the range of changes, so it is computed from
+  // the selection that is going to be replaced, which should be recorded
+  // before typing and editing.
+  void RecordSelection();
+  void ClearRecordedSelection() { pending_start_ = -1; }
+
+  // Compute the range of the change that has just happened, the change is
+  // treated as replacing the whole text when no selection was recorded.
+  // The |inserted| text is only read when it is not null.
+  void GetChangedRange(int* start, int* removed, std::string* inserted);
+
   bool is_editing() const { return is_editing_; }
 
  private:
   void LoadRichEdit();
+  int GetTextLength() const;
 
   bool is_editing_ = false;
+
+  // The length of text after last change.
+  int length_ = 0;
+  // The recorded selection.
+  int pending_start_ = -1;
+  int pending_removed_ = 0;
 };
 
 }  // namespace nu
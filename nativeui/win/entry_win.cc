@@ -4,6 +4,8 @@
 
 #include "nativeui/entry.h"
 
+#include <string>
+
 #include "nativeui/gfx/attributed_text.h"
 #include "nativeui/win/edit_view.h"
 
@@ -20,25 +22,66 @@ class EntryImpl : public EditView {
     SetPlainText();
   }
 
+  bool is_composing() const { return is_composing_; }
+
   // SubwinView:
   void OnCommand(UINT code, int command) override {
     Entry* entry = static_cast<Entry*>(delegate());
-    if (code == EN_CHANGE && !is_editing())
-      entry->on_text_change.Emit(entry);
+    if (code != EN_CHANGE || is_editing())
+      return;
+    entry->NotifyTextChange();
+    int start, removed;
+    std::string inserted;
+    bool has_listener = !entry->on_text_range_change.IsEmpty();
+    GetChangedRange(&start, &removed, has_listener ? &inserted : nullptr);
+    if (has_listener)
+      entry->on_text_range_change.Emit(entry, start, removed, inserted);
   }
 
  protected:
   CR_BEGIN_MSG_MAP_EX(EntryImpl, SubwinView)
+    CR_MSG_WM_KEYDOWN(OnKeyDown)
     CR_MSG_WM_CHAR(OnChar)
+    CR_MESSAGE_HANDLER_EX(WM_IME_STARTCOMPOSITION, OnStartComposition)
+    CR_MESSAGE_HANDLER_EX(WM_IME_ENDCOMPOSITION, OnEndComposition)
   CR_END_MSG_MAP()
 
+  void OnKeyDown(UINT ch, UINT repeat, UINT flags) {
+    // Changes not made by typing are notified as replacing the whole text.
+    ClearRecordedSelection();
+    if (ch == VK_DELETE)
+      RecordSelection();
+    SetMsgHandled(false);
+  }
+
   void OnChar(UINT ch, UINT repeat, UINT flags) {
     Entry* entry = static_cast<Entry*>(delegate());
-    if (ch == VK_RETURN)  // enter means activate.
+    if (ch == VK_RETURN) {  // enter means activate.
       entry->on_activate.Emit(entry);
-    else
-      SetMsgHandled(false);
+      return;
+    }
+    // Ctrl+Y and Ctrl+Z.
+    if (ch != 0x19 && ch != 0x1A)
+      RecordSelection();
+    SetMsgHandled(false);
+  }
+
+  LRESULT OnStartComposition(UINT message, WPARAM w_param, LPARAM l_param) {
+    is_composing_ = true;
+    SetMsgHandled(false);
+    return 0;
   }
+
+  LRESULT OnEndComposition(UINT message, WPARAM w_param, LPARAM l_param) {
+    // The result string has been inserted when composition ends.
+    is_composing_ = false;
+    static_cast<Entry*>(delegate())->NotifyCompositionEnd();
+    SetMsgHandled(false);
+    return 0;
+  }
+
+ private:
+  bool is_composing_ = false;
 };
 
 }  // namespace
@@ -65,6 +108,10 @@ std::string Entry::GetText() const {
   return static_cast<EditView*>(GetNative())->GetText();
 }
 
+bool Entry::IsComposing() const {
+  return static_cast<EntryImpl*>(GetNative())->is_composing();
+}
+
 SizeF Entry::GetMinimumSize() const {
   scoped_refptr<AttributedText> text =
       new AttributedText(L"some text", TextAttributes(GetNative()->font()));
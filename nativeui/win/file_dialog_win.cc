@@ -6,6 +6,7 @@
 
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/win/window_win.h"
 
 namespace nu {
@@ -153,6 +154,18 @@ bool FileDialog::RunForWindow(Window* window) {
   return dialog_->RunForWindow(window->GetNative());
 }
 
+void FileDialog::PlatformShowForWindow(Window* window) {
+  // IFileDialog only has the blocking Show, which runs a modal loop that
+  // still dispatches the messages of this thread. Call it from a task so the
+  // caller returns immediately, and tasks and timers keep running while the
+  // dialog is open.
+  scoped_refptr<Window> parent(window);
+  MessageLoop::PostTask([this, parent]() {
+    OnClose(parent ? dialog_->RunForWindow(parent->GetNative())
+                   : dialog_->Run());
+  });
+}
+
 void FileDialog::SetTitle(const std::string& title) {
   dialog_->SetTitle(base::UTF8ToUTF16(title));
 }
@@ -52,18 +52,18 @@ void FocusManager::AdvanceFocus(ViewImpl* view, bool reverse) {
 
 bool FocusManager::DoAdvanceFocus(ContainerImpl* container, bool reverse,
                                   bool* focus_on_next_view) {
-  bool result = false;
   // Iterate views recusively.
-  container->adapter()->ForEach([&](ViewImpl* child) {
+  const std::vector<ViewImpl*>& children =
+      container->adapter()->GetChildren();
+  for (size_t i = 0; i < children.size(); ++i) {
+    ViewImpl* child = children[reverse ? children.size() - 1 - i : i];
     if (!child->is_visible())
-      return true;  // continue
+      continue;
 
     if (child->type() >= ControlType::Container &&
         DoAdvanceFocus(static_cast<ContainerImpl*>(child), reverse,
-                       focus_on_next_view)) {
-      result = true;
-      return false;  // break
-    }
+                       focus_on_next_view))
+      return true;
 
     if (child == focused_view_) {
       *focus_on_next_view = true;
@@ -72,12 +72,10 @@ bool FocusManager::DoAdvanceFocus(ContainerImpl* container, bool reverse,
         focused_view_->SetFocus(false);
       focused_view_ = child;
       child->SetFocus(true);
-      result = true;
-      return false;  // break
+      return true;
     }
-    return true;  // continue
-  }, reverse);
-  return result;
+  }
+  return false;
 }
 
 }  // namespace nu
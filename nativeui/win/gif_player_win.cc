@@ -31,7 +31,7 @@ class GifPlayerImpl : public ViewImpl {
     auto* gif = static_cast<GifPlayer*>(delegate());
     if (gif->IsAnimating() && (is_tree_visible() != gif->IsPlaying())) {
       if (is_tree_visible())
-        gif->ScheduleFrame();
+        gif->StartAnimationTimer();
       else
         gif->StopAnimationTimer();
     }
@@ -45,59 +45,7 @@ GifPlayer::GifPlayer() {
 }
 
 GifPlayer::~GifPlayer() {
-  if (timer_ != 0)
-    StopAnimationTimer();
-}
-
-void GifPlayer::PlatformSetImage(Image* image) {
-  // Reset frame information after chaning image.
-  frames_count_ = 0;
-  frame_ = 0;
-  frame_delays_.reset();
-  if (image) {
-    // Frame dimensions:
-    // frames[animation_frame_index][how_many_animation]
-    UINT dimensions_count = image->GetNative()->GetFrameDimensionsCount();
-    if (dimensions_count > 0) {
-      // Get the identifiers for the frame dimensions.
-      std::vector<GUID> ids(dimensions_count);
-      image->GetNative()->GetFrameDimensionsList(ids.data(), dimensions_count);
-      // For GIF, only #0 is meaningful.
-      frames_count_ = image->GetNative()->GetFrameCount(&ids[0]);
-      frame_ = frames_count_ - 1;
-      // Get frame delays.
-      if (frames_count_ > 1) {
-        UINT size = image->GetNative()->GetPropertyItemSize(
-            PropertyTagFrameDelay);
-        frame_delays_.reset(new BYTE[size]);
-        image->GetNative()->GetPropertyItem(
-            PropertyTagFrameDelay, size,
-            reinterpret_cast<Gdiplus::PropertyItem*>(frame_delays_.get()));
-      }
-    }
-  }
-  // Start animation by default.
-  SetAnimating(!!image);
-  GetNative()->Invalidate();
-}
-
-bool GifPlayer::CanAnimate() const {
-  return frames_count_ > 1;
-}
-
-void GifPlayer::ScheduleFrame() {
-  // Advance frame.
-  frame_ = (frame_ + 1) % frames_count_;
-  image_->GetNative()->SelectActiveFrame(&Gdiplus::FrameDimensionTime, frame_);
-  // Emit draw event.
-  SchedulePaint();
-  // Schedule next call.
-  if (is_animating_) {
-    auto* item = reinterpret_cast<Gdiplus::PropertyItem*>(frame_delays_.get());
-    auto* delays = static_cast<UINT*>(item->value);
-    timer_ = MessageLoop::SetTimeout(
-        delays[frame_] * 10, std::bind(&GifPlayer::ScheduleFrame, this));
-  }
+  StopAnimationTimer();
 }
 
 }  // namespace nu
@@ -51,9 +51,9 @@ class GroupImpl : public ContainerImpl,
     delegate_->GetContentView()->SetBounds(child_alloc);
   }
 
-  void ForEach(const std::function<bool(ViewImpl*)>& callback,
-               bool reverse) override {
-    callback(delegate_->GetContentView()->GetNative());
+  const std::vector<ViewImpl*>& GetChildren() override {
+    children_.assign(1, delegate_->GetContentView()->GetNative());
+    return children_;
   }
 
   bool HasChild(ViewImpl* child) override {
@@ -126,6 +126,7 @@ class GroupImpl : public ContainerImpl,
   Group* delegate_;
   RectF title_bounds_;
   scoped_refptr<AttributedText> text_;
+  std::vector<ViewImpl*> children_;
 };
 
 }  // namespace
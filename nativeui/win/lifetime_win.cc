@@ -4,6 +4,10 @@
 
 #include "nativeui/lifetime.h"
 
+#include "nativeui/clipboard.h"
+#include "nativeui/state.h"
+#include "nativeui/win/clipboard_win.h"
+
 namespace nu {
 
 void Lifetime::PlatformInit() {
@@ -12,4 +16,13 @@ void Lifetime::PlatformInit() {
 void Lifetime::PlatformDestroy() {
 }
 
+void Lifetime::PlatformFlushBeforeExit() {
+  // Keep the data promised by this process available after exit, the process
+  // is terminated without destroying the clipboard window so there would be
+  // no WM_RENDERALLFORMATS.
+  State* state = State::GetCurrent();
+  if (state)
+    RenderAllClipboardFormats(state->GetClipboard(Clipboard::Type::CopyPaste));
+}
+
 }  // namespace nu
@@ -25,7 +25,22 @@ void DispatchCommandToItem(MenuBase* menu, int command) {
   }
 }
 
+void DispatchInitMenuPopup(HMENU menu) {
+  MENUINFO mi = {0};
+  mi.cbSize = sizeof(mi);
+  mi.fMask = MIM_MENUDATA;
+  if (!GetMenuInfo(menu, &mi) || !mi.dwMenuData)
+    return;
+  reinterpret_cast<MenuBase*>(mi.dwMenuData)->NotifyWillOpen();
+}
+
 void MenuBase::PlatformInit() {
+  // Remember the shell so it can be found from WM_INITMENUPOPUP.
+  MENUINFO mi = {0};
+  mi.cbSize = sizeof(mi);
+  mi.fMask = MIM_MENUDATA;
+  mi.dwMenuData = reinterpret_cast<ULONG_PTR>(this);
+  SetMenuInfo(menu_, &mi);
 }
 
 void MenuBase::PlatformDestroy() {
@@ -13,6 +13,10 @@ namespace nu {
 // the click event for it.
 void DispatchCommandToItem(nu::MenuBase* menu, int command);
 
+// Notify the MenuBase owning |menu| that it is about to be shown, should be
+// called when handling WM_INITMENUPOPUP.
+void DispatchInitMenuPopup(HMENU menu);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_WIN_MENU_BASE_WIN_H_
@@ -69,7 +69,7 @@ void MenuItem::Click() {
     SetChecked(!IsChecked());
   else if (type_ == Type::Radio)
     SetChecked(true);
-  on_click.Emit(this);
+  NotifyClick();
 }
 
 void MenuItem::SetLabel(const std::string& label) {
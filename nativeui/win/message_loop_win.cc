@@ -6,6 +6,7 @@
 
 #include <windows.h>
 
+#include "base/logging.h"
 #include "nativeui/state.h"
 #include "nativeui/win/util/timer_host.h"
 
@@ -26,23 +27,34 @@ void MessageLoop::Quit() {
 }
 
 // static
-void MessageLoop::PostTask(Task task) {
-  PostDelayedTask(USER_TIMER_MINIMUM, std::move(task));
+bool MessageLoop::WakeupForTasks() {
+  return State::GetMain()->GetTimerHost()->WakeupForTasks();
 }
 
 // static
-void MessageLoop::PostDelayedTask(int ms, Task task) {
-  SetTimeout(ms, std::move(task));
+void MessageLoop::PlatformPostTask(Priority priority, Task task) {
+  TimerHost* timer_host = State::GetMain()->GetTimerHost();
+  switch (priority) {
+    case Priority::UserBlocking:
+      timer_host->PostTask(std::move(task));
+      break;
+    case Priority::Idle:
+      timer_host->PostIdleTask(std::move(task));
+      break;
+    case Priority::Normal:
+      NOTREACHED();
+      break;
+  }
 }
 
 // static
-UINT_PTR MessageLoop::SetTimeout(int ms, Task task) {
-  return State::GetMain()->GetTimerHost()->SetTimeout(ms, std::move(task));
+void MessageLoop::ScheduleTimer(int ms) {
+  State::GetMain()->GetTimerHost()->ScheduleTimer(ms);
 }
 
 // static
-void MessageLoop::ClearTimeout(TimerId id) {
-  State::GetMain()->GetTimerHost()->ClearTimeout(id);
+void MessageLoop::PlatformSetTimersPrecise(bool precise) {
+  // There is no App Nap on Windows.
 }
 
 }  // namespace nu
@@ -6,6 +6,7 @@
 
 #include <commctrl.h>
 
+#include <unordered_set>
 #include <vector>
 
 #include "base/strings/utf_string_conversions.h"
@@ -33,6 +34,19 @@ std::string PickerImpl::GetItemAt(int i) {
   return base::UTF16ToUTF8(text16);
 }
 
+void PickerImpl::SetItems(const std::vector<base::string16>& items,
+                          size_t size) {
+  ::SendMessage(hwnd(), WM_SETREDRAW, FALSE, 0L);
+  ::SendMessage(hwnd(), CB_RESETCONTENT, 0, 0L);
+  // Allocate the memory at once.
+  ::SendMessage(hwnd(), CB_INITSTORAGE, items.size(), size);
+  for (const base::string16& item : items)
+    ::SendMessage(hwnd(), CB_ADDSTRING, 0,
+                  reinterpret_cast<LPARAM>(item.c_str()));
+  ::SendMessage(hwnd(), WM_SETREDRAW, TRUE, 0L);
+  ::InvalidateRect(hwnd(), nullptr, TRUE);
+}
+
 void PickerImpl::SelectItemAt(int index) {
   ::SendMessage(hwnd(), CB_SETCURSEL, index, 0L);
 }
@@ -76,6 +90,25 @@ void Picker::AddItem(const std::string& text) {
   }
 }
 
+void Picker::SetItems(const std::vector<std::string>& items) {
+  auto* picker = static_cast<PickerImpl*>(GetNative());
+  std::vector<base::string16> items16;
+  items16.reserve(items.size());
+  std::unordered_set<std::string> added;
+  size_t size = 0;
+  for (const std::string& item : items) {
+    // Guard against duplicate items.
+    if (!added.insert(item).second)
+      continue;
+    items16.emplace_back(base::UTF8ToUTF16(item));
+    size += (items16.back().size() + 1) * sizeof(wchar_t);
+  }
+  picker->SetItems(items16, size);
+  // Select first item by default.
+  if (!items16.empty())
+    picker->SelectItemAt(0);
+}
+
 void Picker::RemoveItemAt(int index) {
   auto* picker = static_cast<PickerImpl*>(GetNative());
   ::SendMessage(picker->hwnd(), CB_DELETESTRING, index, 0L);
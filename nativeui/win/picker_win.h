@@ -6,6 +6,7 @@
 #define NATIVEUI_WIN_PICKER_WIN_H_
 
 #include <string>
+#include <vector>
 
 #include "nativeui/picker.h"
 #include "nativeui/win/subwin_view.h"
@@ -18,6 +19,8 @@ class PickerImpl : public SubwinView {
 
   int ItemCount() const;
   std::string GetItemAt(int i);
+  // Replace items with |items| which take |size| bytes in total.
+  void SetItems(const std::vector<base::string16>& items, size_t size);
   void SelectItemAt(int index);
   int GetSelectedItemIndex() const;
 
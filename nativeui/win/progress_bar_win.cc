@@ -37,7 +37,9 @@ void ProgressBar::SetValue(float value) {
 }
 
 float ProgressBar::GetValue() const {
-  return 0;
+  auto* progress = static_cast<ProgressBarImpl*>(GetNative());
+  return static_cast<float>(
+      SendMessageW(progress->hwnd(), PBM_GETPOS, 0, 0));
 }
 
 void ProgressBar::SetIndeterminate(bool indeterminate) {
@@ -4,14 +4,33 @@
 
 #include "nativeui/win/scroll_win.h"
 
+#include <algorithm>
+#include <cmath>
 #include <tuple>
 
+#include "base/auto_reset.h"
 #include "nativeui/events/win/event_win.h"
 #include "nativeui/gfx/geometry/size_conversions.h"
+#include "nativeui/gfx/geometry/vector2d_conversions.h"
 #include "nativeui/win/scrollbar/scrollbar.h"
+#include "nativeui/win/window_win.h"
+#include "nativeui/window.h"
 
 namespace nu {
 
+namespace {
+
+// The distance of one line scrolled by mouse wheel, in DIP.
+const float kWheelLineHeight = 40.f;
+
+// The time in ms for smooth scrolling to cover half of remaining distance.
+const double kScrollHalfLife = 30.;
+
+// The frame interval assumed for the first frame of animation.
+const double kFrameInterval = 16.;
+
+}  // namespace
+
 ScrollImpl::ScrollImpl(Scroll* delegate)
     : ContainerImpl(delegate, this, ControlType::Scroll),
       scrollbar_height_(GetSystemMetrics(SM_CXVSCROLL)),
@@ -22,17 +41,22 @@ ScrollImpl::ScrollImpl(Scroll* delegate)
 ScrollImpl::~ScrollImpl() {}
 
 void ScrollImpl::SetOrigin(const Vector2d& origin) {
-  UpdateOrigin(origin);
+  StopAnimation();
+  bool changed = UpdateOrigin(origin);
   Layout();
   Invalidate();
+  if (changed)
+    delegate_->NotifyScroll();
 }
 
 void ScrollImpl::SetContentSize(const Size& size) {
   content_size_ = size;
   UpdateScrollbar();
-  UpdateOrigin(origin_);
+  bool changed = UpdateOrigin(origin_);
   Layout();
   Invalidate();
+  if (changed)
+    delegate_->NotifyScroll();
 }
 
 void ScrollImpl::SetScrollbarPolicy(Scroll::Policy h_policy,
@@ -40,9 +64,11 @@ void ScrollImpl::SetScrollbarPolicy(Scroll::Policy h_policy,
   h_policy_ = h_policy;
   v_policy_ = v_policy;
   UpdateScrollbar();
-  UpdateOrigin(origin_);
+  bool changed = UpdateOrigin(origin_);
   Layout();
   Invalidate();
+  if (changed)
+    delegate_->NotifyScroll();
 }
 
 Rect ScrollImpl::GetViewportRect() const {
@@ -53,11 +79,15 @@ Rect ScrollImpl::GetViewportRect() const {
   return viewport;
 }
 
+Vector2d ScrollImpl::GetMaximumOrigin() const {
+  Rect viewport = GetViewportRect();
+  return Vector2d(std::max(0, content_size_.width() - viewport.width()),
+                  std::max(0, content_size_.height() - viewport.height()));
+}
+
 void ScrollImpl::OnScroll(int x, int y) {
-  if (UpdateOrigin(origin_ + Vector2d(x, y))) {
-    Layout();
-    Invalidate();
-  }
+  StopAnimation();
+  ScrollTo(origin_ + Vector2d(x, y));
 }
 
 void ScrollImpl::Layout() {
@@ -81,11 +111,14 @@ void ScrollImpl::Layout() {
   }
 }
 
-void ScrollImpl::ForEach(const std::function<bool(ViewImpl*)>& callback,
-                         bool reverse /* ignored for Scroll */) {
-  callback(delegate_->GetContentView()->GetNative()) &&
-  (!h_scrollbar_ || callback(h_scrollbar_.get())) &&
-  v_scrollbar_ && callback(v_scrollbar_.get());
+const std::vector<ViewImpl*>& ScrollImpl::GetChildren() {
+  children_.clear();
+  children_.push_back(delegate_->GetContentView()->GetNative());
+  if (h_scrollbar_)
+    children_.push_back(h_scrollbar_.get());
+  if (v_scrollbar_)
+    children_.push_back(v_scrollbar_.get());
+  return children_;
 }
 
 bool ScrollImpl::HasChild(ViewImpl* child) {
@@ -94,10 +127,14 @@ bool ScrollImpl::HasChild(ViewImpl* child) {
 }
 
 void ScrollImpl::SizeAllocate(const Rect& size_allocation) {
+  base::AutoReset<bool> auto_reset(&layer_moving_,
+                                   IsMovingLayer(size_allocation));
   ViewImpl::SizeAllocate(size_allocation);
   UpdateScrollbar();
-  UpdateOrigin(origin_);
+  bool changed = UpdateOrigin(origin_);
   Layout();
+  if (changed)
+    delegate_->NotifyScroll();
 }
 
 void ScrollImpl::Draw(PainterWin* painter, const Rect& dirty) {
@@ -114,10 +151,36 @@ void ScrollImpl::Draw(PainterWin* painter, const Rect& dirty) {
 
 bool ScrollImpl::OnMouseWheel(NativeEvent event) {
   int16_t delta = static_cast<int16_t>(HIWORD(event->w_param));
-  if (event->message == WM_MOUSEWHEEL)
-    OnScroll(0, delta);
-  else
-    OnScroll(-delta, 0);
+  bool vertical = event->message == WM_MOUSEWHEEL;
+  // Use the number of lines that users configured for each notch.
+  UINT lines = 3;
+  ::SystemParametersInfo(vertical ? SPI_GETWHEELSCROLLLINES
+                                  : SPI_GETWHEELSCROLLCHARS,
+                         0, &lines, 0);
+  float distance;
+  if (lines == WHEEL_PAGESCROLL) {
+    Rect viewport = GetViewportRect();
+    distance = static_cast<float>(delta) / WHEEL_DELTA *
+               (vertical ? viewport.height() : viewport.width());
+  } else {
+    distance = static_cast<float>(delta) / WHEEL_DELTA * lines *
+               kWheelLineHeight * scale_factor();
+  }
+  Vector2dF offset = vertical ? Vector2dF(0, distance)
+                              : Vector2dF(-distance, 0);
+
+  // Precision touchpads and high resolution wheels send deltas smaller than
+  // a notch at high frequency, which already follow the fingers and should
+  // not be delayed by animation.
+  if (delta % WHEEL_DELTA != 0 && !frame_id_) {
+    // Keep the fractions from last scroll unless origin has been changed.
+    if (ToRoundedVector2d(target_) != origin_)
+      target_ = origin_;
+    MoveTarget(offset);
+    ScrollTo(ToRoundedVector2d(target_));
+  } else {
+    AnimateScroll(offset);
+  }
   return true;
 }
 
@@ -184,6 +247,113 @@ Rect ScrollImpl::GetScrollbarRect(bool vertical) const {
                 scrollbar_height_);
 }
 
+void ScrollImpl::ScrollTo(const Vector2d& new_origin) {
+  Vector2d old_origin = origin_;
+  if (!UpdateOrigin(new_origin))
+    return;
+  Vector2d delta = origin_ - old_origin;
+  // Only the pixels that can be seen have been painted.
+  Rect viewport = IntersectRects(GetViewportRect(), GetClippedRect());
+  bool move_pixels = window() &&
+                     std::abs(delta.x()) < viewport.width() &&
+                     std::abs(delta.y()) < viewport.height();
+  // Moving content repaints the whole viewport, which is replaced by moving
+  // the painted pixels when possible.
+  Rect dirty = window() ? window()->dirty_rect() : Rect();
+  Layout();
+  if (move_pixels && window()->ScrollPixelRect(viewport, delta, dirty)) {
+    // Repaint the strips that were outside the viewport before scrolling.
+    if (delta.y() > 0)
+      Invalidate(Rect(viewport.x(), viewport.y(),
+                      viewport.width(), delta.y()));
+    else if (delta.y() < 0)
+      Invalidate(Rect(viewport.x(), viewport.bottom() + delta.y(),
+                      viewport.width(), -delta.y()));
+    if (delta.x() > 0)
+      Invalidate(Rect(viewport.x(), viewport.y(),
+                      delta.x(), viewport.height()));
+    else if (delta.x() < 0)
+      Invalidate(Rect(viewport.right() + delta.x(), viewport.y(),
+                      -delta.x(), viewport.height()));
+    // The thumbs have moved.
+    Vector2d offset = size_allocation().OffsetFromOrigin();
+    if (h_scrollbar_)
+      Invalidate(GetScrollbarRect(false) + offset);
+    if (v_scrollbar_)
+      Invalidate(GetScrollbarRect(true) + offset);
+  } else {
+    Invalidate();
+  }
+  delegate_->NotifyScroll();
+}
+
+void ScrollImpl::MoveTarget(const Vector2dF& delta) {
+  // Stop at the edges, otherwise scrolling back would be delayed.
+  target_ += delta;
+  Vector2d max_origin = GetMaximumOrigin();
+  target_.set_x(std::max(-static_cast<float>(max_origin.x()),
+                         std::min(target_.x(), 0.f)));
+  target_.set_y(std::max(-static_cast<float>(max_origin.y()),
+                         std::min(target_.y(), 0.f)));
+}
+
+void ScrollImpl::AnimateScroll(const Vector2dF& delta) {
+  Window* win = delegate_->GetWindow();
+  if (!win) {
+    OnScroll(std::round(delta.x()), std::round(delta.y()));
+    return;
+  }
+  // Continue from the current target so fast wheeling accumulates.
+  if (!frame_id_)
+    target_ = origin_;
+  MoveTarget(delta);
+  if (frame_id_)
+    return;
+  last_frame_time_ = 0;
+  // Keep a reference so the view is alive when the frame comes.
+  scoped_refptr<Scroll> self(delegate_);
+  frame_id_ = win->RequestFrame([self, this](double timestamp) {
+    OnAnimationFrame(timestamp);
+  });
+}
+
+void ScrollImpl::OnAnimationFrame(double timestamp) {
+  if (!frame_id_)
+    return;
+  frame_id_ = 0;
+  double interval = last_frame_time_ > 0 ? timestamp - last_frame_time_
+                                         : kFrameInterval;
+  last_frame_time_ = timestamp;
+  // Ease out by covering a fixed ratio of remaining distance in each period
+  // of time, which does not depend on the frame rate.
+  Vector2dF remaining = target_ - Vector2dF(origin_);
+  float ratio = 1.f - std::pow(0.5, interval / kScrollHalfLife);
+  Vector2dF next = Vector2dF(origin_) + ScaleVector2d(remaining, ratio);
+  Vector2d new_origin = ToRoundedVector2d(next);
+  // Always make progress, and finish when there is less than one pixel left.
+  if (new_origin == origin_ ||
+      (std::abs(remaining.x()) < 1.f && std::abs(remaining.y()) < 1.f))
+    new_origin = ToRoundedVector2d(target_);
+  if (new_origin == origin_)
+    return;
+  ScrollTo(new_origin);
+  Window* win = delegate_->GetWindow();
+  if (!win || origin_ == ToRoundedVector2d(target_))
+    return;
+  scoped_refptr<Scroll> self(delegate_);
+  frame_id_ = win->RequestFrame([self, this](double timestamp) {
+    OnAnimationFrame(timestamp);
+  });
+}
+
+void ScrollImpl::StopAnimation() {
+  if (!frame_id_)
+    return;
+  if (delegate_->GetWindow())
+    delegate_->GetWindow()->CancelFrame(frame_id_);
+  frame_id_ = 0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Public Container API implementation.
 
@@ -202,6 +372,28 @@ void Scroll::SetContentSize(const SizeF& size) {
   scroll->SetContentSize(ToCeiledSize(ScaleSize(size, scroll->scale_factor())));
 }
 
+void Scroll::PlatformSetScrollPosition(float horizon, float vertical) {
+  auto* scroll = static_cast<ScrollImpl*>(GetNative());
+  float scale_factor = scroll->scale_factor();
+  scroll->SetOrigin(Vector2d(-horizon * scale_factor,
+                             -vertical * scale_factor));
+}
+
+std::tuple<float, float> Scroll::GetScrollPosition() const {
+  auto* scroll = static_cast<ScrollImpl*>(GetNative());
+  float scale_factor = scroll->scale_factor();
+  return std::make_tuple(-scroll->origin().x() / scale_factor,
+                         -scroll->origin().y() / scale_factor);
+}
+
+std::tuple<float, float> Scroll::GetMaximumScrollPosition() const {
+  auto* scroll = static_cast<ScrollImpl*>(GetNative());
+  float scale_factor = scroll->scale_factor();
+  Vector2d max_origin = scroll->GetMaximumOrigin();
+  return std::make_tuple(max_origin.x() / scale_factor,
+                         max_origin.y() / scale_factor);
+}
+
 void Scroll::SetScrollbarPolicy(Policy h_policy, Policy v_policy) {
   auto* scroll = static_cast<ScrollImpl*>(GetNative());
   scroll->SetScrollbarPolicy(h_policy, v_policy);
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "nativeui/gfx/geometry/insets.h"
+#include "nativeui/gfx/geometry/vector2d_f.h"
 #include "nativeui/scroll.h"
 #include "nativeui/win/container_win.h"
 
@@ -28,12 +29,14 @@ class ScrollImpl : public ContainerImpl,
   void SetScrollbarPolicy(Scroll::Policy h_policy, Scroll::Policy v_policy);
 
   Rect GetViewportRect() const;
+  Vector2d GetMaximumOrigin() const;
+
+  // Scroll by |x| and |y| immediately, used by scrollbars.
   void OnScroll(int x, int y);
 
   // ContainerImpl::Adapter:
   void Layout() override;
-  void ForEach(const std::function<bool(ViewImpl*)>& callback,
-               bool reverse) override;
+  const std::vector<ViewImpl*>& GetChildren() override;
   bool HasChild(ViewImpl* child) override;
 
   // ViewImpl:
@@ -52,6 +55,16 @@ class ScrollImpl : public ContainerImpl,
   bool UpdateOrigin(Vector2d new_origin);
   Rect GetScrollbarRect(bool vertical) const;
 
+  // Move the content to |new_origin|, the pixels already painted are moved
+  // together so only the exposed area gets repainted.
+  void ScrollTo(const Vector2d& new_origin);
+
+  // Scroll towards |target_| smoothly on each frame.
+  void MoveTarget(const Vector2dF& delta);
+  void AnimateScroll(const Vector2dF& delta);
+  void OnAnimationFrame(double timestamp);
+  void StopAnimation();
+
   Size content_size_;
   Vector2d origin_;
 
@@ -64,6 +77,13 @@ class ScrollImpl : public ContainerImpl,
 
   std::unique_ptr<Scrollbar> h_scrollbar_;
   std::unique_ptr<Scrollbar> v_scrollbar_;
+  std::vector<ViewImpl*> children_;
+
+  // The origin that the smooth scrolling is moving to, which keeps the
+  // fractions of precise wheel deltas.
+  Vector2dF target_;
+  int frame_id_ = 0;
+  double last_frame_time_ = 0;
 
   Scroll* delegate_;
 };
@@ -17,6 +17,7 @@ Scrollbar::Scrollbar(bool vertical, ScrollImpl* scroll)
       far_button_(vertical ? ScrollbarButton::Down : ScrollbarButton::Right,
                   this),
       thumb_(vertical, this),
+      children_({&near_button_, &far_button_, &thumb_}),
       repeater_([this] { this->OnClick(); }),
       vertical_(vertical),
       scroll_(scroll) {
@@ -110,9 +111,8 @@ void Scrollbar::Layout() {
   UpdateThumbPosition();
 }
 
-void Scrollbar::ForEach(const std::function<bool(ViewImpl*)>& callback,
-                        bool reverse /* ignored for Scrollbar */) {
-  callback(&near_button_) && callback(&far_button_) && callback(&thumb_);
+const std::vector<ViewImpl*>& Scrollbar::GetChildren() {
+  return children_;
 }
 
 bool Scrollbar::HasChild(ViewImpl* child) {
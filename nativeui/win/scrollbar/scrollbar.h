@@ -30,8 +30,7 @@ class Scrollbar : public ContainerImpl,
 
   // ContainerImpl::Adapter:
   void Layout() override;
-  void ForEach(const std::function<bool(ViewImpl*)>& callback,
-               bool reverse) override;
+  const std::vector<ViewImpl*>& GetChildren() override;
   bool HasChild(ViewImpl* child) override;
 
   // ViewImpl:
@@ -58,6 +57,7 @@ class Scrollbar : public ContainerImpl,
   ScrollbarButton near_button_;
   ScrollbarButton far_button_;
   ScrollbarThumb thumb_;
+  std::vector<ViewImpl*> children_;
 
   RepeatController repeater_;
 
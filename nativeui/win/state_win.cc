@@ -15,11 +15,16 @@
 #include "nativeui/gfx/win/native_theme.h"
 #include "nativeui/screen.h"
 #include "nativeui/win/util/class_registrar.h"
+#include "nativeui/win/util/composition_target.h"
+#include "nativeui/win/util/direct2d_holder.h"
 #include "nativeui/win/util/gdiplus_holder.h"
 #include "nativeui/win/util/scoped_ole_initializer.h"
 #include "nativeui/win/util/subwin_holder.h"
 #include "nativeui/win/util/timer_host.h"
 #include "nativeui/win/util/tray_host.h"
+#if defined(WEBVIEW2_SUPPORT)
+#include "nativeui/win/webview2/webview2_environment.h"
+#endif
 #include "third_party/yoga/Yoga.h"
 
 namespace nu {
@@ -39,11 +44,23 @@ void State::PlatformInit() {
   if (GetMain() == this)
     GetTimerHost();
 
+  ScopedStartupPhase startup_phase(StartupPhase::GdiplusInit);
   gdiplus_holder_.reset(new GdiplusHolder);
 }
 
+void State::PlatformPrewarm() {
+  // Windows accepting drops initialize OLE on creation.
+  InitializeCOM();
+  // The holder is a window of the default class, creating it registers the
+  // class used by all windows.
+  GetSubwinHolder();
+  GetNativeTheme()->OpenHandles();
+  Font::Default()->GetHFONT(Screen::GetDefaultScaleFactor());
+}
+
 void State::InitializeCOM() {
   if (!com_initializer_) {
+    ScopedStartupPhase startup_phase(StartupPhase::COMInit);
     com_initializer_.reset(new base::win::ScopedCOMInitializer);
     ole_initializer_.reset(new ScopedOleInitializer);
   }
@@ -66,6 +83,14 @@ bool State::InitWebView2Loader() {
   return webview2_loader_->is_valid();
 }
 
+#if defined(WEBVIEW2_SUPPORT)
+WebView2Environment* State::GetWebView2Environment() {
+  if (!webview2_environment_)
+    webview2_environment_.reset(new WebView2Environment);
+  return webview2_environment_.get();
+}
+#endif
+
 HWND State::GetSubwinHolder() {
   if (!subwin_holder_)
     subwin_holder_.reset(new SubwinHolder);
@@ -78,6 +103,18 @@ ClassRegistrar* State::GetClassRegistrar() {
   return class_registrar_.get();
 }
 
+Direct2DHolder* State::GetDirect2DHolder() {
+  if (!direct2d_holder_)
+    direct2d_holder_.reset(new Direct2DHolder);
+  return direct2d_holder_.get();
+}
+
+CompositionDevice* State::GetCompositionDevice() {
+  if (!composition_device_)
+    composition_device_.reset(new CompositionDevice);
+  return composition_device_.get();
+}
+
 NativeTheme* State::GetNativeTheme() {
   if (!native_theme_)
     native_theme_.reset(new NativeTheme);
@@ -101,4 +138,12 @@ UINT State::GetNextCommandID() {
   return next_command_id_++;
 }
 
+void State::SetWindowMessageStatsEnabled(bool enabled) {
+  window_message_stats_enabled_ = enabled;
+}
+
+void State::ResetWindowMessageStats() {
+  window_message_stats_ = WindowMessageStats();
+}
+
 }  // namespace nu
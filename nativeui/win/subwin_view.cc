@@ -10,6 +10,7 @@
 #include "nativeui/state.h"
 #include "nativeui/win/scroll_win.h"
 #include "nativeui/win/util/hwnd_util.h"
+#include "nativeui/win/util/window_message_stats.h"
 
 namespace nu {
 
@@ -34,7 +35,7 @@ void SubwinView::SizeAllocate(const Rect& size_allocation) {
   // the control may be inside a Scroll.
   Rect clipped = GetClippedRect();
   if (clipped.IsEmpty()) {
-    ::ShowWindow(hwnd(), SW_HIDE);
+    SetWindowBounds(Rect(), SWP_HIDEWINDOW | SWP_NOMOVE | SWP_NOSIZE);
     return;
   }
 
@@ -51,12 +52,7 @@ void SubwinView::SizeAllocate(const Rect& size_allocation) {
     SetWindowRgn(hwnd(), NULL, FALSE);
   }
 
-  ::ShowWindow(hwnd(), SW_SHOWNOACTIVATE);
-  SetWindowPos(hwnd(), NULL,
-               size_allocation.x(), size_allocation.y(),
-               size_allocation.width(), size_allocation.height(),
-               SWP_NOACTIVATE | SWP_NOZORDER);
-  RedrawWindow(hwnd(), NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
+  SetWindowBounds(size_allocation, SWP_SHOWWINDOW);
 }
 
 void SubwinView::SetParent(ViewImpl* parent) {
@@ -107,7 +103,8 @@ void SubwinView::SetFont(Font* new_font) {
   ViewImpl::SetFont(new_font);
   // Use it as control's default font.
   SendMessage(hwnd(), WM_SETFONT,
-              reinterpret_cast<WPARAM>(new_font->GetHFONT(hwnd())), TRUE);
+              reinterpret_cast<WPARAM>(new_font->GetHFONT(scale_factor())),
+              TRUE);
 }
 
 void SubwinView::SetBackgroundColor(Color color) {
@@ -118,10 +115,30 @@ void SubwinView::SetBackgroundColor(Color color) {
     bg_brush_.reset(CreateSolidBrush(color.ToCOLORREF()));
 }
 
+void SubwinView::OnDPIChanged() {
+  // The fonts of native controls are in pixels.
+  SetFont(font());
+}
+
 void SubwinView::Draw(PainterWin* painter, const Rect& dirty) {
   // There is nothing to draw in a sub window.
 }
 
+bool SubwinView::IsOpaque() const {
+  // The background is painted by the sub window.
+  return false;
+}
+
+void SubwinView::SetWindowBounds(const Rect& bounds, UINT flags) {
+  flags |= SWP_NOACTIVATE | SWP_NOZORDER;
+  if (window() && window()->DeferChildMove(hwnd(), bounds, flags))
+    return;
+  ::SetWindowPos(hwnd(), NULL, bounds.x(), bounds.y(),
+                 bounds.width(), bounds.height(), flags);
+  if (!(flags & SWP_HIDEWINDOW))
+    RedrawWindow(hwnd(), NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
+}
+
 void SubwinView::SetTransparentBackground() {
   transprent_background_ = true;
   UpdateTransparentBackgroundBrush();
@@ -214,6 +231,9 @@ LRESULT SubwinView::WndProc(HWND hwnd,
   auto* self = reinterpret_cast<SubwinView*>(GetWindowUserData(hwnd));
   if (!self)  // could happen during destruction
     return 0;
+  // Report native controls by their view classes.
+  ScopedMessageTimer timer(
+      message, self->delegate() ? self->delegate()->GetClassName() : nullptr);
   LRESULT lresult = 0;
   if (self->ProcessWindowMessage(hwnd, message, w_param, l_param, &lresult))
     return lresult;
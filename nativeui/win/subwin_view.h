@@ -29,6 +29,8 @@ class SubwinView : public Win32Window, public ViewImpl {
   void SetFont(Font* font) override;
   void SetBackgroundColor(Color color) override;
   void Draw(PainterWin* painter, const Rect& dirty) override;
+  bool IsOpaque() const override;
+  void OnDPIChanged() override;
 
   WNDPROC proc() const { return proc_; }
 
@@ -65,6 +67,10 @@ class SubwinView : public Win32Window, public ViewImpl {
       UINT message, WPARAM w_param, LPARAM l_param);
 
  private:
+  // Move the window, the move is batched when the parent window is laying
+  // out its children.
+  void SetWindowBounds(const Rect& bounds, UINT flags);
+
   void UpdateTransparentBackgroundBrush();
 
   // Subclass-ed window procedure.
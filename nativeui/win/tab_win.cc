@@ -172,12 +172,13 @@ class TabImpl : public ContainerImpl,
     page->SetVisible(true);
     Layout();
 
+    // Lazy pages are loaded here, which must happen before moving focus.
+    tab()->NotifyPageSelected(selected_item_index_);
+
     // Move focus to the selected page.
     ViewImpl* view = page->GetNative();
     if (window())
       window()->focus_manager()->AdvanceFocus(view, false);
-
-    tab()->on_selected_page_change.Emit(tab());
   }
 
   ViewImpl* GetSelectedPage() const {
@@ -226,17 +227,13 @@ class TabImpl : public ContainerImpl,
     Invalidate();
   }
 
-  void ForEach(const std::function<bool(ViewImpl*)>& callback,
-               bool reverse) override {
-    if (items_.empty())
-      return;
-    for (int i = reverse ? static_cast<int>(items_.size()) - 1 : 0;
-         reverse ? (i >= 0) : (i < static_cast<int>(items_.size()));
-         reverse ? --i : ++i) {
-      if (!callback(items_[i].get()) ||
-          !callback(tab()->PageAt(i)->GetNative()))
-        break;
+  const std::vector<ViewImpl*>& GetChildren() override {
+    children_.clear();
+    for (size_t i = 0; i < items_.size(); ++i) {
+      children_.push_back(items_[i].get());
+      children_.push_back(tab()->PageAt(static_cast<int>(i))->GetNative());
     }
+    return children_;
   }
 
   bool HasChild(ViewImpl* child) override {
@@ -302,6 +299,7 @@ class TabImpl : public ContainerImpl,
   TabItem* selected_item_ = nullptr;
   int selected_item_index_ = -1;
   std::vector<std::unique_ptr<TabItem>> items_;
+  std::vector<ViewImpl*> children_;
 };
 
 }  // namespace
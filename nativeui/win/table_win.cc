@@ -17,6 +17,25 @@
 
 namespace nu {
 
+namespace {
+
+// Number of rows measured for guessing the width of columns.
+const uint32_t kMaxRowsToMeasure = 16;
+
+// Texts of rows out of the visible area are dropped when there are more
+// cached texts than this.
+const size_t kMinTextCacheSize = 256;
+
+inline uint64_t GetCellKey(int column, int row) {
+  return (static_cast<uint64_t>(row) << 32) | static_cast<uint32_t>(column);
+}
+
+inline int GetRowFromKey(uint64_t key) {
+  return static_cast<int>(key >> 32);
+}
+
+}  // namespace
+
 TableImpl::TableImpl(Table* delegate)
     : SubwinView(delegate, WC_LISTVIEW,
                  LVS_SINGLESEL | LVS_SHOWSELALWAYS | LVS_REPORT |
@@ -42,6 +61,8 @@ void TableImpl::AddColumnWithOptions(const base::string16& title,
   if (options.column == -1)
     options.column = GetColumnCount();
   ListView_InsertColumn(hwnd(), GetColumnCount(), &col);
+  cell_caches_.push_back(options.type == Table::ColumnType::Custom ?
+                         new TableCellCache(options) : nullptr);
   columns_.emplace_back(std::move(options));
   UpdateColumnsWidth(static_cast<Table*>(delegate())->GetModel());
 
@@ -65,17 +86,20 @@ void TableImpl::UpdateColumnsWidth(TableModel* model) {
     int width = columns_[i].width * scale_factor();
     if (width < 0) {  // autosize
       width = kDefaultColumnWidth * scale_factor();
-      // If there is data in model, use the first cell's width.
-      if (model && model->GetRowCount() > 0) {
-        const base::Value* value = model->GetValue(i, 0);
-        if (value && value->is_string()) {
-          base::string16 text = base::UTF8ToUTF16(value->GetString());
-          int text_width = ListView_GetStringWidth(hwnd(), text.c_str());
-          // Add some padding.
-          text_width += (i == 0 ? 7 : 14) * scale_factor();
-          // Do not choose a too small width.
-          width = std::max(width, text_width);
-        }
+      // If there is data in model, use the widest of a few sampled cells,
+      // measuring every row would be too slow for large models.
+      uint32_t rows = model ? model->GetRowCount() : 0;
+      uint32_t step = std::max(1u, rows / kMaxRowsToMeasure);
+      for (uint32_t row = 0; row < rows; row += step) {
+        const base::Value* value = model->GetValue(i, row);
+        if (!value || !value->is_string())
+          continue;
+        base::string16 text = base::UTF8ToUTF16(value->GetString());
+        int text_width = ListView_GetStringWidth(hwnd(), text.c_str());
+        // Add some padding.
+        text_width += (i == 0 ? 7 : 14) * scale_factor();
+        // Do not choose a too small width.
+        width = std::max(width, text_width);
       }
     }
     ListView_SetColumnWidth(hwnd(), i, width);
@@ -110,6 +134,31 @@ int TableImpl::GetRowHeight() const {
   return std::ceil(text->GetOneLineHeight());
 }
 
+void TableImpl::InvalidateText(int column, int row) {
+  text_cache_.erase(GetCellKey(column, row));
+}
+
+void TableImpl::InvalidateRows(int start, int count) {
+  for (auto it = text_cache_.begin(); it != text_cache_.end();) {
+    int row = GetRowFromKey(it->first);
+    if (row >= start && row < start + count)
+      it = text_cache_.erase(it);
+    else
+      ++it;
+  }
+}
+
+void TableImpl::ClearTextCache() {
+  text_cache_.clear();
+}
+
+void TableImpl::ClearCellCaches() {
+  for (const auto& cache : cell_caches_) {
+    if (cache)
+      cache->Clear();
+  }
+}
+
 void TableImpl::OnPaint(HDC dc) {
   // Block redrawing of leftmost item when editing sub item.
   if (edit_proc_) {
@@ -125,6 +174,8 @@ void TableImpl::OnWindowPosChanged(WINDOWPOS* pos) {
   if (!window())
     return;
 
+  static_cast<Table*>(delegate())->OnVisibleRangeMayChange();
+
   // Resize the last column to fill the control.
   int count = GetColumnCount();
   if (count > 0 && columns_[count - 1].width == -1)
@@ -149,6 +200,10 @@ LRESULT TableImpl::OnNotify(int code, LPNMHDR pnmh) {
       auto* nm = reinterpret_cast<NMLVDISPINFO*>(pnmh);
       return OnEndEdit(nm, nm->item.iItem);
     }
+    case LVN_ENDSCROLL: {
+      static_cast<Table*>(delegate())->OnVisibleRangeMayChange();
+      return 0;
+    }
     default:
       return 0;
   }
@@ -169,13 +224,36 @@ LRESULT TableImpl::OnGetDispInfo(NMLVDISPINFO* nm, int column, int row) {
     return 0;
   // Always set text regardless of cell type, for increased accessbility.
   if ((nm->item.mask & LVIF_TEXT) && value->is_string()) {
-    text_cache_ = base::UTF8ToUTF16(value->GetString());
-    nm->item.pszText = const_cast<wchar_t*>(text_cache_.c_str());
+    const base::string16& text =
+        GetCachedText(column, row, value->GetString());
+    nm->item.pszText = const_cast<wchar_t*>(text.c_str());
     return TRUE;
   }
   return 0;
 }
 
+const base::string16& TableImpl::GetCachedText(int column, int row,
+                                               const std::string& value) {
+  uint64_t key = GetCellKey(column, row);
+  auto it = text_cache_.find(key);
+  if (it != text_cache_.end())
+    return it->second;
+  // Drop the texts of rows that have been scrolled away.
+  int per_page = ListView_GetCountPerPage(hwnd());
+  if (text_cache_.size() >= std::max(kMinTextCacheSize,
+                                     per_page * columns_.size() * 2)) {
+    int top = ListView_GetTopIndex(hwnd());
+    for (auto i = text_cache_.begin(); i != text_cache_.end();) {
+      int cached_row = GetRowFromKey(i->first);
+      if (cached_row < top || cached_row > top + per_page)
+        i = text_cache_.erase(i);
+      else
+        ++i;
+    }
+  }
+  return text_cache_.emplace(key, base::UTF8ToUTF16(value)).first->second;
+}
+
 LRESULT TableImpl::OnCustomDraw(NMLVCUSTOMDRAW* nm, int row) {
   if (!has_custom_column_)
     return 0;
@@ -201,6 +279,7 @@ LRESULT TableImpl::OnCustomDraw(NMLVCUSTOMDRAW* nm, int row) {
     if (options.type != Table::ColumnType::Custom || !options.on_draw)
       continue;
     const base::Value* value = model->GetValue(options.column, row);
+    const base::Value empty_value;
     // Calculate the rect of each cell.
     RECT rc;
     ListView_GetSubItemRect(hwnd(), row, i, LVIR_BOUNDS, &rc);
@@ -208,13 +287,14 @@ LRESULT TableImpl::OnCustomDraw(NMLVCUSTOMDRAW* nm, int row) {
     // Reduce the cell area so the focus ring can show.
     int space = 1 * scale_factor();
     rect.Inset(space, space);
-    // Draw.
+    // Draw, the on_draw handler is only called when the cell has changed.
     PainterWin painter(nm->nmcd.hdc, rect.size(), scale_factor());
     painter.TranslatePixel(rect.OffsetFromOrigin());
     painter.ClipRectPixel(Rect(rect.size()));
-    options.on_draw(&painter,
-                    RectF(ScaleSize(SizeF(rect.size()), 1.f / scale_factor())),
-                    value ? value->Clone() : base::Value());
+    cell_caches_[i]->DrawCell(
+        &painter, row,
+        RectF(ScaleSize(SizeF(rect.size()), 1.f / scale_factor())),
+        scale_factor(), value ? *value : empty_value);
   }
   return CDRF_SKIPDEFAULT;
 }
@@ -309,6 +389,8 @@ void Table::PlatformDestroy() {
 
 void Table::PlatformSetModel(TableModel* model) {
   auto* table = static_cast<TableImpl*>(GetNative());
+  table->ClearTextCache();
+  table->ClearCellCaches();
   if (GetModel()) {
     // Deselect everything.
     ListView_SetItemState(table->hwnd(), -1, LVIF_STATE, LVIS_SELECTED);
@@ -376,21 +458,73 @@ int Table::GetSelectedRow() const {
   return ListView_GetNextItem(table->hwnd(), -1, LVNI_SELECTED);
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+std::tuple<int, int> Table::GetVisibleRowRange() const {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  int count = ListView_GetItemCount(table->hwnd());
+  if (count == 0)
+    return std::make_tuple(-1, -1);
+  int top = ListView_GetTopIndex(table->hwnd());
+  // The count per page does not include the partially visible row.
+  int end = std::min(count, top + ListView_GetCountPerPage(table->hwnd()) + 1);
+  return std::make_tuple(top, end);
+}
+
+void Table::PlatformScrollToRow(int row, ScrollAlign align) {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  HWND hwnd = table->hwnd();
+  if (align == ScrollAlign::Nearest) {
+    ListView_EnsureVisible(hwnd, row, FALSE);
+    return;
+  }
+  int top = ListView_GetTopIndex(hwnd);
+  int per_page = ListView_GetCountPerPage(hwnd);
+  int target = row;
+  if (align == ScrollAlign::Center)
+    target = row - per_page / 2;
+  else if (align == ScrollAlign::End)
+    target = row - per_page + 1;
+  // ListView scrolls by pixels in report mode.
+  RECT rc;
+  if (!ListView_GetItemRect(hwnd, top, &rc, LVIR_BOUNDS))
+    return;
+  ListView_Scroll(hwnd, 0, (std::max(target, 0) - top) * (rc.bottom - rc.top));
+}
+
+void Table::NotifyRowsInserted(uint32_t start, uint32_t count) {
+  // The list view is virtual, so only the item count needs updating.
   auto* table = static_cast<TableImpl*>(GetNative());
+  // Rows have been shifted.
+  table->ClearTextCache();
   ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(),
                           LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
+  // Rows after |start| have moved.
+  ListView_RedrawItems(table->hwnd(), start, GetModel()->GetRowCount() - 1);
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::NotifyRowsDeleted(uint32_t start, uint32_t count) {
   auto* table = static_cast<TableImpl*>(GetNative());
+  table->ClearTextCache();
   ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(),
                           LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
+  ::InvalidateRect(table->hwnd(), nullptr, FALSE);
+}
+
+void Table::NotifyRangeChanged(uint32_t start, uint32_t count) {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  table->InvalidateRows(start, count);
+  ListView_RedrawItems(table->hwnd(), start, start + count - 1);
 }
 
 void Table::NotifyValueChange(uint32_t column, uint32_t row) {
   auto* table = static_cast<TableImpl*>(GetNative());
+  table->InvalidateText(column, row);
   ListView_Update(table->hwnd(), row);
 }
 
+void Table::NotifyReset() {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  table->ClearTextCache();
+  ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(), 0);
+}
+
 }  // namespace nu
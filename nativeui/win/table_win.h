@@ -5,9 +5,11 @@
 #ifndef NATIVEUI_WIN_TABLE_WIN_H_
 #define NATIVEUI_WIN_TABLE_WIN_H_
 
+#include <unordered_map>
 #include <vector>
 
 #include "nativeui/table.h"
+#include "nativeui/table_cell_cache.h"
 #include "nativeui/win/subwin_view.h"
 
 namespace nu {
@@ -26,6 +28,12 @@ class TableImpl : public SubwinView {
   void SetRowHeight(int height);
   int GetRowHeight() const;
 
+  // Drop the cached texts of changed cells.
+  void InvalidateText(int column, int row);
+  void InvalidateRows(int start, int count);
+  void ClearTextCache();
+  void ClearCellCaches();
+
  protected:
   CR_BEGIN_MSG_MAP_EX(TableImpl, SubwinView)
     CR_MSG_WM_PAINT(OnPaint)
@@ -40,6 +48,10 @@ class TableImpl : public SubwinView {
   void OnWindowPosChanged(WINDOWPOS* pos);
 
   LRESULT OnGetDispInfo(NMLVDISPINFO* nm, int column, int row);
+
+  // Return the UTF-16 text of the cell, converted from |value| if not cached.
+  const base::string16& GetCachedText(int column, int row,
+                                      const std::string& value);
   LRESULT OnCustomDraw(NMLVCUSTOMDRAW* nm, int row);
   LRESULT OnBeginEdit(NMLVDISPINFO* nm, int row);
   LRESULT OnEndEdit(NMLVDISPINFO* nm, int row);
@@ -51,6 +63,9 @@ class TableImpl : public SubwinView {
 
   std::vector<Table::ColumnOptions> columns_;
 
+  // The drawings of custom cells, null for other types of columns.
+  std::vector<scoped_refptr<TableCellCache>> cell_caches_;
+
   // Whether there are custom drawing cells.
   bool has_custom_column_ = false;
 
@@ -67,8 +82,10 @@ class TableImpl : public SubwinView {
   HIMAGELIST image_list_ = NULL;
 
   // The pszText must be valid when the message is sent, so we have to keep
-  // a cache to avoid returning a pointer to temporary memory.
-  base::string16 text_cache_;
+  // a cache to avoid returning a pointer to temporary memory. The cache is
+  // indexed by row and column, and only keeps the texts of visible rows so
+  // repainting does not convert strings again.
+  std::unordered_map<uint64_t, base::string16> text_cache_;
 };
 
 }  // namespace nu
@@ -5,9 +5,13 @@
 #include "nativeui/text_edit.h"
 
 #include <richedit.h>
+#include <richole.h>
+#include <tom.h>
+#include <wrl/client.h>
 
 #include <algorithm>
 
+#include "base/macros.h"
 #include "base/strings/utf_string_conversions.h"
 #include "nativeui/gfx/attributed_text.h"
 #include "nativeui/win/edit_view.h"
@@ -19,34 +23,171 @@ namespace {
 
 const int kTextEditPadding = 2;
 
+// The IID of ITextDocument, tom.h only declares it.
+const IID kIIDITextDocument = {
+    0x8CC497C0, 0xA1DF, 0x11CE,
+    {0x80, 0x98, 0x00, 0xAA, 0x00, 0x47, 0xBE, 0x5D}};
+
+// Suspend drawing of richedit and keep its selection and scroll position.
+class ScopedEditUpdate {
+ public:
+  explicit ScopedEditUpdate(HWND hwnd) : hwnd_(hwnd) {
+    ::SendMessage(hwnd_, EM_EXGETSEL, 0, reinterpret_cast<LPARAM>(&selection_));
+    ::SendMessage(hwnd_, EM_GETSCROLLPOS, 0,
+                  reinterpret_cast<LPARAM>(&scroll_pos_));
+    ::SendMessage(hwnd_, WM_SETREDRAW, FALSE, 0);
+  }
+
+  ~ScopedEditUpdate() {
+    ::SendMessage(hwnd_, EM_EXSETSEL, 0,
+                  reinterpret_cast<LPARAM>(&selection_));
+    ::SendMessage(hwnd_, EM_SETSCROLLPOS, 0,
+                  reinterpret_cast<LPARAM>(&scroll_pos_));
+    ::SendMessage(hwnd_, WM_SETREDRAW, TRUE, 0);
+    ::InvalidateRect(hwnd_, nullptr, TRUE);
+  }
+
+  CHARRANGE& selection() { return selection_; }
+
+ private:
+  HWND hwnd_;
+  CHARRANGE selection_;
+  POINT scroll_pos_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedEditUpdate);
+};
+
 class TextEditImpl : public EditView {
  public:
   explicit TextEditImpl(View* delegate)
       : EditView(delegate, WS_VSCROLL | ES_MULTILINE) {
     set_switch_focus_on_tab(false);
     SetPlainText();
+    // The default limit is 32K characters.
+    ::SendMessage(hwnd(), EM_EXLIMITTEXT, 0, 0x7FFFFFFE);
+  }
+
+  // Return the Text Object Model of the richedit, which counts paragraphs
+  // instead of wrapped lines.
+  Microsoft::WRL::ComPtr<ITextDocument> GetTextDocument() const {
+    Microsoft::WRL::ComPtr<IRichEditOle> ole;
+    Microsoft::WRL::ComPtr<ITextDocument> document;
+    ::SendMessage(hwnd(), EM_GETOLEINTERFACE, 0,
+                  reinterpret_cast<LPARAM>(ole.GetAddressOf()));
+    if (ole)
+      ole->QueryInterface(kIIDITextDocument,
+                          reinterpret_cast<void**>(document.GetAddressOf()));
+    return document;
+  }
+
+  // Replace the text in range without changing selection, scroll position and
+  // undo stack.
+  void ReplaceRange(LONG start, LONG end, const std::string& text) {
+    ScopedEditUpdate update(hwnd());
+    CHARRANGE range = {start, end};
+    ::SendMessage(hwnd(), EM_EXSETSEL, 0, reinterpret_cast<LPARAM>(&range));
+    RecordSelection();
+    std::wstring text16 = base::UTF8ToUTF16(text);
+    ::SendMessageW(hwnd(), EM_REPLACESEL, FALSE,
+                   reinterpret_cast<LPARAM>(text16.c_str()));
+    // The inserted text takes the format of its neighbor.
+    if (rich_text_ && !text16.empty()) {
+      ::SendMessage(hwnd(), EM_EXGETSEL, 0, reinterpret_cast<LPARAM>(&range));
+      SetFormatForRange(start, range.cpMax, GetDefaultFormat());
+    }
+    // Move the old selection along with the text after the range.
+    CHARRANGE& selection = update.selection();
+    LONG delta = static_cast<LONG>(text16.size()) - (end - start);
+    if (selection.cpMin >= end)
+      selection.cpMin = std::max(start, selection.cpMin + delta);
+    if (selection.cpMax >= end)
+      selection.cpMax = std::max(start, selection.cpMax + delta);
+  }
+
+  // Range attributes require the rich text mode, which can only be changed
+  // when the control is empty.
+  void EnableRichText() {
+    if (rich_text_)
+      return;
+    rich_text_ = true;
+    ScopedEditUpdate update(hwnd());
+    // Do not notify the text change, as the text stays the same.
+    LRESULT mask = ::SendMessage(hwnd(), EM_GETEVENTMASK, 0, 0L);
+    ::SendMessage(hwnd(), EM_SETEVENTMASK, 0, 0L);
+    base::string16 text = GetWindowString(hwnd());
+    ::SetWindowTextW(hwnd(), L"");
+    ::SendMessage(hwnd(), EM_SETTEXTMODE, TM_RICHTEXT, 0L);
+    SetFont(font());
+    ::SetWindowTextW(hwnd(), text.c_str());
+    ::SendMessage(hwnd(), EM_EMPTYUNDOBUFFER, 0, 0L);
+    ::SendMessage(hwnd(), EM_SETEVENTMASK, 0, mask);
+  }
+
+  CHARFORMAT2W GetDefaultFormat() const {
+    CHARFORMAT2W format = {sizeof(format)};
+    ::SendMessage(hwnd(), EM_GETCHARFORMAT, SCF_DEFAULT,
+                  reinterpret_cast<LPARAM>(&format));
+    return format;
+  }
+
+  void SetFormatForRange(LONG start, LONG end, CHARFORMAT2W format) {
+    CHARRANGE range = {start, end};
+    ::SendMessage(hwnd(), EM_EXSETSEL, 0, reinterpret_cast<LPARAM>(&range));
+    ::SendMessage(hwnd(), EM_SETCHARFORMAT, SCF_SELECTION,
+                  reinterpret_cast<LPARAM>(&format));
   }
 
+  bool rich_text() const { return rich_text_; }
+
  protected:
   // SubwinView:
   void OnCommand(UINT code, int command) override {
     TextEdit* edit = static_cast<TextEdit*>(delegate());
-    if (code == EN_CHANGE)
-      edit->on_text_change.Emit(edit);
+    if (code != EN_CHANGE)
+      return;
+    edit->on_text_change.Emit(edit);
+    int start, removed;
+    std::string inserted;
+    bool has_listener = !edit->on_text_range_change.IsEmpty();
+    GetChangedRange(&start, &removed, has_listener ? &inserted : nullptr);
+    if (has_listener)
+      edit->on_text_range_change.Emit(edit, start, removed, inserted);
   }
 
  private:
   CR_BEGIN_MSG_MAP_EX(TextEditImpl, SubwinView)
     CR_MSG_WM_KEYDOWN(OnKeyDown)
+    CR_MSG_WM_CHAR(OnChar)
   CR_END_MSG_MAP()
 
   void OnKeyDown(UINT ch, UINT repeat, UINT flags) {
+    // Rich text mode pastes formats, only paste text.
+    bool control = ::GetKeyState(VK_CONTROL) & 0x8000;
+    bool shift = ::GetKeyState(VK_SHIFT) & 0x8000;
+    if (rich_text_ &&
+        ((control && ch == 'V') || (shift && ch == VK_INSERT))) {
+      Paste();
+      return;
+    }
+    // Changes not made by typing are notified as replacing the whole text.
+    ClearRecordedSelection();
+    if (ch == VK_DELETE)
+      RecordSelection();
     TextEdit* edit = static_cast<TextEdit*>(delegate());
     if (ch == VK_RETURN && edit->should_insert_new_line)
       SetMsgHandled(!edit->should_insert_new_line(edit));
     else
       SetMsgHandled(false);
   }
+
+  void OnChar(UINT ch, UINT repeat, UINT flags) {
+    // Ctrl+Y and Ctrl+Z.
+    if (ch != 0x19 && ch != 0x1A)
+      RecordSelection();
+    SetMsgHandled(false);
+  }
+
+  bool rich_text_ = false;
 };
 
 }  // namespace
@@ -113,10 +254,11 @@ void TextEdit::SelectRange(int start, int end) {
 }
 
 std::string TextEdit::GetTextInRange(int start, int end) const {
-  return GetText().substr(start, end - start);
+  return static_cast<EditView*>(GetNative())->GetTextInRange(start, end);
 }
 
 void TextEdit::InsertText(const std::string& text) {
+  static_cast<EditView*>(GetNative())->RecordSelection();
   HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
   ::SendMessageW(hwnd, EM_REPLACESEL, TRUE,
                  reinterpret_cast<LPARAM>(base::UTF8ToUTF16(text).c_str()));
@@ -128,6 +270,7 @@ void TextEdit::InsertTextAt(const std::string& text, int pos) {
 }
 
 void TextEdit::Delete() {
+  static_cast<EditView*>(GetNative())->RecordSelection();
   HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
   ::SendMessage(hwnd, EM_REPLACESEL, TRUE, reinterpret_cast<LPARAM>(L""));
 }
@@ -152,6 +295,90 @@ void TextEdit::SetScrollbarPolicy(Scroll::Policy h_policy,
   ::SetWindowLong(hwnd, GWL_STYLE, style);
 }
 
+void TextEdit::PlatformAppendText(const std::string& text) {
+  auto* edit = static_cast<TextEditImpl*>(GetNative());
+  GETTEXTLENGTHEX gtl = {GTL_NUMCHARS | GTL_PRECISE, 1200};
+  LONG length = static_cast<LONG>(::SendMessage(
+      edit->hwnd(), EM_GETTEXTLENGTHEX, reinterpret_cast<WPARAM>(&gtl), 0));
+  edit->ReplaceRange(length, length, text);
+}
+
+int TextEdit::PlatformGetLineCount() const {
+  auto* edit = static_cast<TextEditImpl*>(GetNative());
+  Microsoft::WRL::ComPtr<ITextDocument> document = edit->GetTextDocument();
+  Microsoft::WRL::ComPtr<ITextRange> range;
+  long index = 1;
+  if (document &&
+      SUCCEEDED(document->Range(tomForward, tomForward,
+                                range.GetAddressOf())))
+    range->GetIndex(tomParagraph, &index);
+  return static_cast<int>(index);
+}
+
+void TextEdit::PlatformDeleteLines(int count) {
+  auto* edit = static_cast<TextEditImpl*>(GetNative());
+  Microsoft::WRL::ComPtr<ITextDocument> document = edit->GetTextDocument();
+  Microsoft::WRL::ComPtr<ITextRange> range;
+  long end = 0;
+  if (!document || FAILED(document->Range(0, 0, range.GetAddressOf())) ||
+      FAILED(range->SetIndex(tomParagraph, count + 1, 0)) ||
+      FAILED(range->GetStart(&end)))
+    return;
+  edit->ReplaceRange(0, end, "");
+  // The recorded actions no longer match the positions of text.
+  ::SendMessage(edit->hwnd(), EM_EMPTYUNDOBUFFER, 0, 0);
+}
+
+bool TextEdit::PlatformIsScrolledToEnd() const {
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  SCROLLINFO si = {sizeof(si), SIF_PAGE | SIF_POS | SIF_RANGE};
+  if (!::GetScrollInfo(hwnd, SB_VERT, &si))
+    return true;
+  return si.nPos + static_cast<int>(si.nPage) >= si.nMax;
+}
+
+void TextEdit::PlatformScrollToEnd() {
+  HWND hwnd = static_cast<SubwinView*>(GetNative())->hwnd();
+  ::SendMessage(hwnd, WM_VSCROLL, SB_BOTTOM, 0);
+}
+
+void TextEdit::SetAttributesForRanges(
+    const std::vector<RangeAttributes>& ranges) {
+  auto* edit = static_cast<TextEditImpl*>(GetNative());
+  edit->EnableRichText();
+  ScopedEditUpdate update(edit->hwnd());
+  for (const RangeAttributes& range : ranges) {
+    CHARFORMAT2W format = {sizeof(format)};
+    if (range.font) {
+      Font* font = range.font.get();
+      format.dwMask |= CFM_FACE | CFM_SIZE | CFM_WEIGHT | CFM_BOLD |
+                       CFM_ITALIC;
+      wcsncpy_s(format.szFaceName, font->GetName16().c_str(), _TRUNCATE);
+      // The size is in twips, which is 1/20 point or 1/15 DIP.
+      format.yHeight = static_cast<LONG>(font->GetSize() * 15);
+      format.wWeight = static_cast<WORD>(font->GetWeight());
+      if (font->GetWeight() >= Font::Weight::Bold)
+        format.dwEffects |= CFE_BOLD;
+      if (font->GetStyle() == Font::Style::Italic)
+        format.dwEffects |= CFE_ITALIC;
+    }
+    if (range.color) {
+      format.dwMask |= CFM_COLOR;
+      format.crTextColor = range.color->ToCOLORREF();
+    }
+    if (format.dwMask)
+      edit->SetFormatForRange(range.start, range.end, format);
+  }
+}
+
+void TextEdit::ClearAttributesInRange(int start, int end) {
+  auto* edit = static_cast<TextEditImpl*>(GetNative());
+  if (!edit->rich_text())
+    return;
+  ScopedEditUpdate update(edit->hwnd());
+  edit->SetFormatForRange(start, end, edit->GetDefaultFormat());
+}
+
 RectF TextEdit::GetTextBounds() const {
   auto* edit = static_cast<TextEditImpl*>(GetNative());
   // Calculate the text bounds.
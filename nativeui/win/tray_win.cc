@@ -5,9 +5,13 @@
 
 #include "nativeui/win/tray_win.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "base/win/scoped_hdc.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/geometry/rect_f.h"
 #include "nativeui/gfx/image.h"
 #include "nativeui/gfx/win/gdiplus.h"
@@ -100,16 +104,72 @@ void TrayImpl::SetImage(Image* icon) {
     return;
   // Convert image to bitmap icon.
   int width = ::GetSystemMetrics(SM_CXSMICON);
-  icon_ = icon->GetHICON(SizeF(width, width));
+  ModifyIcon(icon->GetHICON(SizeF(width, width)));
+}
+
+void TrayImpl::SetImageFromCanvas(Canvas* canvas) {
+  if (!host_)
+    return;
+  CanvasPixels pixels = canvas->LockPixels();
+  const Size& size = pixels.size;
+  if (size != bitmap_size_) {
+    BITMAPINFOHEADER bih = {0};
+    bih.biSize = sizeof(BITMAPINFOHEADER);
+    bih.biWidth = size.width();
+    bih.biHeight = -size.height();
+    bih.biPlanes = 1;
+    bih.biBitCount = 32;
+    bih.biCompression = BI_RGB;
+    base::win::ScopedGetDC dc(NULL);
+    color_bitmap_.reset(::CreateDIBSection(
+        dc, reinterpret_cast<BITMAPINFO*>(&bih), DIB_RGB_COLORS,
+        &color_bits_, NULL, 0));
+    // The mask is ignored for 32bpp icons but still required, rows of
+    // monochrome bitmaps are aligned to 16 bits.
+    std::vector<uint8_t> mask((size.width() + 15) / 16 * 2 * size.height());
+    mask_bitmap_.reset(::CreateBitmap(size.width(), size.height(), 1, 1,
+                                      mask.data()));
+    bitmap_size_ = size;
+  }
+  if (!color_bitmap_.is_valid() || !mask_bitmap_.is_valid()) {
+    canvas->UnlockPixels();
+    bitmap_size_ = Size();
+    LOG(WARNING) << "Error creating bitmaps for tray image";
+    return;
+  }
 
-  // Create the icon.
+  // Icons take straight alpha while canvas is premultiplied.
+  auto* dest = static_cast<uint8_t*>(color_bits_);
+  for (int y = 0; y < size.height(); ++y) {
+    const uint8_t* src = static_cast<const uint8_t*>(pixels.buffer.content()) +
+                         y * pixels.stride;
+    for (int x = 0; x < size.width(); ++x, src += 4, dest += 4) {
+      uint8_t alpha = src[3];
+      for (int i = 0; i < 3; ++i)
+        dest[i] = alpha ? static_cast<uint8_t>(
+                              std::min(src[i] * 255 / alpha, 255)) : 0;
+      dest[3] = alpha;
+    }
+  }
+  canvas->UnlockPixels();
+
+  ICONINFO info = {0};
+  info.fIcon = TRUE;
+  info.hbmMask = mask_bitmap_.get();
+  info.hbmColor = color_bitmap_.get();
+  ModifyIcon(base::win::ScopedHICON(::CreateIconIndirect(&info)));
+}
+
+void TrayImpl::ModifyIcon(base::win::ScopedHICON icon) {
   NOTIFYICONDATA icon_data;
   InitIconData(&icon_data);
   icon_data.uFlags = NIF_ICON;
-  icon_data.hIcon = icon_.get();
+  icon_data.hIcon = icon.get();
   BOOL result = Shell_NotifyIcon(NIM_MODIFY, &icon_data);
   if (!result)
     LOG(WARNING) << "Error setting tray image";
+  // The shell copies the icon, the previous one is released after modifying.
+  icon_ = std::move(icon);
 }
 
 void TrayImpl::InitIconData(NOTIFYICONDATA* icon_data) {
@@ -143,6 +203,10 @@ void Tray::SetImage(scoped_refptr<Image> icon) {
   tray_->SetImage(icon.get());
 }
 
+void Tray::SetImageFromCanvas(scoped_refptr<Canvas> canvas) {
+  tray_->SetImageFromCanvas(canvas.get());
+}
+
 void Tray::SetMenu(scoped_refptr<Menu> menu) {
   menu_ = std::move(menu);
 }
@@ -9,11 +9,13 @@
 #include <shellapi.h>  // NOLINT
 
 #include "base/win/scoped_gdi_object.h"
+#include "nativeui/gfx/geometry/size.h"
 #include "nativeui/tray.h"
 #include "nativeui/win/util/tray_host.h"
 
 namespace nu {
 
+class Canvas;
 class Rect;
 
 class TrayImpl {
@@ -26,12 +28,14 @@ class TrayImpl {
   void ResetIcon();
   Rect GetBounds() const;
   void SetImage(Image* icon);
+  void SetImageFromCanvas(Canvas* canvas);
 
   UINT icon_id() const { return icon_id_; }
   HWND hwnd() const { return host_->hwnd(); }
 
  private:
   void InitIconData(NOTIFYICONDATA* icon_data);
+  void ModifyIcon(base::win::ScopedHICON icon);
 
   Tray* delegate_;
 
@@ -44,6 +48,13 @@ class TrayImpl {
   // The currently-displayed icon for the window.
   base::win::ScopedHICON icon_;
 
+  // The bitmaps that icons are created from when showing canvas, kept across
+  // updates and only recreated when the size of canvas changes.
+  base::win::ScopedBitmap color_bitmap_;
+  base::win::ScopedBitmap mask_bitmap_;
+  void* color_bits_ = nullptr;
+  Size bitmap_size_;
+
   DISALLOW_COPY_AND_ASSIGN(TrayImpl);
 };
 
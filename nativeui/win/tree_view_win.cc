@@ -0,0 +1,295 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree_view.h"
+
+#include <commctrl.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/strings/utf_string_conversions.h"
+#include "base/values.h"
+#include "nativeui/win/subwin_view.h"
+
+namespace nu {
+
+namespace {
+
+// Number of spaces used for indenting each level.
+const int kIndentSpaces = 4;
+
+// Win32 has no virtual TreeView control, so the tree is shown as a virtual
+// ListView of the expanded nodes, with the expanders drawn in text.
+class TreeViewImpl : public SubwinView {
+ public:
+  explicit TreeViewImpl(TreeView* delegate)
+      : SubwinView(delegate, WC_LISTVIEW,
+                   LVS_SINGLESEL | LVS_SHOWSELALWAYS | LVS_REPORT |
+                   LVS_OWNERDATA | WS_CHILD | WS_VISIBLE) {
+    set_focusable(true);
+    ListView_SetExtendedListViewStyle(
+        hwnd(), LVS_EX_DOUBLEBUFFER | LVS_EX_FULLROWSELECT);
+  }
+
+  void AddColumn(const base::string16& title) {
+    LVCOLUMNA col = {0};
+    col.mask = LVCF_TEXT;
+    // The pszText is LPSTR even under Unicode build.
+    col.pszText =
+        const_cast<char*>(reinterpret_cast<const char*>(title.c_str()));
+    ListView_InsertColumn(hwnd(), column_count_, &col);
+    ++column_count_;
+    ListView_SetColumnWidth(hwnd(), column_count_ - 1,
+                            LVSCW_AUTOSIZE_USEHEADER);
+  }
+
+  int GetColumnCount() const { return column_count_; }
+
+  // Flatten the expanded nodes into rows, and keep the selection.
+  void Rebuild() {
+    TreeView::Node* selected = GetSelectedNode();
+    rows_.clear();
+    if (tree()->GetModel())
+      AppendRows(tree()->GetRoot(), 0);
+    ListView_SetItemCountEx(hwnd(), rows_.size(),
+                            LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
+    ::InvalidateRect(hwnd(), nullptr, FALSE);
+    int row = GetRowOfNode(selected);
+    ListView_SetItemState(hwnd(), -1, 0, LVIS_SELECTED);
+    if (row >= 0)
+      ListView_SetItemState(hwnd(), row, LVIS_SELECTED, LVIS_SELECTED);
+  }
+
+  void Expand(TreeView::Node* node, bool expand) {
+    if (expand == node->expanded)
+      return;
+    if (expand) {
+      if (!tree()->HasChildren(node))
+        return;
+      tree()->OnNodeExpand(node);
+    } else {
+      tree()->OnNodeCollapse(node);
+    }
+    Rebuild();
+  }
+
+  void Select(TreeView::Node* node) {
+    int row = GetRowOfNode(node);
+    if (row < 0)
+      return;
+    ListView_SetItemState(hwnd(), row, LVIS_SELECTED, LVIS_SELECTED);
+    ListView_EnsureVisible(hwnd(), row, FALSE);
+  }
+
+  TreeView::Node* GetSelectedNode() const {
+    int row = ListView_GetNextItem(hwnd(), -1, LVNI_SELECTED);
+    if (row < 0 || static_cast<size_t>(row) >= rows_.size())
+      return nullptr;
+    return rows_[row].node;
+  }
+
+  void UpdateNode(TreeView::Node* node) {
+    int row = GetRowOfNode(node);
+    if (row >= 0)
+      ListView_Update(hwnd(), row);
+  }
+
+ protected:
+  // SubwinView:
+  LRESULT OnNotify(int code, LPNMHDR pnmh) override {
+    switch (pnmh->code) {
+      case LVN_GETDISPINFO:
+        return OnGetDispInfo(reinterpret_cast<NMLVDISPINFO*>(pnmh));
+      case NM_CLICK:
+      case NM_DBLCLK: {
+        auto* nm = reinterpret_cast<NMITEMACTIVATE*>(pnmh);
+        if (nm->iItem < 0 || static_cast<size_t>(nm->iItem) >= rows_.size())
+          return 0;
+        const Row& row = rows_[nm->iItem];
+        // Single click only toggles when clicking on the expander.
+        if (pnmh->code == NM_CLICK) {
+          RECT rc;
+          ListView_GetItemRect(hwnd(), nm->iItem, &rc, LVIR_LABEL);
+          base::string16 prefix = GetPrefix(row);
+          int width = ListView_GetStringWidth(hwnd(), prefix.c_str());
+          if (nm->ptAction.x > rc.left + width)
+            return 0;
+        }
+        Expand(row.node, !row.node->expanded);
+        return 0;
+      }
+      case LVN_KEYDOWN: {
+        auto* nm = reinterpret_cast<NMLVKEYDOWN*>(pnmh);
+        TreeView::Node* node = GetSelectedNode();
+        if (!node)
+          return 0;
+        if (nm->wVKey == VK_RIGHT)
+          Expand(node, true);
+        else if (nm->wVKey == VK_LEFT && node->expanded)
+          Expand(node, false);
+        else if (nm->wVKey == VK_LEFT && node->parent->parent)
+          Select(node->parent);
+        return 0;
+      }
+      case LVN_ITEMCHANGED: {
+        auto* nm = reinterpret_cast<NMLISTVIEW*>(pnmh);
+        if ((nm->uChanged & LVIF_STATE) &&
+            ((nm->uOldState ^ nm->uNewState) & LVIS_SELECTED))
+          tree()->on_selection_change.Emit(tree());
+        return 0;
+      }
+      default:
+        return 0;
+    }
+  }
+
+ private:
+  struct Row {
+    TreeView::Node* node;
+    int depth;
+  };
+
+  TreeView* tree() const { return static_cast<TreeView*>(delegate()); }
+
+  void AppendRows(TreeView::Node* node, int depth) {
+    for (const auto& child : tree()->GetChildren(node)) {
+      rows_.push_back({child.get(), depth});
+      if (child->expanded)
+        AppendRows(child.get(), depth + 1);
+    }
+  }
+
+  int GetRowOfNode(TreeView::Node* node) const {
+    if (!node)
+      return -1;
+    auto it = std::find_if(rows_.begin(), rows_.end(),
+                           [node](const Row& row) { return row.node == node; });
+    return it == rows_.end() ? -1 : static_cast<int>(it - rows_.begin());
+  }
+
+  // The indentation and expander shown before the text of first column.
+  base::string16 GetPrefix(const Row& row) const {
+    base::string16 prefix(row.depth * kIndentSpaces, L' ');
+    if (!tree()->HasChildren(row.node))
+      prefix += L"   ";
+    else if (row.node->expanded)
+      prefix += L"\u25BE ";
+    else
+      prefix += L"\u25B8 ";
+    return prefix;
+  }
+
+  LRESULT OnGetDispInfo(NMLVDISPINFO* nm) {
+    int row = nm->item.iItem;
+    if (!(nm->item.mask & LVIF_TEXT) ||
+        row < 0 || static_cast<size_t>(row) >= rows_.size())
+      return 0;
+    TreeModel* model = tree()->GetModel();
+    if (!model)
+      return 0;
+    const base::Value* value =
+        model->GetValue(rows_[row].node->id, nm->item.iSubItem);
+    // The pszText must be valid after returning, so keep it in member.
+    text_.clear();
+    if (nm->item.iSubItem == 0)
+      text_ = GetPrefix(rows_[row]);
+    if (value && value->is_string())
+      text_ += base::UTF8ToUTF16(value->GetString());
+    nm->item.pszText = const_cast<wchar_t*>(text_.c_str());
+    return TRUE;
+  }
+
+  int column_count_ = 0;
+  std::vector<Row> rows_;
+  base::string16 text_;
+};
+
+}  // namespace
+
+NativeView TreeView::PlatformCreate() {
+  return new TreeViewImpl(this);
+}
+
+void TreeView::PlatformDestroy() {
+}
+
+void TreeView::PlatformSetModel(TreeModel* model) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  // Scroll back to top, otherwise listview will have rendering bugs.
+  ListView_EnsureVisible(tree->hwnd(), 0, FALSE);
+  tree->Rebuild();
+}
+
+void TreeView::AddColumn(const std::string& title) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  tree->AddColumn(base::UTF8ToUTF16(title));
+}
+
+int TreeView::GetColumnCount() const {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  return tree->GetColumnCount();
+}
+
+void TreeView::SetColumnsVisible(bool visible) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  LONG styles = ::GetWindowLong(tree->hwnd(), GWL_STYLE);
+  if (!visible)
+    styles |= LVS_NOCOLUMNHEADER;
+  else
+    styles &= ~LVS_NOCOLUMNHEADER;
+  ::SetWindowLong(tree->hwnd(), GWL_STYLE, styles);
+}
+
+bool TreeView::IsColumnsVisible() const {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  return !(::GetWindowLong(tree->hwnd(), GWL_STYLE) & LVS_NOCOLUMNHEADER);
+}
+
+void TreeView::PlatformExpandNode(Node* node, bool expand) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  tree->Expand(node, expand);
+}
+
+void TreeView::PlatformSelectNode(Node* node) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  tree->Select(node);
+}
+
+TreeView::Node* TreeView::PlatformGetSelectedNode() const {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  return tree->GetSelectedNode();
+}
+
+void TreeView::PlatformChildrenInserted(Node* parent,
+                                        uint32_t start,
+                                        uint32_t count) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  // The new rows are only visible when the parent is expanded.
+  if (parent->expanded)
+    tree->Rebuild();
+  else
+    tree->UpdateNode(parent);
+}
+
+void TreeView::PlatformChildrenDeleted(Node* parent,
+                                       uint32_t start,
+                                       const Nodes& removed) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  // The parent may have been collapsed after losing all children.
+  tree->Rebuild();
+}
+
+void TreeView::PlatformNodeChanged(Node* node) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  tree->UpdateNode(node);
+}
+
+void TreeView::PlatformChildrenReset(Node* parent, const Nodes& removed) {
+  auto* tree = static_cast<TreeViewImpl*>(GetNative());
+  tree->Rebuild();
+}
+
+}  // namespace nu
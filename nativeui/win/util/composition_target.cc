@@ -0,0 +1,115 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/win/util/composition_target.h"
+
+#include "base/logging.h"
+
+namespace nu {
+
+namespace {
+
+using DCompositionCreateDeviceFunc = HRESULT (WINAPI*)(IDXGIDevice*,
+                                                       REFIID,
+                                                       void**);
+
+}  // namespace
+
+CompositionDevice::CompositionDevice() {
+  // Load dynamically to keep running on Windows 7.
+  static auto create_device = []() -> DCompositionCreateDeviceFunc {
+    HMODULE dcomp_dll = ::LoadLibrary(L"dcomp.dll");
+    if (!dcomp_dll)
+      return nullptr;
+    return reinterpret_cast<DCompositionCreateDeviceFunc>(
+        ::GetProcAddress(dcomp_dll, "DCompositionCreateDevice"));
+  }();
+  if (!create_device)
+    return;
+
+  // Fallback to software rendering when there is no usable GPU.
+  const UINT flags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+  HRESULT hr = ::D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr,
+                                   flags, nullptr, 0, D3D11_SDK_VERSION,
+                                   &d3d_device_, nullptr, &d3d_context_);
+  if (FAILED(hr))
+    hr = ::D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_WARP, nullptr,
+                             flags, nullptr, 0, D3D11_SDK_VERSION,
+                             &d3d_device_, nullptr, &d3d_context_);
+  if (FAILED(hr)) {
+    LOG(ERROR) << "Failed to create Direct3D device: " << hr;
+    return;
+  }
+
+  Microsoft::WRL::ComPtr<IDXGIDevice> dxgi_device;
+  if (FAILED(d3d_device_.As(&dxgi_device)))
+    return;
+  hr = create_device(dxgi_device.Get(), IID_PPV_ARGS(&dcomp_device_));
+  if (FAILED(hr))
+    LOG(ERROR) << "Failed to create DirectComposition device: " << hr;
+}
+
+CompositionDevice::~CompositionDevice() {
+}
+
+CompositionTarget::CompositionTarget(CompositionDevice* device, HWND hwnd)
+    : device_(device) {
+  IDCompositionDevice* dcomp = device_->dcomp_device();
+  if (FAILED(dcomp->CreateTargetForHwnd(hwnd, TRUE, &target_)) ||
+      FAILED(dcomp->CreateVisual(&visual_)) ||
+      FAILED(target_->SetRoot(visual_.Get()))) {
+    LOG(ERROR) << "Failed to create composition target for window";
+    target_.Reset();
+  }
+}
+
+CompositionTarget::~CompositionTarget() {
+}
+
+bool CompositionTarget::Update(const void* bits,
+                               const Size& size,
+                               const Rect& dirty) {
+  if (!target_ || size.IsEmpty())
+    return false;
+
+  Rect rect(dirty);
+  if (!surface_ || surface_size_ != size) {
+    surface_.Reset();
+    HRESULT hr = device_->dcomp_device()->CreateSurface(
+        size.width(), size.height(), DXGI_FORMAT_B8G8R8A8_UNORM,
+        DXGI_ALPHA_MODE_PREMULTIPLIED, &surface_);
+    if (FAILED(hr))
+      return false;
+    visual_->SetContent(surface_.Get());
+    surface_size_ = size;
+    // The new surface has no content.
+    rect = Rect(size);
+  }
+  rect.Intersect(Rect(size));
+  if (rect.IsEmpty())
+    return true;
+
+  RECT update_rect = rect.ToRECT();
+  POINT offset;
+  Microsoft::WRL::ComPtr<ID3D11Texture2D> texture;
+  if (FAILED(surface_->BeginDraw(&update_rect, IID_PPV_ARGS(&texture),
+                                 &offset)))
+    return false;
+  // The texture is an atlas, the update area is placed at |offset|.
+  D3D11_BOX box = {static_cast<UINT>(offset.x),
+                   static_cast<UINT>(offset.y),
+                   0,
+                   static_cast<UINT>(offset.x + rect.width()),
+                   static_cast<UINT>(offset.y + rect.height()),
+                   1};
+  const UINT stride = size.width() * 4;
+  const uint8_t* src = static_cast<const uint8_t*>(bits) +
+                       rect.y() * stride + rect.x() * 4;
+  device_->d3d_context()->UpdateSubresource(texture.Get(), 0, &box, src,
+                                            stride, 0);
+  surface_->EndDraw();
+  return SUCCEEDED(device_->dcomp_device()->Commit());
+}
+
+}  // namespace nu
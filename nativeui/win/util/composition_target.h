@@ -0,0 +1,62 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_WIN_UTIL_COMPOSITION_TARGET_H_
+#define NATIVEUI_WIN_UTIL_COMPOSITION_TARGET_H_
+
+#include <d3d11.h>
+#include <dcomp.h>
+#include <wrl/client.h>
+
+#include "base/macros.h"
+#include "nativeui/gfx/geometry/rect.h"
+
+namespace nu {
+
+// Holds the Direct3D and DirectComposition devices, which are shared by all
+// windows composed with DirectComposition.
+class CompositionDevice {
+ public:
+  CompositionDevice();
+  ~CompositionDevice();
+
+  // DirectComposition is only available on Windows 8 and later.
+  bool IsValid() const { return dcomp_device_ != nullptr; }
+
+  ID3D11DeviceContext* d3d_context() const { return d3d_context_.Get(); }
+  IDCompositionDevice* dcomp_device() const { return dcomp_device_.Get(); }
+
+ private:
+  Microsoft::WRL::ComPtr<ID3D11Device> d3d_device_;
+  Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_context_;
+  Microsoft::WRL::ComPtr<IDCompositionDevice> dcomp_device_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompositionDevice);
+};
+
+// Presents the contents of a window created with WS_EX_NOREDIRECTIONBITMAP,
+// by copying pixels to a DirectComposition surface. Unlike layered windows,
+// only the updated area is uploaded and the rest of surface is kept.
+class CompositionTarget {
+ public:
+  CompositionTarget(CompositionDevice* device, HWND hwnd);
+  ~CompositionTarget();
+
+  // Copy the |dirty| area of |bits|, which are premultiplied BGRA pixels
+  // stored top-down without padding.
+  bool Update(const void* bits, const Size& size, const Rect& dirty);
+
+ private:
+  CompositionDevice* device_;
+  Microsoft::WRL::ComPtr<IDCompositionTarget> target_;
+  Microsoft::WRL::ComPtr<IDCompositionVisual> visual_;
+  Microsoft::WRL::ComPtr<IDCompositionSurface> surface_;
+  Size surface_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompositionTarget);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_WIN_UTIL_COMPOSITION_TARGET_H_
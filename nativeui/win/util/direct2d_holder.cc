@@ -0,0 +1,79 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/win/util/direct2d_holder.h"
+
+#include <utility>
+
+#include "base/logging.h"
+
+namespace nu {
+
+Direct2DHolder::Direct2DHolder() {
+  HRESULT hr = ::D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED,
+                                   d2d_factory_.GetAddressOf());
+  CHECK(SUCCEEDED(hr)) << "Failed to create Direct2D factory";
+  hr = ::DWriteCreateFactory(
+      DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory),
+      reinterpret_cast<IUnknown**>(dwrite_factory_.GetAddressOf()));
+  CHECK(SUCCEEDED(hr)) << "Failed to create DirectWrite factory";
+}
+
+Direct2DHolder::~Direct2DHolder() {}
+
+Microsoft::WRL::ComPtr<ID2D1DCRenderTarget>
+Direct2DHolder::CreateDCRenderTarget() {
+  D2D1_RENDER_TARGET_PROPERTIES properties = D2D1::RenderTargetProperties(
+      D2D1_RENDER_TARGET_TYPE_DEFAULT,
+      D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM,
+                        D2D1_ALPHA_MODE_PREMULTIPLIED));
+  Microsoft::WRL::ComPtr<ID2D1DCRenderTarget> target;
+  HRESULT hr = d2d_factory_->CreateDCRenderTarget(&properties, &target);
+  CHECK(SUCCEEDED(hr)) << "Failed to create Direct2D render target: " << hr;
+  return target;
+}
+
+ID2D1DCRenderTarget* Direct2DHolder::AcquireDCRenderTarget() {
+  if (dc_target_in_use_)
+    return nullptr;
+  if (!dc_target_)
+    dc_target_ = CreateDCRenderTarget();
+  dc_target_in_use_ = true;
+  return dc_target_.Get();
+}
+
+void Direct2DHolder::ReleaseDCRenderTarget(bool recreate) {
+  dc_target_in_use_ = false;
+  if (recreate)
+    dc_target_.Reset();
+}
+
+IDWriteTextFormat* Direct2DHolder::GetTextFormat(Font* font) {
+  TextFormatKey key(font->GetName16(), font->GetSize(), font->GetWeight(),
+                    font->GetStyle());
+  auto it = text_formats_.find(key);
+  if (it != text_formats_.end())
+    return it->second.Get();
+  // Fonts loaded from files are not in the system collection, and would fall
+  // back to the default family.
+  Microsoft::WRL::ComPtr<IDWriteTextFormat> format;
+  HRESULT hr = dwrite_factory_->CreateTextFormat(
+      font->GetName16().c_str(), nullptr,
+      static_cast<DWRITE_FONT_WEIGHT>(font->GetWeight()),
+      font->GetStyle() == Font::Style::Italic ? DWRITE_FONT_STYLE_ITALIC
+                                              : DWRITE_FONT_STYLE_NORMAL,
+      DWRITE_FONT_STRETCH_NORMAL,
+      font->GetSize(),
+      L"",
+      &format);
+  if (FAILED(hr)) {
+    LOG(ERROR) << "Failed to create text format: " << hr;
+    return nullptr;
+  }
+  IDWriteTextFormat* result = format.Get();
+  text_formats_.emplace(std::move(key), std::move(format));
+  return result;
+}
+
+}  // namespace nu
@@ -0,0 +1,62 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_WIN_UTIL_DIRECT2D_HOLDER_H_
+#define NATIVEUI_WIN_UTIL_DIRECT2D_HOLDER_H_
+
+#include <d2d1.h>
+#include <dwrite.h>
+#include <wrl/client.h>
+
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "base/macros.h"
+#include "nativeui/gfx/font.h"
+
+namespace nu {
+
+// Holds the factories of Direct2D and DirectWrite, which are expensive to
+// create and can be shared by all painters.
+class Direct2DHolder {
+ public:
+  Direct2DHolder();
+  ~Direct2DHolder();
+
+  // Create a new DC render target, the DPI should be set before drawing.
+  Microsoft::WRL::ComPtr<ID2D1DCRenderTarget> CreateDCRenderTarget();
+
+  // Borrow the DC render target shared by painters, so the resources created
+  // for it like bitmaps can be reused between paints. Returns nullptr if it
+  // is being used by another painter.
+  ID2D1DCRenderTarget* AcquireDCRenderTarget();
+
+  // Give back the shared target, which is dropped if |recreate| is true.
+  void ReleaseDCRenderTarget(bool recreate);
+
+  // Return the cached text format of |font|, nullptr on failure.
+  IDWriteTextFormat* GetTextFormat(Font* font);
+
+  ID2D1Factory* d2d_factory() const { return d2d_factory_.Get(); }
+  IDWriteFactory* dwrite_factory() const { return dwrite_factory_.Get(); }
+
+ private:
+  Microsoft::WRL::ComPtr<ID2D1Factory> d2d_factory_;
+  Microsoft::WRL::ComPtr<IDWriteFactory> dwrite_factory_;
+
+  Microsoft::WRL::ComPtr<ID2D1DCRenderTarget> dc_target_;
+  bool dc_target_in_use_ = false;
+
+  using TextFormatKey =
+      std::tuple<std::wstring, float, Font::Weight, Font::Style>;
+  std::map<TextFormatKey, Microsoft::WRL::ComPtr<IDWriteTextFormat>>
+      text_formats_;
+
+  DISALLOW_COPY_AND_ASSIGN(Direct2DHolder);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_WIN_UTIL_DIRECT2D_HOLDER_H_
@@ -8,6 +8,7 @@
 #include "base/logging.h"
 #include "nativeui/gfx/geometry/point.h"
 #include "nativeui/gfx/geometry/size.h"
+#include "nativeui/win/util/window_message_stats.h"
 
 // Based on WTL version 8.0 atlcrack.h
 
@@ -35,6 +36,7 @@
                             WPARAM wParam,                         \
                             LPARAM lParam,                         \
                             LRESULT* result) override {            \
+    ::nu::ScopedMessageTimer::SetMessageMapName(#theClass);        \
     if (_ProcessWindowMessage(hWnd, uMsg, wParam, lParam, result)) \
       return true;                                                 \
     return parent::ProcessWindowMessage(                           \
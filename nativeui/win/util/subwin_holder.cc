@@ -4,6 +4,7 @@
 
 #include "nativeui/win/util/subwin_holder.h"
 
+#include "nativeui/win/menu_base_win.h"
 #include "nativeui/win/subwin_view.h"
 #include "nativeui/win/util/hwnd_util.h"
 
@@ -29,6 +30,11 @@ LRESULT SubwinHolder::OnNotify(int id, LPNMHDR pnmh) {
   return control->OnNotify(id, pnmh);
 }
 
+void SubwinHolder::OnInitMenuPopup(HMENU menu, UINT index,
+                                   BOOL is_system_menu) {
+  DispatchInitMenuPopup(menu);
+}
+
 HBRUSH SubwinHolder::OnCtlColorStatic(HDC dc, HWND window) {
   auto* control = reinterpret_cast<SubwinView*>(GetWindowUserData(window));
   if (!control)
@@ -6,42 +6,138 @@
 
 #include <utility>
 
+#include "nativeui/message_loop.h"
+
+// Not defined in older SDKs.
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
 namespace nu {
 
-TimerHost::TimerHost() {}
+namespace {
+
+// The timers used for idle tasks and MessageLoop's tasks.
+const UINT_PTR kIdleTimerId = 1;
+const UINT_PTR kTasksTimerId = 2;
+
+}  // namespace
 
-TimerHost::~TimerHost() {}
+TimerHost::TimerHost() {
+  // The high resolution timer is only available since Windows 10 1803.
+  waitable_timer_ = ::CreateWaitableTimerExW(
+      nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+      TIMER_ALL_ACCESS);
+  if (!waitable_timer_)
+    waitable_timer_ = ::CreateWaitableTimerExW(nullptr, nullptr, 0,
+                                               TIMER_ALL_ACCESS);
+  wait_ = ::CreateThreadpoolWait(&TimerHost::OnWaitableTimer, this, nullptr);
+}
+
+TimerHost::~TimerHost() {
+  ::SetThreadpoolWait(wait_, nullptr, nullptr);
+  ::WaitForThreadpoolWaitCallbacks(wait_, TRUE);
+  ::CloseThreadpoolWait(wait_);
+  ::CloseHandle(waitable_timer_);
+}
 
-TimerHost::TimerId TimerHost::SetTimeout(int ms, Task task) {
+void TimerHost::PostTask(Task task) {
   base::AutoLock auto_lock(lock_);
-  TimerId id = NextTimerId();
-  if (::SetTimer(hwnd(), id, ms, nullptr))
-    tasks_[id] = std::move(task);
-  return id;
+  posted_tasks_.push_back(std::move(task));
+  // One message runs all pending tasks.
+  if (!message_posted_)
+    message_posted_ = ::PostMessage(hwnd(), kMsgRunTasks, 0, 0) != FALSE;
 }
 
-void TimerHost::ClearTimeout(TimerId id) {
-  ::KillTimer(hwnd(), id);
+void TimerHost::PostIdleTask(Task task) {
   base::AutoLock auto_lock(lock_);
-  tasks_.erase(id);
+  idle_tasks_.push_back(std::move(task));
+  // WM_TIMER is only generated when there is no other message in the queue.
+  if (!idle_timer_set_)
+    idle_timer_set_ = ::SetTimer(hwnd(), kIdleTimerId, USER_TIMER_MINIMUM,
+                                 nullptr) != 0;
+}
+
+bool TimerHost::WakeupForTasks() {
+  // SetTimer fails for windows of other threads, while PostMessage does not.
+  return ::PostMessage(hwnd(), kMsgWakeupForTasks, 0, 0) != FALSE;
+}
+
+void TimerHost::ScheduleTimer(int ms) {
+  // Negative due time is relative, in 100 nanoseconds.
+  LARGE_INTEGER due_time;
+  due_time.QuadPart = -static_cast<LONGLONG>(ms) * 10000;
+  ::SetWaitableTimer(waitable_timer_, &due_time, 0, nullptr, nullptr, FALSE);
+  // The wait is one-shot, and setting it again replaces the previous one.
+  ::SetThreadpoolWait(wait_, waitable_timer_, nullptr);
 }
 
 void TimerHost::OnTimer(UINT_PTR id) {
-  ::KillTimer(hwnd(), id);
-  std::function<void()> task;
+  if (id == kIdleTimerId) {
+    RunIdleTask();
+    return;
+  }
+  if (id == kTasksTimerId) {
+    ::KillTimer(hwnd(), id);
+    MessageLoop::RunTasks();
+  }
+}
+
+LRESULT TimerHost::OnRunTasks(UINT message, WPARAM w_param, LPARAM l_param) {
+  std::deque<Task> tasks;
   {
     base::AutoLock auto_lock(lock_);
-    auto it = tasks_.find(id);
-    if (it == tasks_.end())
-      return;
-    task = std::move(it->second);
-    tasks_.erase(it);
+    tasks.swap(posted_tasks_);
+    message_posted_ = false;
   }
-  task();
+  for (Task& task : tasks)
+    task();
+  return 0;
+}
+
+LRESULT TimerHost::OnRunTimers(UINT message, WPARAM w_param, LPARAM l_param) {
+  MessageLoop::RunTimers();
+  return 0;
+}
+
+LRESULT TimerHost::OnWakeupForTasks(UINT message,
+                                    WPARAM w_param,
+                                    LPARAM l_param) {
+  // WM_TIMER has lower priority than input and paint messages, run the tasks
+  // directly if the timer can not be set.
+  if (!::SetTimer(hwnd(), kTasksTimerId, USER_TIMER_MINIMUM, nullptr))
+    MessageLoop::RunTasks();
+  return 0;
 }
 
-UINT_PTR TimerHost::NextTimerId() {
-  return static_cast<UINT_PTR>(++next_timer_id_);
+// static
+void CALLBACK TimerHost::OnWaitableTimer(PTP_CALLBACK_INSTANCE instance,
+                                         void* context,
+                                         PTP_WAIT wait,
+                                         TP_WAIT_RESULT result) {
+  // Called in thread pool, move to the main thread.
+  auto* self = static_cast<TimerHost*>(context);
+  ::PostMessage(self->hwnd(), kMsgRunTimers, 0, 0);
+}
+
+void TimerHost::RunIdleTask() {
+  // Yield to input and paint messages, the timer fires again later.
+  if (HIWORD(::GetQueueStatus(QS_INPUT | QS_PAINT | QS_POSTMESSAGE)) != 0)
+    return;
+  Task task;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (idle_tasks_.empty())
+      return;
+    task = std::move(idle_tasks_.front());
+    idle_tasks_.pop_front();
+    // Keep the timer until all tasks are done.
+    if (idle_tasks_.empty()) {
+      ::KillTimer(hwnd(), kIdleTimerId);
+      idle_timer_set_ = false;
+    }
+  }
+  task();
 }
 
 }  // namespace nu
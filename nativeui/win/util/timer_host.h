@@ -5,8 +5,8 @@
 #ifndef NATIVEUI_WIN_UTIL_TIMER_HOST_H_
 #define NATIVEUI_WIN_UTIL_TIMER_HOST_H_
 
+#include <deque>
 #include <functional>
-#include <unordered_map>
 
 #include "base/synchronization/lock.h"
 #include "nativeui/win/util/win32_window.h"
@@ -16,29 +16,66 @@ namespace nu {
 class TimerHost : public Win32Window {
  public:
   using Task = std::function<void()>;
-  using TimerId = UINT_PTR;
 
   TimerHost();
   ~TimerHost() override;
 
-  TimerId SetTimeout(int ms, Task task);
-  void ClearTimeout(TimerId id);
+  // Run |task| with a posted message, which is retrieved before input and
+  // paint messages.
+  void PostTask(Task task);
+
+  // Run |task| when there is no other pending message.
+  void PostIdleTask(Task task);
+
+  // Call MessageLoop::RunTasks, can be called from any thread. A message is
+  // posted to arm a timer in the main thread, so the tasks still run after
+  // input and paint messages.
+  bool WakeupForTasks();
+
+  // Call MessageLoop::RunTimers after |ms|, replacing the previous schedule.
+  // A high resolution waitable timer is used when available, since SetTimer
+  // is limited to the granularity of system clock.
+  void ScheduleTimer(int ms);
 
  protected:
   CR_BEGIN_MSG_MAP_EX(TimerHost, Win32Window)
     CR_MSG_WM_TIMER(OnTimer)
+    CR_MESSAGE_HANDLER_EX(kMsgRunTasks, OnRunTasks)
+    CR_MESSAGE_HANDLER_EX(kMsgRunTimers, OnRunTimers)
+    CR_MESSAGE_HANDLER_EX(kMsgWakeupForTasks, OnWakeupForTasks)
   CR_END_MSG_MAP()
 
   void OnTimer(UINT_PTR id);
+  LRESULT OnRunTasks(UINT message, WPARAM w_param, LPARAM l_param);
+  LRESULT OnRunTimers(UINT message, WPARAM w_param, LPARAM l_param);
+  LRESULT OnWakeupForTasks(UINT message, WPARAM w_param, LPARAM l_param);
 
  private:
-  UINT_PTR NextTimerId();
+  static const UINT kMsgRunTasks = WM_USER + 1;
+  static const UINT kMsgRunTimers = WM_USER + 2;
+  static const UINT kMsgWakeupForTasks = WM_USER + 3;
+
+  static void CALLBACK OnWaitableTimer(PTP_CALLBACK_INSTANCE instance,
+                                       void* context,
+                                       PTP_WAIT wait,
+                                       TP_WAIT_RESULT result);
 
-  // The unique timer ID we will assign to the next timer.
-  UINT next_timer_id_ = 0;
+  void RunIdleTask();
 
   base::Lock lock_;
-  std::unordered_map<TimerId, Task> tasks_;
+
+  // Tasks waiting for the posted message.
+  std::deque<Task> posted_tasks_;
+  bool message_posted_ = false;
+
+  // The timer driving MessageLoop's timeouts, and the thread pool wait that
+  // posts kMsgRunTimers when it is signaled.
+  HANDLE waitable_timer_;
+  PTP_WAIT wait_;
+
+  // Tasks waiting for the queue to become empty.
+  std::deque<Task> idle_tasks_;
+  bool idle_timer_set_ = false;
 };
 
 }  // namespace nu
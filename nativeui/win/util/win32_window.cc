@@ -8,6 +8,7 @@
 #include "nativeui/state.h"
 #include "nativeui/win/util/class_registrar.h"
 #include "nativeui/win/util/hwnd_util.h"
+#include "nativeui/win/util/window_message_stats.h"
 
 namespace nu {
 
@@ -76,6 +77,7 @@ LRESULT Win32Window::OnWndProc(UINT message, WPARAM w_param, LPARAM l_param) {
   if (message == WM_NCDESTROY)
     hwnd_ = NULL;
 
+  ScopedMessageTimer timer(message);
   // Handle the message if it's in our message map; otherwise, let the system
   // handle it.
   if (!ProcessWindowMessage(hwnd, message, w_param, l_param, &result))
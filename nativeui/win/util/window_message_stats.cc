@@ -0,0 +1,66 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/win/util/window_message_stats.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "nativeui/state.h"
+
+namespace nu {
+
+WindowMessageStats::WindowMessageStats() {}
+
+WindowMessageStats::WindowMessageStats(const WindowMessageStats& other)
+    = default;
+
+WindowMessageStats::~WindowMessageStats() {}
+
+ScopedMessageTimer::ScopedMessageTimer(unsigned int message,
+                                       const char* window_class)
+    : message_(message),
+      window_class_(window_class),
+      previous_(nullptr),
+      enabled_(State::GetCurrent()->IsWindowMessageStatsEnabled()) {
+  if (!enabled_)
+    return;
+  State* state = State::GetCurrent();
+  previous_ = state->message_timer();
+  state->message_timer() = this;
+  start_ = base::TimeTicks::Now();
+}
+
+ScopedMessageTimer::~ScopedMessageTimer() {
+  if (!enabled_)
+    return;
+  base::TimeDelta duration = base::TimeTicks::Now() - start_;
+  State* state = State::GetCurrent();
+  state->message_timer() = previous_;
+  // Messages handled by DefWindowProc alone have no message map.
+  std::string window_class = window_class_ ? window_class_ : "DefWindowProc";
+  WindowMessageStats* stats = state->window_message_stats();
+  WindowMessageStats::Entry& entry =
+      stats->messages[std::make_pair(window_class, message_)];
+  entry.count++;
+  entry.total_duration += duration;
+  entry.max_duration = std::max(entry.max_duration, duration);
+  if (duration < state->GetLongTaskThreshold())
+    return;
+  LOG(WARNING) << "Message 0x" << std::hex << message_ << std::dec
+               << " to " << window_class << " took "
+               << duration.InMillisecondsF() << "ms";
+  if (stats->slow_messages.size() >= WindowMessageStats::kMaxSlowMessages)
+    stats->slow_messages.erase(stats->slow_messages.begin());
+  stats->slow_messages.push_back({window_class, message_, start_, duration});
+}
+
+// static
+void ScopedMessageTimer::SetMessageMapName(const char* name) {
+  ScopedMessageTimer* timer = State::GetCurrent()->message_timer();
+  if (timer && !timer->window_class_)
+    timer->window_class_ = name;
+}
+
+}  // namespace nu
@@ -0,0 +1,74 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_WIN_UTIL_WINDOW_MESSAGE_STATS_H_
+#define NATIVEUI_WIN_UTIL_WINDOW_MESSAGE_STATS_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/time/time.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Statistics about the time spent in handling window messages.
+struct NATIVEUI_EXPORT WindowMessageStats {
+  WindowMessageStats();
+  WindowMessageStats(const WindowMessageStats& other);
+  ~WindowMessageStats();
+
+  struct Entry {
+    int count = 0;
+    base::TimeDelta total_duration;
+    base::TimeDelta max_duration;
+  };
+
+  // A message that took longer than the long task threshold to handle.
+  struct SlowMessage {
+    std::string window_class;
+    unsigned int message = 0;
+    base::TimeTicks start;
+    base::TimeDelta duration;
+  };
+
+  // Only the most recent slow messages are kept.
+  static const size_t kMaxSlowMessages = 100;
+
+  // Keyed by the class of the message map and the message.
+  std::map<std::pair<std::string, unsigned int>, Entry> messages;
+
+  std::vector<SlowMessage> slow_messages;
+};
+
+// Internal: Record the time spent in the scope as handling |message|.
+//
+// The window class is the name of the most derived message map that sees the
+// message, which is reported with SetMessageMapName by CR_BEGIN_MSG_MAP_EX.
+// The time spent in default window procedures is included.
+class NATIVEUI_EXPORT ScopedMessageTimer {
+ public:
+  // The |window_class| can be set upfront when the handler is not a window,
+  // like the controls receiving forwarded WM_NOTIFY.
+  explicit ScopedMessageTimer(unsigned int message,
+                              const char* window_class = nullptr);
+  ~ScopedMessageTimer();
+
+  // Name the window class of the message being handled, only the first name
+  // reported to a timer is kept.
+  static void SetMessageMapName(const char* name);
+
+ private:
+  unsigned int message_;
+  const char* window_class_;
+  base::TimeTicks start_;
+  ScopedMessageTimer* previous_;
+  bool enabled_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_WIN_UTIL_WINDOW_MESSAGE_STATS_H_
@@ -7,10 +7,17 @@
 #include <utility>
 #include <vector>
 
+#include "base/auto_reset.h"
 #include "nativeui/events/event.h"
 #include "nativeui/events/win/event_win.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/geometry/rect_conversions.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/win/double_buffer.h"
+#include "nativeui/gfx/win/gdiplus.h"
 #include "nativeui/screen.h"
+#include "nativeui/state.h"
 #include "nativeui/win/dragging_info_win.h"
 #include "nativeui/win/scroll_win.h"
 
@@ -31,9 +38,14 @@ void ViewImpl::SizeAllocate(const Rect& size_allocation) {
 
   bool size_changed = size_allocation.size() != size_allocation_.size();
 
+  base::AutoReset<bool> auto_reset(&layer_moving_,
+                                   IsMovingLayer(size_allocation));
+
   Invalidate(size_allocation_);  // old
   size_allocation_ = size_allocation;
   Invalidate(size_allocation_);  // new
+  if (parent_)
+    parent_->OnChildChanged();
 
   if (size_changed && delegate_)
     delegate_->OnSizeChanged();
@@ -47,8 +59,12 @@ void ViewImpl::SetParent(ViewImpl* parent) {
   if (window())
     window()->focus_manager()->RemoveFocus(this);
 
+  if (parent_)
+    parent_->OnChildChanged();
   window_ = parent ? parent->window_ : nullptr;
   parent_ = parent;
+  if (parent_)
+    parent_->OnChildChanged();
 
   if (!dragged_types_.empty() && window())
     window()->RegisterDropTarget();
@@ -75,6 +91,8 @@ void ViewImpl::BecomeContentView(WindowImpl* parent) {
 }
 
 void ViewImpl::Invalidate(const Rect& dirty) {
+  InvalidateLayers();
+
   // Nothing to draw?
   if (!window_ || size_allocation_.size().IsEmpty() || dirty.IsEmpty())
     return;
@@ -87,14 +105,67 @@ void ViewImpl::Invalidate(const Rect& dirty) {
   if (clipped_dirty.IsEmpty())
     return;
 
-  RECT rect = clipped_dirty.ToRECT();
-  InvalidateRect(window_->hwnd(), &rect, TRUE);
+  window_->InvalidatePixelRect(clipped_dirty);
+}
+
+void ViewImpl::SetLayerBacked(bool backed) {
+  layer_backed_ = backed;
+  layer_.reset();
+  layer_dirty_ = true;
+  Invalidate();
+}
+
+void ViewImpl::DrawLayer(PainterWin* painter, const Rect& dirty) {
+  Size size = size_allocation_.size();
+  if (!layer_ || layer_->size() != size) {
+    layer_.reset(new DoubleBuffer(State::GetCurrent()->GetSubwinHolder(),
+                                  size));
+    layer_dirty_ = true;
+  }
+  if (layer_dirty_) {
+    PainterWin layer_painter(layer_->dc(), size, scale_factor_);
+    layer_painter.Clear();
+    Draw(&layer_painter, Rect(size));
+    layer_dirty_ = false;
+    // Parts outside viewport are not drawn, and the layer can not be reused
+    // after moving.
+    layer_complete_ = GetClippedRect() == size_allocation_;
+  }
+  // Composite the dirty part of layer.
+  Vector2d origin = painter->GetTranslationPixel();
+  BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+  HDC dc = painter->GetRawHDC();
+  ::AlphaBlend(dc, origin.x() + dirty.x(), origin.y() + dirty.y(),
+               dirty.width(), dirty.height(),
+               layer_->dc(), dirty.x(), dirty.y(),
+               dirty.width(), dirty.height(), blend);
+  painter->ReleaseRawHDC(dc);
+}
+
+bool ViewImpl::IsMovingLayer(const Rect& bounds) const {
+  if (layer_moving_)
+    return true;
+  return layer_ && !layer_dirty_ && layer_complete_ &&
+         bounds.size() == size_allocation_.size();
+}
+
+void ViewImpl::InvalidateLayers() {
+  // The views being moved keep their layers, but their parents still need to
+  // redraw for the new position.
+  for (ViewImpl* view = this; view; view = view->parent_) {
+    if (view->layer_ && !view->layer_moving_)
+      view->layer_dirty_ = true;
+  }
 }
 
 void ViewImpl::ClipRectForChild(const ViewImpl* child, Rect* rect) const {
   rect->Intersect(GetClippedRect());
 }
 
+bool ViewImpl::IsOpaque() const {
+  return background_color_.a() == 255;
+}
+
 void ViewImpl::SetFocus(bool focus) {
   if (is_focused_ == focus || !window())
     return;
@@ -160,21 +231,22 @@ void ViewImpl::OnMouseMove(NativeEvent event) {
   if (!delegate() || delegate()->on_mouse_move.IsEmpty())
     return;
   event->w_param = 0;
-  delegate()->on_mouse_move.Emit(delegate(), MouseEvent(event, this));
+  delegate()->EmitMouseMove(MouseEvent(event, this));
 }
 
 void ViewImpl::OnMouseEnter(NativeEvent event) {
   if (!delegate() || delegate()->on_mouse_enter.IsEmpty())
     return;
   event->w_param = 1;
-  delegate()->on_mouse_enter.Emit(delegate(), MouseEvent(event, this));
+  delegate()->EmitMouseEvent(MouseEvent(event, this));
 }
 
 void ViewImpl::OnMouseLeave(NativeEvent event) {
   if (!delegate() || delegate()->on_mouse_leave.IsEmpty())
     return;
   event->w_param = 2;
-  delegate()->on_mouse_leave.Emit(delegate(), MouseEvent(event, this));
+  delegate()->FlushMouseMove();
+  delegate()->EmitMouseEvent(MouseEvent(event, this));
 }
 
 bool ViewImpl::OnMouseWheel(NativeEvent event) {
@@ -197,14 +269,8 @@ bool ViewImpl::OnMouseClick(NativeEvent event) {
 
   if (!delegate())
     return false;
-  MouseEvent client_event(event, this);
-  if (client_event.type == EventType::MouseDown &&
-      delegate()->on_mouse_down.Emit(delegate(), client_event))
-    return true;
-  if (client_event.type == EventType::MouseUp &&
-      delegate()->on_mouse_up.Emit(delegate(), client_event))
-    return true;
-  return false;
+  delegate()->FlushMouseMove();
+  return delegate()->EmitMouseEvent(MouseEvent(event, this));
 }
 
 bool ViewImpl::OnSetCursor(NativeEvent event) {
@@ -224,11 +290,7 @@ bool ViewImpl::OnKeyEvent(NativeEvent event) {
   if (!is_enabled() || !delegate())
     return false;
   KeyEvent client_event(event, this);
-  if (client_event.type == EventType::KeyDown &&
-      delegate()->on_key_down.Emit(delegate(), client_event))
-    return true;
-  if (client_event.type == EventType::KeyUp &&
-      delegate()->on_key_up.Emit(delegate(), client_event))
+  if (delegate()->EmitKeyEvent(client_event))
     return true;
   // Pass to parent if this view ignores the event.
   if (delegate()->GetParent())
@@ -326,7 +388,18 @@ void ViewImpl::Invalidate() {
   Invalidate(size_allocation_);
 }
 
+void ViewImpl::UpdateScaleFactor(float scale_factor) {
+  if (scale_factor == scale_factor_)
+    return;
+  size_allocation_ = ToNearestRect(ScaleRect(RectF(size_allocation_),
+                                             scale_factor / scale_factor_));
+  scale_factor_ = scale_factor;
+  layer_dirty_ = true;
+  OnDPIChanged();
+}
+
 void ViewImpl::ParentChanged() {
+  layer_dirty_ = true;
   VisibilityChanged();
   // Scale the bounds after moving to a new parent.
   float new_scale_factor = window_ ? window_->scale_factor() : scale_factor_;
@@ -348,6 +421,27 @@ void View::PlatformDestroy() {
   delete view_;
 }
 
+void View::PlatformSetLayerBacked(bool backed) {
+  view_->SetLayerBacked(backed);
+}
+
+void View::RenderToCanvas(Canvas* canvas, const RectF& rect) {
+  Size size = view_->size_allocation().size();
+  if (size.IsEmpty() || !view_->is_visible())
+    return;
+  // Draw the view in its own scale factor, and then scale to |rect|.
+  DoubleBuffer buffer(State::GetCurrent()->GetSubwinHolder(), size);
+  {
+    PainterWin painter(buffer.dc(), size, view_->scale_factor());
+    painter.Clear();
+    view_->Draw(&painter, Rect(size));
+  }
+  // The bitmap references the memory of buffer, and the image is destroyed
+  // before the buffer.
+  scoped_refptr<Image> image = new Image(buffer.GetGdiplusBitmap().release());
+  canvas->GetPainter()->DrawImage(image.get(), rect);
+}
+
 void View::TakeOverView(NativeView view) {
   view_ = view;
 }
@@ -429,6 +523,7 @@ bool View::HasFocus() const {
 }
 
 void View::SetFocusable(bool focusable) {
+  properties_changed_ = true;
   GetNative()->set_focusable(focusable);
 }
 
@@ -452,6 +547,7 @@ bool View::HasCapture() const {
 }
 
 void View::SetMouseDownCanMoveWindow(bool yes) {
+  properties_changed_ = true;
   view_->set_draggable(yes);
 }
 
@@ -490,10 +586,12 @@ void View::PlatformSetFont(Font* font) {
 }
 
 void View::SetColor(Color color) {
+  properties_changed_ = true;
   view_->SetColor(color);
 }
 
 void View::SetBackgroundColor(Color color) {
+  properties_changed_ = true;
   view_->SetBackgroundColor(color);
 }
 
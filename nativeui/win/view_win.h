@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_WIN_VIEW_WIN_H_
 #define NATIVEUI_WIN_VIEW_WIN_H_
 
+#include <memory>
 #include <set>
 
 #include "nativeui/cursor.h"
@@ -14,6 +15,7 @@
 
 namespace nu {
 
+class DoubleBuffer;
 class ScrollImpl;
 class WindowImpl;
 
@@ -57,6 +59,17 @@ class ViewImpl {
   // Calculate the clipped rect of a child.
   virtual void ClipRectForChild(const ViewImpl* child, Rect* rect) const;
 
+  // Whether Draw fills the whole dirty rect with opaque pixels, so views
+  // beneath it do not need painting.
+  virtual bool IsOpaque() const;
+
+  // Called when a child is moved, resized, added or removed.
+  virtual void OnChildChanged() {}
+
+  // Called when the window has moved to a monitor with different DPI, scale
+  // the bounds of this view and its children in one walk.
+  virtual void UpdateScaleFactor(float scale_factor);
+
   // Move focus to the view.
   virtual void SetFocus(bool focus);
   virtual bool HasFocus() const;
@@ -84,6 +97,9 @@ class ViewImpl {
   // Draw the content.
   virtual void Draw(PainterWin* painter, const Rect& dirty);
 
+  // Draw the content from cached layer, the layer is redrawn when needed.
+  void DrawLayer(PainterWin* painter, const Rect& dirty);
+
   // The DPI of this view has changed.
   virtual void OnDPIChanged() {}
 
@@ -131,6 +147,10 @@ class ViewImpl {
   // Invalidate the whole view.
   void Invalidate();
 
+  // Whether to cache the contents in a layer.
+  void SetLayerBacked(bool backed);
+  bool is_layer_backed() const { return layer_backed_; }
+
   // Change the bounds without invalidating.
   void set_size_allocation(const Rect& bounds) { size_allocation_ = bounds; }
   Rect size_allocation() const { return size_allocation_; }
@@ -175,7 +195,18 @@ class ViewImpl {
   // Called by SetParent/BecomeContentView when parent view changes.
   void ParentChanged();
 
+  // Return whether changing bounds to |bounds| only moves the layer, the
+  // layer is kept when its children are moved together.
+  bool IsMovingLayer(const Rect& bounds) const;
+
+  // Moving a layer-backed view does not change the contents of its layer,
+  // set by SizeAllocate when only the origin changes.
+  bool layer_moving_ = false;
+
  private:
+  // Mark the layers of this view and its parents as dirty.
+  void InvalidateLayers();
+
   ControlType type_;
 
   // Whether the view can have focus.
@@ -228,6 +259,13 @@ class ViewImpl {
   // The absolute bounds relative to the origin of window.
   Rect size_allocation_;
 
+  // The cached contents of layer-backed view.
+  bool layer_backed_ = false;
+  bool layer_dirty_ = true;
+  // Whether the whole view was inside viewport when drawing the layer.
+  bool layer_complete_ = false;
+  std::unique_ptr<DoubleBuffer> layer_;
+
   DISALLOW_COPY_AND_ASSIGN(ViewImpl);
 };
 
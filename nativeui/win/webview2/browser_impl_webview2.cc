@@ -10,45 +10,14 @@
 #include <string>
 #include <utility>
 
-#include "base/base_paths.h"
-#include "base/base_paths_win.h"
-#include "base/file_version_info.h"
 #include "base/json/json_reader.h"
-#include "base/path_service.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/win/scoped_co_mem.h"
+#include "nativeui/state.h"
+#include "nativeui/win/webview2/webview2_environment.h"
 
 namespace nu {
 
-namespace {
-
-// Get the application name with order:
-// 1. The product name specified in exe file.
-// 2. The name of the exe file.
-// 3. "Yue.WebView2"
-base::string16 GetApplicationName() {
-  base::string16 name;
-  base::FilePath path;
-  if (base::PathService::Get(base::FILE_EXE, &path)) {
-    auto info = FileVersionInfo::CreateFileVersionInfo(path);
-    if (info && !info->product_name().empty())
-      name = info->product_name();
-    else
-      name = path.BaseName().RemoveExtension().value();
-  }
-  return name.empty() ? L"Yue.WebView2" : name;
-}
-
-// C:\Users\USER_NAME\AppData\Local\APPLICATION_NAME
-base::FilePath GetUserDataDir() {
-  base::FilePath path;
-  if (!base::PathService::Get(base::DIR_LOCAL_APP_DATA, &path))
-    base::PathService::Get(base::DIR_TEMP, &path);
-  return path.Append(GetApplicationName());
-}
-
-}  // namespace
-
 // static
 bool BrowserImplWebview2::RegisterProtocol(
     base::string16 scheme,
@@ -64,21 +33,13 @@ BrowserImplWebview2::BrowserImplWebview2(Browser::Options options,
                                          BrowserHolder* holder)
     : BrowserImpl(std::move(options), holder),
       weak_factory_(this) {
+  // The environment is shared by all browsers.
   base::WeakPtr<BrowserImplWebview2> self = weak_factory_.GetWeakPtr();
-  auto callback =
-      Microsoft::WRL::Callback<
-          ICoreWebView2CreateCoreWebView2EnvironmentCompletedHandler>(
-              [self](HRESULT res, ICoreWebView2Environment* env) {
-                if (!self)
-                  return E_FAIL;
-                return self->OnEnvCreated(res, env);
-              });
-  if (FAILED(::CreateCoreWebView2EnvironmentWithOptions(
-                 nullptr, GetUserDataDir().value().c_str(), nullptr,
-                 callback.Get()))) {
-    CreationFailed();
-    return;
-  }
+  State::GetCurrent()->GetWebView2Environment()->GetEnvironment(
+      [self](HRESULT res, ICoreWebView2Environment* env) {
+        if (self)
+          self->OnEnvCreated(res, env);
+      });
 }
 
 BrowserImplWebview2::~BrowserImplWebview2() {
@@ -187,6 +148,25 @@ void BrowserImplWebview2::ExecuteJavaScript(
   }
 }
 
+void BrowserImplWebview2::ExecuteJavaScriptRaw(
+    base::string16 code,
+    const Browser::RawExecutionCallback& callback) {
+  if (webview_) {
+    auto handler =
+        Microsoft::WRL::Callback<ICoreWebView2ExecuteScriptCompletedHandler>(
+            [callback](HRESULT res, LPCWSTR json) -> HRESULT {
+              if (!callback)
+                return S_OK;
+              if (SUCCEEDED(res))
+                callback(true, base::UTF16ToUTF8(json));
+              else
+                callback(false, std::string());
+              return S_OK;
+            });
+    webview_->ExecuteScript(code.c_str(), handler.Get());
+  }
+}
+
 void BrowserImplWebview2::GoBack() {
   if (webview_)
     webview_->GoBack();
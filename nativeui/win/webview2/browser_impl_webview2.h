@@ -36,6 +36,9 @@ class BrowserImplWebview2 : public BrowserImpl {
   void ExecuteJavaScript(
       base::string16 code,
       const Browser::ExecutionCallback& callback) override;
+  void ExecuteJavaScriptRaw(
+      base::string16 code,
+      const Browser::RawExecutionCallback& callback);
 
   void GoBack() override;
   bool CanGoBack() const override;
@@ -0,0 +1,88 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Avoid compiling this file with other build systems.
+#if defined(WEBVIEW2_SUPPORT)
+
+#include "nativeui/win/webview2/webview2_environment.h"
+
+#include <utility>
+
+#include "base/base_paths.h"
+#include "base/base_paths_win.h"
+#include "base/file_version_info.h"
+#include "base/path_service.h"
+
+namespace nu {
+
+namespace {
+
+// Get the application name with order:
+// 1. The product name specified in exe file.
+// 2. The name of the exe file.
+// 3. "Yue.WebView2"
+base::string16 GetApplicationName() {
+  base::string16 name;
+  base::FilePath path;
+  if (base::PathService::Get(base::FILE_EXE, &path)) {
+    auto info = FileVersionInfo::CreateFileVersionInfo(path);
+    if (info && !info->product_name().empty())
+      name = info->product_name();
+    else
+      name = path.BaseName().RemoveExtension().value();
+  }
+  return name.empty() ? L"Yue.WebView2" : name;
+}
+
+// C:\Users\USER_NAME\AppData\Local\APPLICATION_NAME
+base::FilePath GetUserDataDir() {
+  base::FilePath path;
+  if (!base::PathService::Get(base::DIR_LOCAL_APP_DATA, &path))
+    base::PathService::Get(base::DIR_TEMP, &path);
+  return path.Append(GetApplicationName());
+}
+
+}  // namespace
+
+WebView2Environment::WebView2Environment() {}
+
+WebView2Environment::~WebView2Environment() {}
+
+void WebView2Environment::GetEnvironment(const Callback& callback) {
+  if (env_) {
+    callback(S_OK, env_.Get());
+    return;
+  }
+  pending_callbacks_.push_back(callback);
+  if (is_creating_)
+    return;
+  is_creating_ = true;
+  // The environment is owned by State and outlives the creation.
+  auto handler =
+      Microsoft::WRL::Callback<
+          ICoreWebView2CreateCoreWebView2EnvironmentCompletedHandler>(
+              this, &WebView2Environment::OnEnvCreated);
+  HRESULT res = ::CreateCoreWebView2EnvironmentWithOptions(
+      nullptr, GetUserDataDir().value().c_str(), nullptr, handler.Get());
+  if (FAILED(res))
+    OnEnvCreated(res, nullptr);
+}
+
+HRESULT WebView2Environment::OnEnvCreated(HRESULT res,
+                                          ICoreWebView2Environment* env) {
+  is_creating_ = false;
+  // Keep the environment only when succeeded, so failed creations can be
+  // retried by later browsers.
+  if (SUCCEEDED(res))
+    env_ = env;
+  std::vector<Callback> callbacks = std::move(pending_callbacks_);
+  pending_callbacks_.clear();
+  for (const Callback& callback : callbacks)
+    callback(res, env);
+  return S_OK;
+}
+
+}  // namespace nu
+
+#endif  // defined(WEBVIEW2_SUPPORT)
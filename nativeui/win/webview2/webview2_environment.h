@@ -0,0 +1,44 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NATIVEUI_WIN_WEBVIEW2_WEBVIEW2_ENVIRONMENT_H_
+#define NATIVEUI_WIN_WEBVIEW2_WEBVIEW2_ENVIRONMENT_H_
+
+#include <webview2.h>
+#include <wrl.h>
+
+#include <functional>
+#include <vector>
+
+#include "base/macros.h"
+
+namespace nu {
+
+// Creates the ICoreWebView2Environment once and shares it with all browsers,
+// so only the first browser pays for starting the WebView2 processes. This
+// class is managed by State.
+class WebView2Environment {
+ public:
+  using Callback = std::function<void(HRESULT, ICoreWebView2Environment*)>;
+
+  WebView2Environment();
+  ~WebView2Environment();
+
+  // Call |callback| with the environment, which is created on first request.
+  // The |callback| may be called synchronously.
+  void GetEnvironment(const Callback& callback);
+
+ private:
+  HRESULT OnEnvCreated(HRESULT res, ICoreWebView2Environment* env);
+
+  bool is_creating_ = false;
+  std::vector<Callback> pending_callbacks_;
+  Microsoft::WRL::ComPtr<ICoreWebView2Environment> env_;
+
+  DISALLOW_COPY_AND_ASSIGN(WebView2Environment);
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_WIN_WEBVIEW2_WEBVIEW2_ENVIRONMENT_H_
@@ -14,6 +14,7 @@
 #include <tuple>
 #include <utility>
 
+#include "base/check_op.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/win/windows_version.h"
 #include "nativeui/accelerator.h"
@@ -26,13 +27,18 @@
 #include "nativeui/gfx/win/double_buffer.h"
 #include "nativeui/gfx/win/painter_win.h"
 #include "nativeui/menu_bar.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/paint_stats.h"
+#include "nativeui/state.h"
+#include "nativeui/trace_event.h"
 #include "nativeui/win/drag_drop/clipboard_util.h"
 #include "nativeui/win/drag_drop/data_object.h"
 #include "nativeui/win/menu_base_win.h"
 #include "nativeui/win/screen_win.h"
 #include "nativeui/win/subwin_view.h"
+#include "nativeui/win/util/composition_target.h"
 #include "nativeui/win/util/hwnd_util.h"
-#include "third_party/yoga/Yoga.h"
+#include "nativeui/win/util/window_message_stats.h"
 
 namespace nu {
 
@@ -63,6 +69,16 @@ SizeF WindowToContentSize(Win32Window* window, bool has_menu_bar,
   return SizeF(size.width() - p.width(), size.height() - p.height());
 }
 
+// Transparent windows are layered windows unless DirectComposition is used.
+DWORD GetTransparentExStyle(const Window::Options& options) {
+  if (!options.transparent)
+    return 0;
+  if (options.direct_composition &&
+      State::GetCurrent()->GetCompositionDevice()->IsValid())
+    return WS_EX_NOREDIRECTIONBITMAP;
+  return WS_EX_LAYERED;
+}
+
 inline bool IsShiftPressed() {
   return (::GetKeyState(VK_SHIFT) & 0x8000) == 0x8000;
 }
@@ -73,8 +89,9 @@ WindowImpl::WindowImpl(const Window::Options& options, Window* delegate)
     : Win32Window(L"", NULL,
                   options.frame ? kWindowDefaultStyle
                                 : kWindowDefaultFramelessStyle,
-                  options.transparent ? WS_EX_LAYERED : 0),
+                  GetTransparentExStyle(options)),
       scale_factor_(GetScaleFactorForHWND(hwnd())),
+      direct2d_(options.direct2d),
       delegate_(delegate) {
   if (options.frame) {
     // Normal window always has shadow.
@@ -93,6 +110,10 @@ WindowImpl::WindowImpl(const Window::Options& options, Window* delegate)
     // Change default background color to transparent.
     background_color_ = Color(0, 0, 0, 0);
   }
+  if (window_ex_style() & WS_EX_NOREDIRECTIONBITMAP) {
+    composition_target_.reset(new CompositionTarget(
+        State::GetCurrent()->GetCompositionDevice(), hwnd()));
+  }
 }
 
 WindowImpl::~WindowImpl() {
@@ -154,6 +175,46 @@ void WindowImpl::ReleaseCapture() {
     ::ReleaseCapture();
 }
 
+void WindowImpl::BeginChildMoves() {
+  ++child_moves_depth_;
+}
+
+void WindowImpl::EndChildMoves() {
+  DCHECK_GT(child_moves_depth_, 0);
+  if (--child_moves_depth_ > 0 || child_moves_.empty())
+    return;
+
+  std::map<HWND, ChildMove> moves;
+  moves.swap(child_moves_);
+  HDWP hdwp = ::BeginDeferWindowPos(static_cast<int>(moves.size()));
+  for (const auto& it : moves) {
+    if (!hdwp)
+      break;
+    const Rect& bounds = it.second.bounds;
+    hdwp = ::DeferWindowPos(hdwp, it.first, NULL, bounds.x(), bounds.y(),
+                            bounds.width(), bounds.height(), it.second.flags);
+  }
+  // A failed DeferWindowPos frees the whole batch, move windows one by one.
+  if (!hdwp || !::EndDeferWindowPos(hdwp)) {
+    for (const auto& it : moves) {
+      const Rect& bounds = it.second.bounds;
+      ::SetWindowPos(it.first, NULL, bounds.x(), bounds.y(),
+                     bounds.width(), bounds.height(), it.second.flags);
+    }
+  }
+  for (const auto& it : moves) {
+    if (!(it.second.flags & SWP_HIDEWINDOW))
+      ::RedrawWindow(it.first, NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
+  }
+}
+
+bool WindowImpl::DeferChildMove(HWND hwnd, const Rect& bounds, UINT flags) {
+  if (child_moves_depth_ == 0)
+    return false;
+  child_moves_[hwnd] = {bounds, flags};
+  return true;
+}
+
 bool WindowImpl::IsMaximized() const {
   return !!::IsZoomed(hwnd()) && !IsFullscreen();
 }
@@ -205,9 +266,39 @@ bool WindowImpl::IsFullscreen() const {
   return fullscreen_;
 }
 
+void WindowImpl::InvalidatePixelRect(const Rect& rect) {
+  dirty_rect_.Union(rect);
+  RECT r = rect.ToRECT();
+  ::InvalidateRect(hwnd(), &r, TRUE);
+}
+
+void WindowImpl::InvalidateAll() {
+  dirty_rect_ = Rect(GetContentPixelBounds().size());
+  ::InvalidateRect(hwnd(), NULL, TRUE);
+}
+
+bool WindowImpl::ScrollPixelRect(const Rect& rect, const Vector2d& delta,
+                                 const Rect& dirty) {
+  // The buffer would be repainted entirely when it is reallocated.
+  if (!back_buffer_ ||
+      back_buffer_->size() != GetContentPixelBounds().size() ||
+      back_buffer_scale_factor_ != scale_factor_)
+    return false;
+  RECT r = rect.ToRECT();
+  ::ScrollDC(back_buffer_->dc(), delta.x(), delta.y(), &r, &r, NULL, NULL);
+  // The areas waiting for repaint are moved together with the pixels.
+  dirty_rect_ = dirty;
+  Rect moved_dirty = IntersectRects(dirty, rect) + delta;
+  moved_dirty.Intersect(rect);
+  dirty_rect_.Union(moved_dirty);
+  moved_rect_.Union(rect);
+  ::InvalidateRect(hwnd(), &r, TRUE);
+  return true;
+}
+
 void WindowImpl::SetBackgroundColor(nu::Color color) {
   background_color_ = color;
-  ::InvalidateRect(hwnd(), NULL, TRUE);
+  InvalidateAll();
 }
 
 void WindowImpl::SetHasShadow(bool has) {
@@ -247,7 +338,7 @@ int WindowImpl::DoDrag(std::vector<Clipboard::Data> data,
     return DRAG_OPERATION_NONE;
 
   drag_source_ = DragSource::Create(this);
-  drag_data_ = new DataObject(std::move(data));
+  drag_data_ = new DataObject(std::move(data), options.file_promises);
   drag_drop_in_progress_ = true;
 
   if (options.image) {
@@ -319,6 +410,7 @@ void WindowImpl::OnCommand(UINT code, int command, HWND window) {
   }
 
   auto* control = reinterpret_cast<SubwinView*>(GetWindowUserData(window));
+  ScopedMessageTimer timer(WM_COMMAND, control->delegate()->GetClassName());
   control->OnCommand(code, command);
 }
 
@@ -327,16 +419,40 @@ LRESULT WindowImpl::OnNotify(int id, LPNMHDR pnmh) {
   if (::GetParent(window) != hwnd())
     return 0;
   auto* control = reinterpret_cast<SubwinView*>(GetWindowUserData(window));
+  // Attribute the time to the control, the notification is counted twice with
+  // the outer timer of WindowImpl.
+  ScopedMessageTimer timer(WM_NOTIFY, control->delegate()->GetClassName());
   return control->OnNotify(id, pnmh);
 }
 
+void WindowImpl::OnInitMenuPopup(HMENU menu, UINT index, BOOL is_system_menu) {
+  if (!is_system_menu)
+    DispatchInitMenuPopup(menu);
+  SetMsgHandled(false);
+}
+
 void WindowImpl::OnSize(UINT param, const Size& size) {
+  // Suspend or resume animations.
+  if (param == SIZE_MINIMIZED || param == SIZE_RESTORED ||
+      param == SIZE_MAXIMIZED)
+    delegate_->NotifyOcclusionChanged();
   if (!delegate_->GetContentView())
     return;
   delegate_->GetContentView()->GetNative()->SizeAllocate(Rect(size));
+  dirty_rect_ = Rect(size);
   RedrawWindow(hwnd(), NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
 }
 
+void WindowImpl::OnEnterSizeMove() {
+  delegate_->NotifyLiveResizeStart();
+  SetMsgHandled(false);
+}
+
+void WindowImpl::OnExitSizeMove() {
+  delegate_->NotifyLiveResizeEnd();
+  SetMsgHandled(false);
+}
+
 void WindowImpl::OnFocus(HWND old) {
   if (ignore_focus_)
     return;
@@ -360,14 +476,33 @@ LRESULT WindowImpl::OnDPIChanged(UINT msg, WPARAM w_param, LPARAM l_param) {
   float new_scale_factor = GetScalingFactorFromDPI(LOWORD(w_param));
   if (new_scale_factor != scale_factor_) {
     scale_factor_ = new_scale_factor;
-    // Notify the content view of DPI change.
-    delegate_->GetContentView()->GetNative()->BecomeContentView(this);
-    // Move to the new window position under new DPI.
+    // Rescale the views in place, re-parenting the whole tree would notify
+    // each view once for every container above it.
+    View* content_view = delegate_->GetContentView();
+    if (content_view)
+      content_view->GetNative()->UpdateScaleFactor(scale_factor_);
+    // Move to the new window position under new DPI, the views are laid out
+    // and repainted once in OnSize.
+    RECT old_client;
+    ::GetClientRect(hwnd(), &old_client);
     SetPixelBounds(Rect(*reinterpret_cast<RECT*>(l_param)));
+    RECT new_client;
+    ::GetClientRect(hwnd(), &new_client);
+    if (content_view && Rect(old_client) == Rect(new_client)) {
+      content_view->GetNative()->SizeAllocate(Rect(new_client));
+      InvalidateAll();
+    }
   }
   return 1;
 }
 
+void WindowImpl::OnThemeChanged() {
+  // Every window receives the message, clearing the cache is cheap.
+  State::GetCurrent()->GetNativeTheme()->ThemeChanged();
+  InvalidateAll();
+  SetMsgHandled(false);
+}
+
 LRESULT WindowImpl::OnMouseMove(UINT message, WPARAM w_param, LPARAM l_param) {
   Win32Message msg = {message, w_param, l_param};
   if (!mouse_in_window_) {
@@ -452,50 +587,84 @@ void WindowImpl::OnChar(UINT ch, UINT repeat, UINT flags) {
 }
 
 void WindowImpl::OnPaint(HDC) {
+  NU_TRACE_EVENT("paint", "WindowImpl::OnPaint");
   PAINTSTRUCT ps;
   BeginPaint(hwnd(), &ps);
 
-  // Always update the whole buffer for transparent window.
   Rect bounds(GetContentPixelBounds());
-  Rect dirty;
-  if (delegate_->IsTransparent())
-    dirty = Rect(bounds.size());
-  else
-    dirty = Rect(ps.rcPaint);
+  Rect dirty = dirty_rect_;
+  Rect moved = moved_rect_;
+  dirty_rect_ = Rect();
+  moved_rect_ = Rect();
+  // The system may also ask for repaint, like when the window is uncovered,
+  // which only needs copying when the area has been moved in back buffer.
+  if (!delegate_->IsTransparent() && !moved.Contains(Rect(ps.rcPaint)))
+    dirty.Union(Rect(ps.rcPaint));
 
   // Window may be resized to no content.
-  if (dirty.IsEmpty())
+  if (bounds.IsEmpty()) {
+    back_buffer_.reset();
+    EndPaint(hwnd(), &ps);
     return;
+  }
 
-  base::win::ScopedGetDC dc(hwnd());
-  {
-    // Double buffering the drawing.
-    DoubleBuffer buffer(dc, bounds.size(), dirty, dirty.origin());
-
-    // Draw.
-    {
-      // Background.
-      PainterWin painter(buffer.dc(), bounds.size(), scale_factor_);
-      painter.SetColor(background_color_);
-      painter.FillRectPixel(dirty);
+  // Reallocate the buffer only when window is resized or DPI changes, the
+  // whole window has to be repainted for the new buffer.
+  if (!back_buffer_ ||
+      back_buffer_->size() != bounds.size() ||
+      back_buffer_scale_factor_ != scale_factor_) {
+    back_buffer_.reset(new DoubleBuffer(hwnd(), bounds.size()));
+    back_buffer_scale_factor_ = scale_factor_;
+    dirty = Rect(bounds.size());
+  }
+  dirty.Intersect(Rect(bounds.size()));
+  moved.Intersect(Rect(bounds.size()));
+  if (dirty.IsEmpty() && moved.IsEmpty()) {
+    EndPaint(hwnd(), &ps);
+    return;
+  }
 
-      // Controls.
-      delegate_->GetContentView()->GetNative()->Draw(&painter, dirty);
-    }
+  ScopedPaintTimer paint_timer(delegate_, dirty);
+  if (!dirty.IsEmpty()) {
+    PainterWin painter(back_buffer_->dc(), bounds.size(), scale_factor_);
+    painter.ClipRectPixel(dirty);
+    // Clear the dirty area before drawing, since the buffer keeps what was
+    // drawn last time.
+    if (delegate_->IsTransparent())
+      painter.Clear();
+    // Background.
+    painter.SetColor(background_color_);
+    painter.FillRectPixel(dirty);
+    // Controls.
+    ScopedPaintTimer::CountView(delegate_->GetContentView());
+    delegate_->GetContentView()->GetNative()->Draw(&painter, dirty);
+  }
 
-    // Update layered window.
-    if (delegate_->IsTransparent()) {
-      RECT wr;
-      ::GetWindowRect(hwnd(), &wr);
-      SIZE size = {wr.right - wr.left, wr.bottom - wr.top};
-      POINT position = {wr.left, wr.top};
-      POINT zero = {0, 0};
-      BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
-
-      buffer.SetNoCopy();
-      ::UpdateLayeredWindow(hwnd(), NULL, &position, &size, buffer.dc(),
-                            &zero, 0, &blend, ULW_ALPHA);
-    }
+  // Copy the moved pixels to screen together with the repainted ones.
+  dirty.Union(moved);
+  if (composition_target_) {
+    composition_target_->Update(back_buffer_->bits(), bounds.size(), dirty);
+  } else if (delegate_->IsTransparent()) {
+    // Update only the dirty area of layered window.
+    RECT wr;
+    ::GetWindowRect(hwnd(), &wr);
+    SIZE size = {wr.right - wr.left, wr.bottom - wr.top};
+    POINT position = {wr.left, wr.top};
+    POINT zero = {0, 0};
+    RECT dirty_rect = dirty.ToRECT();
+    BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+    UPDATELAYEREDWINDOWINFO info = {sizeof(info)};
+    info.pptDst = &position;
+    info.psize = &size;
+    info.hdcSrc = back_buffer_->dc();
+    info.pptSrc = &zero;
+    info.pblend = &blend;
+    info.dwFlags = ULW_ALPHA;
+    info.prcDirty = &dirty_rect;
+    ::UpdateLayeredWindowIndirect(hwnd(), &info);
+  } else {
+    base::win::ScopedGetDC dc(hwnd());
+    back_buffer_->CopyTo(dc, dirty);
   }
 
   EndPaint(hwnd(), &ps);
@@ -810,11 +979,13 @@ bool WindowImpl::GetClientAreaInsets(Insets* insets) {
 void Window::PlatformInit(const Options& options) {
   window_ = new WindowImpl(options, this);
 
-  YGConfigSetPointScaleFactor(yoga_config_,
-                              GetScaleFactorForHWND(window_->hwnd()));
+  yoga_config_ = State::GetCurrent()->GetYogaConfig(
+      GetScaleFactorForHWND(window_->hwnd()));
 }
 
 void Window::PlatformDestroy() {
+  if (frame_timer_)
+    MessageLoop::ClearTimeout(frame_timer_);
   delete window_;
 }
 
@@ -831,10 +1002,20 @@ bool Window::HasShadow() const {
 }
 
 void Window::PlatformSetContentView(View* view) {
+  // Do not paint until all subwins have been reparented. Note that enabling
+  // redraw also makes the window visible, so skip hidden windows.
+  HWND hwnd = window_->hwnd();
+  bool freeze = !!::IsWindowVisible(hwnd);
+  if (freeze)
+    ::SendMessage(hwnd, WM_SETREDRAW, FALSE, 0L);
   if (content_view_)
     content_view_->GetNative()->BecomeContentView(nullptr);
   view->GetNative()->BecomeContentView(window_);
   view->SetPixelBounds(Rect(window_->GetContentPixelBounds().size()));
+  if (freeze) {
+    ::SendMessage(hwnd, WM_SETREDRAW, TRUE, 0L);
+    ::RedrawWindow(hwnd, NULL, NULL, RDW_INVALIDATE | RDW_ALLCHILDREN);
+  }
 }
 
 void Window::Center() {
@@ -914,6 +1095,7 @@ std::tuple<SizeF, SizeF> Window::GetContentSizeConstraints() const {
 }
 
 void Window::Activate() {
+  NotifyWillShow();
   HWND hwnd = window_->hwnd();
   ::ShowWindow(hwnd, SW_SHOW);
   ::SetForegroundWindow(hwnd);
@@ -930,13 +1112,22 @@ bool Window::IsActive() const {
 }
 
 void Window::SetVisible(bool visible) {
+  if (visible)
+    NotifyWillShow();
   ::ShowWindow(window_->hwnd(), visible ? SW_SHOWNOACTIVATE : SW_HIDE);
+  NotifyOcclusionChanged();
 }
 
 bool Window::IsVisible() const {
   return !!::IsWindowVisible(window_->hwnd());
 }
 
+bool Window::IsOccluded() const {
+  // Checking whether the window is covered by others requires walking all
+  // windows, which costs more than the animations it would save.
+  return !IsVisible() || IsMinimized();
+}
+
 void Window::SetAlwaysOnTop(bool top) {
   ::SetWindowPos(window_->hwnd(), top ? HWND_TOPMOST : HWND_NOTOPMOST,
                  0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
@@ -1052,4 +1243,32 @@ void Window::PlatformRemoveChildWindow(Window* child) {
   ::SetParent(child->GetNative()->hwnd(), NULL);
 }
 
+void Window::PlatformRequestFrame() {
+  if (frame_timer_)
+    return;
+  // Wait until the next vblank of DWM composition, and fallback to 60fps when
+  // the timing is not available.
+  LARGE_INTEGER now, frequency;
+  ::QueryPerformanceCounter(&now);
+  ::QueryPerformanceFrequency(&frequency);
+  DWM_TIMING_INFO info = {sizeof(info)};
+  int delay = 16;
+  LONGLONG vblank = now.QuadPart;
+  if (SUCCEEDED(::DwmGetCompositionTimingInfo(nullptr, &info)) &&
+      info.qpcRefreshPeriod > 0) {
+    vblank = info.qpcVBlank;
+    if (vblank <= now.QuadPart)
+      vblank += ((now.QuadPart - vblank) / info.qpcRefreshPeriod + 1) *
+                info.qpcRefreshPeriod;
+    delay = static_cast<int>((vblank - now.QuadPart) * 1000 /
+                             frequency.QuadPart);
+  }
+  double timestamp = vblank * 1000. / frequency.QuadPart;
+  frame_timer_ = MessageLoop::SetTimeout(delay, [this, timestamp]() {
+    frame_timer_ = 0;
+    // Callbacks requested in this frame have scheduled the next one.
+    RunFrameCallbacks(timestamp);
+  });
+}
+
 }  // namespace nu
@@ -6,6 +6,8 @@
 #ifndef NATIVEUI_WIN_WINDOW_WIN_H_
 #define NATIVEUI_WIN_WINDOW_WIN_H_
 
+#include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -17,6 +19,9 @@
 
 namespace nu {
 
+class CompositionTarget;
+class DoubleBuffer;
+
 class DataObject;
 
 class WindowImpl : public Win32Window,
@@ -40,10 +45,30 @@ class WindowImpl : public Win32Window,
   void SetCapture(ViewImpl* view);
   void ReleaseCapture();
 
+  // Child windows moved between BeginChildMoves and EndChildMoves are moved
+  // together with one DeferWindowPos batch in the outermost EndChildMoves.
+  void BeginChildMoves();
+  void EndChildMoves();
+
+  // Add the move of child window to the batch, return false if there is no
+  // batch and the caller should move the window immediately.
+  bool DeferChildMove(HWND hwnd, const Rect& bounds, UINT flags);
+
   bool IsMaximized() const;
   void SetFullscreen(bool fullscreen);
   bool IsFullscreen() const;
 
+  // Add |rect| in pixels to the area that needs repaint.
+  void InvalidatePixelRect(const Rect& rect);
+  void InvalidateAll();
+
+  // Move the painted pixels in |rect| by |delta| instead of repainting them.
+  // The |dirty| is the area that needed repaint before the contents were
+  // moved, which replaces the repaints requested since then. Return false if
+  // there are no painted pixels to move.
+  bool ScrollPixelRect(const Rect& rect, const Vector2d& delta,
+                       const Rect& dirty);
+
   void SetBackgroundColor(nu::Color color);
   void SetHasShadow(bool has);
 
@@ -66,9 +91,11 @@ class WindowImpl : public Win32Window,
   FocusManager* focus_manager() { return &focus_manager_; }
   ViewImpl* captured_view() const { return captured_view_; }
   Color background_color() const { return background_color_; }
+  Rect dirty_rect() const { return dirty_rect_; }
   bool has_shadow() const { return has_shadow_; }
   bool drag_drop_in_progress() const { return drag_drop_in_progress_; }
   float scale_factor() const { return scale_factor_; }
+  bool direct2d() const { return direct2d_; }
   Window* delegate() { return delegate_; }
 
  protected:
@@ -78,10 +105,14 @@ class WindowImpl : public Win32Window,
     CR_MSG_WM_CLOSE(OnClose)
     CR_MSG_WM_COMMAND(OnCommand)
     CR_MSG_WM_NOTIFY(OnNotify)
+    CR_MSG_WM_INITMENUPOPUP(OnInitMenuPopup)
     CR_MSG_WM_SIZE(OnSize)
+    CR_MSG_WM_ENTERSIZEMOVE(OnEnterSizeMove)
+    CR_MSG_WM_EXITSIZEMOVE(OnExitSizeMove)
     CR_MSG_WM_SETFOCUS(OnFocus)
     CR_MSG_WM_KILLFOCUS(OnBlur)
     CR_MESSAGE_HANDLER_EX(WM_DPICHANGED, OnDPIChanged)
+    CR_MSG_WM_THEMECHANGED(OnThemeChanged)
 
     // Input events.
     CR_MESSAGE_HANDLER_EX(WM_MOUSEMOVE, OnMouseMove)
@@ -110,10 +141,14 @@ class WindowImpl : public Win32Window,
   void OnClose();
   void OnCommand(UINT code, int command, HWND window);
   LRESULT OnNotify(int id, LPNMHDR pnmh);
+  void OnInitMenuPopup(HMENU menu, UINT index, BOOL is_system_menu);
   void OnSize(UINT param, const Size& size);
+  void OnEnterSizeMove();
+  void OnExitSizeMove();
   void OnFocus(HWND old);
   void OnBlur(HWND old);
   LRESULT OnDPIChanged(UINT msg, WPARAM w_param, LPARAM l_param);
+  void OnThemeChanged();
   LRESULT OnMouseMove(UINT message, WPARAM w_param, LPARAM l_param);
   LRESULT OnMouseLeave(UINT message, WPARAM w_param, LPARAM l_param);
   LRESULT OnMouseWheel(UINT message, WPARAM w_param, LPARAM l_param);
@@ -154,6 +189,15 @@ class WindowImpl : public Win32Window,
   // The view that has mouse capture.
   ViewImpl* captured_view_ = nullptr;
 
+  // Moves of child windows waiting for EndChildMoves, later moves of the
+  // same window replace earlier ones.
+  struct ChildMove {
+    Rect bounds;
+    UINT flags;
+  };
+  std::map<HWND, ChildMove> child_moves_;
+  int child_moves_depth_ = 0;
+
   // Information saved before going into fullscreen mode, used to restore the
   // window afterwards.
   struct SavedWindowInfo {
@@ -170,6 +214,23 @@ class WindowImpl : public Win32Window,
   // The background color.
   nu::Color background_color_ = nu::Color(0xFF, 0xFF, 0xFF);
 
+  // The accumulated area that needs repaint.
+  Rect dirty_rect_;
+
+  // The area of back buffer that has been moved and needs to be copied to
+  // screen without repainting.
+  Rect moved_rect_;
+
+  // The back buffer is reused by paints, and is only reallocated when the
+  // window is resized or the DPI changes. Transparent windows also rely on
+  // it to keep the contents so only the dirty area has to be repainted.
+  std::unique_ptr<DoubleBuffer> back_buffer_;
+  float back_buffer_scale_factor_ = 0.f;
+
+  // Presents transparent window with DirectComposition instead of updating
+  // the layered window.
+  std::unique_ptr<CompositionTarget> composition_target_;
+
   // Whether there is native shadow.
   bool has_shadow_ = true;
 
@@ -183,6 +244,9 @@ class WindowImpl : public Win32Window,
   // The scale factor of current window.
   float scale_factor_;
 
+  // Whether to draw custom contents with Direct2D.
+  bool direct2d_;
+
   // The public Window interface.
   Window* delegate_;
 };
@@ -4,12 +4,16 @@
 
 #include "nativeui/window.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/logging.h"
 #include "nativeui/container.h"
+#include "nativeui/layout_transaction.h"
 #include "nativeui/menu_bar.h"
-#include "third_party/yoga/Yoga.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/state.h"
+#include "nativeui/util/frame_clock.h"
 
 #if defined(OS_MACOSX)
 #include "nativeui/toolbar.h"
@@ -20,7 +24,8 @@ namespace nu {
 Window::Window(const Options& options)
     : has_frame_(options.frame),
       transparent_(options.transparent),
-      yoga_config_(YGConfigNew()) {
+      yoga_config_(State::GetCurrent()->yoga_config()) {
+  ScopedStartupPhase startup_phase(StartupPhase::FirstWindow);
   // Initialize.
   PlatformInit(options);
   SetContentView(new Container);
@@ -33,8 +38,10 @@ Window::Window(const Options& options)
 }
 
 Window::~Window() {
+  State* state = State::GetCurrent();
+  if (state)
+    state->GetApp()->UpdateWindowOcclusion(this, true);
   PlatformDestroy();
-  YGConfigFree(yoga_config_);
   content_view_->BecomeContentView(nullptr);
 }
 
@@ -50,6 +57,19 @@ void Window::SetContentView(scoped_refptr<View> view) {
   content_view_->BecomeContentView(this);
 }
 
+void Window::PrepareContentView(View* view) {
+  if (view->GetParent() || view->GetWindow()) {
+    LOG(ERROR) << "Only detached views can be prepared";
+    return;
+  }
+  RectF bounds(GetContentSize());
+  // Changing the size lays out the view, otherwise do it manually.
+  if (view->GetBounds() != bounds)
+    view->SetBounds(bounds);
+  else
+    view->Layout();
+}
+
 View* Window::GetContentView() const {
   return content_view_.get();
 }
@@ -68,6 +88,126 @@ void Window::SetMenuBar(scoped_refptr<MenuBar> menu_bar) {
 }
 #endif
 
+int Window::RequestFrame(FrameCallback callback) {
+  bool was_empty = frame_callbacks_.empty();
+  int id = ++next_frame_id_;
+  frame_callbacks_.emplace_back(id, std::move(callback));
+  if (was_empty)
+    PlatformRequestFrame();
+  return id;
+}
+
+void Window::CancelFrame(int id) {
+  auto it = std::find_if(frame_callbacks_.begin(), frame_callbacks_.end(),
+                         [id](const auto& it) { return it.first == id; });
+  if (it != frame_callbacks_.end())
+    frame_callbacks_.erase(it);
+}
+
+void Window::SetLiveResizeThrottled(bool throttled) {
+  live_resize_throttled_ = throttled;
+}
+
+void Window::SetLiveResizeApproximated(bool approximated) {
+  live_resize_approximated_ = approximated;
+}
+
+void Window::NotifyLiveResizeStart() {
+  in_live_resize_ = true;
+}
+
+void Window::NotifyLiveResizeEnd() {
+  if (!in_live_resize_)
+    return;
+  bool approximated = IsApproximatingLayout();
+  in_live_resize_ = false;
+  if (live_resize_frame_) {
+    CancelFrame(live_resize_frame_);
+    live_resize_frame_ = 0;
+  }
+  if (!content_view_)
+    return;
+  // Do the skipped layout and replace the approximated measurements.
+  LayoutTransaction transaction;
+  if (approximated)
+    content_view_->OnLiveResizeEnd();
+  content_view_->Layout();
+}
+
+bool Window::DeferLayoutForLiveResize() {
+  if (!in_live_resize_ || !live_resize_throttled_)
+    return false;
+  if (live_resize_layout_due_) {
+    live_resize_layout_due_ = false;
+    return false;
+  }
+  if (!live_resize_frame_) {
+    live_resize_frame_ = RequestFrame([this](double) {
+      live_resize_frame_ = 0;
+      if (!content_view_)
+        return;
+      live_resize_layout_due_ = true;
+      content_view_->Layout();
+    });
+  }
+  return true;
+}
+
+void Window::SetLayoutDeferredUntilShown(bool deferred) {
+  layout_deferred_until_shown_ = deferred;
+  // Catch up with the layouts skipped so far.
+  if (!deferred && layout_skipped_until_shown_) {
+    layout_skipped_until_shown_ = false;
+    content_view_->Layout();
+  }
+}
+
+bool Window::DeferLayoutUntilShown() {
+  if (!IsWaitingForFirstShow())
+    return false;
+  layout_skipped_until_shown_ = true;
+  return true;
+}
+
+void Window::NotifyWillShow() {
+  if (has_been_shown_)
+    return;
+  has_been_shown_ = true;
+  // Do one full layout so the first frame is correct.
+  if (layout_skipped_until_shown_) {
+    layout_skipped_until_shown_ = false;
+    content_view_->Layout();
+  }
+}
+
+void Window::NotifyOcclusionChanged() {
+  bool occluded = IsOccluded();
+  App::GetCurrent()->UpdateWindowOcclusion(this, is_closed_ || occluded);
+  if (occluded)
+    return;
+  if (!frame_callbacks_.empty())
+    PlatformRequestFrame();
+  FrameClock::GetCurrent()->UpdateVisibility();
+}
+
+bool Window::RunFrameCallbacks(double timestamp) {
+  MessageLoop::DidProduceFrame();
+  // Keep the callbacks until the window can be seen again.
+  if (frame_callbacks_.empty() || IsOccluded())
+    return false;
+  // The callbacks may close the window or request new frames.
+  scoped_refptr<Window> self(this);
+  std::vector<std::pair<int, FrameCallback>> callbacks;
+  callbacks.swap(frame_callbacks_);
+  {
+    // Changes made by all callbacks are laid out once.
+    LayoutTransaction transaction;
+    for (const auto& it : callbacks)
+      it.second(timestamp);
+  }
+  return !frame_callbacks_.empty();
+}
+
 void Window::AddChildWindow(scoped_refptr<Window> child) {
   if (child->GetParentWindow())
     return;
@@ -102,6 +242,7 @@ std::vector<Window*> Window::GetChildWindows() const {
 void Window::NotifyWindowClosed() {
   DCHECK(!is_closed_);
   is_closed_ = true;
+  App::GetCurrent()->UpdateWindowOcclusion(this, true);
   for (const auto& i : child_windows_) {
     i->should_close = nullptr;  // don't give user a chance to cancel.
     i->Close();
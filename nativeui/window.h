@@ -8,6 +8,7 @@
 #include <functional>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "nativeui/container.h"
@@ -26,6 +27,7 @@
 
 namespace nu {
 
+class EventRecorder;
 class MenuBar;
 
 #if defined(OS_MACOSX)
@@ -44,6 +46,11 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
 #if defined(OS_MACOSX)
     // Show window buttons for the frameless window.
     bool show_traffic_lights = false;
+#elif defined(OS_WIN)
+    // Draw the custom contents of containers with Direct2D.
+    bool direct2d = false;
+    // Present transparent window with DirectComposition.
+    bool direct_composition = false;
 #endif
   };
 
@@ -57,6 +64,9 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   bool HasShadow() const;
 
   void SetContentView(scoped_refptr<View> view);
+  // Lay out a detached |view| for current content size, so it can later be
+  // passed to SetContentView without being laid out again.
+  void PrepareContentView(View* view);
   View* GetContentView() const;
 
   void Center();
@@ -86,6 +96,10 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   void Restore();
   bool IsMinimized() const;
 
+  // Whether the window can not be seen, because it is hidden, minimized, or
+  // fully covered by other windows.
+  bool IsOccluded() const;
+
   void SetResizable(bool resizable);
   bool IsResizable() const;
   void SetMaximizable(bool maximizable);
@@ -119,15 +133,82 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   void RemoveChildWindow(Window* child);
   std::vector<Window*> GetChildWindows() const;
 
+  // Call |callback| before the next frame is drawn, with the timestamp of the
+  // frame in milliseconds. Callbacks requested for the same frame are run in
+  // one batch, returns an ID that can be passed to CancelFrame.
+  using FrameCallback = std::function<void(double)>;
+  int RequestFrame(FrameCallback callback);
+  void CancelFrame(int id);
+
+  // Lay out the content view at most once per frame while the user is
+  // resizing the window, which is disabled by default.
+  void SetLiveResizeThrottled(bool throttled);
+  bool IsLiveResizeThrottled() const { return live_resize_throttled_; }
+
+  // Reuse the last measured sizes of texts while the user is resizing the
+  // window, and measure them again after the resize ends. Disabled by default.
+  void SetLiveResizeApproximated(bool approximated);
+  bool IsLiveResizeApproximated() const { return live_resize_approximated_; }
+
+  // Return whether the user is resizing the window.
+  bool IsInLiveResize() const { return in_live_resize_; }
+
+  // Internal: Notify that the user starts or ends resizing the window.
+  void NotifyLiveResizeStart();
+  void NotifyLiveResizeEnd();
+
+  // Internal: Return true if the layout of content view should wait for the
+  // next frame.
+  bool DeferLayoutForLiveResize();
+
+  // Internal: Whether texts should reuse their last measured sizes.
+  bool IsApproximatingLayout() const {
+    return in_live_resize_ && live_resize_approximated_;
+  }
+
+  // Skip laying out the content view until the window is shown for the first
+  // time, which is disabled by default.
+  void SetLayoutDeferredUntilShown(bool deferred);
+  bool IsLayoutDeferredUntilShown() const {
+    return layout_deferred_until_shown_;
+  }
+
+  // Internal: Whether layouts are skipped because the window has never been
+  // shown.
+  bool IsWaitingForFirstShow() const {
+    return layout_deferred_until_shown_ && !has_been_shown_;
+  }
+
+  // Internal: Return true if the layout of content view should wait until the
+  // window is shown.
+  bool DeferLayoutUntilShown();
+
+  // Internal: Notify that the window is about to be shown.
+  void NotifyWillShow();
+
   // Internal: Destroy all child windows and notify window is closed.
   void NotifyWindowClosed();
 
+  // Internal: Resume the animations and frame callbacks that were suspended
+  // while the window was occluded.
+  void NotifyOcclusionChanged();
+
+  // Internal: Run the callbacks requested for current frame, returns whether
+  // there are callbacks requested for the next frame.
+  bool RunFrameCallbacks(double timestamp);
+
   // Get the native window object.
   NativeWindow GetNative() const { return window_; }
 
   // Internal: Get the yogo config object.
   YGConfigRef GetYogaConfig() const { return yoga_config_; }
 
+  // Internal: The recorder of the events dispatched to the views of window.
+  void set_event_recorder(EventRecorder* recorder) {
+    event_recorder_ = recorder;
+  }
+  EventRecorder* event_recorder() const { return event_recorder_; }
+
   // Events.
   Signal<void(Window*)> on_close;
   Signal<void(Window*)> on_focus;
@@ -151,6 +232,8 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
 #endif
   void PlatformAddChildWindow(Window* child);
   void PlatformRemoveChildWindow(Window* child);
+  // Start receiving frame notifications, can be called when already started.
+  void PlatformRequestFrame();
 
   // Whether window has a native chrome.
   bool has_frame_;
@@ -158,12 +241,15 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   // Whether window is transparent.
   bool transparent_;
 
-  // The yoga config for window's children.
+  // The yoga config for window's children, owned by State.
   YGConfigRef yoga_config_;
 
   // Whehter window has been closed.
   bool is_closed_ = false;
 
+  // Not owned, set by the recorder when recording.
+  EventRecorder* event_recorder_ = nullptr;
+
 #if defined(OS_MACOSX)
   scoped_refptr<Toolbar> toolbar_;
 #endif
@@ -175,6 +261,34 @@ class NATIVEUI_EXPORT Window : public base::RefCounted<Window> {
   Window* parent_ = nullptr;
   std::vector<scoped_refptr<Window>> child_windows_;
 
+  // Callbacks for the next frame.
+  int next_frame_id_ = 0;
+  std::vector<std::pair<int, FrameCallback>> frame_callbacks_;
+
+  // Live resize states.
+  bool live_resize_throttled_ = false;
+  bool live_resize_approximated_ = false;
+  bool in_live_resize_ = false;
+  // The frame callback doing the deferred layout.
+  int live_resize_frame_ = 0;
+  // Set when the deferred layout is being done.
+  bool live_resize_layout_due_ = false;
+
+  // First show states.
+  bool layout_deferred_until_shown_ = false;
+  bool has_been_shown_ = false;
+  // Set when a layout has been skipped before the first show.
+  bool layout_skipped_until_shown_ = false;
+
+#if defined(OS_MACOSX)
+  // The CVDisplayLinkRef driving the frame callbacks.
+  void* display_link_ = nullptr;
+#elif defined(OS_LINUX)
+  unsigned int tick_callback_id_ = 0;
+#elif defined(OS_WIN)
+  UINT_PTR frame_timer_ = 0;
+#endif
+
   NativeWindow window_ = nullptr;
   scoped_refptr<View> content_view_;
 };
@@ -2,6 +2,10 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "nativeui/nativeui.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -70,6 +74,77 @@ TEST_F(WindowTest, OnClose) {
   EXPECT_EQ(closed, true);
 }
 
+TEST_F(WindowTest, RequestFrame) {
+  std::vector<double> timestamps;
+  window_->RequestFrame([&](double t) { timestamps.push_back(t); });
+  int id = window_->RequestFrame([&](double t) { timestamps.push_back(-t); });
+  window_->RequestFrame([&](double t) {
+    timestamps.push_back(t);
+    window_->RequestFrame([&](double t) { timestamps.push_back(t); });
+  });
+  window_->CancelFrame(id);
+  EXPECT_TRUE(window_->RunFrameCallbacks(16));
+  EXPECT_EQ(timestamps, std::vector<double>({16, 16}));
+  EXPECT_FALSE(window_->RunFrameCallbacks(32));
+  EXPECT_EQ(timestamps, std::vector<double>({16, 16, 32}));
+  EXPECT_FALSE(window_->RunFrameCallbacks(48));
+}
+
+TEST_F(WindowTest, LiveResizeThrottled) {
+  scoped_refptr<nu::Container> container = new nu::Container;
+  scoped_refptr<nu::Label> label = new nu::Label("label");
+  label->SetStyle("flex", 1.f);
+  container->AddChildView(label.get());
+  window_->SetContentView(container.get());
+  window_->SetContentSize(nu::SizeF(100, 100));
+  EXPECT_EQ(label->GetBounds().width(), 100);
+
+  window_->SetLiveResizeThrottled(true);
+  window_->NotifyLiveResizeStart();
+  EXPECT_TRUE(window_->IsInLiveResize());
+  window_->SetContentSize(nu::SizeF(200, 200));
+  window_->SetContentSize(nu::SizeF(300, 300));
+  EXPECT_EQ(label->GetBounds().width(), 100);
+  window_->RunFrameCallbacks(16);
+  EXPECT_EQ(label->GetBounds().width(), 300);
+
+  window_->SetContentSize(nu::SizeF(400, 400));
+  window_->NotifyLiveResizeEnd();
+  EXPECT_FALSE(window_->IsInLiveResize());
+  EXPECT_EQ(label->GetBounds().width(), 400);
+}
+
+TEST_F(WindowTest, LayoutDeferredUntilShown) {
+  window_->SetLayoutDeferredUntilShown(true);
+  scoped_refptr<nu::Container> container = new nu::Container;
+  scoped_refptr<nu::Label> label = new nu::Label("label");
+  label->SetStyle("flex", 1.f);
+  container->AddChildView(label.get());
+  window_->SetContentView(container.get());
+  window_->SetContentSize(nu::SizeF(100, 100));
+  EXPECT_EQ(label->GetBounds().width(), 0);
+
+  window_->SetVisible(true);
+  EXPECT_EQ(label->GetBounds().width(), 100);
+  window_->SetContentSize(nu::SizeF(200, 200));
+  EXPECT_EQ(label->GetBounds().width(), 200);
+}
+
+TEST_F(WindowTest, PrepareContentView) {
+  window_->SetContentSize(nu::SizeF(100, 100));
+  scoped_refptr<nu::Container> container = new nu::Container;
+  scoped_refptr<nu::Label> label = new nu::Label("label");
+  label->SetStyle("flex", 1.f);
+  container->AddChildView(label.get());
+  window_->PrepareContentView(container.get());
+  EXPECT_EQ(label->GetBounds().width(), 100);
+
+  state_.SetLayoutStatsEnabled(true);
+  window_->SetContentView(container.get());
+  EXPECT_EQ(state_.GetLayoutStats().layout_count, 0);
+  EXPECT_EQ(label->GetBounds().width(), 100);
+}
+
 TEST_F(WindowTest, ShouldClose) {
   bool closed = false;
   window_->on_close.Connect([&closed](nu::Window*) { closed = true; });
@@ -163,3 +238,46 @@ TEST_F(WindowTest, ParentWindowCloseChild) {
   window_->Close();
   EXPECT_EQ(closed, true);
 }
+
+TEST_F(WindowTest, BackgroundMode) {
+  nu::App* app = nu::App::GetCurrent();
+  app->SetBackgroundTimerInterval(10);
+  int entered = 0;
+  int left = 0;
+  app->on_enter_background.Connect([&](nu::App*) { ++entered; });
+  app->on_leave_background.Connect([&](nu::App*) { ++left; });
+  // Not in background before any window is shown.
+  app->UpdateWindowOcclusion(window_.get(), true);
+  EXPECT_FALSE(app->IsInBackground());
+  app->UpdateWindowOcclusion(window_.get(), false);
+  app->UpdateWindowOcclusion(window_.get(), true);
+  EXPECT_TRUE(app->IsInBackground());
+  EXPECT_EQ(entered, 1);
+  // Timers still run when throttled.
+  bool ran = false;
+  nu::MessageLoop::PostDelayedTask(0, [&ran]() {
+    ran = true;
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  EXPECT_TRUE(ran);
+  app->UpdateWindowOcclusion(window_.get(), false);
+  EXPECT_FALSE(app->IsInBackground());
+  EXPECT_EQ(left, 1);
+  // The window enters background again when destroyed.
+  app->on_enter_background.DisconnectAll();
+}
+
+TEST_F(WindowTest, StartupStats) {
+  nu::StartupStats stats = nu::State::GetStartupStats();
+  std::vector<std::string> names;
+  for (const auto& phase : stats.phases) {
+    names.push_back(phase.name);
+    EXPECT_GE(phase.start, base::TimeDelta());
+  }
+  // Each phase is only recorded once.
+  EXPECT_EQ(std::count(names.begin(), names.end(), "State"), 1);
+  EXPECT_EQ(std::count(names.begin(), names.end(), "FirstWindow"), 1);
+  ASSERT_FALSE(stats.phases.empty());
+  EXPECT_EQ(stats.phases[0].start, base::TimeDelta());
+}
@@ -0,0 +1,188 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "node_yue/array_table_model.h"
+
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "node_yue/binding_values.h"
+
+namespace node_yue {
+
+namespace {
+
+// Return the number of elements in an array or a typed array.
+uint32_t GetLength(v8::Local<v8::Value> value) {
+  if (value->IsTypedArray())
+    return static_cast<uint32_t>(value.As<v8::TypedArray>()->Length());
+  if (value->IsArray())
+    return value.As<v8::Array>()->Length();
+  return 0;
+}
+
+// Numbers that can not be represented in base::Value are treated as null.
+base::Value NumberToValue(double number) {
+  if (!std::isfinite(number))
+    return base::Value();
+  return base::Value(number);
+}
+
+}  // namespace
+
+// static
+ArrayTableModel* ArrayTableModel::CreateWithRows(
+    v8::Local<v8::Context> context,
+    v8::Local<v8::Array> rows) {
+  return new ArrayTableModel(context, rows, false);
+}
+
+// static
+ArrayTableModel* ArrayTableModel::CreateWithColumns(
+    v8::Local<v8::Context> context,
+    v8::Local<v8::Array> columns) {
+  return new ArrayTableModel(context, columns, true);
+}
+
+ArrayTableModel::ArrayTableModel(v8::Local<v8::Context> context,
+                                 v8::Local<v8::Array> data,
+                                 bool by_columns)
+    : isolate_(context->GetIsolate()),
+      context_(isolate_, context),
+      data_(isolate_, data),
+      by_columns_(by_columns) {}
+
+ArrayTableModel::~ArrayTableModel() {}
+
+void ArrayTableModel::SetRows(v8::Local<v8::Context> context,
+                              v8::Local<v8::Array> rows) {
+  data_.Reset(isolate_, rows);
+  by_columns_ = false;
+  NotifyReset();
+}
+
+void ArrayTableModel::SetColumns(v8::Local<v8::Context> context,
+                                 v8::Local<v8::Array> columns) {
+  data_.Reset(isolate_, columns);
+  by_columns_ = true;
+  NotifyReset();
+}
+
+v8::Local<v8::Array> ArrayTableModel::GetData(
+    v8::Local<v8::Context> context) const {
+  return data_.Get(isolate_);
+}
+
+uint32_t ArrayTableModel::GetRowCount() const {
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Array> data = data_.Get(isolate_);
+  if (!by_columns_)
+    return data->Length();
+  // The first column decides the number of rows.
+  v8::Local<v8::Value> column;
+  if (data->Length() == 0 ||
+      !data->Get(context_.Get(isolate_), 0).ToLocal(&column))
+    return 0;
+  return GetLength(column);
+}
+
+const base::Value* ArrayTableModel::GetValue(uint32_t column,
+                                             uint32_t row) const {
+  v8::HandleScope handle_scope(isolate_);
+  v8::Local<v8::Context> context = context_.Get(isolate_);
+  v8::Context::Scope context_scope(context);
+
+  copy_ = base::Value();
+  v8::Local<v8::Object> container;
+  uint32_t index;
+  if (!GetContainer(context, column, row, &container, &index))
+    return &copy_;
+
+  // Numbers in typed arrays are read without creating handles.
+  if (container->IsTypedArray() &&
+      ReadTypedArray(container.As<v8::TypedArray>(), index))
+    return &copy_;
+
+  v8::Local<v8::Value> cell;
+  if (!container->Get(context, index).ToLocal(&cell))
+    return &copy_;
+  if (cell->IsInt32()) {
+    copy_ = base::Value(cell.As<v8::Int32>()->Value());
+  } else if (cell->IsNumber()) {
+    copy_ = NumberToValue(cell.As<v8::Number>()->Value());
+  } else if (cell->IsBoolean()) {
+    copy_ = base::Value(cell.As<v8::Boolean>()->Value());
+  } else if (cell->IsString()) {
+    v8::String::Utf8Value str(isolate_, cell);
+    copy_ = base::Value(std::string(*str, str.length()));
+  } else if (!cell->IsNullOrUndefined()) {
+    // Other values are rare in tables, use the generic conversion.
+    if (!vb::FromV8(context, cell, &copy_))
+      copy_ = base::Value();
+  }
+  return &copy_;
+}
+
+void ArrayTableModel::SetValue(uint32_t column, uint32_t row,
+                               base::Value value) {
+  {
+    v8::HandleScope handle_scope(isolate_);
+    v8::Local<v8::Context> context = context_.Get(isolate_);
+    v8::Context::Scope context_scope(context);
+    v8::Local<v8::Object> container;
+    uint32_t index;
+    if (!GetContainer(context, column, row, &container, &index))
+      return;
+    if (!container->Set(context, index, vb::ToV8(context, value))
+             .FromMaybe(false))
+      return;
+  }
+  NotifyValueChange(column, row);
+}
+
+bool ArrayTableModel::GetContainer(v8::Local<v8::Context> context,
+                                   uint32_t column, uint32_t row,
+                                   v8::Local<v8::Object>* container,
+                                   uint32_t* index) const {
+  v8::Local<v8::Array> data = data_.Get(isolate_);
+  uint32_t outer = by_columns_ ? column : row;
+  *index = by_columns_ ? row : column;
+  v8::Local<v8::Value> value;
+  if (outer >= data->Length() ||
+      !data->Get(context, outer).ToLocal(&value) ||
+      *index >= GetLength(value))
+    return false;
+  *container = value.As<v8::Object>();
+  return true;
+}
+
+bool ArrayTableModel::ReadTypedArray(v8::Local<v8::TypedArray> array,
+                                     uint32_t index) const {
+  const char* data =
+      static_cast<const char*>(array->Buffer()->GetContents().Data()) +
+      array->ByteOffset();
+  if (array->IsFloat64Array())
+    copy_ = NumberToValue(reinterpret_cast<const double*>(data)[index]);
+  else if (array->IsFloat32Array())
+    copy_ = NumberToValue(reinterpret_cast<const float*>(data)[index]);
+  else if (array->IsInt32Array())
+    copy_ = base::Value(reinterpret_cast<const int32_t*>(data)[index]);
+  else if (array->IsUint32Array())
+    copy_ = base::Value(
+        static_cast<double>(reinterpret_cast<const uint32_t*>(data)[index]));
+  else if (array->IsInt16Array())
+    copy_ = base::Value(reinterpret_cast<const int16_t*>(data)[index]);
+  else if (array->IsUint16Array())
+    copy_ = base::Value(reinterpret_cast<const uint16_t*>(data)[index]);
+  else if (array->IsInt8Array())
+    copy_ = base::Value(reinterpret_cast<const int8_t*>(data)[index]);
+  else if (array->IsUint8Array() || array->IsUint8ClampedArray())
+    copy_ = base::Value(reinterpret_cast<const uint8_t*>(data)[index]);
+  else
+    return false;
+  return true;
+}
+
+}  // namespace node_yue
@@ -0,0 +1,71 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NODE_YUE_ARRAY_TABLE_MODEL_H_
+#define NODE_YUE_ARRAY_TABLE_MODEL_H_
+
+#include <node.h>
+
+#include "nativeui/nativeui.h"
+
+namespace node_yue {
+
+// A TableModel that reads cells from JavaScript arrays directly.
+//
+// The data is either an array of rows, where each row is an array of cells,
+// or an array of columns, where each column is an array or a typed array.
+// Cells are read through V8 handles when tables paint, and numbers in typed
+// arrays are read from their buffers, so the data is never copied into
+// base::Value trees.
+class ArrayTableModel : public nu::TableModel {
+ public:
+  static ArrayTableModel* CreateWithRows(v8::Local<v8::Context> context,
+                                         v8::Local<v8::Array> rows);
+  static ArrayTableModel* CreateWithColumns(v8::Local<v8::Context> context,
+                                            v8::Local<v8::Array> columns);
+
+  // Replace the data and reload the tables.
+  void SetRows(v8::Local<v8::Context> context, v8::Local<v8::Array> rows);
+  void SetColumns(v8::Local<v8::Context> context,
+                  v8::Local<v8::Array> columns);
+
+  // Return the array passed to create the model.
+  v8::Local<v8::Array> GetData(v8::Local<v8::Context> context) const;
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  const base::Value* GetValue(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+ protected:
+  ArrayTableModel(v8::Local<v8::Context> context,
+                  v8::Local<v8::Array> data,
+                  bool by_columns);
+  ~ArrayTableModel() override;
+
+ private:
+  // Return the array holding the cell at |column| and |row|, and the index of
+  // the cell in it.
+  bool GetContainer(v8::Local<v8::Context> context,
+                    uint32_t column, uint32_t row,
+                    v8::Local<v8::Object>* container,
+                    uint32_t* index) const;
+
+  // Read the number at |index| of |array| from its buffer.
+  bool ReadTypedArray(v8::Local<v8::TypedArray> array, uint32_t index) const;
+
+  v8::Isolate* isolate_;
+  v8::Global<v8::Context> context_;
+  v8::Global<v8::Array> data_;
+  bool by_columns_;
+
+  // Temporary storage of the value returned by GetValue.
+  mutable base::Value copy_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArrayTableModel);
+};
+
+}  // namespace node_yue
+
+#endif  // NODE_YUE_ARRAY_TABLE_MODEL_H_
@@ -0,0 +1,49 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+const {kInnerLoop, runPerfTest} = require('./common')
+
+// Callbacks of v8binding and the lookups of templates in PerIsolateData.
+module.exports = function(gui) {
+  const label = gui.Label.create('yue')
+
+  // Methods defined in the prototype of the class itself.
+  runPerfTest('NodeMethodCallOwn', 100, () => {
+    for (let i = 0; i < kInnerLoop; ++i)
+      label.getText()
+  })
+
+  // Methods defined in the prototypes of base classes.
+  runPerfTest('NodeMethodCallInherited', 100, () => {
+    for (let i = 0; i < kInnerLoop; ++i)
+      label.isVisible()
+  })
+
+  // Methods converting arguments.
+  runPerfTest('NodeMethodCallWithArgs', 100, () => {
+    for (let i = 0; i < kInnerLoop; ++i)
+      label.setAlign('center')
+  })
+
+  // Returning objects that already have wrappers.
+  const container = gui.Container.create()
+  container.addChildView(label)
+  runPerfTest('NodePushCachedObject', 100, () => {
+    for (let i = 0; i < kInnerLoop; ++i)
+      container.childAt(0)
+  })
+
+  // Creating objects, which looks up the templates of the class and its base
+  // classes.
+  runPerfTest('NodeCreateObject', 100, () => {
+    for (let i = 0; i < kInnerLoop; ++i)
+      gui.Label.create('yue')
+  })
+
+  // Reading the cached signal properties.
+  runPerfTest('NodeGetSignalProperty', 100, () => {
+    for (let i = 0; i < kInnerLoop; ++i)
+      label.onMouseDown
+  })
+}
@@ -0,0 +1,54 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+const fs = require('fs')
+
+// Number of times the benchmarked code runs in each iteration, so the cost of
+// the loop in runPerfTest is not counted.
+const kInnerLoop = 1000
+
+// The runtime is recorded with each result so they can be compared across
+// Node and Electron versions.
+const runtime = process.versions.electron ? 'electron' : 'node'
+const runtimeVersion = process.versions.electron || process.versions.node
+
+let filter = null
+
+function setFilter(pattern) {
+  filter = pattern
+}
+
+function round(value) {
+  return Math.round(value * 1000) / 1000
+}
+
+// Run |task| for |iterations| times and print the result as one line of JSON,
+// which has the same fields with the results of nativeui_perftests followed
+// by the versions of the runtime.
+function runPerfTest(name, iterations, task) {
+  if (filter && !name.includes(filter))
+    return
+  // Run a few times first so the results do not include the compilation of
+  // the code by V8.
+  for (let i = 0; i < Math.min(iterations, 10); ++i)
+    task(i)
+  const start = process.hrtime.bigint()
+  for (let i = 0; i < iterations; ++i)
+    task(i)
+  const total = Number(process.hrtime.bigint() - start) / 1e6
+  const line = JSON.stringify({
+    test: name,
+    iterations,
+    total_ms: round(total),
+    mean_us: round(total * 1000 / iterations),
+    runtime,
+    version: runtimeVersion,
+    v8: process.versions.v8,
+  }) + '\n'
+  process.stdout.write(line)
+  if (process.env.NATIVEUI_PERF_OUTPUT)
+    fs.appendFileSync(process.env.NATIVEUI_PERF_OUTPUT, line)
+}
+
+module.exports = {kInnerLoop, setFilter, runPerfTest}
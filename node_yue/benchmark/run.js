@@ -0,0 +1,33 @@
+#!/usr/bin/env node
+
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+// Usage: run.js path/to/gui.node [filter]
+//
+// The module must be built with node_yue_benchmark=true, each result is
+// printed as one line of JSON.
+
+const path = require('path')
+const {setFilter} = require('./common')
+
+if (process.argv.length < 3) {
+  console.error('Usage: run.js path/to/gui.node [filter]')
+  process.exit(1)
+}
+
+const gui = require(path.resolve(process.argv[2]))
+if (!gui._benchmark) {
+  console.error('The module is not built with node_yue_benchmark=true')
+  process.exit(1)
+}
+if (process.argv[3])
+  setFilter(process.argv[3])
+
+for (const suite of ['bindings', 'signals', 'values', 'table_model'])
+  require(`./${suite}`)(gui)
+
+if (gui.MessageLoop)
+  gui.MessageLoop.quit()
+process.exit(0)
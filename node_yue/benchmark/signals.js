@@ -0,0 +1,27 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+const {kInnerLoop, runPerfTest} = require('./common')
+
+// Emitting signals into JavaScript handlers.
+module.exports = function(gui) {
+  let count = 0
+  gui.app.onEnterBackground = () => { ++count }
+  runPerfTest('NodeSignalEmit', 100, () => {
+    gui._benchmark.emitSignal(kInnerLoop)
+  })
+  gui.app.onEnterBackground.disconnectAll()
+  if (count == 0)
+    throw new Error('Signal handlers are not called')
+
+  // Connecting and disconnecting handlers.
+  const label = gui.Label.create('yue')
+  const handler = () => {}
+  runPerfTest('NodeSignalConnect', 100, () => {
+    for (let i = 0; i < kInnerLoop; ++i) {
+      const id = label.onMouseDown.connect(handler)
+      label.onMouseDown.disconnect(id)
+    }
+  })
+}
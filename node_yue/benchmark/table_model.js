@@ -0,0 +1,31 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+const {runPerfTest} = require('./common')
+
+const kRows = 1000
+const kColumns = 4
+
+// Fetching cells of table models from C++, as tables do when painting.
+module.exports = function(gui) {
+  // Each cell is fetched by calling into JavaScript.
+  const abstract = gui.AbstractTableModel.create()
+  abstract.getRowCount = () => kRows
+  abstract.getValue = (model, column, row) => `${column}:${row}`
+  runPerfTest('NodeAbstractTableModelGetValue', 10, () => {
+    gui._benchmark.getTableCells(abstract, kColumns)
+  })
+
+  // Cells are stored in C++.
+  const simple = gui.SimpleTableModel.create(kColumns)
+  for (let row = 0; row < kRows; ++row) {
+    const cells = []
+    for (let column = 0; column < kColumns; ++column)
+      cells.push(`${column}:${row}`)
+    simple.addRow(cells)
+  }
+  runPerfTest('NodeSimpleTableModelGetValue', 10, () => {
+    gui._benchmark.getTableCells(simple, kColumns)
+  })
+}
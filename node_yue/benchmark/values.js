@@ -0,0 +1,38 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+const {runPerfTest} = require('./common')
+
+// Converting values between V8 and base::Value with V8ValueConverterImpl.
+module.exports = function(gui) {
+  const small = {name: 'yue', size: [800, 600], visible: true}
+  runPerfTest('NodeConvertSmallObject', 100, () => {
+    gui._benchmark.convertValue(small, 100)
+  })
+
+  // A nested object similar to the rows of a big table.
+  const rows = []
+  for (let i = 0; i < 1000; ++i) {
+    rows.push({
+      id: i,
+      title: `Row ${i}`,
+      tags: ['a', 'b', 'c'],
+      meta: {created: i * 1000, checked: i % 2 == 0, score: i / 7},
+    })
+  }
+  const big = {rows, total: rows.length}
+  runPerfTest('NodeConvertNestedObject', 10, () => {
+    gui._benchmark.convertValue(big, 1)
+  })
+
+  // Typed arrays are converted to binary values.
+  const bytes = new Uint8Array(1024 * 1024)
+  runPerfTest('NodeConvertUint8Array', 100, () => {
+    gui._benchmark.convertValue(bytes, 1)
+  })
+  const floats = new Float64Array(64 * 1024)
+  runPerfTest('NodeConvertFloat64Array', 100, () => {
+    gui._benchmark.convertValue(floats, 1)
+  })
+}
@@ -5,7 +5,9 @@
 #include <node.h>
 
 #include "base/notreached.h"
+#include "base/strings/string_util.h"
 #include "nativeui/nativeui.h"
+#include "node_yue/array_table_model.h"
 #include "node_yue/binding_signal.h"
 #include "node_yue/binding_values.h"
 #include "node_yue/node_integration.h"
@@ -21,6 +23,14 @@ namespace {
 bool is_electron = false;
 bool is_yode = false;
 
+// Handlers of the tasks posted from worker threads, keyed by channel names,
+// which are only accessed in the GUI thread.
+using WorkerTaskHandler = std::function<void(nu::Buffer)>;
+std::map<std::string, WorkerTaskHandler>& GetWorkerTaskHandlers() {
+  static auto* handlers = new std::map<std::string, WorkerTaskHandler>;
+  return *handlers;
+}
+
 }  // namespace
 
 namespace vb {
@@ -52,6 +62,27 @@ struct Type<nu::Buffer> {
                               static_cast<char*>(value.content()),
                               value.size()).ToLocalChecked();
   }
+  // The memory of buffers that own it is moved into node without copying.
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   nu::Buffer&& value) {
+    if (!value.owns_content())
+      return ToV8(context, static_cast<const nu::Buffer&>(value));
+    v8::Isolate* isolate = context->GetIsolate();
+    char* content = static_cast<char*>(value.content());
+    size_t size = value.size();
+    auto* free = new nu::Buffer::FreeFunc(value.Release());
+    v8::Local<v8::Object> result;
+    // Node frees the memory with the callback when failed.
+    if (!node::Buffer::New(isolate, content, size, &FreeContent, free)
+             .ToLocal(&result))
+      return v8::Undefined(isolate);
+    return result;
+  }
+  static void FreeContent(char* content, void* hint) {
+    auto* free = static_cast<nu::Buffer::FreeFunc*>(hint);
+    (*free)(content);
+    delete free;
+  }
   static bool FromV8(v8::Local<v8::Context> context,
                      v8::Local<v8::Value> value,
                      nu::Buffer* out) {
@@ -231,6 +262,43 @@ struct Type<nu::ImageScale> {
   }
 };
 
+template<>
+struct Type<nu::ImageQuality> {
+  static constexpr const char* name = "ImageQuality";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::ImageQuality* out) {
+    std::string quality;
+    if (!vb::FromV8(context, value, &quality))
+      return false;
+    if (quality == "low") {
+      *out = nu::ImageQuality::Low;
+      return true;
+    } else if (quality == "medium") {
+      *out = nu::ImageQuality::Medium;
+      return true;
+    } else if (quality == "high") {
+      *out = nu::ImageQuality::High;
+      return true;
+    } else {
+      return false;
+    }
+  }
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   nu::ImageQuality quality) {
+    switch (quality) {
+      case nu::ImageQuality::Low:
+        return vb::ToV8(context, "low");
+      case nu::ImageQuality::Medium:
+        return vb::ToV8(context, "medium");
+      case nu::ImageQuality::High:
+        return vb::ToV8(context, "high");
+    }
+    NOTREACHED();
+    return v8::Undefined(context->GetIsolate());
+  }
+};
+
 template<>
 struct Type<nu::Orientation> {
   static constexpr const char* name = "Orientation";
@@ -284,6 +352,8 @@ struct Type<nu::Lifetime> {
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ, "fastExit", &nu::Lifetime::FastExit);
+    SetProperty(context, templ, "onFastExit", &nu::Lifetime::on_fast_exit);
 #if defined(OS_MACOSX)
     SetProperty(context, templ,
                 "onReady", &nu::Lifetime::on_ready,
@@ -292,6 +362,30 @@ struct Type<nu::Lifetime> {
   }
 };
 
+template<>
+struct Type<nu::MessageLoop::Priority> {
+  static constexpr const char* name = "MessageLoopPriority";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::MessageLoop::Priority* out) {
+    std::string priority;
+    if (!vb::FromV8(context, value, &priority))
+      return false;
+    if (priority == "user-blocking") {
+      *out = nu::MessageLoop::Priority::UserBlocking;
+      return true;
+    } else if (priority == "normal") {
+      *out = nu::MessageLoop::Priority::Normal;
+      return true;
+    } else if (priority == "idle") {
+      *out = nu::MessageLoop::Priority::Idle;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
 template<>
 struct Type<nu::MessageLoop> {
   static constexpr const char* name = "MessageLoop";
@@ -299,8 +393,13 @@ struct Type<nu::MessageLoop> {
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
         "quit", &nu::MessageLoop::Quit,
-        "postTask", &nu::MessageLoop::PostTask,
-        "postDelayedTask", &nu::MessageLoop::PostDelayedTask);
+        "postTask", &PostTask,
+        "postTaskWithPriority", &PostTaskWithPriority,
+        "postDelayedTask", &PostDelayedTask,
+        "postUnthrottledDelayedTask", &PostUnthrottledDelayedTask,
+        "postIdleTask", &PostIdleTask,
+        "setWorkerTaskHandler", &SetWorkerTaskHandler,
+        "removeWorkerTaskHandler", &RemoveWorkerTaskHandler);
     // The "run" method should never be used in yode runtime.
     if (!is_yode) {
       Set(context, constructor, "run", &nu::MessageLoop::Run);
@@ -309,6 +408,272 @@ struct Type<nu::MessageLoop> {
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
   }
+  // Report the caller in script as where the task is posted.
+  static std::string GetPostingSite(Arguments* args) {
+    if (!nu::State::GetCurrent()->IsMessageLoopStatsEnabled())
+      return std::string();
+    v8::Isolate* isolate = args->isolate();
+    v8::Local<v8::StackTrace> trace =
+        v8::StackTrace::CurrentStackTrace(isolate, 1);
+    if (trace->GetFrameCount() == 0)
+      return std::string();
+    v8::Local<v8::StackFrame> frame = trace->GetFrame(isolate, 0);
+    std::string script;
+    vb::FromV8(isolate->GetCurrentContext(), frame->GetScriptName(), &script);
+    return script + ":" + std::to_string(frame->GetLineNumber());
+  }
+  static void PostTask(Arguments* args, nu::MessageLoop::Task task) {
+    nu::MessageLoop::PostTaskFrom(GetPostingSite(args),
+                                  nu::MessageLoop::Priority::Normal,
+                                  std::move(task));
+  }
+  static void PostTaskWithPriority(Arguments* args,
+                                   nu::MessageLoop::Priority priority,
+                                   nu::MessageLoop::Task task) {
+    nu::MessageLoop::PostTaskFrom(GetPostingSite(args), priority,
+                                  std::move(task));
+  }
+  static void PostDelayedTask(Arguments* args, int ms,
+                              nu::MessageLoop::Task task) {
+    nu::MessageLoop::SetTimeoutFrom(GetPostingSite(args), ms, std::move(task));
+  }
+  static void PostUnthrottledDelayedTask(Arguments* args, int ms,
+                                         nu::MessageLoop::Task task) {
+    nu::MessageLoop::SetTimeoutFrom(GetPostingSite(args), ms, std::move(task),
+                                    false);
+  }
+  static void PostIdleTask(Arguments* args, nu::MessageLoop::IdleTask task) {
+    nu::MessageLoop::PostIdleTaskFrom(GetPostingSite(args), std::move(task));
+  }
+  static void SetWorkerTaskHandler(const std::string& channel,
+                                   WorkerTaskHandler handler) {
+    GetWorkerTaskHandlers()[channel] = std::move(handler);
+  }
+  static void RemoveWorkerTaskHandler(const std::string& channel) {
+    GetWorkerTaskHandlers().erase(channel);
+  }
+};
+
+template<>
+struct Type<nu::MessageLoopStats::LongTask> {
+  static constexpr const char* name = "MessageLoopLongTask";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::MessageLoopStats::LongTask& task) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "postedFrom", task.posted_from,
+        "queueDelay", static_cast<float>(task.queue_delay.InMillisecondsF()),
+        "runTime", static_cast<float>(task.run_time.InMillisecondsF()));
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::MessageLoopStats> {
+  static constexpr const char* name = "MessageLoopStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::MessageLoopStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "taskCount", stats.task_count,
+        "totalQueueDelay",
+        static_cast<float>(stats.total_queue_delay.InMillisecondsF()),
+        "maxQueueDelay",
+        static_cast<float>(stats.max_queue_delay.InMillisecondsF()),
+        "totalRunTime",
+        static_cast<float>(stats.total_run_time.InMillisecondsF()),
+        "maxRunTime", static_cast<float>(stats.max_run_time.InMillisecondsF()),
+        "longTasks", stats.long_tasks);
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::StartupStats::Phase> {
+  static constexpr const char* name = "StartupPhase";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::StartupStats::Phase& phase) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "name", phase.name,
+        "start", static_cast<float>(phase.start.InMillisecondsF()),
+        "duration", static_cast<float>(phase.duration.InMillisecondsF()));
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::StartupStats> {
+  static constexpr const char* name = "StartupStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::StartupStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj, "phases", stats.phases);
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::LayoutStats::MeasureStats> {
+  static constexpr const char* name = "LayoutMeasureStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::LayoutStats::MeasureStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "count", stats.count,
+        "duration", static_cast<float>(stats.duration.InMillisecondsF()));
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::LayoutStats> {
+  static constexpr const char* name = "LayoutStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::LayoutStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "layoutCount", stats.layout_count,
+        "totalDuration",
+        static_cast<float>(stats.total_duration.InMillisecondsF()),
+        "maxDuration", static_cast<float>(stats.max_duration.InMillisecondsF()),
+        "nodesVisited", stats.nodes_visited,
+        "measures", stats.measures);
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::MemoryReport::Entry> {
+  static constexpr const char* name = "MemoryReportEntry";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::MemoryReport::Entry& entry) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "count", entry.count,
+        "bytes", static_cast<double>(entry.bytes));
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::MemoryReport> {
+  static constexpr const char* name = "MemoryReport";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::MemoryReport& report) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "viewCount", report.view_count,
+        "views", report.views,
+        "yogaNodeCount", report.yoga_node_count,
+        "freeYogaNodeCount", report.free_yoga_node_count,
+        "recycledViewCount", report.recycled_view_count,
+        "images", report.images,
+        "fonts", report.fonts,
+        "attributedTexts", report.attributed_texts,
+        "canvases", report.canvases,
+        "tableModelCount", report.table_model_count,
+        "tableRows", static_cast<double>(report.table_rows),
+        "tableCells", static_cast<double>(report.table_cells),
+        "protocolCacheEntries", report.protocol_cache_entries,
+        "protocolCacheBytes",
+        static_cast<double>(report.protocol_cache_bytes));
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::PaintStats::Record> {
+  static constexpr const char* name = "PaintRecord";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::PaintStats::Record& record) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "windowTitle", record.window_title,
+        "startTime",
+        (record.start - base::TimeTicks()).InMillisecondsF(),
+        "duration", static_cast<float>(record.duration.InMillisecondsF()),
+        "dirtyArea", record.dirty_area,
+        "viewsDrawn", record.views_drawn,
+        "views", record.views,
+        "onDrawCount", record.on_draw_count,
+        "onDrawDuration",
+        static_cast<float>(record.on_draw_duration.InMillisecondsF()));
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::PaintStats> {
+  static constexpr const char* name = "PaintStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const nu::PaintStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "paintCount", stats.paint_count,
+        "totalDuration",
+        static_cast<float>(stats.total_duration.InMillisecondsF()),
+        "maxDuration", static_cast<float>(stats.max_duration.InMillisecondsF()),
+        "records", stats.records);
+    return obj;
+  }
+};
+
+template<>
+struct Type<vb::ObjectStats> {
+  static constexpr const char* name = "ObjectStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const vb::ObjectStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "count", stats.count,
+        "retainedByWrapper", stats.retained_by_wrapper);
+    return obj;
+  }
+};
+
+template<>
+struct Type<vb::CallStats> {
+  static constexpr const char* name = "CallStats";
+  static v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                   const vb::CallStats& stats) {
+    auto obj = v8::Object::New(context->GetIsolate());
+    Set(context, obj,
+        "calls", static_cast<double>(stats.calls),
+        "convertTime", stats.convert_time.InMillisecondsF(),
+        "nativeTime", stats.native_time.InMillisecondsF());
+    return obj;
+  }
+};
+
+template<>
+struct Type<nu::LayoutTransaction> {
+  static constexpr const char* name = "LayoutTransaction";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "begin", &nu::LayoutTransaction::Begin,
+        "commit", &nu::LayoutTransaction::Commit,
+        "isActive", &nu::LayoutTransaction::IsActive,
+        "setDeferredLayout", &nu::LayoutTransaction::SetDeferredLayout,
+        "isDeferredLayout", &nu::LayoutTransaction::IsDeferredLayout,
+        "flush", &nu::LayoutTransaction::Flush);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+  }
+};
+
+template<>
+struct Type<nu::AsyncLayout> {
+  static constexpr const char* name = "AsyncLayout";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "compute", &nu::AsyncLayout::Compute);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+  }
 };
 
 #if defined(OS_MACOSX)
@@ -357,6 +722,20 @@ struct Type<nu::App> {
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "prewarm", &nu::App::Prewarm,
+        "notifyMemoryPressure", &nu::App::NotifyMemoryPressure,
+        "isInBackground", &nu::App::IsInBackground,
+        "setBackgroundThrottlingEnabled",
+        &nu::App::SetBackgroundThrottlingEnabled,
+        "isBackgroundThrottlingEnabled",
+        &nu::App::IsBackgroundThrottlingEnabled,
+        "setBackgroundTimerInterval", &nu::App::SetBackgroundTimerInterval,
+        "getBackgroundTimerInterval", &nu::App::GetBackgroundTimerInterval);
+    SetProperty(context, templ,
+                "onMemoryPressure", &nu::App::on_memory_pressure,
+                "onEnterBackground", &nu::App::on_enter_background,
+                "onLeaveBackground", &nu::App::on_leave_background);
 #if defined(OS_MACOSX)
     Set(context, templ,
         "setApplicationMenu",
@@ -394,6 +773,8 @@ struct Type<nu::AttributedText> {
         "setColorFor", &nu::AttributedText::SetColorFor,
 #endif
         "clear", &nu::AttributedText::Clear,
+        "replaceText", &nu::AttributedText::ReplaceText,
+        "appendText", &nu::AttributedText::AppendText,
         "getBoundsFor", &nu::AttributedText::GetBoundsFor,
         "setFormat", &nu::AttributedText::SetFormat,
         "getFormat", &nu::AttributedText::GetFormat,
@@ -506,9 +887,10 @@ struct Type<nu::Font> {
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "create", &CreateOnHeap<nu::Font, const std::string&, float,
-                                nu::Font::Weight, nu::Font::Style>,
+        "create", &nu::Font::Get,
         "createFromPath", &CreateOnHeap<nu::Font, const base::FilePath&, float>,
+        "loadAsync", &nu::Font::LoadAsync,
+        "loadSetAsync", &nu::Font::LoadSetAsync,
         "default", &nu::Font::Default);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
@@ -518,7 +900,21 @@ struct Type<nu::Font> {
         "getName", &nu::Font::GetName,
         "getSize", &nu::Font::GetSize,
         "getWeight", &nu::Font::GetWeight,
-        "getStyle", &nu::Font::GetStyle);
+        "getStyle", &nu::Font::GetStyle,
+        "measureStrings", &nu::Font::MeasureStrings);
+  }
+};
+
+template<>
+struct Type<nu::Image::EncodeOptions> {
+  static constexpr const char* name = "ImageEncodeOptions";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::Image::EncodeOptions* out) {
+    if (!value->IsObject())
+      return true;
+    Get(context, value.As<v8::Object>(), "quality", &out->quality);
+    return true;
   }
 };
 
@@ -536,7 +932,127 @@ struct Type<nu::Canvas> {
     Set(context, templ,
         "getScaleFactor", &nu::Canvas::GetScaleFactor,
         "getPainter", &nu::Canvas::GetPainter,
-        "getSize", &nu::Canvas::GetSize);
+        "getSize", &nu::Canvas::GetSize,
+        "lockPixels", &LockPixels,
+        "unlockPixels", &UnlockPixels,
+        "encodeAsync", &nu::Canvas::EncodeAsync);
+  }
+  // The pixels are exposed as an external ArrayBuffer without copying.
+  static v8::Local<v8::Value> LockPixels(Arguments* args) {
+    nu::Canvas* canvas;
+    if (!args->GetHolder(&canvas))
+      return v8::Undefined(args->isolate());
+    v8::Local<v8::Context> context = args->GetContext();
+    // Locking again invalidates the buffer returned by last lock.
+    if (DetachPixels(context, args->This()))
+      canvas->UnlockPixels();
+    nu::CanvasPixels pixels = canvas->LockPixels();
+    // The backing store keeps the canvas alive, so the memory is never freed
+    // while the buffer is still referenced by JavaScript. The deleter may be
+    // called in any thread, while the canvas can only be released in the
+    // main thread.
+    auto* ref = new scoped_refptr<nu::Canvas>(canvas);
+    std::unique_ptr<v8::BackingStore> store = v8::ArrayBuffer::NewBackingStore(
+        pixels.buffer.content(), pixels.buffer.size(),
+        [](void*, size_t, void* ref) {
+          nu::MessageLoop::PostTask([ref]() {
+            delete static_cast<scoped_refptr<nu::Canvas>*>(ref);
+          });
+        }, ref);
+    v8::Local<v8::ArrayBuffer> data =
+        v8::ArrayBuffer::New(args->isolate(), std::move(store));
+    // Remember the buffer so it can be detached when unlocking.
+    v8::Local<v8::Map> refs = vb::GetAttachedTable(
+        context, args->This(), "pixels");
+    ignore_result(refs->Set(context, ToV8(context, "data"), data));
+    auto obj = v8::Object::New(args->isolate());
+    Set(context, obj,
+        "data", data,
+        "width", pixels.size.width(),
+        "height", pixels.size.height(),
+        "stride", pixels.stride);
+    return obj;
+  }
+  static void UnlockPixels(Arguments* args) {
+    nu::Canvas* canvas;
+    if (!args->GetHolder(&canvas))
+      return;
+    if (DetachPixels(args->GetContext(), args->This()))
+      canvas->UnlockPixels();
+  }
+  // Make the locked memory no longer accessible from JavaScript, returns
+  // false if the pixels are not locked.
+  static bool DetachPixels(v8::Local<v8::Context> context,
+                           v8::Local<v8::Object> self) {
+    v8::Local<v8::Map> refs = vb::GetAttachedTable(context, self, "pixels");
+    v8::Local<v8::Value> key = ToV8(context, "data");
+    v8::Local<v8::Value> data;
+    if (!refs->Get(context, key).ToLocal(&data) || !data->IsArrayBuffer())
+      return false;
+    data.As<v8::ArrayBuffer>()->Detach();
+    ignore_result(refs->Delete(context, key));
+    return true;
+  }
+};
+
+template<>
+struct Type<nu::DisplayList> {
+  static constexpr const char* name = "DisplayList";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::DisplayList>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "getPainter", &nu::DisplayList::GetPainter,
+        "replay", &nu::DisplayList::Replay,
+        "clear", &nu::DisplayList::Clear,
+        "getOpCount", &nu::DisplayList::GetOpCount,
+        "isEmpty", &nu::DisplayList::IsEmpty);
+  }
+};
+
+template<>
+struct Type<nu::Path> {
+  static constexpr const char* name = "Path";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::Path>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "moveTo", &nu::Path::MoveTo,
+        "lineTo", &nu::Path::LineTo,
+        "bezierCurveTo", &nu::Path::BezierCurveTo,
+        "arc", &nu::Path::Arc,
+        "rect", &nu::Path::Rect,
+        "closePath", &nu::Path::ClosePath,
+        "clear", &nu::Path::Clear,
+        "isEmpty", &nu::Path::IsEmpty);
+  }
+};
+
+template<>
+struct Type<nu::MonospaceTextRenderer> {
+  static constexpr const char* name = "MonospaceTextRenderer";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::MonospaceTextRenderer,
+                                nu::Font*, nu::Color, float>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "drawText", &nu::MonospaceTextRenderer::DrawText,
+        "measureText", &nu::MonospaceTextRenderer::MeasureText,
+        "getCellSize", &nu::MonospaceTextRenderer::GetCellSize,
+        "getGlyphCount", &nu::MonospaceTextRenderer::GetGlyphCount,
+        "getFont", &nu::MonospaceTextRenderer::GetFont,
+        "getColor", &nu::MonospaceTextRenderer::GetColor,
+        "getScaleFactor", &nu::MonospaceTextRenderer::GetScaleFactor);
   }
 };
 
@@ -696,11 +1212,26 @@ struct Type<nu::Clipboard> {
         "isDataAvailable", &nu::Clipboard::IsDataAvailable,
         "getData", &nu::Clipboard::GetData,
         "setData", &nu::Clipboard::SetData,
+        "setDataProvider", &nu::Clipboard::SetDataProvider,
+        "getDataSize", &GetDataSize,
+        "readData", &ReadData,
         "startWatching", &nu::Clipboard::StartWatching,
         "stopWatching", &nu::Clipboard::StopWatching);
     SetProperty(context, templ,
                 "onChange", &nu::Clipboard::on_change);
   }
+  static double GetDataSize(nu::Clipboard* clipboard,
+                            nu::Clipboard::Data::Type type) {
+    return static_cast<double>(clipboard->GetDataSize(type));
+  }
+  static bool ReadData(nu::Clipboard* clipboard,
+                       nu::Clipboard::Data::Type type,
+                       const std::function<bool(const nu::Buffer&)>& reader) {
+    // The chunk is only valid during the call.
+    return clipboard->ReadData(type, [&reader](const char* chunk, size_t size) {
+      return reader(nu::Buffer::Wrap(chunk, size));
+    });
+  }
 };
 
 template<>
@@ -737,11 +1268,17 @@ struct Type<nu::Color> {
       *out = nu::Color(value->Uint32Value(context).ToChecked());
       return true;
     }
+    // Values packed with bitwise operators are signed.
+    if (value->IsInt32()) {
+      *out = nu::Color(
+          static_cast<uint32_t>(value->Int32Value(context).ToChecked()));
+      return true;
+    }
     // String representation.
     std::string hex;
     if (!vb::FromV8(context, value, &hex))
       return false;
-    *out = nu::Color(hex);
+    *out = nu::Color::FromHexCached(hex);
     return true;
   }
   static void BuildConstructor(v8::Local<v8::Context> context,
@@ -814,7 +1351,7 @@ struct Type<nu::Cursor> {
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "createWithType", &CreateOnHeap<nu::Cursor, nu::Cursor::Type>);
+        "createWithType", &nu::Cursor::CreateWithType);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
@@ -837,8 +1374,22 @@ struct Type<nu::DraggingInfo> {
     Set(context, templ,
         "isDataAvailable", &nu::DraggingInfo::IsDataAvailable,
         "getData", &nu::DraggingInfo::GetData,
+        "getDataSize", &GetDataSize,
+        "readData", &ReadData,
         "getDragOperations", &nu::DraggingInfo::GetDragOperations);
   }
+  static double GetDataSize(nu::DraggingInfo* info,
+                            nu::Clipboard::Data::Type type) {
+    return static_cast<double>(info->GetDataSize(type));
+  }
+  static bool ReadData(nu::DraggingInfo* info,
+                       nu::Clipboard::Data::Type type,
+                       const std::function<bool(const nu::Buffer&)>& reader) {
+    // The chunk is only valid during the call.
+    return info->ReadData(type, [&reader](const char* chunk, size_t size) {
+      return reader(nu::Buffer::Wrap(chunk, size));
+    });
+  }
 };
 
 template<>
@@ -857,6 +1408,21 @@ struct Type<nu::DragOptions> {
   }
 };
 
+template<>
+struct Type<nu::Image::DecodeOptions> {
+  static constexpr const char* name = "ImageDecodeOptions";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::Image::DecodeOptions* out) {
+    if (!value->IsObject())
+      return true;
+    Get(context, value.As<v8::Object>(),
+        "size", &out->size,
+        "scaleFactor", &out->scale_factor);
+    return true;
+  }
+};
+
 template<>
 struct Type<nu::Image> {
   static constexpr const char* name = "Image";
@@ -865,14 +1431,57 @@ struct Type<nu::Image> {
     Set(context, constructor,
         "createEmpty", &CreateOnHeap<nu::Image>,
         "createFromPath", &CreateOnHeap<nu::Image, const base::FilePath&>,
-        "createFromBuffer", &CreateOnHeap<nu::Image, const nu::Buffer&, float>);
+        "createFromBuffer", &CreateOnHeap<nu::Image, const nu::Buffer&, float>,
+        "decodeFromPathAsync", &DecodeFromPathAsync,
+        "decodeFromBufferAsync", &DecodeFromBufferAsync);
+  }
+  static void DecodeFromPathAsync(const base::FilePath& path,
+                                  const nu::Image::DecodeOptions& options,
+                                  nu::Image::DecodeCallback callback) {
+    nu::Image::DecodeAsync(path, options, std::move(callback));
+  }
+  static void DecodeFromBufferAsync(const nu::Buffer& buffer,
+                                    const nu::Image::DecodeOptions& options,
+                                    nu::Image::DecodeCallback callback) {
+    nu::Image::DecodeAsync(buffer, options, std::move(callback));
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
         "isEmpty", &nu::Image::IsEmpty,
         "getSize", &nu::Image::GetSize,
-        "getScaleFactor", &nu::Image::GetScaleFactor);
+        "getScaleFactor", &nu::Image::GetScaleFactor,
+        "createResized", &nu::Image::CreateResized,
+        "setMipmapEnabled", &nu::Image::SetMipmapEnabled,
+        "isMipmapEnabled", &nu::Image::IsMipmapEnabled,
+        "encodeAsync", &nu::Image::EncodeAsync);
+  }
+};
+
+template<>
+struct Type<nu::ImageCache> {
+  static constexpr const char* name = "ImageCache";
+  static void BuildConstructor(v8::Local<v8::Context>, v8::Local<v8::Object>) {
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "get", &nu::ImageCache::Get,
+        "getAsync", &nu::ImageCache::GetAsync,
+        "setBudget", &SetBudget,
+        "getBudget", &GetBudget,
+        "getUsage", &GetUsage,
+        "onMemoryPressure", &nu::ImageCache::OnMemoryPressure,
+        "clear", &nu::ImageCache::Clear);
+  }
+  static void SetBudget(nu::ImageCache* cache, double bytes) {
+    cache->SetBudget(static_cast<size_t>(std::max(0., bytes)));
+  }
+  static double GetBudget(nu::ImageCache* cache) {
+    return static_cast<double>(cache->GetBudget());
+  }
+  static double GetUsage(nu::ImageCache* cache) {
+    return static_cast<double>(cache->GetUsage());
   }
 };
 
@@ -960,26 +1569,28 @@ struct Type<nu::Painter> {
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
-        "save", &nu::Painter::Save,
-        "restore", &nu::Painter::Restore,
-        "beginPath", &nu::Painter::BeginPath,
-        "closePath", &nu::Painter::ClosePath,
+        "save", VB_FAST_METHOD(&nu::Painter::Save),
+        "restore", VB_FAST_METHOD(&nu::Painter::Restore),
+        "beginPath", VB_FAST_METHOD(&nu::Painter::BeginPath),
+        "closePath", VB_FAST_METHOD(&nu::Painter::ClosePath),
         "moveTo", &nu::Painter::MoveTo,
         "lineTo", &nu::Painter::LineTo,
         "bezierCurveTo", &nu::Painter::BezierCurveTo,
         "arc", &nu::Painter::Arc,
         "rect", &nu::Painter::Rect,
-        "clip", &nu::Painter::Clip,
+        "clip", VB_FAST_METHOD(&nu::Painter::Clip),
         "clipRect", &nu::Painter::ClipRect,
         "translate", &nu::Painter::Translate,
-        "rotate", &nu::Painter::Rotate,
+        "rotate", VB_FAST_METHOD(&nu::Painter::Rotate),
         "scale", &nu::Painter::Scale,
         "setColor", &nu::Painter::SetColor,
         "setStrokeColor", &nu::Painter::SetStrokeColor,
         "setFillColor", &nu::Painter::SetFillColor,
-        "setLineWidth", &nu::Painter::SetLineWidth,
-        "stroke", &nu::Painter::Stroke,
-        "fill", &nu::Painter::Fill,
+        "setLineWidth", VB_FAST_METHOD(&nu::Painter::SetLineWidth),
+        "stroke", VB_FAST_METHOD(&nu::Painter::Stroke),
+        "fill", VB_FAST_METHOD(&nu::Painter::Fill),
+        "strokePath", &nu::Painter::StrokePath,
+        "fillPath", &nu::Painter::FillPath,
         "clear", &nu::Painter::Clear,
         "strokeRect", &nu::Painter::StrokeRect,
         "fillRect", &nu::Painter::FillRect,
@@ -988,7 +1599,20 @@ struct Type<nu::Painter> {
         "drawCanvas", &nu::Painter::DrawCanvas,
         "drawCanvasFromRect", &nu::Painter::DrawCanvasFromRect,
         "drawAttributedText", &nu::Painter::DrawAttributedText,
-        "drawText", &nu::Painter::DrawText);
+        "drawText", &nu::Painter::DrawText,
+        "execute", &Execute);
+  }
+  // Read the commands directly from the memory of Float32Array.
+  static bool Execute(nu::Painter* painter,
+                      Arguments* args,
+                      v8::Local<v8::Value> value) {
+    if (!value->IsFloat32Array()) {
+      args->ThrowError("Float32Array");
+      return false;
+    }
+    const float* data = reinterpret_cast<const float*>(
+        node::Buffer::Data(value));
+    return painter->Execute(data, node::Buffer::Length(value) / sizeof(float));
   }
 };
 
@@ -1059,7 +1683,8 @@ struct Type<nu::MouseEvent> {
     Set(context, obj,
         "button", event.button,
         "positionInView", event.position_in_view,
-        "positionInWindow", event.position_in_window);
+        "positionInWindow", event.position_in_window,
+        "coalescedPositions", event.coalesced_positions);
     return obj;
   }
 };
@@ -1128,12 +1753,15 @@ struct Type<nu::FileDialog> {
         "getResult", &nu::FileDialog::GetResult,
         "run", &nu::FileDialog::Run,
         "runForWindow", &nu::FileDialog::RunForWindow,
+        "show", &nu::FileDialog::Show,
+        "showForWindow", &nu::FileDialog::ShowForWindow,
         "setTitle", &nu::FileDialog::SetTitle,
         "setButtonLabel", &nu::FileDialog::SetButtonLabel,
         "setFilename", &nu::FileDialog::SetFilename,
         "setFolder", &nu::FileDialog::SetFolder,
         "setOptions", &nu::FileDialog::SetOptions,
         "setFilters", &nu::FileDialog::SetFilters);
+    SetProperty(context, templ, "onResponse", &nu::FileDialog::on_response);
   }
 };
 
@@ -1177,8 +1805,14 @@ struct Type<nu::MenuBase> {
         "append", RefMethod(&nu::MenuBase::Append, RefType::Ref),
         "insert", RefMethod(&nu::MenuBase::Insert, RefType::Ref),
         "remove", RefMethod(&nu::MenuBase::Remove, RefType::Deref),
+        "appendTemplate", &AppendTemplate,
         "itemCount", &nu::MenuBase::ItemCount,
         "itemAt", &nu::MenuBase::ItemAt);
+    SetProperty(context, templ,
+                "onItemClick", &nu::MenuBase::on_item_click);
+  }
+  static void AppendTemplate(nu::MenuBase* menu, ::base::Value items) {
+    menu->AppendTemplate(items);
   }
 };
 
@@ -1192,11 +1826,18 @@ struct Type<nu::MenuBar> {
   static constexpr const char* name = "MenuBar";
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
-    Set(context, constructor, "create", &Create);
+    Set(context, constructor,
+        "create", &Create,
+        "createFromTemplate", &CreateFromTemplate);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
   }
+  static nu::MenuBar* CreateFromTemplate(::base::Value items) {
+    nu::MenuBar* menu = new nu::MenuBar;
+    menu->AppendTemplate(items);
+    return menu;
+  }
   static nu::MenuBar* CreateRaw(v8::Local<v8::Context> context,
                                 v8::Local<v8::Array> options) {
     nu::MenuBar* menu = new nu::MenuBar;
@@ -1221,13 +1862,20 @@ struct Type<nu::Menu> {
   static constexpr const char* name = "Menu";
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
-    Set(context, constructor, "create", &Create);
+    Set(context, constructor,
+        "create", &Create,
+        "createFromTemplate", &CreateFromTemplate);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
         "popup", &nu::Menu::Popup);
   }
+  static nu::Menu* CreateFromTemplate(::base::Value items) {
+    nu::Menu* menu = new nu::Menu;
+    menu->AppendTemplate(items);
+    return menu;
+  }
   static nu::Menu* CreateRaw(v8::Local<v8::Context> context,
                              v8::Local<v8::Array> options) {
     nu::Menu* menu = new nu::Menu;
@@ -1335,7 +1983,9 @@ struct Type<nu::MenuItem> {
         "isVisible", &nu::MenuItem::IsVisible,
         "setSubmenu", &nu::MenuItem::SetSubmenu,
         "getSubmenu", &nu::MenuItem::GetSubmenu,
-        "setAccelerator", &nu::MenuItem::SetAccelerator);
+        "setAccelerator", &nu::MenuItem::SetAccelerator,
+        "setId", &nu::MenuItem::SetId,
+        "getId", &nu::MenuItem::GetId);
     SetProperty(context, templ,
                 "onClick", &nu::MenuItem::on_click);
   }
@@ -1449,9 +2099,7 @@ struct Type<nu::MessageBox> {
     Set(context, templ,
         "run", &nu::MessageBox::Run,
         "runForWindow", &nu::MessageBox::RunForWindow,
-#if defined(OS_LINUX) || defined(OS_WIN)
         "show", &nu::MessageBox::Show,
-#endif
         "showForWindow", &nu::MessageBox::ShowForWindow,
         "close", &nu::MessageBox::Close,
         "setType", &nu::MessageBox::SetType,
@@ -1496,6 +2144,7 @@ struct Type<nu::Tray> {
         "setTitle", &nu::Tray::SetTitle,
 #endif
         "setImage", &nu::Tray::SetImage,
+        "setImageFromCanvas", &nu::Tray::SetImageFromCanvas,
 #if defined(OS_MAC)
         "setPressedImage", &nu::Tray::SetPressedImage,
 #endif
@@ -1593,6 +2242,9 @@ struct Type<nu::Window::Options> {
     Get(context, obj, "transparent", &out->transparent);
 #if defined(OS_MACOSX)
     Get(context, obj, "showTrafficLights", &out->show_traffic_lights);
+#elif defined(OS_WIN)
+    Get(context, obj, "direct2d", &out->direct2d);
+    Get(context, obj, "directComposition", &out->direct_composition);
 #endif
     return true;
   }
@@ -1616,6 +2268,7 @@ struct Type<nu::Window> {
         "setContentView",
         RefMethod(&nu::Window::SetContentView, RefType::Reset, "contentView"),
         "getContentView", &nu::Window::GetContentView,
+        "prepareContentView", &nu::Window::PrepareContentView,
         "setContentSize", &nu::Window::SetContentSize,
         "getContentSize", &nu::Window::GetContentSize,
         "setBounds", &nu::Window::SetBounds,
@@ -1639,6 +2292,7 @@ struct Type<nu::Window> {
         "minimize", &nu::Window::Minimize,
         "restore", &nu::Window::Restore,
         "isMinimized", &nu::Window::IsMinimized,
+        "isOccluded", &nu::Window::IsOccluded,
         "setResizable", &nu::Window::SetResizable,
         "isResizable", &nu::Window::IsResizable,
         "setMaximizable", &nu::Window::SetMaximizable,
@@ -1668,7 +2322,17 @@ struct Type<nu::Window> {
         RefMethod(&nu::Window::AddChildWindow, RefType::Ref),
         "removeChildView",
         RefMethod(&nu::Window::RemoveChildWindow, RefType::Deref),
-        "getChildWindows", &nu::Window::GetChildWindows);
+        "getChildWindows", &nu::Window::GetChildWindows,
+        "requestFrame", &nu::Window::RequestFrame,
+        "cancelFrame", &nu::Window::CancelFrame,
+        "setLiveResizeThrottled", &nu::Window::SetLiveResizeThrottled,
+        "isLiveResizeThrottled", &nu::Window::IsLiveResizeThrottled,
+        "setLiveResizeApproximated", &nu::Window::SetLiveResizeApproximated,
+        "isLiveResizeApproximated", &nu::Window::IsLiveResizeApproximated,
+        "isInLiveResize", &nu::Window::IsInLiveResize,
+        "setLayoutDeferredUntilShown",
+        &nu::Window::SetLayoutDeferredUntilShown,
+        "isLayoutDeferredUntilShown", &nu::Window::IsLayoutDeferredUntilShown);
     SetProperty(context, templ,
                 "onClose", &nu::Window::on_close,
                 "onFocus", &nu::Window::on_focus,
@@ -1678,23 +2342,51 @@ struct Type<nu::Window> {
 };
 
 template<>
-struct Type<nu::View> {
-  static constexpr const char* name = "View";
+struct Type<nu::StyleSheet> {
+  static constexpr const char* name = "StyleSheet";
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &Create);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
-    Set(context, templ,
-        "offsetFromView", &nu::View::OffsetFromView,
-        "offsetFromWindow", &nu::View::OffsetFromWindow,
-        "setBounds", &nu::View::SetBounds,
+  }
+  static nu::StyleSheet* Create(
+      v8::Local<v8::Context> context,
+      const std::map<std::string, v8::Local<v8::Value>>& styles) {
+    nu::StyleSheet* sheet = new nu::StyleSheet;
+    for (const auto& it : styles) {
+      if (it.second->IsNumber())
+        sheet->SetProperty(
+            it.first, it.second->NumberValue(context).ToChecked());
+      else
+        sheet->SetProperty(
+            it.first,
+            *v8::String::Utf8Value(context->GetIsolate(), it.second));
+    }
+    return sheet;
+  }
+};
+
+template<>
+struct Type<nu::View> {
+  static constexpr const char* name = "View";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "offsetFromView", &nu::View::OffsetFromView,
+        "offsetFromWindow", &nu::View::OffsetFromWindow,
+        "setBounds", &nu::View::SetBounds,
         "getBounds", &nu::View::GetBounds,
         "layout", &nu::View::Layout,
         "schedulePaint", &nu::View::SchedulePaint,
         "schedulePaintRect", &nu::View::SchedulePaintRect,
         "setVisible", &nu::View::SetVisible,
         "isVisible", &nu::View::IsVisible,
+        "isOnScreen", &nu::View::IsOnScreen,
         "setEnabled", &nu::View::SetEnabled,
         "isEnabled", &nu::View::IsEnabled,
         "focus", &nu::View::Focus,
@@ -1706,6 +2398,8 @@ struct Type<nu::View> {
         "hasCapture", &nu::View::HasCapture,
         "setMouseDownCanMoveWindow", &nu::View::SetMouseDownCanMoveWindow,
         "isMouseDownCanMoveWindow", &nu::View::IsMouseDownCanMoveWindow,
+        "setCoalesceMouseMove", &nu::View::SetCoalesceMouseMove,
+        "isCoalesceMouseMove", &nu::View::IsCoalesceMouseMove,
         "doDrag", &nu::View::DoDrag,
         "doDragWithOptions", &nu::View::DoDragWithOptions,
         "cancelDrag", &nu::View::CancelDrag,
@@ -1716,11 +2410,18 @@ struct Type<nu::View> {
         "setColor", &nu::View::SetColor,
         "setBackgroundColor", &nu::View::SetBackgroundColor,
         "setStyle", &SetStyle,
+        "set", &SetProperties,
+        "applyStyle", &nu::View::ApplyStyle,
         "getComputedLayout", &nu::View::GetComputedLayout,
         "getMinimumSize", &nu::View::GetMinimumSize,
+        "renderToCanvas", &nu::View::RenderToCanvas,
+        "setLayerBacked", &nu::View::SetLayerBacked,
+        "isLayerBacked", &nu::View::IsLayerBacked,
 #if defined(OS_MACOSX)
         "setWantsLayer", &nu::View::SetWantsLayer,
         "wantsLayer", &nu::View::WantsLayer,
+        "setDrawsAsynchronously", &nu::View::SetDrawsAsynchronously,
+        "drawsAsynchronously", &nu::View::DrawsAsynchronously,
 #endif
         "getParent", &nu::View::GetParent,
         "getWindow", &nu::View::GetWindow);
@@ -1756,6 +2457,52 @@ struct Type<nu::View> {
     }
     view->Layout();
   }
+  // Call the setter of each property in the object, for example "text" calls
+  // "setText", and only do layout once for all of them.
+  static void SetProperties(Arguments* args,
+                            v8::Local<v8::Context> context,
+                            v8::Local<v8::Object> properties) {
+    v8::Local<v8::Object> self = args->This();
+    v8::Local<v8::Array> keys;
+    if (!properties->GetOwnPropertyNames(context).ToLocal(&keys))
+      return;
+    nu::LayoutTransaction transaction;
+    for (uint32_t i = 0; i < keys->Length(); ++i) {
+      v8::Local<v8::Value> key;
+      std::string name;
+      if (!keys->Get(context, i).ToLocal(&key) ||
+          !vb::FromV8(context, key, &name) || name.empty())
+        continue;
+      name[0] = base::ToUpperASCII(name[0]);
+      v8::Local<v8::Value> setter;
+      if (!self->Get(context, vb::ToV8(context, "set" + name))
+               .ToLocal(&setter))
+        return;
+      if (!setter->IsFunction()) {
+        vb::ThrowTypeError(context, "Unknown property " + name);
+        return;
+      }
+      v8::Local<v8::Value> value;
+      if (!properties->Get(context, key).ToLocal(&value) ||
+          setter.As<v8::Function>()->Call(context, self, 1, &value).IsEmpty())
+        return;
+    }
+  }
+};
+
+template<>
+struct Type<nu::ViewTemplate> {
+  static constexpr const char* name = "ViewTemplate";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &nu::ViewTemplate::Create);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "instantiate", &nu::ViewTemplate::Instantiate,
+        "getViewCount", &nu::ViewTemplate::GetViewCount);
+  }
 };
 
 template<>
@@ -1772,7 +2519,8 @@ struct Type<nu::ComboBox> {
         "setText", &nu::ComboBox::SetText,
         "getText", &nu::ComboBox::GetText);
     SetProperty(context, templ,
-                "onTextChange", &nu::ComboBox::on_text_change);
+                "onTextChange", &nu::ComboBox::on_text_change,
+                "getItemsForText", &nu::ComboBox::get_items_for_text);
   }
 };
 
@@ -1783,7 +2531,7 @@ struct Type<nu::Container> {
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "create", &CreateOnHeap<nu::Container>);
+        "create", &Create);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
@@ -1800,10 +2548,25 @@ struct Type<nu::Container> {
         "removeChildView",
         RefMethod(&nu::Container::RemoveChildView, RefType::Deref),
         "childCount", &nu::Container::ChildCount,
-        "childAt", &nu::Container::ChildAt);
+        "childAt", &nu::Container::ChildAt,
+#if defined(OS_MACOSX)
+        "setTrackChildrenHover", &nu::Container::SetTrackChildrenHover,
+        "isTrackChildrenHover", &nu::Container::IsTrackChildrenHover,
+#endif
+        "setDisplayList", &nu::Container::SetDisplayList,
+        "getDisplayList", &nu::Container::GetDisplayList,
+        "setThreadedRendering", &nu::Container::SetThreadedRendering,
+        "isThreadedRendering", &nu::Container::IsThreadedRendering);
     SetProperty(context, templ,
                 "onDraw", &nu::Container::on_draw);
   }
+  static scoped_refptr<nu::Container> Create() {
+    scoped_refptr<nu::View> view =
+        nu::State::GetCurrent()->ReuseView(nu::Container::kClassName);
+    if (view)
+      return static_cast<nu::Container*>(view.get());
+    return new nu::Container;
+  }
 };
 
 template<>
@@ -1944,6 +2707,9 @@ struct Type<nu::ProtocolJob> {
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setCacheControl", &nu::ProtocolJob::SetCacheControl,
+        "getCacheControl", &nu::ProtocolJob::GetCacheControl);
   }
 };
 
@@ -1996,6 +2762,7 @@ struct Type<nu::ProtocolAsarJob> {
   }
 };
 
+#if defined(BROWSER_SUPPORT)
 template<>
 struct Type<nu::Browser::Options> {
   static constexpr const char* name = "BrowserOptions";
@@ -2021,6 +2788,21 @@ struct Type<nu::Browser::Options> {
   }
 };
 
+template<>
+struct Type<nu::BrowserReply> {
+  static constexpr const char* name = "BrowserReply";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "resolve", &nu::BrowserReply::Resolve,
+        "reject", &nu::BrowserReply::Reject,
+        "isDone", &nu::BrowserReply::IsDone);
+  }
+};
+
 template<>
 struct Type<nu::Browser> {
   using base = nu::View;
@@ -2029,8 +2811,14 @@ struct Type<nu::Browser> {
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
         "create", &CreateOnHeap<nu::Browser, nu::Browser::Options>,
+        "prewarm", &nu::Browser::Prewarm,
+        "acquire", &nu::Browser::Acquire,
         "registerProtocol", &nu::Browser::RegisterProtocol,
-        "unregisterProtocol", &nu::Browser::UnregisterProtocol);
+        "unregisterProtocol", &nu::Browser::UnregisterProtocol,
+        "setProtocolCacheBudget", &SetProtocolCacheBudget,
+        "getProtocolCacheBudget", &GetProtocolCacheBudget,
+        "getProtocolCacheUsage", &GetProtocolCacheUsage,
+        "clearProtocolCache", &nu::Browser::ClearProtocolCache);
   }
   static void BuildPrototype(v8::Local<v8::Context> context,
                              v8::Local<v8::ObjectTemplate> templ) {
@@ -2041,6 +2829,7 @@ struct Type<nu::Browser> {
         "getTitle", &nu::Browser::GetTitle,
         "setUserAgent", &nu::Browser::SetUserAgent,
         "executeJavaScript", &nu::Browser::ExecuteJavaScript,
+        "executeJavaScriptRaw", &nu::Browser::ExecuteJavaScriptRaw,
         "goBack", &nu::Browser::GoBack,
         "canGoBack", &nu::Browser::CanGoBack,
         "goForward", &nu::Browser::GoForward,
@@ -2051,7 +2840,17 @@ struct Type<nu::Browser> {
         "setBindingName", &nu::Browser::SetBindingName,
         "addBinding", &AddBinding,
         "addRawBinding", &AddRawBinding,
-        "removeBinding", &RemoveBinding);
+        "addBufferBinding", &AddBufferBinding,
+        "addAsyncBinding", &AddAsyncBinding,
+        "removeBinding", &RemoveBinding,
+        "createBufferURL", &CreateBufferURL,
+        "revokeBufferURL", &nu::Browser::RevokeBufferURL,
+        "pushMessage",
+        static_cast<void(nu::Browser::*)(const base::Value&)>(
+            &nu::Browser::PushMessage),
+        "pushBuffer",
+        static_cast<void(nu::Browser::*)(const nu::Buffer&)>(
+            &nu::Browser::PushMessage));
     SetProperty(context, templ,
                 "onClose", &nu::Browser::on_close,
                 "onUpdateCommand", &nu::Browser::on_update_command,
@@ -2062,6 +2861,27 @@ struct Type<nu::Browser> {
                 "onFinishNavigation", &nu::Browser::on_finish_navigation,
                 "onFailNavigation", &nu::Browser::on_fail_navigation);
   }
+  static void SetProtocolCacheBudget(double bytes) {
+    nu::Browser::SetProtocolCacheBudget(
+        static_cast<size_t>(std::max(0., bytes)));
+  }
+  static double GetProtocolCacheBudget() {
+    return static_cast<double>(nu::Browser::GetProtocolCacheBudget());
+  }
+  static double GetProtocolCacheUsage() {
+    return static_cast<double>(nu::Browser::GetProtocolCacheUsage());
+  }
+  static std::string CreateBufferURL(nu::Browser* browser,
+                                     const nu::Buffer& buffer,
+                                     const std::string& mime_type) {
+    // The converted buffer does not own its memory, so keep a copy.
+    std::string* copy = new std::string(static_cast<char*>(buffer.content()),
+                                        buffer.size());
+    return browser->CreateBufferURL(
+        nu::Buffer::TakeOver(&(*copy)[0], copy->size(),
+                             [copy](void*) { delete copy; }),
+        mime_type);
+  }
   static void AddBinding(Arguments* args,
                          const std::string& name,
                          v8::Local<v8::Function> func) {
@@ -2112,6 +2932,38 @@ struct Type<nu::Browser> {
     WeakFunctionFromV8(context, func, &callback);
     browser->AddRawBinding(name, callback);
   }
+  static void AddBufferBinding(Arguments* args,
+                               const std::string& name,
+                               v8::Local<v8::Function> func) {
+    nu::Browser* browser;
+    if (!args->GetHolder(&browser))
+      return;
+    // this[bindings][name] = func
+    v8::Local<v8::Context> context = args->GetContext();
+    v8::Local<v8::Map> refs = vb::GetAttachedTable(
+        context, args->This(), "bindings");
+    ignore_result(refs->Set(context, ToV8(context, name), func));
+    // The func must be stored as weak reference.
+    nu::Browser::BufferBindingFunc callback;
+    WeakFunctionFromV8(context, func, &callback);
+    browser->AddBufferBinding(name, callback);
+  }
+  static void AddAsyncBinding(Arguments* args,
+                              const std::string& name,
+                              v8::Local<v8::Function> func) {
+    nu::Browser* browser;
+    if (!args->GetHolder(&browser))
+      return;
+    // this[bindings][name] = func
+    v8::Local<v8::Context> context = args->GetContext();
+    v8::Local<v8::Map> refs = vb::GetAttachedTable(
+        context, args->This(), "bindings");
+    ignore_result(refs->Set(context, ToV8(context, name), func));
+    // The func must be stored as weak reference.
+    nu::Browser::AsyncBindingFunc callback;
+    WeakFunctionFromV8(context, func, &callback);
+    browser->AddAsyncBinding(name, callback);
+  }
   static void RemoveBinding(Arguments* args, const std::string& name) {
     nu::Browser* browser;
     if (!args->GetHolder(&browser))
@@ -2126,6 +2978,8 @@ struct Type<nu::Browser> {
   }
 };
 
+#endif
+
 template<>
 struct Type<nu::Entry::Type> {
   static constexpr const char* name = "EntryType";
@@ -2159,10 +3013,18 @@ struct Type<nu::Entry> {
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
         "setText", &nu::Entry::SetText,
-        "getText", &nu::Entry::GetText);
+        "getText", &nu::Entry::GetText,
+        "setTextChangeDebounce", &nu::Entry::SetTextChangeDebounce,
+        "getTextChangeDebounce", &nu::Entry::GetTextChangeDebounce,
+        "setTextChangeThrottle", &nu::Entry::SetTextChangeThrottle,
+        "getTextChangeThrottle", &nu::Entry::GetTextChangeThrottle,
+        "setIgnoreComposition", &nu::Entry::SetIgnoreComposition,
+        "isIgnoringComposition", &nu::Entry::IsIgnoringComposition,
+        "isComposing", &nu::Entry::IsComposing);
     SetProperty(context, templ,
                 "onActivate", &nu::Entry::on_activate,
-                "onTextChange", &nu::Entry::on_text_change);
+                "onTextChange", &nu::Entry::on_text_change,
+                "onTextRangeChange", &nu::Entry::on_text_range_change);
   }
 };
 
@@ -2173,7 +3035,7 @@ struct Type<nu::Label> {
   static void BuildConstructor(v8::Local<v8::Context> context,
                                v8::Local<v8::Object> constructor) {
     Set(context, constructor,
-        "create", &CreateOnHeap<nu::Label, const std::string&>,
+        "create", &Create,
         "createWithAttributedText",
          &CreateOnHeap<nu::Label, nu::AttributedText*>);
   }
@@ -2188,6 +3050,15 @@ struct Type<nu::Label> {
         RefMethod(&nu::Label::SetAttributedText, RefType::Reset, "atext"),
         "getAttributedText", &nu::Label::GetAttributedText);
   }
+  static scoped_refptr<nu::Label> Create(const std::string& text) {
+    scoped_refptr<nu::View> view =
+        nu::State::GetCurrent()->ReuseView(nu::Label::kClassName);
+    if (!view)
+      return new nu::Label(text);
+    auto* label = static_cast<nu::Label*>(view.get());
+    label->SetText(text);
+    return label;
+  }
 };
 
 template<>
@@ -2220,6 +3091,7 @@ struct Type<nu::Picker> {
                              v8::Local<v8::ObjectTemplate> templ) {
     Set(context, templ,
         "addItem", &nu::Picker::AddItem,
+        "setItems", &nu::Picker::SetItems,
         "removeItemAt", &nu::Picker::RemoveItemAt,
         "getItems", &nu::Picker::GetItems,
         "selectItemAt", &nu::Picker::SelectItemAt,
@@ -2345,8 +3217,44 @@ struct Type<nu::Scroll> {
         "setOverlayScrollbar", &nu::Scroll::SetOverlayScrollbar,
         "isOverlayScrollbar", &nu::Scroll::IsOverlayScrollbar,
 #endif
+        "setScrollPosition", &nu::Scroll::SetScrollPosition,
+        "setScrollPositionAnimated", &nu::Scroll::SetScrollPositionAnimated,
+        "getScrollPosition", &nu::Scroll::GetScrollPosition,
+        "getMaximumScrollPosition", &nu::Scroll::GetMaximumScrollPosition,
         "setScrollbarPolicy", &nu::Scroll::SetScrollbarPolicy,
         "getScrollbarPolicy", &nu::Scroll::GetScrollbarPolicy);
+    SetProperty(context, templ, "onScroll", &nu::Scroll::on_scroll,
+                "onScrollEnd", &nu::Scroll::on_scroll_end);
+  }
+};
+
+template<>
+struct Type<nu::VirtualList> {
+  using base = nu::Scroll;
+  static constexpr const char* name = "VirtualList";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::VirtualList>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setItemCount", &nu::VirtualList::SetItemCount,
+        "getItemCount", &nu::VirtualList::GetItemCount,
+        "setEstimatedItemHeight", &nu::VirtualList::SetEstimatedItemHeight,
+        "getEstimatedItemHeight", &nu::VirtualList::GetEstimatedItemHeight,
+        "setOverscan", &nu::VirtualList::SetOverscan,
+        "getOverscan", &nu::VirtualList::GetOverscan,
+        "reloadData", &nu::VirtualList::ReloadData,
+        "reloadItem", &nu::VirtualList::ReloadItem,
+        "scrollToItem", &nu::VirtualList::ScrollToItem,
+        "getVisibleRange", &nu::VirtualList::GetVisibleRange,
+        "getItemView", &nu::VirtualList::GetItemView);
+    SetProperty(context, templ,
+                "createItem", &nu::VirtualList::create_item,
+                "bindItem", &nu::VirtualList::bind_item,
+                "recycleItem", &nu::VirtualList::recycle_item,
+                "measureItem", &nu::VirtualList::measure_item);
   }
 };
 
@@ -2400,6 +3308,10 @@ struct Type<nu::Tab> {
     Set(context, templ,
         "addPage", RefMethod(&nu::Tab::AddPage, RefType::Ref),
         "removePage", RefMethod(&nu::Tab::RemovePage, RefType::Deref),
+        "addLazyPage", &nu::Tab::AddLazyPage,
+        "isPageLoaded", &nu::Tab::IsPageLoaded,
+        "setMaxLoadedPages", &nu::Tab::SetMaxLoadedPages,
+        "getMaxLoadedPages", &nu::Tab::GetMaxLoadedPages,
         "pageCount", &nu::Tab::PageCount,
         "pageAt", &nu::Tab::PageAt,
         "selectPageAt", &nu::Tab::SelectPageAt,
@@ -2423,7 +3335,11 @@ struct Type<nu::TableModel> {
         "getValue", &nu::TableModel::GetValue,
         "notifyRowInsertion", &nu::TableModel::NotifyRowInsertion,
         "notifyRowDeletion", &nu::TableModel::NotifyRowDeletion,
-        "notifyValueChange", &nu::TableModel::NotifyValueChange);
+        "notifyValueChange", &nu::TableModel::NotifyValueChange,
+        "notifyRowsInserted", &nu::TableModel::NotifyRowsInserted,
+        "notifyRowsDeleted", &nu::TableModel::NotifyRowsDeleted,
+        "notifyRangeChanged", &nu::TableModel::NotifyRangeChanged,
+        "notifyReset", &nu::TableModel::NotifyReset);
   }
 };
 
@@ -2440,7 +3356,30 @@ struct Type<nu::AbstractTableModel> {
     SetProperty(context, templ,
                 "getRowCount", &nu::AbstractTableModel::get_row_count,
                 "setValue", &nu::AbstractTableModel::set_value,
-                "getValue", &nu::AbstractTableModel::get_value);
+                "getValue", &nu::AbstractTableModel::get_value,
+                "getRows", &nu::AbstractTableModel::get_rows);
+  }
+};
+
+template<>
+struct Type<nu::PagedTableModel> {
+  using base = nu::TableModel;
+  static constexpr const char* name = "PagedTableModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &Create);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setRowCount", &nu::PagedTableModel::SetRowCount,
+        "setRows", &nu::PagedTableModel::SetRows,
+        "setPlaceholder", &nu::PagedTableModel::SetPlaceholder,
+        "setMaxCachedPages", &nu::PagedTableModel::SetMaxCachedPages,
+        "invalidate", &nu::PagedTableModel::Invalidate,
+        "isRowLoaded", &nu::PagedTableModel::IsRowLoaded);
+    SetProperty(context, templ,
+                "loadRows", &nu::PagedTableModel::load_rows);
   }
 };
 
@@ -2458,10 +3397,107 @@ struct Type<nu::SimpleTableModel> {
     Set(context, templ,
         "addRow", &nu::SimpleTableModel::AddRow,
         "removeRowAt", &nu::SimpleTableModel::RemoveRowAt,
+        "addRows", &nu::SimpleTableModel::AddRows,
+        "removeRowsAt", &nu::SimpleTableModel::RemoveRowsAt,
         "setValue", &nu::SimpleTableModel::SetValue);
   }
 };
 
+template<>
+struct Type<nu::TableModelView> {
+  using base = nu::TableModel;
+  static constexpr const char* name = "TableModelView";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::TableModelView,
+                                scoped_refptr<nu::TableModel>>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "getSource", &nu::TableModelView::GetSource,
+        "setFilter", &nu::TableModelView::SetFilter,
+        "sort", &nu::TableModelView::Sort,
+        "sortAsync", &nu::TableModelView::SortAsync,
+        "clearSort", &nu::TableModelView::ClearSort,
+        "getSortColumn", &nu::TableModelView::GetSortColumn,
+        "isSortAscending", &nu::TableModelView::IsSortAscending,
+        "mapToSource", &nu::TableModelView::MapToSource,
+        "mapFromSource", &nu::TableModelView::MapFromSource);
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel::ColumnType> {
+  static constexpr const char* name = "ColumnarTableModelColumnType";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::ColumnarTableModel::ColumnType* out) {
+    std::string type;
+    if (!vb::FromV8(context, value, &type))
+      return false;
+    if (type == "int64") {
+      *out = nu::ColumnarTableModel::ColumnType::Int64;
+      return true;
+    } else if (type == "double") {
+      *out = nu::ColumnarTableModel::ColumnType::Double;
+      return true;
+    } else if (type == "bool") {
+      *out = nu::ColumnarTableModel::ColumnType::Bool;
+      return true;
+    } else if (type == "string") {
+      *out = nu::ColumnarTableModel::ColumnType::String;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel> {
+  using base = nu::TableModel;
+  static constexpr const char* name = "ColumnarTableModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &CreateOnHeap<nu::ColumnarTableModel,
+                                std::vector<
+                                    nu::ColumnarTableModel::ColumnType>>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "addRow", &nu::ColumnarTableModel::AddRow,
+        "removeRowAt", &nu::ColumnarTableModel::RemoveRowAt,
+        "addRows", &nu::ColumnarTableModel::AddRows,
+        "removeRowsAt", &nu::ColumnarTableModel::RemoveRowsAt,
+        "reserve", &nu::ColumnarTableModel::Reserve,
+        "setValue", &nu::ColumnarTableModel::SetValue);
+  }
+};
+
+template<>
+struct Type<node_yue::ArrayTableModel> {
+  using base = nu::TableModel;
+  static constexpr const char* name = "ArrayTableModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor,
+        "create", &node_yue::ArrayTableModel::CreateWithRows,
+        "createWithColumns", &node_yue::ArrayTableModel::CreateWithColumns);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setRows", &node_yue::ArrayTableModel::SetRows,
+        "setColumns", &node_yue::ArrayTableModel::SetColumns,
+        "getData", &node_yue::ArrayTableModel::GetData,
+        "setValue", &node_yue::ArrayTableModel::SetValue);
+  }
+};
+
 template<>
 struct Type<nu::Table::ColumnType> {
   static constexpr const char* name = "TableColumnType";
@@ -2486,6 +3522,33 @@ struct Type<nu::Table::ColumnType> {
   }
 };
 
+template<>
+struct Type<nu::Table::ScrollAlign> {
+  static constexpr const char* name = "TableScrollAlign";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::Table::ScrollAlign* out) {
+    std::string align;
+    if (!vb::FromV8(context, value, &align))
+      return false;
+    if (align == "nearest") {
+      *out = nu::Table::ScrollAlign::Nearest;
+      return true;
+    } else if (align == "start") {
+      *out = nu::Table::ScrollAlign::Start;
+      return true;
+    } else if (align == "center") {
+      *out = nu::Table::ScrollAlign::Center;
+      return true;
+    } else if (align == "end") {
+      *out = nu::Table::ScrollAlign::End;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
 template<>
 struct Type<nu::Table::ColumnOptions> {
   static constexpr const char* name = "TableColumnOptions";
@@ -2527,7 +3590,121 @@ struct Type<nu::Table> {
         "setRowHeight", &nu::Table::SetRowHeight,
         "getRowHeight", &nu::Table::GetRowHeight,
         "selectRow", &nu::Table::SelectRow,
-        "getSelectedRow", &nu::Table::GetSelectedRow);
+        "getSelectedRow", &nu::Table::GetSelectedRow,
+        "getVisibleRowRange", &nu::Table::GetVisibleRowRange,
+        "scrollToRow", &nu::Table::ScrollToRow);
+    SetProperty(context, templ,
+                "onVisibleRangeChange", &nu::Table::on_visible_range_change);
+  }
+};
+
+template<>
+struct Type<nu::TreeModel> {
+  static constexpr const char* name = "TreeModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "getChildCount", &nu::TreeModel::GetChildCount,
+        "getChild", &nu::TreeModel::GetChild,
+        "hasChildren", &nu::TreeModel::HasChildren,
+        "getValue", &nu::TreeModel::GetValue,
+        "notifyChildrenInserted", &nu::TreeModel::NotifyChildrenInserted,
+        "notifyChildrenDeleted", &nu::TreeModel::NotifyChildrenDeleted,
+        "notifyNodeChanged", &nu::TreeModel::NotifyNodeChanged,
+        "notifyChildrenReset", &nu::TreeModel::NotifyChildrenReset);
+  }
+};
+
+template<>
+struct Type<nu::AbstractTreeModel> {
+  using base = nu::TreeModel;
+  static constexpr const char* name = "AbstractTreeModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::AbstractTreeModel>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    SetProperty(context, templ,
+                "getChildCount", &nu::AbstractTreeModel::get_child_count,
+                "getChild", &nu::AbstractTreeModel::get_child,
+                "hasChildren", &nu::AbstractTreeModel::has_children,
+                "getValue", &nu::AbstractTreeModel::get_value);
+  }
+};
+
+template<>
+struct Type<nu::SimpleTreeModel> {
+  using base = nu::TreeModel;
+  static constexpr const char* name = "SimpleTreeModel";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::SimpleTreeModel>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "addNode", &nu::SimpleTreeModel::AddNode,
+        "addNodes", &nu::SimpleTreeModel::AddNodes,
+        "removeNode", &nu::SimpleTreeModel::RemoveNode,
+        "setValue", &nu::SimpleTreeModel::SetValue,
+        "getParent", &nu::SimpleTreeModel::GetParent,
+        "getNodeCount", &nu::SimpleTreeModel::GetNodeCount);
+  }
+};
+
+template<>
+struct Type<nu::TreeView> {
+  using base = nu::View;
+  static constexpr const char* name = "TreeView";
+  static void BuildConstructor(v8::Local<v8::Context> context,
+                               v8::Local<v8::Object> constructor) {
+    Set(context, constructor, "create", &CreateOnHeap<nu::TreeView>);
+  }
+  static void BuildPrototype(v8::Local<v8::Context> context,
+                             v8::Local<v8::ObjectTemplate> templ) {
+    Set(context, templ,
+        "setModel",
+        RefMethod(&nu::TreeView::SetModel, RefType::Reset, "model"),
+        "getModel", &nu::TreeView::GetModel,
+        "addColumn", &nu::TreeView::AddColumn,
+        "getColumnCount", &nu::TreeView::GetColumnCount,
+        "setColumnsVisible", &nu::TreeView::SetColumnsVisible,
+        "isColumnsVisible", &nu::TreeView::IsColumnsVisible,
+        "expandNode", &nu::TreeView::ExpandNode,
+        "collapseNode", &nu::TreeView::CollapseNode,
+        "isNodeExpanded", &nu::TreeView::IsNodeExpanded,
+        "selectNode", &nu::TreeView::SelectNode,
+        "getSelectedNode", &nu::TreeView::GetSelectedNode);
+    SetProperty(context, templ,
+                "onNodeExpand", &nu::TreeView::on_node_expand,
+                "onNodeCollapse", &nu::TreeView::on_node_collapse,
+                "onSelectionChange", &nu::TreeView::on_selection_change);
+  }
+};
+
+template<>
+struct Type<nu::TextEdit::RangeAttributes> {
+  static constexpr const char* name = "TextEditRangeAttributes";
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     nu::TextEdit::RangeAttributes* out) {
+    if (!value->IsObject())
+      return false;
+    v8::Local<v8::Object> obj = value.As<v8::Object>();
+    if (!Get(context, obj, "start", &out->start) ||
+        !Get(context, obj, "end", &out->end))
+      return false;
+    nu::Font* font;
+    if (Get(context, obj, "font", &font))
+      out->font = font;
+    nu::Color color;
+    if (Get(context, obj, "color", &color))
+      out->color = color;
+    return true;
   }
 };
 
@@ -2559,6 +3736,13 @@ struct Type<nu::TextEdit> {
         "insertTextAt", &nu::TextEdit::InsertTextAt,
         "delete", &nu::TextEdit::Delete,
         "deleteRange", &nu::TextEdit::DeleteRange,
+        "appendText", &nu::TextEdit::AppendText,
+        "setMaxLines", &nu::TextEdit::SetMaxLines,
+        "getMaxLines", &nu::TextEdit::GetMaxLines,
+        "setAutoScroll", &nu::TextEdit::SetAutoScroll,
+        "isAutoScroll", &nu::TextEdit::IsAutoScroll,
+        "setAttributesForRanges", &nu::TextEdit::SetAttributesForRanges,
+        "clearAttributesInRange", &nu::TextEdit::ClearAttributesInRange,
 #if !defined(OS_WIN)
         "setOverlayScrollbar", &nu::TextEdit::SetOverlayScrollbar,
 #endif
@@ -2566,6 +3750,7 @@ struct Type<nu::TextEdit> {
         "getTextBounds", &nu::TextEdit::GetTextBounds);
     SetProperty(context, templ,
                 "onTextChange", &nu::TextEdit::on_text_change,
+                "onTextRangeChange", &nu::TextEdit::on_text_range_change,
                 "shouldInsertNewLine", &nu::TextEdit::should_insert_new_line);
   }
 };
@@ -2692,16 +3877,206 @@ bool GetRuntime(
 
 void MemoryPressureNotification(v8::Local<v8::Context> context, int level) {
   level = std::max(0, std::min(level, 2));
-  context->GetIsolate()->MemoryPressureNotification(
-      static_cast<v8::MemoryPressureLevel>(level));
+  // V8 is notified by the on_memory_pressure handler.
+  if (level > 0)
+    nu::App::GetCurrent()->NotifyMemoryPressure(level == 2);
+  else
+    context->GetIsolate()->MemoryPressureNotification(
+        v8::MemoryPressureLevel::kNone);
 }
 
+void SetLayoutStatsEnabled(bool enabled) {
+  nu::State::GetCurrent()->SetLayoutStatsEnabled(enabled);
+}
+
+nu::LayoutStats GetLayoutStats() {
+  return nu::State::GetCurrent()->GetLayoutStats();
+}
+
+void ResetLayoutStats() {
+  nu::State::GetCurrent()->ResetLayoutStats();
+}
+
+void SetMessageLoopStatsEnabled(bool enabled) {
+  nu::State::GetCurrent()->SetMessageLoopStatsEnabled(enabled);
+}
+
+nu::MessageLoopStats GetMessageLoopStats() {
+  return nu::State::GetCurrent()->GetMessageLoopStats();
+}
+
+void ResetMessageLoopStats() {
+  nu::State::GetCurrent()->ResetMessageLoopStats();
+}
+
+nu::MemoryReport GetMemoryReport() {
+  return nu::State::GetCurrent()->GetMemoryReport();
+}
+
+nu::StartupStats GetStartupStats() {
+  return nu::State::GetStartupStats();
+}
+
+void SetPaintStatsEnabled(bool enabled) {
+  nu::State::GetCurrent()->SetPaintStatsEnabled(enabled);
+}
+
+nu::PaintStats GetPaintStats() {
+  return nu::State::GetCurrent()->GetPaintStats();
+}
+
+void ResetPaintStats() {
+  nu::State::GetCurrent()->ResetPaintStats();
+}
+
+std::string GetPaintTrace() {
+  return nu::State::GetCurrent()->GetPaintStats().ToTraceJSON();
+}
+
+void StartTracing(const std::string& categories) {
+  nu::TraceLog::GetInstance()->Clear();
+  nu::TraceLog::GetInstance()->Start(categories);
+}
+
+void StopTracing() {
+  nu::TraceLog::GetInstance()->Stop();
+}
+
+std::string GetTrace() {
+  return nu::TraceLog::GetInstance()->ToTraceJSON();
+}
+
+// Wrappers that are garbage but not collected yet are also counted.
+std::map<std::string, vb::ObjectStats> GetObjectStats(
+    v8::Local<v8::Context> context) {
+  return vb::PerIsolateData::Get(context->GetIsolate())->GetObjectStats();
+}
+
+void SetCallStatsEnabled(bool enabled) {
+  vb::SetCallStatsEnabled(enabled);
+}
+
+std::map<std::string, vb::CallStats> GetCallStats() {
+  return vb::GetCallStats();
+}
+
+void ResetCallStats() {
+  vb::ResetCallStats();
+}
+
+void SetLongTaskThreshold(float ms) {
+  nu::State::GetCurrent()->SetLongTaskThreshold(
+      base::TimeDelta::FromMillisecondsD(ms));
+}
+
+void SetViewRecycleLimit(uint32_t limit) {
+  nu::State::GetCurrent()->SetViewRecycleLimit(limit);
+}
+
+// A payload posted from a worker thread to the handler of |channel|.
+struct WorkerTask {
+  std::string channel;
+  nu::Buffer payload;
+};
+
+// Called in the GUI thread.
+void RunWorkerTask(WorkerTask* task) {
+  std::unique_ptr<WorkerTask> scoped_task(task);
+  auto& handlers = GetWorkerTaskHandlers();
+  auto it = handlers.find(task->channel);
+  if (it == handlers.end())
+    return;
+  // The handler may replace itself.
+  WorkerTaskHandler handler = it->second;
+  handler(std::move(task->payload));
+}
+
+// Called in worker threads, the payload is copied once and then handed to
+// the handler in the GUI thread without copying.
+void PostWorkerTask(vb::Arguments* args,
+                    const std::string& channel,
+                    v8::Local<v8::Value> data) {
+  std::string str;
+  const char* content = nullptr;
+  size_t size = 0;
+  if (node::Buffer::HasInstance(data)) {
+    content = node::Buffer::Data(data);
+    size = node::Buffer::Length(data);
+  } else if (data->IsString()) {
+    vb::FromV8(args->GetContext(), data, &str);
+    content = str.data();
+    size = str.size();
+  } else if (!data->IsNullOrUndefined()) {
+    args->ThrowError("Buffer or string");
+    return;
+  }
+  auto* task = new WorkerTask{channel, nu::Buffer()};
+  if (size > 0) {
+    void* copy = malloc(size);
+    memcpy(copy, content, size);
+    task->payload = nu::Buffer::TakeOver(copy, size, &free);
+  }
+  nu::MessageLoop::PostTask([task]() { RunWorkerTask(task); });
+}
+
+// Worker threads do not have GUI states, and can only post tasks to the GUI
+// thread.
+void InitializeWorker(v8::Local<v8::Object> exports,
+                      v8::Local<v8::Context> context) {
+  v8::Local<v8::Object> message_loop = v8::Object::New(context->GetIsolate());
+  vb::Set(context, message_loop, "postTask", &PostWorkerTask);
+  vb::Set(context, exports, "MessageLoop", message_loop);
+}
+
+#if defined(NODE_YUE_BENCHMARK)
+// Native side of the benchmarks in node_yue/benchmark, the operations are
+// repeated in C++ so the calls into the hooks are not measured.
+void BenchmarkEmitSignal(uint32_t count) {
+  nu::App* app = nu::App::GetCurrent();
+  for (uint32_t i = 0; i < count; ++i)
+    app->on_enter_background.Emit(app);
+}
+
+// Convert |value| to base::Value and back for |count| times.
+v8::Local<v8::Value> BenchmarkConvertValue(v8::Local<v8::Context> context,
+                                           v8::Local<v8::Value> value,
+                                           uint32_t count) {
+  v8::Local<v8::Value> result = v8::Null(context->GetIsolate());
+  for (uint32_t i = 0; i < count; ++i) {
+    base::Value converted;
+    if (!vb::FromV8(context, value, &converted))
+      break;
+    result = vb::ToV8(context, converted);
+  }
+  return result;
+}
+
+// Read every cell of |model| and return the number of cells read.
+uint32_t BenchmarkGetTableCells(nu::TableModel* model, uint32_t columns) {
+  uint32_t cells = 0;
+  uint32_t rows = model->GetRowCount();
+  for (uint32_t row = 0; row < rows; ++row) {
+    for (uint32_t column = 0; column < columns; ++column) {
+      if (model->GetValue(column, row))
+        ++cells;
+    }
+  }
+  return cells;
+}
+#endif
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
                 void* priv) {
   CHECK(GetRuntime(context, &is_electron, &is_yode));
 
+  // The module is loaded in a worker thread after the GUI thread.
+  if (nu::State::GetMain() && !nu::State::GetCurrent()) {
+    InitializeWorker(exports, context);
+    return;
+  }
+
 #if defined(OS_WIN)
   if (!is_electron) {
     // Show system dialog on crash.
@@ -2714,6 +4089,22 @@ void Initialize(v8::Local<v8::Object> exports,
   }
   // Initialize the nativeui and leak it.
   new nu::State;
+  // Let V8 release memory together with the caches.
+  v8::Isolate* isolate = context->GetIsolate();
+  nu::App::GetCurrent()->on_memory_pressure.Connect(
+      [isolate](nu::App*, bool critical) {
+    isolate->MemoryPressureNotification(
+        critical ? v8::MemoryPressureLevel::kCritical
+                 : v8::MemoryPressureLevel::kModerate);
+  });
+  // Let V8 collect garbage in the idle time after frames, instead of in the
+  // middle of animations.
+  nu::MessageLoop::AddFrameIdleHandler([isolate](double remaining) {
+    NU_TRACE_EVENT("binding", "V8::IdleGC");
+    // The deadline is based on the MonotonicallyIncreasingTime of Node's
+    // platform, which is uv_hrtime.
+    isolate->IdleNotificationDeadline(uv_hrtime() / 1e9 + remaining / 1000);
+  });
   // Official node platform needs node integration.
   if (!is_electron && !is_yode) {
     // Initialize node integration and leak it.
@@ -2724,69 +4115,120 @@ void Initialize(v8::Local<v8::Object> exports,
 
   vb::Set(context, exports,
           // Classes.
-          "App",               vb::Constructor<nu::App>(),
-          "AttributedText",    vb::Constructor<nu::AttributedText>(),
-          "Font",              vb::Constructor<nu::Font>(),
-          "Canvas",            vb::Constructor<nu::Canvas>(),
-          "Clipboard",         vb::Constructor<nu::Clipboard>(),
-          "Color",             vb::Constructor<nu::Color>(),
-          "Cursor",            vb::Constructor<nu::Cursor>(),
-          "DraggingInfo",      vb::Constructor<nu::DraggingInfo>(),
-          "Image",             vb::Constructor<nu::Image>(),
-          "Painter",           vb::Constructor<nu::Painter>(),
-          "Event",             vb::Constructor<nu::Event>(),
-          "FileDialog",        vb::Constructor<nu::FileDialog>(),
-          "FileOpenDialog",    vb::Constructor<nu::FileOpenDialog>(),
-          "FileSaveDialog",    vb::Constructor<nu::FileSaveDialog>(),
-          "MenuBar",           vb::Constructor<nu::MenuBar>(),
-          "Menu",              vb::Constructor<nu::Menu>(),
-          "MenuItem",          vb::Constructor<nu::MenuItem>(),
-          "MessageBox",        vb::Constructor<nu::MessageBox>(),
-          "Window",            vb::Constructor<nu::Window>(),
-          "View",              vb::Constructor<nu::View>(),
-          "ComboBox",          vb::Constructor<nu::ComboBox>(),
-          "Container",         vb::Constructor<nu::Container>(),
-          "Button",            vb::Constructor<nu::Button>(),
-          "ProtocolStringJob", vb::Constructor<nu::ProtocolStringJob>(),
-          "ProtocolFileJob",   vb::Constructor<nu::ProtocolFileJob>(),
-          "ProtocolAsarJob",   vb::Constructor<nu::ProtocolAsarJob>(),
-          "Browser",           vb::Constructor<nu::Browser>(),
-          "Entry",             vb::Constructor<nu::Entry>(),
-          "Label",             vb::Constructor<nu::Label>(),
-          "Picker",            vb::Constructor<nu::Picker>(),
-          "ProgressBar",       vb::Constructor<nu::ProgressBar>(),
-          "GifPlayer",         vb::Constructor<nu::GifPlayer>(),
-          "Group",             vb::Constructor<nu::Group>(),
-          "Screen",            vb::Constructor<nu::Screen>(),
-          "Scroll",            vb::Constructor<nu::Scroll>(),
-          "Separator",         vb::Constructor<nu::Separator>(),
-          "Slider",            vb::Constructor<nu::Slider>(),
-          "TableModel",        vb::Constructor<nu::TableModel>(),
-          "AbstractTableModel", vb::Constructor<nu::AbstractTableModel>(),
-          "SimpleTableModel",  vb::Constructor<nu::SimpleTableModel>(),
-          "Tab",               vb::Constructor<nu::Tab>(),
-          "Table",             vb::Constructor<nu::Table>(),
-          "TextEdit",          vb::Constructor<nu::TextEdit>(),
-          "Tray",              vb::Constructor<nu::Tray>(),
+          "App",               vb::LazyConstructor<nu::App>(),
+          "ImageCache",        vb::LazyConstructor<nu::ImageCache>(),
+          "AttributedText",    vb::LazyConstructor<nu::AttributedText>(),
+          "Font",              vb::LazyConstructor<nu::Font>(),
+          "Canvas",            vb::LazyConstructor<nu::Canvas>(),
+          "Clipboard",         vb::LazyConstructor<nu::Clipboard>(),
+          "Color",             vb::LazyConstructor<nu::Color>(),
+          "Cursor",            vb::LazyConstructor<nu::Cursor>(),
+          "DisplayList",       vb::LazyConstructor<nu::DisplayList>(),
+          "Path",              vb::LazyConstructor<nu::Path>(),
+          "MonospaceTextRenderer",
+          vb::LazyConstructor<nu::MonospaceTextRenderer>(),
+          "DraggingInfo",      vb::LazyConstructor<nu::DraggingInfo>(),
+          "Image",             vb::LazyConstructor<nu::Image>(),
+          "Painter",           vb::LazyConstructor<nu::Painter>(),
+          "Event",             vb::LazyConstructor<nu::Event>(),
+          "FileDialog",        vb::LazyConstructor<nu::FileDialog>(),
+          "FileOpenDialog",    vb::LazyConstructor<nu::FileOpenDialog>(),
+          "FileSaveDialog",    vb::LazyConstructor<nu::FileSaveDialog>(),
+          "MenuBar",           vb::LazyConstructor<nu::MenuBar>(),
+          "Menu",              vb::LazyConstructor<nu::Menu>(),
+          "MenuItem",          vb::LazyConstructor<nu::MenuItem>(),
+          "MessageBox",        vb::LazyConstructor<nu::MessageBox>(),
+          "Window",            vb::LazyConstructor<nu::Window>(),
+          "View",              vb::LazyConstructor<nu::View>(),
+          "ComboBox",          vb::LazyConstructor<nu::ComboBox>(),
+          "Container",         vb::LazyConstructor<nu::Container>(),
+          "Button",            vb::LazyConstructor<nu::Button>(),
+          "ProtocolStringJob", vb::LazyConstructor<nu::ProtocolStringJob>(),
+          "ProtocolFileJob",   vb::LazyConstructor<nu::ProtocolFileJob>(),
+          "ProtocolAsarJob",   vb::LazyConstructor<nu::ProtocolAsarJob>(),
+#if defined(BROWSER_SUPPORT)
+          "Browser",           vb::LazyConstructor<nu::Browser>(),
+          "BrowserReply",      vb::LazyConstructor<nu::BrowserReply>(),
+#endif
+          "Entry",             vb::LazyConstructor<nu::Entry>(),
+          "Label",             vb::LazyConstructor<nu::Label>(),
+          "StyleSheet",        vb::LazyConstructor<nu::StyleSheet>(),
+          "ViewTemplate",      vb::LazyConstructor<nu::ViewTemplate>(),
+          "LayoutTransaction", vb::LazyConstructor<nu::LayoutTransaction>(),
+          "AsyncLayout",       vb::LazyConstructor<nu::AsyncLayout>(),
+          "Picker",            vb::LazyConstructor<nu::Picker>(),
+          "ProgressBar",       vb::LazyConstructor<nu::ProgressBar>(),
+          "GifPlayer",         vb::LazyConstructor<nu::GifPlayer>(),
+          "Group",             vb::LazyConstructor<nu::Group>(),
+          "Screen",            vb::LazyConstructor<nu::Screen>(),
+          "Scroll",            vb::LazyConstructor<nu::Scroll>(),
+          "Separator",         vb::LazyConstructor<nu::Separator>(),
+          "Slider",            vb::LazyConstructor<nu::Slider>(),
+          "TableModel",        vb::LazyConstructor<nu::TableModel>(),
+          "AbstractTableModel", vb::LazyConstructor<nu::AbstractTableModel>(),
+          "PagedTableModel",   vb::LazyConstructor<nu::PagedTableModel>(),
+          "SimpleTableModel",  vb::LazyConstructor<nu::SimpleTableModel>(),
+          "ColumnarTableModel", vb::LazyConstructor<nu::ColumnarTableModel>(),
+          "ArrayTableModel",   vb::LazyConstructor<node_yue::ArrayTableModel>(),
+          "TableModelView",    vb::LazyConstructor<nu::TableModelView>(),
+          "Tab",               vb::LazyConstructor<nu::Tab>(),
+          "Table",             vb::LazyConstructor<nu::Table>(),
+          "TextEdit",          vb::LazyConstructor<nu::TextEdit>(),
+          "Tray",              vb::LazyConstructor<nu::Tray>(),
+          "TreeModel",         vb::LazyConstructor<nu::TreeModel>(),
+          "AbstractTreeModel", vb::LazyConstructor<nu::AbstractTreeModel>(),
+          "SimpleTreeModel",   vb::LazyConstructor<nu::SimpleTreeModel>(),
+          "TreeView",          vb::LazyConstructor<nu::TreeView>(),
+          "VirtualList",       vb::LazyConstructor<nu::VirtualList>(),
 #if defined(OS_MACOSX)
-          "Toolbar",           vb::Constructor<nu::Toolbar>(),
-          "Vibrant",           vb::Constructor<nu::Vibrant>(),
+          "Toolbar",           vb::LazyConstructor<nu::Toolbar>(),
+          "Vibrant",           vb::LazyConstructor<nu::Vibrant>(),
 #endif
           // Properties.
-          "app",    nu::App::GetCurrent(),
-          "screen", nu::Screen::GetCurrent(),
+          "app",        nu::App::GetCurrent(),
+          "imageCache", nu::ImageCache::GetCurrent(),
+          "screen",     nu::Screen::GetCurrent(),
           // Functions.
-          "memoryPressureNotification", &MemoryPressureNotification);
+          "memoryPressureNotification", &MemoryPressureNotification,
+          "setLayoutStatsEnabled", &SetLayoutStatsEnabled,
+          "getLayoutStats", &GetLayoutStats,
+          "resetLayoutStats", &ResetLayoutStats,
+          "setMessageLoopStatsEnabled", &SetMessageLoopStatsEnabled,
+          "getMessageLoopStats", &GetMessageLoopStats,
+          "resetMessageLoopStats", &ResetMessageLoopStats,
+          "setPaintStatsEnabled", &SetPaintStatsEnabled,
+          "getPaintStats", &GetPaintStats,
+          "resetPaintStats", &ResetPaintStats,
+          "getPaintTrace", &GetPaintTrace,
+          "startTracing", &StartTracing,
+          "stopTracing", &StopTracing,
+          "getTrace", &GetTrace,
+          "getObjectStats", &GetObjectStats,
+          "getMemoryReport", &GetMemoryReport,
+          "getStartupStats", &GetStartupStats,
+          "setCallStatsEnabled", &SetCallStatsEnabled,
+          "getCallStats", &GetCallStats,
+          "resetCallStats", &ResetCallStats,
+          "setLongTaskThreshold", &SetLongTaskThreshold,
+          "setViewRecycleLimit", &SetViewRecycleLimit);
+#if defined(NODE_YUE_BENCHMARK)
+  v8::Local<v8::Object> benchmark = v8::Object::New(isolate);
+  vb::Set(context, benchmark,
+          "emitSignal", &BenchmarkEmitSignal,
+          "convertValue", &BenchmarkConvertValue,
+          "getTableCells", &BenchmarkGetTableCells);
+  vb::Set(context, exports, "_benchmark", benchmark);
+#endif
   if (is_electron) {
 #if defined(OS_MACOSX)
     vb::Set(context, exports,
-            "ChromeView", vb::Constructor<node_yue::ChromeView>());
+            "ChromeView", vb::LazyConstructor<node_yue::ChromeView>());
 #endif
   } else {
     vb::Set(context, exports,
-            "Lifetime", vb::Constructor<nu::Lifetime>(),
+            "Lifetime", vb::LazyConstructor<nu::Lifetime>(),
             "lifetime", nu::Lifetime::GetCurrent(),
-            "MessageLoop", vb::Constructor<nu::MessageLoop>());
+            "MessageLoop", vb::LazyConstructor<nu::MessageLoop>());
   }
 }
 
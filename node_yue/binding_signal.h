@@ -6,6 +6,7 @@
 #define NODE_YUE_BINDING_SIGNAL_H_
 
 #include "nativeui/nativeui.h"
+#include "nativeui/trace_event.h"
 #include "v8binding/v8binding.h"
 
 namespace node_yue {
@@ -33,11 +34,11 @@ class SignalWrapper : public base::RefCounted<SignalWrapper<Sig>> {
       args->ThrowError("Function");
       return -1;
     }
-    int id = signal_->Connect(slot);
+    int id = signal_->Connect(
+        nu::TraceSlot("binding", "SignalHandler", std::move(slot)));
     // owner[signal][id] = slot.
-    v8::Local<v8::Map> refs = vb::GetAttachedTable(
-        context, v8::Local<v8::Object>::New(isolate, owner_), signal_);
-    refs->Set(context, v8::Integer::New(isolate, id), value).IsEmpty();
+    GetSlots(context)->Set(context, v8::Integer::New(isolate, id),
+                           value).IsEmpty();
     return id;
   }
 
@@ -50,9 +51,8 @@ class SignalWrapper : public base::RefCounted<SignalWrapper<Sig>> {
     signal_->Disconnect(id);
     // delete owner[signal][id]
     v8::Local<v8::Context> context = args->GetContext();
-    v8::Local<v8::Map> refs = vb::GetAttachedTable(
-        context, v8::Local<v8::Object>::New(isolate, owner_), signal_);
-    refs->Delete(context, v8::Integer::New(isolate, id)).FromJust();
+    GetSlots(context)->Delete(context,
+                              v8::Integer::New(isolate, id)).FromJust();
   }
 
   void DisconnectAll(vb::Arguments* args) {
@@ -63,18 +63,30 @@ class SignalWrapper : public base::RefCounted<SignalWrapper<Sig>> {
     }
     signal_->DisconnectAll();
     // owner[signal].clear()
-    v8::Local<v8::Context> context = args->GetContext();
-    vb::GetAttachedTable(context,
-                         v8::Local<v8::Object>::New(isolate, owner_),
-                         signal_)->Clear();
+    GetSlots(args->GetContext())->Clear();
   }
 
  private:
   ~SignalWrapper() {}
 
+  // Return owner[signal], looking up the attached table requires encoding
+  // the key and searching private symbols, so it is cached after first use.
+  // The table is owned by owner, and is only weakly referenced here.
+  v8::Local<v8::Map> GetSlots(v8::Local<v8::Context> context) {
+    v8::Isolate* isolate = context->GetIsolate();
+    if (!slots_.IsEmpty())
+      return v8::Local<v8::Map>::New(isolate, slots_);
+    v8::Local<v8::Map> slots = vb::GetAttachedTable(
+        context, v8::Local<v8::Object>::New(isolate, owner_), signal_);
+    slots_.Reset(isolate, slots);
+    slots_.SetWeak();
+    return slots;
+  }
+
   friend class base::RefCounted<SignalWrapper<Sig>>;
 
   v8::Global<v8::Object> owner_;
+  v8::Global<v8::Map> slots_;
   nu::Signal<Sig>* signal_;
 };
 
@@ -118,7 +130,8 @@ struct MemberTraits<nu::Signal<Sig>> {
     std::function<Sig> slot;
     if (!vb::WeakFunctionFromV8(context, value, &slot))
       return false;
-    int id = out->Connect(slot);
+    int id = out->Connect(
+        nu::TraceSlot("binding", "SignalHandler", std::move(slot)));
     // owner[signal][id] = slot
     v8::Local<v8::Map> refs = vb::GetAttachedTable(context, owner, out);
     refs->Set(context,
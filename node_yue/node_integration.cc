@@ -17,10 +17,16 @@ namespace node_yue {
 NodeIntegration::NodeIntegration()
     : uv_loop_(uv_default_loop()),
       embed_closed_(false),
+      watching_backend_fd_(false),
       weak_factory_(this) {
 }
 
 NodeIntegration::~NodeIntegration() {
+  if (watching_backend_fd_) {
+    uv_close(reinterpret_cast<uv_handle_t*>(&dummy_uv_handle_), nullptr);
+    return;
+  }
+
   // Quit the embed thread.
   embed_closed_ = true;
   uv_sem_post(&embed_sem_);
@@ -39,6 +45,11 @@ void NodeIntegration::PrepareMessageLoop() {
   // nothing to do.
   uv_async_init(uv_loop_, &dummy_uv_handle_, nullptr);
 
+  // Prefer handling events directly in main thread.
+  watching_backend_fd_ = WatchBackendFd();
+  if (watching_backend_fd_)
+    return;
+
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
@@ -53,8 +64,18 @@ void NodeIntegration::UvRunOnce() {
   // Deal with uv events.
   uv_run(uv_loop_, UV_RUN_NOWAIT);
 
-  // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  // Wait for next timeout, or tell the worker thread to continue polling.
+  if (watching_backend_fd_)
+    UpdateBackendTimeout();
+  else
+    uv_sem_post(&embed_sem_);
+}
+
+bool NodeIntegration::WatchBackendFd() {
+  return false;
+}
+
+void NodeIntegration::UpdateBackendTimeout() {
 }
 
 void NodeIntegration::WakeupMainThread() {
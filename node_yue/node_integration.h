@@ -31,6 +31,15 @@ class NodeIntegration {
  protected:
   NodeIntegration();
 
+  // Watch libuv's backend fd in the main thread's message loop, so events are
+  // handled without waking up a thread in between. Returns false if it is not
+  // supported, and a thread is used to poll events instead.
+  virtual bool WatchBackendFd();
+
+  // Called after running libuv loop when watching the backend fd, to arm the
+  // timer for libuv's next timeout.
+  virtual void UpdateBackendTimeout();
+
   // Called to poll events in new thread.
   virtual void PollEvents() = 0;
 
@@ -53,6 +62,9 @@ class NodeIntegration {
   // Whether the libuv loop has ended.
   bool embed_closed_;
 
+  // Whether the backend fd is watched in main thread.
+  bool watching_backend_fd_;
+
   // Dummy handle to make uv's loop not quit.
   uv_async_t dummy_uv_handle_;
 
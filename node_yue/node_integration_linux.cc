@@ -6,9 +6,41 @@
 #include "node_yue/node_integration_linux.h"
 
 #include <sys/epoll.h>
+#include <unistd.h>
 
 namespace node_yue {
 
+// The source is ready when the backend fd has events, or when the loop has
+// reached its next timeout.
+struct NodeIntegrationLinux::UvSource {
+  GSource source;
+  NodeIntegrationLinux* self;
+  gpointer fd_tag;
+
+  static gboolean Prepare(GSource* source, gint* timeout) {
+    uv_loop_t* loop = reinterpret_cast<UvSource*>(source)->self->uv_loop_;
+    // Timers may have been started by JavaScript called from GTK events, and
+    // the timeout is relative to the cached loop time.
+    uv_update_time(loop);
+    *timeout = uv_backend_timeout(loop);
+    return *timeout == 0;
+  }
+
+  static gboolean Check(GSource* source) {
+    auto* uv_source = reinterpret_cast<UvSource*>(source);
+    if (g_source_query_unix_fd(source, uv_source->fd_tag) & G_IO_IN)
+      return TRUE;
+    uv_loop_t* loop = uv_source->self->uv_loop_;
+    uv_update_time(loop);
+    return uv_backend_timeout(loop) == 0;
+  }
+
+  static gboolean Dispatch(GSource* source, GSourceFunc, gpointer) {
+    reinterpret_cast<UvSource*>(source)->self->UvRunOnce();
+    return G_SOURCE_CONTINUE;
+  }
+};
+
 NodeIntegrationLinux::NodeIntegrationLinux() : epoll_(epoll_create(1)) {
   int backend_fd = uv_backend_fd(uv_loop_);
   struct epoll_event ev = { 0 };
@@ -18,6 +50,29 @@ NodeIntegrationLinux::NodeIntegrationLinux() : epoll_(epoll_create(1)) {
 }
 
 NodeIntegrationLinux::~NodeIntegrationLinux() {
+  if (source_) {
+    g_source_destroy(source_);
+    g_source_unref(source_);
+  }
+  close(epoll_);
+}
+
+bool NodeIntegrationLinux::WatchBackendFd() {
+  // The backend fd is an epoll fd, which becomes readable when there are
+  // events, so GLib can poll it together with other sources.
+  static GSourceFuncs funcs = {
+    &UvSource::Prepare,
+    &UvSource::Check,
+    &UvSource::Dispatch,
+    nullptr,
+  };
+  source_ = g_source_new(&funcs, sizeof(UvSource));
+  auto* uv_source = reinterpret_cast<UvSource*>(source_);
+  uv_source->self = this;
+  uv_source->fd_tag = g_source_add_unix_fd(source_, uv_backend_fd(uv_loop_),
+                                           G_IO_IN);
+  g_source_attach(source_, nullptr);
+  return true;
 }
 
 void NodeIntegrationLinux::PollEvents() {
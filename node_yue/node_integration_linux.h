@@ -6,6 +6,8 @@
 #ifndef NODE_YUE_NODE_INTEGRATION_LINUX_H_
 #define NODE_YUE_NODE_INTEGRATION_LINUX_H_
 
+#include <glib.h>
+
 #include "node_yue/node_integration.h"
 
 namespace node_yue {
@@ -16,11 +18,17 @@ class NodeIntegrationLinux : public NodeIntegration {
   ~NodeIntegrationLinux() override;
 
  private:
+  struct UvSource;
+
+  bool WatchBackendFd() override;
   void PollEvents() override;
 
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
+  // The GSource watching uv's backend fd in main loop.
+  GSource* source_ = nullptr;
+
   DISALLOW_COPY_AND_ASSIGN(NodeIntegrationLinux);
 };
 
@@ -6,6 +6,7 @@
 #include "node_yue/node_integration_mac.h"
 
 #include <errno.h>
+#include <math.h>
 #include <sys/select.h>
 #include <sys/sysctl.h>
 #include <sys/time.h>
@@ -17,6 +18,80 @@ NodeIntegrationMac::NodeIntegrationMac() {
 }
 
 NodeIntegrationMac::~NodeIntegrationMac() {
+  if (observer_) {
+    CFRunLoopObserverInvalidate(observer_);
+    CFRelease(observer_);
+  }
+  if (timer_) {
+    CFRunLoopTimerInvalidate(timer_);
+    CFRelease(timer_);
+  }
+  if (backend_source_) {
+    CFRunLoopSourceInvalidate(backend_source_);
+    CFRelease(backend_source_);
+  }
+  if (backend_fd_) {
+    CFFileDescriptorInvalidate(backend_fd_);
+    CFRelease(backend_fd_);
+  }
+}
+
+bool NodeIntegrationMac::WatchBackendFd() {
+  CFFileDescriptorContext context = {0, this, nullptr, nullptr, nullptr};
+  backend_fd_ = CFFileDescriptorCreate(kCFAllocatorDefault,
+                                       uv_backend_fd(uv_loop_), false,
+                                       &OnBackendFd, &context);
+  if (!backend_fd_)
+    return false;
+  backend_source_ = CFFileDescriptorCreateRunLoopSource(kCFAllocatorDefault,
+                                                        backend_fd_, 0);
+  CFRunLoopAddSource(CFRunLoopGetMain(), backend_source_,
+                     kCFRunLoopCommonModes);
+  CFFileDescriptorEnableCallBacks(backend_fd_, kCFFileDescriptorReadCallBack);
+
+  CFRunLoopTimerContext timer_context = {0, this, nullptr, nullptr, nullptr};
+  timer_ = CFRunLoopTimerCreate(kCFAllocatorDefault, HUGE_VAL, HUGE_VAL, 0, 0,
+                                &OnTimeout, &timer_context);
+  CFRunLoopAddTimer(CFRunLoopGetMain(), timer_, kCFRunLoopCommonModes);
+
+  CFRunLoopObserverContext observer_context =
+      {0, this, nullptr, nullptr, nullptr};
+  observer_ = CFRunLoopObserverCreate(kCFAllocatorDefault,
+                                      kCFRunLoopBeforeWaiting, true, 0,
+                                      &OnBeforeWaiting, &observer_context);
+  CFRunLoopAddObserver(CFRunLoopGetMain(), observer_, kCFRunLoopCommonModes);
+  return true;
+}
+
+void NodeIntegrationMac::UpdateBackendTimeout() {
+  // The timeout is relative to the cached loop time, which is stale when
+  // timers were added outside uv_run.
+  uv_update_time(uv_loop_);
+  int timeout = uv_backend_timeout(uv_loop_);
+  CFAbsoluteTime fire_date = timeout == -1 ?
+      HUGE_VAL : CFAbsoluteTimeGetCurrent() + timeout / 1000.;
+  CFRunLoopTimerSetNextFireDate(timer_, fire_date);
+}
+
+// static
+void NodeIntegrationMac::OnBackendFd(CFFileDescriptorRef fd,
+                                     CFOptionFlags flags,
+                                     void* info) {
+  // The callback is disabled after each event.
+  CFFileDescriptorEnableCallBacks(fd, kCFFileDescriptorReadCallBack);
+  static_cast<NodeIntegrationMac*>(info)->UvRunOnce();
+}
+
+// static
+void NodeIntegrationMac::OnTimeout(CFRunLoopTimerRef timer, void* info) {
+  static_cast<NodeIntegrationMac*>(info)->UvRunOnce();
+}
+
+// static
+void NodeIntegrationMac::OnBeforeWaiting(CFRunLoopObserverRef observer,
+                                         CFRunLoopActivity activity,
+                                         void* info) {
+  static_cast<NodeIntegrationMac*>(info)->UpdateBackendTimeout();
 }
 
 void NodeIntegrationMac::PollEvents() {
@@ -6,6 +6,8 @@
 #ifndef NODE_YUE_NODE_INTEGRATION_MAC_H_
 #define NODE_YUE_NODE_INTEGRATION_MAC_H_
 
+#include <CoreFoundation/CoreFoundation.h>
+
 #include "node_yue/node_integration.h"
 
 namespace node_yue {
@@ -16,8 +18,29 @@ class NodeIntegrationMac : public NodeIntegration {
   ~NodeIntegrationMac() override;
 
  private:
+  static void OnBackendFd(CFFileDescriptorRef fd,
+                          CFOptionFlags flags,
+                          void* info);
+  static void OnTimeout(CFRunLoopTimerRef timer, void* info);
+  static void OnBeforeWaiting(CFRunLoopObserverRef observer,
+                              CFRunLoopActivity activity,
+                              void* info);
+
+  bool WatchBackendFd() override;
+  void UpdateBackendTimeout() override;
   void PollEvents() override;
 
+  // Watch uv's backend fd, which is a kqueue fd, in main run loop.
+  CFFileDescriptorRef backend_fd_ = nullptr;
+  CFRunLoopSourceRef backend_source_ = nullptr;
+
+  // Fires at uv's next timeout.
+  CFRunLoopTimerRef timer_ = nullptr;
+
+  // Re-arms |timer_| before the run loop sleeps, as JavaScript called from
+  // native events may have started timers outside uv_run.
+  CFRunLoopObserverRef observer_ = nullptr;
+
   DISALLOW_COPY_AND_ASSIGN(NodeIntegrationMac);
 };
 
@@ -57,6 +57,13 @@ class V8ValueConverter {
   // If true, treats -0 as an integer. Otherwise, -0 is converted to a double.
   virtual void SetConvertNegativeZeroToInt(bool val) = 0;
 
+  // If true, objects and arrays are not checked for cycles, which saves an
+  // identity hash and a map lookup for each of them.
+  //
+  // Only use it for trusted data that is known to be acyclic, otherwise cycles
+  // are expanded until the max recursion depth is reached.
+  virtual void SetSkipCycleCheck(bool val) = 0;
+
   // Converts a base::Value to a v8::Value.
   //
   // Unsupported types are replaced with null.  If an array or object throws
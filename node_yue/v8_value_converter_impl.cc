@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include <cmath>
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -45,8 +46,13 @@ class V8ValueConverterImpl::FromV8ValueState {
     FromV8ValueState* state_;
   };
 
-  explicit FromV8ValueState(bool avoid_identity_hash_for_testing)
+  // Names of properties converted at one depth, which are reused for objects
+  // of the same shape, as they share the same internalized key strings.
+  using KeyCache = std::vector<std::pair<v8::Local<v8::Value>, std::string>>;
+
+  FromV8ValueState(bool skip_cycle_check, bool avoid_identity_hash_for_testing)
       : max_recursion_depth_(kMaxRecursionDepth),
+        skip_cycle_check_(skip_cycle_check),
         avoid_identity_hash_for_testing_(avoid_identity_hash_for_testing) {}
 
   // If |handle| is not in |unique_map_|, then add it to |unique_map_| and
@@ -57,6 +63,8 @@ class V8ValueConverterImpl::FromV8ValueState {
   // be unique even if there already is another handle with the same identity
   // hash (key) in the map, because two objects can have the same hash.
   bool AddToUniquenessCheck(v8::Local<v8::Object> handle) {
+    if (skip_cycle_check_)
+      return true;
     int hash;
     Iterator iter = GetIteratorInMap(handle, &hash);
     if (iter != unique_map_.end())
@@ -67,6 +75,8 @@ class V8ValueConverterImpl::FromV8ValueState {
   }
 
   bool RemoveFromUniquenessCheck(v8::Local<v8::Object> handle) {
+    if (skip_cycle_check_)
+      return true;
     int unused_hash;
     Iterator iter = GetIteratorInMap(handle, &unused_hash);
     if (iter == unique_map_.end())
@@ -79,6 +89,13 @@ class V8ValueConverterImpl::FromV8ValueState {
     return max_recursion_depth_ < 0;
   }
 
+  KeyCache* GetKeyCache() {
+    size_t depth = kMaxRecursionDepth - max_recursion_depth_;
+    if (key_caches_.size() <= depth)
+      key_caches_.resize(depth + 1);
+    return &key_caches_[depth];
+  }
+
  private:
   using HashToHandleMap = std::multimap<int, v8::Local<v8::Object>>;
   using Iterator = HashToHandleMap::const_iterator;
@@ -99,9 +116,12 @@ class V8ValueConverterImpl::FromV8ValueState {
   }
 
   HashToHandleMap unique_map_;
+  // Converting nested objects must not move the caches of outer objects.
+  std::deque<KeyCache> key_caches_;
 
   int max_recursion_depth_;
 
+  bool skip_cycle_check_;
   bool avoid_identity_hash_for_testing_;
 
   DISALLOW_COPY_AND_ASSIGN(FromV8ValueState);
@@ -147,6 +167,7 @@ V8ValueConverterImpl::V8ValueConverterImpl()
       function_allowed_(false),
       strip_null_from_objects_(false),
       convert_negative_zero_to_int_(false),
+      skip_cycle_check_(false),
       avoid_identity_hash_for_testing_(false) {}
 
 void V8ValueConverterImpl::SetDateAllowed(bool val) {
@@ -169,6 +190,10 @@ void V8ValueConverterImpl::SetConvertNegativeZeroToInt(bool val) {
   convert_negative_zero_to_int_ = val;
 }
 
+void V8ValueConverterImpl::SetSkipCycleCheck(bool val) {
+  skip_cycle_check_ = val;
+}
+
 v8::Local<v8::Value> V8ValueConverterImpl::ToV8Value(
     const base::Value* value, v8::Local<v8::Context> context) const {
   v8::Context::Scope context_scope(context);
@@ -182,7 +207,7 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Value(
     v8::Local<v8::Context> context) const {
   v8::Context::Scope context_scope(context);
   v8::HandleScope handle_scope(context->GetIsolate());
-  FromV8ValueState state(avoid_identity_hash_for_testing_);
+  FromV8ValueState state(skip_cycle_check_, avoid_identity_hash_for_testing_);
   return FromV8ValueImpl(&state, val, context->GetIsolate());
 }
 
@@ -318,31 +343,13 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8ValueImpl(
   if (state->HasReachedMaxRecursionDepth())
     return nullptr;
 
-  if (val->IsNull())
-    return std::make_unique<base::Value>();
-
-  if (val->IsBoolean())
-    return std::make_unique<base::Value>(val->ToBoolean(isolate)->Value());
+  base::Value primitive;
+  if (FromV8Primitive(val, isolate, &primitive))
+    return std::make_unique<base::Value>(std::move(primitive));
 
-  if (val->IsInt32())
-    return std::make_unique<base::Value>(val.As<v8::Int32>()->Value());
-
-  if (val->IsNumber()) {
-    double val_as_double = val.As<v8::Number>()->Value();
-    if (!std::isfinite(val_as_double))
-      return nullptr;
-    // Normally, this would be an integer, and fall into IsInt32(). But if the
-    // value is -0, it's treated internally as a double. Consumers are allowed
-    // to ignore this esoterica and treat it as an integer.
-    if (convert_negative_zero_to_int_ && val_as_double == 0.0)
-      return std::make_unique<base::Value>(0);
-    return std::make_unique<base::Value>(val_as_double);
-  }
-
-  if (val->IsString()) {
-    v8::String::Utf8Value utf8(isolate, val);
-    return std::make_unique<base::Value>(std::string(*utf8, utf8.length()));
-  }
+  // Only non-finite numbers are left.
+  if (val->IsNumber())
+    return nullptr;
 
   if (val->IsUndefined()) {
     // JSON.stringify ignores undefined.
@@ -386,6 +393,47 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8ValueImpl(
   return nullptr;
 }
 
+bool V8ValueConverterImpl::FromV8Primitive(v8::Local<v8::Value> val,
+                                           v8::Isolate* isolate,
+                                           base::Value* out) const {
+  if (val->IsNull()) {
+    *out = base::Value();
+    return true;
+  }
+
+  if (val->IsBoolean()) {
+    *out = base::Value(val->ToBoolean(isolate)->Value());
+    return true;
+  }
+
+  if (val->IsInt32()) {
+    *out = base::Value(val.As<v8::Int32>()->Value());
+    return true;
+  }
+
+  if (val->IsNumber()) {
+    double val_as_double = val.As<v8::Number>()->Value();
+    if (!std::isfinite(val_as_double))
+      return false;
+    // Normally, this would be an integer, and fall into IsInt32(). But if the
+    // value is -0, it's treated internally as a double. Consumers are allowed
+    // to ignore this esoterica and treat it as an integer.
+    if (convert_negative_zero_to_int_ && val_as_double == 0.0)
+      *out = base::Value(0);
+    else
+      *out = base::Value(val_as_double);
+    return true;
+  }
+
+  if (val->IsString()) {
+    v8::String::Utf8Value utf8(isolate, val);
+    *out = base::Value(std::string(*utf8, utf8.length()));
+    return true;
+  }
+
+  return false;
+}
+
 std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Array(
     v8::Local<v8::Array> val,
     FromV8ValueState* state,
@@ -401,35 +449,38 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Array(
       val->CreationContext() != isolate->GetCurrentContext())
     scope.reset(new v8::Context::Scope(val->CreationContext()));
 
-  std::unique_ptr<base::ListValue> result(new base::ListValue());
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  uint32_t length = val->Length();
+  base::Value::ListStorage storage;
+  storage.reserve(length);
 
   // Only fields with integer keys are carried over to the ListValue.
-  for (uint32_t i = 0; i < val->Length(); ++i) {
+  for (uint32_t i = 0; i < length; ++i) {
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8;
-    v8::MaybeLocal<v8::Value> maybe_child =
-        val->Get(isolate->GetCurrentContext(), i);
+    v8::MaybeLocal<v8::Value> maybe_child = val->Get(context, i);
     if (try_catch.HasCaught() || !maybe_child.ToLocal(&child_v8)) {
       LOG(ERROR) << "Getter for index " << i << " threw an exception.";
       child_v8 = v8::Null(isolate);
     }
 
-    if (!val->HasRealIndexedProperty(isolate->GetCurrentContext(), i)
-             .FromMaybe(false)) {
-      result->Append(std::make_unique<base::Value>());
+    // JSON.stringify puts null in places where values don't serialize, for
+    // example undefined and functions. Emulate that behavior.
+    storage.emplace_back();
+    if (!val->HasRealIndexedProperty(context, i).FromMaybe(false))
+      continue;
+
+    // Elements of table rows are usually primitives, convert them in place
+    // instead of allocating a Value for each of them.
+    if (FromV8Primitive(child_v8, isolate, &storage.back()))
       continue;
-    }
 
     std::unique_ptr<base::Value> child =
         FromV8ValueImpl(state, child_v8, isolate);
     if (child)
-      result->Append(std::move(child));
-    else
-      // JSON.stringify puts null in places where values don't serialize, for
-      // example undefined and functions. Emulate that behavior.
-      result->Append(std::make_unique<base::Value>());
+      storage.back() = std::move(*child);
   }
-  return std::move(result);
+  return std::make_unique<base::ListValue>(std::move(storage));
 }
 
 std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8ArrayBuffer(
@@ -442,7 +493,17 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8ArrayBuffer(
   } else if (val->IsArrayBufferView()) {
     v8::Local<v8::ArrayBufferView> view = val.As<v8::ArrayBufferView>();
     size_t byte_length = view->ByteLength();
-    std::vector<char> buffer(byte_length);
+    // Copy from the backing store directly, views without buffers are small
+    // typed arrays kept in the V8 heap and are read with CopyContents, which
+    // avoids materializing a buffer for them.
+    if (view->HasBuffer()) {
+      auto contents = view->Buffer()->GetContents();
+      const uint8_t* data =
+          static_cast<const uint8_t*>(contents.Data()) + view->ByteOffset();
+      return std::make_unique<base::Value>(
+          base::Value::BlobStorage(data, data + byte_length));
+    }
+    base::Value::BlobStorage buffer(byte_length);
     view->CopyContents(buffer.data(), buffer.size());
     return std::make_unique<base::Value>(std::move(buffer));
   } else {
@@ -482,16 +543,19 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Object(
   if (val->InternalFieldCount())
     return std::make_unique<base::DictionaryValue>();
 
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
   std::unique_ptr<base::DictionaryValue> result(new base::DictionaryValue());
   v8::Local<v8::Array> property_names;
-  if (!val->GetOwnPropertyNames(isolate->GetCurrentContext())
-           .ToLocal(&property_names)) {
+  if (!val->GetOwnPropertyNames(context).ToLocal(&property_names))
     return std::move(result);
-  }
 
-  for (uint32_t i = 0; i < property_names->Length(); ++i) {
-    v8::Local<v8::Value> key =
-        property_names->Get(isolate->GetCurrentContext(), i).ToLocalChecked();
+  FromV8ValueState::KeyCache* key_cache = state->GetKeyCache();
+  uint32_t length = property_names->Length();
+  if (key_cache->size() < length)
+    key_cache->resize(length);
+
+  for (uint32_t i = 0; i < length; ++i) {
+    v8::Local<v8::Value> key = property_names->Get(context, i).ToLocalChecked();
 
     // Extend this test to cover more types as necessary and if sensible.
     if (!key->IsString() &&
@@ -502,24 +566,34 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Object(
       continue;
     }
 
-    v8::String::Utf8Value name_utf8(isolate, key);
+    // Objects of the same shape, like rows of a table, have the same key
+    // strings in the same order, so the names are only converted once.
+    auto& cached = (*key_cache)[i];
+    if (cached.first != key) {
+      v8::String::Utf8Value name_utf8(isolate, key);
+      cached.first = key;
+      cached.second.assign(*name_utf8, name_utf8.length());
+    }
+    const std::string& name = cached.second;
 
     v8::TryCatch try_catch(isolate);
     v8::Local<v8::Value> child_v8;
-    v8::MaybeLocal<v8::Value> maybe_child =
-        val->Get(isolate->GetCurrentContext(), key);
+    v8::MaybeLocal<v8::Value> maybe_child = val->Get(context, key);
     if (try_catch.HasCaught() || !maybe_child.ToLocal(&child_v8)) {
-      LOG(ERROR) << "Getter for property " << *name_utf8
-                 << " threw an exception.";
+      LOG(ERROR) << "Getter for property " << name << " threw an exception.";
       child_v8 = v8::Null(isolate);
     }
 
-    std::unique_ptr<base::Value> child =
-        FromV8ValueImpl(state, child_v8, isolate);
-    if (!child)
-      // JSON.stringify skips properties whose values don't serialize, for
-      // example undefined and functions. Emulate that behavior.
-      continue;
+    base::Value child;
+    if (!FromV8Primitive(child_v8, isolate, &child)) {
+      std::unique_ptr<base::Value> converted =
+          FromV8ValueImpl(state, child_v8, isolate);
+      if (!converted)
+        // JSON.stringify skips properties whose values don't serialize, for
+        // example undefined and functions. Emulate that behavior.
+        continue;
+      child = std::move(*converted);
+    }
 
     // Strip null if asked (and since undefined is turned into null, undefined
     // too). The use case for supporting this is JSON-schema support,
@@ -541,11 +615,10 @@ std::unique_ptr<base::Value> V8ValueConverterImpl::FromV8Object(
     // there *is* a "windowId" property, but since it should be an int, code
     // on the browser which doesn't additionally check for null will fail.
     // We can avoid all bugs related to this by stripping null.
-    if (strip_null_from_objects_ && child->type() == base::Value::Type::NONE)
+    if (strip_null_from_objects_ && child.is_none())
       continue;
 
-    result->SetWithoutPathExpansion(std::string(*name_utf8, name_utf8.length()),
-                                    std::move(child));
+    result->SetKey(name, std::move(child));
   }
 
   return std::move(result);
@@ -30,6 +30,7 @@ class V8ValueConverterImpl : public V8ValueConverter {
   void SetFunctionAllowed(bool val) override;
   void SetStripNullFromObjects(bool val) override;
   void SetConvertNegativeZeroToInt(bool val) override;
+  void SetSkipCycleCheck(bool val) override;
   v8::Local<v8::Value> ToV8Value(
       const base::Value* value,
       v8::Local<v8::Context> context) const override;
@@ -58,6 +59,13 @@ class V8ValueConverterImpl : public V8ValueConverter {
   std::unique_ptr<base::Value> FromV8ValueImpl(FromV8ValueState* state,
                                                v8::Local<v8::Value> value,
                                                v8::Isolate* isolate) const;
+
+  // Convert null, booleans, finite numbers and strings into |out| without
+  // allocating, return false for other values.
+  bool FromV8Primitive(v8::Local<v8::Value> value,
+                       v8::Isolate* isolate,
+                       base::Value* out) const;
+
   std::unique_ptr<base::Value> FromV8Array(v8::Local<v8::Array> array,
                                            FromV8ValueState* state,
                                            v8::Isolate* isolate) const;
@@ -87,6 +95,9 @@ class V8ValueConverterImpl : public V8ValueConverter {
   // If true, convert -0 to an integer value (instead of a double).
   bool convert_negative_zero_to_int_;
 
+  // If true, objects are not checked for cycles when converting to Values.
+  bool skip_cycle_check_;
+
   bool avoid_identity_hash_for_testing_;
 
   DISALLOW_COPY_AND_ASSIGN(V8ValueConverterImpl);
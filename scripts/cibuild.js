@@ -32,6 +32,13 @@ if ((targetCpu == 'x64') || (targetOs == 'win' && targetCpu == 'x86')) {
 
 // Build common targets.
 execSync('node ./scripts/build.js out/Release')
+
+// Run benchmarks, which need no window manager and run wherever the unit
+// tests run, including virtual X servers on headless Linux machines.
+if (targetCpu == 'x64') {
+  execSync('node ./scripts/build.js out/Release nativeui_perftests')
+  execSync(`${path.join('out', 'Release', 'nativeui_perftests')}`)
+}
 execSync('node ./scripts/build.js out/Debug')
 execSync('node scripts/create_dist.js')
 
@@ -0,0 +1,30 @@
+#!/usr/bin/env node
+
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+const {argv, targetCpu, targetOs, execSync, spawnSync} = require('./common')
+const {gnConfig, gnSysrootConfig} = require('./config')
+
+const path = require('path')
+
+// Build the node module with benchmark hooks for current Node.js, which is
+// otherwise the same with the Release build.
+const args = gnConfig.concat([
+  `node_version="${process.version}"`,
+  'node_yue_benchmark=true',
+  'is_component_build=false',
+  'is_debug=false',
+  'is_official_build=true',
+])
+if (targetOs == 'linux')
+  args.push(...gnSysrootConfig)
+
+execSync(`node ./scripts/download_node_headers.js node ${process.version} ${targetOs} ${targetCpu}`)
+spawnSync('gn', ['gen', 'out/Benchmark', `--args=${args.join(' ')}`])
+execSync('ninja -C out/Benchmark node_yue')
+
+// Run the benchmarks, the arguments are passed as filter.
+const module = path.join('out', 'Benchmark', 'gui.node')
+execSync(`node node_yue/benchmark/run.js ${module} ${argv.join(' ')}`)
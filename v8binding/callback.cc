@@ -4,6 +4,7 @@
 
 #include "v8binding/callback.h"
 
+#include "base/no_destructor.h"
 #include "base/notreached.h"
 #include "base/time/time.h"
 
@@ -11,8 +12,61 @@ namespace vb {
 
 namespace internal {
 
+namespace {
+
+using CallStatsMap = std::map<std::string, CallStats>;
+
+// The counters are never removed so holders can keep pointers to them.
+CallStatsMap& GetCallStatsMap() {
+  static base::NoDestructor<CallStatsMap> call_stats;
+  return *call_stats;
+}
+
+const char* g_call_stats_class = nullptr;
+const std::string* g_call_stats_name = nullptr;
+
+}  // namespace
+
+bool g_call_stats_enabled = false;
+
+CallStats* GetCallStatsEntry(const std::string& name) {
+  return &GetCallStatsMap()[name];
+}
+
+std::string QualifyCallStatsName(const char* key) {
+  if (!g_call_stats_class)
+    return key;
+  return std::string(g_call_stats_class) + "." + key;
+}
+
+ScopedCallStatsClass::ScopedCallStatsClass(const char* name)
+    : previous_(g_call_stats_class) {
+  g_call_stats_class = name;
+}
+
+ScopedCallStatsClass::~ScopedCallStatsClass() {
+  g_call_stats_class = previous_;
+}
+
+ScopedCallStatsName::ScopedCallStatsName(const std::string& name)
+    : previous_(g_call_stats_name) {
+  g_call_stats_name = &name;
+}
+
+ScopedCallStatsName::~ScopedCallStatsName() {
+  g_call_stats_name = previous_;
+}
+
 #ifndef NDEBUG
+namespace {
+
+int g_allow_function_template = 0;
+
+}  // namespace
+
 void FunctionTemplateCreated() {
+  if (g_allow_function_template > 0)
+    return;
   static base::Time first_time;
   if (first_time.is_null())
     first_time = base::Time::Now();
@@ -20,10 +74,20 @@ void FunctionTemplateCreated() {
     NOTREACHED() << "Creating FunctionTemplate after program has started for a "
                     "while, it is very likely we are leaking FunctionTemplate.";
 }
+
+ScopedAllowFunctionTemplate::ScopedAllowFunctionTemplate() {
+  ++g_allow_function_template;
+}
+
+ScopedAllowFunctionTemplate::~ScopedAllowFunctionTemplate() {
+  --g_allow_function_template;
+}
 #endif
 
 CallbackHolderBase::CallbackHolderBase(v8::Isolate* isolate)
-    : v8_ref_(isolate, v8::External::New(isolate, this)) {
+    : v8_ref_(isolate, v8::External::New(isolate, this)),
+      stats_(GetCallStatsEntry(g_call_stats_name ? *g_call_stats_name
+                                                 : "(anonymous)")) {
   v8_ref_.SetWeak(this, &CallbackHolderBase::FirstWeakCallback,
                   v8::WeakCallbackType::kParameter);
 }
@@ -65,4 +129,22 @@ v8::Local<v8::Function> V8FunctionWrapper::Get(v8::Isolate* isolate) const {
 
 }  // namespace internal
 
+void SetCallStatsEnabled(bool enabled) {
+  internal::g_call_stats_enabled = enabled;
+}
+
+std::map<std::string, CallStats> GetCallStats() {
+  std::map<std::string, CallStats> result;
+  for (const auto& it : internal::GetCallStatsMap()) {
+    if (it.second.calls > 0)
+      result.emplace(it.first, it.second);
+  }
+  return result;
+}
+
+void ResetCallStats() {
+  for (auto& it : internal::GetCallStatsMap())
+    it.second = CallStats();
+}
+
 }  // namespace vb
@@ -5,13 +5,26 @@
 #ifndef V8BINDING_CALLBACK_H_
 #define V8BINDING_CALLBACK_H_
 
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "v8binding/callback_internal.h"
 
 namespace vb {
 
+// Enable counting the calls into bound native functions, which is off by
+// default. The counters are shared by all isolates and must only be used on
+// the main thread.
+void SetCallStatsEnabled(bool enabled);
+
+// Return the counters of called functions, keyed by names like "View.focus".
+std::map<std::string, CallStats> GetCallStats();
+
+// Reset all counters to zero.
+void ResetCallStats();
+
 // CreateFunctionTemplate creates a v8::FunctionTemplate that will create
 // JavaScript functions that execute a provided C++ function or std::function.
 // JavaScript arguments are automatically converted via Type<T>, as is
@@ -7,9 +7,11 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "base/time/time.h"
 #include "node.h"  // NOLINT(build/include)
 #include "v8binding/arguments.h"
 #include "v8binding/locker.h"
@@ -32,6 +34,16 @@ struct Type<Arguments*> {
   static constexpr const char* name = "Arguments";
 };
 
+// Counters of the calls into a bound native function.
+struct CallStats {
+  uint64_t calls = 0;
+  // Time spent on converting arguments from JavaScript.
+  base::TimeDelta convert_time;
+  // Time spent in the native function, including converting its result and
+  // the JavaScript code it calls.
+  base::TimeDelta native_time;
+};
+
 namespace internal {
 
 template<typename T>
@@ -54,8 +66,58 @@ struct CallbackParamTraits<const T*> {
 #ifndef NDEBUG
 // Counting the function template created to avoid leaking.
 void FunctionTemplateCreated();
+
+// Templates of prototypes and constructors are created on first use and kept
+// for the lifetime of isolate, so creating them late is not a leak.
+class ScopedAllowFunctionTemplate {
+ public:
+  ScopedAllowFunctionTemplate();
+  ~ScopedAllowFunctionTemplate();
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ScopedAllowFunctionTemplate);
+};
 #endif
 
+// Whether calls into bound functions are counted.
+extern bool g_call_stats_enabled;
+
+// Return the counters of function |name|, which live as long as the process.
+CallStats* GetCallStatsEntry(const std::string& name);
+
+// Return |key| prefixed with the name of the class being built.
+std::string QualifyCallStatsName(const char* key);
+
+inline const char* CallStatsKey(const char* key) { return key; }
+inline const char* CallStatsKey(const std::string& key) { return key.c_str(); }
+template<typename T>
+inline const char* CallStatsKey(const T& key) { return "(anonymous)"; }
+
+// Functions added to the prototype and constructor of a class in this scope
+// are reported as "Class.method" in call stats.
+class ScopedCallStatsClass {
+ public:
+  explicit ScopedCallStatsClass(const char* name);
+  ~ScopedCallStatsClass();
+
+ private:
+  const char* previous_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedCallStatsClass);
+};
+
+// Functions created in this scope are reported as |name| in call stats.
+class ScopedCallStatsName {
+ public:
+  explicit ScopedCallStatsName(const std::string& name);
+  ~ScopedCallStatsName();
+
+ private:
+  const std::string* previous_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedCallStatsName);
+};
+
 // CallbackHolder and CallbackHolderBase are used to pass a std::function from
 // CreateFunctionTemplate through v8 (via v8::FunctionTemplate) to
 // DispatchToCallback, where it is invoked.
@@ -66,6 +128,12 @@ class CallbackHolderBase {
  public:
   v8::Local<v8::External> GetHandle(v8::Isolate* isolate);
 
+  void RecordCall(base::TimeDelta convert_time, base::TimeDelta native_time) {
+    stats_->calls++;
+    stats_->convert_time += convert_time;
+    stats_->native_time += native_time;
+  }
+
  protected:
   explicit CallbackHolderBase(v8::Isolate* isolate);
   virtual ~CallbackHolderBase();
@@ -77,6 +145,7 @@ class CallbackHolderBase {
       const v8::WeakCallbackInfo<CallbackHolderBase>& data);
 
   v8::Global<v8::External> v8_ref_;
+  CallStats* stats_;
 
   DISALLOW_COPY_AND_ASSIGN(CallbackHolderBase);
 };
@@ -213,19 +282,35 @@ struct Dispatcher {};
 
 template<typename ReturnType, typename... ArgTypes>
 struct Dispatcher<ReturnType(ArgTypes...)> {
+  using HolderT = CallbackHolder<ReturnType(ArgTypes...)>;
+  using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
+
   static void DispatchToCallback(
       const v8::FunctionCallbackInfo<v8::Value>& info) {
     Arguments args(info);
     v8::Local<v8::External> v8_holder;
     args.GetData(&v8_holder);
-    typedef CallbackHolder<ReturnType(ArgTypes...)> HolderT;
     HolderT* holder = static_cast<HolderT*>(v8_holder->Value());
 
-    using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
+    if (g_call_stats_enabled) {
+      DispatchWithStats(&args, holder);
+      return;
+    }
     Invoker<Indices, ArgTypes...> invoker(&args, holder->flags);
     if (invoker.IsOK())
       invoker.DispatchToCallback(holder->callback);
   }
+
+  // Measure the time of converting arguments and running the callback.
+  static void DispatchWithStats(Arguments* args, HolderT* holder) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    Invoker<Indices, ArgTypes...> invoker(args, holder->flags);
+    if (!invoker.IsOK())
+      return;
+    base::TimeTicks converted = base::TimeTicks::Now();
+    invoker.DispatchToCallback(holder->callback);
+    holder->RecordCall(converted - start, base::TimeTicks::Now() - converted);
+  }
 };
 
 // A RefCounted struct that stores a v8::Function.
@@ -264,7 +349,9 @@ struct V8FunctionInvoker<v8::Local<v8::Value>(ArgTypes...)> {
       return v8::Null(isolate);
     }
     auto context = func->CreationContext();
-    std::vector<v8::Local<v8::Value>> args = { ToV8(context, raw)... };
+    // Arguments are moved so buffers can be transferred without copying.
+    std::vector<v8::Local<v8::Value>> args = {
+        ToV8(context, std::move(raw))... };
     v8::MaybeLocal<v8::Value> val = node::MakeCallback(
         isolate, func, func,
         static_cast<int>(args.size()),
@@ -292,7 +379,8 @@ struct V8FunctionInvoker<void(ArgTypes...)> {
       return;
     }
     auto context = func->CreationContext();
-    std::vector<v8::Local<v8::Value>> args = { ToV8(context, raw)... };
+    std::vector<v8::Local<v8::Value>> args = {
+        ToV8(context, std::move(raw))... };
     node::MakeCallback(isolate, func, func,
                        static_cast<int>(args.size()),
                        args.empty() ? nullptr: &args.front(),
@@ -316,7 +404,8 @@ struct V8FunctionInvoker<ReturnType(ArgTypes...)> {
       return ret;
     }
     auto context = func->CreationContext();
-    std::vector<v8::Local<v8::Value>> args = { ToV8(context, raw)... };
+    std::vector<v8::Local<v8::Value>> args = {
+        ToV8(context, std::move(raw))... };
     v8::MaybeLocal<v8::Value> val = node::MakeCallback(
         isolate, func, func,
         static_cast<int>(args.size()),
@@ -4,10 +4,44 @@
 
 #include "v8binding/dict.h"
 
+#include <utility>
+
 #include "base/strings/string_number_conversions.h"
 
 namespace vb {
 
+namespace internal {
+
+LazyFunctionBase::LazyFunctionBase(std::string name)
+    : name_(std::move(name)) {}
+
+LazyFunctionBase::~LazyFunctionBase() {}
+
+v8::Local<v8::FunctionTemplate> LazyFunctionBase::GetTemplate(
+    v8::Local<v8::Context> context) {
+  v8::Isolate* isolate = context->GetIsolate();
+  if (templ_.IsEmpty()) {
+#ifndef NDEBUG
+    ScopedAllowFunctionTemplate allow_function_template;
+#endif
+    ScopedCallStatsName scoped_name(name_);
+    templ_.Set(isolate, Create(context));
+  }
+  return templ_.Get(isolate);
+}
+
+void LazyFunctionGetter(v8::Local<v8::Name> property,
+                        const v8::PropertyCallbackInfo<v8::Value>& info) {
+  auto* function = static_cast<LazyFunctionBase*>(
+      info.Data().As<v8::External>()->Value());
+  v8::Local<v8::Context> context = info.GetIsolate()->GetCurrentContext();
+  v8::Local<v8::Function> result;
+  if (function->GetTemplate(context)->GetFunction(context).ToLocal(&result))
+    info.GetReturnValue().Set(result);
+}
+
+}  // namespace internal
+
 v8::Local<v8::Map> GetAttachedTable(v8::Local<v8::Context> context,
                                     v8::Local<v8::Object> object,
                                     const base::StringPiece& key_str) {
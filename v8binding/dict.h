@@ -5,6 +5,9 @@
 #ifndef V8BINDING_DICT_H_
 #define V8BINDING_DICT_H_
 
+#include <string>
+#include <utility>
+
 #include "v8binding/ref_method.h"
 
 namespace vb {
@@ -20,12 +23,21 @@ struct ToV8Data {
   }
 };
 
+// Whether the type is converted to a FunctionTemplate.
+template<typename T, typename Enable = void>
+struct IsFunctionData : std::false_type {};
+
 // Specialize for native functions.
 template<typename T>
+struct IsFunctionData<T, typename std::enable_if<
+                             internal::is_function_pointer<T>::value ||
+                             std::is_member_function_pointer<T>::value>::type>
+    : std::true_type {};
+template<typename T>
 struct ToV8Data<T, typename std::enable_if<
                        internal::is_function_pointer<T>::value>::type> {
-  static inline v8::Local<v8::Data> Do(v8::Local<v8::Context> context,
-                                       T callback) {
+  static inline v8::Local<v8::FunctionTemplate> Do(
+      v8::Local<v8::Context> context, T callback) {
     using RunType = typename FunctorTraits<T>::RunType;
     return CreateFunctionTemplate(context, std::function<RunType>(callback));
   }
@@ -35,8 +47,8 @@ struct ToV8Data<T, typename std::enable_if<
 template<typename T>
 struct ToV8Data<T, typename std::enable_if<
                        std::is_member_function_pointer<T>::value>::type> {
-  static inline v8::Local<v8::Data> Do(v8::Local<v8::Context> context,
-                                       T callback) {
+  static inline v8::Local<v8::FunctionTemplate> Do(
+      v8::Local<v8::Context> context, T callback) {
     using RunType = typename FunctorTraits<T>::RunType;
     return CreateFunctionTemplate(context, std::function<RunType>(callback),
                                   HolderIsFirstArgument);
@@ -45,11 +57,13 @@ struct ToV8Data<T, typename std::enable_if<
 
 // Specialize for ref method.
 template<typename T>
+struct IsFunctionData<RefMethodRef<T>> : std::true_type {};
+template<typename T>
 struct ToV8Data<RefMethodRef<T>,
                 typename std::enable_if<
                     std::is_member_function_pointer<T>::value>::type> {
-  static inline v8::Local<v8::Data> Do(v8::Local<v8::Context> context,
-                                       const RefMethodRef<T>& callback) {
+  static inline v8::Local<v8::FunctionTemplate> Do(
+      v8::Local<v8::Context> context, const RefMethodRef<T>& callback) {
 #ifndef NDEBUG
     internal::FunctionTemplateCreated();
 #endif
@@ -62,26 +76,101 @@ struct ToV8Data<RefMethodRef<T>,
   }
 };
 
+// Creates the FunctionTemplate of a member on first access of the member.
+// It is kept for the lifetime of isolate, like the template that owns it.
+class LazyFunctionBase {
+ public:
+  v8::Local<v8::FunctionTemplate> GetTemplate(v8::Local<v8::Context> context);
+
+ protected:
+  explicit LazyFunctionBase(std::string name);
+  virtual ~LazyFunctionBase();
+
+  virtual v8::Local<v8::FunctionTemplate> Create(
+      v8::Local<v8::Context> context) = 0;
+
+ private:
+  // The name used in call stats.
+  std::string name_;
+  v8::Eternal<v8::FunctionTemplate> templ_;
+
+  DISALLOW_COPY_AND_ASSIGN(LazyFunctionBase);
+};
+
+template<typename T>
+class LazyFunction : public LazyFunctionBase {
+ public:
+  LazyFunction(std::string name, const T& value)
+      : LazyFunctionBase(std::move(name)), value_(value) {}
+
+ protected:
+  v8::Local<v8::FunctionTemplate> Create(
+      v8::Local<v8::Context> context) override {
+    return ToV8Data<T>::Do(context, value_);
+  }
+
+ private:
+  T value_;
+};
+
+// The getter of lazy members, which has a LazyFunctionBase as data.
+void LazyFunctionGetter(v8::Local<v8::Name> property,
+                        const v8::PropertyCallbackInfo<v8::Value>& info);
+
 }  // namespace internal
 
 // Helper for setting Object.
 template<typename Key, typename Value>
-inline bool Set(v8::Local<v8::Context> context, v8::Local<v8::Object> object,
-                const Key& key, const Value& value) {
+inline typename std::enable_if<!internal::IsFunctionData<Value>::value,
+                               bool>::type
+Set(v8::Local<v8::Context> context, v8::Local<v8::Object> object,
+    const Key& key, const Value& value) {
+  auto result = object->Set(context, ToV8(context, key), ToV8(context, value));
+  return !result.IsNothing() && result.FromJust();
+}
+
+// Functions are reported under their keys in call stats.
+template<typename Key, typename Value>
+inline typename std::enable_if<internal::IsFunctionData<Value>::value,
+                               bool>::type
+Set(v8::Local<v8::Context> context, v8::Local<v8::Object> object,
+    const Key& key, const Value& value) {
+  std::string name =
+      internal::QualifyCallStatsName(internal::CallStatsKey(key));
+  internal::ScopedCallStatsName scoped_name(name);
   auto result = object->Set(context, ToV8(context, key), ToV8(context, value));
   return !result.IsNothing() && result.FromJust();
 }
 
 // Helper for setting ObjectTemplate.
 template<typename Key, typename Value>
-inline bool Set(v8::Local<v8::Context> context,
-                v8::Local<v8::ObjectTemplate> templ,
-                const Key& key, const Value& value) {
+inline typename std::enable_if<!internal::IsFunctionData<Value>::value,
+                               bool>::type
+Set(v8::Local<v8::Context> context,
+    v8::Local<v8::ObjectTemplate> templ,
+    const Key& key, const Value& value) {
   templ->Set(ToV8(context, key).template As<v8::String>(),
              internal::ToV8Data<Value>::Do(context, value));
   return true;
 }
 
+// Functions are created on first access, so building a prototype does not
+// create templates for all of its methods.
+template<typename Key, typename Value>
+inline typename std::enable_if<internal::IsFunctionData<Value>::value,
+                               bool>::type
+Set(v8::Local<v8::Context> context,
+    v8::Local<v8::ObjectTemplate> templ,
+    const Key& key, const Value& value) {
+  v8::Isolate* isolate = context->GetIsolate();
+  auto* function = new internal::LazyFunction<Value>(
+      internal::QualifyCallStatsName(internal::CallStatsKey(key)), value);
+  templ->SetLazyDataProperty(ToV8(context, key).template As<v8::String>(),
+                             &internal::LazyFunctionGetter,
+                             v8::External::New(isolate, function));
+  return true;
+}
+
 // Allow setting arbitrary key/value pairs.
 template<typename Dict, typename Key, typename Value, typename... ArgTypes>
 inline bool Set(v8::Local<v8::Context> context, Dict dict,
@@ -0,0 +1,110 @@
+// Copyright 2020 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef V8BINDING_FAST_METHOD_H_
+#define V8BINDING_FAST_METHOD_H_
+
+#include <type_traits>
+
+#include "v8binding/dict.h"
+#include "v8binding/prototype.h"
+
+// V8 Fast API calls let optimized code call C++ functions directly, without
+// going through the callback trampoline and converting arguments.
+#if V8_MAJOR_VERSION >= 10
+#define V8BINDING_FAST_API_CALLS
+#include "v8-fast-api-calls.h"  // NOLINT(build/include)
+#endif
+
+namespace vb {
+
+namespace internal {
+
+// Helper class to store the method as template parameter.
+template<typename T, T method>
+struct FastMethodRef {};
+
+// Get the native object of |obj|, whose type has been checked by signature.
+template<typename T, typename Enable = void>
+struct InternalField {
+  static inline T* Get(v8::Local<v8::Object> obj) {
+    return static_cast<T*>(obj->GetAlignedPointerFromInternalField(0));
+  }
+};
+
+template<typename T>
+struct InternalField<T, typename std::enable_if<std::is_base_of<
+                            base::internal::WeakPtrBase,
+                            decltype(((T*)nullptr)->GetWeakPtr())>::value>::type> {  // NOLINT
+  static inline T* Get(v8::Local<v8::Object> obj) {
+    auto* tracker = static_cast<WeakPtrObjectTracker<T>*>(
+        obj->GetAlignedPointerFromInternalField(0));
+    return tracker ? tracker->Get() : nullptr;
+  }
+};
+
+template<typename T>
+struct FastMethodTraits {};
+
+template<typename T, typename ReturnType, typename... ArgTypes>
+struct FastMethodTraits<ReturnType(T::*)(ArgTypes...)> {
+  using Class = T;
+
+  // The fast path called by optimized code.
+  template<ReturnType(T::*method)(ArgTypes...)>
+  static ReturnType Call(v8::Local<v8::Object> receiver, ArgTypes... args) {
+    T* self = InternalField<T>::Get(receiver);
+    if (!self)
+      return ReturnType();
+    return (self->*method)(args...);
+  }
+};
+
+template<typename T, T method>
+struct IsFunctionData<FastMethodRef<T, method>> : std::true_type {};
+
+// Create a FunctionTemplate with both the slow callback and the fast path.
+template<typename T, T method>
+struct ToV8Data<FastMethodRef<T, method>> {
+  static inline v8::Local<v8::FunctionTemplate> Do(
+      v8::Local<v8::Context> context, const FastMethodRef<T, method>&) {
+    using RunType = typename FunctorTraits<T>::RunType;
+#if defined(V8BINDING_FAST_API_CALLS)
+#ifndef NDEBUG
+    internal::FunctionTemplateCreated();
+#endif
+    using Traits = FastMethodTraits<T>;
+    static const v8::CFunction c_function =
+        v8::CFunction::Make(&Traits::template Call<method>);
+    v8::Isolate* isolate = context->GetIsolate();
+    auto* holder = new CallbackHolder<RunType>(
+        isolate, std::function<RunType>(method), HolderIsFirstArgument);
+    // The signature makes V8 check the receiver, so the fast path can read
+    // the native object directly.
+    auto signature = v8::Signature::New(
+        isolate, InheritanceChain<typename Traits::Class>::Get(context));
+    v8::Local<v8::FunctionTemplate> tmpl = v8::FunctionTemplate::New(
+        isolate, &Dispatcher<RunType>::DispatchToCallback,
+        holder->GetHandle(isolate), signature, 0,
+        v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+        &c_function);
+    return tmpl;
+#else
+    return CreateFunctionTemplate(context, std::function<RunType>(method),
+                                  HolderIsFirstArgument);
+#endif
+  }
+};
+
+}  // namespace internal
+
+}  // namespace vb
+
+// Bind a method with V8's fast API calls when available, the method must only
+// take arguments of primitive types and must not call into JavaScript, for
+// example by emitting signals.
+#define VB_FAST_METHOD(method) \
+    vb::internal::FastMethodRef<decltype(method), method>()
+
+#endif  // V8BINDING_FAST_METHOD_H_
@@ -4,7 +4,10 @@
 
 #include "v8binding/per_isolate_data.h"
 
+#include <atomic>
+
 #include "base/check.h"
+#include "v8binding/prototype_internal.h"
 
 // The slot 3 had been reserved for Node, but since it is not using the slot
 // after Node v7, we are free to take it.
@@ -24,6 +27,12 @@ PerIsolateData* PerIsolateData::Get(v8::Isolate* isolate) {
   return static_cast<PerIsolateData*>(data);
 }
 
+// static
+size_t PerIsolateData::NewTemplateSlot() {
+  static std::atomic<size_t> next_slot(0);
+  return next_slot++;
+}
+
 PerIsolateData::PerIsolateData(v8::Isolate* isolate)
     : isolate_(isolate) {
 }
@@ -32,26 +41,29 @@ PerIsolateData::~PerIsolateData() {
   // This class is simply leaked.
 }
 
-void PerIsolateData::SetFunctionTemplate(void* key,
+void PerIsolateData::SetFunctionTemplate(size_t slot,
                                          v8::Local<v8::FunctionTemplate> tmpl) {
-  function_templates_[key] = v8::Eternal<v8::FunctionTemplate>(isolate_, tmpl);
+  if (slot >= function_templates_.size())
+    function_templates_.resize(slot + 1);
+  function_templates_[slot].Set(isolate_, tmpl);
 }
 
-v8::Local<v8::FunctionTemplate> PerIsolateData::GetFunctionTemplate(void* key) {
-  auto it = function_templates_.find(key);
-  if (it == function_templates_.end())
+v8::Local<v8::FunctionTemplate> PerIsolateData::GetFunctionTemplate(
+    size_t slot) {
+  if (slot >= function_templates_.size() ||
+      function_templates_[slot].IsEmpty())
     return v8::Local<v8::FunctionTemplate>();
-  return it->second.Get(isolate_);
+  return function_templates_[slot].Get(isolate_);
 }
 
 void PerIsolateData::SetObjectTracker(void* ptr,
                                       internal::ObjectTracker* wrapper) {
-  DCHECK(object_trackers_.find(ptr) == object_trackers_.end() ||
-         wrapper == nullptr);
-  if (wrapper)
-    object_trackers_[ptr] = wrapper;
-  else
+  if (wrapper) {
+    bool inserted = object_trackers_.emplace(ptr, wrapper).second;
+    DCHECK(inserted);
+  } else {
     object_trackers_.erase(ptr);
+  }
 }
 
 internal::ObjectTracker* PerIsolateData::GetObjectTracker(void* ptr) {
@@ -61,4 +73,15 @@ internal::ObjectTracker* PerIsolateData::GetObjectTracker(void* ptr) {
   return it->second;
 }
 
+std::map<std::string, ObjectStats> PerIsolateData::GetObjectStats() const {
+  std::map<std::string, ObjectStats> stats;
+  for (const auto& it : object_trackers_) {
+    ObjectStats& entry = stats[it.second->GetTypeName()];
+    entry.count++;
+    if (it.second->HasOneRef())
+      entry.retained_by_wrapper++;
+  }
+  return stats;
+}
+
 }  // namespace vb
@@ -5,7 +5,10 @@
 #ifndef V8BINDING_PER_ISOLATE_DATA_H_
 #define V8BINDING_PER_ISOLATE_DATA_H_
 
+#include <map>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "base/macros.h"
 #include "v8.h"  // NOLINT(build/include)
@@ -16,31 +19,44 @@ namespace internal {
 class ObjectTracker;
 }
 
+// Statistics of the live wrappers of a native class.
+struct ObjectStats {
+  uint32_t count = 0;
+  // The native objects that are only kept alive by their wrappers.
+  uint32_t retained_by_wrapper = 0;
+};
+
 class PerIsolateData {
  public:
   static PerIsolateData* Get(v8::Isolate* isolate);
 
+  // Return a new slot for caching a template, each type takes one slot when
+  // it is first used, and the slot is valid for all isolates.
+  static size_t NewTemplateSlot();
+
   // Cache template objects.
-  void SetFunctionTemplate(void* key,
+  void SetFunctionTemplate(size_t slot,
                            v8::Local<v8::FunctionTemplate> function_template);
-  v8::Local<v8::FunctionTemplate> GetFunctionTemplate(void* key);
+  v8::Local<v8::FunctionTemplate> GetFunctionTemplate(size_t slot);
 
   // Cache RefPtr wrappers.
   void SetObjectTracker(void* ptr, internal::ObjectTracker* wrapper);
   internal::ObjectTracker* GetObjectTracker(void* ptr);
 
+  // Return the stats of live RefPtr wrappers, keyed by class names.
+  std::map<std::string, ObjectStats> GetObjectStats() const;
+
  protected:
   explicit PerIsolateData(v8::Isolate* isolate);
   ~PerIsolateData();
 
  private:
-  using FunctionTemplateMap =
-      std::unordered_map<void*, v8::Eternal<v8::FunctionTemplate>>;
   using ObjectTrackerMap =
       std::unordered_map<void*, internal::ObjectTracker*>;
 
   v8::Isolate* isolate_;
-  FunctionTemplateMap function_templates_;
+  // Indexed by the slots of types.
+  std::vector<v8::Eternal<v8::FunctionTemplate>> function_templates_;
   ObjectTrackerMap object_trackers_;
 
   DISALLOW_COPY_AND_ASSIGN(PerIsolateData);
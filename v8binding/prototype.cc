@@ -49,13 +49,13 @@ void ObjectTracker::WeakCallback(
 
 bool GetOrCreateFunctionTemplate(
     v8::Isolate* isolate,
-    void* key,
+    size_t slot,
     v8::Local<v8::FunctionTemplate>* templ) {
   auto* per_isolate_data = PerIsolateData::Get(isolate);
-  *templ = per_isolate_data->GetFunctionTemplate(key);
+  *templ = per_isolate_data->GetFunctionTemplate(slot);
   if (templ->IsEmpty()) {
     *templ = v8::FunctionTemplate::New(isolate, &DefaultConstructor);
-    per_isolate_data->SetFunctionTemplate(key, *templ);
+    per_isolate_data->SetFunctionTemplate(slot, *templ);
     return false;
   } else {
     return true;
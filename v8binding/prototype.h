@@ -25,12 +25,42 @@ inline v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
   // Build the constructor if we did not do it before.
   auto indicator = v8::Private::ForApi(isolate, ToV8Symbol(context, "vbb"));
   if (!constructor->HasPrivate(context, indicator).ToChecked()) {
+#ifndef NDEBUG
+    internal::ScopedAllowFunctionTemplate allow_function_template;
+#endif
     constructor->SetPrivate(context, indicator, v8::True(isolate));
+    internal::ScopedCallStatsClass scoped_class(Type<T>::name);
     Type<T>::BuildConstructor(context, constructor);
   }
   return constructor;
 }
 
+// Like Constructor, but when set on an object the constructor is only created
+// on first access, so types that are never used do not build their templates.
+template<typename T>
+struct LazyConstructor {
+};
+
+namespace internal {
+
+template<typename T>
+void LazyConstructorGetter(v8::Local<v8::Name> property,
+                           const v8::PropertyCallbackInfo<v8::Value>& info) {
+  v8::Local<v8::Context> context = info.GetIsolate()->GetCurrentContext();
+  info.GetReturnValue().Set(ToV8(context, Constructor<T>()));
+}
+
+}  // namespace internal
+
+template<typename Key, typename T>
+inline bool Set(v8::Local<v8::Context> context, v8::Local<v8::Object> object,
+                const Key& key, LazyConstructor<T>) {
+  auto result = object->SetLazyDataProperty(
+      context, ToV8(context, key).template As<v8::Name>(),
+      &internal::LazyConstructorGetter<T>);
+  return !result.IsNothing() && result.FromJust();
+}
+
 // Create a new instance of v8::Object from the prototype of T.
 template<typename T>
 v8::MaybeLocal<v8::Object> CallConstructor(v8::Local<v8::Context> context) {
@@ -7,6 +7,7 @@
 
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "v8binding/callback_internal.h"
 #include "v8binding/per_isolate_data.h"
 #include "v8binding/types.h"
 
@@ -23,6 +24,10 @@ class ObjectTracker {
   v8::Local<v8::Object> GetHandle() const;
   v8::Isolate* GetIsolate() const;
 
+  // Used for reporting the live objects.
+  virtual const char* GetTypeName() const = 0;
+  virtual bool HasOneRef() const = 0;
+
  private:
   static void WeakCallback(const v8::WeakCallbackInfo<ObjectTracker>& data);
 
@@ -48,6 +53,10 @@ class RefPtrObjectTracker : public ObjectTracker {
     ptr_->Release();
   }
 
+  // ObjectTracker:
+  const char* GetTypeName() const override { return Type<T>::name; }
+  bool HasOneRef() const override { return ptr_->HasOneRef(); }
+
  private:
   T* ptr_;
 };
@@ -66,15 +75,19 @@ class WeakPtrObjectTracker : public ObjectTracker {
     return ptr_.get();
   }
 
+  // ObjectTracker:
+  const char* GetTypeName() const override { return Type<T>::name; }
+  bool HasOneRef() const override { return false; }
+
  private:
   base::WeakPtr<T> ptr_;
 };
 
 
-// Get or create FunctionTemplate, returns true if the |name| exists.
+// Get or create FunctionTemplate in |slot|, returns true if it exists.
 bool GetOrCreateFunctionTemplate(
     v8::Isolate* isolate,
-    void* key,
+    size_t slot,
     v8::Local<v8::FunctionTemplate>* templ);
 
 // Get populated prototype for T.
@@ -83,13 +96,17 @@ bool GetOrCreatePrototype(
     v8::Local<v8::Context> context,
     const char* name,
     v8::Local<v8::FunctionTemplate>* templ) {
-  // Each type would get its own storage of |key| variable, and we use its
-  // address as the key to the type's FunctionTemplate.
-  static int key = 0xFEE;
-  if (GetOrCreateFunctionTemplate(context->GetIsolate(), &key, templ))
+  // Each type gets its own slot to store the FunctionTemplate, so looking up
+  // the template is only indexing a vector.
+  static const size_t slot = PerIsolateData::NewTemplateSlot();
+  if (GetOrCreateFunctionTemplate(context->GetIsolate(), slot, templ))
     return true;
   (*templ)->SetClassName(ToV8(context, name).As<v8::String>());
   (*templ)->InstanceTemplate()->SetInternalFieldCount(1);
+#ifndef NDEBUG
+  ScopedAllowFunctionTemplate allow_function_template;
+#endif
+  ScopedCallStatsClass scoped_class(name);
   Type<T>::BuildPrototype(context, (*templ)->PrototypeTemplate());
   return false;
 }
@@ -82,6 +82,23 @@ struct Type<float> {
   }
 };
 
+template<>
+struct Type<double> {
+  static constexpr const char* name = "Number";
+  static inline v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
+                                          double value) {
+    return v8::Number::New(context->GetIsolate(), value);
+  }
+  static bool FromV8(v8::Local<v8::Context> context,
+                     v8::Local<v8::Value> value,
+                     double* out) {
+    if (!value->IsNumber())
+      return false;
+    *out = value->NumberValue(context).ToChecked();
+    return true;
+  }
+};
+
 template<>
 struct Type<bool> {
   static constexpr const char* name = "Boolean";
@@ -371,6 +388,14 @@ inline v8::Local<v8::Value> ToV8(v8::Local<v8::Context> context,
   return Type<T>::ToV8(context, type);
 }
 
+// Rvalues are passed on so types like nu::Buffer can move their contents.
+template<typename T>
+inline typename std::enable_if<!std::is_lvalue_reference<T>::value,
+                               v8::Local<v8::Value>>::type
+ToV8(v8::Local<v8::Context> context, T&& type) {
+  return Type<typename std::decay<T>::type>::ToV8(context, std::move(type));
+}
+
 template<typename T>
 inline bool FromV8(v8::Local<v8::Context> context,
                    v8::Local<v8::Value> value,